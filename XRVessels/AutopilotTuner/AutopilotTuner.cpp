@@ -0,0 +1,927 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// AutopilotTuner.cpp
+// Offline Monte Carlo harness and gain search for the attitude hold,
+// descent hold, and airspeed hold autopilots.
+//
+// Runs the autopilots' control laws (XR1AutopilotLaws) against a
+// simple rigid-body model of the selected vessel for thousands of
+// seeded scenarios that vary the ship's mass, center-of-gravity
+// offset, wind gusts, and time acceleration, and reports the settling
+// time, overshoot, and fuel use distributions for a given gain set.
+// Scenarios are split across threads.  With --search, a coordinate
+// descent over the gains used by the selected autopilots looks for
+// the gain set with the lowest cost on the same scenarios.
+//
+// As in Orbiter, the autopilot runs once per frame and its thruster
+// levels are held for the entire timestep, while the model itself is
+// integrated in 1 ms steps.  The autopilot code is the vessels' own:
+// XR1AutopilotLaws runs each law every CONTROL_PERIOD within a frame
+// against its own model of the ship, and the tuner only supplies the
+// state Orbiter would (rates, accelerations, and the disturbance
+// trend).  The model is deliberately simple: one rotation axis
+// (pitch) for attitude hold with the center-of-gravity offset acting
+// as a constant lift torque, vertical motion only for descent hold,
+// and quadratic drag for airspeed hold.  Attitude hold applies the
+// pitch learning thrust as it does in an atmosphere; the
+// center-of-lift shift is not modeled.
+//
+// --max-unsettled and --max-overshoot turn a run into a pass/fail
+// check, and --compare-time-acc runs the same scenarios at several
+// fixed time accelerations and fails if the settling time or
+// overshoot percentiles drift from the first rate's by more than
+// --rate-tolerance and --overshoot-tolerance; "make checks" uses
+// these.
+// ==============================================================
+
+#include "XR1AutopilotLaws.h"
+#include "XRRandom.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <strings.h>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+static const double G = 9.81;                   // m/s^2
+static const double DEG = 57.2957795130823208768;
+static const double PI = 3.14159265358979323846;
+static const double PHYSICS_STEP = 0.001;       // model integration step in seconds
+
+// Rigid-body parameters for one vessel class; see each vessel's XRnGlobals.cpp and XRnStartupCallbacks.cpp.
+// Engine values are per engine; each vessel has two main engines, two hover engines, and two RCS jets per rotation direction.
+struct VesselPreset
+{
+    const char *pName;
+    double EmptyMass;           // EMPTY_MASS [kg]
+    double PMI[3];              // SetPMI values [m^2]: pitch, yaw, roll
+    double RCSThrust;           // MAX_RCS_THRUST [N]
+    double PitchArm;            // distance of the pitch RCS jets from the center of gravity [m]
+    double HoverThrust;         // MAX_HOVER_THRUST, realistic [N]
+    double MainThrust;          // MAX_MAIN_THRUST, realistic [N]
+    double ISP;                 // realistic main fuel ISP, also used by the RCS [m/s]
+    double AngVelDeltaFrac;     // AP_ANGULAR_VELOCITY_DEGREES_DELTA_FRAC
+};
+
+static const VesselPreset s_vesselPresets[] =
+{
+    { "xr1",  12000.0, {  15.5,   22.1,   7.7  },   2.5e3,  8.0,    1.32e5,    1.92e5,    20914.7405907408, 0.5 },
+    { "xr2",  16080.0, {  32.04,  42.56,  13.17 },  3.93e3, 10.955, 207.83e3,  302.3e3,   20914.7405907408, 0.5 / 2 },
+    { "xr3",  60629.0, {  88.20,  107.35, 27.03 },  14.84e3, 14.375, 783.64e3, 1139.83e3, 20914.7405907408, 0.5 / 2.5 },
+    { "xr5", 266400.0, { 317.35,  305.08, 219.45 }, 111.0e3, 26.235, 2930.30e3, 4262.40e3, 20914.7405907408, 0.5 / 5 },
+};
+
+enum Autopilot { AP_ATTITUDE, AP_DESCENT, AP_AIRSPEED, AP_COUNT };
+
+// one gain that --search may adjust
+struct GainDefinition
+{
+    const char *pOption;                    // command-line option that sets it
+    double XR1AutopilotGains::*pValue;
+    int AutopilotMask;                      // (1 << Autopilot) bits of the autopilots that use it
+};
+
+static const GainDefinition s_gainDefinitions[] =
+{
+    { "--ang-vel-frac",       &XR1AutopilotGains::AngularVelocityDegreesDeltaFrac, (1 << AP_ATTITUDE) },
+    { "--rate-taper",         &XR1AutopilotGains::AttitudeRateTaper,               (1 << AP_ATTITUDE) },
+    { "--rate-min-mult",      &XR1AutopilotGains::RateHoldMinMultiplier,           (1 << AP_DESCENT) | (1 << AP_AIRSPEED) },
+    { "--rate-mult-divisor",  &XR1AutopilotGains::RateHoldMultiplierDivisor,       (1 << AP_DESCENT) | (1 << AP_AIRSPEED) },
+    { "--autoland-mult",      &XR1AutopilotGains::AutoLandMultiplier,              (1 << AP_DESCENT) },
+};
+
+// Per-autopilot settings: the controlled value is settled once it stays within Tolerance of its target.
+struct AutopilotDefinition
+{
+    const char *pName;
+    const char *pUnits;         // units of the controlled value, for overshoot
+    double Tolerance;
+};
+
+static const AutopilotDefinition s_autopilots[AP_COUNT] =
+{
+    { "attitude", "deg", 0.5 },
+    { "descent",  "m/s", 0.1 },
+    { "airspeed", "m/s", 0.5 },
+};
+
+struct Options
+{
+    VesselPreset Vessel;
+    XR1AutopilotGains Gains;
+    int AutopilotMask = (1 << AP_ATTITUDE) | (1 << AP_DESCENT) | (1 << AP_AIRSPEED);
+    int ScenarioCount = 1000;
+    uint64_t Seed = 1;
+    double Duration = 120.0;        // simulation seconds per scenario
+    double MinTimeAcc = 1.0;
+    double MaxTimeAcc = 60.0;       // the autopilots suspend themselves above 60x in an atmosphere
+    double MaxCogOffset = 0.01;     // m
+    double MaxWind = 0.05;          // gust amplitude as a fraction of the controlled axis' full authority
+    bool AutoLand = false;
+    int ThreadCount = 0;            // 0 = one per hardware thread
+    int SearchIterations = 0;       // 0 = evaluate the gains only
+    double OvershootWeight = 1.0;   // cost in seconds per tolerance band of overshoot
+    double FuelWeight = 0.0;        // cost in seconds per kg of fuel
+    const char *pOutputFilename = nullptr;  // per-scenario CSV, or nullptr for none
+    int MaxUnsettled = -1;          // fail if more scenarios than this never settle; < 0 = no limit
+    double MaxOvershoot = -1;       // fail if the p99 overshoot exceeds this; < 0 = no limit
+    vector<double> CompareTimeAccs; // run the scenarios at each of these fixed time accelerations and compare them to the first; empty = off
+    double RateTolerance = 0.15;    // settling time percentiles may exceed the first rate's by this fraction
+    double OvershootTolerance = -1; // overshoot percentiles may exceed the first rate's by this much; < 0 = the autopilot's Tolerance
+};
+
+// conditions for one scenario, drawn from the scenario's own random stream
+struct ScenarioConditions
+{
+    double Mass;                // kg
+    double CogOffset;           // m; positive = forward of the center of lift
+    double WindAmplitude;       // fraction of full authority
+    double WindPeriod;          // s
+    double WindPhase;           // radians
+    double TimeAcc;
+    double FrameRate;           // frames per real-time second
+};
+
+struct ScenarioResult
+{
+    ScenarioConditions Conditions;
+    double SettlingTime;        // s, or < 0 if the value never settled
+    double Overshoot;           // past the target, in the autopilot's units
+    double Fuel;                // kg
+};
+
+// percentiles of one result field over all of an autopilot's scenarios
+struct Distribution
+{
+    double P50, P90, P99, Max;
+};
+
+struct AutopilotSummary
+{
+    int UnsettledCount;
+    Distribution SettlingTime;  // of the scenarios that settled
+    Distribution Overshoot;
+    Distribution Fuel;
+};
+
+//-------------------------------------------------------------------------
+
+static double Uniform(XRRandom &rng, const double minVal, const double maxVal)
+{
+    return minVal + (maxVal - minVal) * rng.NextDouble();
+}
+
+static ScenarioConditions DrawConditions(const Options &opt, XRRandom &rng)
+{
+    ScenarioConditions c;
+    c.Mass = opt.Vessel.EmptyMass * Uniform(rng, 1.0, 1.8);    // empty to fully fueled and loaded
+    c.CogOffset = Uniform(rng, -opt.MaxCogOffset, opt.MaxCogOffset);
+    c.WindAmplitude = Uniform(rng, 0, opt.MaxWind);
+    c.WindPeriod = Uniform(rng, 2.0, 20.0);
+    c.WindPhase = Uniform(rng, 0, 2 * PI);
+    c.TimeAcc = exp(Uniform(rng, log(opt.MinTimeAcc), log(max(opt.MaxTimeAcc, opt.MinTimeAcc))));   // log-uniform, so low time acceleration gets its share
+    c.FrameRate = Uniform(rng, 30.0, 60.0);
+    return c;
+}
+
+// Tracks settling time and overshoot of (target - value) over a run.
+class ErrorTracker
+{
+public:
+    ErrorTracker(const double initialError, const double tolerance) :
+        m_sign((initialError >= 0) ? 1.0 : -1.0), m_tolerance(tolerance), m_lastOutsideTime(0), m_overshoot(0), m_settled(false)
+    {
+    }
+
+    void Update(const double error, const double t)
+    {
+        if (fabs(error) > m_tolerance)
+        {
+            m_lastOutsideTime = t;
+            m_settled = false;
+        }
+        else
+        {
+            m_settled = true;
+        }
+        m_overshoot = max(m_overshoot, -m_sign * error);
+    }
+
+    void Store(ScenarioResult &result) const
+    {
+        result.SettlingTime = (m_settled ? m_lastOutsideTime : -1);
+        result.Overshoot = m_overshoot;
+    }
+
+protected:
+    double m_sign;
+    double m_tolerance;
+    double m_lastOutsideTime;
+    double m_overshoot;
+    bool m_settled;
+};
+
+// Returns the next frame's timestep; frame times jitter by +-10%.
+static double NextTimestep(const ScenarioConditions &c, XRRandom &rng)
+{
+    return c.TimeAcc / c.FrameRate * Uniform(rng, 0.9, 1.1);
+}
+
+static double Gust(const ScenarioConditions &c, const double t)
+{
+    return c.WindAmplitude * sin(2 * PI * t / c.WindPeriod + c.WindPhase);
+}
+
+// Attitude hold: pitch only, as FireThrusterGroups holds it in an atmosphere with the initial bank complete.
+static void RunAttitudeHold(const Options &opt, const XR1AutopilotGains &gains, XRRandom &rng, ScenarioResult &result)
+{
+    const ScenarioConditions &c = result.Conditions;
+    const double inertia = c.Mass * opt.Vessel.PMI[0];
+    const double maxAngularAcc = 2 * opt.Vessel.RCSThrust * opt.Vessel.PitchArm / inertia * DEG;   // deg/s^2
+    const double cogAngularAcc = c.Mass * G * c.CogOffset / inertia * DEG;     // level flight: lift equals weight and acts at the center of lift
+    const double rcsFuelFlow = 2 * opt.Vessel.RCSThrust / opt.Vessel.ISP;      // kg/s per jet pair at full thrust
+
+    const double target = ((rng.NextDouble() < 0.5) ? -1 : 1) * Uniform(rng, 2.0, 30.0);
+    double angle = 0;
+    double angularVelocity = Uniform(rng, -1.0, 1.0);
+    double positiveLevel = 0, negativeLevel = 0;
+    XR1LearningData learning;
+
+    ErrorTracker tracker(target - angle, s_autopilots[AP_ATTITUDE].Tolerance);
+    double t = 0;
+    result.Fuel = 0;
+    while (t < opt.Duration)
+    {
+        const double simdt = NextTimestep(c, rng);
+
+        // Orbiter reports the angular acceleration at the start of the timestep, gusts included
+        const double jetAngularAcc = (positiveLevel - negativeLevel) * maxAngularAcc;
+        const double externalAngularAcc = XR1AutopilotLaws::ExternalAngularAcc(jetAngularAcc + Gust(c, t) * maxAngularAcc + cogAngularAcc, jetAngularAcc);
+
+        XR1AttitudeAxis axis;
+        axis.TargetValue = target;
+        axis.CurrentValue = angle;
+        axis.AngularVelocity = angularVelocity;
+        axis.ExternalAngularAcc = externalAngularAcc;
+        axis.HeldJetLevel = positiveLevel - negativeLevel;
+        axis.MaxPositiveAngularAcc = axis.MaxNegativeAngularAcc = maxAngularAcc;
+        axis.AngVelLimit = 20.0;
+        axis.MinAngVel = 0;
+        axis.ReverseRotation = true;
+        axis.ApplyLearningThrust = true;
+        axis.MasterThrustFrac = 1.0;
+        axis.DescentHoldActive = false;
+
+        // inside the dead zone, the jets keep the levels set on the previous frame
+        double jetLevel;
+        if (XR1AutopilotLaws::AttitudeHoldJetLevel(axis, &learning, simdt, gains, jetLevel))
+        {
+            negativeLevel = max(-jetLevel, 0.0);
+            positiveLevel = max(jetLevel, 0.0);
+        }
+
+        const int stepCount = max(1, static_cast<int>(ceil(simdt / PHYSICS_STEP)));
+        const double h = simdt / stepCount;
+        for (int i = 0; i < stepCount; i++)
+        {
+            const double acc = (positiveLevel - negativeLevel + Gust(c, t)) * maxAngularAcc + cogAngularAcc;
+            angularVelocity += acc * h;
+            angle += angularVelocity * h;
+            t += h;
+            result.Fuel += (positiveLevel + negativeLevel) * rcsFuelFlow * h;
+            tracker.Update(target - angle, t);
+        }
+    }
+    tracker.Store(result);
+}
+
+// Descent hold: vertical rate only, with the hover engines holding a commanded rate.
+static void RunDescentHold(const Options &opt, const XR1AutopilotGains &gains, XRRandom &rng, ScenarioResult &result)
+{
+    const ScenarioConditions &c = result.Conditions;
+    const double maxHoverThrust = 2 * opt.Vessel.HoverThrust;
+    const double maxHoverAcc = maxHoverThrust / c.Mass;
+    const double hoverFuelFlow = maxHoverThrust / opt.Vessel.ISP;
+
+    const double targetRate = Uniform(rng, -5.0, 0.0);
+    double rate = targetRate + ((rng.NextDouble() < 0.5) ? -1 : 1) * Uniform(rng, 2.0, 20.0);
+    double thLevel = 0;
+    XR1DisturbanceTrend planetAccTrend;
+
+    ErrorTracker tracker(targetRate - rate, s_autopilots[AP_DESCENT].Tolerance);
+    double t = 0;
+    result.Fuel = 0;
+    while (t < opt.Duration)
+    {
+        const double simdt = NextTimestep(c, rng);
+
+        // Orbiter reports the forces at the start of the timestep, gusts included
+        const double planetAcc = -G + Gust(c, t) * maxHoverAcc;
+        const double planetAccRate = planetAccTrend.Update(t, simdt, planetAcc);
+        thLevel = XR1AutopilotLaws::DescentHoldThrustLevel(targetRate - rate, planetAcc, planetAccRate, maxHoverAcc, opt.AutoLand, simdt, gains);
+
+        const int stepCount = max(1, static_cast<int>(ceil(simdt / PHYSICS_STEP)));
+        const double h = simdt / stepCount;
+        for (int i = 0; i < stepCount; i++)
+        {
+            rate += (thLevel * maxHoverAcc - G + Gust(c, t) * maxHoverAcc) * h;
+            t += h;
+            result.Fuel += thLevel * hoverFuelFlow * h;
+            tracker.Update(targetRate - rate, t);
+        }
+    }
+    tracker.Store(result);
+}
+
+// Airspeed hold: level flight with quadratic drag; the retros are not used, so slowing down relies on drag alone.
+static void RunAirspeedHold(const Options &opt, const XR1AutopilotGains &gains, XRRandom &rng, ScenarioResult &result)
+{
+    const ScenarioConditions &c = result.Conditions;
+    const double maxMainThrust = 2 * opt.Vessel.MainThrust;
+    const double maxMainAcc = maxMainThrust / c.Mass;
+    const double mainFuelFlow = maxMainThrust / opt.Vessel.ISP;
+    const double dragCoeff = Uniform(rng, 0.2, 0.5) * maxMainThrust / (200.0 * 200.0);  // drag at 200 m/s as a fraction of full thrust
+
+    const double targetAirspeed = Uniform(rng, 100.0, 250.0);
+    double airspeed = targetAirspeed + ((rng.NextDouble() < 0.5) ? -1 : 1) * Uniform(rng, 5.0, 40.0);
+    double thLevel = 0;
+    XR1DisturbanceTrend planetAccTrend;
+
+    ErrorTracker tracker(targetAirspeed - airspeed, s_autopilots[AP_AIRSPEED].Tolerance);
+    double t = 0;
+    result.Fuel = 0;
+    while (t < opt.Duration)
+    {
+        const double simdt = NextTimestep(c, rng);
+
+        const double planetAcc = -dragCoeff * airspeed * airspeed / c.Mass + Gust(c, t) * maxMainAcc;
+        const double planetAccRate = planetAccTrend.Update(t, simdt, planetAcc);
+        thLevel = XR1AutopilotLaws::AirspeedHoldThrustLevel(targetAirspeed - airspeed, planetAcc, planetAccRate, maxMainAcc, simdt, gains);
+
+        const int stepCount = max(1, static_cast<int>(ceil(simdt / PHYSICS_STEP)));
+        const double h = simdt / stepCount;
+        for (int i = 0; i < stepCount; i++)
+        {
+            airspeed += (thLevel * maxMainAcc - dragCoeff * airspeed * airspeed / c.Mass + Gust(c, t) * maxMainAcc) * h;
+            t += h;
+            result.Fuel += thLevel * mainFuelFlow * h;
+            tracker.Update(targetAirspeed - airspeed, t);
+        }
+    }
+    tracker.Store(result);
+}
+
+// Run scenarios [first, last) of the flattened (autopilot, scenario) list into pOut.
+static void RunRange(const Options &opt, const XR1AutopilotGains &gains, const int64_t first, const int64_t last, ScenarioResult *pOut)
+{
+    XRRandom rng;
+    for (int64_t k = first; k < last; k++)
+    {
+        const Autopilot autopilot = static_cast<Autopilot>(k / opt.ScenarioCount);
+
+        ScenarioResult &result = pOut[k];
+        if ((opt.AutopilotMask & (1 << autopilot)) == 0)
+        {
+            result = ScenarioResult();
+            continue;
+        }
+
+        // Each scenario has its own stream, so the results do not depend on the thread count and every gain set sees identical scenarios.
+        rng.SetState(opt.Seed, static_cast<uint64_t>(k) << 32);
+        result.Conditions = DrawConditions(opt, rng);
+
+        switch (autopilot)
+        {
+        case AP_ATTITUDE: RunAttitudeHold(opt, gains, rng, result); break;
+        case AP_DESCENT:  RunDescentHold(opt, gains, rng, result);  break;
+        default:          RunAirspeedHold(opt, gains, rng, result); break;
+        }
+    }
+}
+
+// Run every scenario of the selected autopilots, split into contiguous ranges across threadCount threads.
+// results is indexed by (autopilot * ScenarioCount + scenario).
+static void RunScenarios(const Options &opt, const XR1AutopilotGains &gains, const int threadCount, vector<ScenarioResult> &results)
+{
+    const int64_t total = static_cast<int64_t>(AP_COUNT) * opt.ScenarioCount;
+    results.resize(static_cast<size_t>(total));
+
+    // unselected autopilots cost nothing, so split by the work actually done
+    vector<int64_t> work;
+    for (int64_t k = 0; k < total; k++)
+    {
+        if (opt.AutopilotMask & (1 << (k / opt.ScenarioCount)))
+            work.push_back(k);
+    }
+    if (work.empty())
+        return;
+
+    const int64_t workCount = static_cast<int64_t>(work.size());
+    vector<thread> threads;
+    for (int t = 0; t < threadCount; t++)
+    {
+        const int64_t first = workCount * t / threadCount;
+        const int64_t last = workCount * (t + 1) / threadCount;
+        if (first < last)
+            threads.emplace_back(RunRange, cref(opt), cref(gains), work[first], work[last - 1] + 1, results.data());
+    }
+    for (thread &t : threads)
+        t.join();
+}
+
+static Distribution Summarize(vector<double> values)
+{
+    if (values.empty())
+        return { 0, 0, 0, 0 };
+
+    sort(values.begin(), values.end());
+    const auto percentile = [&values](const double p) { return values[static_cast<size_t>(p * (values.size() - 1) + 0.5)]; };
+    return { percentile(0.50), percentile(0.90), percentile(0.99), values.back() };
+}
+
+// Lower is better: mean settling time (unsettled scenarios count as twice the run length) plus the weighted overshoot and fuel.
+static double AutopilotCost(const Options &opt, const vector<ScenarioResult> &results, const Autopilot autopilot)
+{
+    double cost = 0;
+    for (int i = 0; i < opt.ScenarioCount; i++)
+    {
+        const ScenarioResult &r = results[static_cast<size_t>(autopilot) * opt.ScenarioCount + i];
+        cost += ((r.SettlingTime >= 0) ? r.SettlingTime : 2 * opt.Duration);
+        cost += opt.OvershootWeight * r.Overshoot / s_autopilots[autopilot].Tolerance;
+        cost += opt.FuelWeight * r.Fuel;
+    }
+    return cost / opt.ScenarioCount;
+}
+
+static double TotalCost(const Options &opt, const vector<ScenarioResult> &results)
+{
+    double cost = 0;
+    for (int a = 0; a < AP_COUNT; a++)
+    {
+        if (opt.AutopilotMask & (1 << a))
+            cost += AutopilotCost(opt, results, static_cast<Autopilot>(a));
+    }
+    return cost;
+}
+
+static void PrintDistribution(const char *pLabel, const Distribution &d)
+{
+    printf("  %-22s p50=%-10.4g p90=%-10.4g p99=%-10.4g max=%.4g\n", pLabel, d.P50, d.P90, d.P99, d.Max);
+}
+
+static AutopilotSummary SummarizeAutopilot(const Options &opt, const vector<ScenarioResult> &results, const Autopilot autopilot)
+{
+    vector<double> settlingTimes, overshoots, fuel;
+    AutopilotSummary summary;
+    summary.UnsettledCount = 0;
+    for (int i = 0; i < opt.ScenarioCount; i++)
+    {
+        const ScenarioResult &r = results[static_cast<size_t>(autopilot) * opt.ScenarioCount + i];
+        if (r.SettlingTime >= 0)
+            settlingTimes.push_back(r.SettlingTime);
+        else
+            summary.UnsettledCount++;
+        overshoots.push_back(r.Overshoot);
+        fuel.push_back(r.Fuel);
+    }
+    summary.SettlingTime = Summarize(settlingTimes);
+    summary.Overshoot = Summarize(overshoots);
+    summary.Fuel = Summarize(fuel);
+    return summary;
+}
+
+// Returns false if any autopilot exceeds --max-unsettled or --max-overshoot.
+// pSummaries, if not null, receives each autopilot's summary.
+static bool PrintReport(const Options &opt, const vector<ScenarioResult> &results, AutopilotSummary *pSummaries = nullptr)
+{
+    bool withinLimits = true;
+    for (int a = 0; a < AP_COUNT; a++)
+    {
+        if ((opt.AutopilotMask & (1 << a)) == 0)
+            continue;
+
+        const AutopilotSummary summary = SummarizeAutopilot(opt, results, static_cast<Autopilot>(a));
+        if (pSummaries)
+            pSummaries[a] = summary;
+
+        char overshootLabel[32];
+        snprintf(overshootLabel, sizeof(overshootLabel), "overshoot [%s]", s_autopilots[a].pUnits);
+
+        printf("%s hold: %d of %d scenarios settled within %g %s; cost=%.4g\n", s_autopilots[a].pName,
+            opt.ScenarioCount - summary.UnsettledCount, opt.ScenarioCount, s_autopilots[a].Tolerance, s_autopilots[a].pUnits,
+            AutopilotCost(opt, results, static_cast<Autopilot>(a)));
+        PrintDistribution("settling time [s]", summary.SettlingTime);
+        PrintDistribution(overshootLabel, summary.Overshoot);
+        PrintDistribution("fuel [kg]", summary.Fuel);
+
+        if ((opt.MaxUnsettled >= 0) && (summary.UnsettledCount > opt.MaxUnsettled))
+        {
+            printf("FAIL: %s hold: %d scenarios never settled; the limit is %d\n", s_autopilots[a].pName, summary.UnsettledCount, opt.MaxUnsettled);
+            withinLimits = false;
+        }
+        if ((opt.MaxOvershoot >= 0) && (summary.Overshoot.P99 > opt.MaxOvershoot))
+        {
+            printf("FAIL: %s hold: p99 overshoot is %.4g %s; the limit is %g\n", s_autopilots[a].pName, summary.Overshoot.P99, s_autopilots[a].pUnits, opt.MaxOvershoot);
+            withinLimits = false;
+        }
+    }
+    return withinLimits;
+}
+
+// Returns false if a percentile exceeds its limit; label names the percentile, e.g. "p99 settling time".
+static bool CheckPercentile(const Autopilot autopilot, const double timeAcc, const char *pLabel, const double value, const double limit)
+{
+    if (value <= limit)
+        return true;
+
+    printf("FAIL: %s hold: %s is %.4g at %gx; the limit is %.4g\n", s_autopilots[autopilot].pName, pLabel, value, timeAcc, limit);
+    return false;
+}
+
+// Runs the same scenarios at each of --compare-time-acc's fixed time accelerations and checks each rate's settling time and
+// overshoot percentiles against the first rate's.  Returns false if any rate misses --max-unsettled, --max-overshoot, or the
+// --rate-tolerance and --overshoot-tolerance limits.
+static bool CompareTimeAccs(const Options &opt, const XR1AutopilotGains &gains, const int threadCount)
+{
+    bool withinLimits = true;
+    AutopilotSummary reference[AP_COUNT];
+    for (size_t r = 0; r < opt.CompareTimeAccs.size(); r++)
+    {
+        Options rateOpt = opt;
+        rateOpt.MinTimeAcc = rateOpt.MaxTimeAcc = opt.CompareTimeAccs[r];
+        printf("-- time-acc=%g\n", rateOpt.MaxTimeAcc);
+
+        vector<ScenarioResult> results;
+        RunScenarios(rateOpt, gains, threadCount, results);
+        AutopilotSummary summaries[AP_COUNT];
+        withinLimits &= PrintReport(rateOpt, results, summaries);
+        if (r == 0)
+        {
+            copy(begin(summaries), end(summaries), begin(reference));
+            continue;
+        }
+
+        for (int a = 0; a < AP_COUNT; a++)
+        {
+            if ((opt.AutopilotMask & (1 << a)) == 0)
+                continue;
+
+            const Autopilot autopilot = static_cast<Autopilot>(a);
+            const double timeFactor = 1.0 + opt.RateTolerance;
+            const double overshootAllowance = ((opt.OvershootTolerance >= 0) ? opt.OvershootTolerance : s_autopilots[a].Tolerance);
+            const Distribution &refTime = reference[a].SettlingTime, &time = summaries[a].SettlingTime;
+            const Distribution &refOvershoot = reference[a].Overshoot, &overshoot = summaries[a].Overshoot;
+            const double timeAcc = rateOpt.MaxTimeAcc;
+
+            withinLimits &= CheckPercentile(autopilot, timeAcc, "p50 settling time", time.P50, refTime.P50 * timeFactor);
+            withinLimits &= CheckPercentile(autopilot, timeAcc, "p90 settling time", time.P90, refTime.P90 * timeFactor);
+            withinLimits &= CheckPercentile(autopilot, timeAcc, "p99 settling time", time.P99, refTime.P99 * timeFactor);
+            withinLimits &= CheckPercentile(autopilot, timeAcc, "p50 overshoot", overshoot.P50, refOvershoot.P50 + overshootAllowance);
+            withinLimits &= CheckPercentile(autopilot, timeAcc, "p90 overshoot", overshoot.P90, refOvershoot.P90 + overshootAllowance);
+            withinLimits &= CheckPercentile(autopilot, timeAcc, "p99 overshoot", overshoot.P99, refOvershoot.P99 + overshootAllowance);
+        }
+    }
+    return withinLimits;
+}
+
+static void PrintGains(const Options &opt, const XR1AutopilotGains &gains)
+{
+    printf("gains:");
+    for (const GainDefinition &def : s_gainDefinitions)
+    {
+        if ((opt.AutopilotMask & def.AutopilotMask) && ((def.pValue != &XR1AutopilotGains::AutoLandMultiplier) || opt.AutoLand))
+            printf(" %s %.6g", def.pOption, gains.*def.pValue);
+    }
+    printf("\n");
+}
+
+static bool WriteCSV(FILE *pFile, const Options &opt, const vector<ScenarioResult> &results)
+{
+    fprintf(pFile, "autopilot,scenario,mass_kg,cog_offset_m,wind,wind_period_s,time_acc,frame_rate,settling_time_s,overshoot,fuel_kg\n");
+    for (int a = 0; a < AP_COUNT; a++)
+    {
+        if ((opt.AutopilotMask & (1 << a)) == 0)
+            continue;
+
+        for (int i = 0; i < opt.ScenarioCount; i++)
+        {
+            const ScenarioResult &r = results[static_cast<size_t>(a) * opt.ScenarioCount + i];
+            const ScenarioConditions &c = r.Conditions;
+            fprintf(pFile, "%s,%d,%.1f,%.5f,%.4f,%.3f,%.3f,%.2f,%.4f,%.6g,%.6g\n", s_autopilots[a].pName, i,
+                c.Mass, c.CogOffset, c.WindAmplitude, c.WindPeriod, c.TimeAcc, c.FrameRate, r.SettlingTime, r.Overshoot, r.Fuel);
+        }
+    }
+    return (ferror(pFile) == 0);
+}
+
+// Coordinate descent: try scaling each gain up and down by the current step, keep any change that lowers the cost,
+// and halve the step after a pass that finds no improvement.
+static XR1AutopilotGains SearchGains(const Options &opt, const int threadCount)
+{
+    XR1AutopilotGains best = opt.Gains;
+    vector<ScenarioResult> results;
+    RunScenarios(opt, best, threadCount, results);
+    double bestCost = TotalCost(opt, results);
+    printf("initial cost=%.6g\n", bestCost);
+
+    double step = 0.5;
+    for (int iteration = 1; iteration <= opt.SearchIterations; iteration++)
+    {
+        bool improved = false;
+        for (const GainDefinition &def : s_gainDefinitions)
+        {
+            if ((opt.AutopilotMask & def.AutopilotMask) == 0)
+                continue;
+            if ((def.pValue == &XR1AutopilotGains::AutoLandMultiplier) && !opt.AutoLand)
+                continue;   // unused without auto-land
+
+            for (const double scale : { 1.0 + step, 1.0 / (1.0 + step) })
+            {
+                XR1AutopilotGains candidate = best;
+                candidate.*def.pValue *= scale;
+                RunScenarios(opt, candidate, threadCount, results);
+                const double cost = TotalCost(opt, results);
+                if (cost < bestCost)
+                {
+                    best = candidate;
+                    bestCost = cost;
+                    improved = true;
+                    break;
+                }
+            }
+        }
+
+        printf("iteration %d: step=%.4g cost=%.6g\n", iteration, step, bestCost);
+        if (!improved)
+        {
+            step /= 2;
+            if (step < 0.01)
+                break;
+        }
+    }
+    return best;
+}
+
+//-------------------------------------------------------------------------
+
+static void Usage()
+{
+    fprintf(stderr,
+        "Usage: autopilottuner [options]\n"
+        "  --vessel xr1|xr2|xr3|xr5    vessel preset (default xr1)\n"
+        "  --autopilot attitude|descent|airspeed|all  autopilot(s) to run (default all)\n"
+        "  --scenarios n               scenarios per autopilot (default 1000)\n"
+        "  --seed n                    scenario seed (default 1)\n"
+        "  --duration s                simulated seconds per scenario (default 120)\n"
+        "  --time-acc max              maximum time acceleration (default 60)\n"
+        "  --min-time-acc min          minimum time acceleration (default 1)\n"
+        "  --cog-offset max            maximum center-of-gravity offset in meters (default 0.01)\n"
+        "  --wind max                  maximum gust amplitude as a fraction of full authority (default 0.05)\n"
+        "  --autoland                  run descent hold with auto-land engaged\n"
+        "  --ang-vel-frac value        override AP_ANGULAR_VELOCITY_DEGREES_DELTA_FRAC\n"
+        "  --rate-taper value          override the attitude hold rate taper (default 5)\n"
+        "  --rate-min-mult value       override the descent/airspeed hold minimum multiplier (default 2)\n"
+        "  --rate-mult-divisor value   override the descent/airspeed hold multiplier divisor (default 5)\n"
+        "  --autoland-mult value       override the auto-land multiplier (default 2)\n"
+        "  --search [iterations]       search for the gains with the lowest cost (default 20 iterations)\n"
+        "  --overshoot-weight value    cost in seconds per tolerance band of overshoot (default 1)\n"
+        "  --fuel-weight value         cost in seconds per kg of fuel (default 0)\n"
+        "  --threads n                 worker threads (default: hardware threads)\n"
+        "  --output file               write per-scenario results as CSV\n"
+        "  --max-unsettled n           exit with status 1 if more than n scenarios of any autopilot never settle\n"
+        "  --max-overshoot value       exit with status 1 if any autopilot's p99 overshoot exceeds value\n"
+        "  --compare-time-acc a,b,...  run the scenarios at each fixed time acceleration and exit with status 1 if the settling\n"
+        "                              time or overshoot percentiles (p50, p90, p99) at any of them exceed the first one's by\n"
+        "                              more than the tolerances below\n"
+        "  --rate-tolerance frac       settling time tolerance as a fraction of the first rate's (default 0.15)\n"
+        "  --overshoot-tolerance value overshoot tolerance in the autopilot's units (default: its settling band)\n");
+}
+
+static bool ParseDouble(const char *pStr, double &out)
+{
+    char *pEnd;
+    out = strtod(pStr, &pEnd);
+    return ((pEnd != pStr) && (*pEnd == 0));
+}
+
+// Parses a comma-separated list of time accelerations, each >= 1.
+static bool ParseTimeAccList(const char *pStr, vector<double> &out)
+{
+    out.clear();
+    const char *pItem = pStr;
+    for (;;)
+    {
+        const char *pComma = strchr(pItem, ',');
+        const string item = (pComma ? string(pItem, pComma) : string(pItem));
+        double timeAcc;
+        if (!ParseDouble(item.c_str(), timeAcc) || (timeAcc < 1))
+            return false;
+        out.push_back(timeAcc);
+        if (pComma == nullptr)
+            return true;
+        pItem = pComma + 1;
+    }
+}
+
+static bool ParseAutopilot(const char *pStr, int &maskOut)
+{
+    if (strcasecmp(pStr, "all") == 0)
+    {
+        maskOut = (1 << AP_COUNT) - 1;
+        return true;
+    }
+    for (int a = 0; a < AP_COUNT; a++)
+    {
+        if (strcasecmp(pStr, s_autopilots[a].pName) == 0)
+        {
+            maskOut = (1 << a);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns true on success, false on a command-line error.
+static bool ParseArguments(const int argc, char **argv, Options &opt)
+{
+    opt.Vessel = s_vesselPresets[0];
+
+    // First pass: the vessel preset, which the gain overrides below apply on top of.
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--vessel") == 0) && (i + 1 < argc))
+        {
+            const char *pName = argv[++i];
+            bool found = false;
+            for (const VesselPreset &preset : s_vesselPresets)
+            {
+                if (strcasecmp(pName, preset.pName) == 0)
+                {
+                    opt.Vessel = preset;
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                fprintf(stderr, "Unknown vessel: %s\n", pName);
+                return false;
+            }
+        }
+    }
+    opt.Gains.AngularVelocityDegreesDeltaFrac = opt.Vessel.AngVelDeltaFrac;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pArg = argv[i];
+        const char *pValue = ((i + 1 < argc) ? argv[i + 1] : nullptr);
+        bool ok = true;
+        bool consumedValue = true;
+        unsigned long long seed = opt.Seed;
+
+        if (strcmp(pArg, "--vessel") == 0)                  ok = (pValue != nullptr);
+        else if (strcmp(pArg, "--autopilot") == 0)          ok = (pValue && ParseAutopilot(pValue, opt.AutopilotMask));
+        else if (strcmp(pArg, "--scenarios") == 0)          ok = (pValue && (sscanf(pValue, "%d", &opt.ScenarioCount) == 1) && (opt.ScenarioCount > 0));
+        else if (strcmp(pArg, "--seed") == 0)               { ok = (pValue && (sscanf(pValue, "%llu", &seed) == 1)); opt.Seed = seed; }
+        else if (strcmp(pArg, "--duration") == 0)           ok = (pValue && ParseDouble(pValue, opt.Duration) && (opt.Duration > 0));
+        else if (strcmp(pArg, "--time-acc") == 0)           ok = (pValue && ParseDouble(pValue, opt.MaxTimeAcc) && (opt.MaxTimeAcc >= 1));
+        else if (strcmp(pArg, "--min-time-acc") == 0)       ok = (pValue && ParseDouble(pValue, opt.MinTimeAcc) && (opt.MinTimeAcc >= 1));
+        else if (strcmp(pArg, "--cog-offset") == 0)         ok = (pValue && ParseDouble(pValue, opt.MaxCogOffset));
+        else if (strcmp(pArg, "--wind") == 0)               ok = (pValue && ParseDouble(pValue, opt.MaxWind));
+        else if (strcmp(pArg, "--ang-vel-frac") == 0)       ok = (pValue && ParseDouble(pValue, opt.Gains.AngularVelocityDegreesDeltaFrac));
+        else if (strcmp(pArg, "--rate-taper") == 0)         ok = (pValue && ParseDouble(pValue, opt.Gains.AttitudeRateTaper));
+        else if (strcmp(pArg, "--rate-min-mult") == 0)      ok = (pValue && ParseDouble(pValue, opt.Gains.RateHoldMinMultiplier));
+        else if (strcmp(pArg, "--rate-mult-divisor") == 0)  ok = (pValue && ParseDouble(pValue, opt.Gains.RateHoldMultiplierDivisor));
+        else if (strcmp(pArg, "--autoland-mult") == 0)      ok = (pValue && ParseDouble(pValue, opt.Gains.AutoLandMultiplier));
+        else if (strcmp(pArg, "--overshoot-weight") == 0)   ok = (pValue && ParseDouble(pValue, opt.OvershootWeight));
+        else if (strcmp(pArg, "--fuel-weight") == 0)        ok = (pValue && ParseDouble(pValue, opt.FuelWeight));
+        else if (strcmp(pArg, "--threads") == 0)            ok = (pValue && (sscanf(pValue, "%d", &opt.ThreadCount) == 1) && (opt.ThreadCount >= 0));
+        else if (strcmp(pArg, "--output") == 0)             { ok = (pValue != nullptr); opt.pOutputFilename = pValue; }
+        else if (strcmp(pArg, "--max-unsettled") == 0)      ok = (pValue && (sscanf(pValue, "%d", &opt.MaxUnsettled) == 1) && (opt.MaxUnsettled >= 0));
+        else if (strcmp(pArg, "--max-overshoot") == 0)      ok = (pValue && ParseDouble(pValue, opt.MaxOvershoot) && (opt.MaxOvershoot >= 0));
+        else if (strcmp(pArg, "--compare-time-acc") == 0)   ok = (pValue && ParseTimeAccList(pValue, opt.CompareTimeAccs));
+        else if (strcmp(pArg, "--rate-tolerance") == 0)     ok = (pValue && ParseDouble(pValue, opt.RateTolerance) && (opt.RateTolerance >= 0));
+        else if (strcmp(pArg, "--overshoot-tolerance") == 0) ok = (pValue && ParseDouble(pValue, opt.OvershootTolerance) && (opt.OvershootTolerance >= 0));
+        else
+        {
+            consumedValue = false;
+            if (strcmp(pArg, "--autoland") == 0)            opt.AutoLand = true;
+            else if (strcmp(pArg, "--search") == 0)
+            {
+                opt.SearchIterations = 20;
+                if (pValue && (pValue[0] != '-'))
+                {
+                    ok = ((sscanf(pValue, "%d", &opt.SearchIterations) == 1) && (opt.SearchIterations > 0));
+                    consumedValue = true;
+                }
+            }
+            else
+            {
+                fprintf(stderr, "Unknown option: %s\n", pArg);
+                return false;
+            }
+        }
+
+        if (!ok)
+        {
+            fprintf(stderr, "Missing or invalid value for %s\n", pArg);
+            return false;
+        }
+        if (consumedValue)
+            i++;
+    }
+
+    if (!opt.CompareTimeAccs.empty() && ((opt.SearchIterations > 0) || opt.pOutputFilename))
+    {
+        fprintf(stderr, "--compare-time-acc cannot be combined with --search or --output\n");
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--help") == 0) || (strcmp(argv[i], "-h") == 0))
+        {
+            Usage();
+            return 0;
+        }
+    }
+
+    Options opt;
+    if (!ParseArguments(argc, argv, opt))
+    {
+        Usage();
+        return 1;
+    }
+
+    int threadCount = opt.ThreadCount;
+    if (threadCount == 0)
+        threadCount = max(1, static_cast<int>(thread::hardware_concurrency()));
+
+    printf("vessel=%s scenarios=%d seed=%llu duration=%g s time-acc=%g-%g cog-offset=%g m wind=%g%s\n",
+        opt.Vessel.pName, opt.ScenarioCount, static_cast<unsigned long long>(opt.Seed), opt.Duration, opt.MinTimeAcc, opt.MaxTimeAcc,
+        opt.MaxCogOffset, opt.MaxWind, (opt.AutoLand ? " autoland" : ""));
+
+    XR1AutopilotGains gains = opt.Gains;
+    if (!opt.CompareTimeAccs.empty())
+    {
+        PrintGains(opt, gains);
+        return (CompareTimeAccs(opt, gains, threadCount) ? 0 : 1);
+    }
+
+    if (opt.SearchIterations > 0)
+        gains = SearchGains(opt, threadCount);
+
+    vector<ScenarioResult> results;
+    RunScenarios(opt, gains, threadCount, results);
+    PrintGains(opt, gains);
+    const bool withinLimits = PrintReport(opt, results);
+
+    if (opt.pOutputFilename)
+    {
+        FILE *pFile = fopen(opt.pOutputFilename, "w");
+        if (pFile == nullptr)
+        {
+            fprintf(stderr, "Could not open %s: %s\n", opt.pOutputFilename, strerror(errno));
+            return 1;
+        }
+        const bool ok = WriteCSV(pFile, opt, results) & (fclose(pFile) == 0);
+        if (!ok)
+        {
+            fprintf(stderr, "Error writing %s\n", opt.pOutputFilename);
+            return 1;
+        }
+    }
+    return (withinLimits ? 0 : 1);
+}
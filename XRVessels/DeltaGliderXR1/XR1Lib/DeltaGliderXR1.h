@@ -33,10 +33,16 @@
 #include "XR1Ramjet.h"
 #include "InstrumentPanel.h"
 #include "XRSound.h"
+#include "XR1SoundCache.h"
 #include "XR1ConfigFileParser.h"
 #include "TextBox.h"
+#include "XRScenarioWriter.h"
+#include "XRRandom.h"
+#include "XRCalloutQueue.h"
+#include "XR1CrewIndex.h"
 #include "XR1Globals.h"
 #include "imgui.h"
+#include <mutex>
 
 #ifdef MMU
 #include "UMmuSDK.h"
@@ -153,6 +159,11 @@ public:
 
     void RenderDataHUD(const HUDPAINTSPEC *hps, oapi::Sketchpad *skp);
 
+    // handlers for the actions in GetXR1Config()->KeyBindings
+    int GetAutopilotKeyMask() const;
+    void PerformDirectKeyAction(const XR1KeyBinding &binding);
+    int PerformBufferedKeyAction(const XR1KeyBinding &binding, char *kstate);
+
     double m_damagedWingBalance;       // used by ApplyDamage()
 
 	// parameters for failure modeling in the mesh
@@ -161,12 +172,23 @@ public:
 
     void UpdateDoorDamage(DoorStatus &doorStatus, double &doorProc, const double fracIntegrity);
 
+    // Cached damage status, one entry per DamageItem up to D_END.  This is refreshed by UpdateDamageStatusTable whenever
+    // an integrity changes, so GetDamageStatus is just an array lookup.
+    const DamageStatus &GetDamageStatus(DamageItem item) const { return m_damageStatusTable[static_cast<int>(item)]; }
+    const DamageStatus *GetDamageStatusTable() const { return m_damageStatusTable; }
+    void UpdateDamageStatusTable();
+
+    // All random damage, failure, and fuel dump decisions draw from this vessel's own generator rather than oapiRand,
+    // so the sequence is saved with the scenario and replays identically when it is reloaded.
+    double XRRand() { return m_random.NextDouble(); }   // [0, 1)
+    XRRandom &GetXRRandom() { return m_random; }
+
     // it is typically not necessary to override this method by subclasses, but we may need to.
     virtual void ResetDamageStatus();
 
     // virtual methods typically overridden by subclasses
     virtual void SetDamageStatus(DamageItem item, double fracIntegrity);
-    virtual const DamageStatus &GetDamageStatus(DamageItem item) const;
+    virtual void ComputeDamageStatus(DamageItem item, DamageStatus &status, const bool includeLabels) const;
     virtual bool IsDamagePresent() const;
     virtual bool IsWarningPresent() const;
     virtual double GetRCSThrustMax(const int index) const;
@@ -260,10 +282,24 @@ public:
     // Note: no proc for fuel or LOX hatches: they "snap" open or closed
 	double nose_proc, scramdoor_proc, hoverdoor_proc, ladder_proc, gear_proc, rcover_proc, olock_proc, ilock_proc, chamber_proc, hatch_proc, radiator_proc, brake_proc;     // logical status
 
-    // WARNING: All code should invoke SetXRAnimation instead of SetXRAnimation!  The reason is that 
-    // SetXRAnimation always assumes that the handle is valid, and so SetXRAnimation is a virtual "gate" 
-    // method that allows each subclass to determine whether that animation is valid or not for that vessel.
-    virtual void SetXRAnimation(const unsigned int &anim, const double state) const;
+    // WARNING: All code should invoke SetXRAnimation instead of SetAnimation!  The reason is that 
+    // SetAnimation always assumes that the handle is valid, whereas SetXRAnimation ignores any animation
+    // that the vessel's DefineAnimations did not register via RegisterXRAnimation.
+    void SetXRAnimation(const unsigned int &anim, const double state) const;
+    void RegisterXRAnimation(const unsigned int &anim);
+
+    // number of SetXRAnimation calls skipped because the animation state did not change
+    unsigned long long GetSkippedXRAnimationCount() const { return m_skippedXRAnimationCount; }
+
+    // Doors that travel at a fixed rate between closed (proc 0.0) and open (proc 1.0) are kept in a door table; see InitDoorTable.
+    // Subclasses register any additional doors from their constructors.
+    enum class DoorOpenedAction { None, EnableRetroThrusters, EnableHoverEngines, EnableScramEngines };
+    int RegisterDoor(DoorStatus &status, double &proc, const double rate, const unsigned int *pAnim, const int indicatorAreaID,
+        const bool requiresHydraulics, const char *pScenarioName, const DoorOpenedAction openedAction = DoorOpenedAction::None);
+    void AnimateDoors(const double simdt);
+    void WriteDoorScenarioLines(XRScenarioWriter &w) const;
+    bool ParseDoorScenarioLine(char *line);
+    template <class TVessel> friend bool ParseXRCommonScenarioFields(TVessel &vessel, char *line);  // see XRCommonScenarioFields.h
 
 	unsigned int anim_gear;         // handle for landing gear animation
 	unsigned int anim_rcover;       // handle for retro cover animation
@@ -477,6 +513,9 @@ public:
     bool m_apuFuelDumpInProgress;
     bool m_loxDumpInProgress;
 
+    // Orbiter recording being played back, from the XRFLIGHTDATA playback event; empty = none.  This is NOT persisted!
+    char m_flightDataRecordingName[256];
+
     // x-feed state data is NOT persisted!
     XFEED_MODE m_xfeedMode;
 
@@ -503,6 +542,11 @@ public:
     // so that we can easily change max RCS thrust without jumping through hoops.
     double m_rcsIntegrityArray[14];
 
+    // cached damage status; see UpdateDamageStatusTable
+    static const int DAMAGE_ITEM_COUNT = static_cast<int>(DamageItem::DISubclass10) + 1;
+    DamageStatus m_damageStatusTable[DAMAGE_ITEM_COUNT];
+    bool m_damageStatusLabelsValid;     // false until the first UpdateDamageStatusTable call fills in the labels
+
     //
     // New PERSISTENT public state data to communicate between areas and the main vessel
     //
@@ -698,6 +742,13 @@ public:
     virtual bool SetExternalCoolingState(const bool bEnabled);
     virtual bool SetCrossFeedMode(XRXFEED_STATE state);
 
+    // API methods added in XRVesselCtrl version 4.1
+    virtual bool GetXRTelemetrySnapshot(XRTelemetrySnapshot &snapshotOut, const int structSize = sizeof(XRTelemetrySnapshot));
+
+    // API methods added in XRVesselCtrl version 4.2
+    virtual bool EnqueueXRCommand(const XRCommand &command);
+    virtual int GetQueuedXRCommandCount();
+
     //=====================================================================
 
     //
@@ -730,12 +781,12 @@ public:
         AutopilotOn,
         AutopilotOff,
         RetroDoorsAreClosed, // 20
-        MachCallout,         // slot is reloaded on demand
-        AltitudeCallout,     // slot is reloaded on demand; also use for docking callouts
+        MachCallout,         // no longer used: voice callouts are queued and play on the Info channel
+        AltitudeCallout,     // no longer used: voice callouts are queued and play on the Info channel
         SonicBoom,
         Ambient,             // slot is reloaded on demand
         Warning,             // slot is reloaded on demand
-        Info,                // slot is reloaded on demand
+        Info,                // slot is reloaded on demand; used for all queued voice callouts
         ScramJet,
         GearWhine,          
         GearLockedThump,
@@ -786,6 +837,7 @@ public:
     // enum defining different classes of sounds
     enum SoundType { ST_AudioStatusGreeting, ST_VelocityCallout, ST_AltitudeCallout, ST_DockingDistanceCallout, ST_InformationCallout, ST_RCSStatusCallout, ST_AFStatusCallout, ST_WarningCallout, ST_Other, ST_None };
 
+    void PreloadXR1Sound(const Sound sound, const char *pFilename, XRSound::PlaybackType playbackType);
     void LoadXR1Sound(const Sound sound, const char *pFilename, XRSound::PlaybackType playbackType);
     void PlaySound(Sound sound, const SoundType soundType, int volume = 255, bool bLoop = false);
     void StopSound(Sound sound);
@@ -798,6 +850,17 @@ public:
             m_pXRSound->SetDefaultSoundEnabled(defaultSoundID, bOn);
     }
 
+    // Voice callouts are queued and played one at a time by CalloutQueuePostStep; see XRCalloutQueue.
+    // Callouts in the same nonzero group supersede each other while they are waiting to play.
+    enum CalloutGroup { CG_None, CG_Mach, CG_Altitude, CG_DockingDistance, CG_Gear };
+    void EnqueueCallout(const char *pFilename, const SoundType soundType, const CalloutGroup group = CG_None);
+    void EnqueueCallout(const Sound sound, const SoundType soundType, const CalloutGroup group = CG_None);
+    void EnqueueCallout(const Sound sound, const SoundType soundType, const XRCalloutPriority priority, const CalloutGroup group = CG_None);
+    bool IsSoundTypeEnabled(const SoundType soundType) const;
+    static XRCalloutPriority GetCalloutPriority(const SoundType soundType);
+    XRCalloutQueue m_calloutQueue;
+    Sound m_activeCalloutSound;     // channel the active callout is playing on; NO_SOUND = none
+
     void PlayErrorBeep();
     void PlayDoorSound(DoorStatus doorStatus);
     void PlayGearLockedSound(bool isGearUp);
@@ -908,6 +971,7 @@ public:
     virtual bool CheckEVADoor();
     int GetMmuSlotNumberForName(const char *pName) const;
     bool IsCrewMemberOnBoard(const int index) const;
+    void RebuildCrewIndex();    // must be invoked whenever a crew member boards or leaves the ship
 
     // XR1 crew member 'Misc' format: "P0", "P1", etc.
     static int ExtractIndexFromMmuMisc(const char *pMisc);
@@ -1081,7 +1145,46 @@ protected:
 
     double CheckTemperature(double tempK, double limitK, bool doorOpen);
     double CheckScramTemperature(double tempK, double limitK);
-    virtual bool CheckDoorFailure(DoorStatus *doorStatus);
+
+    // Door and hull heating damage limits are table-driven: the XR1 constructor adds a row for each of its doors and hull
+    // surfaces, and subclass constructors append rows for their own.  CheckAllDoorDamage and CheckHullHeatingDamage then
+    // evaluate each table in a single loop, skipping any row whose metric is below its early-out band.
+    enum class DoorFailureAction { None, JamDoor, FailGear };   // JamDoor = freeze the door's animation via FailDoor
+
+    struct DoorDamageRule
+    {
+        DoorStatus *pStatus;
+        double *pProc;
+        const double *pSurfaceTemp[2];  // hull surface temperatures in Kelvin that affect this door; [1] is nullptr if there is only one
+        double failureDynP;             // dynamic pressure limit in pascals with the door fully open; 0 = door cannot fail (heat warning only)
+        double warningDynP;             // failureDynP * DOOR_DYNAMIC_PRESSURE_WARNING_THRESHOLD
+        double earlyOutDynP;            // the door can neither warn nor fail below this dynamic pressure
+        bool *pWarningLight;            // nullptr = no warning light for this door
+        DoorFailureAction failureAction;
+        unsigned int *pAnim;            // animation handle for DoorFailureAction::JamDoor
+        const char *pFailureWav;
+        string failureMsg;
+        const char *pWarningWav;
+        string warningMsg;
+    };
+
+    struct HullBreachRule
+    {
+        const double *pSurfaceTemp;                 // in Kelvin
+        int HullTemperatureLimits::*pLimit;         // this surface's limit in m_hullTemperatureLimits
+        const DoorStatus *pDoorStatus;              // while this door is open the surface uses the (lower) open-door limit instead
+        const char *pSurfaceName;                   // e.g., "TOP HULL"
+    };
+
+    void InitDamageRules();
+    void AddDoorDamageRule(DoorStatus &status, double &proc, const double &surfaceTemp, const double *pSurfaceTemp2, const double failureDynP,
+        bool *pWarningLight, const DoorFailureAction failureAction, unsigned int *pAnim,
+        const char *pFailureWav, const char *pFailureMsg, const char *pWarningWav, const char *pWarningMsg);
+    void AddHullBreachRule(const double &surfaceTemp, int HullTemperatureLimits::*pLimit, const DoorStatus &doorStatus, const char *pSurfaceName);
+
+    vector<DoorDamageRule> m_doorDamageRules;
+    vector<HullBreachRule> m_hullBreachRules;
+    const DoorStatus *m_pWingHeatingDoorStatus;  // door that lowers the wings' heat limit while open; nullptr = none
 
 	virtual void ApplySkin();                     // apply custom skin
 
@@ -1118,6 +1221,60 @@ protected:
 #define CONFIG_OVERRIDE_APUFuelBurnRate           0x00000010
 #define CONFIG_OVERRIDE_CoolantHeatingRate        0x00000020
     unsigned m_configOverrideBitmask;
+
+    // XRVesselCtrl telemetry snapshot; rebuilt at most once per frame by GetXRTelemetrySnapshot
+    void RefreshTelemetrySnapshot();
+    XRTelemetrySnapshot m_telemetrySnapshot;
+    bool m_isTelemetrySnapshotValid;               // false = m_telemetrySnapshot has never been built
+
+    // XRVesselCtrl command queue; filled by EnqueueXRCommand from any thread and drained by clbkPreStep
+    void ApplyQueuedXRCommands();
+    void ApplyXRCommand(const XRCommand &command);
+    mutex m_xrCommandQueueMutex;
+    vector<XRCommand> m_xrCommandQueue;
+    vector<XRCommand> m_xrCommandBatch;            // commands being applied this frame; a member so we don't reallocate each frame
+
+    // scenario lines are buffered here and written in one pass; a member so the buffer is reused by each save
+    XRScenarioWriter m_scenarioWriter;
+
+    XRRandom m_random;      // see XRRand; state is saved in the RNG_STATE scenario line
+
+    XR1CrewIndex m_crewIndex;   // name and rank lookups over the crew on board; see RebuildCrewIndex
+
+    // XRSound slot cache for sounds loaded on demand via LoadXR1Sound; sounds loaded via PreloadXR1Sound are played from
+    // the slot with the same ID as the Sound.
+    int GetSoundSlot(const Sound sound) const { return m_soundCache.GetSlot(sound); }
+    XR1SoundCache<XRSound> m_soundCache;
+
+    void InitDoorTable();
+
+    // The door table is stored column-wise: each field is a contiguous array indexed by door number, so AnimateDoors
+    // can find the doors in motion by scanning the status column alone.  Each door is one bit in the masks below.
+    static const int MAX_XR_DOORS = 16;
+    struct XRDoorTable
+    {
+        int count;
+        unsigned int hydraulicMask;                 // doors that only move while hydraulic pressure is available
+        unsigned int gearMask;                      // doors that move via SetGearParameters rather than SetXRAnimation
+        DoorStatus *pStatus[MAX_XR_DOORS];
+        double *pProc[MAX_XR_DOORS];
+        double rate[MAX_XR_DOORS];                  // fraction of full travel per second
+        const unsigned int *pAnim[MAX_XR_DOORS];    // nullptr = no animation (e.g., airlock chamber pressure)
+        int indicatorAreaID[MAX_XR_DOORS];          // redrawn when the door finishes opening or closing; -1 = none
+        DoorOpenedAction openedAction[MAX_XR_DOORS];
+        const char *pScenarioName[MAX_XR_DOORS];    // "NAME status proc" scenario line
+    };
+    XRDoorTable m_doorTable;
+
+    // registered animations, indexed by animation handle; see SetXRAnimation
+    struct XRAnimationSlot
+    {
+        const unsigned int *pHandle;    // member holding the handle; nullptr = not valid for this vessel
+        double lastState;               // state last passed to SetAnimation
+    };
+    static constexpr double XR_ANIMATION_STATE_EPSILON = 1e-6;
+    mutable vector<XRAnimationSlot> m_xrAnimationTable;
+    mutable unsigned long long m_skippedXRAnimationCount;
 };
 
 // door sound structure; must be defined AFTER the XR1 class
@@ -26,6 +26,7 @@
 #include "DeltaGliderXR1.h"
 #include "AreaIDs.h"
 #include "XRCommon_DMG.h"
+#include "XR1DamageRolls.h"
 
 // Perform crash damage; i.e., damage all systems.  This is invoked only once when a crash occurs.
 void DeltaGliderXR1::PerformCrashDamage()
@@ -50,11 +51,11 @@ void DeltaGliderXR1::PerformCrashDamage()
 
     // fail left wing
     if (lwingstatus == 1.0)     // not already damaged?
-        lwingstatus = oapiRand() * 0.5;
+        lwingstatus = XRRand() * 0.5;
 
     // fail right wing
     if (rwingstatus == 1.0)     // not already damaged?
-        rwingstatus = oapiRand() * 0.5;
+        rwingstatus = XRRand() * 0.5;
 
     // fail all ailerons 
     aileronfail[0] = aileronfail[1] = true;
@@ -270,6 +271,8 @@ void DeltaGliderXR1::SetDamageStatus(DamageItem item, double fracIntegrity)
         break;
     }
 
+    UpdateDamageStatusTable();
+
     // if any damage present, let's apply it (also calls SetDamageVisuals)
     if (IsDamagePresent())   
     {
@@ -307,6 +310,9 @@ void DeltaGliderXR1::UpdateDoorDamage(DoorStatus &doorStatus, double &doorProc,
 // Note: items like RCS/engine thrust is computed internally, and should not be applied here.
 void DeltaGliderXR1::ApplyDamage()
 {
+    // callers may have just changed an integrity directly (e.g., the scenario editor's wing sliders)
+    UpdateDamageStatusTable();
+
     // if crashed, use balance previously set by DoCrash()
     m_wingBalance = (IsCrashed() ? m_damagedWingBalance : ((rwingstatus-lwingstatus) * CRASH_WING_BALANCE_MULTIPLIER));
     const double minWingAreaPct = 0.2222;   // if crashed, will be 22.2% lift
@@ -395,15 +401,15 @@ void DeltaGliderXR1::DoCrash(const char *pMsg, double touchdownVerticalSpeed)
         }
     }
 
-    // play crash sound separately so it always plays immediately
-    PlaySound(Crash, ST_Other);
+    // the crash sound interrupts any callout in progress and is not held off by warnings
+    EnqueueCallout(Crash, ST_Other, XRCalloutPriority::Crash);
     ShowWarning(nullptr, DeltaGliderXR1::ST_None, m_crashMessage, true);  // OK force this message because DoCrash() is only called once
 
     // set random new wing balance to make ship spiral
-    m_damagedWingBalance = (oapiRand() * 6.0) + 3.0;  // was 8.0, but induced excessive spins sometime
+    m_damagedWingBalance = (XRRand() * 6.0) + 3.0;  // was 8.0, but induced excessive spins sometime
 
     // now set left vs. right
-    if (oapiRand() < 0.5)
+    if (XRRand() < 0.5)
         m_damagedWingBalance = -m_damagedWingBalance;
 
     // damage will be applied by the TestDemage routine since IsCrashed() == true now
@@ -444,7 +450,7 @@ void DeltaGliderXR1::DoGearCollapse(const char *pMsg, double touchdownVerticalSp
     {
         // reduce the power somewhat
         double currentIntegrity = m_hoverEngineIntegrity[i];
-        double frac = (oapiRand() + 0.20);  // thruster is still at least 20% functional
+        double frac = (XRRand() + 0.20);  // thruster is still at least 20% functional
         if (frac > 0.89)
             frac = 0.89;  // hard cap
         double newIntegrity = currentIntegrity * frac;  // reduce max power
@@ -461,7 +467,7 @@ void DeltaGliderXR1::DoGearCollapse(const char *pMsg, double touchdownVerticalSp
 // anim = anim_gear, anim_rcover, etc.
 void DeltaGliderXR1::FailDoor(double &doorProc, unsigned int anim)
 {
-    doorProc = fmod(oapiRand(), 0.3) + 0.2;     // damage range is 0.2 - 0.5
+    doorProc = RollFailedDoorProc(GetXRRandom());     // damage range is 0.2 - 0.5
     SetXRAnimation(anim, doorProc);
 }
 
@@ -485,6 +491,7 @@ void DeltaGliderXR1::FailGear(bool setGearAnimState)
     m_MWSActive = true;
     gear_status = DoorStatus::DOOR_FAILED;
     m_warningLights[static_cast<int>(WarningLight::wlGear)] = true;
+    UpdateDamageStatusTable();
 }
 
 //
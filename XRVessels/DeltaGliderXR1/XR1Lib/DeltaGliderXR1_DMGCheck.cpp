@@ -26,6 +26,9 @@
 #include "DeltaGliderXR1.h"
 #include "AreaIDs.h"
 #include "XRCommon_DMG.h"
+#include "XR1DamageStatus.h"
+#include "XR1DamageRolls.h"
+#include <cassert>
 
 void DeltaGliderXR1::TestDamage()
 {
@@ -95,25 +98,24 @@ void DeltaGliderXR1::TestDamage()
         {
             double alpha = max((dynp - DYNP_MAX) * 1e-5,         // amount over-limit * 100K
                 (load > 0 ? load - WINGLOAD_MAX : WINGLOAD_MIN - load) * 5e-5);
-            double p = 1.0 - exp(-alpha * dt); // probability of failure
-            if (oapiRand() < p)
+            double wingFrac = 1.0;
+            const WingStressFailure failure = RollWingStressFailure(GetXRRandom(), alpha, dt, wingFrac);
+            if (failure != WingStressFailure::None)
             {
                 const char* pMsg;
-                // simulate structural failure by distorting the airfoil definition
-                int rfail = static_cast<int>(oapiRand() * RAND_MAX);      // use oapiRand() here since it's already seeded with a random value
-                switch (rfail & 3)
+                switch (failure)
                 {
-                case 0: // fail left wing
-                    lwingstatus *= exp(-alpha * oapiRand());
+                case WingStressFailure::LeftWing:
+                    lwingstatus *= wingFrac;
                     pMsg = "Left Wing Failure!";
                     m_warningLights[static_cast<int>(WarningLight::wlLwng)] = true;
                     break;
-                case 1: // fail right wing
-                    rwingstatus *= exp(-alpha * oapiRand());
+                case WingStressFailure::RightWing:
+                    rwingstatus *= wingFrac;
                     pMsg = "Right Wing Failure!";
                     m_warningLights[static_cast<int>(WarningLight::wlRwng)] = true;
                     break;
-                case 2:
+                case WingStressFailure::LeftAileron:
                 {
                     pMsg = "Left Aileron Failure!";
                     aileronfail[0] = aileronfail[1] = true;     // delete both aileron mesh groups
@@ -123,7 +125,7 @@ void DeltaGliderXR1::TestDamage()
                     FailAileronsIfDamaged();   // delete control surface
                 }
                 break;
-                case 3:
+                default:
                 {
                     pMsg = "Right Aileron Failure!";
                     aileronfail[2] = aileronfail[3] = true;     // delete both aileron mesh groups
@@ -204,7 +206,7 @@ void DeltaGliderXR1::TestDamage()
             // 30% over = 1.38
             // NOTE: do not integrate dt here; dt was already taken into account by CheckTemperature
             // pick a random engine and damage it based on alpha delta
-            int engineIndex = ((oapiRand() < 0.5) ? 0 : 1);
+            int engineIndex = ((XRRand() < 0.5) ? 0 : 1);
             const double engineFrac = std::max(0.0, (1.0 - alpha));
             ramjet->SetEngineIntegrity(engineIndex, ramjet->GetEngineIntegrity(engineIndex) * engineFrac);
 
@@ -213,7 +215,7 @@ void DeltaGliderXR1::TestDamage()
             const double engineInteg = ramjet->GetEngineIntegrity(engineIndex);
             const double mach = GetMachNumber();
             char temp[80];
-            if (oapiRand() > engineInteg)
+            if (XRRand() > engineInteg)
             {
                 sprintf(temp, "#%d SCRAM ENGINE EXPLOSION at Mach %.1lf!", (engineIndex + 1), mach);
                 DoCrash(temp, 0);
@@ -238,13 +240,23 @@ exit:
     if (newdamage)
     {
         m_MWSActive = true;
-        ApplyDamage();
+        ApplyDamage();      // also refreshes the damage status table
         //UpdateDamageDialog (this);
     }
 
     // if no warning present, reset the MWS automatically
     if (!IsWarningPresent())
         m_MWSActive = false;    // it's all good now...
+
+#ifdef _DEBUG
+    // catch any code path that changes an integrity without refreshing the damage status table
+    for (int i = 0; i <= static_cast<int>(D_END); i++)
+    {
+        DamageStatus live;
+        ComputeDamageStatus(static_cast<DamageItem>(i), live, false);
+        assert(live.fracIntegrity == m_damageStatusTable[i].fracIntegrity);
+    }
+#endif
 }
 
 //
@@ -263,28 +275,27 @@ bool DeltaGliderXR1::CheckHullHeatingDamage()
     const double mach = GetMachNumber();
     m_warningLights[static_cast<int>(WarningLight::wlHtmp)] = false;     // assume hull temp warning light OFF
 
-    // check nosecone temperature using both nosecone and hover doors
-    if (CheckTemperature(m_noseconeTemp, m_hullTemperatureLimits.noseCone, IS_DOOR_OPEN(nose_status)) != 0)
+    // Any hull surface that exceeds its limit breaches the hull; see InitDamageRules.
+    // CheckTemperature can only act once a surface reaches criticalFrac of its limit, so skip every surface below that.
+    const double criticalFrac = std::min(1.0, m_hullTemperatureLimits.criticalFrac);
+    for (const HullBreachRule &rule : m_hullBreachRules)
     {
-        // HULL FAILURE - crew death!
-        sprintf(temp, "NOSECONE BREACH at Mach %.1lf!", mach);
-        DoCrash(temp, 0);
-    }
+        const bool doorOpen = IS_DOOR_OPEN(*rule.pDoorStatus);
+        const int limitK = (doorOpen ? m_hullTemperatureLimits.doorOpen : m_hullTemperatureLimits.*rule.pLimit);
+        if (*rule.pSurfaceTemp < (limitK * criticalFrac))
+            continue;
 
-    //
-    // Note: checking these lower hull items separately will increase our chances of hull breach when more than one door is open; this is what we want!
-    //
-    if ((CheckTemperature(m_noseconeTemp, m_hullTemperatureLimits.noseCone, IS_DOOR_OPEN(hoverdoor_status)) != 0) ||
-        (CheckTemperature(m_noseconeTemp, m_hullTemperatureLimits.noseCone, IS_DOOR_OPEN(gear_status)) != 0))
-    {
-        // LOWER HULL FAILURE - crew death!
-        sprintf(temp, "LOWER HULL BREACH at Mach %.1lf!", mach);
-        DoCrash(temp, 0);
+        if (CheckTemperature(*rule.pSurfaceTemp, m_hullTemperatureLimits.*rule.pLimit, doorOpen) != 0)
+        {
+            // HULL FAILURE - crew death!
+            sprintf(temp, "%s BREACH at Mach %.1lf!", rule.pSurfaceName, mach);
+            DoCrash(temp, 0);
+        }
     }
 
-    // This check assumes the retro doors are related to the wings
-    const bool retroDoorsOpen = IS_DOOR_OPEN(rcover_status);
-    if ((alpha = CheckTemperature(m_leftWingTemp, m_hullTemperatureLimits.wings, retroDoorsOpen)) != 0)
+    // On the XR1 the retro doors are in the wings, so an open retro door lowers the wings' heat limit
+    const bool wingDoorOpen = ((m_pWingHeatingDoorStatus != nullptr) && IS_DOOR_OPEN(*m_pWingHeatingDoorStatus));
+    if ((alpha = CheckTemperature(m_leftWingTemp, m_hullTemperatureLimits.wings, wingDoorOpen)) != 0)
     {
         // WING DAMAGE -- check for critical ship failure vs. just wing damage
         // NOTE: as an example, alphas values if pilot is over max temp:
@@ -300,7 +311,7 @@ bool DeltaGliderXR1::CheckHullHeatingDamage()
         lwingstatus *= wingFrac;
         m_warningLights[static_cast<int>(WarningLight::wlLwng)] = true;   // warning light ON
 
-        if (oapiRand() > lwingstatus)
+        if (XRRand() > lwingstatus)
         {
             sprintf(temp, "LEFT WING BREACH at Mach %.1lf!", mach);
             DoCrash(temp, 0);
@@ -313,15 +324,14 @@ bool DeltaGliderXR1::CheckHullHeatingDamage()
         }
     }
 
-    // This check assumes the retro doors are related to the wings
-    if ((alpha = CheckTemperature(m_rightWingTemp, m_hullTemperatureLimits.wings, retroDoorsOpen)) != 0)
+    if ((alpha = CheckTemperature(m_rightWingTemp, m_hullTemperatureLimits.wings, wingDoorOpen)) != 0)
     {
         const double wingFrac = std::min(0.0, (1.0 - alpha));
         rwingstatus *= wingFrac;
         m_warningLights[static_cast<int>(WarningLight::wlRwng)] = true;   // warning light ON
 
         // WING DAMAGE -- check for critical ship failure vs. just wing damage
-        if (oapiRand() > rwingstatus)
+        if (XRRand() > rwingstatus)
         {
             sprintf(temp, "RIGHT WING BREACH at Mach %.1lf!", mach);
             DoCrash(temp, 0);
@@ -334,24 +344,6 @@ bool DeltaGliderXR1::CheckHullHeatingDamage()
         }
     }
 
-    // This check assumes the escape hatch is close to the cockpit.
-    if (CheckTemperature(m_cockpitTemp, m_hullTemperatureLimits.cockpit, IS_DOOR_OPEN(hatch_status)) != 0)
-    {
-        // HULL FAILURE - crew death!
-        sprintf(temp, "COCKPIT BREACH at Mach %.1lf!", mach);
-        DoCrash(temp, 0);
-    }
-
-    // Note: the XR1 does not have a payload bay, but it's OK to check it here for the purpose of subclasses
-    // top hull max temp is tied to: 1) radiators, and 2) bay doors
-    if ((CheckTemperature(m_topHullTemp, m_hullTemperatureLimits.topHull, IS_DOOR_OPEN(radiator_status)) != 0) ||
-        (CheckTemperature(m_topHullTemp, m_hullTemperatureLimits.topHull, IS_DOOR_OPEN(bay_status)) != 0))
-    {
-        // HULL FAILURE - crew death!
-        sprintf(temp, "TOP HULL BREACH at Mach %.1lf!", mach);
-        DoCrash(temp, 0);
-    }
-
     return newdamage;
 }
 
@@ -388,17 +380,158 @@ double DeltaGliderXR1::GetExternalTemperature() const
 bool DeltaGliderXR1::CheckAllDoorDamage()
 {
     bool newdamage = false;
-    newdamage |= CheckDoorFailure(&nose_status);
-    newdamage |= CheckDoorFailure(&rcover_status);
-    newdamage |= CheckDoorFailure(&hatch_status);
-    newdamage |= CheckDoorFailure(&radiator_status);
-    newdamage |= CheckDoorFailure(&gear_status);
-    newdamage |= CheckDoorFailure(&hoverdoor_status);
-    // SCRAM doors cannot fail for heat or pressure, so don't check them
+
+    // these are the same for every door
+    const bool damageAllowed = (AllowDamageIfDockedCheck() && !Playback());
+    const bool heatDamageEnabled = (GetXR1Config()->HullHeatingDamageEnabled && damageAllowed);
+    const bool stressDamageEnabled = (GetXR1Config()->DoorStressDamageEnabled && damageAllowed);
+    const double dynP = (stressDamageEnabled ? GetDynPressure() : 0);
+    const double doorOpenLimitK = m_hullTemperatureLimits.doorOpen;
+    const double warningTempK = doorOpenLimitK * m_hullTemperatureLimits.doorOpenWarning;
+    // Door heat failure requires at least the full open-door limit (the door's deployment only scales the temperature down),
+    // so nothing can happen below the lower of the two temperatures.
+    const double earlyOutTempK = std::min(doorOpenLimitK, warningTempK);
+
+    for (DoorDamageRule &rule : m_doorDamageRules)
+    {
+        // NOTE: once a door fails, it can only be repaired via the damage dialog; therefore, we never reset it here
+        if (*rule.pStatus == DoorStatus::DOOR_FAILED)
+            continue;   // do not re-check or warn if door already failed
+
+        bool *pWarningLight = rule.pWarningLight;
+        if (*rule.pStatus == DoorStatus::DOOR_CLOSED)
+        {
+            if (pWarningLight)
+                *pWarningLight = false;
+            continue;
+        }
+
+        // Door is open!  Check for damage or failure.
+        const double surfaceTemp = (rule.pSurfaceTemp[1] ? std::max(*rule.pSurfaceTemp[0], *rule.pSurfaceTemp[1]) : *rule.pSurfaceTemp[0]);
+        const bool canFail = (rule.failureDynP > 0);
+        const bool nearTempLimit = (heatDamageEnabled && (surfaceTemp > earlyOutTempK));
+        const bool nearDynPLimit = (canFail && (dynP > rule.earlyOutDynP));
+        if (!nearTempLimit && !nearDynPLimit)
+        {
+            if (pWarningLight)
+                *pWarningLight = false;
+            continue;
+        }
+
+        // door heat and dynp FAILURE depend on how far the door is opened
+        const double doorProc = *rule.pProc;
+        const bool overTemp = (heatDamageEnabled && ((surfaceTemp * (0.75 + (doorProc / 4.0))) > doorOpenLimitK));
+        const bool overDynP = ((dynP * (0.20 + (doorProc / 1.25))) > rule.failureDynP);
+        if (canFail && (overTemp || overDynP))
+        {
+            ShowWarning(rule.pFailureWav, ST_WarningCallout, rule.failureMsg.c_str(), true); // OK to force this here
+            *rule.pStatus = DoorStatus::DOOR_FAILED;
+            if (rule.failureAction == DoorFailureAction::JamDoor)
+                FailDoor(*rule.pProc, *rule.pAnim);
+            else if (rule.failureAction == DoorFailureAction::FailGear)
+                FailGear(true);     // also invokes FailDoor to show gear partially collapsed
+
+            if (pWarningLight)
+                *pWarningLight = true;
+            newdamage = true;
+        }
+        else if ((heatDamageEnabled && (surfaceTemp > warningTempK)) || (canFail && (dynP > rule.warningDynP)))
+        {
+            ShowWarning(rule.pWarningWav, ST_WarningCallout, rule.warningMsg.c_str());
+            if (pWarningLight)
+                *pWarningLight = true;
+        }
+        else if (pWarningLight)
+        {
+            *pWarningLight = false;   // reset light
+        }
+    }
 
     return newdamage;
 }
 
+// Build the door and hull surface damage tables for the doors and surfaces common to all XR vessels; invoked by our constructor.
+// Subclasses add rows for their own doors and surfaces from their constructors.
+void DeltaGliderXR1::InitDamageRules()
+{
+    char failureMsg[128], warningMsg[128];
+    sprintf(failureMsg, "%s FAILED due to excessive&heat and/or dynamic pressure!", NOSECONE_LABEL);
+    sprintf(warningMsg, "%s is open:&close it or reduce speed!", NOSECONE_LABEL);
+    AddDoorDamageRule(nose_status, nose_proc, m_noseconeTemp, nullptr, OPEN_NOSECONE_LIMIT,
+        &m_warningLights[static_cast<int>(WarningLight::wlNose)], DoorFailureAction::JamDoor, &anim_nose,
+        "Warning Nosecone Failure.wav", failureMsg, WARNING_NOSECONE_OPEN_WAV, warningMsg);
+
+    AddDoorDamageRule(rcover_status, rcover_proc, m_leftWingTemp, &m_rightWingTemp, RETRO_DOOR_LIMIT,
+        &m_warningLights[static_cast<int>(WarningLight::wlRdor)], DoorFailureAction::JamDoor, &anim_rcover,
+        "Warning Retro Door Failure.wav", "Retro Doors FAILED due to excessive&heat and/or dynamic pressure!",
+        "Warning Retro Doors Open.wav", "Retro Doors are open:&close them or reduce speed!");
+
+    AddDoorDamageRule(hatch_status, hatch_proc, m_cockpitTemp, nullptr, HATCH_OPEN_LIMIT,
+        &m_warningLights[static_cast<int>(WarningLight::wlHtch)], DoorFailureAction::JamDoor, &anim_hatch,
+        "Warning Hatch Failure.wav", "Top Hatch FAILED due to excessive&heat and/or dynamic pressure!",
+        "Warning Hatch Open.wav", "Top Hatch is open:&close it or reduce speed!");
+
+    AddDoorDamageRule(radiator_status, radiator_proc, m_topHullTemp, nullptr, RADIATOR_LIMIT,
+        &m_warningLights[static_cast<int>(WarningLight::wlRad)], DoorFailureAction::JamDoor, &anim_radiator,
+        "Warning Radiator Failure.wav", "Radiator FAILED due to excessive&heat and/or dynamic pressure!",
+        "Warning Radiator Deployed.wav", "Radiator is deployed:&stow it or reduce speed!");
+
+    // use nosecone temps to check gear-down damage
+    AddDoorDamageRule(gear_status, gear_proc, m_noseconeTemp, nullptr, GEAR_LIMIT,
+        &m_warningLights[static_cast<int>(WarningLight::wlGear)], DoorFailureAction::FailGear, nullptr,
+        "Warning Gear Failure.wav", "Landing Gear FAILED due to excessive&heat and/or dynamic pressure!",
+        "Warning Gear Deployed.wav", "Gear is deployed:&retract it or reduce speed!");
+
+    // the hover doors cannot fail, so we only warn about temperature for them; no warning light for hover doors since they can't be damaged for now
+    AddDoorDamageRule(hoverdoor_status, hoverdoor_proc, m_noseconeTemp, nullptr, 0, nullptr, DoorFailureAction::None, nullptr,
+        nullptr, nullptr, "Warning Hover Doors Open.wav", "Hover doors are open:&close them or reduce speed!");
+
+    // SCRAM doors cannot fail for heat or pressure, so don't check them
+
+    // The nosecone and lower hull limits also apply to the hover doors and landing gear bays.
+    // Checking these lower hull items separately will increase our chances of hull breach when more than one door is open; this is what we want!
+    AddHullBreachRule(m_noseconeTemp, &HullTemperatureLimits::noseCone, nose_status, "NOSECONE");
+    AddHullBreachRule(m_noseconeTemp, &HullTemperatureLimits::noseCone, hoverdoor_status, "LOWER HULL");
+    AddHullBreachRule(m_noseconeTemp, &HullTemperatureLimits::noseCone, gear_status, "LOWER HULL");
+    AddHullBreachRule(m_cockpitTemp, &HullTemperatureLimits::cockpit, hatch_status, "COCKPIT");   // the escape hatch is close to the cockpit
+
+    // Note: the XR1 does not have a payload bay, but it's OK to check it here for the purpose of subclasses
+    // top hull max temp is tied to: 1) radiators, and 2) bay doors
+    AddHullBreachRule(m_topHullTemp, &HullTemperatureLimits::topHull, radiator_status, "TOP HULL");
+    AddHullBreachRule(m_topHullTemp, &HullTemperatureLimits::topHull, bay_status, "TOP HULL");
+
+    m_pWingHeatingDoorStatus = &rcover_status;
+}
+
+void DeltaGliderXR1::AddDoorDamageRule(DoorStatus &status, double &proc, const double &surfaceTemp, const double *pSurfaceTemp2, const double failureDynP,
+    bool *pWarningLight, const DoorFailureAction failureAction, unsigned int *pAnim,
+    const char *pFailureWav, const char *pFailureMsg, const char *pWarningWav, const char *pWarningMsg)
+{
+    assert((failureAction != DoorFailureAction::JamDoor) || (pAnim != nullptr));
+
+    DoorDamageRule rule;
+    rule.pStatus = &status;
+    rule.pProc = &proc;
+    rule.pSurfaceTemp[0] = &surfaceTemp;
+    rule.pSurfaceTemp[1] = pSurfaceTemp2;
+    rule.failureDynP = failureDynP;
+    rule.warningDynP = failureDynP * DOOR_DYNAMIC_PRESSURE_WARNING_THRESHOLD;
+    rule.earlyOutDynP = std::min(failureDynP, rule.warningDynP);   // a fully-open door fails at failureDynP
+    rule.pWarningLight = pWarningLight;
+    rule.failureAction = failureAction;
+    rule.pAnim = pAnim;
+    rule.pFailureWav = pFailureWav;
+    rule.failureMsg = (pFailureMsg ? pFailureMsg : "");
+    rule.pWarningWav = pWarningWav;
+    rule.warningMsg = pWarningMsg;
+    m_doorDamageRules.push_back(rule);
+}
+
+void DeltaGliderXR1::AddHullBreachRule(const double &surfaceTemp, int HullTemperatureLimits::*pLimit, const DoorStatus &doorStatus, const char *pSurfaceName)
+{
+    m_hullBreachRules.push_back({ &surfaceTemp, pLimit, &doorStatus, pSurfaceName });
+}
+
 // Check whether ANY system is damaged. Invoked when loading or saving state.
 // Returns: true if any damage present, false if all systems green
 bool DeltaGliderXR1::IsDamagePresent() const
@@ -408,8 +541,7 @@ bool DeltaGliderXR1::IsDamagePresent() const
     // loop through all surfaces
     for (int i = 0; i <= static_cast<int>(D_END); i++)
     {
-        DamageStatus ds = GetDamageStatus((DamageItem)i);
-        if (ds.fracIntegrity < 1.0)
+        if (m_damageStatusTable[i].fracIntegrity < 1.0)
         {
             retVal = true;  // damage present
             break;
@@ -447,195 +579,25 @@ bool DeltaGliderXR1::IsWarningPresent() const
     return retVal;
 }
 
-// returns DamageStatus (a static variable)
-// This queries the actual SYSTEM STATE (e.g., current thrust output) to determine whether an item is damaged.
-const DamageStatus& DeltaGliderXR1::GetDamageStatus(DamageItem item) const
+// Refresh the cached damage status table from the actual system state.  This must be invoked whenever a damage integrity changes;
+// GetDamageStatus only reads the table.  Labels never change, so they are only filled in the first time.
+void DeltaGliderXR1::UpdateDamageStatusTable()
 {
-    double frac;
-    const char* pLabel = "???";
-    const char* pShortLabel = "???";
-    char tempLabel[8];
-    bool onlineOffline = true;     // assume online/offline
-
-    switch (item)
-    {
-    case DamageItem::LeftWing:
-        frac = lwingstatus;
-        pLabel = "Left Wing";
-        pShortLabel = "LWng";
-        onlineOffline = false;     // has partial failure
-        break;
-
-    case DamageItem::RightWing:
-        frac = rwingstatus;
-        pLabel = "Right Wing";
-        pShortLabel = "RWng";
-        onlineOffline = false;     // has partial failure
-        break;
-
-    case DamageItem::LeftAileron:
-        frac = ((aileronfail[0] | aileronfail[1]) ? 0 : 1);    // either mesh index 0 or 1 could be marked FAILED, so we must check both
-        pLabel = "Left Aileron";
-        pShortLabel = "LAil";
-        break;
-
-    case DamageItem::RightAileron:
-        frac = ((aileronfail[2] | aileronfail[3]) ? 0 : 1);    // either mesh index 2 or 3 could be marked FAILED, so we must check both
-        pLabel = "Right Aileron";
-        pShortLabel = "RAil";
-        break;
-
-    case DamageItem::LandingGear:
-        frac = ((gear_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
-        pLabel = "Landing Gear";
-        pShortLabel = "Gear";
-        break;
-
-    case DamageItem::Nosecone:
-        frac = ((nose_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
-        pLabel = NOSECONE_LABEL;
-        pShortLabel = NOSECONE_SHORT_LABEL;
-        break;
-
-    case DamageItem::RetroDoors:
-        frac = ((rcover_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
-        pLabel = "Retro Doors";
-        pShortLabel = "RDor";
-        break;
-
-    case DamageItem::Hatch:
-        frac = ((hatch_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
-        pLabel = "Top Hatch";
-        pShortLabel = "Htch";
-        break;
-
-    case DamageItem::Radiator:
-        frac = ((radiator_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
-        pLabel = "Radiator";
-        pShortLabel = "Rad";
-        break;
-
-    case DamageItem::Airbrake:
-        frac = ((brake_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
-        pLabel = "Airbrake";
-        pShortLabel = "Airb";
-        break;
-
-    case DamageItem::MainEngineLeft:
-    {
-        const double maxMainThrust = MAX_MAIN_THRUST[GetXR1Config()->MainEngineThrust];
-        frac = (maxMainThrust > 0 ? (GetThrusterMax0(th_main[0]) / MAX_MAIN_THRUST[GetXR1Config()->MainEngineThrust]) : 1.0);  // if max main thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
-        pLabel = "Left Main Engine";
-        pShortLabel = "LEng";
-        onlineOffline = false;     // has partial failure
-        break;
-    }
-
-    case DamageItem::MainEngineRight:
-    {
-        const double maxMainThrust = MAX_MAIN_THRUST[GetXR1Config()->MainEngineThrust];
-        frac = (maxMainThrust > 0 ? (GetThrusterMax0(th_main[1]) / MAX_MAIN_THRUST[GetXR1Config()->MainEngineThrust]) : 1.0);  // if max main thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
-        pLabel = "Right Main Engine";
-        pShortLabel = "REng";
-        onlineOffline = false;     // has partial failure
-        break;
-    }
-
-    case DamageItem::SCRAMEngineLeft:
-        frac = ramjet->GetEngineIntegrity(0);
-        pLabel = "Left SCRAM Engine";
-        pShortLabel = "LScr";
-        onlineOffline = false;     // has partial failure
-        break;
-
-    case DamageItem::SCRAMEngineRight:
-        frac = ramjet->GetEngineIntegrity(1);
-        pLabel = "Right SCRAM Engine";
-        pShortLabel = "RScr";
-        onlineOffline = false;     // has partial failure
-        break;
-
-    case DamageItem::HoverEngineFore:
-        // must make explicit check for damage here because we can vary the max thrust based on gimbaling
-        frac = m_hoverEngineIntegrity[0];
-        pLabel = "Fore Hover Engine";
-        pShortLabel = "FHov";
-        onlineOffline = false;     // has partial failure
-        break;
-
-    case DamageItem::HoverEngineAft:
-        // must make explicit check for damage here because we can vary the max thrust based on gimbaling
-        frac = m_hoverEngineIntegrity[1];
-        // can't do this: frac = GetThrusterMax0(th_hover[1]) / MAX_HOVER_THRUST[GetXR1Config()->HoverEngineThrust];
-        pLabel = "Aft Hover Engine";
-        pShortLabel = "AHov";
-        onlineOffline = false;     // has partial failure
-        break;
-
-    case DamageItem::RetroEngineLeft:
-        frac = (MAX_RETRO_THRUST > 0 ? (GetThrusterMax0(th_retro[0]) / MAX_RETRO_THRUST) : 1.0);    // if retro max thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
-        pLabel = "Left Retro Engine";
-        pShortLabel = "LRet";
-        onlineOffline = false;     // has partial failure
-        break;
-
-    case DamageItem::RetroEngineRight:
-        frac = (MAX_RETRO_THRUST > 0 ? (GetThrusterMax0(th_retro[1]) / MAX_RETRO_THRUST) : 1.0);    // if retro max thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
-        pLabel = "Right Retro Engine";
-        pShortLabel = "RRet";
-        onlineOffline = false;     // has partial failure
-        break;
-
-    case DamageItem::RCS1:
-    case DamageItem::RCS2:
-    case DamageItem::RCS3:
-    case DamageItem::RCS4:
-    case DamageItem::RCS5:
-    case DamageItem::RCS6:
-    case DamageItem::RCS7:
-    case DamageItem::RCS8:
-    case DamageItem::RCS9:
-    case DamageItem::RCS10:
-    case DamageItem::RCS11:
-    case DamageItem::RCS12:
-    case DamageItem::RCS13:
-    case DamageItem::RCS14:
-    {
-        int index = static_cast<int>(item) - static_cast<int>(DamageItem::RCS1);    // 0-13
-        // these are display names for the MDA screens, so keep the length reasonable
-        static const char* pLabels[] =
-        {
-            "Forward Lower RCS", "Aft Upper RCS", "Forward Upper RCS", "Aft Lower RCS",
-            "Forward Star. RCS", "Aft Port RCS", "Forward Port RCS", "Aft Star. RCS",
-            "Outboard Upper Port RCS", "Outboard Lower Star. RCS", "Outboard Upper Star. RCS", "Outboard Lower Port RCS",
-            "Aft RCS", "Forward RCS"
-        };
-
-        // for simplicity, we do not use RCS thrust as a damage indicator; we use in internal RCS array instead
-        frac = m_rcsIntegrityArray[index];  // internal array
-        pLabel = pLabels[index];
-        sprintf(tempLabel, "RCS%d", (index + 1));     // RCS1...RCS14
-        pShortLabel = tempLabel;
-        onlineOffline = false;     // has partial failure
-        break;
-    }
-
-    default:        // should never happen!
-        frac = 0;
-        pLabel = "???????";
-        pShortLabel = "????";
-        break;
-    }
-
-    // populate the structure
-    static DamageStatus dmgStatus;
-
-    dmgStatus.fracIntegrity = frac;
-    strcpy(dmgStatus.label, pLabel);
-    strcpy(dmgStatus.shortLabel, pShortLabel);
-    dmgStatus.onlineOffline = onlineOffline;
+    UpdateXR1DamageStatusTable(*this, m_damageStatusTable, m_damageStatusLabelsValid);
+}
 
-    return dmgStatus;   // return by reference
+// Populates 'status' for the given item; if includeLabels is false, only status.fracIntegrity is updated.
+// This queries the actual SYSTEM STATE (e.g., current thrust output) to determine whether an item is damaged.
+void DeltaGliderXR1::ComputeDamageStatus(DamageItem item, DamageStatus &status, const bool includeLabels) const
+{
+    ComputeXR1DamageStatus(*this, item, status, includeLabels);
+
+#ifdef _DEBUG
+    // must agree with the original uncached GetDamageStatus
+    const DamageStatus &legacy = LegacyGetXR1DamageStatus(*this, item);
+    assert(status.fracIntegrity == legacy.fracIntegrity);
+    assert(!includeLabels || ((strcmp(status.label, legacy.label) == 0) && (strcmp(status.shortLabel, legacy.shortLabel) == 0) && (status.onlineOffline == legacy.onlineOffline)));
+#endif
 }
 
 // check HULL temperature and issue warning if necessary
@@ -659,14 +621,11 @@ double DeltaGliderXR1::CheckTemperature(double tempK, double limitK, bool doorOp
 
         // fail the structure if necessary
         const double dt = oapiGetSimStep();     // # of seconds since last timestep
-        double exceededLimitMult = pow((tempK / limitK), 2);  // e.g. 1.21 = 10% over limit
-
-        // # of seconds at this temp / average terminal failure interval (8 secs)
-        double failureTimeFrac = dt / 8.0;
-        double failureProbability = failureTimeFrac * exceededLimitMult;
+        const double exceededLimitMult = pow((tempK / limitK), 2);  // e.g. 1.21 = 10% over limit
+        const double failureProbability = GetHeatDamageProbability(tempK, limitK, dt);
         // sprintf(oapiDebugString(), "Damage failureProbablity=%lf", failureProbability);
 
-        if (oapiRand() <= failureProbability)
+        if (RollHeatDamage(GetXRRandom(), failureProbability))
         {
             retVal = (exceededLimitMult - 1.0);
             ShowWarning("Warning heat damage.wav", ST_WarningCallout, "WARNING: HEAT DAMAGE!", true);  // OK to force this because it will not get called each frame
@@ -689,155 +648,6 @@ double DeltaGliderXR1::CheckTemperature(double tempK, double limitK, bool doorOp
     return retVal;  // remaining fraction is fraction over max heat; e.g., 0.2 = 20% over max heat value
 }
 
-// Fail a door if dynamic pressure exceeds limits, or issue a warning if a door is 
-// open and dynamic pressure is high enough, if heating == 25% of failure heat level.
-// Returns: true if door FAILED, false otherwise
-bool DeltaGliderXR1::CheckDoorFailure(DoorStatus* doorStatus)
-{
-    bool retVal = false;        // assume no damage
-
-    // do not re-check or warn if door already failed
-    bool doorOpen = ((*doorStatus != DoorStatus::DOOR_CLOSED) && (*doorStatus != DoorStatus::DOOR_FAILED));
-    const double dt = oapiGetSimStep();
-
-    if (doorOpen)
-    {
-        // Door is open!  Check for damage or failure.
-        // NOTE: once a door fails, it can only be repaired via the damage dialog; therefore, we never reset it here
-        double dynP = GetDynPressure();
-        if (doorStatus == &nose_status)
-        {
-            const double doorProc = nose_proc;
-            if (IS_DOOR_FAILURE(m_noseconeTemp, OPEN_NOSECONE_LIMIT))
-            {
-                char msg[128];
-                sprintf(msg, "%s FAILED due to excessive&heat and/or dynamic pressure!", NOSECONE_LABEL);
-                ShowWarning("Warning Nosecone Failure.wav", ST_WarningCallout, msg, true); // OK to force this here
-                *doorStatus = DoorStatus::DOOR_FAILED;
-                m_warningLights[static_cast<int>(WarningLight::wlNose)] = true;
-                FailDoor(nose_proc, anim_nose);
-                retVal = true;   // new damage
-            }
-            else if (IS_DOOR_WARNING(m_noseconeTemp, OPEN_NOSECONE_LIMIT))     // this will check temperature limit for hover doors as well
-            {
-                char msg[128];
-                sprintf(msg, "%s is open:&close it or reduce speed!", NOSECONE_LABEL);
-                ShowWarning(WARNING_NOSECONE_OPEN_WAV, ST_WarningCallout, msg);
-                m_warningLights[static_cast<int>(WarningLight::wlNose)] = true;
-            }
-            else if (IS_DOOR_FAILED() == false)
-                m_warningLights[static_cast<int>(WarningLight::wlNose)] = false;   // reset light
-        }
-        if (doorStatus == &hoverdoor_status)
-        {
-            // NOTE: the hover doors cannot fail due to dynamic pressure, so we only check them for temperature here via DOOR_WARNING
-            if ((IS_DOOR_FAILED() == false) && (OPEN_DOOR_WARN_TEMP(m_noseconeTemp)))
-            {
-                ShowWarning("Warning Hover Doors Open.wav", ST_WarningCallout, "Hover doors are open:&close them or reduce speed!");
-                // no warning light for hover doors since they can't be damaged for now
-            }
-        }
-        else if (doorStatus == &rcover_status)
-        {
-            const double doorProc = rcover_proc;
-
-            if (IS_DOOR_FAILURE(m_leftWingTemp, RETRO_DOOR_LIMIT) ||
-                IS_DOOR_FAILURE(m_rightWingTemp, RETRO_DOOR_LIMIT))
-            {
-                ShowWarning("Warning Retro Door Failure.wav", ST_WarningCallout, "Retro Doors FAILED due to excessive&heat and/or dynamic pressure!", true); // force this
-                *doorStatus = DoorStatus::DOOR_FAILED;
-                m_warningLights[static_cast<int>(WarningLight::wlRdor)] = true;
-                FailDoor(rcover_proc, anim_rcover);
-                retVal = true;   // new damage
-            }
-            else if (IS_DOOR_WARNING(m_leftWingTemp, RETRO_DOOR_LIMIT) ||
-                IS_DOOR_WARNING(m_rightWingTemp, RETRO_DOOR_LIMIT))
-            {
-                ShowWarning("Warning Retro Doors Open.wav", ST_WarningCallout, "Retro Doors are open:&close them or reduce speed!");
-                m_warningLights[static_cast<int>(WarningLight::wlRdor)] = true;
-            }
-            else if (IS_DOOR_FAILED() == false)
-                m_warningLights[static_cast<int>(WarningLight::wlRdor)] = false;   // reset light
-        }
-        else if (doorStatus == &hatch_status)
-        {
-            const double doorProc = hatch_proc;
-
-            if (IS_DOOR_FAILURE(m_cockpitTemp, HATCH_OPEN_LIMIT))
-            {
-                ShowWarning("Warning Hatch Failure.wav", ST_WarningCallout, "Top Hatch FAILED due to excessive&heat and/or dynamic pressure!", true); // force this
-                *doorStatus = DoorStatus::DOOR_FAILED;
-                m_warningLights[static_cast<int>(WarningLight::wlHtch)] = true;
-                FailDoor(hatch_proc, anim_hatch);
-                retVal = true;   // new damage
-            }
-            else if (IS_DOOR_WARNING(m_cockpitTemp, HATCH_OPEN_LIMIT))
-            {
-                ShowWarning("Warning Hatch Open.wav", ST_WarningCallout, "Top Hatch is open:&close it or reduce speed!");
-                m_warningLights[static_cast<int>(WarningLight::wlHtch)] = true;
-            }
-            else if (IS_DOOR_FAILED() == false)
-                m_warningLights[static_cast<int>(WarningLight::wlHtch)] = false;   // reset light
-        }
-        else if (doorStatus == &radiator_status)
-        {
-            const double doorProc = radiator_proc;
-            if (IS_DOOR_FAILURE(m_topHullTemp, RADIATOR_LIMIT))
-            {
-                ShowWarning("Warning Radiator Failure.wav", ST_WarningCallout, "Radiator FAILED due to excessive&heat and/or dynamic pressure!", true); // force this
-                *doorStatus = DoorStatus::DOOR_FAILED;
-                m_warningLights[static_cast<int>(WarningLight::wlRad)] = true;
-                FailDoor(radiator_proc, anim_radiator);
-                retVal = true;   // new damage
-            }
-            else if (IS_DOOR_WARNING(m_topHullTemp, RADIATOR_LIMIT))
-            {
-                ShowWarning("Warning Radiator Deployed.wav", ST_WarningCallout, "Radiator is deployed:&stow it or reduce speed!");
-                m_warningLights[static_cast<int>(WarningLight::wlRad)] = true;
-            }
-            else if (IS_DOOR_FAILED() == false)
-                m_warningLights[static_cast<int>(WarningLight::wlRad)] = false;   // reset light
-        }
-        else if (doorStatus == &gear_status)
-        {
-            const double doorProc = gear_proc;
-
-            // use nosecone temps to check gear-down damage
-            if (IS_DOOR_FAILURE(m_noseconeTemp, GEAR_LIMIT))
-            {
-                ShowWarning("Warning Gear Failure.wav", ST_WarningCallout, "Landing Gear FAILED due to excessive&heat and/or dynamic pressure!", true); // force this
-                *doorStatus = DoorStatus::DOOR_FAILED;
-                FailGear(true);     // also invoke FailDoor to show gear partially collapsed
-                m_warningLights[static_cast<int>(WarningLight::wlGear)] = true;
-                retVal = true;   // new damage
-            }
-            else if (IS_DOOR_WARNING(m_noseconeTemp, GEAR_LIMIT))
-            {
-                ShowWarning("Warning Gear Deployed.wav", ST_WarningCallout, "Gear is deployed:&retract it or reduce speed!");
-                m_warningLights[static_cast<int>(WarningLight::wlGear)] = true;
-            }
-            else if (IS_DOOR_FAILED() == false)
-                m_warningLights[static_cast<int>(WarningLight::wlGear)] = false;   // reset light
-        }
-    }
-    else if (IS_DOOR_FAILED() == false)
-    {
-        // door is closed; reset the warning light
-        if (doorStatus == &nose_status)
-            m_warningLights[static_cast<int>(WarningLight::wlNose)] = false;
-        else if (doorStatus == &rcover_status)
-            m_warningLights[static_cast<int>(WarningLight::wlRdor)] = false;
-        else if (doorStatus == &hatch_status)
-            m_warningLights[static_cast<int>(WarningLight::wlHtch)] = false;
-        else if (doorStatus == &radiator_status)
-            m_warningLights[static_cast<int>(WarningLight::wlRad)] = false;
-        else if (doorStatus == &gear_status)
-            m_warningLights[static_cast<int>(WarningLight::wlGear)] = false;
-    }
-
-    return retVal;
-}
-
 // check SCRAM ENGINE temperature and issue warning if necessary
 // returns 0 if OK, > 0 = % max temperature exceeded^2 * 2; e.g., 0.42 = 10% over limit
 double DeltaGliderXR1::CheckScramTemperature(double tempK, double limitK)
@@ -853,13 +663,10 @@ double DeltaGliderXR1::CheckScramTemperature(double tempK, double limitK)
         // fail the engines if necessary
         const double dt = oapiGetSimStep();     // # of seconds since last timestep
         const double exceededLimitMult = pow((tempK / limitK), 2);  // e.g. 1.21 = 10% over limit
-
-        // # of seconds at this temp / average engine failure interval (8 secs)
-        double failureTimeFrac = dt / 8.0;
-        double failureProbability = failureTimeFrac * exceededLimitMult;
+        const double failureProbability = GetHeatDamageProbability(tempK, limitK, dt);   // average engine failure interval is also 8 secs
         // sprintf(oapiDebugString(), "SCRAM Damage failureProbablity=%lf", failureProbability);
 
-        if (oapiRand() <= failureProbability)
+        if (RollHeatDamage(GetXRRandom(), failureProbability))
         {
             retVal = ((exceededLimitMult - 1.0) * 2); // e.g., 0.42 = 10% over limit
             ShowWarning("Warning SCRAM Engine Damage.wav", ST_WarningCallout, "WARNING: SCRAM ENGINE HEAT&DAMAGE! CLOSE THE SCRAM DOORS!", true);  // OK to force this because it will not get called each frame
@@ -120,7 +120,7 @@ void RotateWheelsPreStep::clbkPrePostStep(const double simt, const double simdt,
 void RotateWheelsPreStep::SetWheelRotVel(const double simdt, const double groundSpeed, const bool isWheelOnGround, double &wheelRotationVelocity)
 {
     // add +/-20% randomness in here
-    const double decelerationRate = TIRE_DECELERATION_RATE * (0.8 + (oapiRand() *.40));
+    const double decelerationRate = TIRE_DECELERATION_RATE * (0.8 + (GetXR1().XRRand() *.40));
     double tireSpinDecel = (decelerationRate * simdt);  // in m/s for this timestep
     if (wheelRotationVelocity < 0)
         tireSpinDecel = -tireSpinDecel;     // always move speed toward zero
@@ -28,7 +28,9 @@
 // ==============================================================
 
 #include "TextBox.h"
-#include "DeltaGliderXR1.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 
 // base class for all TextBox objects
 // screenLineCount = # of text lines on the screen
@@ -45,70 +47,73 @@ TextBox::TextBox(int width, int height, uint32_t normalTextColor, uint32_t highl
 // lineSpacing = # of pixels between screen lines
 // startingLineNumber = starting line # in buffer, 1-based; if <= 0, renders full screen starting from bottom
 // Returns: true if text re-rendered, false if text is unchanged since last render
+//
+// Our callers' areas are registered with PANEL_MAP_BACKGROUND, so the surface is reset to the panel background before every redraw
+// and all visible lines must be drawn again whenever anything changed.  Sketchpad state is therefore set up once per render and the
+// text color is only changed when it differs from the previous line's.
 bool TextBox::Render(oapi::Sketchpad *skp, int topY, oapi::Font *font, int lineSpacing, bool forceRender, int startingLineNumber)
 {
-    bool retVal = false;        // assume NOT re-rendered
-
     const int currentAddLinesCount = m_textLineGroup.GetAddLinesCount();
-    if (forceRender || (currentAddLinesCount != m_lastRenderedAddLinesCount))
-    {
-        m_lastRenderedAddLinesCount = currentAddLinesCount;     // remember this
+    if (!forceRender && (currentAddLinesCount == m_lastRenderedAddLinesCount))
+        return false;   // text is unchanged
 
-        // text has changed; must re-render this box
-        retVal = true;        
+    m_lastRenderedAddLinesCount = currentAddLinesCount;     // remember this
 
-        oapi::Font *prevFont = skp->SetFont(font);
-        if (m_bgColor == CWHITE)
-        {
-            skp->SetBackgroundMode(oapi::Sketchpad::BK_TRANSPARENT);
-        }
+    // figure out which line at which to begin rendering
+    const int bufferLineCount = m_textLineGroup.GetLineCount();   // current # of lines in the buffer
+    if (startingLineNumber <= 0)
+    {
+        // user wants a full screen starting from the end
+        if (m_screenLineCount >= bufferLineCount)
+            startingLineNumber = 1; // entire buffer fits on screen
         else
-        {
-            skp->SetBackgroundMode(oapi::Sketchpad::BK_OPAQUE);
-            skp->SetBackgroundColor(m_bgColor);
-        }
+            startingLineNumber = bufferLineCount - m_screenLineCount + 1;    // bottom n lines in buffer (index is 1-based)
+    }
+    else if (startingLineNumber > bufferLineCount)   // out-of-range?
+        return false;     // can't render anything (don't want to throw exception here b/c we don't want to CTD for this)
 
-        skp->SetTextAlign(oapi::Sketchpad::LEFT);
+    // text has changed; must re-render this box
+    oapi::Font *prevFont = skp->SetFont(font);
+    if (m_bgColor == CWHITE)
+    {
+        skp->SetBackgroundMode(oapi::Sketchpad::BK_TRANSPARENT);
+    }
+    else
+    {
+        skp->SetBackgroundMode(oapi::Sketchpad::BK_OPAQUE);
+        skp->SetBackgroundColor(m_bgColor);
+    }
 
-        int cy = topY + 1;  // top spacing
-        int cx = 3;         // left side spacing
+    skp->SetTextAlign(oapi::Sketchpad::LEFT);
 
-        // render each line in the buffer, starting at the top
-        int lineCount = 0;
+    int cy = topY + 1;  // top spacing
+    const int cx = 3;   // left side spacing
 
-        // figure out which line at which to begin rendering
-        const int bufferLineCount = m_textLineGroup.GetLineCount();   // current # of lines in the buffer
-        if (startingLineNumber <= 0)
-        {
-            // user wants a full screen starting from the end
-            if (m_screenLineCount >= bufferLineCount)
-                startingLineNumber = 1; // entire buffer fits on screen
-            else
-                startingLineNumber = bufferLineCount - m_screenLineCount + 1;    // bottom n lines in buffer (index is 1-based)
-        }
-        else if (startingLineNumber > bufferLineCount)   // out-of-range?
-            return false;     // can't render anything (don't want to throw exception here b/c we don't want to CTD for this)
+    // render each line in the buffer, starting at the top; lines have a 0-based index
+    const int startingLineIndex = startingLineNumber-1;     // 0-based
+    const int endingLineIndex = min(startingLineIndex + m_screenLineCount, bufferLineCount);   // EXCLUSIVE
+    bool isTextColorSet = false;
+    TEXTCOLOR textColor = TEXTCOLOR::Normal;    // valid only if isTextColorSet
+    for (int i = startingLineIndex; i < endingLineIndex; i++)
+    {
+        const TextLine &line = m_textLineGroup.GetLine(i);
 
-        // loop thorough lines in vector, which has 0-based index
-        const int startingLineIndex = startingLineNumber-1;     // 0-based
-        const int endingLineIndex = min(startingLineIndex + m_screenLineCount, bufferLineCount);   // EXCLUSIVE
-        for (int i = startingLineIndex; i < endingLineIndex; i++)
+        if (!isTextColorSet || (line.color != textColor))
         {
-            const TextLine &line = m_textLineGroup.GetLine(i);
-            const char *pText = line.text.c_str();
-
             skp->SetTextColor((line.color == TEXTCOLOR::Normal ? m_normalTextColor : m_highlightTextColor));
-            skp->Text(cx, cy, pText, static_cast<int>(line.text.length()));
-
-            // drop to next line
-            cy += lineSpacing;
+            textColor = line.color;
+            isTextColorSet = true;
         }
+        skp->Text(cx, cy, line.text, line.length);
 
-        // restore previous font
-        skp->SetFont(prevFont);
+        // drop to next line
+        cy += lineSpacing;
     }
 
-    return retVal;
+    // restore previous font
+    skp->SetFont(prevFont);
+
+    return true;
 }
 
 
@@ -117,63 +122,59 @@ bool TextBox::Render(oapi::Sketchpad *skp, int topY, oapi::Font *font, int lineS
 // Constructor
 // maxLines = maximum # of lines to preserve in this line group; after full, the oldest line will be discarded
 TextLineGroup::TextLineGroup(const int maxLines) :
-    m_maxLines(maxLines), m_addLinesCount(0)
+    m_maxLines(maxLines), m_addLinesCount(0), m_lines(maxLines), m_firstLine(0), m_lineCount(0)
 {
+    assert(maxLines > 0);
 }
 
 TextLineGroup::~TextLineGroup()
 {
-    // free all TextLine objects in the buffer
-    for (unsigned int i=0; i < m_lines.size(); i++)
-        delete m_lines[i];
 }
 
-
 // Add lines of text to the HUD; newlines are denoted by the "&" character
 // highlighted = to render in highlighted color or normal color
 void TextLineGroup::AddLines(const char *pStr, bool highlighted)
 {
     m_addLinesCount++;      // text has changed now
 
-    // mark a working copy and parse it into separate lines
-    char temp[MAX_MESSAGE_LENGTH];
-    strcpy(temp, pStr);
-
-    char *pStart = temp;
-    bool cont = true;
-    while (cont)
+    const TEXTCOLOR color = (highlighted ? TEXTCOLOR::Highlighted : TEXTCOLOR::Normal);
+    const char *pStart = pStr;
+    for (;;)
     {
-        char *pEnd = strchr(pStart, '&');
-        if (pEnd)   // found a newline?
+        const char *pEnd = strchr(pStart, '&');
+        if (pEnd == nullptr)   // this is the last line
         {
-            *pEnd = 0;     // terminate line
+            AddLine(pStart, static_cast<int>(strlen(pStart)), color);
+            break;
         }
-        else
-            cont = false;   // this is the last line
-
-        TextLine textLine(pStart, (highlighted ? TEXTCOLOR::Highlighted : TEXTCOLOR::Normal));
-        AddLine(textLine);
 
-        if (pEnd)
-            pStart = pEnd + 1;  // set to start of next line
+        AddLine(pStart, static_cast<int>(pEnd - pStart), color);
+        pStart = pEnd + 1;  // start of next line
     }
 }
 
-// Add a line to the buffer, removing the oldest line in the buffer if necessary
-// textLine will be cloned internally by the vector's push_back method
-void TextLineGroup::AddLine(const TextLine &textLine)
+// Add a line to the buffer, overwriting the oldest line in the buffer if necessary
+void TextLineGroup::AddLine(const char *pText, const int length, const TEXTCOLOR color)
 {
-    // lines are stored oldest -> newest; i.e., index #0 has oldest line
-    m_lines.push_back(new TextLine(textLine));  // clone incoming line object
-
-    int lineCount = GetLineCount();
-    if (lineCount > m_maxLines)
+    // lines are stored oldest -> newest; i.e., line #0 is the oldest
+    int slot;
+    if (m_lineCount < m_maxLines)
     {
-        lineCount = m_maxLines;  // keep in range
-        // New code
-        // Delete the oldest item in the list (at the front)
-        delete m_lines[0];               // free TextLine object
-        m_lines.erase(m_lines.begin());  // ...and remove the line ptr from the vector
+        slot = m_firstLine + m_lineCount++;
+        if (slot >= m_maxLines)
+            slot -= m_maxLines;
+    }
+    else
+    {
+        // buffer is full: the oldest line is replaced by the new one
+        slot = m_firstLine;
+        if (++m_firstLine == m_maxLines)
+            m_firstLine = 0;
     }
-}
 
+    TextLine &line = m_lines[slot];
+    line.length = min(length, TextLine::MAX_LENGTH);
+    memcpy(line.text, pText, line.length);
+    line.text[line.length] = 0;
+    line.color = color;
+}
@@ -39,47 +39,36 @@ using namespace std;
 
 enum class TEXTCOLOR { Normal, Highlighted };
 
-// line of text to be added to buffer
+// line of text in a TextLineGroup; longer lines are truncated
 struct TextLine
 {
-    // Normal constructor
-    TextLine(const char *pText, TEXTCOLOR color) 
-    {
-        this->text = pText;
-        this->color = color;
-    }
-
-    // NOTE: A copy constructor is required by the 'vector' class.
-    TextLine(const TextLine &that) 
-    {
-        text = that.text;
-        color = that.color;
-    }
+    static constexpr int MAX_LENGTH = 127;  // not including the terminator
 
-    string text;                // text itself
-    TEXTCOLOR color;      // color of line to be rendered
-
-    bool operator=(const TextLine &that) 
-    { 
-        return ((text == that.text) && (color == that.color));
-    }
+    char text[MAX_LENGTH + 1];  // text itself
+    int length;                 // strlen(text)
+    TEXTCOLOR color;            // color of line to be rendered
 };
 
-// Manages a group of TextLine objects; this is the primary public object for populating a TextBox
+// Manages a group of TextLine objects; this is the primary public object for populating a TextBox.
+// Lines are stored in a fixed-size ring buffer that is allocated once, so adding a line never allocates
+// or moves any other lines.
 class TextLineGroup
 {
 public:
     TextLineGroup(const int maxLines);
     virtual ~TextLineGroup();
 
-    int GetLineCount() const { return static_cast<int>(m_lines.size()); }
-    void Clear() { m_lines.clear(); }
-
-    // retrives lines in buffer
-    const vector<const TextLine *> &GetLines() const { return m_lines; } 
+    int GetLineCount() const { return m_lineCount; }
+    void Clear() { m_firstLine = m_lineCount = 0; }
 
-    // retrieves a single line from the buffer
-    const TextLine &GetLine(const int index) const { return *m_lines[index]; }
+    // retrieves a single line from the buffer; index 0 is the oldest line
+    const TextLine &GetLine(const int index) const
+    {
+        int slot = m_firstLine + index;
+        if (slot >= m_maxLines)
+            slot -= m_maxLines;
+        return m_lines[slot];
+    }
 
     // Returns how many times AddLines has been invoked; useful to determine whether
     // text has changed since the last check.
@@ -89,10 +78,12 @@ public:
     virtual void AddLines(const char *pStr, bool highlighted);
 
 protected:
-    void AddLine(const TextLine &textLine);
+    void AddLine(const char *pText, const int length, const TEXTCOLOR color);
     const int m_maxLines;
     int m_addLinesCount;   // total # of times AddLines invoked
-    vector<const TextLine *> m_lines;  // uses TextLine ptrs for 1) efficiency, and 2) so that vector.erase works
+    vector<TextLine> m_lines;   // ring buffer of m_maxLines lines
+    int m_firstLine;            // index in m_lines of the oldest line
+    int m_lineCount;            // # of lines in use
 };
 
 //-------------------------------------------------------------------------
@@ -40,18 +40,5 @@ public:
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
 
 protected:
-    void AnimateLadder      (const double simt, const double simdt, const double mjd);
-    void AnimateNosecone    (const double simt, const double simdt, const double mjd);
-    void AnimateOuterAirlock(const double simt, const double simdt, const double mjd);
-    void AnimateInnerAirlock(const double simt, const double simdt, const double mjd);
-    void AnimateHatch       (const double simt, const double simdt, const double mjd);
-    void AnimateRadiator    (const double simt, const double simdt, const double mjd);
-    void AnimateRetroDoors  (const double simt, const double simdt, const double mjd);
-    void AnimateHoverDoors  (const double simt, const double simdt, const double mjd);
-    void AnimateScramDoors  (const double simt, const double simdt, const double mjd);
-    void AnimateGear        (const double simt, const double simdt, const double mjd);
-    void AnimateAirbrake    (const double simt, const double simdt, const double mjd);
-    void ManageChamberPressure(const double simt, const double simdt, const double mjd);
-    void AnimateFuelHatch   (const double simt, const double simdt, const double mjd);
-    void AnimateLOXHatch    (const double simt, const double simdt, const double mjd);
+    void ManageHatchVenting(const double simt);
 };
@@ -30,53 +30,45 @@
 #include "DeltaGliderXR1.h"
 //#include "meshres.h"
 #include "../DeltaGliderXR1/meshres.h"
+#include <cassert>
+#include <cmath>
+#include <limits>
 
-// Virtual Gateway method that decides which animations are valid for this vessel; if the incoming animation handle is valid, 
-// the call is propogated up to SetAnimation.  Otherwise, this method returns without changing the animation state.
-// [This check is necessary because if we call SetAnimation with an invalid handle (e.g., 0) the Orbiter core animates the wrong groups or crashes.]
-#define ALLOW(handlePtr)  if (&anim == &(handlePtr)) { SetAnimation(anim, state); return; }
+// Gateway for all animation state changes.  Only animations registered via RegisterXRAnimation are valid for this vessel;
+// the call is ignored for any other handle.  [This check is necessary because if we call SetAnimation with an invalid handle
+// (e.g., 0) the Orbiter core animates the wrong groups or crashes.]
+// Orbiter animation handles are small sequential indices, so the table is indexed directly by the handle, and the registered
+// member's address confirms that 'anim' is the handle that was registered.  SetAnimation is skipped if the state has not
+// changed since it was last applied, so doors sitting fully open or closed cost nothing each frame.
 void DeltaGliderXR1::SetXRAnimation(const unsigned int &anim, const double state) const
 {
-    ALLOW(anim_gear);         // handle for landing gear animation
-	ALLOW(anim_rcover);       // handle for retro cover animation
-    ALLOW(anim_hoverdoor);    // handle for hover doors animation
-    ALLOW(anim_scramdoor);    // handle for scram doors animation
-	ALLOW(anim_nose);         // handle for nose cone animation
-	ALLOW(anim_ladder);       // handle for front escape ladder animation
-	ALLOW(anim_olock);        // handle for outer airlock animation
-	ALLOW(anim_ilock);        // handle for inner airlock animation
-	ALLOW(anim_hatch);        // handle for top hatch animation
-	ALLOW(anim_radiator);     // handle for radiator animation
-	ALLOW(anim_rudder);       // handle for rudder animation
-	ALLOW(anim_elevator);     // handle for elevator animation
-	ALLOW(anim_elevatortrim); // handle for elevator trim animation
-	ALLOW(anim_laileron);     // handle for left aileron animation
-	ALLOW(anim_raileron);     // handle for right aileron animation
-	ALLOW(anim_brake);        // handle for airbrake animation
+    if (anim >= m_xrAnimationTable.size())
+        return;
 
-	ALLOW(anim_mainthrottle[0]);   // VC main/retro throttle levers (left and right)
-    ALLOW(anim_mainthrottle[1]);   // VC main/retro throttle levers (left and right)
-	ALLOW(anim_hoverthrottle);     // VC hover throttle
-	ALLOW(anim_scramthrottle[0]);  // VC scram throttle levers (left and right)
-    ALLOW(anim_scramthrottle[1]);  // VC scram throttle levers (left and right)
-	ALLOW(anim_gearlever);         // VC gear lever
-	ALLOW(anim_nconelever);        // VC nose cone lever
-	ALLOW(anim_pmaingimbal[0]);    // VC main engine pitch gimbal switch (left and right engine)
-    ALLOW(anim_pmaingimbal[1]);    // VC main engine pitch gimbal switch (left and right engine)
-	ALLOW(anim_ymaingimbal[0]);    // VC main engine yaw gimbal switch (left and right engine)
-    ALLOW(anim_ymaingimbal[1]);    // VC main engine yaw gimbal switch (left and right engine)
-	ALLOW(anim_scramgimbal[0]);    // VC scram engine pitch gimbal switch (left and right engine)
-    ALLOW(anim_scramgimbal[1]);    // VC scram engine pitch gimbal switch (left and right engine)
-	ALLOW(anim_hbalance);          // VC hover balance switch
-	ALLOW(anim_hudintens);         // VC HUD intensity switch
-	ALLOW(anim_rcsdial);           // VC RCS dial animation
-	ALLOW(anim_afdial);            // VC AF dial animation
-	ALLOW(anim_olockswitch);       // VC outer airlock switch animation
-	ALLOW(anim_ilockswitch);       // VC inner airlock switch animation
-	ALLOW(anim_retroswitch);       // VC retro cover switch animation
-	ALLOW(anim_ladderswitch);      // VC ladder switch animation
-	ALLOW(anim_hatchswitch);       // VC hatch switch animation
-	ALLOW(anim_radiatorswitch);    // VC radiator switch animation
+    XRAnimationSlot &slot = m_xrAnimationTable[anim];
+    if (slot.pHandle != &anim)
+        return;     // not valid for this vessel
+
+    if (fabs(state - slot.lastState) < XR_ANIMATION_STATE_EPSILON)
+    {
+        m_skippedXRAnimationCount++;
+        return;
+    }
+
+    slot.lastState = state;
+    SetAnimation(anim, state);
+}
+
+// Mark an animation as valid for this vessel; invoked by DefineAnimations after the handle is created.
+void DeltaGliderXR1::RegisterXRAnimation(const unsigned int &anim)
+{
+    if (anim >= m_xrAnimationTable.size())
+        m_xrAnimationTable.resize(anim + 1, { nullptr, 0 });
+
+    XRAnimationSlot &slot = m_xrAnimationTable[anim];
+    assert((slot.pHandle == nullptr) || (slot.pHandle == &anim));    // each handle belongs to exactly one member
+    slot.pHandle = &anim;
+    slot.lastState = numeric_limits<double>::quiet_NaN();   // state is unknown, so the first SetXRAnimation is always applied
 }
 
 // --------------------------------------------------------------
@@ -505,6 +497,48 @@ void DeltaGliderXR1::DefineAnimations()
         _V(0.2592,0.9517,7.2252), _V(-0.7590,-0.231,0.6087), static_cast<float>(31*RAD));
     anim_radiatorswitch = CreateAnimation (1);
     AddAnimationComponent (anim_radiatorswitch, 0, 1, &RadiatorSwitch);
+
+    // Only these animations are valid for this vessel; SetXRAnimation ignores all others.
+    RegisterXRAnimation(anim_gear);         // handle for landing gear animation
+    RegisterXRAnimation(anim_rcover);       // handle for retro cover animation
+    RegisterXRAnimation(anim_hoverdoor);    // handle for hover doors animation
+    RegisterXRAnimation(anim_scramdoor);    // handle for scram doors animation
+    RegisterXRAnimation(anim_nose);         // handle for nose cone animation
+    RegisterXRAnimation(anim_ladder);       // handle for front escape ladder animation
+    RegisterXRAnimation(anim_olock);        // handle for outer airlock animation
+    RegisterXRAnimation(anim_ilock);        // handle for inner airlock animation
+    RegisterXRAnimation(anim_hatch);        // handle for top hatch animation
+    RegisterXRAnimation(anim_radiator);     // handle for radiator animation
+    RegisterXRAnimation(anim_rudder);       // handle for rudder animation
+    RegisterXRAnimation(anim_elevator);     // handle for elevator animation
+    RegisterXRAnimation(anim_elevatortrim); // handle for elevator trim animation
+    RegisterXRAnimation(anim_laileron);     // handle for left aileron animation
+    RegisterXRAnimation(anim_raileron);     // handle for right aileron animation
+    RegisterXRAnimation(anim_brake);        // handle for airbrake animation
+
+    RegisterXRAnimation(anim_mainthrottle[0]);   // VC main/retro throttle levers (left and right)
+    RegisterXRAnimation(anim_mainthrottle[1]);   // VC main/retro throttle levers (left and right)
+    RegisterXRAnimation(anim_hoverthrottle);     // VC hover throttle
+    RegisterXRAnimation(anim_scramthrottle[0]);  // VC scram throttle levers (left and right)
+    RegisterXRAnimation(anim_scramthrottle[1]);  // VC scram throttle levers (left and right)
+    RegisterXRAnimation(anim_gearlever);         // VC gear lever
+    RegisterXRAnimation(anim_nconelever);        // VC nose cone lever
+    RegisterXRAnimation(anim_pmaingimbal[0]);    // VC main engine pitch gimbal switch (left and right engine)
+    RegisterXRAnimation(anim_pmaingimbal[1]);    // VC main engine pitch gimbal switch (left and right engine)
+    RegisterXRAnimation(anim_ymaingimbal[0]);    // VC main engine yaw gimbal switch (left and right engine)
+    RegisterXRAnimation(anim_ymaingimbal[1]);    // VC main engine yaw gimbal switch (left and right engine)
+    RegisterXRAnimation(anim_scramgimbal[0]);    // VC scram engine pitch gimbal switch (left and right engine)
+    RegisterXRAnimation(anim_scramgimbal[1]);    // VC scram engine pitch gimbal switch (left and right engine)
+    RegisterXRAnimation(anim_hbalance);          // VC hover balance switch
+    RegisterXRAnimation(anim_hudintens);         // VC HUD intensity switch
+    RegisterXRAnimation(anim_rcsdial);           // VC RCS dial animation
+    RegisterXRAnimation(anim_afdial);            // VC AF dial animation
+    RegisterXRAnimation(anim_olockswitch);       // VC outer airlock switch animation
+    RegisterXRAnimation(anim_ilockswitch);       // VC inner airlock switch animation
+    RegisterXRAnimation(anim_retroswitch);       // VC retro cover switch animation
+    RegisterXRAnimation(anim_ladderswitch);      // VC ladder switch animation
+    RegisterXRAnimation(anim_hatchswitch);       // VC hatch switch animation
+    RegisterXRAnimation(anim_radiatorswitch);    // VC radiator switch animation
 }
 
 // delete any child animation objects; invoked by our destructor
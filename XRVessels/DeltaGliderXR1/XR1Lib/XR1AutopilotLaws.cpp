@@ -0,0 +1,433 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1AutopilotLaws.cpp
+// Control laws for the attitude hold, descent hold, and airspeed hold
+// autopilots.
+// ==============================================================
+
+#include "XR1AutopilotLaws.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+double XR1AutopilotLaws::TargetAngularVelocity(const double degreesDelta, const double angVelLimit, const double minAngVel, const bool reverseRotation, const double simdt, const XR1AutopilotGains &gains)
+{
+    // if degreesDelta is NEGATIVE, we want a POSITIVE targetAngVel to counteract it unless the REVERSE flag is set
+    // NOTE: do not reduce this too much, or the autopilot cannot hold a given angle precisely enough!
+    // However, if it is too high the ship will oscillate due to too much thrust.
+    // NOTE: this is value #1 to tweak if you want to fine-tune time acc behavior and accuracy
+    double targetAngVel = degreesDelta * gains.AngularVelocityDegreesDeltaFrac;  // rotation rate in degrees per second to reach target in reasonable time
+
+    // enforce the minimum rotation rate, if any
+    if (targetAngVel < 0)
+    {
+        if (targetAngVel > -minAngVel)
+            targetAngVel = -minAngVel;
+    }
+    else  // targetAngVel >= 0
+    {
+        if (targetAngVel < minAngVel)
+            targetAngVel = minAngVel;
+    }
+
+    // NOTE: must allow target angular velocity to reach zero here!  This is what determines whether we rotate or not.
+
+    // reverse rotation if requested (i.e., for pitch)
+    if (reverseRotation == false)
+        targetAngVel = -targetAngVel;
+
+    // check upper rotation limit (no lower limit, since we want rotation to stop once we reach our target)
+    if (targetAngVel > angVelLimit)
+        targetAngVel = angVelLimit;
+    else if (targetAngVel < -angVelLimit)
+        targetAngVel = -angVelLimit;
+
+    // Don't request a rotation rate that would carry us past the target attitude before the next timestep.  We allow only a third of the
+    // distance to the target here because the ship keeps rotating while the jets brake during the following timestep; any more and the
+    // attitude swings past the target when a single timestep spans several seconds.
+    return LimitRateForTimestep(targetAngVel, degreesDelta / 3, simdt);
+}
+
+double XR1AutopilotLaws::ExternalAngularAcc(const double angularAcc, const double jetAngularAcc)
+{
+    return angularAcc - jetAngularAcc;
+}
+
+double XR1AutopilotLaws::AttitudeThrustLevel(const double angVelError, const double externalAngularAcc, const double masterThrustFrac, const bool descentHoldActive,
+    const double maxPositiveAngularAcc, const double maxNegativeAngularAcc, const double simdt, const XR1AutopilotGains &gains)
+{
+    // reduce thrust level if we are close to our angular velocity target already
+    // NOTE: this is the primary setting to control negative RCS thrust levels when we overshoot the target angular velocity
+    // Descent hold must be more aggressive in holding attitude while hovering.
+    const double taper = (descentHoldActive ? gains.DescentAttitudeRateTaper : gains.AttitudeRateTaper);
+    double thLevel = masterThrustFrac * min(1.0, fabs(angVelError) / taper);
+    if (angVelError < 0)
+        thLevel = -thLevel;
+
+    // Push back against the external acceleration as well, using the jets that reach the target rate by the end of the timestep.
+    const bool positiveJets = ((simdt > 0) ? ((angVelError / simdt) >= externalAngularAcc) : (angVelError >= 0));
+    const double maxAngularAcc = (positiveJets ? maxPositiveAngularAcc : maxNegativeAngularAcc);
+    if (maxAngularAcc > 0)
+        thLevel -= externalAngularAcc / maxAngularAcc;
+
+    // reduce thruster level as timestep size increases
+    return LimitThrustLevelForTimestep(thLevel, angVelError, externalAngularAcc, maxAngularAcc, simdt);
+}
+
+double XR1AutopilotLaws::LearningThrustStep(const double deltaV, const double simdt, const XR1AutopilotGains &gains)
+{
+    // NOTE: this is value #2 to tweak if you want to fine-tune time acc behavior and accuracy
+    // Typical deltaV when holding attitude during reentry is 0.2, which / 50 = 250 control periods to "catch up" to attitude target, or 6.25 seconds.
+    // The step is per 1/40-second of simulation time rather than per frame, so the learning thrust adapts at the same rate at any frame rate or time acceleration.
+    return deltaV / gains.LearningThrustStepDivisor * (simdt / 0.025);
+}
+
+double XR1AutopilotLaws::KillRotationThrustLevel(const double angularVelocity, const double masterThrustFrac, const double maxAngularAcc, const double simdt, const XR1AutopilotGains &gains)
+{
+    // reduce thrust level if we are close to our target velocity already
+    const double thLevel = masterThrustFrac * min(1.0, fabs(angularVelocity) / gains.KillRotationRateTaper);
+
+    // always reduce thruster level as timestep size increases, even if in atmosphere
+    return LimitThrustLevelForTimestep(thLevel, fabs(angularVelocity), 0, maxAngularAcc, simdt);
+}
+
+double XR1AutopilotLaws::DescentHoldTargetAcc(const double rateDelta, const bool autoLand, const double simdt, const XR1AutopilotGains &gains)
+{
+    // try to arrive at rate quickly (for accuracy) but in a reasonable time period so we don't overdrive the engines and oscillate
+    // NOTE: this is the primary value to tune accuracy vs. oscillation
+    // targetAcc will be rateDelta * (n >= 2.0)
+    // e.g., if rate = 10, mult = 2.0  (1/2-second)
+    //       if rate = 20, mult = 4.0  (1/4-second)
+    //       if rate = 100, mult = 20.0  (1/20-second)  : [this will certainly induce maximum thrust]
+    double rateDeltaMultiplier = max(gains.RateHoldMinMultiplier, (fabs(rateDelta) / gains.RateHoldMultiplierDivisor));  // n >= 2.0 (no upper limit)
+
+    // must be more aggressive when auto-land engaged
+    if (autoLand)
+    {
+        // there is no upper limit here; this is by design
+        // TOO AGGRESSIVE: rateDeltaMultiplier *= 5;   // 5 * 2.0 = 10 = minimum multiplier set to reach target acc in 1/10th-second to keep auto-land accurate
+        // This can *almost* land at 100x now (it lands at 80x successfully); at 100x it sometimes can't quite touch down, but in any case it doesn't crash the ship!
+        rateDeltaMultiplier *= gains.AutoLandMultiplier;   // 2 * 2.0 = 4 = minimum multiplier set to reach target acc in 0.25-second to keep auto-land accurate
+    }
+
+    // NOTE: (1 / rateDeltaMultiplier) = fraction of second to reach target acc; e.g., 5 = 1/5th-second
+    const double targetAcc = (rateDelta * rateDeltaMultiplier); // target acc range is rateDelta * (n >= 2) m/s/s
+
+    // don't overshoot the target rate before the next timestep; this only comes into play under time acceleration
+    return LimitRateForTimestep(targetAcc, rateDelta, simdt);
+}
+
+double XR1AutopilotLaws::AirspeedHoldTargetAcc(const double velDelta, const double simdt, const XR1AutopilotGains &gains)
+{
+    // Try to arrive at rate quickly (for accuracy) but in a reasonable time period so we don't overdrive the engines and oscillate.
+    // NOTE: this is the primary value to tune accuracy vs. oscillation
+    // targetAcc will be rateDelta * (n >= 2.0 m/s/s)
+    // e.g., if absVelDelta = 10, mult = 2.0   (2.0 m/s/s) : 10 / 5 = 2
+    //       if absVelDelta = 20, mult = 4.0   (4.0 m/s/s) : 20 / 5 = 4
+    //       if absVelDelta = 100, mult = 20.0 (20.0 m/s/s): 100 / 5 = 20
+    // NOTE: velDeltaMultiplier must use absVelDelta because it is merely a positive *multiplier* for a positive or negative *rate*
+    const double velDeltaMultiplier = max(gains.RateHoldMinMultiplier, (fabs(velDelta) / gains.RateHoldMultiplierDivisor));  // n >= 1.0 (no upper limit)
+
+    // NOTE: (1 / velDeltaMultiplier) = fraction of second to reach target acc; e.g., 5 = 1/5th-second; may be negative
+    const double targetAcc = (velDelta * velDeltaMultiplier); // target acc range is [velDelta * (n >= 0.5)] m/s/s
+
+    // don't overshoot the target airspeed before the next timestep; this only comes into play under time acceleration
+    return LimitRateForTimestep(targetAcc, velDelta, simdt);
+}
+
+double XR1AutopilotLaws::LimitRateForTimestep(const double rate, const double deltaToTarget, const double simdt)
+{
+    if (simdt <= 0)
+        return rate;
+
+    const double maxRate = fabs(deltaToTarget) / simdt;
+    return ((rate > maxRate) ? maxRate : ((rate < -maxRate) ? -maxRate : rate));
+}
+
+// Orbiter holds a thruster level for the entire timestep, so at high time acceleration a single timestep covers many of our nominal
+// 1/40-second control periods.  Commanding thLevel for each of those periods and cutting the jets once the predicted angular velocity
+// reaches its target works out to this limit, which keeps the angular velocity from overshooting its target no matter how long the timestep is.
+// The prediction includes the external acceleration, so the jets may hold against the air as hard as it takes and no harder.
+//
+// thLevel = thruster level requested for a 1/40-second control period; > 0 increases the rotation rate, < 0 decreases it
+// angVelError = target - current angular velocity in degrees/second
+// externalAngularAcc = see ExternalAngularAcc
+// maxAngularAcc = angular acceleration at full thrust of the jets that thLevel fires in degrees/second^2, or 0 if unknown
+double XR1AutopilotLaws::LimitThrustLevelForTimestep(const double thLevel, const double angVelError, const double externalAngularAcc, const double maxAngularAcc, const double simdt)
+{
+    if ((maxAngularAcc > 0) && (simdt > 0))
+    {
+        // the thruster level that reaches the target angular velocity at the end of the timestep
+        const double limit = ((angVelError / simdt) - externalAngularAcc) / maxAngularAcc;
+        return ((angVelError >= 0) ? min(thLevel, limit) : max(thLevel, limit));
+    }
+
+    // thruster dynamics unknown: fall back to scaling by the timestep size
+    const double timeAccDivisor = max((simdt / 0.025), 1.0);   // min framerate for full-speed rotation (thruster levels) is 1/40-second (40 frames/sec)
+    return (thLevel / timeAccDivisor);
+}
+
+//-------------------------------------------------------------------------
+// Fixed control period
+//-------------------------------------------------------------------------
+
+const double XR1AutopilotLaws::CONTROL_PERIOD = 0.020;   // 50 Hz
+static const double DISTURBANCE_TREND_HORIZON = 0.25;    // seconds; see RateHoldThrustLevel
+
+int XR1AutopilotLaws::ControlSubstepCount(const double simdt)
+{
+    const int maxSubsteps = 1000;   // 20 seconds; the autopilots suspend themselves long before a timestep gets this long
+    if (simdt <= CONTROL_PERIOD)
+        return 1;
+
+    return min(maxSubsteps, static_cast<int>(ceil(simdt / CONTROL_PERIOD)));
+}
+
+double XR1DisturbanceTrend::Update(const double simt, const double simdt, const double value)
+{
+    // a gap much longer than this timestep means frames went by without an update (e.g., the autopilot was off), so the old sample is stale
+    const double dt = simt - m_prevSimt;
+    const double rate = ((m_hasSample && (dt > 0) && (dt <= 2 * simdt)) ? ((value - m_prevValue) / dt) : 0);
+
+    m_hasSample = true;
+    m_prevSimt = simt;
+    m_prevValue = value;
+    return rate;
+}
+
+// one rotation axis as the attitude hold model sees it
+struct AttitudeModelState
+{
+    double Value;                   // attitude in degrees
+    double AngularVelocity;         // degrees/second
+    double ExternalAngularAcc;      // degrees/second^2
+};
+
+// Advances the model by simdt seconds with the jets held at jetAngularAcc.
+// attitudeRateSign = d(attitude)/dt per degree/second of angular velocity
+static void AdvanceAttitudeModel(AttitudeModelState &state, const double jetAngularAcc, const double attitudeRateSign, const double simdt)
+{
+    const double acc = jetAngularAcc + state.ExternalAngularAcc;
+    state.Value += attitudeRateSign * ((state.AngularVelocity * simdt) + (acc * simdt * simdt / 2));
+    state.AngularVelocity += acc * simdt;
+}
+
+// Returns the angular acceleration from the jets at jetLevel: > 0 = positive jets, < 0 = negative jets.
+static double JetAngularAcc(const XR1AttitudeAxis &axis, const double jetLevel)
+{
+    return jetLevel * ((jetLevel >= 0) ? axis.MaxPositiveAngularAcc : axis.MaxNegativeAngularAcc);
+}
+
+// Orbiter holds a thruster level for the entire timestep, but the attitude hold law is tuned to run every CONTROL_PERIOD.  So we run it
+// against a model of the axis over this timestep and the next one (assuming the next one is as long), which gives the attitude and angular
+// velocity the law would reach by the end of the next timestep, and then hold the level that, followed by a second level for the next
+// timestep, reaches exactly that state.  Matching the law's attitude as well as its angular velocity keeps the ship from lagging behind it
+// no matter how long the timesteps are.  If a timestep is no longer than CONTROL_PERIOD, this is simply the law's own level.
+bool XR1AutopilotLaws::AttitudeHoldJetLevel(const XR1AttitudeAxis &axis, XR1LearningData *pLearning, const double simdt, const XR1AutopilotGains &gains, double &jetLevel)
+{
+    const double targetDeadZone = 0.01;      // in degrees (very tight hold)
+
+    // Without the jets' authority we cannot model the axis, so run the law once for the whole timestep.
+    if ((axis.MaxPositiveAngularAcc <= 0) || (axis.MaxNegativeAngularAcc <= 0) || (simdt <= 0))
+    {
+        // only fire thrusters if outside our deadzone
+        if (fabs(axis.TargetValue - axis.CurrentValue) <= targetDeadZone)
+            return false;
+
+        jetLevel = AttitudeControlPeriodJetLevel(axis, axis.CurrentValue, axis.AngularVelocity, axis.ExternalAngularAcc, pLearning, simdt, gains);
+        return true;
+    }
+
+    const int substepCount = ControlSubstepCount(simdt);
+    const double h = simdt / substepCount;
+    const double attitudeRateSign = (axis.ReverseRotation ? 1.0 : -1.0);
+
+    AttitudeModelState state = { axis.CurrentValue, axis.AngularVelocity, axis.ExternalAngularAcc };
+    double level = axis.HeldJetLevel;
+    XR1LearningData nextLearningData;
+    XR1LearningData *pSubstepLearning = pLearning;
+    bool lawRan = false;
+    for (int i = 0; i < 2 * substepCount; i++)
+    {
+        if (i == substepCount)
+        {
+            if (lawRan == false)
+                return false;   // the jets keep their levels for this timestep
+
+            // the next timestep will run the law again for real, so it must not update the learning data now
+            if (pLearning)
+            {
+                nextLearningData = *pLearning;
+                pSubstepLearning = &nextLearningData;
+            }
+        }
+
+        // only fire thrusters if outside our deadzone; inside it the jets keep their previous level
+        if (fabs(axis.TargetValue - state.Value) > targetDeadZone)
+        {
+            level = AttitudeControlPeriodJetLevel(axis, state.Value, state.AngularVelocity, state.ExternalAngularAcc, pSubstepLearning, h, gains);
+            lawRan |= (i < substepCount);
+        }
+        AdvanceAttitudeModel(state, JetAngularAcc(axis, level), attitudeRateSign, h);
+    }
+
+    // the axis' motion over both timesteps with the jets off
+    AttitudeModelState freeState = { axis.CurrentValue, axis.AngularVelocity, axis.ExternalAngularAcc };
+    AdvanceAttitudeModel(freeState, 0, attitudeRateSign, 2 * simdt);
+
+    // Holding jet acc u0 for this timestep and u1 for the next one adds (u0 + u1) * simdt to the free angular velocity and
+    // (1.5 * u0 + 0.5 * u1) * simdt^2 to the free rotation; solve both for u0.
+    const double angularVelocityTerm = (state.AngularVelocity - freeState.AngularVelocity) / simdt;                     // u0 + u1
+    const double attitudeTerm = attitudeRateSign * (state.Value - freeState.Value) / (simdt * simdt);                   // 1.5 * u0 + 0.5 * u1
+    const double jetAngularAcc = attitudeTerm - (angularVelocityTerm / 2);
+    level = jetAngularAcc / ((jetAngularAcc >= 0) ? axis.MaxPositiveAngularAcc : axis.MaxNegativeAngularAcc);
+
+    jetLevel = max(-1.0, min(level, 1.0));
+    return true;
+}
+
+double XR1AutopilotLaws::AttitudeControlPeriodJetLevel(const XR1AttitudeAxis &axis, const double currentValue, const double angularVelocity, const double externalAngularAcc, XR1LearningData *pLearning,
+    const double simdt, const XR1AutopilotGains &gains)
+{
+    const double angVelDeadZone = 0.01;      // in degrees/second
+
+    // compute the optimal closing rate based on how far we have to go yet before reaching target attitude
+    // NOTE: may be negative here!
+    const double degreesDelta = axis.TargetValue - currentValue;
+    const double targetAngVel = TargetAngularVelocity(degreesDelta, axis.AngVelLimit, axis.MinAngVel, axis.ReverseRotation, simdt, gains);
+
+    // reduce thrust level if we are close to our angular velocity target already
+    // NOTE: inside the dead zone the jets only hold against the external acceleration
+    const double deltaV = fabs(targetAngVel - angularVelocity);
+    const double angVelError = ((deltaV > angVelDeadZone) ? (targetAngVel - angularVelocity) : 0);
+
+    // > 0 fires the positive jets, < 0 the negative jets
+    double jetLevel = AttitudeThrustLevel(angVelError, externalAngularAcc, axis.MasterThrustFrac, axis.DescentHoldActive,
+        axis.MaxPositiveAngularAcc, axis.MaxNegativeAngularAcc, simdt, gains);
+
+    //
+    // Handle PITCH learning autopilot here to hold a stable pitch during reentry
+    //
+    // modify learning thrust fraction based on whether we closed on the target since the previous control period AND if we are reducing thrust because we are close
+    double newLearningThrustFrac = 0;       // set below
+    double learningThrustStep = 0;          // set below
+    const bool activeLearningThrustDirection = (currentValue >= 0);  // only do learning mode for UP pitch
+
+    if (pLearning && axis.ApplyLearningThrust && activeLearningThrustDirection)
+    {
+        // direction in which learning thrust is being applied; this will push AGAINST the air trying to rotate the ship
+        if (fabs(jetLevel) < 1.0)
+        {
+            learningThrustStep = LearningThrustStep(deltaV, simdt, gains);   // thrust step size for this control period
+            newLearningThrustFrac = pLearning->m_thrustFrac;   // will be set to this value if jets actually fire
+
+            // No dead zone here!  If we end up firing the jets, we need accurate data no matter how small it is.
+            // Only apply learning thrust if we need to push in the right direction (against the air)
+            const bool currentAngVelDirection = (targetAngVel >= angularVelocity);
+            if (activeLearningThrustDirection == currentAngVelDirection)
+            {
+                // back out the last applied learning thrust delta if requested
+                if (pLearning->m_reverseLastLearningThrustStep)
+                {
+                    newLearningThrustFrac -= pLearning->m_lastLearningThrustStep;
+                    // NOTE: do not reset 'm_reverseLastLearningThrustStep' flag here; we must only reset it if the jets actually fire and latch our request!
+                }
+
+                // increase learning thrust
+                newLearningThrustFrac += learningThrustStep;   // need more thrust to decrease ang velocity
+                jetLevel += newLearningThrustFrac;   // apply learning thrust
+
+                // the learning thrust must not carry us past the target angular velocity before the next control period, either
+                jetLevel = LimitThrustLevelForTimestep(jetLevel, angVelError, externalAngularAcc, axis.MaxPositiveAngularAcc, simdt);
+            }
+            else    // too much thrust; reduce learning thrust, but do not apply to this control period since thrusters are firing in other direction!
+            {
+                // NOTE: cannot simply set newLearningThrustFrac here because the jets might not fire this control period, and we cannot directly
+                // update m_thrustFrac here because this 'else' block may be invoked multiple times before the positive jets fire again.
+                // Therefore, we simply queue up the change to be applied the next time the positive jets fire.
+                pLearning->m_reverseLastLearningThrustStep = true;
+            }
+
+            if (newLearningThrustFrac < 0)
+                newLearningThrustFrac = 0;
+            else if (newLearningThrustFrac > 1.0)
+                newLearningThrustFrac = 1.0;
+        }
+    }
+
+    jetLevel = max(-1.0, min(jetLevel, 1.0));
+
+    // update pitch learning data for next time IF we actually fired the jets to apply the target thrust
+    if (pLearning && (jetLevel > 0))
+    {
+        pLearning->m_lastLearningThrustStep = learningThrustStep;  // save in case we need to reduce thrust next control period; i.e., back out this change
+        pLearning->m_thrustFrac = newLearningThrustFrac;
+        pLearning->m_reverseLastLearningThrustStep = false;  // reset flag since we know it was already processed above because the positive jets fired
+    }
+    return jetLevel;
+}
+
+double XR1AutopilotLaws::DescentHoldThrustLevel(const double rateDelta, const double planetAcc, const double planetAccRate, const double maxEngineAcc, const bool autoLand,
+    const double simdt, const XR1AutopilotGains &gains)
+{
+    return RateHoldThrustLevel(true, rateDelta, planetAcc, planetAccRate, maxEngineAcc, autoLand, simdt, gains);
+}
+
+double XR1AutopilotLaws::AirspeedHoldThrustLevel(const double velDelta, const double planetAcc, const double planetAccRate, const double maxEngineAcc,
+    const double simdt, const XR1AutopilotGains &gains)
+{
+    return RateHoldThrustLevel(false, velDelta, planetAcc, planetAccRate, maxEngineAcc, false, simdt, gains);
+}
+
+double XR1AutopilotLaws::RateHoldThrustLevel(const bool isDescentHold, double rateDelta, const double planetAcc, const double planetAccRate, const double maxEngineAcc,
+    const bool autoLand, const double simdt, const XR1AutopilotGains &gains)
+{
+    if (maxEngineAcc <= 0)
+        return 0;   // engines have no thrust (e.g., no atmosphere for them to work in)
+
+    // The rate has no other state, so the mean of the substeps' levels gives the same rate at the end of the timestep as the law would.
+    const int substepCount = ControlSubstepCount(simdt);
+    const double h = simdt / substepCount;
+    double thLevelSum = 0;
+    for (int i = 0; i < substepCount; i++)
+    {
+        // try to arrive at rate quickly (for accuracy) but in a reasonable time period so we don't overdrive the engines and oscillate
+        const double targetAcc = (isDescentHold ? DescentHoldTargetAcc(rateDelta, autoLand, h, gains) : AirspeedHoldTargetAcc(rateDelta, h, gains));
+
+        // Gusts keep changing during a long timestep, so follow planetAcc's trend for a short while; beyond DISTURBANCE_TREND_HORIZON
+        // (about one frame at 10x) the gust is as likely to have turned as not.
+        const double substepPlanetAcc = planetAcc + planetAccRate * min(i * h, DISTURBANCE_TREND_HORIZON);
+
+        // Determine effective acc required to maintain the requested acc (m/s/s); this takes gravity, drag, and our mass into account
+        const double effectiveTargetAcc = -substepPlanetAcc + targetAcc;  // planet's pull (including atm drag and lift) + target rate
+        const double thLevel = max(0.0, min(effectiveTargetAcc / maxEngineAcc, 1.0));
+
+        thLevelSum += thLevel;
+        rateDelta -= (thLevel * maxEngineAcc + substepPlanetAcc) * h;
+    }
+    return (thLevelSum / substepCount);
+}
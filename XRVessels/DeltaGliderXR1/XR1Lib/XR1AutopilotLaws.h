@@ -0,0 +1,197 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1AutopilotLaws.h
+// Control laws for the attitude hold, descent hold, and airspeed hold
+// autopilots.
+//
+// These take the vessel state as plain numbers and return thruster
+// levels or target accelerations, so they have no Orbiter dependency:
+// the autopilot PreSteps read the state from Orbiter and apply the
+// result, while the AutopilotTuner tool runs the same laws against a
+// rigid-body model.  All tuning values are in XR1AutopilotGains.
+// ==============================================================
+
+#pragma once
+
+// Autopilot tuning values; the defaults are the values the XR vessels fly with, except for AngularVelocityDegreesDeltaFrac,
+// which each vessel sets from its AP_ANGULAR_VELOCITY_DEGREES_DELTA_FRAC global.
+struct XR1AutopilotGains
+{
+    // attitude hold
+    double AngularVelocityDegreesDeltaFrac = 0.5;   // target rotation rate in degrees/second per degree of attitude error
+    double AttitudeRateTaper = 5.0;             // RCS reaches full thrust at this many degrees/second of rotation rate error
+    double DescentAttitudeRateTaper = 1.0;      // same, while descent hold is holding the ship level
+    double KillRotationRateTaper = 3.0;         // same, when killing yaw rotation
+    double LearningThrustStepDivisor = 50.0;    // pitch learning thrust step per 1/40 second = rate error / this
+
+    // descent hold and airspeed hold
+    double RateHoldMinMultiplier = 2.0;         // target acc is at least this many m/s^2 per m/s of rate error...
+    double RateHoldMultiplierDivisor = 5.0;     // ...rising by 1 m/s^2 per m/s for every this many m/s of rate error
+    double AutoLandMultiplier = 2.0;            // descent hold only: target acc multiplier when auto-land is engaged
+};
+
+// Pitch learning thrust for attitude hold in an atmosphere: an extra positive pitch thrust level that builds up while the
+// jets are pushing against the air, so that the ship can hold a stable pitch during reentry.
+class XR1LearningData
+{
+public:
+    // constructor
+    XR1LearningData() { Reset(); }
+
+    void Reset()
+    {
+        m_thrustFrac = 0;
+        m_lastLearningThrustStep = 0;
+        m_reverseLastLearningThrustStep = false;
+    }
+
+    double m_thrustFrac;      // 0...1: delta to be applied to computed thrust along one direction
+    double m_lastLearningThrustStep;  // last applied learning thrust step
+    bool m_reverseLastLearningThrustStep;  // if true, m_lastLearningThrustStep will be subtracted from m_thrustFrac the next time these jets fire
+};
+
+// Descent hold and airspeed hold: tracks how fast planetAcc changed from the previous frame to this one, so the laws can carry
+// its trend across a long timestep.  The trend is 0 on the first frame and after any frame without an update.
+class XR1DisturbanceTrend
+{
+public:
+    // constructor
+    XR1DisturbanceTrend() { Reset(); }
+
+    void Reset()
+    {
+        m_hasSample = false;
+        m_prevSimt = 0;
+        m_prevValue = 0;
+    }
+
+    // Returns the rate of change of value per second since the previous frame's update.
+    double Update(const double simt, const double simdt, const double value);
+
+protected:
+    bool m_hasSample;
+    double m_prevSimt;
+    double m_prevValue;
+};
+
+// Attitude hold: the state of one rotation axis at the start of a timestep.  Attitudes are in degrees and rotation rates in degrees/second.
+struct XR1AttitudeAxis
+{
+    double TargetValue;
+    double CurrentValue;
+    double AngularVelocity;             // NOTE: may be negative
+    double ExternalAngularAcc;          // see XR1AutopilotLaws::ExternalAngularAcc
+    double HeldJetLevel;                // level held over the previous timestep: > 0 = positive jets, < 0 = negative jets
+    double MaxPositiveAngularAcc;       // angular acceleration of each set of jets at full thrust in degrees/second^2, or 0 if unknown
+    double MaxNegativeAngularAcc;
+    double AngVelLimit;                 // maximum rotation rate
+    double MinAngVel;                   // minimum rotation rate (used to reach the initial bank quickly), or 0 for none
+    bool ReverseRotation;               // true if a positive attitude error requires positive angular velocity (e.g., pitch)
+    bool ApplyLearningThrust;           // true to apply the pitch learning thrust (in an atmosphere, unless descent hold is active)
+    double MasterThrustFrac;            // 0-1
+    bool DescentHoldActive;
+};
+
+class XR1AutopilotLaws
+{
+public:
+    // The autopilots run their control laws once per CONTROL_PERIOD seconds of simulation time no matter how long the timestep is:
+    // a timestep is split into equal substeps no longer than this, each substep holds the level computed at its start, and a
+    // model of the ship carries the controlled value from one substep to the next.  The level returned is the one that, held for
+    // the whole timestep, follows the law's path; see the .cpp file for details.
+    static const double CONTROL_PERIOD;
+
+    // Attitude hold: returns in jetLevel the RCS thruster level to hold for a timestep of simdt seconds for one axis: > 0 fires
+    // the positive jets, < 0 the negative jets.  pLearning = pitch learning data, or nullptr for the other axes; the learning thrust
+    // is applied only if ApplyLearningThrust is set and the current value is >= 0, but the data is updated whenever the positive jets fire.
+    // Returns: false if the axis stayed inside the target dead zone for the entire timestep; the jets should then keep their levels.
+    static bool AttitudeHoldJetLevel(const XR1AttitudeAxis &axis, XR1LearningData *pLearning, const double simdt, const XR1AutopilotGains &gains, double &jetLevel);
+
+    // Descent hold: returns the hover thrust level to hold for a timestep of simdt seconds.
+    // rateDelta = target - current vertical rate in m/s
+    // planetAcc = vertical acceleration in m/s^2 from everything but the hover engines (gravity, drag, and lift)
+    // planetAccRate = rate of change of planetAcc in m/s^3; see XR1DisturbanceTrend
+    // maxEngineAcc = vertical acceleration from the hover engines at full thrust in m/s^2
+    static double DescentHoldThrustLevel(const double rateDelta, const double planetAcc, const double planetAccRate, const double maxEngineAcc, const bool autoLand,
+        const double simdt, const XR1AutopilotGains &gains);
+
+    // Airspeed hold: returns the main thrust level to hold for a timestep of simdt seconds; velDelta = target - current airspeed in m/s,
+    // and planetAcc, planetAccRate, and maxEngineAcc are along the direction of flight.
+    static double AirspeedHoldThrustLevel(const double velDelta, const double planetAcc, const double planetAccRate, const double maxEngineAcc,
+        const double simdt, const XR1AutopilotGains &gains);
+
+    // Attitude hold: returns the target rotation rate in degrees/second for one axis.
+    // degreesDelta = target - current attitude in degrees
+    // minAngVel = minimum rotation rate in degrees/second (used to reach the initial bank quickly), or 0 for none
+    // reverseRotation = true if a positive degreesDelta requires positive angular velocity (e.g., pitch)
+    static double TargetAngularVelocity(const double degreesDelta, const double angVelLimit, const double minAngVel, const bool reverseRotation, const double simdt, const XR1AutopilotGains &gains);
+
+    // Attitude hold: returns the angular acceleration in degrees/second^2 about one axis from everything but the RCS jets (the air,
+    // for one) at the start of a timestep.
+    // angularAcc = the ship's angular acceleration in degrees/second^2
+    // jetAngularAcc = angular acceleration in degrees/second^2 from the thruster levels held over the previous timestep
+    static double ExternalAngularAcc(const double angularAcc, const double jetAngularAcc);
+
+    // Attitude hold: returns the RCS thruster level for one axis: > 0 fires the jets that increase the rotation rate, < 0 the jets that decrease it.
+    // angVelError = target - current rotation rate in degrees/second
+    // externalAngularAcc = see ExternalAngularAcc
+    // maxPositiveAngularAcc, maxNegativeAngularAcc = angular acceleration of each set of jets at full thrust in degrees/second^2, or 0 if unknown
+    static double AttitudeThrustLevel(const double angVelError, const double externalAngularAcc, const double masterThrustFrac, const bool descentHoldActive,
+        const double maxPositiveAngularAcc, const double maxNegativeAngularAcc, const double simdt, const XR1AutopilotGains &gains);
+
+    // Attitude hold: returns the pitch learning thrust step for a timestep of simdt seconds.
+    // deltaV = difference between the target and current rotation rate in degrees/second; must be >= 0
+    static double LearningThrustStep(const double deltaV, const double simdt, const XR1AutopilotGains &gains);
+
+    // Returns the RCS thruster level to use to kill rotation of angularVelocity degrees/second about one axis.
+    static double KillRotationThrustLevel(const double angularVelocity, const double masterThrustFrac, const double maxAngularAcc, const double simdt, const XR1AutopilotGains &gains);
+
+    // Descent hold: returns the target vertical acceleration in m/s^2 to close rateDelta (target - current vertical rate in m/s).
+    static double DescentHoldTargetAcc(const double rateDelta, const bool autoLand, const double simdt, const XR1AutopilotGains &gains);
+
+    // Airspeed hold: returns the target acceleration in m/s^2 to close velDelta (target - current airspeed in m/s).
+    static double AirspeedHoldTargetAcc(const double velDelta, const double simdt, const XR1AutopilotGains &gains);
+
+    // Limits a rate of change so that holding it for one timestep cannot carry a value past a target that is deltaToTarget away.
+    // Orbiter holds each thruster level for an entire timestep, and at high time acceleration a single timestep spans many
+    // of the autopilots' nominal control periods; the autopilots use this to avoid overshooting their targets between frames.
+    static double LimitRateForTimestep(const double rate, const double deltaToTarget, const double simdt);
+
+    // Returns the thruster level to hold for a timestep of simdt seconds; see the .cpp file for details.
+    static double LimitThrustLevelForTimestep(const double thLevel, const double angVelError, const double externalAngularAcc, const double maxAngularAcc, const double simdt);
+
+protected:
+    // Returns the number of CONTROL_PERIOD substeps in a timestep of simdt seconds.
+    static int ControlSubstepCount(const double simdt);
+
+    // Attitude hold: returns the RCS thruster level for one control period of simdt seconds, including any learning thrust.
+    static double AttitudeControlPeriodJetLevel(const XR1AttitudeAxis &axis, const double currentValue, const double angularVelocity, const double externalAngularAcc, XR1LearningData *pLearning,
+        const double simdt, const XR1AutopilotGains &gains);
+
+    // Descent hold and airspeed hold: returns the thrust level to hold for a timestep; see DescentHoldThrustLevel.
+    static double RateHoldThrustLevel(const bool isDescentHold, double rateDelta, const double planetAcc, const double planetAccRate, const double maxEngineAcc,
+        const bool autoLand, const double simdt, const XR1AutopilotGains &gains);
+};
@@ -60,7 +60,8 @@ XR1ConfigFileParser::XR1ConfigFileParser() :
     EnableManualFlightControlsForAttitudeHold(false), InvertAttitudeHoldPitchArrows(false), InvertDescentHoldRateArrows(false), 
     Lower2DPanelVerticalScrollingEnabled(false),
     DefaultCrewComplement(MAX_PASSENGERS), ShowAltitudeAndVerticalSpeedOnHUD(true), EnableEngineLightingEffects(true),
-	CheatcodesEnabled(true), EnableParkingBrakes(true),
+	CheatcodesEnabled(true), EnableParkingBrakes(true), TelemetryExportEnabled(false),
+    FlightDataRecorderEnabled(false), FlightDataRecorderInterval(0.1),
     // Values below here are NOT used by the XR1; there are here for subclasses
     EnableResupplyHatchAnimationsWhileDocked(true),
     AudioCalloutVolume(255), PayloadScreensUpdateInterval(0.05),  // 20 times/second
@@ -69,6 +70,7 @@ XR1ConfigFileParser::XR1ConfigFileParser() :
     // set callout defaults
     strcpy(LiftoffCallout, "Wheels Up.wav");
     strcpy(TouchdownCallout, "Wheels Down.wav");
+    *StartupScript = 0;     // no startup script
 
     //
     // Set default refuel/resupply tank options
@@ -204,6 +206,29 @@ bool XR1ConfigFileParser::ParseLine(const char *pSection, const char *pPropertyN
         else if (PNAME_MATCHES("EnableParkingBrakes"))
         {
 			SSCANF_BOOL("%c", &EnableParkingBrakes);
+        }
+        else if (PNAME_MATCHES("TelemetryExportEnabled"))
+        {
+			SSCANF_BOOL("%c", &TelemetryExportEnabled);
+        }
+        else if (PNAME_MATCHES("FlightDataRecorderEnabled"))
+        {
+            SSCANF_BOOL("%c", &FlightDataRecorderEnabled);
+        }
+        else if (PNAME_MATCHES("FlightDataRecorderInterval"))
+        {
+            SSCANF1("%lf", &FlightDataRecorderInterval);
+            VALIDATE_DOUBLE(&FlightDataRecorderInterval, 0.01, 10.0, 0.1);
+        }
+        else if (PNAME_MATCHES("StartupScript"))
+        {
+            if (strcmp(pValue, "NONE") == 0)
+                *StartupScript = 0;     // no startup script
+            else
+            {
+                strncpy(StartupScript, pValue, MAX_FILENAME_LEN);
+                StartupScript[MAX_FILENAME_LEN] = 0;
+            }
         }
 		else if (PNAME_MATCHES("CheatcodesEnabled"))
 		{
@@ -557,6 +582,17 @@ bool XR1ConfigFileParser::ParseLine(const char *pSection, const char *pPropertyN
                 goto invalid_value;
         }
     }
+    // parse [KEYBINDINGS] settings; e.g., "ToggleLandingGear=CTRL-F5"
+    else if (SECTION_MATCHES("KEYBINDINGS"))
+    {
+        if (!KeyBindings.IsRemappable(pPropertyName))
+            goto invalid_name;
+
+        if (!KeyBindings.Remap(pPropertyName, pValue))
+            goto invalid_value;
+
+        processed = true;
+    }
     // parse [CHEATCODES] settings
     else if (SECTION_MATCHES("CHEATCODES"))
     {
@@ -32,6 +32,7 @@
 #include <vector>
 #include "VesselConfigFileParser.h"
 #include "SecondaryHUDData.h"
+#include "XR1KeyBindings.h"
 #include "XR1Globals.h"
 #include <cstring>
 
@@ -200,6 +201,11 @@ public:
     bool EnableEngineLightingEffects;
     bool CheatcodesEnabled;
 	bool EnableParkingBrakes;
+    bool TelemetryExportEnabled;    // true = publish per-frame telemetry to a shared memory ring buffer
+    bool FlightDataRecorderEnabled; // true = record XR state to a flight data file along with Orbiter's flight recorder
+    double FlightDataRecorderInterval;  // seconds between recorded frames
+    char StartupScript[MAX_FILENAME_LEN+1]; // XRVesselCtrl script run when the simulation starts; empty = none
+    XR1KeyBindings KeyBindings;     // keyboard commands; remapped from the [KEYBINDINGS] section
 
     // this is NOT used by the XR1; it is here for subclasses
     bool EnableResupplyHatchAnimationsWhileDocked;
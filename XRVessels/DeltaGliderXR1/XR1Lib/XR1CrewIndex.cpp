@@ -0,0 +1,82 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1CrewIndex.cpp
+// Hashed lookups over the crew manifest.
+// ==============================================================
+
+#include "XR1CrewIndex.h"
+#include <cctype>
+
+using namespace std;
+
+void XR1CrewIndex::Clear()
+{
+    m_slotForName.clear();
+    m_slotForExactName.clear();
+    m_slotsForRank.clear();
+}
+
+void XR1CrewIndex::Add(const int slot, const char *pName, const char *pRank)
+{
+    if (*pName == 0)
+        return;     // empty slot
+
+    // emplace keeps the first slot for a duplicate name, matching the original linear scans
+    string key;
+    FoldCase(pName, key);
+    m_slotForName.emplace(key, slot);
+    m_slotForExactName.emplace(pName, slot);
+    m_slotsForRank[pRank].push_back(slot);
+}
+
+int XR1CrewIndex::GetSlotForName(const char *pName) const
+{
+    string key;     // crew names fit in the small-string buffer, so this does not allocate
+    FoldCase(pName, key);
+    const auto it = m_slotForName.find(key);
+    return ((it != m_slotForName.end()) ? it->second : -1);
+}
+
+int XR1CrewIndex::GetSlotForExactName(const char *pName) const
+{
+    const auto it = m_slotForExactName.find(pName);
+    return ((it != m_slotForExactName.end()) ? it->second : -1);
+}
+
+const vector<int> &XR1CrewIndex::GetSlotsForRank(const char *pRank) const
+{
+    static const vector<int> s_noSlots;
+    const auto it = m_slotsForRank.find(pRank);
+    return ((it != m_slotsForRank.end()) ? it->second : s_noSlots);
+}
+
+// lowercase the name the same way strcasecmp compares it
+void XR1CrewIndex::FoldCase(const char *pName, string &out)
+{
+    out.clear();
+    for (const char *p = pName; *p; p++)
+        out += static_cast<char>(tolower(static_cast<unsigned char>(*p)));
+}
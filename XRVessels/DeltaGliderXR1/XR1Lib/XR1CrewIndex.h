@@ -0,0 +1,70 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1CrewIndex.h
+// Hashed lookups over the crew manifest: name -> slot and
+// rank -> slots.  Rebuild it whenever the crew members change.
+// ==============================================================
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class XR1CrewIndex
+{
+public:
+    // Rebuild the index from the supplied crew array (CrewMember, or any type with name and rank strings); slots with an empty name are not indexed.
+    template <typename T> void Rebuild(const T *pCrewMembers, const int crewCount)
+    {
+        Clear();
+        for (int i = 0; i < crewCount; i++)
+            Add(i, pCrewMembers[i].name, pCrewMembers[i].rank);
+    }
+
+    void Clear();
+
+    // Index one crew member; slots must be added in ascending order.  Does nothing if pName is empty.
+    void Add(const int slot, const char *pName, const char *pRank);
+
+    // Returns: slot index of the first crew member with the given name (case-insensitive), or -1 if not found
+    int GetSlotForName(const char *pName) const;
+
+    // Returns: slot index of the first crew member with exactly the given name (case-sensitive), or -1 if not found
+    int GetSlotForExactName(const char *pName) const;
+
+    // Returns: slot indexes of all crew members with the given rank (case-sensitive), in ascending order; empty if none
+    const std::vector<int> &GetSlotsForRank(const char *pRank) const;
+
+    bool IsRankPresent(const char *pRank) const { return !GetSlotsForRank(pRank).empty(); }
+
+protected:
+    static void FoldCase(const char *pName, std::string &out);
+
+    std::unordered_map<std::string, int> m_slotForName;     // key is the lowercased name
+    std::unordered_map<std::string, int> m_slotForExactName;
+    std::unordered_map<std::string, std::vector<int>> m_slotsForRank;
+};
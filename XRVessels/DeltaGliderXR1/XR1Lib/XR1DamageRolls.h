@@ -0,0 +1,89 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1DamageRolls.h: the random failure rolls made by TestDamage and its helpers.  Each one draws from the vessel's
+// XRRandom in a fixed order, so a failure sequence replays identically from a saved RNG_STATE; the XRChecks random
+// check replays them and measures their failure rates through these same functions.
+// ==============================================================
+
+#pragma once
+#include "XRRandom.h"
+#include <cmath>
+#include <cstdlib>
+
+// Result of a wing load / dynamic pressure stress roll; see RollWingStressFailure.
+enum class WingStressFailure { None, LeftWing, RightWing, LeftAileron, RightAileron };
+
+// --------------------------------------------------------------
+// Roll for structural failure while the wing load or dynamic pressure is over its limit by 'alpha' for 'dt' seconds.
+// For a wing failure, 'wingFrac' is set to the multiplier for that wing's integrity.
+//
+// Returns: the failed part, or WingStressFailure::None
+// --------------------------------------------------------------
+inline WingStressFailure RollWingStressFailure(XRRandom &rng, const double alpha, const double dt, double &wingFrac)
+{
+    const double p = 1.0 - exp(-alpha * dt); // probability of failure
+    if (rng.NextDouble() >= p)
+        return WingStressFailure::None;
+
+    // simulate structural failure by distorting the airfoil definition
+    const int rfail = static_cast<int>(rng.NextDouble() * RAND_MAX);
+    switch (rfail & 3)
+    {
+    case 0:
+        wingFrac = exp(-alpha * rng.NextDouble());
+        return WingStressFailure::LeftWing;
+
+    case 1:
+        wingFrac = exp(-alpha * rng.NextDouble());
+        return WingStressFailure::RightWing;
+
+    case 2:
+        return WingStressFailure::LeftAileron;
+
+    default:
+        return WingStressFailure::RightAileron;
+    }
+}
+
+// --------------------------------------------------------------
+// Chance that one frame of 'dt' seconds at 'tempK' does heat damage to a hull surface or SCRAM engine with limit
+// 'limitK': the average terminal failure interval is 8 seconds, scaled by the square of the over-limit ratio.
+// --------------------------------------------------------------
+inline double GetHeatDamageProbability(const double tempK, const double limitK, const double dt)
+{
+    const double exceededLimitMult = pow((tempK / limitK), 2);  // e.g. 1.21 = 10% over limit
+    const double failureTimeFrac = dt / 8.0;                    // # of seconds at this temp / average terminal failure interval
+    return failureTimeFrac * exceededLimitMult;
+}
+
+// Returns: true if this frame does heat damage
+inline bool RollHeatDamage(XRRandom &rng, const double failureProbability)
+{
+    return (rng.NextDouble() <= failureProbability);
+}
+
+// Returns: the position, 0.2 - 0.5, at which a failed door jams
+inline double RollFailedDoorProc(XRRandom &rng)
+{
+    return fmod(rng.NextDouble(), 0.3) + 0.2;
+}
@@ -0,0 +1,421 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1DamageStatus.h: the XR1's per-item damage status rules, shared by DeltaGliderXR1::ComputeDamageStatus and
+// the XRChecks damage table check.  They are templates over the vessel so that the check can run this same code
+// without the Orbiter SDK.
+//
+// LegacyGetXR1DamageStatus is the original uncached GetDamageStatus switch, kept as the reference the cached table
+// must agree with: debug builds compare every ComputeDamageStatus result against it, and so does the check.
+// ==============================================================
+
+#pragma once
+#include "XR1Globals.h"
+#include <cstdio>
+#include <cstring>
+
+// --------------------------------------------------------------
+// Populates 'status' for the given item from the vessel's actual SYSTEM STATE (e.g., current thrust output); if
+// includeLabels is false, only status.fracIntegrity is updated.
+// --------------------------------------------------------------
+template <class TVessel> void ComputeXR1DamageStatus(const TVessel &vessel, const DamageItem item, DamageStatus &status, const bool includeLabels)
+{
+    double frac;
+    const char* pLabel = "???";
+    const char* pShortLabel = "???";
+    bool onlineOffline = true;     // assume online/offline
+
+    switch (item)
+    {
+    case DamageItem::LeftWing:
+        frac = vessel.lwingstatus;
+        pLabel = "Left Wing";
+        pShortLabel = "LWng";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::RightWing:
+        frac = vessel.rwingstatus;
+        pLabel = "Right Wing";
+        pShortLabel = "RWng";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::LeftAileron:
+        frac = ((vessel.aileronfail[0] | vessel.aileronfail[1]) ? 0 : 1);    // either mesh index 0 or 1 could be marked FAILED, so we must check both
+        pLabel = "Left Aileron";
+        pShortLabel = "LAil";
+        break;
+
+    case DamageItem::RightAileron:
+        frac = ((vessel.aileronfail[2] | vessel.aileronfail[3]) ? 0 : 1);    // either mesh index 2 or 3 could be marked FAILED, so we must check both
+        pLabel = "Right Aileron";
+        pShortLabel = "RAil";
+        break;
+
+    case DamageItem::LandingGear:
+        frac = ((vessel.gear_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Landing Gear";
+        pShortLabel = "Gear";
+        break;
+
+    case DamageItem::Nosecone:
+        frac = ((vessel.nose_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = NOSECONE_LABEL;
+        pShortLabel = NOSECONE_SHORT_LABEL;
+        break;
+
+    case DamageItem::RetroDoors:
+        frac = ((vessel.rcover_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Retro Doors";
+        pShortLabel = "RDor";
+        break;
+
+    case DamageItem::Hatch:
+        frac = ((vessel.hatch_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Top Hatch";
+        pShortLabel = "Htch";
+        break;
+
+    case DamageItem::Radiator:
+        frac = ((vessel.radiator_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Radiator";
+        pShortLabel = "Rad";
+        break;
+
+    case DamageItem::Airbrake:
+        frac = ((vessel.brake_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Airbrake";
+        pShortLabel = "Airb";
+        break;
+
+    case DamageItem::MainEngineLeft:
+    {
+        const double maxMainThrust = MAX_MAIN_THRUST[vessel.GetXR1Config()->MainEngineThrust];
+        frac = (maxMainThrust > 0 ? (vessel.GetThrusterMax0(vessel.th_main[0]) / maxMainThrust) : 1.0);  // if max main thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
+        pLabel = "Left Main Engine";
+        pShortLabel = "LEng";
+        onlineOffline = false;     // has partial failure
+        break;
+    }
+
+    case DamageItem::MainEngineRight:
+    {
+        const double maxMainThrust = MAX_MAIN_THRUST[vessel.GetXR1Config()->MainEngineThrust];
+        frac = (maxMainThrust > 0 ? (vessel.GetThrusterMax0(vessel.th_main[1]) / maxMainThrust) : 1.0);  // if max main thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
+        pLabel = "Right Main Engine";
+        pShortLabel = "REng";
+        onlineOffline = false;     // has partial failure
+        break;
+    }
+
+    case DamageItem::SCRAMEngineLeft:
+        frac = vessel.ramjet->GetEngineIntegrity(0);
+        pLabel = "Left SCRAM Engine";
+        pShortLabel = "LScr";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::SCRAMEngineRight:
+        frac = vessel.ramjet->GetEngineIntegrity(1);
+        pLabel = "Right SCRAM Engine";
+        pShortLabel = "RScr";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::HoverEngineFore:
+        // must make explicit check for damage here because we can vary the max thrust based on gimbaling
+        frac = vessel.m_hoverEngineIntegrity[0];
+        pLabel = "Fore Hover Engine";
+        pShortLabel = "FHov";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::HoverEngineAft:
+        // must make explicit check for damage here because we can vary the max thrust based on gimbaling
+        frac = vessel.m_hoverEngineIntegrity[1];
+        // can't do this: frac = GetThrusterMax0(th_hover[1]) / MAX_HOVER_THRUST[GetXR1Config()->HoverEngineThrust];
+        pLabel = "Aft Hover Engine";
+        pShortLabel = "AHov";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::RetroEngineLeft:
+        frac = (MAX_RETRO_THRUST > 0 ? (vessel.GetThrusterMax0(vessel.th_retro[0]) / MAX_RETRO_THRUST) : 1.0);    // if retro max thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
+        pLabel = "Left Retro Engine";
+        pShortLabel = "LRet";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::RetroEngineRight:
+        frac = (MAX_RETRO_THRUST > 0 ? (vessel.GetThrusterMax0(vessel.th_retro[1]) / MAX_RETRO_THRUST) : 1.0);    // if retro max thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
+        pLabel = "Right Retro Engine";
+        pShortLabel = "RRet";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::RCS1:
+    case DamageItem::RCS2:
+    case DamageItem::RCS3:
+    case DamageItem::RCS4:
+    case DamageItem::RCS5:
+    case DamageItem::RCS6:
+    case DamageItem::RCS7:
+    case DamageItem::RCS8:
+    case DamageItem::RCS9:
+    case DamageItem::RCS10:
+    case DamageItem::RCS11:
+    case DamageItem::RCS12:
+    case DamageItem::RCS13:
+    case DamageItem::RCS14:
+    {
+        int index = static_cast<int>(item) - static_cast<int>(DamageItem::RCS1);    // 0-13
+        // these are display names for the MDA screens, so keep the length reasonable
+        static const char* pLabels[] =
+        {
+            "Forward Lower RCS", "Aft Upper RCS", "Forward Upper RCS", "Aft Lower RCS",
+            "Forward Star. RCS", "Aft Port RCS", "Forward Port RCS", "Aft Star. RCS",
+            "Outboard Upper Port RCS", "Outboard Lower Star. RCS", "Outboard Upper Star. RCS", "Outboard Lower Port RCS",
+            "Aft RCS", "Forward RCS"
+        };
+        static const char* pShortLabels[] =
+        {
+            "RCS1", "RCS2", "RCS3", "RCS4", "RCS5", "RCS6", "RCS7",
+            "RCS8", "RCS9", "RCS10", "RCS11", "RCS12", "RCS13", "RCS14"
+        };
+
+        // for simplicity, we do not use RCS thrust as a damage indicator; we use in internal RCS array instead
+        frac = vessel.m_rcsIntegrityArray[index];  // internal array
+        pLabel = pLabels[index];
+        pShortLabel = pShortLabels[index];
+        onlineOffline = false;     // has partial failure
+        break;
+    }
+
+    default:        // should never happen!
+        frac = 0;
+        pLabel = "???????";
+        pShortLabel = "????";
+        break;
+    }
+
+    // populate the structure
+    status.fracIntegrity = frac;
+    if (includeLabels)
+    {
+        strcpy(status.label, pLabel);
+        strcpy(status.shortLabel, pShortLabel);
+        status.onlineOffline = onlineOffline;
+    }
+}
+
+// --------------------------------------------------------------
+// Refresh a cached damage status table, one entry per DamageItem up to D_END, through the vessel's (possibly
+// overridden) ComputeDamageStatus.  Labels never change, so they are only filled in while bLabelsValid is false.
+// --------------------------------------------------------------
+template <class TVessel> void UpdateXR1DamageStatusTable(const TVessel &vessel, DamageStatus *pTable, bool &bLabelsValid)
+{
+    const bool includeLabels = !bLabelsValid;
+    for (int i = 0; i <= static_cast<int>(D_END); i++)
+        vessel.ComputeDamageStatus(static_cast<DamageItem>(i), pTable[i], includeLabels);
+
+    bLabelsValid = true;
+}
+
+// --------------------------------------------------------------
+// The original uncached DeltaGliderXR1::GetDamageStatus: recomputes everything, labels included, on every call.
+// Reference only; returns a static variable, so it is not thread-safe and the result is overwritten by the next call.
+// --------------------------------------------------------------
+template <class TVessel> const DamageStatus &LegacyGetXR1DamageStatus(const TVessel &vessel, const DamageItem item)
+{
+    double frac;
+    const char* pLabel = "???";
+    const char* pShortLabel = "???";
+    char tempLabel[8];
+    bool onlineOffline = true;     // assume online/offline
+
+    switch (item)
+    {
+    case DamageItem::LeftWing:
+        frac = vessel.lwingstatus;
+        pLabel = "Left Wing";
+        pShortLabel = "LWng";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::RightWing:
+        frac = vessel.rwingstatus;
+        pLabel = "Right Wing";
+        pShortLabel = "RWng";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::LeftAileron:
+        frac = ((vessel.aileronfail[0] | vessel.aileronfail[1]) ? 0 : 1);    // either mesh index 0 or 1 could be marked FAILED, so we must check both
+        pLabel = "Left Aileron";
+        pShortLabel = "LAil";
+        break;
+
+    case DamageItem::RightAileron:
+        frac = ((vessel.aileronfail[2] | vessel.aileronfail[3]) ? 0 : 1);    // either mesh index 2 or 3 could be marked FAILED, so we must check both
+        pLabel = "Right Aileron";
+        pShortLabel = "RAil";
+        break;
+
+    case DamageItem::LandingGear:
+        frac = ((vessel.gear_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Landing Gear";
+        pShortLabel = "Gear";
+        break;
+
+    case DamageItem::Nosecone:
+        frac = ((vessel.nose_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = NOSECONE_LABEL;
+        pShortLabel = NOSECONE_SHORT_LABEL;
+        break;
+
+    case DamageItem::RetroDoors:
+        frac = ((vessel.rcover_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Retro Doors";
+        pShortLabel = "RDor";
+        break;
+
+    case DamageItem::Hatch:
+        frac = ((vessel.hatch_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Top Hatch";
+        pShortLabel = "Htch";
+        break;
+
+    case DamageItem::Radiator:
+        frac = ((vessel.radiator_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Radiator";
+        pShortLabel = "Rad";
+        break;
+
+    case DamageItem::Airbrake:
+        frac = ((vessel.brake_status == DoorStatus::DOOR_FAILED) ? 0 : 1);
+        pLabel = "Airbrake";
+        pShortLabel = "Airb";
+        break;
+
+    case DamageItem::MainEngineLeft:
+        frac = (MAX_MAIN_THRUST[vessel.GetXR1Config()->MainEngineThrust] > 0 ? (vessel.GetThrusterMax0(vessel.th_main[0]) / MAX_MAIN_THRUST[vessel.GetXR1Config()->MainEngineThrust]) : 1.0);  // if max main thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
+        pLabel = "Left Main Engine";
+        pShortLabel = "LEng";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::MainEngineRight:
+        frac = (MAX_MAIN_THRUST[vessel.GetXR1Config()->MainEngineThrust] > 0 ? (vessel.GetThrusterMax0(vessel.th_main[1]) / MAX_MAIN_THRUST[vessel.GetXR1Config()->MainEngineThrust]) : 1.0);  // if max main thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
+        pLabel = "Right Main Engine";
+        pShortLabel = "REng";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::SCRAMEngineLeft:
+        frac = vessel.ramjet->GetEngineIntegrity(0);
+        pLabel = "Left SCRAM Engine";
+        pShortLabel = "LScr";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::SCRAMEngineRight:
+        frac = vessel.ramjet->GetEngineIntegrity(1);
+        pLabel = "Right SCRAM Engine";
+        pShortLabel = "RScr";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::HoverEngineFore:
+        frac = vessel.m_hoverEngineIntegrity[0];
+        pLabel = "Fore Hover Engine";
+        pShortLabel = "FHov";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::HoverEngineAft:
+        frac = vessel.m_hoverEngineIntegrity[1];
+        pLabel = "Aft Hover Engine";
+        pShortLabel = "AHov";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::RetroEngineLeft:
+        frac = (MAX_RETRO_THRUST > 0 ? (vessel.GetThrusterMax0(vessel.th_retro[0]) / MAX_RETRO_THRUST) : 1.0);    // if retro max thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
+        pLabel = "Left Retro Engine";
+        pShortLabel = "LRet";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::RetroEngineRight:
+        frac = (MAX_RETRO_THRUST > 0 ? (vessel.GetThrusterMax0(vessel.th_retro[1]) / MAX_RETRO_THRUST) : 1.0);    // if retro max thrust set to zero via cheatcode, engines cannot fail (avoid divide-by-zero here as well)
+        pLabel = "Right Retro Engine";
+        pShortLabel = "RRet";
+        onlineOffline = false;     // has partial failure
+        break;
+
+    case DamageItem::RCS1:
+    case DamageItem::RCS2:
+    case DamageItem::RCS3:
+    case DamageItem::RCS4:
+    case DamageItem::RCS5:
+    case DamageItem::RCS6:
+    case DamageItem::RCS7:
+    case DamageItem::RCS8:
+    case DamageItem::RCS9:
+    case DamageItem::RCS10:
+    case DamageItem::RCS11:
+    case DamageItem::RCS12:
+    case DamageItem::RCS13:
+    case DamageItem::RCS14:
+    {
+        int index = static_cast<int>(item) - static_cast<int>(DamageItem::RCS1);    // 0-13
+        static const char* pLabels[] =
+        {
+            "Forward Lower RCS", "Aft Upper RCS", "Forward Upper RCS", "Aft Lower RCS",
+            "Forward Star. RCS", "Aft Port RCS", "Forward Port RCS", "Aft Star. RCS",
+            "Outboard Upper Port RCS", "Outboard Lower Star. RCS", "Outboard Upper Star. RCS", "Outboard Lower Port RCS",
+            "Aft RCS", "Forward RCS"
+        };
+        frac = vessel.m_rcsIntegrityArray[index];  // internal array
+        pLabel = pLabels[index];
+        sprintf(tempLabel, "RCS%d", (index + 1));     // RCS1...RCS14
+        pShortLabel = tempLabel;
+        onlineOffline = false;     // has partial failure
+        break;
+    }
+
+    default:        // should never happen!
+        frac = 0;
+        pLabel = "???????";
+        pShortLabel = "????";
+        break;
+    }
+
+    // populate the structure
+    static DamageStatus dmgStatus;
+    dmgStatus.fracIntegrity = frac;
+    strcpy(dmgStatus.label, pLabel);
+    strcpy(dmgStatus.shortLabel, pShortLabel);
+    dmgStatus.onlineOffline = onlineOffline;
+    return dmgStatus;   // return by reference
+}
@@ -0,0 +1,108 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1DockingTargets.cpp
+// Docking distance from the IDS transmitters on the nav radios.
+// ==============================================================
+
+#include "XR1DockingTargets.h"
+#include <cmath>
+
+void XR1DockingTargets::Reset()
+{
+    for (NavRadioCache &cache : m_navRadioCache)
+        cache = { false, nullptr, 0, false };
+    m_attachmentVersion = 0;
+}
+
+double XR1DockingTargets::GetDockingDistance(const XR1DockingNav &nav)
+{
+    const bool hasPayloadBay = nav.HasPayloadBay();
+
+    // if a payload vessel was attached or detached since the last frame, every transmitter must be rechecked
+    const unsigned int attachmentVersion = (hasPayloadBay ? nav.GetPayloadAttachmentVersion() : 0);
+    if (attachmentVersion != m_attachmentVersion)
+    {
+        for (NavRadioCache &cache : m_navRadioCache)
+            cache.IsValid = false;
+        m_attachmentVersion = attachmentVersion;
+    }
+
+    // NOTE: as of the XR1 1.9 release group, we no longer track XPDR for docking distance: this should fix
+    // the spurrious "Nosecone is closed" warnings when using Universal Cargo Deck and vessels attached that 
+    // default to the 108 MHz radio xpdr frequency and the XR also has a radio tuned to that default frequency.
+
+    // NOTE: Orbiter does not provide a way for us to determine which NAV radio is marked "active" by the radio MFD,
+    // so we have to just make a "best guess" by walking through all four of our nav radios and choosing the closest
+    // TRANSMITTER_IDS in range.  Distances are compared squared; only the closest one is converted to meters.
+    double closestIDSSquared = -1;      // out-of-range
+    bool haveOurPos = false;
+    VECTOR3 ourPos = { };
+
+    for (int i = 0; i < NAV_RADIO_COUNT; i++)
+    {
+        // Always ask Orbiter for the current source: it returns nullptr once the transmitter leaves range, and a handle from
+        // an earlier frame is no longer valid if its vessel has been deleted since.
+        const NAVHANDLE hNav = nav.GetNavSource(i);
+        const unsigned int channel = nav.GetNavChannel(i);
+        NavRadioCache &cache = m_navRadioCache[i];
+        if ((cache.IsValid == false) || (hNav != cache.hNav) || (channel != cache.Channel))
+        {
+            // radio retuned, transmitter came into or went out of range, or the payload bay changed: classify this transmitter again
+            cache.IsValid = true;
+            cache.hNav = hNav;
+            cache.Channel = channel;
+            cache.IsDockingTarget = false;
+            if (hNav != nullptr)  // tuned and in range?
+            {
+                // verify that the vessel is NOT attached in our cargo bay, if we have one
+                const OBJHANDLE hIDSVessel = nav.GetIDSVessel(hNav);
+                if ((hIDSVessel != nullptr) && (!hasPayloadBay || !nav.IsChildVesselAttached(hIDSVessel)))
+                    cache.IsDockingTarget = true;
+            }
+        }
+
+        if (cache.IsDockingTarget)
+        {
+            // obtain the global position of our docking port; only needed once there is a target to measure against
+            if (!haveOurPos)
+            {
+                ourPos = nav.GetDockingPortPos();
+                haveOurPos = true;
+            }
+
+            // obtain the position of the target's docking port
+            const VECTOR3 targetPos = nav.GetNavPos(hNav);
+            const double dx = ourPos.x - targetPos.x;
+            const double dy = ourPos.y - targetPos.y;
+            const double dz = ourPos.z - targetPos.z;
+            const double distanceSquared = (dx * dx) + (dy * dy) + (dz * dz);
+            if ((closestIDSSquared < 0) || (distanceSquared < closestIDSSquared))
+                closestIDSSquared = distanceSquared;     // best IDS match so far
+        }
+    }
+
+    return ((closestIDSSquared >= 0) ? sqrt(closestIDSSquared) : -1);
+}
@@ -0,0 +1,90 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1DockingTargets.h
+// Finds the docking distance to the closest IDS transmitter on the
+// nav radios, used by DockingCalloutsPreStep.  What it learns about
+// each radio's transmitter is kept until the radio's source or
+// frequency changes or a payload vessel is attached or detached, so
+// steady-state tracking needs no nav data or payload bay lookups.
+// ==============================================================
+
+#pragma once
+
+#include "Orbitersdk.h"
+
+// What XR1DockingTargets needs from Orbiter and the vessel.
+class XR1DockingNav
+{
+public:
+    virtual ~XR1DockingNav() { }
+
+    // Returns the transmitter nav radio 'radio' receives, or nullptr if it is not tuned or out of range (VESSEL::GetNavSource).
+    virtual NAVHANDLE GetNavSource(const int radio) const = 0;
+
+    // Returns nav radio 'radio''s frequency channel (VESSEL::GetNavRecv).
+    virtual unsigned int GetNavChannel(const int radio) const = 0;
+
+    // Returns the vessel that owns hNav if hNav is an IDS transmitter, or nullptr if it is any other kind (oapiGetNavData).
+    virtual OBJHANDLE GetIDSVessel(const NAVHANDLE hNav) const = 0;
+
+    // Returns the global position of hNav; for an IDS transmitter, that is its docking port (oapiGetNavPos).
+    virtual VECTOR3 GetNavPos(const NAVHANDLE hNav) const = 0;
+
+    // Returns the global position of our docking port.
+    virtual VECTOR3 GetDockingPortPos() const = 0;
+
+    // Payload bay: GetPayloadAttachmentVersion and IsChildVesselAttached are only called if HasPayloadBay returns true.
+    virtual bool HasPayloadBay() const = 0;
+    virtual unsigned int GetPayloadAttachmentVersion() const = 0;               // XRPayloadBay::GetAttachmentVersion
+    virtual bool IsChildVesselAttached(const OBJHANDLE hVessel) const = 0;      // XRPayloadBay::IsChildVesselAttached
+};
+
+class XR1DockingTargets
+{
+public:
+    static const int NAV_RADIO_COUNT = 4;
+
+    XR1DockingTargets() { Reset(); }
+
+    // Forget what is known about every radio, so the next GetDockingDistance checks each one again.
+    void Reset();
+
+    // Returns the distance in meters from our docking port to the closest IDS transmitter on any nav radio, not counting
+    // vessels attached in our payload bay, or -1 if there is none.
+    double GetDockingDistance(const XR1DockingNav &nav);
+
+protected:
+    // what GetDockingDistance last found on one nav radio
+    struct NavRadioCache
+    {
+        bool IsValid;           // false = must be rechecked
+        NAVHANDLE hNav;         // source as of the last check; nullptr = not tuned or out of range
+        unsigned int Channel;   // frequency channel as of the last check
+        bool IsDockingTarget;   // true if hNav is an IDS transmitter for a vessel that is not attached in our payload bay
+    };
+    NavRadioCache m_navRadioCache[NAV_RADIO_COUNT];
+    unsigned int m_attachmentVersion;   // XR1DockingNav::GetPayloadAttachmentVersion as of the last check; 0 if no payload bay
+};
@@ -31,6 +31,7 @@
 
 #include "DeltaGliderXR1.h"
 #include "XR1PrePostStep.h"
+#include "XR1ResupplyNetwork.h"
 
 // handles fuel callouts (full/low/depleted)
 class FuelCalloutsPostStep : public XR1PrePostStep
@@ -132,6 +133,10 @@ public:
     void AdjustPressure(const double simt, const double simdt, const double mjd);
     void Disconnected();
 
+    // in PSI; a line flows its nominal rate at nominal pressure
+    double GetPressure() const { return m_linePressure; }
+    double GetNominalPressure() const { return m_nominalLinePressure; }
+
     double m_pressureTarget;        // in PSI; -1 = "target is nominal resupply pressure"
 
 protected:
@@ -156,21 +161,46 @@ public:
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
 
 protected:
-    void PerformRefueling(const double simt, const double simdt, const double mjd);
-    void PerformLoxResupply(const double simt, const double simdt, const double mjd);
+    // Describes one external resupply line and the tank it feeds; m_lines is indexed by TANK_MAIN...TANK_LOX.
+    struct ResupplyLine
+    {
+        LinePressure *pLinePressure;
+        bool DeltaGliderXR1::*pFlowSwitch;  // flow switch in the XR1 object
+        bool isLoxLine;                     // true = fed via the LOX hatch, false = fed via the fuel hatch
+        double nominalFlowRate;             // in kg/second at nominal line pressure
+        double capacityFlowFraction;        // in tank fraction/second at nominal line pressure; the larger of the two rates is used
+        int switchAreaID;
+        int switchLedAreaID;
+        const char *pTankFullWav;
+        const char *pTankFullMsg;
+    };
+
+    static const int RESUPPLY_LINE_COUNT = TANK_LAST + 1;
+
+    void PerformResupply(const double simdt, const bool fuelLinesOnline, const bool loxLinesOnline);
     void DisconnectFuelLines();     // invoked when refueling lines disconnected
     void DisconnectLoxLine();       // invoked when LOX line disconnected
-    
-    void FlowMainFuel(const double simt, const double simdt, const double mjd);   // invoked only when refueling main tanks
-    void FlowScramFuel(const double simt, const double simdt, const double mjd);  // invoked only when refueling scram tanks
-    void FlowApuFuel(const double simt, const double simdt, const double mjd);    // invoked only when refueling apu tanks
-    void FlowLox(const double simt, const double simdt, const double mjd);        // invoked only when refueling lox tanks
-
-    // line pressure objects
-    LinePressure *m_pMainLinePressure;
-    LinePressure *m_pScramLinePressure;
-    LinePressure *m_pApuLinePressure;
-    LinePressure *m_pLoxLinePressure;
+    bool IsResupplyAvailable(const int tank) const;
+    void HaltFlow(const int tank);
+
+    void GatherTankMasses();
+    void ScatterTankMasses(const double *pPrevMass);
+    bool IsTankFull(const int tank) const;  // includes any payload bay tanks
+
+    ResupplyLine m_lines[RESUPPLY_LINE_COUNT];
+
+    // The flow network: ship tanks TANK_MAIN...TANK_LOX are nodes 0-3 and each line i feeds node i.  Main, SCRAM, and
+    // LOX each have a payload bay node linked from the ship tank, and the main tank has a cross-feed link to the RCS
+    // node.  Tank ullage pressures may be set via m_network.GetTank.
+    XR1ResupplyNetwork m_network;
+    int m_bayTank[RESUPPLY_LINE_COUNT];     // -1 = no payload bay tanks for this propellant
+    int m_bayLink[RESUPPLY_LINE_COUNT];     // -1 = no payload bay tanks for this propellant
+    int m_rcsTank;
+    int m_xfeedLink;
+
+    // Network parameters in PSI per kg/second; the defaults reproduce the original fixed-rate flows.
+    double m_bayLinkResistance;     // between a ship tank and its payload bay tanks
+    double m_xfeedLinkResistance;   // from the main tank to the RCS tank while cross-feed is set to RCS; 0 = no link, so only XFeedPostStep feeds the RCS tank
 
     // includes time for the external lines to latch to the ship; should be synced with sound effect
     const double m_resupplyStartupTime;
@@ -0,0 +1,79 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1HeatingMeshState.cpp
+// Hull heating mesh update decisions.
+// ==============================================================
+
+#include "XR1HeatingMeshState.h"
+
+void XR1HeatingMeshState::Reset()
+{
+    m_visible = false;
+    m_alphaLevel = -1;
+    m_visibilityUpdateDue = m_materialUpdateDue = false;
+}
+
+void XR1HeatingMeshState::Update(const bool bNewMesh, const double noseconeTemp, const double noseconeTempLimit)
+{
+    // We check temperature of the nosecone only; set the limits at which the mesh becomes barely visible
+    // to where it is at its maximum opacity (maxHeatingAlpha).
+    const double minVisibilityTemp = noseconeTempLimit * 0.387;  // coincides with Orbiter visual plasma
+    const double maxVisibilityTemp = noseconeTempLimit * 0.80;
+
+    // Orbiter core bug: we should only modulate alpha when the heating mesh should
+    // actually be *visible* because the Orbiter core applies the alpha setting to *all*
+    // transparent meshes in the sim, including the Sun!  This makes the sun disappear.
+    const bool bVisible = (noseconeTemp >= minVisibilityTemp);
+
+    // get the fraction between minVisiblityTemp (0) and maxVisibilityTemp (1.0) and quantize it to the mesh's
+    // alpha resolution; there is no point pushing a new material to the mesh until the quantized alpha changes.
+    int alphaLevel = 0;
+    if (bVisible)
+    {
+        double alphaFrac = ((noseconeTemp - minVisibilityTemp) / (maxVisibilityTemp - minVisibilityTemp));
+        if (alphaFrac > 1.0)
+            alphaFrac = 1.0;    // keep in range
+        alphaLevel = static_cast<int>((alphaFrac * ALPHA_LEVELS) + 0.5);
+    }
+
+    // a new mesh instance has default (hidden) state, so everything must be applied again
+    m_visibilityUpdateDue = (bNewMesh || (bVisible != m_visible));
+    m_materialUpdateDue = (bVisible && (m_visibilityUpdateDue || (alphaLevel != m_alphaLevel)));
+    if (!m_visibilityUpdateDue && !m_materialUpdateDue)
+        m_skippedUpdateCount++;
+
+    m_visible = bVisible;
+    if (m_materialUpdateDue)
+        m_alphaLevel = alphaLevel;
+}
+
+float XR1HeatingMeshState::GetAlpha() const
+{
+    // min heating alpha is 0.0
+    // BETA-1 ORG: const double maxHeatingAlpha = 0.475;
+    const double maxHeatingAlpha = 1.0;  // new heating mesh is 4-bit alpha
+    return static_cast<float>((static_cast<double>(m_alphaLevel) / ALPHA_LEVELS) * maxHeatingAlpha);
+}
@@ -0,0 +1,70 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1HeatingMeshState.h
+// Decides which hull heating mesh updates a frame needs, used by
+// SetHullTempsPostStep.  The group visibility and the material
+// alpha are only pushed to the mesh when they change; each material
+// update replaces the mesh group's material.
+// ==============================================================
+
+#pragma once
+
+class XR1HeatingMeshState
+{
+public:
+    // heating mesh alpha is quantized to the mesh's 4-bit alpha resolution: levels 0-15
+    static const int ALPHA_LEVELS = 15;
+
+    XR1HeatingMeshState() : m_skippedUpdateCount(0) { Reset(); }
+
+    // Forget the applied state, e.g., when the visual is destroyed; the next Update applies everything again.
+    void Reset();
+
+    // Work out this frame's mesh state from the nosecone temperature.
+    //   bNewMesh = true if the mesh is a new instance (e.g., a new visual) whose state is still the default
+    //   noseconeTempLimit = the vessel's nosecone temperature limit, in Kelvin
+    void Update(const bool bNewMesh, const double noseconeTemp, const double noseconeTempLimit);
+
+    // true if this frame must set the group visibility and MODULATEMATALPHA property to IsVisible()
+    bool IsVisibilityUpdateDue() const { return m_visibilityUpdateDue; }
+
+    // true if this frame must apply a material with alpha GetAlpha()
+    bool IsMaterialUpdateDue() const { return m_materialUpdateDue; }
+
+    bool IsVisible() const { return m_visible; }
+    int GetAlphaLevel() const { return m_alphaLevel; }     // -1 = no alpha applied yet
+    float GetAlpha() const;
+
+    // number of frames in which the mesh was left untouched because its quantized state did not change
+    unsigned int GetSkippedUpdateCount() const { return m_skippedUpdateCount; }
+
+protected:
+    bool m_visible;             // last group visibility applied
+    int m_alphaLevel;           // last alpha level applied, or -1 if none
+    bool m_visibilityUpdateDue;
+    bool m_materialUpdateDue;
+    unsigned int m_skippedUpdateCount;
+};
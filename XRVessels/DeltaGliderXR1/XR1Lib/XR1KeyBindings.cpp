@@ -0,0 +1,373 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1KeyBindings.cpp
+// Table of the XR keyboard commands.
+// ==============================================================
+
+#include "XR1KeyBindings.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// flag shorthand for the tables below
+static const int INCAP = KBF_ALLOW_IF_INCAP;
+static const int PLAYBACK = KBF_ALLOW_IN_PLAYBACK;
+static const int ORBITER = KBF_PASS_TO_ORBITER;
+
+// Buffered keys, one per keypress.  Within each modifier, autopilot bindings are listed before the general ones
+// they override.
+// Note: SHIFT-<numpad number> never reaches us; Orbiter sends the SHIFT keycode instead.
+static const XR1KeyBinding s_defaultBufferedBindings[] =
+{
+    // SHIFT
+    { "AirspeedHoldIncSmall",       OAPI_KEY_ADD,         XR1KeyMod::Shift,   APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldAdjust,  KEYSTEP_SMALL,  0 },
+    { "AirspeedHoldDecSmall",       OAPI_KEY_SUBTRACT,    XR1KeyMod::Shift,   APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldAdjust, -KEYSTEP_SMALL,  0 },
+
+    // CTRL
+    { "DescentHoldRateIncLarge",    OAPI_KEY_NUMPAD2,     XR1KeyMod::Control, APK_DESCENTHOLD,  XR1KeyAction::DescentHoldAdjust,   KEYSTEP_LARGE,  0 },
+    { "DescentHoldRateDecLarge",    OAPI_KEY_NUMPAD8,     XR1KeyMod::Control, APK_DESCENTHOLD,  XR1KeyAction::DescentHoldAdjust,  -KEYSTEP_LARGE,  0 },
+    { "AttitudeHoldLevelBank",      OAPI_KEY_NUMPAD3,     XR1KeyMod::Control, APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldLevelBank,  0, INCAP },
+    { "AttitudeHoldLevelPitch",     OAPI_KEY_NUMPAD7,     XR1KeyMod::Control, APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldLevelPitch, 0, INCAP },
+    { "AttitudeHoldLevelBoth",      OAPI_KEY_NUMPAD1,     XR1KeyMod::Control, APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldLevelBoth,  0, INCAP },
+    { "AirspeedHoldIncLarge",       OAPI_KEY_ADD,         XR1KeyMod::Control, APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldAdjust,  KEYSTEP_LARGE,  0 },
+    { "AirspeedHoldDecLarge",       OAPI_KEY_SUBTRACT,    XR1KeyMod::Control, APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldAdjust, -KEYSTEP_LARGE,  0 },
+    { nullptr,                      OAPI_KEY_DIVIDE,      XR1KeyMod::Control, 0, XR1KeyAction::None,                 0, ORBITER },
+    { "ToggleRCSRotation",          OAPI_KEY_SLASH,       XR1KeyMod::Control, 0, XR1KeyAction::ToggleRCSRotation,    0, 0 },  // Joy2Key sends numpad "/" as a normal "/"
+    { "KillScramThrustBackspace",   OAPI_KEY_BACK,        XR1KeyMod::Control, 0, XR1KeyAction::KillScramThrust,      0, ORBITER },
+    { "Undock",                     OAPI_KEY_D,           XR1KeyMod::Control, 0, XR1KeyAction::Undock,               0, PLAYBACK },
+    { nullptr,                      OAPI_KEY_SPACE,       XR1KeyMod::Control, 0, XR1KeyAction::None,                 0, INCAP },  // used to open the control dialog
+    { "ToggleAPU",                  OAPI_KEY_A,           XR1KeyMod::Control, 0, XR1KeyAction::ToggleAPU,            0, 0 },
+    { "ToggleAirbrake",             OAPI_KEY_B,           XR1KeyMod::Control, 0, XR1KeyAction::ToggleAirbrake,       0, 0 },
+    { "ToggleNoseCone",             OAPI_KEY_K,           XR1KeyMod::Control, 0, XR1KeyAction::ToggleNoseCone,       0, 0 },
+    { "ToggleOuterAirlock",         OAPI_KEY_O,           XR1KeyMod::Control, 0, XR1KeyAction::ToggleOuterAirlock,   0, 0 },
+    { "ToggleTopHatch",             OAPI_KEY_Y,           XR1KeyMod::Control, 0, XR1KeyAction::ToggleTopHatch,       0, 0 },
+    { nullptr,                      OAPI_KEY_H,           XR1KeyMod::Control, 0, XR1KeyAction::HUDPowerSound,        0, INCAP | PLAYBACK | ORBITER },
+    { "KillHoverThrust",            OAPI_KEY_MULTIPLY,    XR1KeyMod::Control, 0, XR1KeyAction::KillHoverThrust,      0, 0 },
+    { "ToggleRetroDoors",           OAPI_KEY_BACKSLASH,   XR1KeyMod::Control, 0, XR1KeyAction::ToggleRetroDoors,     0, 0 },
+    { "ToggleHoverDoors",           OAPI_KEY_V,           XR1KeyMod::Control, 0, XR1KeyAction::ToggleHoverDoors,     0, 0 },
+    { "ToggleScramDoors",           OAPI_KEY_G,           XR1KeyMod::Control, 0, XR1KeyAction::ToggleScramDoors,     0, 0 },
+    { "SecondaryHUDMode1",          OAPI_KEY_1,           XR1KeyMod::Control, 0, XR1KeyAction::SecondaryHUDMode,     1, INCAP | PLAYBACK },
+    { "SecondaryHUDMode2",          OAPI_KEY_2,           XR1KeyMod::Control, 0, XR1KeyAction::SecondaryHUDMode,     2, INCAP | PLAYBACK },
+    { "SecondaryHUDMode3",          OAPI_KEY_3,           XR1KeyMod::Control, 0, XR1KeyAction::SecondaryHUDMode,     3, INCAP | PLAYBACK },
+    { "SecondaryHUDMode4",          OAPI_KEY_4,           XR1KeyMod::Control, 0, XR1KeyAction::SecondaryHUDMode,     4, INCAP | PLAYBACK },
+    { "SecondaryHUDMode5",          OAPI_KEY_5,           XR1KeyMod::Control, 0, XR1KeyAction::SecondaryHUDMode,     5, INCAP | PLAYBACK },
+    { "ToggleTertiaryHUD",          OAPI_KEY_T,           XR1KeyMod::Control, 0, XR1KeyAction::ToggleTertiaryHUD,    0, INCAP | PLAYBACK },
+    { "ResetMWS",                   OAPI_KEY_W,           XR1KeyMod::Control, 0, XR1KeyAction::ResetMWS,             0, PLAYBACK },
+    { nullptr,                      OAPI_KEY_SUBTRACT,    XR1KeyMod::Control, 0, XR1KeyAction::CheckRetroDoorsIfMainIdle, 0, 0 },
+    { "SyncAttitudeHold",           OAPI_KEY_L,           XR1KeyMod::Control, 0, XR1KeyAction::SyncAttitudeHold,     0, 0 },
+
+    // ALT
+    { "DescentHoldRateIncSmall",    OAPI_KEY_NUMPAD2,     XR1KeyMod::Alt,     APK_DESCENTHOLD,  XR1KeyAction::DescentHoldAdjust,   KEYSTEP_SMALL,  0 },
+    { "DescentHoldRateDecSmall",    OAPI_KEY_NUMPAD8,     XR1KeyMod::Alt,     APK_DESCENTHOLD,  XR1KeyAction::DescentHoldAdjust,  -KEYSTEP_SMALL,  0 },
+    { "AttitudeHoldPitchIncSmall",  OAPI_KEY_NUMPAD2,     XR1KeyMod::Alt,     APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldPitch,   KEYSTEP_SMALL,  0 },
+    { "AttitudeHoldPitchDecSmall",  OAPI_KEY_NUMPAD8,     XR1KeyMod::Alt,     APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldPitch,  -KEYSTEP_SMALL,  0 },
+    { "AirspeedHoldIncTiny",        OAPI_KEY_ADD,         XR1KeyMod::Alt,     APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldAdjust,  KEYSTEP_TINY,   0 },
+    { "AirspeedHoldDecTiny",        OAPI_KEY_SUBTRACT,    XR1KeyMod::Alt,     APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldAdjust, -KEYSTEP_TINY,   0 },
+    { "ToggleRadiator",             OAPI_KEY_R,           XR1KeyMod::Alt,     0, XR1KeyAction::ToggleRadiator,       0, 0 },
+    { "ToggleSecondaryHUD",         OAPI_KEY_T,           XR1KeyMod::Alt,     0, XR1KeyAction::ToggleSecondaryHUD,   0, INCAP | PLAYBACK },
+    { nullptr,                      OAPI_KEY_H,           XR1KeyMod::Alt,     0, XR1KeyAction::HUDColorSound,        0, INCAP | PLAYBACK | ORBITER },
+    { "PreviousMDAMode",            OAPI_KEY_D,           XR1KeyMod::Alt,     0, XR1KeyAction::PreviousMDAMode,      0, INCAP | PLAYBACK },
+    { "ToggleAFCtrl",               OAPI_KEY_SLASH,       XR1KeyMod::Alt,     0, XR1KeyAction::ToggleAFCtrl,         0, 0 },
+    { "KillScramThrust",            OAPI_KEY_MULTIPLY,    XR1KeyMod::Alt,     0, XR1KeyAction::KillScramThrust,      0, 0 },
+    { "ShowDataHUD",                OAPI_KEY_SPACE,       XR1KeyMod::Alt,     0, XR1KeyAction::ShowDataHUD,          0, INCAP },  // hidden again when the key is released
+    { "ToggleAirspeedHold",         OAPI_KEY_S,           XR1KeyMod::Alt,     0, XR1KeyAction::ToggleAirspeedHold,   0, 0 },
+    { "ToggleInnerAirlock",         OAPI_KEY_O,           XR1KeyMod::Alt,     0, XR1KeyAction::ToggleInnerAirlock,   0, 0 },
+
+    // no modifier
+    { "AttitudeHoldPitchIncLarge",  OAPI_KEY_NUMPAD2,     XR1KeyMod::None,    APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldPitch,   KEYSTEP_LARGE,  0 },
+    { "AttitudeHoldPitchDecLarge",  OAPI_KEY_NUMPAD8,     XR1KeyMod::None,    APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldPitch,  -KEYSTEP_LARGE,  0 },
+    { "AttitudeHoldBankInc",        OAPI_KEY_NUMPAD4,     XR1KeyMod::None,    APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldBank,    1, 0 },
+    { "AttitudeHoldBankDec",        OAPI_KEY_NUMPAD6,     XR1KeyMod::None,    APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldBank,   -1, 0 },
+    { "AttitudeHoldToggleAOAPitch", OAPI_KEY_NUMPAD9,     XR1KeyMod::None,    APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldToggleAOAPitch, 0, 0 },
+    { "DescentHoldRateIncMed",      OAPI_KEY_NUMPAD2,     XR1KeyMod::None,    APK_DESCENTHOLD,  XR1KeyAction::DescentHoldAdjust,   KEYSTEP_MED,    0 },
+    { "DescentHoldRateDecMed",      OAPI_KEY_NUMPAD8,     XR1KeyMod::None,    APK_DESCENTHOLD,  XR1KeyAction::DescentHoldAdjust,  -KEYSTEP_MED,    0 },
+    { "DescentHoldAutoLand",        OAPI_KEY_NUMPAD0,     XR1KeyMod::None,    APK_DESCENTHOLD,  XR1KeyAction::DescentHoldAutoLand, 0, 0 },
+    { "DescentHoldLevel",           OAPI_KEY_DECIMAL,     XR1KeyMod::None,    APK_DESCENTHOLD,  XR1KeyAction::DescentHoldLevel,    0, 0 },
+    { "AirspeedHoldIncMed",         OAPI_KEY_ADD,         XR1KeyMod::None,    APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldAdjust,  KEYSTEP_MED,    0 },
+    { "AirspeedHoldDecMed",         OAPI_KEY_SUBTRACT,    XR1KeyMod::None,    APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldAdjust, -KEYSTEP_MED,    0 },
+    { "AirspeedHoldCurrent",        OAPI_KEY_NUMPADENTER, XR1KeyMod::None,    APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldCurrent, 0, 0 },
+    { "AirspeedHoldReset",          OAPI_KEY_MULTIPLY,    XR1KeyMod::None,    APK_AIRSPEEDHOLD, XR1KeyAction::AirspeedHoldReset,   0, 0 },
+    { nullptr,                      OAPI_KEY_DIVIDE,      XR1KeyMod::None,    0, XR1KeyAction::None,                 0, ORBITER },
+    { "ToggleAttitudeHold",         OAPI_KEY_L,           XR1KeyMod::None,    0, XR1KeyAction::ToggleAttitudeHold,   0, 0 },  // replaces Orbiter's "Level Horizon" autopilot
+    { "ToggleDescentHold",          OAPI_KEY_A,           XR1KeyMod::None,    0, XR1KeyAction::ToggleDescentHold,    0, 0 },  // replaces Orbiter's "Hover Hold Alt" autopilot
+    { nullptr,                      OAPI_KEY_LBRACKET,    XR1KeyMod::None,    0, XR1KeyAction::None,                 0, ORBITER },
+    { nullptr,                      OAPI_KEY_RBRACKET,    XR1KeyMod::None,    0, XR1KeyAction::None,                 0, ORBITER },
+    { nullptr,                      OAPI_KEY_SEMICOLON,   XR1KeyMod::None,    0, XR1KeyAction::None,                 0, ORBITER },
+    { nullptr,                      OAPI_KEY_APOSTROPHE,  XR1KeyMod::None,    0, XR1KeyAction::None,                 0, ORBITER },
+    { nullptr,                      OAPI_KEY_NUMPAD5,     XR1KeyMod::None,    0, XR1KeyAction::None,                 0, ORBITER },  // killrot
+    { "MDAMode0",                   OAPI_KEY_0,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              0, INCAP | PLAYBACK },
+    { "MDAMode1",                   OAPI_KEY_1,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              1, INCAP | PLAYBACK },
+    { "MDAMode2",                   OAPI_KEY_2,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              2, INCAP | PLAYBACK },
+    { "MDAMode3",                   OAPI_KEY_3,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              3, INCAP | PLAYBACK },
+    { "MDAMode4",                   OAPI_KEY_4,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              4, INCAP | PLAYBACK },
+    { "MDAMode5",                   OAPI_KEY_5,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              5, INCAP | PLAYBACK },
+    { "MDAMode6",                   OAPI_KEY_6,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              6, INCAP | PLAYBACK },
+    { "MDAMode7",                   OAPI_KEY_7,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              7, INCAP | PLAYBACK },
+    { "MDAMode8",                   OAPI_KEY_8,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              8, INCAP | PLAYBACK },
+    { "MDAMode9",                   OAPI_KEY_9,           XR1KeyMod::None,    0, XR1KeyAction::MDAMode,              9, INCAP | PLAYBACK },
+    { "NextMDAMode",                OAPI_KEY_D,           XR1KeyMod::None,    0, XR1KeyAction::NextMDAMode,          0, INCAP | PLAYBACK },
+    { nullptr,                      OAPI_KEY_H,           XR1KeyMod::None,    0, XR1KeyAction::HUDModeSound,         0, INCAP | PLAYBACK | ORBITER },
+    { "ToggleRCSMode",              OAPI_KEY_SLASH,       XR1KeyMod::None,    0, XR1KeyAction::ToggleRCSMode,        0, 0 },  // Joy2Key sends numpad "/" as a normal "/"
+    { nullptr,                      OAPI_KEY_MULTIPLY,    XR1KeyMod::None,    0, XR1KeyAction::KillMainThrustSound,  0, ORBITER },
+    { nullptr,                      OAPI_KEY_SUBTRACT,    XR1KeyMod::None,    0, XR1KeyAction::CheckRetroDoors,      0, 0 },
+    { "ToggleLandingGear",          OAPI_KEY_G,           XR1KeyMod::None,    0, XR1KeyAction::ToggleLandingGear,    0, 0 },
+    { "KillAllAutopilots",          OAPI_KEY_SPACE,       XR1KeyMod::None,    0, XR1KeyAction::KillAllAutopilots,    0, 0 },
+};
+
+// Direct keys, checked every frame in this order while any key is down.
+static const XR1KeyBinding s_defaultDirectBindings[] =
+{
+    // ALT
+    { "TweakInternalValueDown",     OAPI_KEY_1,           XR1KeyMod::Alt,     0, XR1KeyAction::TweakInternalValueDown, 0, INCAP },  // development testing only
+    { "TweakInternalValueUp",       OAPI_KEY_2,           XR1KeyMod::Alt,     0, XR1KeyAction::TweakInternalValueUp,   0, INCAP },
+    { "ShiftCOGAft",                OAPI_KEY_COMMA,       XR1KeyMod::Alt,     0, XR1KeyAction::ShiftCOGAft,          0, 0 },
+    { "ShiftCOGForward",            OAPI_KEY_PERIOD,      XR1KeyMod::Alt,     0, XR1KeyAction::ShiftCOGForward,      0, 0 },
+    { "RecenterCOG",                OAPI_KEY_M,           XR1KeyMod::Alt,     0, XR1KeyAction::RecenterCOG,          0, 0 },
+    { "ScramThrustInc",             OAPI_KEY_ADD,         XR1KeyMod::Alt,     0, XR1KeyAction::ScramThrustInc,       0, 0 },
+    { "ScramThrustDec",             OAPI_KEY_SUBTRACT,    XR1KeyMod::Alt,     0, XR1KeyAction::ScramThrustDec,       0, 0 },
+    { "ScramThrustIncFine",         OAPI_KEY_EQUALS,      XR1KeyMod::Alt,     0, XR1KeyAction::ScramThrustIncFine,   0, 0 },
+    { "ScramThrustDecFine",         OAPI_KEY_MINUS,       XR1KeyMod::Alt,     0, XR1KeyAction::ScramThrustDecFine,   0, 0 },
+    { "HUDDimmer",                  OAPI_KEY_Z,           XR1KeyMod::Alt,     0, XR1KeyAction::HUDDimmer,            0, INCAP },
+    { "HUDBrighter",                OAPI_KEY_X,           XR1KeyMod::Alt,     0, XR1KeyAction::HUDBrighter,          0, INCAP },
+    { "GimbalAllUp",                OAPI_KEY_SEMICOLON,   XR1KeyMod::Alt,     0, XR1KeyAction::GimbalAllUp,          0, 0 },
+    { "GimbalAllRight",             OAPI_KEY_L,           XR1KeyMod::Alt,     0, XR1KeyAction::GimbalAllRight,       0, 0 },
+    { "GimbalAllDown",              OAPI_KEY_P,           XR1KeyMod::Alt,     0, XR1KeyAction::GimbalAllDown,        0, 0 },
+    { "GimbalAllLeft",              OAPI_KEY_APOSTROPHE,  XR1KeyMod::Alt,     0, XR1KeyAction::GimbalAllLeft,        0, 0 },
+    { "GimbalRecenter",             OAPI_KEY_0,           XR1KeyMod::Alt,     0, XR1KeyAction::GimbalRecenter,       0, 0 },
+
+    // CTRL
+    { "ElevatorTrimInc",            OAPI_KEY_COMMA,       XR1KeyMod::Control, 0, XR1KeyAction::ElevatorTrimInc,      0, 0 },
+    { "ElevatorTrimDec",            OAPI_KEY_PERIOD,      XR1KeyMod::Control, 0, XR1KeyAction::ElevatorTrimDec,      0, 0 },
+    { "ScramThrustIncMainKeyboard", OAPI_KEY_EQUALS,      XR1KeyMod::Control, 0, XR1KeyAction::ScramThrustInc,       0, 0 },
+    { "ScramThrustDecMainKeyboard", OAPI_KEY_MINUS,       XR1KeyMod::Control, 0, XR1KeyAction::ScramThrustDec,       0, 0 },
+
+    // SHIFT
+    { "HoverThrustIncFine",         OAPI_KEY_NUMPAD0,     XR1KeyMod::Shift,   0, XR1KeyAction::HoverThrustIncFine,   0, 0 },
+    { "HoverThrustDecFine",         OAPI_KEY_DECIMAL,     XR1KeyMod::Shift,   0, XR1KeyAction::HoverThrustDecFine,   0, 0 },
+};
+
+// key names for the config file; these are the OAPI_KEY_* names without the prefix
+#define KEY_NAME(k) { #k, OAPI_KEY_##k }
+static const struct { const char *pName; int key; } s_keyNames[] =
+{
+    KEY_NAME(ESCAPE), KEY_NAME(1), KEY_NAME(2), KEY_NAME(3), KEY_NAME(4), KEY_NAME(5), KEY_NAME(6), KEY_NAME(7), KEY_NAME(8), KEY_NAME(9), KEY_NAME(0),
+    KEY_NAME(MINUS), KEY_NAME(EQUALS), KEY_NAME(BACK), KEY_NAME(TAB),
+    KEY_NAME(Q), KEY_NAME(W), KEY_NAME(E), KEY_NAME(R), KEY_NAME(T), KEY_NAME(Y), KEY_NAME(U), KEY_NAME(I), KEY_NAME(O), KEY_NAME(P),
+    KEY_NAME(LBRACKET), KEY_NAME(RBRACKET), KEY_NAME(RETURN),
+    KEY_NAME(A), KEY_NAME(S), KEY_NAME(D), KEY_NAME(F), KEY_NAME(G), KEY_NAME(H), KEY_NAME(J), KEY_NAME(K), KEY_NAME(L),
+    KEY_NAME(SEMICOLON), KEY_NAME(APOSTROPHE), KEY_NAME(GRAVE), KEY_NAME(BACKSLASH),
+    KEY_NAME(Z), KEY_NAME(X), KEY_NAME(C), KEY_NAME(V), KEY_NAME(B), KEY_NAME(N), KEY_NAME(M),
+    KEY_NAME(COMMA), KEY_NAME(PERIOD), KEY_NAME(SLASH), KEY_NAME(SPACE),
+    KEY_NAME(F1), KEY_NAME(F2), KEY_NAME(F3), KEY_NAME(F4), KEY_NAME(F5), KEY_NAME(F6), KEY_NAME(F7), KEY_NAME(F8), KEY_NAME(F9), KEY_NAME(F10), KEY_NAME(F11), KEY_NAME(F12),
+    KEY_NAME(NUMPAD0), KEY_NAME(NUMPAD1), KEY_NAME(NUMPAD2), KEY_NAME(NUMPAD3), KEY_NAME(NUMPAD4),
+    KEY_NAME(NUMPAD5), KEY_NAME(NUMPAD6), KEY_NAME(NUMPAD7), KEY_NAME(NUMPAD8), KEY_NAME(NUMPAD9),
+    KEY_NAME(MULTIPLY), KEY_NAME(SUBTRACT), KEY_NAME(ADD), KEY_NAME(DECIMAL), KEY_NAME(DIVIDE), KEY_NAME(NUMPADENTER),
+    KEY_NAME(HOME), KEY_NAME(UP), KEY_NAME(PRIOR), KEY_NAME(LEFT), KEY_NAME(RIGHT), KEY_NAME(END), KEY_NAME(DOWN), KEY_NAME(NEXT),
+    KEY_NAME(INSERT), KEY_NAME(DELETE)
+};
+#undef KEY_NAME
+
+// Constructor
+XR1KeyBindings::XR1KeyBindings() :
+    m_bufferedBindings(std::begin(s_defaultBufferedBindings), std::end(s_defaultBufferedBindings)),
+    m_directBindings(std::begin(s_defaultDirectBindings), std::end(s_defaultDirectBindings))
+{
+    BuildIndex();
+}
+
+bool XR1KeyBindings::IsAnyKeyDown(const char *kstate)
+{
+    // This is called every frame, and on nearly every frame no key is down, so we OR the buffer together a word at
+    // a time instead of testing each key.
+    uint64_t combined = 0;
+    for (int i = 0; i < 256; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, kstate + i, sizeof(word));  // kstate has no alignment guarantee
+        combined |= word;
+    }
+    return ((combined & 0x8080808080808080ULL) != 0);  // same bit that KEYDOWN tests
+}
+
+XR1KeyMod XR1KeyBindings::GetBufferedKeyMod(const char *kstate)
+{
+    if (KEYMOD_SHIFT(kstate))
+        return XR1KeyMod::Shift;
+    if (KEYMOD_CONTROL(kstate))
+        return XR1KeyMod::Control;
+    if (KEYMOD_ALT(kstate))
+        return XR1KeyMod::Alt;
+    return XR1KeyMod::None;
+}
+
+const XR1KeyBinding *XR1KeyBindings::FindBufferedKey(const int key, const XR1KeyMod mod, const int autopilotMask) const
+{
+    if ((key <= 0) || (key > 255))
+        return nullptr;
+
+    for (const int index : m_bufferedKeyIndex[key])
+    {
+        const XR1KeyBinding &binding = m_bufferedBindings[index];
+        if ((binding.mod == mod) && ((binding.autopilotMask == 0) || (binding.autopilotMask & autopilotMask)))
+            return &binding;
+    }
+    return nullptr;
+}
+
+const XR1KeyBinding *XR1KeyBindings::FindAction(const XR1KeyAction action) const
+{
+    for (const std::vector<XR1KeyBinding> *pBindings : { &m_bufferedBindings, &m_directBindings })
+    {
+        for (const XR1KeyBinding &binding : *pBindings)
+        {
+            if (binding.action == action)
+                return &binding;
+        }
+    }
+    return nullptr;
+}
+
+int XR1KeyBindings::GetInvertedParam(const XR1KeyBinding &binding, const bool invertAttitudeHoldPitchArrows, const bool invertDescentHoldRateArrows)
+{
+    if (((binding.action == XR1KeyAction::AttitudeHoldPitch) && invertAttitudeHoldPitchArrows) ||
+        ((binding.action == XR1KeyAction::DescentHoldAdjust) && invertDescentHoldRateArrows))
+        return -binding.param;
+    return binding.param;
+}
+
+void XR1KeyBindings::SwallowAutopilotKeys(char *kstate, const int autopilotMask) const
+{
+    if (autopilotMask == 0)
+        return;
+
+    for (const AutopilotKey &autopilotKey : m_autopilotKeys)
+    {
+        if ((autopilotKey.autopilotMask & autopilotMask) && KEYDOWN(kstate, autopilotKey.key))
+            RESETKEY(kstate, autopilotKey.key);
+    }
+}
+
+bool XR1KeyBindings::ParseKey(const char *pKey, int &key, XR1KeyMod &mod)
+{
+    static const struct { const char *pPrefix; XR1KeyMod mod; } s_mods[] =
+    {
+        { "SHIFT-", XR1KeyMod::Shift }, { "CTRL-", XR1KeyMod::Control }, { "ALT-", XR1KeyMod::Alt }
+    };
+
+    mod = XR1KeyMod::None;
+    for (const auto &m : s_mods)
+    {
+        const size_t len = strlen(m.pPrefix);
+        if (strncasecmp(pKey, m.pPrefix, len) == 0)
+        {
+            mod = m.mod;
+            pKey += len;
+            break;
+        }
+    }
+
+    if ((mod == XR1KeyMod::None) && (strcasecmp(pKey, "NONE") == 0))
+    {
+        key = 0;    // unbound
+        return true;
+    }
+
+    for (const auto &k : s_keyNames)
+    {
+        if (strcasecmp(pKey, k.pName) == 0)
+        {
+            key = k.key;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool XR1KeyBindings::Remap(const char *pName, const char *pKey)
+{
+    int key;
+    XR1KeyMod mod;
+    XR1KeyBinding *pBinding = FindByName(pName);
+    if ((pBinding == nullptr) || !ParseKey(pKey, key, mod))
+        return false;
+
+    pBinding->key = key;
+    pBinding->mod = mod;
+
+    // move it to the front of its table so that it wins over any other binding on the same key
+    std::vector<XR1KeyBinding> &bindings = ((pBinding >= m_bufferedBindings.data()) && (pBinding < m_bufferedBindings.data() + m_bufferedBindings.size())) ?
+        m_bufferedBindings : m_directBindings;
+    std::rotate(bindings.begin(), bindings.begin() + (pBinding - bindings.data()), bindings.begin() + (pBinding - bindings.data()) + 1);
+
+    BuildIndex();
+    return true;
+}
+
+XR1KeyBinding *XR1KeyBindings::FindByName(const char *pName)
+{
+    for (std::vector<XR1KeyBinding> *pBindings : { &m_bufferedBindings, &m_directBindings })
+    {
+        for (XR1KeyBinding &binding : *pBindings)
+        {
+            if ((binding.pName != nullptr) && (strcasecmp(binding.pName, pName) == 0))
+                return &binding;
+        }
+    }
+    return nullptr;
+}
+
+void XR1KeyBindings::BuildIndex()
+{
+    for (std::vector<int> &keyIndex : m_bufferedKeyIndex)
+        keyIndex.clear();
+    m_autopilotKeys.clear();
+
+    // autopilot bindings first so that they win over the general bindings on the same key
+    for (const bool isAutopilotPass : { true, false })
+    {
+        for (int i = 0; i < static_cast<int>(m_bufferedBindings.size()); i++)
+        {
+            const XR1KeyBinding &binding = m_bufferedBindings[i];
+            if ((binding.key != 0) && ((binding.autopilotMask != 0) == isAutopilotPass))
+                m_bufferedKeyIndex[binding.key].push_back(i);
+        }
+    }
+
+    // An engaged autopilot swallows its unmodified keys so that Orbiter's default handler does not fire the RCS,
+    // hover, etc. for them.
+    for (const XR1KeyBinding &binding : m_bufferedBindings)
+    {
+        if ((binding.key == 0) || (binding.autopilotMask == 0) || (binding.mod != XR1KeyMod::None))
+            continue;
+
+        auto it = std::find_if(m_autopilotKeys.begin(), m_autopilotKeys.end(), [&binding](const AutopilotKey &k) { return (k.key == binding.key); });
+        if (it != m_autopilotKeys.end())
+            it->autopilotMask |= binding.autopilotMask;
+        else
+            m_autopilotKeys.push_back({ binding.key, binding.autopilotMask });
+    }
+}
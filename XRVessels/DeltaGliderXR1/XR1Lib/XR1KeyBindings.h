@@ -0,0 +1,187 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1KeyBindings.h
+// Table of the XR keyboard commands, used by clbkConsumeDirectKey and
+// clbkConsumeBufferedKey.
+//
+// Each binding maps a key, a modifier, and the autopilot states it is
+// limited to to an action.  The keys can be remapped from the
+// [KEYBINDINGS] section of the config file.  This class has no
+// Orbiter dependency beyond the key codes, so the KeyBindingsCheck
+// tool can run it against the original key handlers.
+// ==============================================================
+
+#pragma once
+
+#include "Orbitersdk.h"     // OAPI_KEY_* codes and KEYDOWN/KEYMOD_* macros
+#include <vector>
+
+// The modifier a binding requires.  A buffered key has one modifier at most: SHIFT wins over CTRL, and CTRL over ALT.
+enum class XR1KeyMod { None, Shift, Control, Alt };
+
+// autopilot states that a binding is limited to; a mask of 0 means the binding works in any state
+enum XR1AutopilotKeyMask
+{
+    APK_ATTITUDEHOLD = 0x01,
+    APK_DESCENTHOLD  = 0x02,
+    APK_AIRSPEEDHOLD = 0x04
+};
+
+enum XR1KeyBindingFlags
+{
+    KBF_ALLOW_IF_INCAP    = 0x01,   // works even if the crew is incapacitated or no pilot is on board
+    KBF_ALLOW_IN_PLAYBACK = 0x02,   // works during a playback
+    KBF_PASS_TO_ORBITER   = 0x04    // Orbiter's default handler gets the key as well
+};
+
+// step sizes for the autopilot adjustment actions; these bindings' param is + or - one of these
+enum XR1KeyStep { KEYSTEP_TINY = 1, KEYSTEP_SMALL, KEYSTEP_MED, KEYSTEP_LARGE };
+
+enum class XR1KeyAction
+{
+    None,   // no XR action; with KBF_PASS_TO_ORBITER the key is only swallowed if the crew is incapacitated
+
+    // buffered keys
+    AirspeedHoldAdjust, AirspeedHoldCurrent, AirspeedHoldReset, ToggleAirspeedHold,
+    DescentHoldAdjust, DescentHoldAutoLand, DescentHoldLevel, ToggleDescentHold,
+    AttitudeHoldPitch, AttitudeHoldBank, AttitudeHoldToggleAOAPitch,
+    AttitudeHoldLevelBank, AttitudeHoldLevelPitch, AttitudeHoldLevelBoth, ToggleAttitudeHold, SyncAttitudeHold,
+    KillAllAutopilots,
+    ToggleRCSRotation, ToggleRCSMode, ToggleAFCtrl,
+    KillMainThrustSound, KillHoverThrust, KillScramThrust,
+    CheckRetroDoors, CheckRetroDoorsIfMainIdle,
+    Undock, ToggleAPU, ToggleAirbrake, ToggleNoseCone, ToggleOuterAirlock, ToggleInnerAirlock, ToggleTopHatch,
+    ToggleRadiator, ToggleRetroDoors, ToggleHoverDoors, ToggleScramDoors, ToggleLandingGear,
+    HUDPowerSound, HUDModeSound, HUDColorSound,
+    SecondaryHUDMode, ToggleSecondaryHUD, ToggleTertiaryHUD, ShowDataHUD,
+    MDAMode, NextMDAMode, PreviousMDAMode,
+    ResetMWS,
+
+    // direct keys, which act every frame while they are held down
+    TweakInternalValueDown, TweakInternalValueUp,
+    ShiftCOGAft, ShiftCOGForward, RecenterCOG,
+    ScramThrustInc, ScramThrustDec, ScramThrustIncFine, ScramThrustDecFine,
+    HoverThrustIncFine, HoverThrustDecFine,
+    HUDDimmer, HUDBrighter,
+    GimbalAllUp, GimbalAllDown, GimbalAllLeft, GimbalAllRight, GimbalRecenter,
+    ElevatorTrimInc, ElevatorTrimDec
+};
+
+struct XR1KeyBinding
+{
+    const char *pName;      // name in the [KEYBINDINGS] config section; nullptr = adds a sound or check to one of Orbiter's own keys, so it cannot be remapped
+    int key;                // OAPI_KEY_*; 0 = unbound
+    XR1KeyMod mod;
+    int autopilotMask;      // APK_* bits; 0 = any autopilot state
+    XR1KeyAction action;
+    int param;              // action-specific: a signed XR1KeyStep, mode number, etc.
+    int flags;              // KBF_* bits
+};
+
+class XR1KeyBindings
+{
+public:
+    XR1KeyBindings();   // the default bindings
+
+    // Returns true if any key in the 256-byte Orbiter key state buffer is down
+    static bool IsAnyKeyDown(const char *kstate);
+
+    // Returns the modifier a buffered key was pressed with
+    static XR1KeyMod GetBufferedKeyMod(const char *kstate);
+
+    // Returns the binding for a buffered key, or nullptr if the key is not bound.  Bindings limited to an engaged
+    // autopilot win over general ones.
+    const XR1KeyBinding *FindBufferedKey(const int key, const XR1KeyMod mod, const int autopilotMask) const;
+
+    // Returns the first binding for the specified action, or nullptr if there is none
+    const XR1KeyBinding *FindAction(const XR1KeyAction action) const;
+
+    // Returns the binding's param with the arrow inversion config settings applied
+    static int GetInvertedParam(const XR1KeyBinding &binding, const bool invertAttitudeHoldPitchArrows, const bool invertDescentHoldRateArrows);
+
+    // Resets each unmodified key used by an engaged autopilot so that Orbiter's default handler does not see it
+    // regardless of any ALT/SHIFT/CTRL pressed.
+    void SwallowAutopilotKeys(char *kstate, const int autopilotMask) const;
+
+    // Invokes perform(binding) for each direct key binding whose key and modifier are down, in table order, and resets
+    // the key.  If the crew is incapacitated, bindings without KBF_ALLOW_IF_INCAP only reset their key.
+    template <class TPerform>
+    void DispatchDirectKeys(char *kstate, const bool isIncapacitated, TPerform perform) const
+    {
+        for (const XR1KeyBinding &binding : m_directBindings)
+        {
+            if ((binding.key != 0) && KEYDOWN(kstate, binding.key) && IsDirectModDown(kstate, binding.mod))
+            {
+                if (!isIncapacitated || (binding.flags & KBF_ALLOW_IF_INCAP))
+                    perform(binding);
+                RESETKEY(kstate, binding.key);
+            }
+        }
+    }
+
+    // Remap a binding from a [KEYBINDINGS] config line; e.g., "ToggleLandingGear", "CTRL-F5".  The remapped binding
+    // wins over any other on the same key.  A key of "NONE" unbinds it.
+    // Returns false if the name or key is invalid.
+    bool Remap(const char *pName, const char *pKey);
+
+    // Returns true if pName is a binding that can be remapped
+    bool IsRemappable(const char *pName) const { return (FindByName(pName) != nullptr); }
+
+    // Parse a key such as "ALT-NUMPAD2" or "G"; returns false if it is invalid
+    static bool ParseKey(const char *pKey, int &key, XR1KeyMod &mod);
+
+    const std::vector<XR1KeyBinding> &GetBufferedBindings() const { return m_bufferedBindings; }
+    const std::vector<XR1KeyBinding> &GetDirectBindings() const { return m_directBindings; }
+
+protected:
+    // Direct keys check each modifier on its own, so a key held with ALT and CTRL runs both bindings.
+    static bool IsDirectModDown(const char *kstate, const XR1KeyMod mod)
+    {
+        switch (mod)
+        {
+        case XR1KeyMod::Shift:   return KEYMOD_SHIFT(kstate);
+        case XR1KeyMod::Control: return KEYMOD_CONTROL(kstate);
+        case XR1KeyMod::Alt:     return KEYMOD_ALT(kstate);
+        default:                 return !KEYMOD_SHIFT(kstate) && !KEYMOD_CONTROL(kstate) && !KEYMOD_ALT(kstate);
+        }
+    }
+
+    XR1KeyBinding *FindByName(const char *pName);
+    const XR1KeyBinding *FindByName(const char *pName) const { return const_cast<XR1KeyBindings *>(this)->FindByName(pName); }
+    void BuildIndex();
+
+    std::vector<XR1KeyBinding> m_bufferedBindings;  // remapped bindings first, then in default order
+    std::vector<XR1KeyBinding> m_directBindings;    // in dispatch order
+    std::vector<int> m_bufferedKeyIndex[256];       // m_bufferedBindings indexes for each key; autopilot bindings first
+
+    struct AutopilotKey
+    {
+        int key;
+        int autopilotMask;  // APK_* bits of the autopilots that swallow this key
+    };
+    std::vector<AutopilotKey> m_autopilotKeys;      // for SwallowAutopilotKeys
+};
@@ -27,9 +27,26 @@
 // Contains DeltaGliderXR1 key handler methods
 // ==============================================================
 
+
 #include "DeltaGliderXR1.h"
 #include "AreaIDs.h"
 #include "XR1MultiDisplayArea.h"
+#include <cstdlib>
+
+// Returns the APK_* bits for the custom autopilots that are engaged
+int DeltaGliderXR1::GetAutopilotKeyMask() const
+{
+    int autopilotMask = 0;
+    if (m_customAutopilotMode == AUTOPILOT::AP_ATTITUDEHOLD)
+        autopilotMask |= APK_ATTITUDEHOLD;
+    else if (m_customAutopilotMode == AUTOPILOT::AP_DESCENTHOLD)
+        autopilotMask |= APK_DESCENTHOLD;
+
+    if (m_airspeedHoldEngaged)
+        autopilotMask |= APK_AIRSPEEDHOLD;
+
+    return autopilotMask;
+}
 
 // --------------------------------------------------------------
 // Process direct key events
@@ -42,32 +59,14 @@ int DeltaGliderXR1::clbkConsumeDirectKey(char *kstate)
 
 #define RESET_KEY_IF_INCAP(keyCode)  if (KEYDOWN(kstate, keyCode) && IsCrewIncapacitatedOrNoPilotOnBoard()) RESETKEY(kstate, keyCode)
 
-#define RESET_KEY_IF_PRESSED(keyCode)  if (KEYDOWN(kstate, keyCode)) RESETKEY(kstate, keyCode)
+    // nothing to do if no key is down, which is the case on nearly every frame
+    if (!XR1KeyBindings::IsAnyKeyDown(kstate))
+        return 0;
 
-    // swallow these keys regardless of any alt/shift/ctrl pressed
-    if (m_customAutopilotMode == AUTOPILOT::AP_ATTITUDEHOLD)
-    {
-        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD2);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD8);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD4);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD6);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD9);
-    }
-    else if (m_customAutopilotMode == AUTOPILOT::AP_DESCENTHOLD)
-    {
-        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD2);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD8);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD0);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_DECIMAL);
-    }
+    const XR1KeyBindings &keyBindings = GetXR1Config()->KeyBindings;
 
-    if (m_airspeedHoldEngaged)
-    {
-        RESET_KEY_IF_PRESSED(OAPI_KEY_ADD);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_SUBTRACT);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_MULTIPLY);
-        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPADENTER);
-    }
+    // swallow these keys regardless of any alt/shift/ctrl pressed
+    keyBindings.SwallowAutopilotKeys(kstate, GetAutopilotKeyMask());
 
     // dev testing only!
     /*
@@ -88,295 +87,9 @@ int DeltaGliderXR1::clbkConsumeDirectKey(char *kstate)
     }
     */
 
-    if (KEYMOD_ALT(kstate))
-    {
-        {
-            // These two keys are for development testing to tweak some internal value.
-            if (KEYDOWN(kstate, OAPI_KEY_1))
-            {
-                TweakInternalValue(false);      // direction DOWN
-                RESETKEY(kstate, OAPI_KEY_1);
-            }
-
-            if (KEYDOWN(kstate, OAPI_KEY_2))
-            {
-                TweakInternalValue(true);      // direction UP
-                RESETKEY(kstate, OAPI_KEY_2);
-            }
-
-            // center-of-gravity shift keys
-            const double cogShiftStep = (oapiGetSimStep() * COL_MAX_SHIFT_RATE * COL_KEY_SHIFT_RATE_FRACTION);
-            RESET_KEY_IF_INCAP(OAPI_KEY_COMMA);
-            if (KEYDOWN(kstate, OAPI_KEY_COMMA))   // shift COG aft
-            { 
-                // must shift center of lift *forward* to simulate a COG shift *aft*
-                if (VerifyManualCOGShiftAvailable())    // plays warning if necessary
-                    ShiftCenterOfLift(cogShiftStep);
-
-                RESETKEY(kstate, OAPI_KEY_COMMA);
-            }
-
-            RESET_KEY_IF_INCAP(OAPI_KEY_PERIOD);
-            if (KEYDOWN(kstate, OAPI_KEY_PERIOD))  // shift COG forward
-            { 
-                // must shift center of lift *aft* to simulate a COG shift *forward*
-                if (VerifyManualCOGShiftAvailable())    // plays warning if necessary
-                    ShiftCenterOfLift(-cogShiftStep);
-
-                RESETKEY(kstate, OAPI_KEY_PERIOD);
-            }
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_M);
-        if (KEYDOWN(kstate, OAPI_KEY_M))  // recenter COG
-        { 
-            SetRecenterCenterOfGravityMode(true);
-            RESETKEY(kstate, OAPI_KEY_M);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_ADD);
-        if (KEYDOWN(kstate, OAPI_KEY_ADD))  // increment scram thrust
-        { 
-            if (m_isScramEnabled == false)
-            {
-                PlaySound(ScramDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                ShowWarning(nullptr, DeltaGliderXR1::ST_None, "SCRAM Doors are closed.");
-            }
-            else    // SCRAM engines enabled
-            {
-                for (int i = 0; i < 2; i++)
-                {
-                    IncThrusterLevel (th_scram[i], oapiGetSimStep() * 0.3);
-                    scram_intensity[i] = GetThrusterLevel(th_scram[i]) * scram_max[i];
-                }
-            }
-            RESETKEY(kstate, OAPI_KEY_ADD);
-        }
-        
-        RESET_KEY_IF_INCAP(OAPI_KEY_SUBTRACT);
-        if (KEYDOWN(kstate, OAPI_KEY_SUBTRACT))  // decrement scram thrust
-        { 
-            if (m_isScramEnabled == false)
-            {
-                PlaySound(ScramDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                ShowWarning(nullptr, DeltaGliderXR1::ST_None, "SCRAM Doors are closed.");
-            }
-            else    // SCRAM engines enabled
-            {
-                for (int i = 0; i < 2; i++)
-                {
-                    IncThrusterLevel (th_scram[i], oapiGetSimStep() * -0.3);
-                    scram_intensity[i] = GetThrusterLevel (th_scram[i]) * scram_max[i];
-                }
-            }
-            RESETKEY(kstate, OAPI_KEY_SUBTRACT);
-        }
-
-        // rate is 3% throttle per second vs. normal rate of 30% (1/10th power)
-        const double microRate = oapiGetSimStep() * THROTTLE_MICRO_FRAC;
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_EQUALS);
-        if (KEYDOWN(kstate, OAPI_KEY_EQUALS))  // small inc SCRAM thrust
-        { 
-            if (m_isScramEnabled == false)
-            {
-                PlaySound(ScramDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                ShowWarning(nullptr, DeltaGliderXR1::ST_None, "SCRAM Doors are closed.");
-            }
-            else    // SCRAM engines enabled
-            {
-                for (int i = 0; i < 2; i++)
-                    IncThrusterLevel(th_scram[i], microRate);
-            }
-            RESETKEY(kstate, OAPI_KEY_EQUALS);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_MINUS);
-        if (KEYDOWN(kstate, OAPI_KEY_MINUS))  // small dec SCRAM thrust
-        { 
-            if (m_isScramEnabled == false)
-            {
-                PlaySound(ScramDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                ShowWarning(nullptr, DeltaGliderXR1::ST_None, "SCRAM Doors are closed.");
-            }
-            else    // SCRAM engines enabled
-            {
-                for (int i = 0; i < 2; i++)
-                    IncThrusterLevel(th_scram[i], -microRate);
-            }
-
-            RESETKEY(kstate, OAPI_KEY_MINUS);
-        }
-
-        // allow if incap
-        if (KEYDOWN(kstate, OAPI_KEY_Z))  // decrement HUD brightness
-        { 
-            oapiDecHUDIntensity();
-            RESETKEY(kstate, OAPI_KEY_Z);
-        }
-
-        // allow if incap
-        if (KEYDOWN(kstate, OAPI_KEY_X))  // increment HUD brightness
-        { 
-            oapiIncHUDIntensity();
-            RESETKEY(kstate, OAPI_KEY_X);
-        }
-
-        // gimbal keys
-        // Note: gauge is PANEL_REDRAW_ALWAYS, so we don't need to send redraw messages for these
-        RESET_KEY_IF_INCAP(OAPI_KEY_SEMICOLON);
-        if (KEYDOWN(kstate, OAPI_KEY_SEMICOLON))  // gimbal all up
-        { 
-            GimbalSCRAMPitch(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::UP_OR_LEFT);
-            GimbalMainPitch(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::UP_OR_LEFT);
-            RESETKEY(kstate, OAPI_KEY_SEMICOLON);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_L);
-        if (KEYDOWN(kstate, OAPI_KEY_L))  // gimbal all right
-        { 
-            GimbalMainYaw(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::DOWN_OR_RIGHT);  // only main engines gimbal left/right
-            RESETKEY(kstate, OAPI_KEY_L);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_P);
-        if (KEYDOWN(kstate, OAPI_KEY_P))  // gimbal all down
-        { 
-            GimbalSCRAMPitch(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::DOWN_OR_RIGHT);
-            GimbalMainPitch(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::DOWN_OR_RIGHT);
-            RESETKEY(kstate, OAPI_KEY_P);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_APOSTROPHE);
-        if (KEYDOWN(kstate, OAPI_KEY_APOSTROPHE))  // gimbal all left
-        { 
-            GimbalMainYaw(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::UP_OR_LEFT);  // only main engines gimbal left/right
-            RESETKEY(kstate, OAPI_KEY_APOSTROPHE);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_0);
-        if (KEYDOWN(kstate, OAPI_KEY_0))  // gimbal recenter all
-        { 
-            GimbalRecenterAll();
-            RESETKEY(kstate, OAPI_KEY_0);
-        }
-    }
-
-    //---------------------------------
-
-    if (KEYMOD_CONTROL(kstate))
-    {
-        double delta = oapiGetSimStep() * ELEVATOR_TRIM_SPEED;
-        double trimLevel = GetControlSurfaceLevel(AIRCTRL_ELEVATORTRIM);
-
-        if (!AreElevatorsOperational())
-        {
-            // elevators offline; disable elevator movement keys
-            RESETKEY(kstate, OAPI_KEY_COMMA);
-            RESETKEY(kstate, OAPI_KEY_PERIOD);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_COMMA);
-        if (KEYDOWN(kstate, OAPI_KEY_COMMA))  // inc elevator trim
-        { 
-            if (CheckHydraulicPressure(true, true))   // show warning if no hydraulic pressure
-            {
-                SetControlSurfaceLevel(AIRCTRL_ELEVATORTRIM, trimLevel + delta);
-                MarkAPUActive();  // reset the APU idle warning callout time
-            }
-            RESETKEY(kstate, OAPI_KEY_COMMA);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_PERIOD);
-        if (KEYDOWN(kstate, OAPI_KEY_PERIOD))  // dec elevator trim
-        { 
-            if (CheckHydraulicPressure(true, true))   // show warning if no hydraulic pressure
-            {
-                SetControlSurfaceLevel(AIRCTRL_ELEVATORTRIM, trimLevel - delta);
-                MarkAPUActive();  // reset the APU idle warning callout time
-            }
-            RESETKEY(kstate, OAPI_KEY_PERIOD);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_EQUALS);
-        if (KEYDOWN(kstate, OAPI_KEY_EQUALS))  // increment scram thrust
-        { 
-            if (m_isScramEnabled == false)
-            {
-                PlaySound(ScramDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                ShowWarning(nullptr, DeltaGliderXR1::ST_None, "SCRAM Doors are closed.");
-            }
-            else    // SCRAM engines enabled
-            {
-                for (int i = 0; i < 2; i++)
-                {
-                    IncThrusterLevel(th_scram[i], oapiGetSimStep() * 0.3);
-                    scram_intensity[i] = GetThrusterLevel (th_scram[i]) * scram_max[i];
-                }
-            }
-            RESETKEY(kstate, OAPI_KEY_EQUALS);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_MINUS);
-        if (KEYDOWN(kstate, OAPI_KEY_MINUS))  // decrement scram thrust
-        { 
-            if (m_isScramEnabled == false)
-            {
-                PlaySound(ScramDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                ShowWarning(nullptr, DeltaGliderXR1::ST_None, "SCRAM Doors are closed.");
-            }
-            else    // SCRAM engines enabled
-            {
-                for (int i = 0; i < 2; i++)
-                {
-                    IncThrusterLevel(th_scram[i], oapiGetSimStep() * -0.3);
-                    scram_intensity[i] = GetThrusterLevel (th_scram[i]) * scram_max[i];
-                }
-            }
-            RESETKEY(kstate, OAPI_KEY_MINUS);
-        }
-
-    }
-
-    //---------------------------------
-
-    if (KEYMOD_SHIFT(kstate))
-    {
-        // rate is 3% throttle per second vs. normal rate of 30% (1/10th power)
-        const double microRate = oapiGetSimStep() * THROTTLE_MICRO_FRAC;
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_NUMPAD0);
-        if (KEYDOWN(kstate, OAPI_KEY_NUMPAD0))  // small inc hover thrust
-        { 
-            if (m_isHoverEnabled == false)
-            {
-                PlaySound(HoverDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                ShowWarning(nullptr, DeltaGliderXR1::ST_None, "Hover Doors are closed.");
-            }
-            else    // Hover engines enabled
-            {
-                for (int i = 0; i < 2; i++)
-                    IncThrusterLevel(th_hover[i], microRate);
-            }
-            RESETKEY(kstate, OAPI_KEY_NUMPAD0);
-        }
-
-        RESET_KEY_IF_INCAP(OAPI_KEY_DECIMAL);
-        if (KEYDOWN(kstate, OAPI_KEY_DECIMAL))  // small dec hover thrust
-        { 
-            if (m_isHoverEnabled == false)
-            {
-                PlaySound(HoverDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                ShowWarning(nullptr, DeltaGliderXR1::ST_None, "Hover Doors are closed.");
-            }
-            else    // Hover engines enabled
-            {
-                for (int i = 0; i < 2; i++)
-                    IncThrusterLevel(th_hover[i], -microRate);
-            }
-            RESETKEY (kstate, OAPI_KEY_DECIMAL);
-        }
-    }
+    // held ALT, CTRL, and SHIFT keys
+    keyBindings.DispatchDirectKeys(kstate, IsCrewIncapacitatedOrNoPilotOnBoard(), 
+        [this](const XR1KeyBinding &binding) { PerformDirectKeyAction(binding); });
 
     //---------------------------------
     // keys that work regardless of KEYMOD state
@@ -424,60 +137,149 @@ int DeltaGliderXR1::clbkConsumeDirectKey(char *kstate)
     return 0;
 }
 
-// --------------------------------------------------------------
-// Process buffered key events
-// --------------------------------------------------------------
-#define RET_IF_INCAP() if (IsCrewIncapacitatedOrNoPilotOnBoard()) return 1
-
-int DeltaGliderXR1::clbkConsumeBufferedKey (int key, bool down, char *kstate)
+// Perform a direct key action; invoked every frame while the key is held down
+void DeltaGliderXR1::PerformDirectKeyAction(const XR1KeyBinding &binding)
 {
-    // defines keycodes allowed during playback; currently we do not need to check for CTRL or ALT flags, so we don't
-    // bother to check for those at this time.
-    static const int s_keysAllowedDuringPlayback[] =
-    {
-        OAPI_KEY_T,
-        // numbers cover [0-9] for MDA as well as CTRL-[1-5] for secondary HUD mode selection
-        OAPI_KEY_0,         
-        OAPI_KEY_1,
-        OAPI_KEY_2,
-        OAPI_KEY_3,
-        OAPI_KEY_4,
-        OAPI_KEY_5,
-        OAPI_KEY_6,
-        OAPI_KEY_7,
-        OAPI_KEY_8,
-        OAPI_KEY_9,
-        OAPI_KEY_H,     // covers H (hud mode), CTRL-H (hud on/off), and ALT-H (hud color)
-        OAPI_KEY_W,     // CTRL-W (reset MWS)
-        OAPI_KEY_D      // covers D (next MDA mode) and ALT-D (previous MDA mode)
-    };
-    static const int s_numKeysAllowedDuringPlayback = (sizeof(s_keysAllowedDuringPlayback) / sizeof(int));
-
-    if (Playback()) 
+    // rate is 3% throttle per second vs. normal rate of 30% (1/10th power)
+    const double microRate = oapiGetSimStep() * THROTTLE_MICRO_FRAC;
+
+    switch (binding.action)
     {
-        // check if the key is allowed during playback
-        bool bKeyAllowed = false;
-        for (int i=0; i < s_numKeysAllowedDuringPlayback; i++)
+    // These two keys are for development testing to tweak some internal value.
+    case XR1KeyAction::TweakInternalValueDown:
+        TweakInternalValue(false);      // direction DOWN
+        break;
+
+    case XR1KeyAction::TweakInternalValueUp:
+        TweakInternalValue(true);      // direction UP
+        break;
+
+    // center-of-gravity shift keys
+    case XR1KeyAction::ShiftCOGAft:
+        // must shift center of lift *forward* to simulate a COG shift *aft*
+        if (VerifyManualCOGShiftAvailable())    // plays warning if necessary
+            ShiftCenterOfLift(oapiGetSimStep() * COL_MAX_SHIFT_RATE * COL_KEY_SHIFT_RATE_FRACTION);
+        break;
+
+    case XR1KeyAction::ShiftCOGForward:
+        // must shift center of lift *aft* to simulate a COG shift *forward*
+        if (VerifyManualCOGShiftAvailable())    // plays warning if necessary
+            ShiftCenterOfLift(-oapiGetSimStep() * COL_MAX_SHIFT_RATE * COL_KEY_SHIFT_RATE_FRACTION);
+        break;
+
+    case XR1KeyAction::RecenterCOG:
+        SetRecenterCenterOfGravityMode(true);
+        break;
+
+    case XR1KeyAction::ScramThrustInc:
+    case XR1KeyAction::ScramThrustDec:
+        if (m_isScramEnabled == false)
+        {
+            PlaySound(ScramDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
+            ShowWarning(nullptr, DeltaGliderXR1::ST_None, "SCRAM Doors are closed.");
+        }
+        else    // SCRAM engines enabled
         {
-            if (key == s_keysAllowedDuringPlayback[i])
+            const double delta = oapiGetSimStep() * ((binding.action == XR1KeyAction::ScramThrustInc) ? 0.3 : -0.3);
+            for (int i = 0; i < 2; i++)
             {
-                bKeyAllowed = true;
-                break;
+                IncThrusterLevel(th_scram[i], delta);
+                scram_intensity[i] = GetThrusterLevel(th_scram[i]) * scram_max[i];
             }
         }
+        break;
+
+    case XR1KeyAction::ScramThrustIncFine:
+    case XR1KeyAction::ScramThrustDecFine:
+        if (m_isScramEnabled == false)
+        {
+            PlaySound(ScramDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
+            ShowWarning(nullptr, DeltaGliderXR1::ST_None, "SCRAM Doors are closed.");
+        }
+        else    // SCRAM engines enabled
+        {
+            for (int i = 0; i < 2; i++)
+                IncThrusterLevel(th_scram[i], ((binding.action == XR1KeyAction::ScramThrustIncFine) ? microRate : -microRate));
+        }
+        break;
+
+    case XR1KeyAction::HoverThrustIncFine:
+    case XR1KeyAction::HoverThrustDecFine:
+        if (m_isHoverEnabled == false)
+        {
+            PlaySound(HoverDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
+            ShowWarning(nullptr, DeltaGliderXR1::ST_None, "Hover Doors are closed.");
+        }
+        else    // Hover engines enabled
+        {
+            for (int i = 0; i < 2; i++)
+                IncThrusterLevel(th_hover[i], ((binding.action == XR1KeyAction::HoverThrustIncFine) ? microRate : -microRate));
+        }
+        break;
+
+    case XR1KeyAction::HUDDimmer:
+        oapiDecHUDIntensity();
+        break;
+
+    case XR1KeyAction::HUDBrighter:
+        oapiIncHUDIntensity();
+        break;
+
+    // gimbal keys
+    // Note: gauge is PANEL_REDRAW_ALWAYS, so we don't need to send redraw messages for these
+    case XR1KeyAction::GimbalAllUp:
+        GimbalSCRAMPitch(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::UP_OR_LEFT);
+        GimbalMainPitch(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::UP_OR_LEFT);
+        break;
+
+    case XR1KeyAction::GimbalAllDown:
+        GimbalSCRAMPitch(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::DOWN_OR_RIGHT);
+        GimbalMainPitch(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::DOWN_OR_RIGHT);
+        break;
+
+    case XR1KeyAction::GimbalAllLeft:
+        GimbalMainYaw(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::UP_OR_LEFT);  // only main engines gimbal left/right
+        break;
+
+    case XR1KeyAction::GimbalAllRight:
+        GimbalMainYaw(DeltaGliderXR1::GIMBAL_SWITCH::BOTH, DeltaGliderXR1::DIRECTION::DOWN_OR_RIGHT);  // only main engines gimbal left/right
+        break;
+
+    case XR1KeyAction::GimbalRecenter:
+        GimbalRecenterAll();
+        break;
+
+    case XR1KeyAction::ElevatorTrimInc:
+    case XR1KeyAction::ElevatorTrimDec:
+        // the trim keys do nothing while the elevators are offline
+        if (AreElevatorsOperational() && CheckHydraulicPressure(true, true))   // show warning if no hydraulic pressure
+        {
+            const double delta = oapiGetSimStep() * ELEVATOR_TRIM_SPEED;
+            const double trimLevel = GetControlSurfaceLevel(AIRCTRL_ELEVATORTRIM);
+            SetControlSurfaceLevel(AIRCTRL_ELEVATORTRIM, trimLevel + ((binding.action == XR1KeyAction::ElevatorTrimInc) ? delta : -delta));
+            MarkAPUActive();  // reset the APU idle warning callout time
+        }
+        break;
 
-        if (!bKeyAllowed)
-            return 0; // don't allow manual user input during a playback
-        // else fall through and process the key normally
+    default:
+        break;
     }
+}
+
+// --------------------------------------------------------------
+// Process buffered key events
+// --------------------------------------------------------------
+int DeltaGliderXR1::clbkConsumeBufferedKey (int key, bool down, char *kstate)
+{
+    const XR1KeyBindings &keyBindings = GetXR1Config()->KeyBindings;
 
     if (!down) 
     {
         // key is up; check for our special cases here
         // NOTE: ALT may not be down here, so don't require it!
-        switch(key)
+        const XR1KeyBinding *pDataHUD = keyBindings.FindAction(XR1KeyAction::ShowDataHUD);
+        if ((pDataHUD != nullptr) && (key == pDataHUD->key) && (!Playback() || (pDataHUD->flags & KBF_ALLOW_IN_PLAYBACK)))
         {
-        case OAPI_KEY_SPACE:
             if (m_dataHUDActive)    // data HUD currently active?
             {
                 m_dataHUDActive = false;
@@ -490,591 +292,339 @@ int DeltaGliderXR1::clbkConsumeBufferedKey (int key, bool down, char *kstate)
         return 0; // ignore all other keyup events
     }
 
-    if (KEYMOD_SHIFT (kstate)) 
-    {
-        // SHIFT key down
-        // WARNING: ORBITER BUG: SHIFT-<ANY NUMPAD NUMBER KEY> DOES NOT COME THROUGH!  Key remains set to the SHIFT keycode, not the NUMPAD KEY CODE.
-
-        // special autopilot keys
-        if (m_airspeedHoldEngaged)
-        {
-            // OK to check for SHIFT NON-NUMBER keys here
-            switch (key)
-            {
-            case OAPI_KEY_ADD:
-                RET_IF_INCAP();
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_ADJUST, ASRATE_SMALL);
-                return 1;
+    const XR1KeyBinding *pBinding = keyBindings.FindBufferedKey(key, XR1KeyBindings::GetBufferedKeyMod(kstate), GetAutopilotKeyMask());
+    if (pBinding == nullptr)
+        return 0;
 
-            case OAPI_KEY_SUBTRACT:
-                RET_IF_INCAP();
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_ADJUST, -ASRATE_SMALL);
-                return 1;
-            }
-        }
+    if (Playback() && !(pBinding->flags & KBF_ALLOW_IN_PLAYBACK))
+        return 0; // don't allow manual user input during a playback
 
-        /*
-        switch (key)
-        {
-            // no entries yet; must be careful here to not step on MFD keystrokes!
-        }
-        */
-    } 
-    else if (KEYMOD_CONTROL(kstate)) 
-    {
-        // CTRL key down
-        // autopilot keys
-        if (m_customAutopilotMode == AUTOPILOT::AP_DESCENTHOLD)
-        {
-            const bool invert = GetXR1Config()->InvertDescentHoldRateArrows;
-            switch (key)
-            {
-            case OAPI_KEY_NUMPAD2:
-                RET_IF_INCAP();
-                if (invert) goto numpad8c_descent;
-numpad2c_descent:
-                SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_ADJUST, ADRATE_LARGE);
-                return 1;
+    // swallow the key if the crew is incapacitated
+    if (!(pBinding->flags & KBF_ALLOW_IF_INCAP) && IsCrewIncapacitatedOrNoPilotOnBoard())
+        return 1;
 
-            case OAPI_KEY_NUMPAD8:
-                RET_IF_INCAP();
-                if (invert) goto numpad2c_descent;
-numpad8c_descent:
-                SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_ADJUST, -ADRATE_LARGE);
-                return 1;
-            }
-        }
-        else if (m_customAutopilotMode == AUTOPILOT::AP_ATTITUDEHOLD)
-        {
-            switch (key)
-            {
-            case OAPI_KEY_NUMPAD3:   // reset bank to level
-                ResetAttitudeHoldToLevel(true, true, false);
-                return 1;
+    const int retVal = PerformBufferedKeyAction(*pBinding, kstate);
+    return ((pBinding->flags & KBF_PASS_TO_ORBITER) ? 0 : retVal);   // 0 = let Orbiter's default handler have the key
+}
 
-            case OAPI_KEY_NUMPAD7:   // reset pitch/aoa to level
-                ResetAttitudeHoldToLevel(true, false, true);
-                return 1;
+// Perform a buffered key action.
+// Returns: 1 if we handled the key, 0 to let Orbiter's default handler have it
+int DeltaGliderXR1::PerformBufferedKeyAction(const XR1KeyBinding &binding, char *kstate)
+{
+    const XR1ConfigFileParser &config = *GetXR1Config();
+    const int param = XR1KeyBindings::GetInvertedParam(binding, config.InvertAttitudeHoldPitchArrows, config.InvertDescentHoldRateArrows);
+    const int step = abs(param);    // for the XR1KeyStep actions
 
-            case OAPI_KEY_NUMPAD1:   // reset ship to level
-                ResetAttitudeHoldToLevel(true, true, true);
-                return 1;
-            }
-        }
-        
-        if (m_airspeedHoldEngaged)
-        {
-            switch (key)
-            {
-            case OAPI_KEY_ADD:
-                RET_IF_INCAP();
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_ADJUST, ASRATE_LARGE);
-                return 1;
+    switch (binding.action)
+    {
+    //
+    // custom autopilot keys
+    //
+    case XR1KeyAction::AirspeedHoldAdjust:
+    {
+        const double rate = ((step == KEYSTEP_TINY) ? ASRATE_TINY : (step == KEYSTEP_SMALL) ? ASRATE_SMALL : (step == KEYSTEP_MED) ? ASRATE_MED : ASRATE_LARGE);
+        SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_ADJUST, ((param > 0) ? rate : -rate));
+        return 1;
+    }
 
-            case OAPI_KEY_SUBTRACT:
-                RET_IF_INCAP();
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_ADJUST, -ASRATE_LARGE);
-                return 1;
-            }
-        }
+    case XR1KeyAction::AirspeedHoldCurrent:
+        SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_HOLDCURRENT, 0);
+        return 1;
 
-        // normal mode (no autopilot engaged)
-        switch (key) 
-        {
-            // swallow normal keys if crew incapacitated
-        case OAPI_KEY_DIVIDE:
-            RET_IF_INCAP();
-            return 0;       // let Orbiter default handler handle it
+    case XR1KeyAction::AirspeedHoldReset:
+        SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_RESET, 0);
+        return 1;
 
-        case OAPI_KEY_SLASH:
-            {
-            // WORKAROUND FOR JOY2KEY BUG: it sends numpad "/" as a normal "/", so handle it here.
-            RET_IF_INCAP();
-            int mode = GetAttitudeMode();
-            SetAttitudeMode(mode != 0 ? 0 : 1);  // toggle between off and rotation
-            return 1;
-            }
+    case XR1KeyAction::ToggleAirspeedHold:
+        ToggleAirspeedHold(true);   // hold current airspeed
+        return 1;
 
-        case OAPI_KEY_BACK:   // kill SCRAM thrust
-            RET_IF_INCAP(); 
-            for (int i = 0; i < 2; i++)
-            {
-                SetThrusterLevel(th_scram[i], 0);
-                scram_intensity[i] = 0;
-            }
+    case XR1KeyAction::DescentHoldAdjust:
+    {
+        const double rate = ((step == KEYSTEP_SMALL) ? ADRATE_SMALL : (step == KEYSTEP_MED) ? ADRATE_MED : ADRATE_LARGE);
+        SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_ADJUST, ((param > 0) ? rate : -rate));
+        return 1;
+    }
 
-            PlaySound(_KillThrust, DeltaGliderXR1::ST_Other);
-            RESETKEY(kstate, OAPI_KEY_BACK);
-            break;
-
-        case OAPI_KEY_D:
-            RET_IF_INCAP();
-            // use our custom undocking routine
-            PerformUndocking();
-            return 1;   // we handled this key
-
-        case OAPI_KEY_SPACE: // open control dialog
-            // allow if crew incapacitated here
-            //oapiOpenDialogEx (g_hDLL, IDD_CTRL, XR1Ctrl_DlgProc, DLG_CAPTIONCLOSE, this);
-            return 1;
-
-            //typedef INT_PTR(CALLBACK* DLGPROC)(HWND, UINT, WPARAM, LPARAM);
-
-        case OAPI_KEY_A:    // toggle APU on/off
-            RET_IF_INCAP();
-            ToggleAPU();
-            PlayDoorSound(apu_status);
-            return 1;
-
-        case OAPI_KEY_B:
-            RET_IF_INCAP();
-            ToggleAirbrake();
-            PlayDoorSound(brake_status);
-            return 1;
-
-        case OAPI_KEY_K:  // "operate nose cone" (docking port)
-            RET_IF_INCAP();
-            ToggleNoseCone();
-            PlayDoorSound(nose_status);
-            return 1;
-
-        case OAPI_KEY_O:  // "operate outer airlock"
-            RET_IF_INCAP();
-            ToggleOuterAirlock ();
-            PlayDoorSound(olock_status);
-            return 1;
-
-        case OAPI_KEY_Y:  // operate top hatch
-            RET_IF_INCAP();
-            ToggleHatch();
-            PlayDoorSound(hatch_status);
-            return 1;
-
-        case OAPI_KEY_H:  // toggle HUD on/off
-            // allow if incap
-            PlaySound(SwitchOn, DeltaGliderXR1::ST_Other);    // sound only
-            return 0;               // let Orbiter handle it
-
-        case OAPI_KEY_MULTIPLY:   // kill hover thrust
-            RET_IF_INCAP();
-            for (int i = 0; i < 2; i++)
-                SetThrusterLevel(th_hover[i], 0);
-
-            PlaySound(_KillThrust, DeltaGliderXR1::ST_Other);
-            return 1;
-
-        case OAPI_KEY_BACKSLASH:    // toggle retro doors
-            RET_IF_INCAP();
-            ToggleRCover();
-            PlayDoorSound(rcover_status);
-            return 1;
-
-        case OAPI_KEY_V:        // toggle hover doors
-            RET_IF_INCAP();
-            ToggleHoverDoors();
-            PlayDoorSound(hoverdoor_status);
-            return 1;
-
-        case OAPI_KEY_G:        // toggle scram doors
-            RET_IF_INCAP();
-            ToggleScramDoors();
-            PlayDoorSound(scramdoor_status);
-            return 1;
-
-        case OAPI_KEY_1:        // set secondary HUD mode
-        case OAPI_KEY_2:
-        case OAPI_KEY_3:
-        case OAPI_KEY_4:
-        case OAPI_KEY_5:
-            // allow if incap
-            EnableAndSetSecondaryHUDMode(key - OAPI_KEY_1 + 1);
-            
-            return 1;
-        
-        case OAPI_KEY_T:        // toggle tertiary HUD
-            // allow if incap
-            SetTertiaryHUDEnabled(!m_tertiaryHUDOn); 
-            return 1;
-
-        case OAPI_KEY_W:   // Reset MWS 
-            RET_IF_INCAP();
-            ResetMWS();
-            return 1;
-
-        case OAPI_KEY_SUBTRACT:   // check for retro thrust here
-            {
-                RET_IF_INCAP();
-                // If current throttle level == 0 for BOTH main engines, check the retro doors
-                double mainThrottleLevel = GetThrusterLevel(th_main[0]) + GetThrusterLevel(th_main[1]);
-                if ((mainThrottleLevel == 0) && (m_isRetroEnabled == false))
-                {
-                    PlaySound(RetroDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                    ShowWarning(nullptr, DeltaGliderXR1::ST_None, "Retro Doors are closed.");
-                    return 1;   // swallow this keypress
-                }
-                return 0;       // let the key be processed by Orbiter's default handler
-            }
+    case XR1KeyAction::DescentHoldAutoLand:
+        SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_AUTOLAND, 0);
+        return 1;
 
-        case OAPI_KEY_L:  // engage ATTITUDE HOLD and sync to current attitude
-            RET_IF_INCAP(); 
-            SyncAttitudeHold(true, true); // play sound here and force PITCH mode
+    case XR1KeyAction::DescentHoldLevel:
+        SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_LEVEL, 0);
+        return 1;
 
-            // if autopilot not already engaged, turn it on
-            if (m_customAutopilotMode != AUTOPILOT::AP_ATTITUDEHOLD)
-                ToggleAttitudeHold();  // use 'toggle' here because we don't have an explicit 'ActivateAttitudeHold' method
+    // NOTE: this replaces the standard Orbiter "Hover Hold Alt" autopilot key
+    case XR1KeyAction::ToggleDescentHold:
+        ToggleDescentHold();
+        return 1;
 
-            return 1;
-        } 
-    } 
-    else if (KEYMOD_ALT(kstate)) 
+    case XR1KeyAction::AttitudeHoldPitch:
     {
-        // ALT key down
+        const double delta = ((step == KEYSTEP_SMALL) ? AP_PITCH_DELTA_SMALL : AP_PITCH_DELTA_LARGE);
+        if (param > 0)
+            IncrementAttitudeHoldPitch(true, true, delta);
+        else
+            DecrementAttitudeHoldPitch(true, true, delta);
+        return 1;
+    }
 
-        // special autopilot keys
-        if (m_customAutopilotMode == AUTOPILOT::AP_DESCENTHOLD)
-        {
-            const bool invert = GetXR1Config()->InvertDescentHoldRateArrows;
-            switch (key)
-            {
-            case OAPI_KEY_NUMPAD2:
-                RET_IF_INCAP();
-                if (invert) goto numpad8_descent;
-numpad2_descent:
-                SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_ADJUST, ADRATE_SMALL);
-                return 1;
+    case XR1KeyAction::AttitudeHoldBank:
+        if (param > 0)
+            IncrementAttitudeHoldBank(true, true);
+        else
+            DecrementAttitudeHoldBank(true, true);
+        return 1;
 
-            case OAPI_KEY_NUMPAD8:
-                RET_IF_INCAP();
-                if (invert) goto numpad2_descent;
-numpad8_descent:
-                SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_ADJUST, -ADRATE_SMALL);
-                return 1;
-            }
-        }
-        else if (m_customAutopilotMode == AUTOPILOT::AP_ATTITUDEHOLD)
-        {
-            const bool invert = GetXR1Config()->InvertAttitudeHoldPitchArrows;
-            switch (key)
-            {
-            case OAPI_KEY_NUMPAD2:
-                RET_IF_INCAP(); 
-                if (invert) goto numpad8;
-numpad2:
-                IncrementAttitudeHoldPitch(true, true, AP_PITCH_DELTA_SMALL);
-                return 1;
+    case XR1KeyAction::AttitudeHoldToggleAOAPitch:
+        ToggleAOAPitchAttitudeHold(true);
+        return 1;
 
-            case OAPI_KEY_NUMPAD8:
-                RET_IF_INCAP(); 
-                if (invert) goto numpad2;
-numpad8:
-                DecrementAttitudeHoldPitch(true, true, AP_PITCH_DELTA_SMALL);
-                return 1;
-            }
-        }
+    case XR1KeyAction::AttitudeHoldLevelBank:   // reset bank to level
+        ResetAttitudeHoldToLevel(true, true, false);
+        return 1;
 
-        if (m_airspeedHoldEngaged)
-        {
-            switch (key)
-            {
-            case OAPI_KEY_ADD:
-                RET_IF_INCAP();
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_ADJUST, ASRATE_TINY);
-                return 1;
+    case XR1KeyAction::AttitudeHoldLevelPitch:   // reset pitch/aoa to level
+        ResetAttitudeHoldToLevel(true, false, true);
+        return 1;
 
-            case OAPI_KEY_SUBTRACT:
-                RET_IF_INCAP();
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_ADJUST, -ASRATE_TINY);
-                return 1;
-            }
-        }
+    case XR1KeyAction::AttitudeHoldLevelBoth:   // reset ship to level
+        ResetAttitudeHoldToLevel(true, true, true);
+        return 1;
 
-        // normal mode
-        switch (key) 
-        {
-        case OAPI_KEY_R:  // "operate radiator"
-            RET_IF_INCAP();
-            ToggleRadiator();
-            PlayDoorSound(radiator_status);
-            return 1;
-
-        case OAPI_KEY_T:        // toggle secondary HUD on/off
-            // allow if incap
-            if (m_secondaryHUDMode != 0)    // is HUD on?
-                DisableSecondaryHUD();  // turn it off
-            else    // HUD is off; turn it on
-                EnableAndSetSecondaryHUDMode(m_lastSecondaryHUDMode);  // use the last active mode
-
-            PlaySound(SwitchOn, DeltaGliderXR1::ST_Other, QUIET_CLICK);
-            TriggerRedrawArea(AID_SECONDARY_HUD_BUTTONS);
-            return 1;
-
-            // NOTE: ALT-H will change HUD color; Orbiter core handles this; however, we want to play a sound
-        case OAPI_KEY_H:    // Change HUD color
-            // allow if incap
-            // NOTE: by design, ALT-H is processed by the Orbiter core *before* any vessel-specific code,
-            // so it is impossible for a vessel to capture ALT-H anyway; i.e., the Orbiter core *always* 
-            // executes oapiToggleHUDColour() when ALT-H is invoked, even before our hook here is called.
-            // Therefore, we do not want to invoke oapiToggleHUDColour() here and return 1, like we might expect.
-            // We instead simply play a beep for the oapiToggleHUDColour() that the Orbiter core already invoked.
-            // ORG CODE: oapiToggleHUDColour();
-            PlaySound(BeepHigh, ST_Other);
-            // ORG CODE: return 1;   // we handled this
-            return 0;  // The core already handled this key, so returning 1 or 0 here makes no difference.
+    // NOTE: this replaces the standard Orbiter "Level Horizon" autopilot key
+    case XR1KeyAction::ToggleAttitudeHold:
+        ToggleAttitudeHold();
+        return 1;
 
-        case OAPI_KEY_D:   // Previous MDA mode
-            // allow if incap
-            if (!m_pMDA)  // MDA not rendered?
-                PlayErrorBeep();
-            else
-            {
-                m_pMDA->SwitchActiveMode(MultiDisplayArea::DIRECTION::DOWN);
-                PlaySound(BeepLow, ST_Other);
-            }
-            return 1;
+    case XR1KeyAction::SyncAttitudeHold:  // engage ATTITUDE HOLD and sync to current attitude
+        SyncAttitudeHold(true, true); // play sound here and force PITCH mode
 
-        case OAPI_KEY_SLASH:
-            {
-                RET_IF_INCAP();
-                // make / on main keyboard act the same as numeric keypad /
-                int mode = GetADCtrlMode();
-                SetADCtrlMode(mode != 0 ? 0 : 7);  // toggle between off and on for all surfaces
-                return 1;
-            }
+        // if autopilot not already engaged, turn it on
+        if (m_customAutopilotMode != AUTOPILOT::AP_ATTITUDEHOLD)
+            ToggleAttitudeHold();  // use 'toggle' here because we don't have an explicit 'ActivateAttitudeHold' method
+        return 1;
 
-        case OAPI_KEY_MULTIPLY:   // kill scram thrust
-            RET_IF_INCAP();
-            for (int i = 0; i < 2; i++)
-            {
-                SetThrusterLevel(th_scram[i], 0);
-                scram_intensity[i] = 0;
-            }
+    case XR1KeyAction::KillAllAutopilots:
+        KillAllAutopilots();    // sound will play automatically
+        return 1;
 
-            PlaySound(_KillThrust, DeltaGliderXR1::ST_Other);
-            return 1;
-
-        case OAPI_KEY_SPACE:    // show data HUD
-            // allow if incap
-            m_dataHUDActive = true;
-            PlaySound(SwitchOn, DeltaGliderXR1::ST_Other, MED_CLICK);  // medium click for both on and off
-            TriggerRedrawArea(AID_DATA_HUD_BUTTON);
-            return 1;
-
-        case OAPI_KEY_S:  // toggle AIRSPEED HOLD autopilot
-            RET_IF_INCAP(); 
-            ToggleAirspeedHold(true);   // hold current airspeed
-            return 1;
-
-        case OAPI_KEY_O:    // toggle INNER AIRLOCK DOOR
-            RET_IF_INCAP();
-            ToggleInnerAirlock();
-            return 1;
-        }
+    //
+    // RCS and AF Ctrl modes
+    //
+    case XR1KeyAction::ToggleRCSRotation:
+    {
+        const int mode = GetAttitudeMode();
+        SetAttitudeMode(mode != 0 ? 0 : 1);  // toggle between off and rotation
+        return 1;
     }
-    else   // normal key (not SHIFT, CTRL, or ALT)
-    {    
-        //
-        // Handle custom autopilot mode-specific keys
-        //
-        if (m_customAutopilotMode == AUTOPILOT::AP_ATTITUDEHOLD)
-        {
-            const bool invert = GetXR1Config()->InvertAttitudeHoldPitchArrows;
-            switch (key)
-            {
-            case OAPI_KEY_NUMPAD2:
-                RET_IF_INCAP(); 
-                if (invert) goto numpad8n;
-numpad2n:
-                IncrementAttitudeHoldPitch(true, true, AP_PITCH_DELTA_LARGE);
-                return 1;
-
-            case OAPI_KEY_NUMPAD8:
-                RET_IF_INCAP(); 
-                if (invert) goto numpad2n;
-numpad8n:
-                DecrementAttitudeHoldPitch(true, true, AP_PITCH_DELTA_LARGE);
-                return 1;
 
-            case OAPI_KEY_NUMPAD4:
-                RET_IF_INCAP(); 
-                IncrementAttitudeHoldBank(true, true);
-                return 1;
+    case XR1KeyAction::ToggleRCSMode:
+        ToggleAttitudeMode();
+        return 1;
 
-            case OAPI_KEY_NUMPAD6:
-                RET_IF_INCAP(); 
-                DecrementAttitudeHoldBank(true, true);
-                return 1;
+    case XR1KeyAction::ToggleAFCtrl:
+    {
+        // make / on main keyboard act the same as numeric keypad /
+        const int mode = GetADCtrlMode();
+        SetADCtrlMode(mode != 0 ? 0 : 7);  // toggle between off and on for all surfaces
+        return 1;
+    }
 
-            case OAPI_KEY_NUMPAD9:
-                RET_IF_INCAP(); 
-                ToggleAOAPitchAttitudeHold(true);
-                return 1;
-            }
-        }
-        else if (m_customAutopilotMode == AUTOPILOT::AP_DESCENTHOLD)
-        {
-            const bool invert = GetXR1Config()->InvertDescentHoldRateArrows;
-            switch(key)
-            {
-            case OAPI_KEY_NUMPAD2:
-                RET_IF_INCAP(); 
-                if (invert) goto numpad8n_descent;
-numpad2n_descent:
-                SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_ADJUST, ADRATE_MED);
-                return 1;
+    //
+    // engines
+    //
+    case XR1KeyAction::KillMainThrustSound:   // Orbiter kills the main thrust
+        PlaySound(_KillThrust, DeltaGliderXR1::ST_Other);
+        return 0;
 
-            case OAPI_KEY_NUMPAD8:
-                RET_IF_INCAP(); 
-                if (invert) goto numpad2n_descent;
-numpad8n_descent:
-                SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_ADJUST, -ADRATE_MED);
-                return 1;
+    case XR1KeyAction::KillHoverThrust:
+        for (int i = 0; i < 2; i++)
+            SetThrusterLevel(th_hover[i], 0);
 
-            case OAPI_KEY_NUMPAD0:
-                RET_IF_INCAP(); 
-                SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_AUTOLAND, 0);
-                return 1;
+        PlaySound(_KillThrust, DeltaGliderXR1::ST_Other);
+        return 1;
 
-            case OAPI_KEY_DECIMAL:
-                RET_IF_INCAP(); 
-                SetAutoDescentRate(true, AUTODESCENT_ADJUST::AD_LEVEL, 0);
-                return 1;
-            }
+    case XR1KeyAction::KillScramThrust:
+        for (int i = 0; i < 2; i++)
+        {
+            SetThrusterLevel(th_scram[i], 0);
+            scram_intensity[i] = 0;
         }
 
-        if (m_airspeedHoldEngaged)
-        {
-            switch(key)
-            {
-            case OAPI_KEY_ADD:
-                RET_IF_INCAP(); 
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_ADJUST, ASRATE_MED);
-                return 1;
+        PlaySound(_KillThrust, DeltaGliderXR1::ST_Other);
+        if (binding.flags & KBF_PASS_TO_ORBITER)
+            RESETKEY(kstate, binding.key);  // Orbiter gets the keypress but not the held key
+        return 1;
 
-            case OAPI_KEY_SUBTRACT:
-                RET_IF_INCAP(); 
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_ADJUST, -ASRATE_MED);
-                return 1;
-            
-            case OAPI_KEY_NUMPADENTER:
-                RET_IF_INCAP(); 
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_HOLDCURRENT, 0);
-                return 1;
+    case XR1KeyAction::CheckRetroDoors:   // check for retro thrust here
+        if (m_isRetroEnabled == false)
+        {
+            PlaySound(RetroDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
+            ShowWarning(nullptr, DeltaGliderXR1::ST_None, "Retro Doors are closed.");
+            return 1;   // swallow this keypress
+        }
+        return 0;       // let the key be processed by Orbiter's default handler
 
-            case OAPI_KEY_MULTIPLY:
-                RET_IF_INCAP(); 
-                SetAirspeedHold(true, AIRSPEEDHOLD_ADJUST::AS_RESET, 0);
-                return 1;
-            }
+    case XR1KeyAction::CheckRetroDoorsIfMainIdle:
+    {
+        // If current throttle level == 0 for BOTH main engines, check the retro doors
+        const double mainThrottleLevel = GetThrusterLevel(th_main[0]) + GetThrusterLevel(th_main[1]);
+        if ((mainThrottleLevel == 0) && (m_isRetroEnabled == false))
+        {
+            PlaySound(RetroDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
+            ShowWarning(nullptr, DeltaGliderXR1::ST_None, "Retro Doors are closed.");
+            return 1;   // swallow this keypress
         }
+        return 0;       // let the key be processed by Orbiter's default handler
+    }
 
-        // 
-        // Perform normal key checks here
-        //
-        switch (key) 
+    //
+    // doors and systems
+    //
+    case XR1KeyAction::Undock:
+        // use our custom undocking routine
+        PerformUndocking();
+        return 1;   // we handled this key
+
+    case XR1KeyAction::ToggleAPU:
+        ToggleAPU();
+        PlayDoorSound(apu_status);
+        return 1;
+
+    case XR1KeyAction::ToggleAirbrake:
+        ToggleAirbrake();
+        PlayDoorSound(brake_status);
+        return 1;
+
+    case XR1KeyAction::ToggleNoseCone:  // "operate nose cone" (docking port)
+        ToggleNoseCone();
+        PlayDoorSound(nose_status);
+        return 1;
+
+    case XR1KeyAction::ToggleOuterAirlock:
+        ToggleOuterAirlock();
+        PlayDoorSound(olock_status);
+        return 1;
+
+    case XR1KeyAction::ToggleInnerAirlock:
+        ToggleInnerAirlock();
+        return 1;
+
+    case XR1KeyAction::ToggleTopHatch:
+        ToggleHatch();
+        PlayDoorSound(hatch_status);
+        return 1;
+
+    case XR1KeyAction::ToggleRadiator:
+        ToggleRadiator();
+        PlayDoorSound(radiator_status);
+        return 1;
+
+    case XR1KeyAction::ToggleRetroDoors:
+        ToggleRCover();
+        PlayDoorSound(rcover_status);
+        return 1;
+
+    case XR1KeyAction::ToggleHoverDoors:
+        ToggleHoverDoors();
+        PlayDoorSound(hoverdoor_status);
+        return 1;
+
+    case XR1KeyAction::ToggleScramDoors:
+        ToggleScramDoors();
+        PlayDoorSound(scramdoor_status);
+        return 1;
+
+    case XR1KeyAction::ToggleLandingGear:
+        ToggleLandingGear();
+        // do not play sound here; we have voice for this
+        return 1;
+
+    case XR1KeyAction::ResetMWS:
+        ResetMWS();
+        return 1;
+
+    //
+    // HUDs and MDA
+    //
+    case XR1KeyAction::HUDPowerSound:  // Orbiter toggles the HUD on/off
+        PlaySound(SwitchOn, DeltaGliderXR1::ST_Other);    // sound only
+        return 0;
+
+    case XR1KeyAction::HUDModeSound:  // Orbiter switches the HUD mode
+        PlaySound(SwitchOn, DeltaGliderXR1::ST_Other, MED_CLICK);
+        return 0;
+
+    case XR1KeyAction::HUDColorSound:
+        // NOTE: by design, ALT-H is processed by the Orbiter core *before* any vessel-specific code,
+        // so it is impossible for a vessel to capture ALT-H anyway; i.e., the Orbiter core *always* 
+        // executes oapiToggleHUDColour() when ALT-H is invoked, even before our hook here is called.
+        // Therefore, we do not want to invoke oapiToggleHUDColour() here and return 1, like we might expect.
+        // We instead simply play a beep for the oapiToggleHUDColour() that the Orbiter core already invoked.
+        PlaySound(BeepHigh, ST_Other);
+        return 0;  // The core already handled this key, so returning 1 or 0 here makes no difference.
+
+    case XR1KeyAction::SecondaryHUDMode:
+        EnableAndSetSecondaryHUDMode(binding.param);
+        return 1;
+
+    case XR1KeyAction::ToggleSecondaryHUD:
+        if (m_secondaryHUDMode != 0)    // is HUD on?
+            DisableSecondaryHUD();  // turn it off
+        else    // HUD is off; turn it on
+            EnableAndSetSecondaryHUDMode(m_lastSecondaryHUDMode);  // use the last active mode
+
+        PlaySound(SwitchOn, DeltaGliderXR1::ST_Other, QUIET_CLICK);
+        TriggerRedrawArea(AID_SECONDARY_HUD_BUTTONS);
+        return 1;
+
+    case XR1KeyAction::ToggleTertiaryHUD:
+        SetTertiaryHUDEnabled(!m_tertiaryHUDOn); 
+        return 1;
+
+    case XR1KeyAction::ShowDataHUD:   // hidden again when the key is released
+        m_dataHUDActive = true;
+        PlaySound(SwitchOn, DeltaGliderXR1::ST_Other, MED_CLICK);  // medium click for both on and off
+        TriggerRedrawArea(AID_DATA_HUD_BUTTON);
+        return 1;
+
+    case XR1KeyAction::MDAMode:
+        if (!m_pMDA)  // MDA not rendered?
+            PlayErrorBeep();
+        else
         {
-            // swallow normal keys if crew incapacitated
-        case OAPI_KEY_DIVIDE:
-            RET_IF_INCAP();
-            return 0;       // let Orbiter default handler handle it
-
-        // NOTE: this replaces the standard Orbiter "Level Horizon" autopilot key
-        case OAPI_KEY_L:  // toggle ATTITUDE HOLD autopilot
-            RET_IF_INCAP(); 
-            ToggleAttitudeHold();
-            return 1;
-
-        // NOTE: this replaces the standard Orbiter "Hover Hold Alt" autopilot key
-        case OAPI_KEY_A:  // toggle DESCENT HOLD autopilot
-            RET_IF_INCAP(); 
-            ToggleDescentHold();
-            return 1;
-
-        case OAPI_KEY_LBRACKET:
-        case OAPI_KEY_RBRACKET:
-        case OAPI_KEY_SEMICOLON:
-        case OAPI_KEY_APOSTROPHE:
-        case OAPI_KEY_NUMPAD5:   // killrot
-            // swallow this key
-            RET_IF_INCAP();    
-            return 0;       // let Orbiter's default handler handle it
-
-        case OAPI_KEY_0:
-        case OAPI_KEY_1:
-        case OAPI_KEY_2:
-        case OAPI_KEY_3:
-        case OAPI_KEY_4:
-        case OAPI_KEY_5:
-        case OAPI_KEY_6:
-        case OAPI_KEY_7:
-        case OAPI_KEY_8:
-        case OAPI_KEY_9:
-            // allow if incap
-            if (!m_pMDA)  // MDA not rendered?
-                PlayErrorBeep();
-            else
+            const int modeNumber = binding.param;
+            if (m_pMDA->SetActiveMode(modeNumber) == false)
             {
-                int modeNumber = ((key == OAPI_KEY_0) ? 0 : (key-1));
-                if (m_pMDA->SetActiveMode(modeNumber) == false)
-                {
-                    char temp[64];
-                    sprintf(temp, "No such display mode: %d", modeNumber);
-                    PlayErrorBeep();
-                    ShowWarning(nullptr, DeltaGliderXR1::ST_None, temp);
-                }
-                else
-                    PlaySound(BeepHigh, ST_Other);
-            }
-            return 1;
-
-        case OAPI_KEY_D:
-            // allow if incap
-            if (!m_pMDA)  // MDA not rendered?
+                char temp[64];
+                sprintf(temp, "No such display mode: %d", modeNumber);
                 PlayErrorBeep();
+                ShowWarning(nullptr, DeltaGliderXR1::ST_None, temp);
+            }
             else
-            {
-                m_pMDA->SwitchActiveMode(MultiDisplayArea::DIRECTION::UP);
                 PlaySound(BeepHigh, ST_Other);
-            }
-            return 1;
-
-        case OAPI_KEY_H:  // switch HUD mode
-            // allow if incap
-            PlaySound(SwitchOn, DeltaGliderXR1::ST_Other, MED_CLICK);
-            return 0;               // let Orbiter handle it
-
-        case OAPI_KEY_SLASH:
-            RET_IF_INCAP();
-            // WORKAROUND FOR JOY2KEY BUG: it sends numpad "/" as a normal "/", so handle it here.
-            ToggleAttitudeMode();
-            return 1;
-
-        case OAPI_KEY_MULTIPLY:   // kill main thrust
-            RET_IF_INCAP();
-            PlaySound(_KillThrust, DeltaGliderXR1::ST_Other);
-            return 0;   // let Orbiter default handler have the key
-        
-        case OAPI_KEY_SUBTRACT:
-            RET_IF_INCAP();
-            if (m_isRetroEnabled == false)
-            {
-                PlaySound(RetroDoorsAreClosed, DeltaGliderXR1::ST_WarningCallout);
-                ShowWarning(nullptr, DeltaGliderXR1::ST_None, "Retro Doors are closed.");
-                return 1;   // swallow this keypress
-            }
-            return 0;       // let the key be processed by Orbiter's default handler
-
-        case OAPI_KEY_G:  // "operate landing gear"
-            RET_IF_INCAP();
-            ToggleLandingGear();
-            // do not play sound here; we have voice for this
-            return 1;
-
-        case OAPI_KEY_SPACE:  // disable autopilots
-            RET_IF_INCAP();
-            KillAllAutopilots();    // sound will play automatically
-            return 1;
-        }       // end of normal switch statement
+        }
+        return 1;
+
+    case XR1KeyAction::NextMDAMode:
+    case XR1KeyAction::PreviousMDAMode:
+        if (!m_pMDA)  // MDA not rendered?
+            PlayErrorBeep();
+        else if (binding.action == XR1KeyAction::NextMDAMode)
+        {
+            m_pMDA->SwitchActiveMode(MultiDisplayArea::DIRECTION::UP);
+            PlaySound(BeepHigh, ST_Other);
+        }
+        else
+        {
+            m_pMDA->SwitchActiveMode(MultiDisplayArea::DIRECTION::DOWN);
+            PlaySound(BeepLow, ST_Other);
+        }
+        return 1;
+
+    case XR1KeyAction::None:
+    default:
+        return 1;   // swallow the key; the caller passes it on to Orbiter if the binding says to
     }
-    return 0;
 }
-
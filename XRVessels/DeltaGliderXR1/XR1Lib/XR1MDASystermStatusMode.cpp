@@ -78,7 +78,7 @@ bool SystemsStatusMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE s
         if (damageItem > D_END)
             break;  // no more items
 
-        DamageStatus damageStatus = GetXR1().GetDamageStatus(damageItem);
+        const DamageStatus &damageStatus = GetXR1().GetDamageStatus(damageItem);
 
         double integrity = damageStatus.fracIntegrity;
 
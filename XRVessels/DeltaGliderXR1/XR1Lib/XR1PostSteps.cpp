@@ -235,6 +235,46 @@ void ShowWarningPostStep::clbkPrePostStep(const double simt, const double simdt,
 
 //---------------------------------------------------------------------------
 
+CalloutQueuePostStep::CalloutQueuePostStep(DeltaGliderXR1 &vessel) :
+    XR1PrePostStep(vessel)
+{
+}
+
+void CalloutQueuePostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
+{
+    DeltaGliderXR1 &xr1 = GetXR1();
+    bool isActivePlaying = ((xr1.m_activeCalloutSound != DeltaGliderXR1::NO_SOUND) && xr1.IsPlaying(xr1.m_activeCalloutSound));
+
+    // warnings are played by ShowWarningPostStep and take precedence over all queued callouts except crash sounds
+    const bool isWarningPlaying = xr1.IsPlaying(xr1.Warning);
+    const XRCalloutQueue::Callout *pActive = xr1.m_calloutQueue.GetActive();
+    if (isWarningPlaying && isActivePlaying && ((pActive == nullptr) || (pActive->priority < XRCalloutPriority::Crash)))
+    {
+        xr1.StopSound(xr1.m_activeCalloutSound);
+        isActivePlaying = false;
+    }
+
+    bool preemptActive;
+    const XRCalloutQueue::Callout *pCallout = xr1.m_calloutQueue.Update(simt, isActivePlaying, isWarningPlaying, preemptActive);
+    if (pCallout == nullptr)
+        return;     // nothing to play yet
+
+    if (preemptActive)
+        xr1.StopSound(xr1.m_activeCalloutSound);
+
+    // callouts loaded on demand all play on the Info channel
+    DeltaGliderXR1::Sound sound = static_cast<DeltaGliderXR1::Sound>(pCallout->soundID);
+    if (*pCallout->filename != 0)
+    {
+        sound = xr1.Info;
+        xr1.LoadXR1Sound(sound, pCallout->filename, XRSound::PlaybackType::Radio);  // audible outside vessel as well
+    }
+    xr1.PlaySound(sound, static_cast<DeltaGliderXR1::SoundType>(pCallout->soundType));
+    xr1.m_activeCalloutSound = sound;
+}
+
+//---------------------------------------------------------------------------
+
 // compute descent or ascent slope
 SetSlopePostStep::SetSlopePostStep(DeltaGliderXR1 &vessel) : 
     XR1PrePostStep(vessel), m_lastUpdateTime(0), m_lastUpdateAltitude(0),
@@ -573,7 +613,7 @@ void UpdateCoolantTempPostStep::clbkPrePostStep(const double simt, const double
             double failureTimeFrac = dt / 20.0;
             double failureProbability = failureTimeFrac * exceededLimitMult;
 
-            if (oapiRand() <= failureProbability)
+            if (GetXR1().XRRand() <= failureProbability)
             {
                 GetXR1().m_internalSystemsFailure = true;   // systems offline
                 GetXR1().m_MWSActive = true;
@@ -32,6 +32,10 @@
 #include "DeltaGliderXR1.h"
 #include "XR1PrePostStep.h"
 #include "RollingArray.h"
+#include "XRTelemetryRing.h"
+#include "XRFlightDataRecorder.h"
+#include "XR1ThermalNodes.h"
+#include "XR1HeatingMeshState.h"
 
 //---------------------------------------------------------------------------
 
@@ -50,6 +54,16 @@ protected:
 
 //---------------------------------------------------------------------------
 
+// plays queued voice callouts one at a time; see DeltaGliderXR1::EnqueueCallout
+class CalloutQueuePostStep : public XR1PrePostStep
+{
+public:
+    CalloutQueuePostStep(DeltaGliderXR1 &vessel);
+    virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+};
+
+//---------------------------------------------------------------------------
+
 class ComputeAccPostStep : public XR1PrePostStep
 {
 public:
@@ -70,8 +84,15 @@ public:
     SetHullTempsPostStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
 
+    // which leading-edge heating profile a thermal node follows
+    typedef XR1ThermalNodes::HeatSource HeatSource;
+
 protected:
-    void RemoveSurfaceHeat(const double simdt, double &temp);
+    // Subclasses may call this from their constructor to add extra heated surfaces; returns the new node's index.
+    int AddThermalNode(double &vesselTemp, const HeatSource source, const double heatScale, const double coolingRate = 0.02, const double minCooling = 0.1)
+    {
+        return m_thermalNodes.Add(vesselTemp, source, heatScale, coolingRate, minCooling);
+    }
 
     virtual void AddHeat(const double simdt);
     virtual void RemoveHeat(const double simdt);
@@ -79,6 +100,9 @@ protected:
     virtual int GetHeatingMeshGroupIndex() { return 0; }  // typical heating mesh will only have one group anyway
 
     bool m_forceTempUpdate;
+    XR1ThermalNodes m_thermalNodes;   // hull surfaces; temperatures are gathered from the vessel before AddHeat and written back after RemoveHeat
+    DEVMESHHANDLE m_lastHeatingMesh;    // mesh that m_heatingMeshState applies to; a new visual invalidates it
+    XR1HeatingMeshState m_heatingMeshState;
 };
 
 //---------------------------------------------------------------------------
@@ -218,6 +242,62 @@ protected:
     int m_target2DPanel;        // panel ID
 };
 
+//---------------------------------------------------------------------------
+
+// Publishes one XRTelemetryRecord per frame to a shared memory ring buffer for out-of-process readers.
+// Only added if 'TelemetryExportEnabled' is set in the config file.
+class TelemetryExportPostStep : public XR1PrePostStep
+{
+public:
+    TelemetryExportPostStep(DeltaGliderXR1 &vessel);
+    virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+
+protected:
+    void BuildRecord(const double mjd, XRTelemetryRecord &recordOut);
+
+    XRTelemetryRingWriter m_ringWriter;
+    XRTelemetrySnapshot m_snapshot;
+    bool m_openFailed;          // true = shm_open/mmap failed; do not retry every frame
+};
+
+//---------------------------------------------------------------------------
+
+// While Orbiter's flight recorder is running, records XR-specific state that Orbiter does not (hull temperatures, consumables,
+// autopilot modes, and damage) to a binary flight data file at a fixed rate.  Only added if 'FlightDataRecorderEnabled' is set in the config file.
+class FlightDataRecorderPostStep : public XR1PrePostStep
+{
+public:
+    FlightDataRecorderPostStep(DeltaGliderXR1 &vessel);
+    virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+
+protected:
+    void BuildFrame(const double simt, XRFlightDataFrame &frameOut);
+
+    XRFlightDataRecorder m_recorder;
+    XRTelemetrySnapshot m_snapshot;
+    double m_nextSampleSimt;    // simt of the next frame to record
+    bool m_openFailed;          // true = could not create the file; do not retry until the next recording starts
+};
+
+// During Orbiter playback, applies the state saved by FlightDataRecorderPostStep.  Only added if 'FlightDataRecorderEnabled' is set in the config file.
+class FlightDataPlaybackPostStep : public XR1PrePostStep
+{
+public:
+    FlightDataPlaybackPostStep(DeltaGliderXR1 &vessel);
+    virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+
+protected:
+    void ApplyFrame(const XRFlightDataFrame &frame, const uint64_t changeMask);
+
+    XRFlightDataReader m_reader;
+    XRFlightDataFrame m_currentFrame;   // most recent frame at or before simt
+    XRFlightDataFrame m_nextFrame;      // first frame after simt
+    bool m_haveCurrentFrame;
+    bool m_haveNextFrame;
+    uint64_t m_nextChangeMask;          // fields in m_nextFrame that differ from the frame before it
+    bool m_openFailed;                  // true = no flight data file for this playback; do not retry every frame
+};
+
 //---------------------------------------------------------------------------
 #ifdef _DEBUG
 class TestXRVesselCtrlPostStep : public XR1PrePostStep
@@ -0,0 +1,269 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1PostStepsFlightData.cpp
+// Binary flight data recording and playback of XR-specific state.
+// ==============================================================
+
+#include "XR1PostSteps.h"
+
+// Orbiter's flight recorder folder, relative to the Orbiter root folder.  Each recording has its own subfolder, and we save
+// our flight data file there next to Orbiter's own files for the vessel.
+#define ORBITER_FLIGHTS_FOLDER "Flights"
+
+// XRSystemStatusWrite fields for XRFlightDataField::DamageIntegrityFirst ... DamageIntegrityLast, in order
+static double XRSystemStatusWrite::* const s_damageIntegrityFields[] =
+{
+    &XRSystemStatusWrite::LeftWing, &XRSystemStatusWrite::RightWing,
+    &XRSystemStatusWrite::LeftMainEngine, &XRSystemStatusWrite::RightMainEngine,
+    &XRSystemStatusWrite::LeftSCRAMEngine, &XRSystemStatusWrite::RightSCRAMEngine,
+    &XRSystemStatusWrite::ForeHoverEngine, &XRSystemStatusWrite::AftHoverEngine,
+    &XRSystemStatusWrite::LeftRetroEngine, &XRSystemStatusWrite::RightRetroEngine,
+    &XRSystemStatusWrite::ForwardLowerRCS, &XRSystemStatusWrite::AftUpperRCS,
+    &XRSystemStatusWrite::ForwardUpperRCS, &XRSystemStatusWrite::AftLowerRCS,
+    &XRSystemStatusWrite::ForwardStarboardRCS, &XRSystemStatusWrite::AftPortRCS,
+    &XRSystemStatusWrite::ForwardPortRCS, &XRSystemStatusWrite::AftStarboardRCS,
+    &XRSystemStatusWrite::OutboardUpperPortRCS, &XRSystemStatusWrite::OutboardLowerStarboardRCS,
+    &XRSystemStatusWrite::OutboardUpperStarboardRCS, &XRSystemStatusWrite::OutboardLowerPortRCS,
+    &XRSystemStatusWrite::AftRCS, &XRSystemStatusWrite::ForwardRCS
+};
+static_assert((sizeof(s_damageIntegrityFields) / sizeof(s_damageIntegrityFields[0])) ==
+    (static_cast<int>(XRFlightDataField::DamageIntegrityLast) - static_cast<int>(XRFlightDataField::DamageIntegrityFirst) + 1), "damage integrity field count mismatch");
+
+// XRSystemStatusWrite fields packed two bits apiece into XRFlightDataField::DamageStateMask, in order
+static XRDamageState XRSystemStatusWrite::* const s_damageStateFields[] =
+{
+    &XRSystemStatusWrite::LeftAileron, &XRSystemStatusWrite::RightAileron, &XRSystemStatusWrite::LandingGear,
+    &XRSystemStatusWrite::DockingPort, &XRSystemStatusWrite::RetroDoors, &XRSystemStatusWrite::TopHatch,
+    &XRSystemStatusWrite::Radiator, &XRSystemStatusWrite::Speedbrake, &XRSystemStatusWrite::PayloadBayDoors,
+    &XRSystemStatusWrite::CrewElevator
+};
+
+static const uint64_t DAMAGE_FIELDS_MASK = (((1ull << (static_cast<int>(XRFlightDataField::DamageIntegrityLast) + 1)) - 1) & ~((1ull << static_cast<int>(XRFlightDataField::DamageIntegrityFirst)) - 1)) |
+    (1ull << static_cast<int>(XRFlightDataField::DamageStateMask));
+
+//---------------------------------------------------------------------------
+
+FlightDataRecorderPostStep::FlightDataRecorderPostStep(DeltaGliderXR1 &vessel) :
+    XR1PrePostStep(vessel),
+    m_nextSampleSimt(0), m_openFailed(false)
+{
+}
+
+void FlightDataRecorderPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
+{
+    char msg[512];
+    if (!GetVessel().Recording())
+    {
+        if (m_recorder.IsOpen())
+        {
+            m_recorder.Close();
+            if (m_recorder.GetDroppedCount() > 0)
+            {
+                sprintf(msg, "WARNING: flight data recorder dropped %llu frame(s) because the disk could not keep up", static_cast<unsigned long long>(m_recorder.GetDroppedCount()));
+                GetXR1().GetXR1Config()->WriteLog(msg);
+            }
+        }
+        m_openFailed = false;   // try again when the next recording starts
+        return;
+    }
+
+    const double sampleInterval = GetXR1().GetXR1Config()->FlightDataRecorderInterval;
+    if (!m_recorder.IsOpen())
+    {
+        if (m_openFailed)
+            return;
+
+        // Orbiter has already created this recording's .pos file for our vessel by the time Recording() returns true
+        const string recordingName = XRFlightDataRecorder::FindOrbiterRecordingName(ORBITER_FLIGHTS_FOLDER, GetVessel().GetName());
+        if (recordingName.empty())
+        {
+            m_openFailed = true;
+            sprintf(msg, "WARNING: could not find Orbiter's flight recording folder for vessel '%s'; XR flight data will not be recorded", GetVessel().GetName());
+            GetXR1().GetXR1Config()->WriteLog(msg);
+            return;
+        }
+
+        const string filename = XRFlightDataRecorder::GetFlightDataFilename(ORBITER_FLIGHTS_FOLDER, recordingName.c_str(), GetVessel().GetName());
+        if (!m_recorder.Open(filename.c_str(), GetVessel().GetName(), sampleInterval))
+        {
+            m_openFailed = true;
+            sprintf(msg, "WARNING: could not create flight data file '%s'; XR flight data will not be recorded", filename.c_str());
+            GetXR1().GetXR1Config()->WriteLog(msg);
+            return;
+        }
+
+        // Tell playback which recording holds our flight data: the event is saved in Orbiter's own event stream for this recording.
+        GetVessel().RecordEvent("XRFLIGHTDATA", recordingName.c_str());
+        m_nextSampleSimt = simt;
+    }
+
+    if (simt < m_nextSampleSimt)
+        return;
+
+    // stay on the fixed sample grid unless we fell more than one interval behind
+    m_nextSampleSimt += sampleInterval;
+    if (m_nextSampleSimt <= simt)
+        m_nextSampleSimt = simt + sampleInterval;
+
+    XRFlightDataFrame frame;
+    BuildFrame(simt, frame);
+    m_recorder.Record(frame);     // never blocks; dropped frames are logged when the recording ends
+}
+
+// Populate a frame from the shared per-frame XRVesselCtrl snapshot
+void FlightDataRecorderPostStep::BuildFrame(const double simt, XRFlightDataFrame &frameOut)
+{
+    GetXR1().GetXRTelemetrySnapshot(m_snapshot);
+    const XRSystemStatusRead &status = m_snapshot.Status;
+
+    frameOut.SetDouble(XRFlightDataField::SimTime, simt);
+
+    frameOut.SetDouble(XRFlightDataField::NoseconeTemp, status.NoseconeTemp);
+    frameOut.SetDouble(XRFlightDataField::LeftWingTemp, status.LeftWingTemp);
+    frameOut.SetDouble(XRFlightDataField::RightWingTemp, status.RightWingTemp);
+    frameOut.SetDouble(XRFlightDataField::CockpitTemp, status.CockpitTemp);
+    frameOut.SetDouble(XRFlightDataField::TopHullTemp, status.TopHullTemp);
+    frameOut.SetDouble(XRFlightDataField::CoolantTemp, status.CoolantTemp);
+    frameOut.SetDouble(XRFlightDataField::CabinO2Level, status.CabinO2Level);
+
+    const int mainIndex = static_cast<int>(XREngineID::XRE_MainLeft);
+    const int scramIndex = static_cast<int>(XREngineID::XRE_ScramLeft);
+    frameOut.SetDouble(XRFlightDataField::MainFuelLevel, (m_snapshot.EngineSupported[mainIndex] ? m_snapshot.Engines[mainIndex].FuelLevel : -1));
+    frameOut.SetDouble(XRFlightDataField::SCRAMFuelLevel, (m_snapshot.EngineSupported[scramIndex] ? m_snapshot.Engines[scramIndex].FuelLevel : -1));
+    frameOut.SetDouble(XRFlightDataField::RCSFuelLevel, status.RCSFuelLevel);
+    frameOut.SetDouble(XRFlightDataField::APUFuelLevel, status.APUFuelLevel);
+    frameOut.SetDouble(XRFlightDataField::LOXLevel, status.LOXLevel);
+
+    int64_t stdAutopilotMask = 0;
+    for (int i = 0; i < XRTELEMETRY_STDAP_COUNT; i++)
+    {
+        if (m_snapshot.StandardAP[i] == XRAutopilotState::XRAPSTATE_Engaged)
+            stdAutopilotMask |= (1ll << i);
+    }
+    frameOut.SetInt(XRFlightDataField::StdAutopilotMask, stdAutopilotMask);
+    frameOut.SetInt(XRFlightDataField::AttitudeHoldOn, m_snapshot.AttitudeHold.on);
+    frameOut.SetInt(XRFlightDataField::AttitudeHoldMode, static_cast<int64_t>(m_snapshot.AttitudeHold.mode));
+    frameOut.SetDouble(XRFlightDataField::AttitudeHoldTargetPitch, m_snapshot.AttitudeHold.TargetPitch);
+    frameOut.SetDouble(XRFlightDataField::AttitudeHoldTargetBank, m_snapshot.AttitudeHold.TargetBank);
+    frameOut.SetInt(XRFlightDataField::DescentHoldOn, m_snapshot.DescentHold.on);
+    frameOut.SetDouble(XRFlightDataField::DescentHoldTargetRate, m_snapshot.DescentHold.TargetDescentRate);
+    frameOut.SetInt(XRFlightDataField::DescentHoldAutoLand, m_snapshot.DescentHold.AutoLandMode);
+    frameOut.SetInt(XRFlightDataField::AirspeedHoldOn, m_snapshot.AirspeedHold.on);
+    frameOut.SetDouble(XRFlightDataField::AirspeedHoldTarget, m_snapshot.AirspeedHold.TargetAirspeed);
+
+    const int firstIntegrityField = static_cast<int>(XRFlightDataField::DamageIntegrityFirst);
+    for (int i = 0; i < static_cast<int>(sizeof(s_damageIntegrityFields) / sizeof(s_damageIntegrityFields[0])); i++)
+        frameOut.SetDouble(static_cast<XRFlightDataField>(firstIntegrityField + i), status.*s_damageIntegrityFields[i]);
+
+    int64_t damageStateMask = 0;
+    for (int i = 0; i < static_cast<int>(sizeof(s_damageStateFields) / sizeof(s_damageStateFields[0])); i++)
+        damageStateMask |= (static_cast<int64_t>(status.*s_damageStateFields[i]) << (i * 2));
+    frameOut.SetInt(XRFlightDataField::DamageStateMask, damageStateMask);
+
+    frameOut.SetInt(XRFlightDataField::InternalSystemsFailure, status.InternalSystemsFailure);
+    frameOut.SetInt(XRFlightDataField::MasterWarning, (status.MasterWarning == XRWarningState::XRW_warningActive) ? 1 : 0);
+}
+
+//---------------------------------------------------------------------------
+
+FlightDataPlaybackPostStep::FlightDataPlaybackPostStep(DeltaGliderXR1 &vessel) :
+    XR1PrePostStep(vessel),
+    m_haveCurrentFrame(false), m_haveNextFrame(false), m_nextChangeMask(0), m_openFailed(false)
+{
+}
+
+void FlightDataPlaybackPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
+{
+    if (!GetVessel().Playback())
+        return;
+
+    // set by the XRFLIGHTDATA playback event at the start of the recording; recordings made without flight data never have one
+    const char *pRecordingName = GetXR1().m_flightDataRecordingName;
+    if (*pRecordingName == 0)
+        return;
+
+    if (!m_reader.IsOpen())
+    {
+        if (m_openFailed)
+            return;
+
+        const string filename = XRFlightDataRecorder::GetFlightDataFilename(ORBITER_FLIGHTS_FOLDER, pRecordingName, GetVessel().GetName());
+        if (!m_reader.Open(filename.c_str()))
+        {
+            m_openFailed = true;
+            char msg[512];
+            sprintf(msg, "Could not read XR flight data file '%s' for this playback; XR systems will not be replayed", filename.c_str());
+            GetXR1().GetXR1Config()->WriteLog(msg);
+            return;
+        }
+        m_haveNextFrame = (m_reader.ReadNext(m_nextFrame) == XRFlightDataReader::ReadResult::Frame);
+        m_nextChangeMask = m_reader.GetChangeMask();
+    }
+
+    // advance to the last recorded frame at or before simt, merging the change masks of any frames we pass over
+    uint64_t changeMask = 0;
+    while (m_haveNextFrame && (m_nextFrame.GetDouble(XRFlightDataField::SimTime) <= simt))
+    {
+        m_currentFrame = m_nextFrame;
+        m_haveCurrentFrame = true;
+        changeMask |= m_nextChangeMask;
+
+        m_haveNextFrame = (m_reader.ReadNext(m_nextFrame) == XRFlightDataReader::ReadResult::Frame);
+        m_nextChangeMask = m_reader.GetChangeMask();
+    }
+
+    if (m_haveCurrentFrame)
+        ApplyFrame(m_currentFrame, changeMask);
+}
+
+// Apply a recorded frame to the vessel.  The temperatures and consumables are set every timestep since our other
+// post steps update them as well; damage is only reapplied when it changes.  Autopilot modes and engine fuel are not
+// applied: Orbiter's own playback already reproduces the recorded attitude and thrust.
+void FlightDataPlaybackPostStep::ApplyFrame(const XRFlightDataFrame &frame, const uint64_t changeMask)
+{
+    DeltaGliderXR1 &xr1 = GetXR1();
+
+    xr1.m_noseconeTemp = frame.GetDouble(XRFlightDataField::NoseconeTemp);
+    xr1.m_leftWingTemp = frame.GetDouble(XRFlightDataField::LeftWingTemp);
+    xr1.m_rightWingTemp = frame.GetDouble(XRFlightDataField::RightWingTemp);
+    xr1.m_cockpitTemp = frame.GetDouble(XRFlightDataField::CockpitTemp);
+    xr1.m_topHullTemp = frame.GetDouble(XRFlightDataField::TopHullTemp);
+    xr1.m_coolantTemp = frame.GetDouble(XRFlightDataField::CoolantTemp);
+    xr1.m_cabinO2Level = frame.GetDouble(XRFlightDataField::CabinO2Level);
+    xr1.m_apuFuelQty = frame.GetDouble(XRFlightDataField::APUFuelLevel) * APU_FUEL_CAPACITY;
+    xr1.m_internalSystemsFailure = (frame.GetInt(XRFlightDataField::InternalSystemsFailure) != 0);
+
+    if (changeMask & DAMAGE_FIELDS_MASK)
+    {
+        XRSystemStatusWrite status;
+        const int firstIntegrityField = static_cast<int>(XRFlightDataField::DamageIntegrityFirst);
+        for (int i = 0; i < static_cast<int>(sizeof(s_damageIntegrityFields) / sizeof(s_damageIntegrityFields[0])); i++)
+            status.*s_damageIntegrityFields[i] = frame.GetDouble(static_cast<XRFlightDataField>(firstIntegrityField + i));
+
+        const int64_t damageStateMask = frame.GetInt(XRFlightDataField::DamageStateMask);
+        for (int i = 0; i < static_cast<int>(sizeof(s_damageStateFields) / sizeof(s_damageStateFields[0])); i++)
+            status.*s_damageStateFields[i] = static_cast<XRDamageState>((damageStateMask >> (i * 2)) & 3);
+
+        xr1.SetXRSystemStatus(status);
+    }
+}
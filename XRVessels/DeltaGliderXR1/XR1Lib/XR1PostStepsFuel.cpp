@@ -328,9 +328,9 @@ bool FuelDumpPostStep::DumpFuel(const PROPELLANT_HANDLE ph, const double simdt,
     double remaining = GetXR1().GetXRPropellantMass(ph);
     if (remaining > 0)
     {
-        // add oapiRand to fuel dump rate so that kg mass goes down by a random fraction
+        // add a random value to fuel dump rate so that kg mass goes down by a random fraction
         // (looks better on the lower panel's mass display)
-        remaining -= ((FUEL_DUMP_RATE + oapiRand()) * simdt * rateFraction);
+        remaining -= ((FUEL_DUMP_RATE + GetXR1().XRRand()) * simdt * rateFraction);
         if (remaining < 0)    // underflow?
             remaining = 0;
 
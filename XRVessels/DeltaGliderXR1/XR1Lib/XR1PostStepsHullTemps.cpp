@@ -28,14 +28,25 @@
 
 SetHullTempsPostStep::SetHullTempsPostStep(DeltaGliderXR1& vessel) :
     XR1PrePostStep(vessel),
-    m_forceTempUpdate(true) // force update on first frame through to init hull temps
+    m_forceTempUpdate(true), // force update on first frame through to init hull temps
+    m_lastHeatingMesh(nullptr)
 {
+    // standard hull surfaces common to all XR vessels
+    AddThermalNode(GetXR1().m_noseconeTemp, HeatSource::Nosecone, 1.0);
+    AddThermalNode(GetXR1().m_leftWingTemp, HeatSource::LeftWing, 0.75);    // nose gets 25% hotter than wings
+    AddThermalNode(GetXR1().m_rightWingTemp, HeatSource::RightWing, 0.75);
+    AddThermalNode(GetXR1().m_cockpitTemp, HeatSource::Cockpit, 0.73);     // nose gets 27% hotter than cockpit (max)
+    AddThermalNode(GetXR1().m_topHullTemp, HeatSource::Cockpit, 0.73 * 0.80);  // top hull gets 80% of the heat that the cockpit does
 }
 
 void SetHullTempsPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
 {
+    // gather the current surface temperatures: other code (e.g., scenario load, damage reset) may have changed them
+    m_thermalNodes.Gather();
     AddHeat(simdt);
     RemoveHeat(simdt);
+    m_thermalNodes.Scatter();
+
     UpdateHullHeatingMesh(simdt);
 }
 
@@ -195,35 +206,14 @@ void SetHullTempsPostStep::AddHeat(const double simdt)
             if (cockpitHeatFrac > 1.20)
                 cockpitHeatFrac = 1.20;
 
-            // NOSECONE
-            // NOTE: this variable is reused for each surface
-            double newTemp = extTemp + (noseconeHeatFrac * degreesK);
-
-            // Don't ever LOWER the nosecone temp in the "add heat" phase here
-            if (newTemp > GetXR1().m_noseconeTemp)
-                GetXR1().m_noseconeTemp = newTemp;
-
-            // LEFT WING
-            newTemp = extTemp + ((leftWingHeatFrac * degreesK) * 0.75);  // nose gets 25% hotter than wings
-            if (newTemp > GetXR1().m_leftWingTemp)
-                GetXR1().m_leftWingTemp = newTemp;
-
-            // RIGHT WING
-            newTemp = extTemp + ((rightWingHeatFrac * degreesK) * 0.75);
-            if (newTemp > GetXR1().m_rightWingTemp)
-                GetXR1().m_rightWingTemp = newTemp;
+            // now update every surface in one pass
+            double sourceHeatFrac[static_cast<int>(HeatSource::Count)];
+            sourceHeatFrac[static_cast<int>(HeatSource::Nosecone)] = noseconeHeatFrac;
+            sourceHeatFrac[static_cast<int>(HeatSource::LeftWing)] = leftWingHeatFrac;
+            sourceHeatFrac[static_cast<int>(HeatSource::RightWing)] = rightWingHeatFrac;
+            sourceHeatFrac[static_cast<int>(HeatSource::Cockpit)] = cockpitHeatFrac;
 
-            // COCKPIT
-            double cockpitDeltaTemp = (cockpitHeatFrac * degreesK) * .73;  // nose gets 27% hotter than cockpit (max)
-            newTemp = extTemp + cockpitDeltaTemp;
-            if (newTemp > GetXR1().m_cockpitTemp)
-                GetXR1().m_cockpitTemp = newTemp;
-
-            // TOP HULL
-            // top hull gets 80% of the heat that the cockpit does
-            newTemp = extTemp + (cockpitDeltaTemp * 0.80);
-            if (newTemp > GetXR1().m_topHullTemp)
-                GetXR1().m_topHullTemp = newTemp;
+            m_thermalNodes.AddHeat(sourceHeatFrac, extTemp, degreesK);
         }
     }
     m_forceTempUpdate = false;      // reset
@@ -231,64 +221,39 @@ void SetHullTempsPostStep::AddHeat(const double simdt)
 
 void SetHullTempsPostStep::RemoveHeat(const double simdt)
 {
-    // heat dissipation rates are the same for each surface
-    RemoveSurfaceHeat(simdt, GetXR1().m_noseconeTemp);
-    RemoveSurfaceHeat(simdt, GetXR1().m_leftWingTemp);
-    RemoveSurfaceHeat(simdt, GetXR1().m_rightWingTemp);
-    RemoveSurfaceHeat(simdt, GetXR1().m_cockpitTemp);
-    RemoveSurfaceHeat(simdt, GetXR1().m_topHullTemp);
-}
-
-// remove heat from a single surface
-// temp = temperature of surface
-void SetHullTempsPostStep::RemoveSurfaceHeat(const double simdt, double& temp)
-{
-    const double extTemp = GetXR1().GetExternalTemperature();
-    const double delta = fabs(temp - extTemp);
-
-    // Each surface drops 2% or .1 degree of its heat ABOVE AMBIENT per second, whichever is greater
-    double heatDropped = max((delta * .02), 0.1) * simdt;  // amount of heat dropped in this fraction of a second
-
-    double newTemp = temp - heatDropped;
-    if (newTemp > extTemp)
-        temp = newTemp;
-    else
-        temp = extTemp;   // external temps reached ambient
+    m_thermalNodes.RemoveHeat(GetXR1().GetExternalTemperature(), simdt);
 }
 
 // update the transparency of the hull heating mesh, if any
 void SetHullTempsPostStep::UpdateHullHeatingMesh(const double simdt)
 {
     if (!GetXR1().heatingmesh)
-        return;     // no hull heating mesh
+    {
+        // No hull heating mesh (e.g., the visual was destroyed): forget the cached state.  The next visual's mesh may be
+        // allocated at the same address as the old one, so comparing handles alone would not detect it as a new mesh.
+        m_lastHeatingMesh = nullptr;
+        m_heatingMeshState.Reset();
+        return;
+    }
 
     // DEBUG: heating mesh testing: GetXR1().m_noseconeTemp = GetXR1().m_tweakedInternalValue;
 
-    // We check temperature of the nosecone only; set the limits at which the mesh becomes barely visible
-    // to where it is at its maximum opacity (maxHeatingAlpha).
-    const double minVisibilityTemp = GetXR1().m_hullTemperatureLimits.noseCone * 0.387;  // coincides with Orbiter visual plasma
-    const double maxVisibilityTemp = GetXR1().m_hullTemperatureLimits.noseCone * 0.80;
+    // a new visual means a new mesh instance with default (hidden) state, so everything must be applied again
+    const bool bMeshChanged = (GetXR1().heatingmesh != m_lastHeatingMesh);
+    m_lastHeatingMesh = GetXR1().heatingmesh;
+    m_heatingMeshState.Update(bMeshChanged, GetXR1().m_noseconeTemp, GetXR1().m_hullTemperatureLimits.noseCone);
 
-    // Orbiter core bug: we should only modulate alpha when the heating mesh should
-    // actually be *visible* because the Orbiter core applies the alpha setting to *all*
-    // transparent meshes in the sim, including the Sun!  This makes the sun disappear.
-    const bool bHeatingMeshVisible = (GetXR1().m_noseconeTemp >= minVisibilityTemp);
-    GetXR1().SetMeshGroupVisible(GetXR1().heatingmesh, GetHeatingMeshGroupIndex(), bHeatingMeshVisible);  // show or hide the group
-    oapiSetMeshProperty(GetXR1().heatingmesh, MESHPROPERTY_MODULATEMATALPHA, (int)bHeatingMeshVisible); // use material alpha w/texture alpha
+    if (m_heatingMeshState.IsVisibilityUpdateDue())
+    {
+        const bool bHeatingMeshVisible = m_heatingMeshState.IsVisible();
+        GetXR1().SetMeshGroupVisible(GetXR1().heatingmesh, GetHeatingMeshGroupIndex(), bHeatingMeshVisible);  // show or hide the group
+        oapiSetMeshProperty(GetXR1().heatingmesh, MESHPROPERTY_MODULATEMATALPHA, (int)bHeatingMeshVisible); // use material alpha w/texture alpha
+    }
 
-    if (bHeatingMeshVisible)
+    if (m_heatingMeshState.IsMaterialUpdateDue())
     {
         // hull heat is visible!  Update the alpha for the material.
-        // get the fraction between minVisiblityTemp (0 and maxVisibilityTemp (1.0)
-        double alphaFrac = ((GetXR1().m_noseconeTemp - minVisibilityTemp) / (maxVisibilityTemp - minVisibilityTemp));
-        if (alphaFrac > 1.0)
-            alphaFrac = 1.0;    // keep in range
-
-        // now get the alpha to be applied
-        // min heating alpha is 0.0
-        // BETA-1 ORG: const double maxHeatingAlpha = 0.475;
-        const double maxHeatingAlpha = 1.0;  // new heating mesh is 4-bit alpha
-        const float heatingMeshAlpha = static_cast<float>(alphaFrac * maxHeatingAlpha);
+        const float heatingMeshAlpha = m_heatingMeshState.GetAlpha();
 
         // read the original material from the *global* mesh and clone it, since we cannot read material from the active ship's mesh in Orbiter_ng
         const MATERIAL* pSrcHeatingMaterial = oapiMeshMaterial(GetXR1().heatingmesh_tpl, GetHeatingMeshGroupIndex());
@@ -306,8 +271,4 @@ void SetHullTempsPostStep::UpdateHullHeatingMesh(const double simdt)
 
         // DEBUG: sprintf(oapiDebugString(), "NoseconeTemp: %.3lf heatingMeshAlpha=%f", GetXR1().m_noseconeTemp, heatingMeshAlpha);
     }
-    else
-    {
-        // DEBUG: sprintf(oapiDebugString(), "NoseconeTemp: %.3lf : Heating mesh invisible", GetXR1().m_noseconeTemp);
-    }
 }
@@ -32,22 +32,64 @@ ResupplyPostStep::ResupplyPostStep(DeltaGliderXR1& vessel) :
     m_prevResupplyEnabledStatus(false), m_prevFuelHatchStatus(DoorStatus::DOOR_CLOSED), m_prevLoxHatchStatus(DoorStatus::DOOR_CLOSED), m_prevExternalCoolingStatus(DoorStatus::DOOR_CLOSED),
     m_refuelingSequenceStartSimt(-1), m_loxSequenceStartSimt(-1), m_externalCoolingSequenceStartSimt(-1),
     m_resupplyStartupTime(5.0), // time in seconds
-    m_prevSimt(-1), m_resupplyMovementFirstDetectedSimt(-1)
+    m_prevSimt(-1), m_resupplyMovementFirstDetectedSimt(-1),
+    m_bayLinkResistance(1e-9),  // effectively none, so bay tanks fill at the line's rate once the ship tank is full
+    m_xfeedLinkResistance(0)
 {
-    // create our pressure objects; each line has a slightly different pressure rate
-    m_pMainLinePressure = new LinePressure(GetXR1().m_mainExtLinePressure, GetXR1().m_nominalMainExtLinePressure, GetXR1().m_mainSupplyLineStatus, GetXR1().m_mainFuelFlowSwitch, MAIN_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 1.14, GetXR1());
-    m_pScramLinePressure = new LinePressure(GetXR1().m_scramExtLinePressure, GetXR1().m_nominalScramExtLinePressure, GetXR1().m_scramSupplyLineStatus, GetXR1().m_scramFuelFlowSwitch, SCRAM_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 1.0, GetXR1());
-    m_pApuLinePressure = new LinePressure(GetXR1().m_apuExtLinePressure, GetXR1().m_nominalApuExtLinePressure, GetXR1().m_apuSupplyLineStatus, GetXR1().m_apuFuelFlowSwitch, APU_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 0.92, GetXR1());
-    m_pLoxLinePressure = new LinePressure(GetXR1().m_loxExtLinePressure, GetXR1().m_nominalLoxExtLinePressure, GetXR1().m_loxSupplyLineStatus, GetXR1().m_loxFlowSwitch, LOX_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 0.86, GetXR1());
+    // Create our line descriptors; each line has a slightly different pressure rate.
+    // Main, SCRAM, and APU flow at a fixed rate; LOX flows at a fraction of its tank capacity, but no slower than LOX_MIN_FLOW_RATE.
+    m_lines[TANK_MAIN] =
+    {
+        new LinePressure(GetXR1().m_mainExtLinePressure, GetXR1().m_nominalMainExtLinePressure, GetXR1().m_mainSupplyLineStatus, GetXR1().m_mainFuelFlowSwitch, MAIN_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 1.14, GetXR1()),
+        &DeltaGliderXR1::m_mainFuelFlowSwitch, false, FUEL_LOAD_RATE, 0,   // main tank loads with no load fraction (i.e., effectively 1.0)
+        AID_MAINSUPPLYLINE_SWITCH, AID_MAINSUPPLYLINE_SWITCH_LED, "Main Fuel Tanks Full.wav", "Main fuel tanks already full."
+    };
+
+    m_lines[TANK_SCRAM] =
+    {
+        new LinePressure(GetXR1().m_scramExtLinePressure, GetXR1().m_nominalScramExtLinePressure, GetXR1().m_scramSupplyLineStatus, GetXR1().m_scramFuelFlowSwitch, SCRAM_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 1.0, GetXR1()),
+        &DeltaGliderXR1::m_scramFuelFlowSwitch, false, FUEL_LOAD_RATE * SCRAM_FLOW_FRACTION, 0,
+        AID_SCRAMSUPPLYLINE_SWITCH, AID_SCRAMSUPPLYLINE_SWITCH_LED, "Scram Fuel Tanks Full.wav", "SCRAM fuel tanks already full."
+    };
+
+    m_lines[TANK_APU] =
+    {
+        new LinePressure(GetXR1().m_apuExtLinePressure, GetXR1().m_nominalApuExtLinePressure, GetXR1().m_apuSupplyLineStatus, GetXR1().m_apuFuelFlowSwitch, APU_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 0.92, GetXR1()),
+        &DeltaGliderXR1::m_apuFuelFlowSwitch, false, FUEL_LOAD_RATE * APU_FLOW_FRACTION, 0,
+        AID_APUSUPPLYLINE_SWITCH, AID_APUSUPPLYLINE_SWITCH_LED, "APU Fuel Tanks Full.wav", "APU fuel tanks already full."
+    };
+
+    m_lines[TANK_LOX] =
+    {
+        new LinePressure(GetXR1().m_loxExtLinePressure, GetXR1().m_nominalLoxExtLinePressure, GetXR1().m_loxSupplyLineStatus, GetXR1().m_loxFlowSwitch, LOX_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 0.86, GetXR1()),
+        &DeltaGliderXR1::m_loxFlowSwitch, true, LOX_MIN_FLOW_RATE, LOX_LOAD_FRAC,
+        AID_LOXSUPPLYLINE_SWITCH, AID_LOXSUPPLYLINE_SWITCH_LED, "LOX Tanks Full.wav", "LOX fuel tanks already full."
+    };
+
+    // Build the flow network; capacities are updated each timestep.  The ship tanks must be added first so that
+    // each is the node with its TANK_ index.
+    for (int tank = 0; tank < RESUPPLY_LINE_COUNT; tank++)
+    {
+        m_network.AddTank(0);
+        m_network.AddLine(tank, 1.0);   // resistance is set from the line's nominal pressure each timestep
+    }
+
+    for (int tank = 0; tank < RESUPPLY_LINE_COUNT; tank++)
+    {
+        const bool hasBayTank = (tank != TANK_APU);     // the APU has no bay tanks
+        m_bayTank[tank] = (hasBayTank ? m_network.AddTank(0) : -1);
+        m_bayLink[tank] = (hasBayTank ? m_network.AddLink(tank, m_bayTank[tank], m_bayLinkResistance) : -1);
+    }
+
+    m_rcsTank = m_network.AddTank(0);
+    m_xfeedLink = m_network.AddLink(TANK_MAIN, m_rcsTank, 1.0);
 }
 
 ResupplyPostStep::~ResupplyPostStep()
 {
     // clean up
-    delete m_pMainLinePressure;
-    delete m_pScramLinePressure;
-    delete m_pApuLinePressure;
-    delete m_pLoxLinePressure;
+    for (ResupplyLine &line : m_lines)
+        delete line.pLinePressure;
 }
 
 void ResupplyPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
@@ -94,6 +136,8 @@ void ResupplyPostStep::clbkPrePostStep(const double simt, const double simdt, co
     }
     // end workaround ========================================================================
 
+    bool fuelLinesOnline = false;
+    bool loxLinesOnline = false;
     if (resupplyEnabled)
     {
         //
@@ -120,43 +164,18 @@ void ResupplyPostStep::clbkPrePostStep(const double simt, const double simdt, co
                     GetXR1().PlaySound(GetXR1().FuelResupplyLine, DeltaGliderXR1::ST_Other);   // use max volume for this
                     GetXR1().ShowInfo("Refueling Systems Online.wav", DeltaGliderXR1::ST_InformationCallout, "External fuel line attached;&refueling systems ONLINE.");
 
-                    // determine which fuel lines should have pressure
-                    const XR1ConfigFileParser& config = *GetXR1().GetXR1Config();
-                    const bool isDocked = GetXR1().IsDocked();
-                    const bool onEarth = GetXR1().IsLandedOnEarth();
-
-                    bool mainFuelAvailable = false;
-                    bool scramFuelAvailable = false;
-                    bool apuFuelAvailable = false;
-
-                    if (isDocked)
-                    {
-                        mainFuelAvailable = config.AllowDockResupply[TANK_MAIN];
-                        scramFuelAvailable = config.AllowDockResupply[TANK_SCRAM];
-                        apuFuelAvailable = config.AllowDockResupply[TANK_APU];
-                    }
-                    else  // we are grounded
+                    // mark for "target nominal pressure" for all available fuel lines; this will start the pressure gauges moving
+                    for (int tank = 0; tank < RESUPPLY_LINE_COUNT; tank++)
                     {
-                        mainFuelAvailable = (config.AllowEarthOnlyResupply[TANK_MAIN] ? onEarth : config.AllowGroundResupply[TANK_MAIN]);
-                        scramFuelAvailable = (config.AllowEarthOnlyResupply[TANK_SCRAM] ? onEarth : config.AllowGroundResupply[TANK_SCRAM]);
-                        apuFuelAvailable = (config.AllowEarthOnlyResupply[TANK_APU] ? onEarth : config.AllowGroundResupply[TANK_APU]);
+                        if (!m_lines[tank].isLoxLine && IsResupplyAvailable(tank))
+                            m_lines[tank].pLinePressure->m_pressureTarget = -1;
                     }
 
-                    // mark for "target nominal pressure" for all fuel lines; this will start the pressure gauges moving
-                    if (mainFuelAvailable)
-                        m_pMainLinePressure->m_pressureTarget = -1;
-
-                    if (scramFuelAvailable)
-                        m_pScramLinePressure->m_pressureTarget = -1;
-
-                    if (apuFuelAvailable)
-                        m_pApuLinePressure->m_pressureTarget = -1;
-
                     // refueling begins at next timestep
                 }
                 else    // refueling online!
                 {
-                    PerformRefueling(simt, simdt, mjd);     // will check individual line switches to determine flow
+                    fuelLinesOnline = true;
                 }
             }
         }
@@ -198,24 +217,18 @@ void ResupplyPostStep::clbkPrePostStep(const double simt, const double simdt, co
                     GetXR1().PlaySound(GetXR1().LoxResupplyLine, DeltaGliderXR1::ST_Other);   // use max volume for this
                     GetXR1().ShowInfo("LOX Resupply Systems Online.wav", DeltaGliderXR1::ST_InformationCallout, "External LOX line attached;&LOX resupply systems ONLINE.");
 
-                    // determine if the LOX line should have pressure
-                    const XR1ConfigFileParser& config = *GetXR1().GetXR1Config();
-                    bool loxAvailable = false;
-
-                    if (GetXR1().IsDocked())
-                        loxAvailable = config.AllowDockResupply[TANK_LOX];
-                    else  // we are grounded
-                        loxAvailable = (config.AllowEarthOnlyResupply[TANK_LOX] ? GetXR1().IsLandedOnEarth() : config.AllowGroundResupply[TANK_LOX]);
-
-                    // mark for "target nominal pressure" for all fuel lines; this will start the pressure gauges moving
-                    if (loxAvailable)
-                        m_pLoxLinePressure->m_pressureTarget = -1;     // mark for "target nominal pressure" to start the pressure gauge moving
+                    // mark for "target nominal pressure" if the LOX line is available; this will start the pressure gauge moving
+                    for (int tank = 0; tank < RESUPPLY_LINE_COUNT; tank++)
+                    {
+                        if (m_lines[tank].isLoxLine && IsResupplyAvailable(tank))
+                            m_lines[tank].pLinePressure->m_pressureTarget = -1;
+                    }
 
                     // resupply begins at next timestep
                 }
                 else    // LOX resupply online!
                 {
-                    PerformLoxResupply(simt, simdt, mjd);  // will check LOX switch to determine flow
+                    loxLinesOnline = true;
                 }
             }
         }
@@ -320,18 +333,20 @@ void ResupplyPostStep::clbkPrePostStep(const double simt, const double simdt, co
         }
     }
 
-    // adjust pressure for all lines; this occurs each step regardless of state
-    m_pMainLinePressure->AdjustPressure(simt, simdt, mjd);
-    m_pScramLinePressure->AdjustPressure(simt, simdt, mjd);
-    m_pApuLinePressure->AdjustPressure(simt, simdt, mjd);
-    m_pLoxLinePressure->AdjustPressure(simt, simdt, mjd);
+    // flow every online line whose switch is ON; the flow network solves all lines together
+    if (fuelLinesOnline || loxLinesOnline)
+        PerformResupply(simdt, fuelLinesOnline, loxLinesOnline);
+
+    // adjust pressure for all lines and count the lines that are flowing; this occurs each step regardless of state
+    int flowCount = 0;
+    for (ResupplyLine &line : m_lines)
+    {
+        line.pLinePressure->AdjustPressure(simt, simdt, mjd);
+        flowCount += static_cast<int>(GetXR1().*line.pFlowSwitch);
+    }
 
     // NOTE: no sound for external coolant flowing
     // handle fuel/lox flow sounds; handled by a single sound
-    int flowCount = static_cast<int>(GetXR1().m_mainFuelFlowSwitch) +
-        static_cast<int>(GetXR1().m_scramFuelFlowSwitch) +
-        static_cast<int>(GetXR1().m_apuFuelFlowSwitch) +
-        static_cast<int>(GetXR1().m_loxFlowSwitch);
 
     if (flowCount > 0)
     {
@@ -357,288 +372,187 @@ void ResupplyPostStep::clbkPrePostStep(const double simt, const double simdt, co
 // reset fuel pressure state; invoked when refueling line disconnected
 void ResupplyPostStep::DisconnectFuelLines()
 {
-    m_pMainLinePressure->Disconnected();
-    m_pScramLinePressure->Disconnected();
-    m_pApuLinePressure->Disconnected();
+    for (ResupplyLine &line : m_lines)
+    {
+        if (!line.isLoxLine)
+            line.pLinePressure->Disconnected();
+    }
 }
 
 // reset lox pressure state; invoked when refueling line disconnected
 void ResupplyPostStep::DisconnectLoxLine()
 {
-    m_pLoxLinePressure->Disconnected();
+    for (ResupplyLine &line : m_lines)
+    {
+        if (line.isLoxLine)
+            line.pLinePressure->Disconnected();
+    }
 }
 
-// Check individual refueling lines and handle refueling operations; this is only invoked when 
-// refueling systems are ONLINE; however, FUEL PRESSURE may be building yet.
-void ResupplyPostStep::PerformRefueling(const double simt, const double simdt, const double mjd)
+// Returns true if the config file allows resupply of the specified tank (TANK_MAIN, etc.) in our current location
+bool ResupplyPostStep::IsResupplyAvailable(const int tank) const
 {
     const XR1ConfigFileParser& config = *GetXR1().GetXR1Config();
-    const bool onEarth = GetXR1().IsLandedOnEarth();
-
-    bool mainFuelAvailable = false;
-    bool scramFuelAvailable = false;
-    bool apuFuelAvailable = false;
 
     if (GetXR1().IsDocked())
-    {
-        mainFuelAvailable = config.AllowDockResupply[TANK_MAIN];
-        scramFuelAvailable = config.AllowDockResupply[TANK_SCRAM];
-        apuFuelAvailable = config.AllowDockResupply[TANK_APU];
-    }
-    else  // we are grounded
-    {
-        mainFuelAvailable = (config.AllowEarthOnlyResupply[TANK_MAIN] ? onEarth : config.AllowGroundResupply[TANK_MAIN]);
-        scramFuelAvailable = (config.AllowEarthOnlyResupply[TANK_SCRAM] ? onEarth : config.AllowGroundResupply[TANK_SCRAM]);
-        apuFuelAvailable = (config.AllowEarthOnlyResupply[TANK_APU] ? onEarth : config.AllowGroundResupply[TANK_APU]);
-    }
-
-    // 
-    // Handle pressure climb / variance for all three fuel lines (main, scram, apu)
-    //
+        return config.AllowDockResupply[tank];
 
-    if (mainFuelAvailable && GetXR1().m_mainFuelFlowSwitch)
-        FlowMainFuel(simt, simdt, mjd);
-
-    if (scramFuelAvailable && GetXR1().m_scramFuelFlowSwitch)
-        FlowScramFuel(simt, simdt, mjd);
-
-    if (apuFuelAvailable && GetXR1().m_apuFuelFlowSwitch)
-        FlowApuFuel(simt, simdt, mjd);
+    // we are grounded
+    return (config.AllowEarthOnlyResupply[tank] ? GetXR1().IsLandedOnEarth() : config.AllowGroundResupply[tank]);
 }
 
-// Invoked at each timestep when fuel flowing into main tank
-void ResupplyPostStep::FlowMainFuel(const double simt, const double simdt, const double mjd)
+// Copy the vessel's tank masses and capacities into the flow network; payload bay tanks are separate nodes
+void ResupplyPostStep::GatherTankMasses()
 {
-    double mainTankQty = GetXR1().GetXRPropellantMass(GetXR1().ph_main);
-    const double mainTankMaxQty = GetXR1().GetXRPropellantMaxMass(GetXR1().ph_main);
+    const DeltaGliderXR1 &xr1 = GetXR1();
+
+    const PROPELLANT_HANDLE phMain = xr1.ph_main, phScram = xr1.ph_scram;
+    m_network.GetTank(TANK_MAIN) .Mass = xr1.GetPropellantMass(phMain);
+    m_network.GetTank(TANK_SCRAM).Mass = xr1.GetPropellantMass(phScram);
+    m_network.GetTank(TANK_APU)  .Mass = xr1.m_apuFuelQty;
+    m_network.GetTank(TANK_LOX)  .Mass = xr1.m_loxQty;
+    m_network.GetTank(TANK_MAIN) .Capacity = xr1.GetPropellantMaxMass(phMain);
+    m_network.GetTank(TANK_SCRAM).Capacity = xr1.GetPropellantMaxMass(phScram);
+    m_network.GetTank(TANK_APU)  .Capacity = APU_FUEL_CAPACITY;
+    m_network.GetTank(TANK_LOX)  .Capacity = xr1.GetXR1Config()->GetMaxLoxMass();
+
+    m_network.GetTank(m_bayTank[TANK_MAIN]) .Mass = xr1.GetXRBayPropellantMass(phMain);
+    m_network.GetTank(m_bayTank[TANK_SCRAM]).Mass = xr1.GetXRBayPropellantMass(phScram);
+    m_network.GetTank(m_bayTank[TANK_LOX])  .Mass = xr1.GetXRBayLOXMass();
+    m_network.GetTank(m_bayTank[TANK_MAIN]) .Capacity = xr1.GetXRPropellantMaxMass(phMain) - m_network.GetTank(TANK_MAIN).Capacity;
+    m_network.GetTank(m_bayTank[TANK_SCRAM]).Capacity = xr1.GetXRPropellantMaxMass(phScram) - m_network.GetTank(TANK_SCRAM).Capacity;
+    m_network.GetTank(m_bayTank[TANK_LOX])  .Capacity = xr1.GetXRLOXMaxMass() - m_network.GetTank(TANK_LOX).Capacity;
+
+    m_network.GetTank(m_rcsTank).Mass = xr1.GetXRPropellantMass(xr1.ph_rcs);
+    m_network.GetTank(m_rcsTank).Capacity = xr1.GetXRPropellantMaxMass(xr1.ph_rcs);
+}
 
-    bool haltFlow = false;
+// Copy the flow network's tank masses back to the vessel for each tank that took any flow; pPrevMass is indexed by network tank.
+// Ship and bay tanks are set together, and the vessel fills its internal tanks first, as the network does.
+void ResupplyPostStep::ScatterTankMasses(const double *pPrevMass)
+{
+    DeltaGliderXR1 &xr1 = GetXR1();
 
-    // if main tank already full, we cannot refuel a full tank
-    if (mainTankQty >= mainTankMaxQty)
-    {
-        GetXR1().ShowInfo("Main Fuel Tanks Full.wav", DeltaGliderXR1::ST_InformationCallout, "Main fuel tanks already full.");
-        haltFlow = true;
-    }
-    else   // tanks not full yet
+    for (int tank = 0; tank < RESUPPLY_LINE_COUNT; tank++)
     {
-        // adjust by pressure
-        const double pressureFrac = GetXR1().m_mainExtLinePressure / GetXR1().m_nominalMainExtLinePressure;  // 0...1
-        const double fuelFlowForThisStep = (FUEL_LOAD_RATE * simdt * pressureFrac); // main tank loads with no load fraction (i.e., effectively 1.0)
-
-        mainTankQty += fuelFlowForThisStep;
+        const int bayTank = m_bayTank[tank];
+        const double bayMass = ((bayTank >= 0) ? m_network.GetTank(bayTank).Mass : 0);
+        if ((m_network.GetTank(tank).Mass == pPrevMass[tank]) && ((bayTank < 0) || (bayMass == pPrevMass[bayTank])))
+            continue;
 
-        // check limits
-        const char* pMsg = nullptr;
-        if (mainTankQty > mainTankMaxQty)  // main tank overflow
+        const double mass = m_network.GetTank(tank).Mass + bayMass;
+        switch (tank)
         {
-            mainTankQty = mainTankMaxQty;
-
-            // halt fuel flow ONLY if cross-feed is not set to RCS; i.e., fuel is not draining into the RCS tank
-            if (GetXR1().m_xfeedMode != XFEED_MODE::XF_RCS)
-                haltFlow = true;
-
-            // no need for a msg here; the FuelCalloutsPostStep will handle it
+        case TANK_MAIN:  xr1.SetXRPropellantMass(xr1.ph_main, mass);  break;
+        case TANK_SCRAM: xr1.SetXRPropellantMass(xr1.ph_scram, mass); break;
+        case TANK_APU:   xr1.m_apuFuelQty = mass;                     break;
+        case TANK_LOX:   xr1.SetXRLOXMass(mass);                      break;  // updates payload LOX mass as well
         }
-
-        GetXR1().SetXRPropellantMass(GetXR1().ph_main, mainTankQty);
     }
 
-    // flow sounds are handled by our caller
-    // NOTE: "main fuel tank full" is handled by our FuelCalloutsPostStep
-    if (haltFlow)
-    {
-        GetXR1().m_mainFuelFlowSwitch = false;
-
-        // refresh the switch and its LED
-        GetXR1().TriggerRedrawArea(AID_MAINSUPPLYLINE_SWITCH);
-        GetXR1().TriggerRedrawArea(AID_MAINSUPPLYLINE_SWITCH_LED);
-
-        // flow sound will stop next timestep 
-    }
+    if (m_network.GetTank(m_rcsTank).Mass != pPrevMass[m_rcsTank])
+        xr1.SetXRPropellantMass(xr1.ph_rcs, m_network.GetTank(m_rcsTank).Mass);
 }
 
-// Invoked at each timestep when fuel flowing into scram tank
-void ResupplyPostStep::FlowScramFuel(const double simt, const double simdt, const double mjd)
+// Returns true if the specified tank and its payload bay tanks, if any, are full
+bool ResupplyPostStep::IsTankFull(const int tank) const
 {
-    double scramTankQty = GetXR1().GetXRPropellantMass(GetXR1().ph_scram);
-    const double scramTankMaxQty = GetXR1().GetXRPropellantMaxMass(GetXR1().ph_scram);
-
-    bool haltFlow = false;
-
-    // if SCRAM tank is hidden and no SCRAM tank present in bay, we cannot flow any fuel to resupply anything
-    // Note: if the SCRAM tank is hidden, then by definition we have a payload bay, so no need to check if m_pPayloadBay is null here
-    if (GetXR1().m_SCRAMTankHidden && (GetXR1().m_pPayloadBay->GetPropellantMaxMass(PROP_TYPE::PT_SCRAM) <= 0))  // < 0 for sanity check
-    {
-        GetXR1().ShowWarning(nullptr, DeltaGliderXR1::ST_None, "No SCRAM fuel tank in bay.");
-        GetXR1().PlayErrorBeep();
-        haltFlow = true;
-        goto FlowScramFuelExit;
-    }
-
-    // if scram tank already full, we cannot refuel a full tank
-    if (scramTankQty >= scramTankMaxQty)
-    {
-        GetXR1().ShowInfo("Scram Fuel Tanks Full.wav", DeltaGliderXR1::ST_InformationCallout, "SCRAM fuel tanks already full.");
-        haltFlow = true;
-    }
-    else   // tanks not full yet
-    {
-        // adjust by pressure
-        const double pressureFrac = GetXR1().m_scramExtLinePressure / GetXR1().m_nominalScramExtLinePressure;  // 0...1
-        const double fuelFlowForThisStep = (FUEL_LOAD_RATE * simdt * SCRAM_FLOW_FRACTION * pressureFrac);
-
-        scramTankQty += fuelFlowForThisStep;
-
-        // check limits
-        const char* pMsg = nullptr;
-        if (scramTankQty > scramTankMaxQty)  // scram tank overflow
-        {
-            scramTankQty = scramTankMaxQty;
-            haltFlow = true;
-            // no need for a msg here; the FuelCalloutsPostStep will handle it
-        }
-        GetXR1().SetXRPropellantMass(GetXR1().ph_scram, scramTankQty);
-    }
+    return (m_network.IsFull(tank) && ((m_bayTank[tank] < 0) || m_network.IsFull(m_bayTank[tank])));
+}
 
-    // flow sounds are handled by our caller
-    // NOTE: "scram fuel tank full" is handled by our FuelCalloutsPostStep
-FlowScramFuelExit:
-    if (haltFlow)
-    {
-        GetXR1().m_scramFuelFlowSwitch = false;
+// Turn off the flow switch for the specified tank's line
+void ResupplyPostStep::HaltFlow(const int tank)
+{
+    const ResupplyLine &line = m_lines[tank];
+    GetXR1().*line.pFlowSwitch = false;
 
-        // refresh the switch and its LED
-        GetXR1().TriggerRedrawArea(AID_SCRAMSUPPLYLINE_SWITCH);
-        GetXR1().TriggerRedrawArea(AID_SCRAMSUPPLYLINE_SWITCH_LED);
+    // refresh the switch and its LED
+    GetXR1().TriggerRedrawArea(line.switchAreaID);
+    GetXR1().TriggerRedrawArea(line.switchLedAreaID);
 
-        // flow sound will stop next timestep 
-    }
+    // flow sound will stop next timestep
 }
 
-// Invoked at each timestep when fuel flowing into apu tank
-void ResupplyPostStep::FlowApuFuel(const double simt, const double simdt, const double mjd)
+// Flow resupply through every online line whose flow switch is ON: lines fed by the fuel hatch if fuelLinesOnline, and
+// by the LOX hatch if loxLinesOnline.  Line pressure may be building yet.
+//
+// All lines are solved together by m_network, which also fills the payload bay tanks once the ship tanks are full and
+// cross-feeds the main line into the RCS tank if so configured.  A line is halted once nothing more can flow through it.
+void ResupplyPostStep::PerformResupply(const double simdt, const bool fuelLinesOnline, const bool loxLinesOnline)
 {
-    double apuTankQty = GetXR1().m_apuFuelQty;
-    const double apuTankMaxQty = APU_FUEL_CAPACITY;
-
-    bool haltFlow = false;
+    DeltaGliderXR1 &xr1 = GetXR1();
+    GatherTankMasses();
 
-    // if apu tank already full, we cannot refuel a full tank
-    if (apuTankQty >= apuTankMaxQty)
+    bool isLineOpen[RESUPPLY_LINE_COUNT] = { false };
+    for (int tank = 0; tank < RESUPPLY_LINE_COUNT; tank++)
     {
-        GetXR1().ShowInfo("APU Fuel Tanks Full.wav", DeltaGliderXR1::ST_InformationCallout, "APU fuel tanks already full.");
-        haltFlow = true;
-    }
-    else   // tanks not full yet
-    {
-        // adjust by pressure
-        const double pressureFrac = GetXR1().m_apuExtLinePressure / GetXR1().m_nominalApuExtLinePressure;  // 0...1
-        const double fuelFlowForThisStep = (FUEL_LOAD_RATE * simdt * APU_FLOW_FRACTION * pressureFrac);
-
-        apuTankQty += fuelFlowForThisStep;
-
-        // check limits
-
-        const char* pMsg = nullptr;
-        if (apuTankQty > apuTankMaxQty)  // apu tank overflow
+        const ResupplyLine &line = m_lines[tank];
+        XR1ResupplyNetwork::Line &networkLine = m_network.GetLine(tank);
+        networkLine.Open = false;
+        if (!(line.isLoxLine ? loxLinesOnline : fuelLinesOnline) || !(xr1.*line.pFlowSwitch) || !IsResupplyAvailable(tank))
+            continue;
+
+        // if SCRAM tank is hidden and no SCRAM tank present in bay, we cannot flow any fuel to resupply anything
+        // Note: if the SCRAM tank is hidden, then by definition we have a payload bay, so no need to check if m_pPayloadBay is null here
+        if ((tank == TANK_SCRAM) && xr1.m_SCRAMTankHidden && (xr1.m_pPayloadBay->GetPropellantMaxMass(PROP_TYPE::PT_SCRAM) <= 0))  // < 0 for sanity check
         {
-            apuTankQty = apuTankMaxQty;
-            haltFlow = true;
-            // no need for a msg here; the FuelCalloutsPostStep will handle it
+            xr1.ShowWarning(nullptr, DeltaGliderXR1::ST_None, "No SCRAM fuel tank in bay.");
+            xr1.PlayErrorBeep();
+            HaltFlow(tank);
+            continue;
         }
 
-        GetXR1().m_apuFuelQty = apuTankQty;
+        // The line flows its nominal rate at nominal pressure, so its resistance is nominal pressure / nominal rate.
+        // LOX flows at a fraction of its total capacity, but no slower than its nominal rate.
+        const double totalCapacity = m_network.GetTank(tank).Capacity + ((m_bayTank[tank] >= 0) ? m_network.GetTank(m_bayTank[tank]).Capacity : 0);
+        const double flowRate = max(line.nominalFlowRate, totalCapacity * line.capacityFlowFraction);
+        const double nominalPressure = line.pLinePressure->GetNominalPressure();
+        networkLine.Pressure = ((nominalPressure > 0) ? line.pLinePressure->GetPressure() : 0);   // no flow until the line is pressurized
+        networkLine.Resistance = ((nominalPressure > 0) ? nominalPressure : 1.0) / flowRate;
+        networkLine.Open = true;
+        isLineOpen[tank] = true;
     }
 
-    // flow sounds are handled by our caller
-    // NOTE: "apu fuel tank full" is handled by our FuelCalloutsPostStep
-    if (haltFlow)
+    // payload bay tanks fill once their ship tank is full, and the main tank overflows into the RCS tank if cross-feed is set to RCS
+    for (int tank = 0; tank < RESUPPLY_LINE_COUNT; tank++)
     {
-        GetXR1().m_apuFuelFlowSwitch = false;
-
-        // refresh the switch and its LED
-        GetXR1().TriggerRedrawArea(AID_APUSUPPLYLINE_SWITCH);
-        GetXR1().TriggerRedrawArea(AID_APUSUPPLYLINE_SWITCH_LED);
-
-        // flow sound will stop next timestep 
+        if (m_bayLink[tank] >= 0)
+        {
+            XR1ResupplyNetwork::Link &bayLink = m_network.GetLink(m_bayLink[tank]);
+            bayLink.Resistance = m_bayLinkResistance;
+            bayLink.Open = true;
+        }
     }
-}
-
-// **** LOX Resupply 
 
-// Check LOX switch and handle resupply operations; this is only invoked when 
-// LOX resupply systems are ONLINE; however, LOX PRESSURE may be building yet.
-void ResupplyPostStep::PerformLoxResupply(const double simt, const double simdt, const double mjd)
-{
-    const XR1ConfigFileParser& config = *GetXR1().GetXR1Config();
-
-    bool loxAvailable = false;
-
-    if (GetXR1().IsDocked())
-        loxAvailable = config.AllowDockResupply[TANK_LOX];
-    else  // we are grounded
-        loxAvailable = (config.AllowEarthOnlyResupply[TANK_LOX] ? GetXR1().IsLandedOnEarth() : config.AllowGroundResupply[TANK_LOX]);
+    XR1ResupplyNetwork::Link &xfeedLink = m_network.GetLink(m_xfeedLink);
+    xfeedLink.Open = ((m_xfeedLinkResistance > 0) && (xr1.m_xfeedMode == XFEED_MODE::XF_RCS));
+    xfeedLink.Resistance = (xfeedLink.Open ? m_xfeedLinkResistance : 1.0);
 
-    // 
-    // Handle LOX flow
-    //
-
-    if (loxAvailable)
-    {
-        if (GetXR1().m_loxFlowSwitch)
-            FlowLox(simt, simdt, mjd);
-    }
-}
-
-// Invoked at each timestep when LOX flowing into main tank
-void ResupplyPostStep::FlowLox(const double simt, const double simdt, const double mjd)
-{
-    double loxTankQty = GetXR1().GetXRLOXMass();
-    const double loxTankMaxQty = GetXR1().GetXRLOXMaxMass();
+    double prevMass[XR1ResupplyNetwork::MAX_TANKS];
+    for (int i = 0; i < m_network.GetTankCount(); i++)
+        prevMass[i] = m_network.GetTank(i).Mass;
 
-    bool haltFlow = false;
+    m_network.Solve(simdt);
+    ScatterTankMasses(prevMass);
 
-    // if main tank already full, we cannot refuel a full tank
-    if (loxTankQty >= loxTankMaxQty)
+    // halt each line that can flow no more
+    for (int tank = 0; tank < RESUPPLY_LINE_COUNT; tank++)
     {
-        GetXR1().ShowInfo("LOX Tanks Full.wav", DeltaGliderXR1::ST_InformationCallout, "LOX fuel tanks already full.");
-        haltFlow = true;
-    }
-    else   // tanks not full yet
-    {
-        // LOX flow fraction is based on tank capacity AND a minimum flow rate per second * pressureFraction
-        const double pressureFrac = GetXR1().m_loxExtLinePressure / GetXR1().m_nominalLoxExtLinePressure;  // 0...1
-        const double flowRate = max(GetXR1().GetXRLOXMaxMass() * LOX_LOAD_FRAC * pressureFrac, LOX_MIN_FLOW_RATE * pressureFrac);
-        const double loxFlowForThisStep = (flowRate * simdt);  // mass * load rate in TANK FRACTION/SECOND
-
-        loxTankQty += loxFlowForThisStep;
-
-        // check limits
+        if (!isLineOpen[tank] || (m_network.GetLineFlowRate(tank) > 0) || !IsTankFull(tank))
+            continue;   // still flowing, or line pressure still building
 
-        const char* pMsg = nullptr;
-        if (loxTankQty > loxTankMaxQty)  // tank overflow?
+        if (m_network.GetLineFlow(tank) <= 0)
         {
-            loxTankQty = loxTankMaxQty;
-            haltFlow = true;
-
-            // no need for a msg here; the FuelCalloutsPostStep will handle it
+            // tank was already full; we cannot refuel a full tank
+            xr1.ShowInfo(m_lines[tank].pTankFullWav, DeltaGliderXR1::ST_InformationCallout, m_lines[tank].pTankFullMsg);
+            HaltFlow(tank);
+        }
+        else if ((tank != TANK_MAIN) || (xr1.m_xfeedMode != XFEED_MODE::XF_RCS))
+        {
+            // Tank filled this timestep.  Main fuel keeps flowing while cross-feed is set to RCS, since XFeedPostStep
+            // keeps draining it into the RCS tank.  No need for a msg here; the FuelCalloutsPostStep will handle it.
+            HaltFlow(tank);
         }
-
-        GetXR1().SetXRLOXMass(loxTankQty);  // updates payload LOX mass as well
-    }
-
-    // flow sounds are handled by our caller
-    // NOTE: "lox fuel tank full" is handled by our FuelCalloutsPostStep
-    if (haltFlow)
-    {
-        GetXR1().m_loxFlowSwitch = false;
-
-        // refresh the switch and its LED
-        GetXR1().TriggerRedrawArea(AID_LOXSUPPLYLINE_SWITCH);
-        GetXR1().TriggerRedrawArea(AID_LOXSUPPLYLINE_SWITCH_LED);
-
-        // flow sound will stop next timestep 
     }
 }
 
@@ -687,8 +601,8 @@ void LinePressure::AdjustPressure(const double simt, const double simdt, const d
             m_pressureTarget = m_maxPressure * RESUPPLY_DOCKED_PSI_FACTOR;
 
         // actual pressure may vary +-RESUPPLY_RANDOM_LIMIT fraction
-        const double sign = ((oapiRand() < 0.5) ? -1.0 : 1.0);
-        const double varianceFrac = RESUPPLY_RANDOM_LIMIT * oapiRand() * sign;
+        const double sign = ((m_xr1.XRRand() < 0.5) ? -1.0 : 1.0);
+        const double varianceFrac = RESUPPLY_RANDOM_LIMIT * m_xr1.XRRand() * sign;
         m_pressureTarget += (m_maxPressure * varianceFrac);  // NOTE: variance is by MAX PRESSURE here
         m_initialPressureTarget = m_pressureTarget; // this will be nominal pressure for this fueling session
     }
@@ -720,8 +634,8 @@ void LinePressure::AdjustPressure(const double simt, const double simdt, const d
             if (m_flowInProgress)
             {
                 // adjust the pressure target by a variance based on the NOMINAL pressure; i.e., successive variances do not "stack"
-                const double sign = ((oapiRand() < 0.5) ? -1.0 : 1.0);
-                const double varianceFrac = RESUPPLY_RANDOM_LIMIT * oapiRand() * sign;
+                const double sign = ((m_xr1.XRRand() < 0.5) ? -1.0 : 1.0);
+                const double varianceFrac = RESUPPLY_RANDOM_LIMIT * m_xr1.XRRand() * sign;
                 const double variance = (m_maxPressure * varianceFrac);  // in PSI; variance is by MAX PRESSURE here
                 m_pressureTarget = (m_initialPressureTarget * 0.81) + variance;  // 19% lower pressure when flowing
 
@@ -0,0 +1,120 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+
+#include "XR1PostSteps.h"
+
+// the telemetry record cannot include XRVesselCtrl.h, so verify its array sizes here
+static_assert((sizeof(XRTelemetryRecord::ThrottleLevel) / sizeof(double)) == XRTELEMETRY_ENGINE_COUNT, "XRTelemetryRecord engine count mismatch");
+static_assert((sizeof(XRTelemetryRecord::DoorStates) / sizeof(int32_t)) == XRTELEMETRY_DOOR_COUNT, "XRTelemetryRecord door count mismatch");
+
+//---------------------------------------------------------------------------
+
+TelemetryExportPostStep::TelemetryExportPostStep(DeltaGliderXR1 &vessel) :
+    XR1PrePostStep(vessel),
+    m_openFailed(false)
+{
+}
+
+void TelemetryExportPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
+{
+    // create the shared memory segment on the first frame; the vessel name is not final until then
+    if (!m_ringWriter.IsOpen())
+    {
+        if (m_openFailed)
+            return;
+
+        char msg[512];
+        if (!m_ringWriter.Open(GetVessel().GetName()))
+        {
+            m_openFailed = true;
+            sprintf(msg, "WARNING: could not create telemetry export shared memory segment for vessel '%s'; telemetry export disabled", GetVessel().GetName());
+            GetXR1().GetXR1Config()->WriteLog(msg);
+            return;
+        }
+
+        char name[256];
+        XRTelemetryRingName(GetVessel().GetName(), name, sizeof(name));
+        sprintf(msg, "Telemetry export enabled: shared memory segment '%s'", name);
+        GetXR1().GetXR1Config()->WriteLog(msg);
+    }
+
+    XRTelemetryRecord record;
+    BuildRecord(mjd, record);
+    m_ringWriter.Publish(record);
+}
+
+// Populate a telemetry record for this frame; uses the shared per-frame snapshot so we don't duplicate
+// any XRVesselCtrl client's work.
+void TelemetryExportPostStep::BuildRecord(const double mjd, XRTelemetryRecord &recordOut)
+{
+    DeltaGliderXR1 &xr1 = GetXR1();
+    xr1.GetXRTelemetrySnapshot(m_snapshot);
+    const XRSystemStatusRead &status = m_snapshot.Status;
+
+    recordOut.FrameSequence = m_snapshot.FrameSequence;
+    recordOut.SimTime = m_snapshot.SimTime;
+    recordOut.MJD = mjd;
+
+    VECTOR3 horizonAirspeed;
+    xr1.GetHorizonAirspeedVector(horizonAirspeed);
+    recordOut.Altitude = xr1.GetAltitude(ALTMODE_GROUND);
+    recordOut.Airspeed = xr1.GetAirspeed();
+    recordOut.Groundspeed = xr1.GetGroundspeed();
+    recordOut.VerticalSpeed = horizonAirspeed.y;
+    recordOut.Mach = xr1.GetMachNumber();
+    recordOut.DynamicPressure = xr1.GetDynPressure();
+    recordOut.StaticPressure = xr1.GetAtmPressure();
+    recordOut.Pitch = xr1.GetPitch();
+    recordOut.Bank = xr1.GetBank();
+    recordOut.Yaw = xr1.GetYaw();
+    recordOut.AOA = xr1.GetAOA();
+    recordOut.SlipAngle = xr1.GetSlipAngle();
+    recordOut.Mass = xr1.GetMass();
+
+    for (int i = 0; i < XRTELEMETRY_ENGINE_COUNT; i++)
+    {
+        const bool supported = m_snapshot.EngineSupported[i];
+        recordOut.ThrottleLevel[i] = (supported ? m_snapshot.Engines[i].ThrottleLevel : -1);
+        recordOut.Thrust[i] = (supported ? m_snapshot.Engines[i].Thrust : -1);
+    }
+
+    const int mainIndex = static_cast<int>(XREngineID::XRE_MainLeft);
+    const int scramIndex = static_cast<int>(XREngineID::XRE_ScramLeft);
+    recordOut.MainFuelLevel = (m_snapshot.EngineSupported[mainIndex] ? m_snapshot.Engines[mainIndex].FuelLevel : -1);
+    recordOut.SCRAMFuelLevel = (m_snapshot.EngineSupported[scramIndex] ? m_snapshot.Engines[scramIndex].FuelLevel : -1);
+    recordOut.RCSFuelLevel = status.RCSFuelLevel;
+    recordOut.APUFuelLevel = status.APUFuelLevel;
+    recordOut.LOXLevel = status.LOXLevel;
+
+    recordOut.NoseconeTemp = status.NoseconeTemp;
+    recordOut.LeftWingTemp = status.LeftWingTemp;
+    recordOut.RightWingTemp = status.RightWingTemp;
+    recordOut.CockpitTemp = status.CockpitTemp;
+    recordOut.TopHullTemp = status.TopHullTemp;
+    recordOut.CoolantTemp = status.CoolantTemp;
+
+    for (int i = 0; i < XRTELEMETRY_DOOR_COUNT; i++)
+        recordOut.DoorStates[i] = static_cast<int32_t>(m_snapshot.DoorStates[i]);
+
+    recordOut.MasterWarning = (status.MasterWarning == XRWarningState::XRW_warningActive) ? 1 : 0;
+}
@@ -31,6 +31,7 @@
 
 #include "PrePostStep.h"
 #include "DeltaGliderXR1.h"
+#include "XR1AutopilotLaws.h"
 
 class XR1PrePostStep : public PrePostStep
 {
@@ -39,8 +40,17 @@ public:
     XR1PrePostStep(DeltaGliderXR1 &vessel) :
         PrePostStep(vessel)
     {
+        m_autopilotGains.AngularVelocityDegreesDeltaFrac = AP_ANGULAR_VELOCITY_DEGREES_DELTA_FRAC;
     }
 
     // convenience methods
     DeltaGliderXR1 &GetXR1() const { return static_cast<DeltaGliderXR1 &>(GetVessel()); }
+
+protected:
+    // Returns the autopilot tuning values for this vessel class.
+    const XR1AutopilotGains &GetAutopilotGains() const { return m_autopilotGains; }
+
+    // NOTE: this is a member rather than a function-local static so that each vessel module gets its own values; a static
+    // in this inline header would be merged into a single instance shared by every XR vessel module loaded in the process.
+    XR1AutopilotGains m_autopilotGains;
 };
@@ -315,3 +315,45 @@ void ParkingBrakePreStep::clbkPrePostStep(const double simt, const double simdt,
 		// else no brake override is applied, so normal Orbiter core wheelbrake keys apply for this timestep
 	}
 }
+
+//---------------------------------------------------------------------------
+
+// wall-clock time the startup script may use each frame; whatever is left runs on the following frames
+static const double STARTUP_SCRIPT_FRAME_BUDGET = 0.5e-3;  // seconds
+
+StartupScriptPreStep::StartupScriptPreStep(DeltaGliderXR1 &vessel) :
+    XR1PrePostStep(vessel), m_compileAttempted(false)
+{
+}
+
+// Run the XRVesselCtrl script named by 'StartupScript' in the config file.  The script is compiled on the first timestep, when
+// the vessel is fully initialized, and is not run during playback because Orbiter replays the recorded events instead.
+void StartupScriptPreStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
+{
+    if (GetVessel().Playback())
+        return;
+
+    char msg[512];
+    if (!m_compileAttempted)
+    {
+        m_compileAttempted = true;
+        if (!m_scriptEngine.CompileFile(GetXR1().GetXR1Config()->StartupScript))
+        {
+            // the program is empty after a failed compile, so IsFinished() is true from now on
+            snprintf(msg, sizeof(msg), "WARNING: startup script not run: %s", m_scriptEngine.GetErrorMessage());
+            GetXR1().GetXR1Config()->WriteLog(msg);
+            return;
+        }
+    }
+
+    if (m_scriptEngine.IsFinished())
+        return;
+
+    m_scriptEngine.Execute(GetXR1(), STARTUP_SCRIPT_FRAME_BUDGET);
+    if (m_scriptEngine.IsFinished() && (m_scriptEngine.GetFailedCount() > 0))
+    {
+        snprintf(msg, sizeof(msg), "WARNING: the vessel rejected %d startup script command(s); the last one was on line %d",
+            m_scriptEngine.GetFailedCount(), m_scriptEngine.GetLastFailedLine());
+        GetXR1().GetXR1Config()->WriteLog(msg);
+    }
+}
@@ -31,6 +31,8 @@
 
 #include "DeltaGliderXR1.h"
 #include "XR1PrePostStep.h"
+#include "XRVCScriptEngine.h"
+#include "XR1DockingTargets.h"
 
 //---------------------------------------------------------------------------
 
@@ -42,33 +44,16 @@ public:
 
 protected:
     enum class AXIS { PITCH, ROLL, YAW };
-    // inner class to manage learning autopilot data in an atmosphere
-    class LearningData
-    {
-    public:
-        // constructor
-        LearningData() { Reset(); }
-
-        void Reset()
-        {
-            m_thrustFrac = 0;
-            m_lastLearningThrustStep = 0;
-            m_reverseLastLearningThrustStep = false;
-        }
-
-        double m_thrustFrac;      // 0...1: delta to be applied to computed thrust along one direction
-        double m_lastLearningThrustStep;  // last applied learning thrust step
-        bool m_reverseLastLearningThrustStep;  // if true, m_lastLearningThrustStep will be subtracted from m_thrustFrac the next time these jets fire
-    };
-
     void ResetLastYawThrusterLevels() { m_lastSetYawThrusterGroupLevels[0] = m_lastSetYawThrusterGroupLevels[1] = 2; }   // > 1 means "not set yet"
     void ResetCenterOfLift();
     void ResetLearningData();
     void ResetAutopilot();
-    double FireThrusterGroups(const double targetValue, const double currentValue, double angularVelocity, THGROUP_TYPE thgPositive, THGROUP_TYPE thgNegative, const double simdt, const double angVelLimit, const bool reverseRotation, const bool isShipInverted, const AXIS axis, const double masterThrustFrac = 1.0);
-    void KillRotation(const double angularVelocity, const THGROUP_TYPE thgPositive, const THGROUP_TYPE thgNegative, const double simdt, const bool reverseRotation, double * const pOutSetThrusterGroupsLevels = nullptr, const double masterThrustFrac = 1.0);
+    double FireThrusterGroups(const double targetValue, const double currentValue, double angularVelocity, const double angularAcc, THGROUP_TYPE thgPositive, THGROUP_TYPE thgNegative, const double simdt, const double angVelLimit, const bool reverseRotation, const bool isShipInverted, const AXIS axis, const double masterThrustFrac = 1.0);
+    void KillRotation(const double angularVelocity, const THGROUP_TYPE thgPositive, const THGROUP_TYPE thgNegative, const double simdt, const bool reverseRotation, const AXIS axis, double * const pOutSetThrusterGroupsLevels = nullptr, const double masterThrustFrac = 1.0);
+    double GetMaxAngularAcc(const THGROUP_TYPE thg, const AXIS axis) const;
     AUTOPILOT m_prevCustomAutopilotMode;
-    LearningData m_pitchLearningData;
+    XR1LearningData m_pitchLearningData;
+
     double m_lastSetYawThrusterGroupLevels[2];  // last LEFT and RIGHT group levels set by the autopilot
     bool m_performedAPUWarningCallout;          // true if we warned the pilot that the APU is offline since the autopilot was engaged
     bool m_apuRanOnceWhileAPActive;             // true if the APU was running at least once while the autopilot was engaged
@@ -85,6 +70,7 @@ public:
 
 protected:
     AUTOPILOT m_prevCustomAutopilotMode;
+    XR1DisturbanceTrend m_planetAccTrend;
 };
 
 //---------------------------------------------------------------------------
@@ -98,6 +84,7 @@ public:
 
 protected:
     PREV_AIRSPEED_HOLD m_prevAirspeedHold;
+    XR1DisturbanceTrend m_planetAccTrend;
 };
 
 //---------------------------------------------------------------------------
@@ -164,15 +151,26 @@ protected:
 
 //---------------------------------------------------------------------------
 
-class DockingCalloutsPreStep : public XR1PrePostStep
+class DockingCalloutsPreStep : public XR1PrePostStep, public XR1DockingNav
 {
 public:
     DockingCalloutsPreStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+
+    // XR1DockingNav methods
+    virtual NAVHANDLE GetNavSource(const int radio) const;
+    virtual unsigned int GetNavChannel(const int radio) const;
+    virtual OBJHANDLE GetIDSVessel(const NAVHANDLE hNav) const;
+    virtual VECTOR3 GetNavPos(const NAVHANDLE hNav) const;
+    virtual VECTOR3 GetDockingPortPos() const;
+    virtual bool HasPayloadBay() const;
+    virtual unsigned int GetPayloadAttachmentVersion() const;
+    virtual bool IsChildVesselAttached(const OBJHANDLE hVessel) const;
     
 protected:
     void PlayDistance(const double simt, const char *pFilename);
-    double GetDockingDistance();  // distance in meters
+
+    XR1DockingTargets m_dockingTargets;
 
     double m_previousDistance; // Distance @ last step; < 0 = none
     double m_intervalStartTime;      // simt when m_intervalStartDistance was set
@@ -323,3 +321,18 @@ public:
 private:
     double m_nextRefreshSimt;   // simt when we should perform the next rescan 
 };
+
+//---------------------------------------------------------------------------
+// Only added if 'StartupScript' is set in the config file.
+//---------------------------------------------------------------------------
+
+class StartupScriptPreStep : public XR1PrePostStep
+{
+public:
+    StartupScriptPreStep(DeltaGliderXR1 &vessel);
+    virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+
+protected:
+    XRVCScriptEngine m_scriptEngine;
+    bool m_compileAttempted;    // true once we have tried to compile the script
+};
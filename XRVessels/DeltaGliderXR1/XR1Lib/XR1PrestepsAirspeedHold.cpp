@@ -123,47 +123,26 @@ void AirspeedHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
 
         // determine what rate of change (acc) we need in order to hit our target airspeed in a reasonable timeframe
         // A targetAcc of zero will hold the current airspeed rate; i.e., the ship will not be accelerated horizontally
-        double velDelta = targetVelocity - currentAirspeed;     // in m/s; may be positive or negative
-        const double absVelDelta = fabs(velDelta);
-
-        // Try to arrive at rate quickly (for accuracy) but in a reasonable time period so we don't overdrive the engines and oscillate.
-        // NOTE: this is the primary value to tune accuracy vs. oscillation
-        // targetAcc will be rateDelta * (n >= 2.0 m/s/s) 
-        // e.g., if absVelDelta = 10, mult = 2.0   (2.0 m/s/s) : 10 / 5 = 2
-        //       if absVelDelta = 20, mult = 4.0   (4.0 m/s/s) : 20 / 5 = 4
-        //       if absVelDelta = 100, mult = 20.0 (20.0 m/s/s): 100 / 5 = 20
-        // NOTE: velDeltaMultiplier must use absVelDelta because it is merely a positive *multiplier* for a positive or negative *rate*
-        const double velDeltaMultiplier = max(2.0, (absVelDelta / 5));  // n >= 1.0 (no upper limit)
-
-        // NOTE: (1 / velDeltaMultiplier) = fraction of second to reach target acc; e.g., 5 = 1/5th-second; may be negative
-        double targetAcc = (velDelta * velDeltaMultiplier); // target acc range is [velDelta * (n >= 0.5)] m/s/s
+        const double velDelta = targetVelocity - currentAirspeed;     // in m/s; may be positive or negative
 
         // WORKAROUND: If grounded and the SET rate == 0, prevent planetAcc from being NEGATIVE here, since it induces thruster oscillations on the ground
         if (GetVessel().GroundContact() && (GetXR1().m_setAirspeed == 0) && (planetAcc < 0))
             planetAcc = 0;
 
-        // Determine effective acc required to maintain the requested acc (m/s/s); this takes gravity, drag, and our mass into account
-        const double effectiveTargetAcc = -planetAcc + targetAcc;  // planet's pull (including atm drag and lift) + target rate
-
-        // determine thrust required to maintain the requested rate of acc (m/s/s)
-        double targetThrustRequired = effectiveTargetAcc * mass;   // in kN
+        // Set the main thrust level required to hold the requested acc; this takes gravity, drag, and our mass into account along with
+        // how fast gravity and drag changed since the previous frame, and runs the control law every 20 ms over the timestep so that the
+        // engines close on the target airspeed the same way at any time acceleration.
+        const double planetAccRate = m_planetAccTrend.Update(simt, simdt, planetAcc);
+        const double mainThLevel = XR1AutopilotLaws::AirspeedHoldThrustLevel(velDelta, planetAcc, planetAccRate, (maxMainThrust / mass), simdt, GetAutopilotGains());
 
         /* DEBUG
-        sprintf(oapiDebugString(), "planetAcc=%f, targetAcc=%f, velDeltaMultiplier=%f, velDelta=%f, effectiveTargetAcc=%f, targetThrustRequired=%f",
-            planetAcc, targetAcc, velDeltaMultiplier, velDelta, effectiveTargetAcc, targetThrustRequired);
+        sprintf(oapiDebugString(), "planetAcc=%f, velDelta=%f, mainThLevel=%f", planetAcc, velDelta, mainThLevel);
         */
 
-        // set main thrust level required to hold requested acc
-        const double requiredMainThLevel = targetThrustRequired / maxMainThrust;
-        double mainThLevel = requiredMainThLevel;
-        if (mainThLevel < 0)
-            mainThLevel = 0;
-        else if (mainThLevel > 1.0)
-            mainThLevel = 1;
-
 #if 0
         // NOT USED; THIS DOES NOT WORK OUTSIDE OF AN ATMOSPHERE BECAUSE THE SHIP CAN POINT AWAY FROM THE VELOCITY VECTOR
         // set retro thrust level required to hold requested acc
+        const double targetThrustRequired = (-planetAcc + XR1AutopilotLaws::AirspeedHoldTargetAcc(velDelta, simdt, GetAutopilotGains())) * mass;   // in kN
         const double requiredRetroThLevel = (-targetThrustRequired) / maxRetroThrust;
         double retroThLevel = requiredRetroThLevel;
         if (retroThLevel < 0)
@@ -196,8 +175,7 @@ void AirspeedHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
         }
 
         /* DEBUG
-        sprintf(oapiDebugString(), "velDelta=%f, targetAcc=%f, VAcc=%f, effectiveTargetAcc=%f, targetThrustRequired=%f, mainThLevel=%lf, retroThLevel=%lf",
-            velDelta, targetAcc, acc, effectiveTargetAcc, (targetThrustRequired / 1000), mainThLevel, retroThLevel);
+        sprintf(oapiDebugString(), "velDelta=%f, VAcc=%f, mainThLevel=%lf, retroThLevel=%lf", velDelta, acc, mainThLevel, retroThLevel);
         */
     }
 
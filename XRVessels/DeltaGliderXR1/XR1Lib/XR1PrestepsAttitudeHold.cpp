@@ -101,6 +101,11 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
         GetVessel().GetAngularVel(angularVelocity);
         angularVelocity *= DEG; // convert to degrees
 
+        // get our angular acceleration in degrees per second^2; this includes the thruster levels we set on the previous timestep
+        VECTOR3 angularAcc;
+        GetVessel().GetAngularAcc(angularAcc);
+        angularAcc *= DEG;
+
         // handle BANK
         double targetBank = (descentHoldActive ? 0 : GetXR1().m_setBank);             // in degrees; -180 to +180
         const double currentBank = GetVessel().GetBank() * DEG;   // in degrees
@@ -163,7 +168,7 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
         }
 
         // ignore return value here; bank targets should never request COL changes
-        FireThrusterGroups(targetBank, currentBank, angularVelocity.z, ttBankRight, ttBankLeft, simdt, 20.0, false, isInverted, AXIS::ROLL);  // never invert angular velocity target for roll
+        FireThrusterGroups(targetBank, currentBank, angularVelocity.z, angularAcc.z, ttBankRight, ttBankLeft, simdt, 20.0, false, isInverted, AXIS::ROLL);  // never invert angular velocity target for roll
 
         // never CLEAR this flag here; once the initial bank is complete, this flag remains set until the autopilot is disengaged 
         // (UNLESS the AP has to snap across +90 or -90 on the bank setting: see LimitAttitudeHoldPitchAndBank method in XRVessel.cpp 
@@ -197,13 +202,13 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
                 {
                     // we are outside the maximum allowable pitch range trying to hold AOA!  Execute PITCH hold instead at the pitch limit.
                     // Note: always invert thruster rotation vs. angular velocity since we're holding since we're holding PITCH here
-                    requestedColShift = FireThrusterGroups(newPitchTarget, currentPitch, angularVelocity.x, ttPitchUp, ttPitchDown, simdt, 20.0, true, isInverted, AXIS::PITCH);
+                    requestedColShift = FireThrusterGroups(newPitchTarget, currentPitch, angularVelocity.x, angularAcc.x, ttPitchUp, ttPitchDown, simdt, 20.0, true, isInverted, AXIS::PITCH);
                 }
                 else    // pitch is still OK; let's keep tracking AOA hold
                 {
                     // holding AOA
                     // NOTE: must *not* reverse thruster direction if ship is INVERTED since AoA then goes UP when pitch goes DOWN
-                    requestedColShift = FireThrusterGroups(targetAOA, currentAOA, angularVelocity.x, ttPitchUp, ttPitchDown, simdt, 20.0, !isInverted, isInverted, AXIS::PITCH);
+                    requestedColShift = FireThrusterGroups(targetAOA, currentAOA, angularVelocity.x, angularAcc.x, ttPitchUp, ttPitchDown, simdt, 20.0, !isInverted, isInverted, AXIS::PITCH);
                 }
             }
             else  // holding PITCH
@@ -211,7 +216,7 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
                 const double targetPitch = (descentHoldActive ? 0 : GetXR1().m_setPitchOrAOA);  // in degrees
                 const double currentPitch = GetVessel().GetPitch() * DEG;   // in degrees
                 // Note: always invert thruster rotation vs. angular velocity since we're holding since we're holding PITCH here
-                requestedColShift = FireThrusterGroups(targetPitch, currentPitch, angularVelocity.x, ttPitchUp, ttPitchDown, simdt, 20.0, true, isInverted, AXIS::PITCH);
+                requestedColShift = FireThrusterGroups(targetPitch, currentPitch, angularVelocity.x, angularAcc.x, ttPitchUp, ttPitchDown, simdt, 20.0, true, isInverted, AXIS::PITCH);
             }
 
             // reduce COG shift by time acc to maintain stability in atmosphereic flight under time acceleration
@@ -338,7 +343,7 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
         */
 
         if ((descentHoldActive == false) && (pilotFiringYawJets == false) && (rudderActive == false))
-            KillRotation(angularVelocity.y, ttYawLeft, ttYawRight, simdt, false, m_lastSetYawThrusterGroupLevels);
+            KillRotation(angularVelocity.y, ttYawLeft, ttYawRight, simdt, false, AXIS::YAW, m_lastSetYawThrusterGroupLevels);
     }
     else    // neither ATTITUDE HOLD nor DESCENT HOLD engaged -- kill the thrusters and reset the center of lift if the pilot just turned off the autopilot
     {
@@ -387,172 +392,59 @@ void AttitudeHoldPreStep::ResetLearningData()
 }
 
 // angularVelocity = degrees/second; NOTE: MAY BE NEGATIVE!
+// angularAcc = degrees/second^2
 // angVelLimit = angular velocity limit in degrees/second
 // reverseRotation = true to reverse rotation thrust (positive degreesDelta == positive angular velocity as well); e.g., for PITCH axis
 // Returns: requested center-of-lift shift in meters; will be 0.0 for non-pitch axes or if not in an atmosphere.
-double AttitudeHoldPreStep::FireThrusterGroups(const double targetValue, const double currentValue, double angularVelocity, THGROUP_TYPE thgPositive, THGROUP_TYPE thgNegative, const double simdt, double angVelLimit, const bool reverseRotation, const bool isShipInverted, const AXIS axis, const double masterThrustFrac)
+double AttitudeHoldPreStep::FireThrusterGroups(const double targetValue, const double currentValue, double angularVelocity, const double angularAcc, THGROUP_TYPE thgPositive, THGROUP_TYPE thgNegative, const double simdt, double angVelLimit, const bool reverseRotation, const bool isShipInverted, const AXIS axis, const double masterThrustFrac)
 {
     double retVal = 0.0;                     // assume no center-of-lift shift
-    const double targetDeadZone = 0.01;      // in degrees (very tight hold)
-    const double angVelDeadZone = 0.01;      // in degrees/second
 
     const bool descentHoldActive = (GetXR1().m_customAutopilotMode == AUTOPILOT::AP_DESCENTHOLD);
 
+    // Determine how hard everything but the jets (e.g., the air) is rotating the ship right now.
+    // NOTE: GetThrusterGroupLevel returns the levels held during the previous timestep, so this must be done before we set new levels below.
+    const double jetAngularAcc = (GetVessel().GetThrusterGroupLevel(thgPositive) * GetMaxAngularAcc(thgPositive, axis)) -
+        (GetVessel().GetThrusterGroupLevel(thgNegative) * GetMaxAngularAcc(thgNegative, axis));
+    double externalAngularAcc = XR1AutopilotLaws::ExternalAngularAcc(angularAcc, jetAngularAcc);
+
     // handle inverted attitude hold 
     if (isShipInverted && (axis != AXIS::ROLL))
     {
         swap(thgPositive, thgNegative);      // swap the thrusters
         angularVelocity = -angularVelocity;  // target angular velocity is reversed b/c the ship is upside-down & the thrusters are reversed now
+        externalAngularAcc = -externalAngularAcc;
     }
 
-    // compute the optimal closing rate based on how far we have to go yet before reaching target attitude
-    // NOTE: may be negative here!
-    double degreesDelta = targetValue - currentValue;
-    const bool deltaAngleDirection = (degreesDelta >= 0);
-
-    // only fire thrusters if outside our deadzone
-    if (fabs(degreesDelta) > targetDeadZone)
+    XR1AttitudeAxis attitudeAxis;
+    attitudeAxis.TargetValue = targetValue;
+    attitudeAxis.CurrentValue = currentValue;
+    attitudeAxis.AngularVelocity = angularVelocity;
+    attitudeAxis.ExternalAngularAcc = externalAngularAcc;
+    attitudeAxis.HeldJetLevel = GetVessel().GetThrusterGroupLevel(thgPositive) - GetVessel().GetThrusterGroupLevel(thgNegative);
+    attitudeAxis.MaxPositiveAngularAcc = GetMaxAngularAcc(thgPositive, axis);
+    attitudeAxis.MaxNegativeAngularAcc = GetMaxAngularAcc(thgNegative, axis);
+    attitudeAxis.AngVelLimit = angVelLimit;
+    // if we have not reached our initial roll attitude, set a minimum roll rate here so we can reach it faster
+    attitudeAxis.MinAngVel = (GetXR1().m_initialAHBankCompleted ? 0 : 10);     // minimum initial rotation = 10 degrees per second
+    attitudeAxis.ReverseRotation = reverseRotation;
+    // do NOT apply learning mode if in AUTO DESCENT mode; only apply learning thrust in an atmosphere
+    attitudeAxis.ApplyLearningThrust = ((descentHoldActive == false) && GetXR1().InAtm());
+    attitudeAxis.MasterThrustFrac = masterThrustFrac;
+    attitudeAxis.DescentHoldActive = descentHoldActive;
+
+    // NOTE: autopilot cannot hold attitude in atmosphere at 100x; however, it can in space.  Auto-suspend was handled previously by the PreStep.
+    // The learning data is for pitch only.
+    // > 0 fires thgPositive, < 0 fires thgNegative
+    double jetLevel;
+    if (XR1AutopilotLaws::AttitudeHoldJetLevel(attitudeAxis, ((axis == AXIS::PITCH) ? &m_pitchLearningData : nullptr), simdt, GetAutopilotGains(), jetLevel))
     {
-        // if degreesDelta is NEGATIVE, we want a POSITIVE targetAngVel to counteract it unless the REVERSE flag is set
-        // NOTE: do not reduce this too much, or the autopilot cannot hold a given angle precisely enough!
-        // However, if it is too high the ship will oscillate due to too much thrust.
-        // NOTE: this is value #1 to tweak if you want to fine-tune time acc behavior and accuracy
-        double targetAngVel = degreesDelta * AP_ANGULAR_VELOCITY_DEGREES_DELTA_FRAC;  // rotation rate in degrees per second to reach target in reasonable time
-
-        // if we have not reached our initial roll attitude, set a minimum roll rate here so we can reach it faster
-        if (GetXR1().m_initialAHBankCompleted == false)
-        {
-            const double minAngVel = 10;     // minimum initial rotation = 10 degrees per second
-            if (targetAngVel < 0)
-            {
-                if (targetAngVel > -minAngVel)
-                    targetAngVel = -minAngVel;
-            }
-            else  // targetAngVel >= 0
-            {
-                if (targetAngVel < minAngVel)
-                    targetAngVel = minAngVel;
-            }
-        }
-
-#if 0   // DEBUG ONLY
-        if (axis == ROLL)  // roll only
-            sprintf(oapiDebugString(), "targetAngVel=%lf, m_initialAHBankCompleted=%d", targetAngVel, GetXR1().m_initialAHBankCompleted);
-#endif
-
-        // NOTE: must allow target angular velocity to reach zero here!  This is what determines whether we rotate or not.
-
-        // reverse rotation if requested (i.e., for pitch)
-        if (reverseRotation == false)
-            targetAngVel = -targetAngVel;
-
-        // check upper rotation limit (no lower limit, since we want rotation to stop once we reach our target)
-        if (targetAngVel > angVelLimit)
-            targetAngVel = angVelLimit;
-        else if (targetAngVel < -angVelLimit)
-            targetAngVel = -angVelLimit;
-
-        // reduce thruster level as timestep size increases
-        // NOTE: autopilot cannot hold attitude in atmosphere at 100x; however, it can in space.  Auto-suspend was handled previously by the PreStep.
-        const double timeAccDivisor = max((simdt / 0.025), 1.0);   // min framerate for full-speed rotation (thruster levels) is 1/40-second (40 frames/sec)
-        double thLevel = masterThrustFrac / timeAccDivisor;    // was 1.0 / timeAccDivisor
+        const double thLevel = fabs(jetLevel);
+        GetVessel().SetThrusterGroupLevel(thgNegative, ((jetLevel < 0) ? thLevel : 0));
+        GetVessel().SetThrusterGroupLevel(thgPositive, ((jetLevel > 0) ? thLevel : 0));
 
-        // reduce thrust level if we are close to our angular velocity target already
-        const double deltaV = fabs(targetAngVel - angularVelocity);
-
-        // NOTE: this is the primary setting to control negative RCS thrust levels when we overshoot the target angular velocity
-        if (descentHoldActive)
-            thLevel *= min(1.0, deltaV * 1.0);  // must be more aggressive in holding attitude while hovering (only reduce thrust within 1 meter per second); NOTE: used to be x5.0.
-        else    // normal attitude hold
-            thLevel *= min(1.0, deltaV / 5);  // reduce thrust levels if within 5 meters per second
-
-        //
-        // Handle PITCH learning autopilot here to hold a stable pitch during reentry
-        //
-        // modify learning thrust fraction based on whether we closed on the target since the previous frame AND if we are reducing thrust because we are close
-        double newLearningThrustFrac = 0;       // set below
-        double learningThrustStep = 0;          // set below
-        const bool activeLearningThrustDirection = (currentValue >= 0);  // only do learning mode for UP pitch
-
-        // holding pitch in ATM applies to descent hold as well
-        bool holdingPitchInAtm = (GetXR1().InAtm() && (axis == AXIS::PITCH));  // needed by COL adjustment code later; unlike the test below, this works for both positive and negative pitch
-
-        // do NOT apply learning mode if in AUTO DESCENT mode
-        if ((descentHoldActive == false) && GetXR1().InAtm() && activeLearningThrustDirection && (axis == AXIS::PITCH))  // only apply learning thrust in an atmosphere for positive pitch
-        {
-            // direction in which learning thrust is being applied; this will push AGAINST the air trying to rotate the ship
-            if (thLevel < 1.0)
-            {
-                const double timeAcc = oapiGetTimeAcceleration();
-                // NOTE: this is value #2 to tweak if you want to fine-tune time acc behavior and accuracy
-                // Typical deltaV when holding attitude during reentry is 0.2, which / 50 = 250 frames to "catch up" to attitude target, or 6.25 seconds @ 40 fps
-                learningThrustStep = deltaV / 50 / timeAcc;      // thrust step size per frame, modified for timeAcc
-                newLearningThrustFrac = m_pitchLearningData.m_thrustFrac;   // will be set to this value if jets actually fire
-
-                // No dead zone here!  If we end up firing the jets, we need accurate data no matter how small it is.
-                // Only apply learning thrust if we need to push in the right direction (against the air)
-                bool currentAngVelDirection = (targetAngVel >= angularVelocity);
-                if (activeLearningThrustDirection == currentAngVelDirection)
-                {
-                    // back out the last applied learning thrust delta if requested
-                    if (m_pitchLearningData.m_reverseLastLearningThrustStep)
-                    {
-                        newLearningThrustFrac -= m_pitchLearningData.m_lastLearningThrustStep;
-                        // NOTE: do not reset 'm_reverseLastLearningThrustStep' flag here; we must only reset it if the jets actually fire and latch our request!
-                    }
-
-                    // increase learning thrust
-                    newLearningThrustFrac += learningThrustStep;   // need more thrust to decrease ang velocity
-                    thLevel += newLearningThrustFrac;   // apply learning thrust
-                }
-                else    // too much thrust; reduce learning thrust, but do not apply to this frame since thrusters are firing in other direction!
-                {
-                    // NOTE: cannot simply set newLearningThrustFrac here because the jets might not fire this frame, and we cannot directly
-                    // update m_thrustFrac here because this 'else' block may be invoked multiple times before the positive jets fire again.  
-                    // Therefore, we simply queue up the change to be applied the next time the positive jets fire.
-                    m_pitchLearningData.m_reverseLastLearningThrustStep = true;
-                }
-
-                if (newLearningThrustFrac < 0)
-                    newLearningThrustFrac = 0;
-                else if (newLearningThrustFrac > 1.0)
-                    newLearningThrustFrac = 1.0;
-            }
-        }
-
-        bool positivePitchJetsFired = false;
-        bool negativePitchJetsFired = false;
-        // NOTE: angularVelocity may be negative here!
-        if (angularVelocity > (targetAngVel + angVelDeadZone))
-        {
-            GetVessel().SetThrusterGroupLevel(thgNegative, thLevel);
-            if (axis == AXIS::PITCH)
-                negativePitchJetsFired = true;   // remember this
-        }
-        else
-            GetVessel().SetThrusterGroupLevel(thgNegative, 0);
-
-        if (angularVelocity < (targetAngVel - angVelDeadZone))
-        {
-            GetVessel().SetThrusterGroupLevel(thgPositive, thLevel);
-            if (axis == AXIS::PITCH)
-                positivePitchJetsFired = true;   // remember this
-        }
-        else
-            GetVessel().SetThrusterGroupLevel(thgPositive, 0);
-
-        // update pitch learning data for next time IF we actually fired the jets to apply the target thrust
-        if (positivePitchJetsFired)
-        {
-            m_pitchLearningData.m_lastLearningThrustStep = learningThrustStep;  // save in case we need to reduce thrust next frame; i.e., back out this change
-            m_pitchLearningData.m_thrustFrac = newLearningThrustFrac;
-            m_pitchLearningData.m_reverseLastLearningThrustStep = false;  // reset flag since we know it was already processed above because the positive jets fired
-
-#if 0   // DEBUG ONLY
-            sprintf(oapiDebugString(), "angularVelocity=%f, targetAngVel=%f, deltaV=%f, deltaAngleDirection=%d, learningThrustFrac[pitch]=%f, learningThrustStep=%f",
-                angularVelocity, targetAngVel, deltaV, deltaAngleDirection, newLearningThrustFrac, learningThrustStep);
-#endif
-        }
+        // holding pitch in ATM applies to descent hold as well; unlike the learning thrust, this works for both positive and negative pitch
+        const bool holdingPitchInAtm = (GetXR1().InAtm() && (axis == AXIS::PITCH));
 
         // Adjust center-of-lift if we are holding pitch in an atmosphere and the jets fired at a level outside a dead zone.
         if (holdingPitchInAtm && (thLevel > AP_COL_DEAD_ZONE))
@@ -561,7 +453,7 @@ double AttitudeHoldPreStep::FireThrusterGroups(const double targetValue, const d
             // In addition, it is more realistic since the pumps can only shift fuel fore/aft as a given rate.
             const double thLevelStepFraction = min(1.0, (thLevel * AP_COL_THRUSTLEVEL_TO_SHIFTSTEP_RATIO));
             const double stepSize = COL_MAX_SHIFT_RATE * simdt * thLevelStepFraction;
-            retVal = (negativePitchJetsFired ? -stepSize : stepSize);
+            retVal = ((jetLevel < 0) ? -stepSize : stepSize);
 
             // NOTE: if the ship is inverted, we need to reverse the COG shift direction because elevator UP == NEGATIVE pitch instead of POSITIVE pitch
             if (isShipInverted)
@@ -571,7 +463,7 @@ double AttitudeHoldPreStep::FireThrusterGroups(const double targetValue, const d
 #if 0  // DEBUG ONLY 
         if (axis == PITCH)
         {
-            sprintf(oapiDebugString(), "thLevel=%lf, degreesDelta=%lf, angVel=%lf, targetAngVel=%lf, cogShiftRequested=%lf, isShipInverted=%d", thLevel, degreesDelta, angularVelocity, targetAngVel, retVal, isShipInverted);
+            sprintf(oapiDebugString(), "thLevel=%lf, degreesDelta=%lf, angVel=%lf, learningThrustFrac=%lf, cogShiftRequested=%lf, isShipInverted=%d", thLevel, (targetValue - currentValue), angularVelocity, m_pitchLearningData.m_thrustFrac, retVal, isShipInverted);
         }
 #endif
         //sprintf(oapiDebugString(), "pitch=%lf, roll=%lf, slip=%lf", GetVessel().GetPitch()*DEG, GetVessel().GetBank() * DEG, GetVessel().GetSlipAngle()*DEG);
@@ -582,16 +474,13 @@ double AttitudeHoldPreStep::FireThrusterGroups(const double targetValue, const d
 // angularVelocity = degrees/second; NOTE: MAY BE NEGATIVE!
 // reverseRotation = true to reverse rotation thrust (positive degreesDelta == positive angular velocity as well); e.g., for PITCH axis
 // pOutSetThrusterGroupsLevels = double[2] ptr to hold new thruster group values: [0] = thgPositive level, [1] = thgNegative level; may be null
-void AttitudeHoldPreStep::KillRotation(const double angularVelocity, const THGROUP_TYPE thgPositive, const THGROUP_TYPE thgNegative, const double simdt, const bool reverseRotation, double* const pOutSetThrusterGroupsLevels, const double masterThrustFrac)
+void AttitudeHoldPreStep::KillRotation(const double angularVelocity, const THGROUP_TYPE thgPositive, const THGROUP_TYPE thgNegative, const double simdt, const bool reverseRotation, const AXIS axis, double* const pOutSetThrusterGroupsLevels, const double masterThrustFrac)
 {
     const double angVelDeadZone = 0.05;       // in degrees/second
 
-    // always reduce thruster level as timestep size increases, even if in atmosphere
-    const double timeAccDivisor = max((simdt / 0.025), 1.0);     // min framerate for full-speed rotation (thruster levels) is 1/40-second (40 frames/sec)
-    double thLevel = masterThrustFrac / timeAccDivisor;
-
-    // reduce thrust level if we are close to our target velocity already
-    thLevel *= min(1.0, fabs(angularVelocity) / 3);
+    // reduce thrust level if we are close to our target velocity already; this also reduces it as timestep size increases, even if in atmosphere
+    const double maxAngularAcc = GetMaxAngularAcc(((angularVelocity > 0) ? thgNegative : thgPositive), axis);
+    const double thLevel = XR1AutopilotLaws::KillRotationThrustLevel(angularVelocity, masterThrustFrac, maxAngularAcc, simdt, GetAutopilotGains());
 
     // sprintf(oapiDebugString(), "angularVelocity=%f, thLevel=%f", angularVelocity, thLevel);
 
@@ -623,3 +512,37 @@ void AttitudeHoldPreStep::KillRotation(const double angularVelocity, const THGRO
         pOutSetThrusterGroupsLevels[1] = newNegativeThLevel;
     }
 }
+
+// Returns the angular acceleration in degrees/second^2 that the specified thruster group produces about the specified axis at full thrust,
+// or 0 if it cannot be determined.  This is recomputed on each call so that it tracks mass, fuel, and thruster damage changes.
+double AttitudeHoldPreStep::GetMaxAngularAcc(const THGROUP_TYPE thg, const AXIS axis) const
+{
+    VECTOR3 pmi;
+    GetVessel().GetPMI(pmi);    // principal moments of inertia, mass-normalized
+    double inertia;
+    switch (axis)
+    {
+    case AXIS::PITCH: inertia = pmi.x; break;
+    case AXIS::YAW:   inertia = pmi.y; break;
+    default:          inertia = pmi.z; break;   // roll
+    }
+    inertia *= GetVessel().GetMass();
+
+    if (inertia <= 0)
+        return 0;   // sanity check
+
+    // sum the torque from each thruster in the group
+    double torque = 0;
+    const DWORD thrusterCount = GetVessel().GetGroupThrusterCount(thg);
+    for (DWORD i = 0; i < thrusterCount; i++)
+    {
+        const THRUSTER_HANDLE th = GetVessel().GetGroupThruster(thg, i);
+        VECTOR3 pos, dir;
+        GetVessel().GetThrusterRef(th, pos);
+        GetVessel().GetThrusterDir(th, dir);
+        const VECTOR3 thrusterTorque = crossp(pos, dir * GetVessel().GetThrusterMax(th));
+        torque += ((axis == AXIS::PITCH) ? thrusterTorque.x : ((axis == AXIS::YAW) ? thrusterTorque.y : thrusterTorque.z));
+    }
+
+    return (fabs(torque) / inertia * DEG);
+}
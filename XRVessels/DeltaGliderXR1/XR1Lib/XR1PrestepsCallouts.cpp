@@ -253,11 +253,11 @@ void TakeoffAndLandingCalloutsAndCrashPreStep::clbkPrePostStep(const double simt
             // NOTE: check for HIGHEST speeds first!
             if ((airspeed >= vrCalloutVelocity) && (GetXR1().m_preStepPreviousAirspeed < vrCalloutVelocity))  // taking off; check Rotate
             {
-                GetXR1().PlaySound(GetXR1().Rotate, DeltaGliderXR1::ST_InformationCallout);
+                GetXR1().EnqueueCallout(GetXR1().Rotate, DeltaGliderXR1::ST_InformationCallout);
             }
             else if ((airspeed >= v1CalloutVelocity) && (GetXR1().m_preStepPreviousAirspeed < v1CalloutVelocity))  // taking off; check V1
             {
-                GetXR1().PlaySound(GetXR1().V1, DeltaGliderXR1::ST_InformationCallout);
+                GetXR1().EnqueueCallout(GetXR1().V1, DeltaGliderXR1::ST_InformationCallout);
             }
             else  // check 100 knots (both takoff and landing)
             {
@@ -265,7 +265,7 @@ void TakeoffAndLandingCalloutsAndCrashPreStep::clbkPrePostStep(const double simt
                 if (((airspeed >= mpsKnots) && (GetXR1().m_preStepPreviousAirspeed < mpsKnots)) ||
                     ((airspeed <= mpsKnots) && (GetXR1().m_preStepPreviousAirspeed > mpsKnots)))
                 {
-                    GetXR1().PlaySound(GetXR1().OneHundredKnots, DeltaGliderXR1::ST_InformationCallout);
+                    GetXR1().EnqueueCallout(GetXR1().OneHundredKnots, DeltaGliderXR1::ST_InformationCallout);
                 }
             }
         }
@@ -344,12 +344,12 @@ void GearCalloutsPreStep::clbkPrePostStep(const double simt, const double simdt,
             }
             else if (gearStatus == DoorStatus::DOOR_OPENING)
             {
-                GetXR1().PlaySound(GetXR1().GearDown, DeltaGliderXR1::ST_InformationCallout);
+                GetXR1().EnqueueCallout(GetXR1().GearDown, DeltaGliderXR1::ST_InformationCallout, DeltaGliderXR1::CG_Gear);
                 GetXR1().PlaySound(GetXR1().GearWhine, DeltaGliderXR1::ST_Other, GEAR_WHINE_VOL);
             }
             else
             {
-                GetXR1().PlaySound(GetXR1().GearUp, DeltaGliderXR1::ST_InformationCallout);
+                GetXR1().EnqueueCallout(GetXR1().GearUp, DeltaGliderXR1::ST_InformationCallout, DeltaGliderXR1::CG_Gear);
                 GetXR1().PlaySound(GetXR1().GearWhine, DeltaGliderXR1::ST_Other, GEAR_WHINE_VOL);
             }
         }
@@ -443,8 +443,7 @@ void MachCalloutsPreStep::PlayMach(const double simt, const char* pFilename)
 
     // allow normal ATC chatter to continue; mach callouts are not that important
     // also, we don't want this to actually fade, so we don't keep re-sending it
-    GetXR1().LoadXR1Sound(GetXR1().MachCallout, pFilename, XRSound::PlaybackType::Radio);
-    GetXR1().PlaySound(GetXR1().MachCallout, DeltaGliderXR1::ST_VelocityCallout);
+    GetXR1().EnqueueCallout(pFilename, DeltaGliderXR1::ST_VelocityCallout, DeltaGliderXR1::CG_Mach);
 }
 
 //---------------------------------------------------------------------------
@@ -524,8 +523,7 @@ void AltitudeCalloutsPreStep::PlayAltitude(const double simt, const char* pFilen
 {
     m_nextMinimumCalloutTime = simt + 1;    // reset timer
 
-    GetXR1().LoadXR1Sound(GetXR1().AltitudeCallout, pFilename, XRSound::PlaybackType::Radio);  // audible outside vessel as well
-    GetXR1().PlaySound(GetXR1().AltitudeCallout, DeltaGliderXR1::ST_AltitudeCallout);
+    GetXR1().EnqueueCallout(pFilename, DeltaGliderXR1::ST_AltitudeCallout, DeltaGliderXR1::CG_Altitude);
 }
 
 //---------------------------------------------------------------------------
@@ -583,7 +581,7 @@ void DockingCalloutsPreStep::clbkPrePostStep(const double simt, const double sim
     }
 
     // returns -1 if no docking target set
-    const double distance = GetDockingDistance();
+    const double distance = m_dockingTargets.GetDockingDistance(*this);   // distance in meters, or -1 if no port set
     if (distance < 0)
     {
         // no docking port in range, so reset intervals
@@ -670,17 +668,35 @@ void DockingCalloutsPreStep::PlayDistance(const double simt, const char* pFilena
 {
     m_nextMinimumCalloutTime = simt + 1;    // reset timer
 
-    // use altitude callout since we won't be docking in an atmosphere
-    GetXR1().LoadXR1Sound(GetXR1().AltitudeCallout, pFilename, XRSound::PlaybackType::Radio);  // audible outside vessel as well
-    GetXR1().PlaySound(GetXR1().AltitudeCallout, DeltaGliderXR1::ST_DockingDistanceCallout);
+    GetXR1().EnqueueCallout(pFilename, DeltaGliderXR1::ST_DockingDistanceCallout, DeltaGliderXR1::CG_DockingDistance);
 }
 
-// returns distance to target docking port in meters, or -1 if no port set
-double DockingCalloutsPreStep::GetDockingDistance()
+NAVHANDLE DockingCalloutsPreStep::GetNavSource(const int radio) const
 {
-    double distance = -1;  // assume no target
+    return GetVessel().GetNavSource(radio);
+}
+
+unsigned int DockingCalloutsPreStep::GetNavChannel(const int radio) const
+{
+    return GetVessel().GetNavRecv(radio);
+}
+
+OBJHANDLE DockingCalloutsPreStep::GetIDSVessel(const NAVHANDLE hNav) const
+{
+    NAVDATA navdata;
+    oapiGetNavData(hNav, &navdata);
+    return ((navdata.type == TRANSMITTER_IDS) ? navdata.ids.hVessel : nullptr);
+}
+
+VECTOR3 DockingCalloutsPreStep::GetNavPos(const NAVHANDLE hNav) const
+{
+    VECTOR3 pos;
+    oapiGetNavPos(hNav, &pos);
+    return pos;
+}
 
-    // obtain the global position of our docking port
+VECTOR3 DockingCalloutsPreStep::GetDockingPortPos() const
+{
     DOCKHANDLE hOurDock = GetVessel().GetDockHandle(0);
     VECTOR3 ourDockingPortLocalCoord;
     VECTOR3 temp;   // reused
@@ -688,74 +704,20 @@ double DockingCalloutsPreStep::GetDockingDistance()
 
     VECTOR3 ourPos;
     GetVessel().Local2Global(ourDockingPortLocalCoord, ourPos);
+    return ourPos;
+}
 
+bool DockingCalloutsPreStep::HasPayloadBay() const
+{
+    return (GetXR1().m_pPayloadBay != nullptr);
+}
 
-    // NOTE: as of the XR1 1.9 release group, we no longer track XPDR for docking distance: this should fix
-    // the spurrious "Nosecone is closed" warnings when using Universal Cargo Deck and vessels attached that 
-    // default to the 108 MHz radio xpdr frequency and the XR also has a radio tuned to that default frequency.
-
-    // NOTE: Orbiter does not provide a way for us to determine which NAV radio is marked "active" by the radio MFD,
-    // so we have to just make a "best guess" by walking through all four of our nav radios and choosing a frequency
-    // based on two criteria: 1) the closest TRANSMITTER_IDS in range, or 2) the closest TRANSMITTER_XPDR in range.
-    double closestIDS = -1;      // out-of-range
-    //double closestXPDR = -1;     // out-of-range
-
-    // find the closest TRANSMITTER_IDS and TRANSMITTER_XPDR values
-    for (int i = 0; i < 4; i++)
-    {
-        NAVHANDLE hNav = GetVessel().GetNavSource(i);
-        if (hNav != nullptr)  // tuned and in range?
-        {
-            NAVDATA navdata;
-            oapiGetNavData(hNav, &navdata);
-            if ((navdata.type == TRANSMITTER_IDS) || (navdata.type == TRANSMITTER_XPDR))
-            {
-                // obtain target position (will either be the vessel itself (XPDR) or the docking port (IDS)
-                VECTOR3 targetPos;
-                oapiGetNavPos(hNav, &targetPos);
-
-                // compute the distance between our docking port and the IDS or XPDR target
-                VECTOR3 dp = ourPos - targetPos;       // delta position
-                distance = sqrt((dp.x * dp.x) + (dp.y * dp.y) + (dp.z * dp.z));
-
-                if (navdata.type == TRANSMITTER_IDS)
-                {
-                    // verify that the vessel is NOT attached in our cargo bay
-                    if ((GetXR1().m_pPayloadBay != nullptr) && !(GetXR1().m_pPayloadBay->IsChildVesselAttached(navdata.ids.hVessel)))
-                    {
-                        if ((closestIDS == -1) || (distance < closestIDS))
-                        {
-                            closestIDS = distance;     // best IDS match so far
-                        }
-                    }
-                }
-                /*                else    // XPDR
-                                {
-                                    // verify that the vessel is NOT attached in our cargo bay
-                                    if ((GetXR1().m_pPayloadBay != nullptr) && !(GetXR1().m_pPayloadBay->IsChildVesselAttached(navdata.xpdr.hVessel)))
-                                    {
-                                        if ((closestXPDR == -1) || (distance < closestXPDR))
-                                        {
-                                            closestXPDR = distance;     // best XPDR match so far
-                                        }
-                                    }
-                                }
-                */
-            }
-        }
-    }
+unsigned int DockingCalloutsPreStep::GetPayloadAttachmentVersion() const
+{
+    return GetXR1().m_pPayloadBay->GetAttachmentVersion();
+}
 
-    // if any IDS found in range, use the closest one; otherwise, use the closest XPDR 
-    if (closestIDS != -1)
-    {
-        distance = closestIDS;
-        // sprintf(oapiDebugString(), "Docking distance [IDS] = %f", distance);
-    }
-    /*    else if (closestXPDR != -1)
-        {
-            distance = closestXPDR;
-            // sprintf(oapiDebugString(), "Docking distance [XPDR] = %f", distance);
-        }
-    */
-    return distance;
+bool DockingCalloutsPreStep::IsChildVesselAttached(const OBJHANDLE hVessel) const
+{
+    return GetXR1().m_pPayloadBay->IsChildVesselAttached(hVessel);
 }
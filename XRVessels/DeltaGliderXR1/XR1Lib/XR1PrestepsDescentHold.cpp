@@ -249,55 +249,20 @@ void DescentHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
 
         // determine what rate of change (acc) we need in order to hit our target rate in a reasonable timeframe
         // A targetAcc of zero will hold the current descent rate; i.e., the ship will not be accelerated vertically
-        double rateDelta = targetRate - currentDescentRate;     // in m/s; may be positive or negative
-
-        // try to arrive at rate quickly (for accuracy) but in a reasonable time period so we don't overdrive the engines and oscillate
-        // NOTE: this is the primary value to tune accuracy vs. oscillation
-        // if not auto-landing, smooth out targetAcc
-        const double absRateDelta = fabs(rateDelta);
-        double targetAcc;
-
-        // targetAcc will be rateDelta * (n >= 2.0) 
-        // e.g., if rate = 10, mult = 2.0  (1/2-second)
-        //       if rate = 20, mult = 4.0  (1/4-second)
-        //       if rate = 100, mult = 20.0  (1/20-second)  : [this will certainly induce maximum thrust]
-        double rateDeltaMultiplier = max(2.0, (absRateDelta / 5));  // n >= 2.0 (no upper limit)
-
-        // must be more aggressive when auto-land engaged
-        if (GetXR1().m_autoLand)
-        {
-            // there is no upper limit here; this is by design
-            // TOO AGGRESSIVE: rateDeltaMultiplier *= 5;   // 5 * 2.0 = 10 = minimum multiplier set to reach target acc in 1/10th-second to keep auto-land accurate
-            // This can *almost* land at 100x now (it lands at 80x successfully); at 100x it sometimes can't quite touch down, but in any case it doesn't crash the ship!
-            rateDeltaMultiplier *= 2;   // 2 * 2.0 = 4 = minimum multiplier set to reach target acc in 0.25-second to keep auto-land accurate
-        }
-
-        // NOTE: (1 / rateDeltaMultiplier) = fraction of second to reach target acc; e.g., 5 = 1/5th-second
-        targetAcc = (rateDelta * rateDeltaMultiplier); // target acc range is rateDelta * (n >= 2) m/s/s
-
-        // DEBUG: sprintf(oapiDebugString(), "targetAcc=%f, rateDeltaMultiplier=%f, rateDelta=%f", targetAcc, rateDeltaMultiplier, rateDelta);
-
-        // Determine effective acc required to maintain the requested acc (m/s/s); this takes gravity, drag, and our mass into account
-        const double effectiveTargetAcc = -planetAcc + targetAcc;  // planet's pull (including atm drag and lift) + target rate
-
-        // determine thrust required to maintain the requested rate of acc (m/s/s)
-        double targetThrustRequired = effectiveTargetAcc * mass;   // in kN
+        const double rateDelta = targetRate - currentDescentRate;     // in m/s; may be positive or negative
 
-        // set hover thrust level required to hold requested acc
-        const double requiredThLevel = targetThrustRequired / maxHoverThrust;
-        double thLevel = requiredThLevel;
-        if (thLevel < 0)
-            thLevel = 0;
-        else if (thLevel > 1.0)
-            thLevel = 1;
+        // Try to arrive at rate quickly (for accuracy) but in a reasonable time period so we don't overdrive the engines and oscillate.
+        // The hover thrust level takes gravity, drag, and our mass into account along with how fast gravity and drag changed since the
+        // previous frame, and runs the control law every 20 ms over the timestep so that the engines close on the target rate the same
+        // way at any time acceleration.
+        const double planetAccRate = m_planetAccTrend.Update(simt, simdt, planetAcc);
+        const double thLevel = XR1AutopilotLaws::DescentHoldThrustLevel(rateDelta, planetAcc, planetAccRate, (maxHoverThrust / mass), GetXR1().m_autoLand, simdt, GetAutopilotGains());
 
-        const double thrustPerHoverEngine = targetThrustRequired / 2;
         for (int i = 0; i < 2; i++)
             GetVessel().SetThrusterLevel(GetXR1().th_hover[i], thLevel);
 
         /* DEBUG
-        sprintf(oapiDebugString(), "rateDelta=%f, targetAcc=%f, VAcc=%f, effectiveTargetAcc=%f, targetThrustRequired=%f kN, targetHoverThrottle=%lf",
-            rateDelta, targetAcc, acc, effectiveTargetAcc, (targetThrustRequired / 1000), thLevel);
+        sprintf(oapiDebugString(), "rateDelta=%f, planetAcc=%f, VAcc=%f, targetHoverThrottle=%lf", rateDelta, planetAcc, acc, thLevel);
         */
     }
     else    // DESCENT HOLD not engaged -- kill the thrusters if the pilot just turned off the autopilot
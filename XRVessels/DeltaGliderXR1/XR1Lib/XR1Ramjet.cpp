@@ -28,103 +28,161 @@
 // ==============================================================
 
 #include "XR1Ramjet.h"
+#ifndef XR1RAMJET_VESSEL_HEADER
 #include "DeltaGliderXR1.h"
+#endif
 #include "stdio.h"  
+#include <cassert>
+#include <array>
 
 // constructor
 XR1Ramjet::XR1Ramjet (DeltaGliderXR1 *_vessel): 
-    vessel(_vessel)
+    m_usePressureRecoveryTable(false), vessel(_vessel)
 {
 	nthdef = 0;    // no thrusters associated yet
 
     for (int i=0; i < 2; i++)   // enable engines @ 100%
         m_integrity[i] = 1.0;
+
+    m_atmConstants = AtmConstants();   // nothing cached yet: hBody == nullptr and isValid == false, which is also the correct state for no atmosphere
 }
 
 // destructor
 XR1Ramjet::~XR1Ramjet ()
 {
-	if (nthdef) 
-    {  
-        // delete list of thruster definitions
-		for (unsigned int i = 0; i < nthdef; i++)
-			delete thdef[i];
-		delete []thdef;
-	}
 }
 
 // add new thruster definition to list
 void XR1Ramjet::AddThrusterDefinition (THRUSTER_HANDLE th,
 	double Qr, double Ai, double Tb_max, double dmf_max)
 {
-	THDEF *thd   = new THDEF;
-	thd->th      = th;
-	thd->Qr      = Qr;
-	thd->Ai      = Ai;
-	thd->Tb_max  = Tb_max;
-	thd->dmf_max = dmf_max;
-	thd->dmf     = 0.0;
-	thd->F       = 0.0;
-	for (int i = 0; i < 3; i++) thd->T[i] = 0.0;
-
-	THDEF **tmp = new THDEF*[nthdef+1];
-	if (nthdef) {
-		memcpy (tmp, thdef, nthdef * sizeof(THDEF*));
-		delete []thdef;
-	}
-	thdef = tmp;
-	thdef[nthdef++] = thd;
+    assert(nthdef < MAX_THRUSTERS);
+    if (nthdef >= MAX_THRUSTERS)
+        return;     // should never happen
+
+    const unsigned int i = nthdef++;
+	m_th[i]     = th;
+	m_Qr[i]     = Qr;
+	m_Ai[i]     = Ai;
+	m_TbMax[i]  = Tb_max;
+	m_dmfMax[i] = dmf_max;
+	m_dmf[i]    = 0.0;
+	m_F[i]      = 0.0;
+    m_pd[i]     = 0.0;
+	for (int t = 0; t < 3; t++) m_T[t][i] = 0.0;
+}
+
+// Returns the constants derived from the current atmosphere reference body's ATMCONST.
+// The atmosphere reference only changes when the vessel moves into a different body's sphere of influence, so
+// oapiGetPlanetAtmConstants and the gamma divisions are normally not repeated from frame to frame.
+const XR1Ramjet::AtmConstants &XR1Ramjet::GetAtmConstants() const
+{
+    const OBJHANDLE hBody = vessel->GetAtmRef();
+    if (hBody != m_atmConstants.hBody)
+    {
+        AtmConstants &c = m_atmConstants;
+        c.hBody = hBody;
+        const ATMCONST *atm = (hBody ? oapiGetPlanetAtmConstants(hBody) : nullptr);
+        c.isValid = (atm != nullptr);
+        if (atm)
+        {
+            const double gamma = atm->gamma;
+            c.gammaR = gamma * atm->R;
+            c.cp = c.gammaR / (gamma - 1.0);
+            c.halfGammaM1 = 0.5 * (gamma - 1.0);
+            c.pdExponent = gamma / (gamma - 1.0);
+            c.teExponent = (gamma - 1.0) / gamma;
+        }
+    }
+    return m_atmConstants;
+}
+
+// pressure recovery factor for the given Mach number (0...1)
+double XR1Ramjet::ComputePressureRecovery(const double mach)
+{
+    // {DEB} modified this for high-altitude flight: new limit is mach 17 (doubled)
+    // ORG: precov = max (0.0, 1.0 - (0.075*pow(max(M,1.0)-1.0, 1.35)) ); // pressure recovery
+    return max(0.0, 1.0 - (0.075*pow(max(mach, 1.0) - 1.0, SCRAM_PRESSURE_RECOVERY_MULT))); // pressure recovery : good for Mach 17 now
+}
+
+// Same as ComputePressureRecovery, but reads from a lookup table when enabled.
+// The curve's slope is unbounded as Mach approaches 1 (the exponent is < 1), so that region and anything past the end of the table use the exact formula.
+double XR1Ramjet::GetPressureRecovery(const double mach) const
+{
+    const int STEPS_PER_MACH = 64;
+    const int TABLE_SIZE = 31 * STEPS_PER_MACH + 1;     // covers Mach 1 - 32; recovery reaches zero before Mach 17
+    const double TABLE_START = 0.25;                    // Mach - 1 at which the table takes over from the exact formula
+
+    const double x = mach - 1.0;
+    if ((!m_usePressureRecoveryTable) || (x < TABLE_START))
+        return ComputePressureRecovery(mach);
+
+    // built on first use; function-local static initialization is thread-safe, so standalone tools may call this from several threads
+    static const array<float, TABLE_SIZE> s_table = []
+    {
+        array<float, TABLE_SIZE> table;
+        for (int i = 0; i < TABLE_SIZE; i++)
+            table[i] = static_cast<float>(1.0 - (0.075*pow(static_cast<double>(i) / STEPS_PER_MACH, SCRAM_PRESSURE_RECOVERY_MULT)));  // unclamped so the zero crossing interpolates cleanly
+        return table;
+    }();
+
+    const double pos = x * STEPS_PER_MACH;
+    const int index = static_cast<int>(pos);
+    if (index >= TABLE_SIZE - 1)
+        return ComputePressureRecovery(mach);
+
+    const double frac = pos - index;
+    return max(0.0, s_table[index] + (s_table[index + 1] - s_table[index]) * frac);
 }
 
 // calculate current thrust force for all engines
 void XR1Ramjet::Thrust (double *F) const
 {
-	const OBJHANDLE hBody = vessel->GetAtmRef();
-	const ATMCONST *atm = (hBody ? oapiGetPlanetAtmConstants (hBody) : 0);
+    const AtmConstants &atm = GetAtmConstants();
 
-	if (atm)   // atmospheric parameters available
+	if (atm.isValid)   // atmospheric parameters available
     { 
-		double M, Fs, T0, Td, Tb, Tb0, Te, p0, pd, D, rho, cp, v0, ve, tr, lvl, dma, dmf, precov, dmafac;
+		double M, Fs, T0, Td, Tb, Tb0, Te, p0, pd, D, cp, v0, ve, tr, lvl, dma, dmf, precov, dmafac, teFactor;
 		// ORG: const double dma_scale = 2.7e-4;
         const double dma_scale = SCRAM_DMA_SCALE;  // {DEB} tweaked for mach 17 (value is 1/2 original)
 
 		M   = vessel->GetMachNumber();                     // Mach number
 		T0  = vessel->GetExternalTemperature();                        // freestream temperature
 		p0  = vessel->GetAtmPressure();                    // freestream pressure
-		rho = vessel->GetAtmDensity();                     // freestream density
-		cp  = atm->gamma * atm->R / (atm->gamma-1.0);      // specific heat (pressure)
-		v0  = M * sqrt (atm->gamma * atm->R * T0);         // freestream velocity
-		tr  = (1.0 + 0.5*(atm->gamma-1.0) * M*M);          // temperature ratio
+		cp  = atm.cp;                                      // specific heat (pressure)
+		v0  = M * sqrt (atm.gammaR * T0);                  // freestream velocity
+		tr  = (1.0 + atm.halfGammaM1 * M*M);               // temperature ratio
 		Td  = T0 * tr;                                     // diffuser temperature
-		pd  = p0 * pow (Td/T0, atm->gamma/(atm->gamma-1.0)) * GetXR1().scramdoor_proc; // diffuser pressure; will be ZERO if SCRAM doors closed
+		pd  = p0 * pow (tr, atm.pdExponent) * GetXR1().scramdoor_proc; // diffuser pressure; will be ZERO if SCRAM doors closed
 
-        // {DEB} modified this for high-altitude flight: new limit is mach 17 (doubled)
-		// ORG: precov = max (0.0, 1.0 - (0.075*pow(max(M,1.0)-1.0, 1.35)) ); // pressure recovery
-        precov = max (0.0, 1.0 - (0.075*pow(max(M,1.0)-1.0, SCRAM_PRESSURE_RECOVERY_MULT)) ); // pressure recovery : good for Mach 17 now
+        precov = GetPressureRecovery(M);
 
         // NOTE: if the SCRAM doors are not fully open the throttle will be closed already, so no need to check the doors here
 
         dmafac = dma_scale*precov*pd;   // will be ZERO if SCRAM doors closed
 
+        // exhaust-to-burner temperature ratio; the same for all engines
+        teFactor = ((pd > 0) ? pow (p0/pd, atm.teExponent) : 0);
+
         // DEBUG: sprintf(oapiDebugString(), "Td=%lf, precov=%lf, dmafac=%lf, pd=%lf" , Td, precov, dmafac, pd);
 
 		for (unsigned int i = 0; i < nthdef; i++) 
         {
-			Tb0 = thdef[i]->Tb_max;                        // max burner temperature
+			Tb0 = m_TbMax[i];                              // max burner temperature
 
-            lvl  = vessel->GetThrusterLevel(thdef[i]->th); // throttle level
+            lvl  = vessel->GetThrusterLevel(m_th[i]);      // throttle level
 
             // NOTE: engine temp is checked in DMG file
 
             if ((pd > 0) & (Tb0 > Td))    // any diffuser pressure AND are we within operational range?
             {                                
-				D    = (Tb0-Td) / (thdef[i]->Qr/cp - Tb0); // max fuel-to-air ratio (what if negative?)
-                //dma  = rho * v0 * thdef[i]->Ai;          // air mass flow rate (DEB: Martin commented this out)
-                dma = dmafac * thdef[i]->Ai;               // air mass flow rate [kg/s]
+				D    = (Tb0-Td) / (m_Qr[i]/cp - Tb0);      // max fuel-to-air ratio (what if negative?)
+                //dma  = rho * v0 * m_Ai[i];               // air mass flow rate (DEB: Martin commented this out)
+                dma = dmafac * m_Ai[i];                    // air mass flow rate [kg/s]
 
                 // {DEB} reduce effective level based on dmf_max limit
                 // FORMULA: throttleFrac = D * dma / max_dmf, where x = throttle fraction limit (0...n)
-                double throttleFrac = D * dma / thdef[i]->dmf_max;
+                double throttleFrac = D * dma / m_dmfMax[i];
                 
                 // if throttleFrac > 1.0, it means that we need to reduce the throttle sensitivity by that fraction; i.e., reduce the effective throttle setting
                 if (throttleFrac > 1.0)
@@ -133,15 +191,15 @@ void XR1Ramjet::Thrust (double *F) const
 				D   *= lvl;                                // actual fuel-to-air ratio
 				dmf  = D * dma;                            // fuel mass flow rate
                 
-                // debug: if (i == 0) sprintf(oapiDebugString(), "throttleFrac=%lf, D=%lf, dma=%lf, dmf=%lf, dmf_max=%lf", throttleFrac, D, dma, dmf, thdef[i]->dmf_max);
+                // debug: if (i == 0) sprintf(oapiDebugString(), "throttleFrac=%lf, D=%lf, dma=%lf, dmf=%lf, dmf_max=%lf", throttleFrac, D, dma, dmf, m_dmfMax[i]);
 
-				if (dmf > thdef[i]->dmf_max)               // max fuel rate exceeded
+				if (dmf > m_dmfMax[i])                     // max fuel rate exceeded
                 {             
-					dmf = thdef[i]->dmf_max;
+					dmf = m_dmfMax[i];
 					D = dmf/dma;
 				}
-				Tb   = (D*thdef[i]->Qr/cp + Td) / (1.0+D); // actual burner temperature
-				Te   = Tb * pow (p0/pd, (atm->gamma-1.0)/atm->gamma); // exhaust temperature
+				Tb   = (D*m_Qr[i]/cp + Td) / (1.0+D);      // actual burner temperature
+				Te   = Tb * teFactor;                      // exhaust temperature
                 
                 // bugfix: if exhaust temperature > burner temperature, we cannot continue
                 if (Te > Tb)
@@ -157,39 +215,38 @@ void XR1Ramjet::Thrust (double *F) const
 				ve   = sqrt (2.0*cp*(Tb-Te));              // exhaust velocity
 			    Fs  = (1.0+D)*ve - v0;                     // specific thrust
 
-				thdef[i]->F = F[i] = max(0.0, Fs*dma * m_integrity[i]);    // thrust force * integrity fraction (0...1)
+				m_F[i] = F[i] = max(0.0, Fs*dma * m_integrity[i]);    // thrust force * integrity fraction (0...1)
 
                 // NEW CHECK: if no thrust, fuel flow is also zero
-                if (thdef[i]->F == 0.0)
+                if (m_F[i] == 0.0)
                     dmf = 0;    // no flow
 
-				thdef[i]->dmf = dmf;
-				thdef[i]->T[1] = Tb;
-				thdef[i]->T[2] = Te;
+				m_dmf[i] = dmf;
+				m_T[1][i] = Tb;
+				m_T[2][i] = Te;
 
 			} 
             else   // overheating or SCRAM doors are closed!
             {                                       
 engines_off:
-				thdef[i]->F = F[i] = 0.0;
-				thdef[i]->dmf = 0.0;
-				thdef[i]->T[1] = thdef[i]->T[2] = Td;
+				m_F[i] = F[i] = 0.0;
+				m_dmf[i] = 0.0;
+				m_T[1][i] = m_T[2][i] = Td;
 
 			}
-			thdef[i]->T[0] = Td;    // save diffuser temperature; may be very high, but we message the internal temp here for heat and display checks in the "Temp" method below
-            thdef[i]->pd = pd;      // save diffuser pressure; will be ZERO if doors closed or out of atmosphere
+			m_T[0][i] = Td;    // save diffuser temperature; may be very high, but we message the internal temp here for heat and display checks in the "Temp" method below
+            m_pd[i] = pd;      // save diffuser pressure; will be ZERO if doors closed or out of atmosphere
 		}
 	} 
     else  // no atmospheric parameters or engines disabled
     {   
+        const double extTemp = vessel->GetExternalTemperature();
 		for (unsigned int i = 0; i < nthdef; i++)
         {
-            thdef[i]->dmf = 0.0;
-			thdef[i]->F = F[i] = 0.0;
-            thdef[i]->T[0] = vessel->GetExternalTemperature();  // set to external temperature
-            thdef[i]->T[1] = vessel->GetExternalTemperature();  // set to external temperature
-            thdef[i]->T[0] = vessel->GetExternalTemperature();  // set to external temperature
-            thdef[i]->pd = 0;       // zero pressure
+            m_dmf[i] = 0.0;
+			m_F[i] = F[i] = 0.0;
+            m_T[0][i] = m_T[1][i] = m_T[2][i] = extTemp;  // set to external temperature
+            m_pd[i] = 0;       // zero pressure
 		}
 	}
 }
@@ -197,7 +254,7 @@ engines_off:
 double XR1Ramjet::TSFC (unsigned int idx) const
 {
 	const double eps = 1e-5;
-	return thdef[idx]->dmf/(thdef[idx]->F+eps);
+	return m_dmf[idx]/(m_F[idx]+eps);
 }
 
 // returns "visual" temperature used for display purposes and for heat checks
@@ -213,7 +270,7 @@ double XR1Ramjet::Temp(unsigned int idx, unsigned int which) const
     if (vessel->scramdoor_status == DoorStatus::DOOR_CLOSED)
         return freestreamTemp;
 
-    double t = thdef[idx]->T[which] / SCRAM_COOLING; // adjusted for the XR1
+    double t = m_T[which][idx] / SCRAM_COOLING; // adjusted for the XR1
 
     // Modify visual diffuser temperature based on diffuser pressure; this allows the temperature to rise gradually as the ship reenters the atmosphere,
     // giving the pilot time to close the SCRAM doors.
@@ -225,11 +282,11 @@ double XR1Ramjet::Temp(unsigned int idx, unsigned int which) const
     }
 
     // NOTE: OK if pd is zero (or even negative, although that should never happen) 
-    const double tdFrac = thdef[idx]->pd / (76923 * mach);  // once diffuser pressure reaches 2.0 million @ mach 26, temperature reaches full
+    const double tdFrac = m_pd[idx] / (76923 * mach);  // once diffuser pressure reaches 2.0 million @ mach 26, temperature reaches full
     if (tdFrac < 1.0)
         t *= tdFrac;   // reduce temperature
     
-    // DEBUG: sprintf(oapiDebugString(), "Td=%lf, tdFrac=%lf, pd=%lf, mach=%lf" , t, tdFrac, thdef[idx]->pd, mach);
+    // DEBUG: sprintf(oapiDebugString(), "Td=%lf, tdFrac=%lf, pd=%lf, mach=%lf" , t, tdFrac, m_pd[idx], mach);
 
     // if t < freestream temp, return the freestream temp
     if (t < freestreamTemp)
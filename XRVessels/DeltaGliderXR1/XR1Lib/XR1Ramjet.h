@@ -39,7 +39,12 @@
 
 #include "Orbitersdk.h"
 
+#ifdef XR1RAMJET_VESSEL_HEADER
+// standalone build (e.g., the ScramEnvelope tool): this header supplies DeltaGliderXR1, DoorStatus, and the SCRAM_* globals
+#include XR1RAMJET_VESSEL_HEADER
+#else
 #include "XR1Globals.h"
+#endif
 
 class DeltaGliderXR1;
 
@@ -78,7 +83,7 @@ public:
 	void Thrust (double *F) const;
 
 	// returns current fuel mass flow of thruster idx
-	inline double DMF (unsigned int idx) const { return thdef[idx]->dmf; }
+	inline double DMF (unsigned int idx) const { return m_dmf[idx]; }
 
 	// returns diffuser, combustion or exhaust temperature [K] of thruster idx
 	// {DEB} these are ADJUSTED temperatures for the XR1
@@ -93,36 +98,66 @@ public:
     // Also, we are getting some weirdness here where F is sometimes -0.0000...  Therefore we, check for that here.
     double GetMostRecentThrust(int index) const 
     { 
-        double retVal = thdef[index]->F;
+        double retVal = m_F[index];
         if (retVal <= 0.0) 
             retVal = 0;
 
         return retVal;
     }
 
-    // made public for the XR1
-    struct THDEF        // list of XR1Ramjet thrusters
-    {             
-		THRUSTER_HANDLE th;    //   thruster handle                -+
-		double Qr;             //   fuel heating parameter [J/kg]   | static
-		double Ai;             //   air intake cross section [m^2]  | parameters
-		double Tb_max;         //   max. burner temperature [K]     |
-		double dmf_max;        //   max. fuel flow rate [kg/s]     -+
-
-		double dmf;            //   current fuel mass rate [kg/s]  -+ dynamic
-		double F;              //   current thrust [N]              | parameters
-		double T[3];           //   temperatures                   -+ 0=diffuser, 1=burner, 2=exhaust
-        double pd;             //   diffuser pressure
-	} **thdef;
+    // raw thrust from the most recent Thrust call, without the -0.0 cleanup above
+    double GetThrust(int index) const { return m_F[index]; }
+
+    THRUSTER_HANDLE GetThrusterHandle(int index) const { return m_th[index]; }
+
 	unsigned int nthdef;               // number of XR1Ramjet thrusters
 
     // disable/enable an engine
     void SetEngineIntegrity(int engine, double integ) { m_integrity[engine] = integ; }
     double GetEngineIntegrity(int engine) const { return m_integrity[engine]; }
 
+    // The pressure recovery term depends only on Mach number, so it can optionally be read from a lookup table
+    // (accurate to within 3e-6) instead of calling pow() every frame.  Off by default: the exact formula is used.
+    void SetPressureRecoveryTableEnabled(const bool enabled) { m_usePressureRecoveryTable = enabled; }
+    static double ComputePressureRecovery(const double mach);   // exact formula
+
 protected:
     DeltaGliderXR1 &GetXR1() const { return *vessel; }
 
+    double GetPressureRecovery(const double mach) const;
+
+    // Constants derived from the current atmosphere's ATMCONST; refreshed only when the vessel's atmosphere reference body changes.
+    struct AtmConstants
+    {
+        OBJHANDLE hBody;        // body these constants were derived from; nullptr = none cached yet
+        bool   isValid;         // false if hBody has no atmosphere
+        double gammaR;          // gamma * R
+        double cp;              // specific heat (pressure)
+        double halfGammaM1;     // 0.5 * (gamma - 1)
+        double pdExponent;      // gamma / (gamma - 1)
+        double teExponent;      // (gamma - 1) / gamma
+    };
+    const AtmConstants &GetAtmConstants() const;
+
+    // Thruster definitions in structure-of-arrays form; XR vessels have at most two SCRAM engines.
+    static const int MAX_THRUSTERS = 2;
+
+    // static parameters
+    THRUSTER_HANDLE m_th[MAX_THRUSTERS];   // thruster handle
+    double m_Qr[MAX_THRUSTERS];            // fuel heating parameter [J/kg]
+    double m_Ai[MAX_THRUSTERS];            // air intake cross section [m^2]
+    double m_TbMax[MAX_THRUSTERS];         // max. burner temperature [K]
+    double m_dmfMax[MAX_THRUSTERS];        // max. fuel flow rate [kg/s]
+
+    // dynamic parameters; updated by Thrust
+    mutable double m_dmf[MAX_THRUSTERS];   // current fuel mass rate [kg/s]
+    mutable double m_F[MAX_THRUSTERS];     // current thrust [N]
+    mutable double m_T[3][MAX_THRUSTERS];  // temperatures: 0=diffuser, 1=burner, 2=exhaust
+    mutable double m_pd[MAX_THRUSTERS];    // diffuser pressure
+
+    mutable AtmConstants m_atmConstants;
+    bool m_usePressureRecoveryTable;
+
 private:
 	DeltaGliderXR1 *vessel;        // vessel pointer
     double m_integrity[2];         // 0...1
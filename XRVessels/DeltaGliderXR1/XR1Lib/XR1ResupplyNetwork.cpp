@@ -0,0 +1,358 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1ResupplyNetwork.cpp
+// Flow network for ResupplyPostStep; see XR1ResupplyNetwork.h.
+// ==============================================================
+
+#include "XR1ResupplyNetwork.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+// flows smaller than this are rounding noise from the pressure solution, in kg/second
+static const double MIN_FLOW_RATE = 1e-9;
+
+int XR1ResupplyNetwork::AddTank(const double capacity, const double pressure)
+{
+    assert(m_tankCount < MAX_TANKS);
+    m_tanks[m_tankCount] = { 0, capacity, pressure };
+    m_tankRate[m_tankCount] = 0;
+    return m_tankCount++;
+}
+
+int XR1ResupplyNetwork::AddLine(const int toTank, const double resistance)
+{
+    assert(m_lineCount < MAX_LINES);
+    assert((toTank >= 0) && (toTank < m_tankCount));
+    m_lines[m_lineCount] = { toTank, resistance, 0, false };
+    m_lineFlow[m_lineCount] = m_lineRate[m_lineCount] = 0;
+    return m_lineCount++;
+}
+
+int XR1ResupplyNetwork::AddLink(const int fromTank, const int toTank, const double resistance)
+{
+    assert(m_linkCount < MAX_LINKS);
+    assert((fromTank >= 0) && (fromTank < m_tankCount) && (toTank >= 0) && (toTank < m_tankCount) && (fromTank != toTank));
+    m_links[m_linkCount] = { fromTank, toTank, resistance, false };
+    return m_linkCount++;
+}
+
+void XR1ResupplyNetwork::Solve(const double deltaT)
+{
+    for (int i = 0; i < m_lineCount; i++)
+        m_lineFlow[i] = 0;
+
+    // Flows are constant until a tank fills, so advance from one fill to the next; each pass fills at least one tank,
+    // so this ends after at most m_tankCount + 1 passes.  The last pass leaves the rates set for the final masses.
+    double remaining = deltaT;
+    for (;;)
+    {
+        ComputeRates();
+        if (remaining <= 0)
+            break;
+
+        double stepTime = remaining;
+        int fillingTank = -1;
+        for (int i = 0; i < m_tankCount; i++)
+        {
+            if (!IsFull(i) && (m_tankRate[i] > 0))
+            {
+                const double fillTime = (m_tanks[i].Capacity - m_tanks[i].Mass) / m_tankRate[i];
+                if (fillTime < stepTime)
+                {
+                    stepTime = fillTime;
+                    fillingTank = i;
+                }
+            }
+        }
+
+        for (int i = 0; i < m_tankCount; i++)
+        {
+            if (m_tankRate[i] > 0)
+            {
+                // set a tank that fills on this pass to exactly full so that rounding cannot leave it a hair short
+                Tank &tank = m_tanks[i];
+                tank.Mass += m_tankRate[i] * stepTime;
+                if ((i == fillingTank) || (tank.Mass > tank.Capacity))
+                    tank.Mass = tank.Capacity;
+            }
+        }
+
+        for (int i = 0; i < m_lineCount; i++)
+            m_lineFlow[i] += m_lineRate[i] * stepTime;
+
+        remaining = ((fillingTank >= 0) ? (remaining - stepTime) : 0);
+    }
+}
+
+void XR1ResupplyNetwork::ComputeRates()
+{
+    // The unknowns are the pressures of the full tanks; every other tank is at its ullage pressure.
+    int unknown[MAX_TANKS];     // row in the system for each full tank, or -1
+    int unknownCount = 0;
+    double pressure[MAX_TANKS];
+    for (int i = 0; i < m_tankCount; i++)
+    {
+        unknown[i] = (IsFull(i) ? unknownCount++ : -1);
+        pressure[i] = m_tanks[i].Pressure;
+    }
+
+    // Edges are the lines followed by the links.  A link only flows out of a full tank, and nothing flows into a tank
+    // with no capacity.
+    const int edgeCount = m_lineCount + m_linkCount;
+    bool active[MAX_LINES + MAX_LINKS];
+    for (int i = 0; i < m_lineCount; i++)
+        active[i] = m_lines[i].Open;
+    for (int i = 0; i < m_linkCount; i++)
+    {
+        const Link &link = m_links[i];
+        active[m_lineCount + i] = (link.Open && IsFull(link.FromTank) && (m_tanks[link.ToTank].Capacity > 0));
+    }
+
+    double flow[MAX_LINES + MAX_LINKS];
+
+    // Lines and links never flow backward: any edge that would is closed and the pressures solved again.
+    for (int pass = 0; pass <= edgeCount; pass++)
+    {
+        // A full tank only passes flow on if an active line reaches it through active links, and only takes flow
+        // if its active links reach a tank that can take more.  No flow passes through any other full tank, so close
+        // its edges here rather than leave rounding noise from the solution to trickle through it.
+        bool fed[MAX_TANKS] = { }, drains[MAX_TANKS];
+        for (int i = 0; i < m_tankCount; i++)
+            drains[i] = !IsFull(i);
+        for (int i = 0; i < m_lineCount; i++)
+        {
+            if (active[i])
+                fed[m_lines[i].ToTank] = true;
+        }
+        for (bool changed = true; changed; )
+        {
+            changed = false;
+            for (int i = 0; i < m_linkCount; i++)
+            {
+                const Link &link = m_links[i];
+                if (!active[m_lineCount + i])
+                    continue;
+                if (fed[link.FromTank] && !fed[link.ToTank])
+                    changed = fed[link.ToTank] = true;
+                if (drains[link.ToTank] && !drains[link.FromTank])
+                    changed = drains[link.FromTank] = true;
+            }
+        }
+        for (int e = 0; e < edgeCount; e++)
+        {
+            const int downTank = ((e < m_lineCount) ? m_lines[e].ToTank : m_links[e - m_lineCount].ToTank);
+            if (!drains[downTank] || ((e >= m_lineCount) && !fed[m_links[e - m_lineCount].FromTank]))
+                active[e] = false;
+        }
+
+        // Flow into each full tank equals flow out of it: the sum over its edges of (otherPressure - pressure) / resistance is 0.
+        double a[MAX_TANKS][MAX_TANKS + 1] = { };   // augmented matrix
+        for (int e = 0; e < edgeCount; e++)
+        {
+            if (!active[e])
+                continue;
+
+            // upTank is -1 for a line's external end
+            const bool isLine = (e < m_lineCount);
+            const int upTank = (isLine ? -1 : m_links[e - m_lineCount].FromTank);
+            const int downTank = (isLine ? m_lines[e].ToTank : m_links[e - m_lineCount].ToTank);
+            const double upPressure = (isLine ? m_lines[e].Pressure : 0);  // only used for a line's external end
+            const double conductance = 1.0 / (isLine ? m_lines[e].Resistance : m_links[e - m_lineCount].Resistance);
+
+            const int upRow = ((upTank >= 0) ? unknown[upTank] : -1);
+            const int downRow = unknown[downTank];
+            if (upRow >= 0)
+            {
+                a[upRow][upRow] += conductance;
+                if (downRow >= 0)
+                    a[upRow][downRow] -= conductance;
+                else
+                    a[upRow][unknownCount] += conductance * pressure[downTank];
+            }
+            if (downRow >= 0)
+            {
+                a[downRow][downRow] += conductance;
+                if (upRow >= 0)
+                    a[downRow][upRow] -= conductance;
+                else
+                    a[downRow][unknownCount] += conductance * ((upTank >= 0) ? pressure[upTank] : upPressure);
+            }
+        }
+
+        // Gaussian elimination with partial pivoting.  A zero pivot is a full tank, or group of full tanks, that no
+        // open edge connects to a known pressure; no flow passes through it, so its pressure is arbitrary.
+        double solution[MAX_TANKS];
+        bool isFree[MAX_TANKS] = { };
+        for (int col = 0; col < unknownCount; col++)
+        {
+            int pivot = col;
+            for (int row = col + 1; row < unknownCount; row++)
+            {
+                if (fabs(a[row][col]) > fabs(a[pivot][col]))
+                    pivot = row;
+            }
+            if (fabs(a[pivot][col]) < 1e-12)
+            {
+                isFree[col] = true;
+                continue;
+            }
+            if (pivot != col)
+            {
+                for (int k = 0; k <= unknownCount; k++)
+                    swap(a[pivot][k], a[col][k]);
+            }
+            for (int row = col + 1; row < unknownCount; row++)
+            {
+                const double factor = a[row][col] / a[col][col];
+                if (factor != 0)
+                {
+                    for (int k = col; k <= unknownCount; k++)
+                        a[row][k] -= factor * a[col][k];
+                }
+            }
+        }
+        for (int row = unknownCount - 1; row >= 0; row--)
+        {
+            if (isFree[row])
+            {
+                solution[row] = 0;
+                continue;
+            }
+            double sum = a[row][unknownCount];
+            for (int k = row + 1; k < unknownCount; k++)
+                sum -= a[row][k] * solution[k];
+            solution[row] = sum / a[row][row];
+        }
+        for (int i = 0; i < m_tankCount; i++)
+        {
+            if (unknown[i] >= 0)
+                pressure[i] = solution[unknown[i]];
+        }
+
+        bool closedAny = false;
+        for (int e = 0; e < edgeCount; e++)
+        {
+            flow[e] = 0;
+            if (!active[e])
+                continue;
+
+            if (e < m_lineCount)
+            {
+                const Line &line = m_lines[e];
+                flow[e] = (line.Pressure - pressure[line.ToTank]) / line.Resistance;
+            }
+            else
+            {
+                const Link &link = m_links[e - m_lineCount];
+                flow[e] = (pressure[link.FromTank] - pressure[link.ToTank]) / link.Resistance;
+            }
+
+            if (flow[e] < -MIN_FLOW_RATE)
+            {
+                active[e] = false;
+                closedAny = true;
+            }
+        }
+
+        if (!closedAny)
+            break;
+    }
+
+    // A full tank passes on everything it receives.  The flow through a low-resistance link is only as precise as the
+    // pressure difference across it, so rather than add up link flows, pass each full tank's inflow on through its
+    // links in proportion to their flows, highest pressure first; the tanks then take exactly what the lines deliver.
+    double inflow[MAX_TANKS] = { };
+    for (int i = 0; i < m_lineCount; i++)
+    {
+        m_lineRate[i] = ((active[i] && (flow[i] > MIN_FLOW_RATE)) ? flow[i] : 0);
+        inflow[m_lines[i].ToTank] += m_lineRate[i];
+    }
+
+    // hops is each tank's distance in active links from a tank that can take more, or -1 if none
+    int hops[MAX_TANKS];
+    for (int i = 0; i < m_tankCount; i++)
+        hops[i] = (IsFull(i) ? -1 : 0);
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        for (int i = 0; i < m_linkCount; i++)
+        {
+            const Link &link = m_links[i];
+            if (active[m_lineCount + i] && (hops[link.ToTank] >= 0) && ((hops[link.FromTank] < 0) || (hops[link.FromTank] > hops[link.ToTank] + 1)))
+            {
+                hops[link.FromTank] = hops[link.ToTank] + 1;
+                changed = true;
+            }
+        }
+    }
+
+    // Link flows run from higher to lower pressure, so visit each full tank once, highest pressure first, and only
+    // pass flow on to tanks not yet visited.  A tank whose links all solved to no flow splits its inflow by conductance
+    // among the links that bring it closer to a tank that can take more; on equal pressures the farther tank goes first.
+    bool visited[MAX_TANKS] = { };
+    for (;;)
+    {
+        int fromTank = -1;
+        for (int i = 0; i < m_tankCount; i++)
+        {
+            if (IsFull(i) && !visited[i] && (inflow[i] > 0) &&
+                ((fromTank < 0) || (pressure[i] > pressure[fromTank]) || ((pressure[i] == pressure[fromTank]) && (hops[i] > hops[fromTank]))))
+                fromTank = i;
+        }
+        if (fromTank < 0)
+            break;
+        visited[fromTank] = true;
+
+        double flowTotal = 0, conductanceTotal = 0;
+        double flowWeight[MAX_LINKS], conductanceWeight[MAX_LINKS];
+        for (int i = 0; i < m_linkCount; i++)
+        {
+            const Link &link = m_links[i];
+            const bool canPass = (active[m_lineCount + i] && (link.FromTank == fromTank) && !visited[link.ToTank]);
+            flowWeight[i] = (canPass ? max(flow[m_lineCount + i], 0.0) : 0);
+            conductanceWeight[i] = ((canPass && (hops[link.ToTank] >= 0) && (hops[link.ToTank] < hops[fromTank])) ? (1.0 / link.Resistance) : 0);
+            flowTotal += flowWeight[i];
+            conductanceTotal += conductanceWeight[i];
+        }
+
+        const double *pWeight = ((flowTotal > 0) ? flowWeight : conductanceWeight);
+        const double total = ((flowTotal > 0) ? flowTotal : conductanceTotal);
+        for (int i = 0; i < m_linkCount; i++)
+        {
+            if (pWeight[i] > 0)
+                inflow[m_links[i].ToTank] += inflow[fromTank] * pWeight[i] / total;
+        }
+        inflow[fromTank] = 0;
+    }
+
+    for (int i = 0; i < m_tankCount; i++)
+        m_tankRate[i] = (IsFull(i) ? 0 : inflow[i]);
+}
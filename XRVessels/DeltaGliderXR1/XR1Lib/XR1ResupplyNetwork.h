@@ -0,0 +1,117 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1ResupplyNetwork.h
+// Flow network for ResupplyPostStep: tanks are nodes, external
+// resupply lines feed tanks, and links carry the overflow from a
+// full tank into other tanks (payload bay tanks, or the RCS tank
+// via cross-feed).
+//
+// Each line and link has a flow resistance, and each tank an ullage
+// pressure that the flow into it must overcome.  A full tank passes
+// everything it receives on through its links, so its pressure
+// rises until inflow equals outflow; those pressures are solved for
+// all full tanks together, and every line and link flow follows
+// from them.  Flows are constant until the next tank fills, so Solve
+// steps from one fill to the next and no tank overshoots at any time
+// acceleration.
+//
+// This has no Orbiter dependency, so the ResupplyNetworkCheck tool
+// can run it against the original per-line code.
+// ==============================================================
+
+#pragma once
+
+class XR1ResupplyNetwork
+{
+public:
+    static const int MAX_TANKS = 8;
+    static const int MAX_LINES = 8;
+    static const int MAX_LINKS = 8;
+
+    struct Tank
+    {
+        double Mass;        // in kg
+        double Capacity;    // in kg; a tank with no capacity takes no flow
+        double Pressure;    // ullage pressure in PSI while not full; 0 = vented
+    };
+
+    // an external supply line into a tank; the supply end is at Pressure
+    struct Line
+    {
+        int ToTank;
+        double Resistance;  // in PSI per kg/second; must be > 0
+        double Pressure;    // in PSI
+        bool Open;
+    };
+
+    // carries flow from FromTank to ToTank while FromTank is full; never flows backward
+    struct Link
+    {
+        int FromTank;
+        int ToTank;
+        double Resistance;  // in PSI per kg/second; must be > 0
+        bool Open;
+    };
+
+    XR1ResupplyNetwork() : m_tankCount(0), m_lineCount(0), m_linkCount(0) { }
+
+    // These return the new tank, line, or link's index.  Lines and links start closed.
+    int AddTank(const double capacity, const double pressure = 0);
+    int AddLine(const int toTank, const double resistance);
+    int AddLink(const int fromTank, const int toTank, const double resistance);
+
+    int GetTankCount() const { return m_tankCount; }
+    Tank &GetTank(const int index) { return m_tanks[index]; }
+    Line &GetLine(const int index) { return m_lines[index]; }
+    Link &GetLink(const int index) { return m_links[index]; }
+    const Tank &GetTank(const int index) const { return m_tanks[index]; }
+
+    bool IsFull(const int tank) const { return (m_tanks[tank].Mass >= m_tanks[tank].Capacity); }
+
+    // Flow the open lines for deltaT seconds, updating the tank masses.
+    void Solve(const double deltaT);
+
+    // mass that flowed through a line during the last Solve, in kg
+    double GetLineFlow(const int line) const { return m_lineFlow[line]; }
+
+    // Line flow rate at the end of the last Solve, in kg/second.  Zero means that the line is closed or that no
+    // tank it reaches can take more.
+    double GetLineFlowRate(const int line) const { return m_lineRate[line]; }
+
+protected:
+    // Set m_lineRate and m_tankRate for the current tank masses.
+    void ComputeRates();
+
+    int m_tankCount, m_lineCount, m_linkCount;
+    Tank m_tanks[MAX_TANKS];
+    Line m_lines[MAX_LINES];
+    Link m_links[MAX_LINKS];
+
+    double m_lineFlow[MAX_LINES];   // in kg
+    double m_lineRate[MAX_LINES];   // in kg/second
+    double m_tankRate[MAX_TANKS];   // net inflow in kg/second
+};
@@ -0,0 +1,196 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1SoundCache.h
+// XRSound slot cache for WAV files that the vessel loads on demand
+// right before it plays them (info and warning callouts, door, APU and
+// resupply sounds).  Each WAV file is read from disk only the first
+// time it is used, or again after it has been evicted.
+//
+// Each vessel Sound ID is a channel that is bound to the cached slot
+// holding the WAV it last loaded; PlaySound, StopSound, and IsPlaying
+// use GetSlot to find that slot.  Rebinding a channel stops its
+// previous sound, just as reloading a slot in place did.  A slot that
+// another channel is playing is never shared or evicted, so two doors
+// moving at once still get independent hydraulic sounds.
+//
+// The XRSound interface is a template parameter so that the
+// XRChecks tools can run this code against a mock XRSound.
+// ==============================================================
+
+#pragma once
+
+#include "stringhasher.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+template <class TXRSound>
+class XR1SoundCache
+{
+public:
+    typedef typename TXRSound::PlaybackType PlaybackType;
+
+    static const int CHANNEL_COUNT = 64;    // > highest Sound ID
+    static const int CACHE_SIZE = 64;       // maximum number of on-demand WAV files kept loaded at once
+    static const int FIRST_SLOT = 1000;     // XRSound ID of cache entry 0; must be above all Sound IDs
+    static const int NO_CHANNEL = 0;        // Sound ID 0 is never a channel
+
+    enum class LoadResult
+    {
+        Cached,         // the WAV was already loaded; no disk access
+        Loaded,         // the WAV was loaded into a cached slot
+        LoadFailed,     // XRSound could not load the WAV; the slot stays reserved so we do not retry a missing file on every call
+        NoIdleSlot      // every cached slot is playing; the channel is bound to its own slot again
+    };
+
+    XR1SoundCache() : m_clock(0)
+    {
+        for (int i = 0; i < CACHE_SIZE; i++)
+        {
+            m_entries[i].lastUsed = 0;  // empty
+            m_entries[i].boundChannel = NO_CHANNEL;
+        }
+        for (int i = 0; i < CHANNEL_COUNT; i++)
+            m_channelSlot[i] = i;       // each channel plays from its own slot until it loads a sound on demand
+    }
+
+    // Returns the XRSound ID that the specified channel plays from; IDs that are not channels are their own slot
+    int GetSlot(const int channel) const { return (((channel >= 0) && (channel < CHANNEL_COUNT)) ? m_channelSlot[channel] : channel); }
+
+    // Bind a channel to a cached slot holding the specified WAV file, loading it from <pSoundFolder>/<pFilename> if necessary.
+    // If the WAV is loaded, pPathOut receives its full path.
+    LoadResult Load(TXRSound &xrSound, const int channel, const char *pSoundFolder, const char *pFilename, const PlaybackType playbackType,
+        char *pPathOut, const size_t pathOutSize)
+    {
+        assert((channel > NO_CHANNEL) && (channel < CHANNEL_COUNT));
+        const uint32_t filenameHash = HashStringNoCase(pFilename);
+        const int channelSlot = m_channelSlot[channel];
+        if (channelSlot >= FIRST_SLOT)
+        {
+            // check whether this channel already has this sound
+            Entry &entry = m_entries[channelSlot - FIRST_SLOT];
+            if (entry.Matches(filenameHash, pFilename, playbackType))
+            {
+                entry.lastUsed = ++m_clock;
+                return LoadResult::Cached;
+            }
+        }
+
+        // find an idle slot that already holds this WAV, or else the empty or least-recently-used idle slot
+        int lruIndex = -1;
+        for (int i = 0; i < CACHE_SIZE; i++)
+        {
+            const Entry &entry = m_entries[i];
+            if (entry.lastUsed == 0)   // empty?
+            {
+                if ((lruIndex < 0) || (m_entries[lruIndex].lastUsed != 0))   // prefer empty slots over evicting anything
+                    lruIndex = i;
+                continue;
+            }
+
+            // a slot that another channel is still playing may not be reused or evicted
+            const bool isIdle = ((entry.boundChannel == NO_CHANNEL) || !xrSound.IsWavPlaying(FIRST_SLOT + i));
+            if (!isIdle)
+                continue;
+
+            if (entry.Matches(filenameHash, pFilename, playbackType))
+            {
+                Bind(xrSound, channel, FIRST_SLOT + i);
+                return LoadResult::Cached;
+            }
+
+            if ((lruIndex < 0) || ((m_entries[lruIndex].lastUsed != 0) && (entry.lastUsed < m_entries[lruIndex].lastUsed)))
+                lruIndex = i;
+        }
+
+        if (lruIndex < 0)
+        {
+            Bind(xrSound, channel, channel);
+            return LoadResult::NoIdleSlot;
+        }
+
+        // load the WAV into the empty or least-recently-used slot, evicting whatever was there
+        Entry &entry = m_entries[lruIndex];
+        if (entry.boundChannel != NO_CHANNEL)
+            m_channelSlot[entry.boundChannel] = entry.boundChannel;     // channel no longer has a sound loaded
+
+        entry.filenameHash = filenameHash;
+        entry.playbackType = playbackType;
+        entry.boundChannel = NO_CHANNEL;
+        entry.lastUsed = ++m_clock;
+        strncpy(entry.filename, pFilename, sizeof(entry.filename) - 1);
+        entry.filename[sizeof(entry.filename) - 1] = 0;
+
+        snprintf(pPathOut, pathOutSize, "%s/%s", pSoundFolder, pFilename);
+        const bool stat = xrSound.LoadWav(FIRST_SLOT + lruIndex, pPathOut, playbackType);
+        Bind(xrSound, channel, FIRST_SLOT + lruIndex);
+        return (stat ? LoadResult::Loaded : LoadResult::LoadFailed);
+    }
+
+protected:
+    struct Entry
+    {
+        uint32_t filenameHash;      // HashStringNoCase(filename); only valid if lastUsed != 0
+        PlaybackType playbackType;
+        int boundChannel;           // channel currently playing from this slot, or NO_CHANNEL
+        unsigned int lastUsed;      // m_clock value when last used; 0 = entry is empty
+        char filename[256];         // same size as DeltaGliderXR1::m_warningWavFilename
+
+        bool Matches(const uint32_t hash, const char *pFilename, const PlaybackType type) const
+        {
+            return ((lastUsed != 0) && (filenameHash == hash) && (playbackType == type) && (strcasecmp(filename, pFilename) == 0));
+        }
+    };
+
+    // Point the specified channel at a new slot.  As with reloading a slot, this stops any sound the channel was playing.
+    void Bind(TXRSound &xrSound, const int channel, const int slot)
+    {
+        const int oldSlot = m_channelSlot[channel];
+        if (oldSlot == slot)
+            return;
+
+        if (oldSlot >= FIRST_SLOT)
+        {
+            xrSound.StopWav(oldSlot);   // OK if sound is already stopped here
+            m_entries[oldSlot - FIRST_SLOT].boundChannel = NO_CHANNEL;
+        }
+
+        if (slot >= FIRST_SLOT)
+        {
+            Entry &entry = m_entries[slot - FIRST_SLOT];
+            if ((entry.boundChannel != NO_CHANNEL) && (entry.boundChannel != channel))
+                m_channelSlot[entry.boundChannel] = entry.boundChannel;    // idle slot is taken over from another channel
+            entry.boundChannel = channel;
+            entry.lastUsed = ++m_clock;
+        }
+        m_channelSlot[channel] = slot;
+    }
+
+    Entry m_entries[CACHE_SIZE];
+    int m_channelSlot[CHANNEL_COUNT];   // XRSound ID that each channel plays from
+    unsigned int m_clock;
+};
@@ -486,6 +486,8 @@ void DeltaGliderXR1::clbkPostCreation()
     AddPreStep(new NosewheelSteeringPreStep(*this));
     AddPreStep(new UpdateVesselLightsPreStep(*this));
     AddPreStep(new ParkingBrakePreStep(*this));
+    if (*GetXR1Config()->StartupScript)  // user wants a script run when the simulation starts?
+        AddPreStep(new StartupScriptPreStep(*this));
 
     // WARNING: this must be invoked LAST in the prestep sequence so that behavior is consistent across all pre-step methods
     AddPreStep(new UpdatePreviousFieldsPreStep(*this));
@@ -495,6 +497,7 @@ void DeltaGliderXR1::clbkPostCreation()
     AddPostStep(new ComputeAccPostStep(*this));   // used by acc areas; computed only once per frame for efficiency
     // XRSound: AddPostStep(new AmbientSoundsPostStep       (*this));
     AddPostStep(new ShowWarningPostStep(*this));
+    AddPostStep(new CalloutQueuePostStep(*this));
     AddPostStep(new SetHullTempsPostStep(*this));
     AddPostStep(new SetSlopePostStep(*this));
     AddPostStep(new DoorSoundsPostStep(*this));
@@ -514,6 +517,13 @@ void DeltaGliderXR1::clbkPostCreation()
     AddPostStep(new AutoCenteringSimpleButtonAreasPostStep(*this));  // logic for all auto-centering button areas
     AddPostStep(new ResetAPUTimerForPolledSystemsPostStep(*this));
     AddPostStep(new ManageMWSPostStep(*this));
+    if (GetXR1Config()->FlightDataRecorderEnabled)  // user wants XR state recorded and replayed along with Orbiter's flight recorder?
+    {
+        AddPostStep(new FlightDataPlaybackPostStep(*this));
+        AddPostStep(new FlightDataRecorderPostStep(*this));
+    }
+    if (GetXR1Config()->TelemetryExportEnabled)  // user wants telemetry exported to shared memory?
+        AddPostStep(new TelemetryExportPostStep(*this));
 #ifdef _DEBUG
     AddPostStep(new TestXRVesselCtrlPostStep(*this));      // for manual testing of new XRVesselCtrl methods via the debugger
 #endif
@@ -535,6 +545,8 @@ void DeltaGliderXR1::clbkPostCreationCommonXRCode()
 
     SetEmptyMass();     // update mass for passengers, APU fuel, O2, etc.
 
+    UpdateDamageStatusTable();  // pick up any damage loaded from the scenario file
+
     // set default crew members if no UMmu crew data loaded from scenario file
     if (m_mmuCrewDataValid == false)   // scenario file not saved with UMmu data?
     {
@@ -554,6 +566,9 @@ void DeltaGliderXR1::clbkPostCreationCommonXRCode()
 #endif
         }
     }
+#ifdef MMU
+    RebuildCrewIndex();     // index the crew loaded from the scenario file or added above
+#endif
 
     // ENHANCEMENT: init correct defaults if no scenario file loaded
     if (m_parsedScenarioFile == false)
@@ -0,0 +1,79 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1ThermalNodes.cpp
+// Hull surface temperatures in structure-of-arrays form.
+// ==============================================================
+
+#include "XR1ThermalNodes.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+int XR1ThermalNodes::Add(double &vesselTemp, const HeatSource source, const double heatScale, const double coolingRate, const double minCooling)
+{
+    assert(Count < MAX_NODES);
+
+    const int index = Count++;
+    pVesselTemp[index] = &vesselTemp;
+    Source[index] = source;
+    Temp[index] = vesselTemp;
+    HeatScale[index] = heatScale;
+    HeatFrac[index] = 0;
+    CoolingRate[index] = coolingRate;
+    MinCooling[index] = minCooling;
+    return index;
+}
+
+void XR1ThermalNodes::AddHeat(const double *sourceHeatFrac, const double extTemp, const double degreesK)
+{
+    for (int i = 0; i < Count; i++)
+        HeatFrac[i] = sourceHeatFrac[static_cast<int>(Source[i])];
+
+    for (int i = 0; i < Count; i++)
+    {
+        const double newTemp = extTemp + ((HeatFrac[i] * degreesK) * HeatScale[i]);
+
+        // Don't ever LOWER a surface temp in the "add heat" phase here
+        Temp[i] = ((newTemp > Temp[i]) ? newTemp : Temp[i]);
+    }
+}
+
+void XR1ThermalNodes::RemoveHeat(const double extTemp, const double simdt)
+{
+    for (int i = 0; i < Count; i++)
+    {
+        const double delta = fabs(Temp[i] - extTemp);
+
+        // By default each surface drops 2% or .1 degree of its heat ABOVE AMBIENT per second, whichever is greater
+        const double heatDropped = max((delta * CoolingRate[i]), MinCooling[i]) * simdt;  // amount of heat dropped in this fraction of a second
+
+        const double newTemp = Temp[i] - heatDropped;
+        Temp[i] = ((newTemp > extTemp) ? newTemp : extTemp);   // stop once external temps reach ambient
+    }
+}
@@ -0,0 +1,76 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1ThermalNodes.h
+// Hull surface temperatures in structure-of-arrays form, used by
+// SetHullTempsPostStep.
+//
+// The heating and cooling kernels take the shared per-step terms as
+// plain numbers, so they have no Orbiter dependency and the
+// HullTempsCheck tool can run them against the original per-surface
+// code.
+//
+// There is no temperature limit column: a limit belongs to the damage
+// rule that watches a surface, not to the surface.  The nosecone alone
+// is checked by three hull breach rules, and each rule's limit drops
+// to HullTemperatureLimits::doorOpen while its door is open; see
+// DeltaGliderXR1::InitDamageRules.  The kernels never read a limit.
+// ==============================================================
+
+#pragma once
+
+struct XR1ThermalNodes
+{
+    // which leading-edge heating profile a node follows
+    enum class HeatSource { Nosecone, LeftWing, RightWing, Cockpit, Count };
+
+    static const int MAX_NODES = 16;
+
+    int Count = 0;
+    double *pVesselTemp[MAX_NODES];   // vessel member that holds this surface's temperature
+    HeatSource Source[MAX_NODES];
+    double Temp[MAX_NODES];           // working copy of *pVesselTemp, in Kelvin
+    double HeatScale[MAX_NODES];      // fraction of the source's heat this surface receives; e.g., wings get 0.75 of the nose's heat
+    double HeatFrac[MAX_NODES];       // per-step heat fraction from this node's HeatSource
+    double CoolingRate[MAX_NODES];    // fraction of heat above ambient dropped per second
+    double MinCooling[MAX_NODES];     // minimum heat dropped per second, in Kelvin
+
+    // Add a heated surface; returns the new node's index.
+    //   vesselTemp = variable holding the surface temperature; must remain valid for the life of this object
+    //   coolingRate, minCooling = the surface drops coolingRate of its heat above ambient per second, or minCooling degrees, whichever is greater
+    int Add(double &vesselTemp, const HeatSource source, const double heatScale, const double coolingRate = 0.02, const double minCooling = 0.1);
+
+    // copy the vessel temperatures into Temp, and back again after the kernels have run
+    void Gather() { for (int i = 0; i < Count; i++) Temp[i] = *pVesselTemp[i]; }
+    void Scatter() const { for (int i = 0; i < Count; i++) *pVesselTemp[i] = Temp[i]; }
+
+    // Raise each surface to extTemp + (its source's heat fraction * degreesK * HeatScale) if that is hotter than it is now.
+    // sourceHeatFrac is indexed by HeatSource.
+    void AddHeat(const double *sourceHeatFrac, const double extTemp, const double degreesK);
+
+    // Drop each surface's heat above ambient at its cooling rate for simdt seconds, stopping at extTemp.
+    void RemoveHeat(const double extTemp, const double simdt);
+};
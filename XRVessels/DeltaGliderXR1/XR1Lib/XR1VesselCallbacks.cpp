@@ -296,99 +296,86 @@ bool DeltaGliderXR1::clbkPanelRedrawEvent(const int areaID, const int event, SUR
 // --------------------------------------------------------------
 bool DeltaGliderXR1::clbkPlaybackEvent(double simt, double event_t, const char* event_type, const char* event)
 {
-    if (!strcasecmp(event_type, "GEAR"))
+    // Dispatch on a hash of the event type rather than comparing it against every type in turn.  Each case confirms
+    // the match with a single strcasecmp in case an event type that is not ours hashes to the same value as one that is.
+#define PLAYBACK_EVENT(TYPE)  case HashStringNoCase(TYPE): if (strcasecmp(event_type, TYPE) != 0) return false;
+
+    switch (HashStringNoCase(event_type))
     {
+    PLAYBACK_EVENT("GEAR")
         ActivateLandingGear(!strcasecmp(event, "UP") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "NOSECONE"))
-    {
+
+    PLAYBACK_EVENT("NOSECONE")
         ActivateNoseCone(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "RCOVER"))
-    {
+
+    PLAYBACK_EVENT("RCOVER")
         ActivateRCover(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "RADIATOR"))
-    {
+
+    PLAYBACK_EVENT("RADIATOR")
         ActivateRadiator(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "AIRBRAKE"))
-    {
+
+    PLAYBACK_EVENT("AIRBRAKE")
         ActivateAirbrake(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "HATCH"))
-    {
+
+    PLAYBACK_EVENT("HATCH")
         ActivateHatch(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "OLOCK"))
-    {
+
+    PLAYBACK_EVENT("OLOCK")
         ActivateOuterAirlock(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "ILOCK"))
-    {
+
+    PLAYBACK_EVENT("ILOCK")
         ActivateInnerAirlock(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "LADDER"))
-    {
+
+    PLAYBACK_EVENT("LADDER")
         ActivateLadder(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "APU"))
-    {
+
+    PLAYBACK_EVENT("APU")
         ActivateAPU(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "HOVERDOORS"))
-    {
+
+    PLAYBACK_EVENT("HOVERDOORS")
         ActivateHoverDoors(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "SCRAMDOORS"))
-    {
+
+    PLAYBACK_EVENT("SCRAMDOORS")
         ActivateScramDoors(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "BAYDOORS"))
-    {
+
+    PLAYBACK_EVENT("BAYDOORS")
         ActivateBayDoors(!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
         return true;
-    }
-    else if (!strcasecmp(event_type, "CHAMBER"))
-    {
+
+    PLAYBACK_EVENT("CHAMBER")
         ActivateChamber((!strcasecmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING), true);  // OK to force here, although it shouldn't be necessary
         return true;
-    }
+
     // new for the XR1-1.9 release group
-    else if (!strcasecmp(event_type, "NAVLIGHT"))
-    {
+    PLAYBACK_EVENT("NAVLIGHT")
         SetNavlight(!strcasecmp(event, "ON"));  // true = light on
         return true;
-    }
-    else if (!strcasecmp(event_type, "BEACONLIGHT"))
-    {
+
+    PLAYBACK_EVENT("BEACONLIGHT")
         SetBeacon(!strcasecmp(event, "ON"));  // true = light on
         return true;
-    }
-    else if (!strcasecmp(event_type, "STROBELIGHT"))
-    {
+
+    PLAYBACK_EVENT("STROBELIGHT")
         SetStrobe(!strcasecmp(event, "ON"));  // true = light on
         return true;
-    }
-    else if (!strcasecmp(event_type, "RESETMET"))
-    {
+
+    PLAYBACK_EVENT("RESETMET")
         ResetMET();   // event not used for this
         return true;
-    }
-    else if (!strcasecmp(event_type, "XFEED"))
-    {
+
+    PLAYBACK_EVENT("XFEED")
         XFEED_MODE mode;
         if (!strcasecmp(event, "MAIN"))
             mode = XFEED_MODE::XF_MAIN;
@@ -403,32 +390,35 @@ bool DeltaGliderXR1::clbkPlaybackEvent(double simt, double event_t, const char*
         }
         SetCrossfeedMode(mode, nullptr);   // no optional message for this
         return true;
-    }
-    else if (!strcasecmp(event_type, "MAINDUMP"))
-    {
+
+    PLAYBACK_EVENT("MAINDUMP")
         m_mainFuelDumpInProgress = (!strcmp(event, "ON"));
         return true;
-    }
-    else if (!strcasecmp(event_type, "RCSDUMP"))
-    {
+
+    PLAYBACK_EVENT("RCSDUMP")
         m_rcsFuelDumpInProgress = (!strcmp(event, "ON"));
         return true;
-    }
-    else if (!strcasecmp(event_type, "SCRAMDUMP"))
-    {
+
+    PLAYBACK_EVENT("SCRAMDUMP")
         m_scramFuelDumpInProgress = (!strcmp(event, "ON"));
         return true;
-    }
-    else if (!strcasecmp(event_type, "APUDUMP"))
-    {
+
+    PLAYBACK_EVENT("APUDUMP")
         m_apuFuelDumpInProgress = (!strcmp(event, "ON"));
         return true;
-    }
-    else if (!strcasecmp(event_type, "LOXDUMP"))
-    {
+
+    PLAYBACK_EVENT("LOXDUMP")
         m_loxDumpInProgress = (!strcmp(event, "ON"));
         return true;
+
+    PLAYBACK_EVENT("XRFLIGHTDATA")
+        snprintf(m_flightDataRecordingName, sizeof(m_flightDataRecordingName), "%s", event);   // FlightDataPlaybackPostStep opens this recording's flight data file
+        return true;
+
+    default:
+        break;
     }
+#undef PLAYBACK_EVENT
 
     return false;
 }
@@ -475,6 +465,9 @@ void DeltaGliderXR1::clbkVisualDestroyed(VISHANDLE vis, int refcount)
 // --------------------------------------------------------------
 void DeltaGliderXR1::clbkPreStep(double simt, double simdt, double mjd)
 {
+    // apply any state changes queued by XRVesselCtrl clients since the last frame
+    ApplyQueuedXRCommands();
+
     // calculate max scramjet thrust
     ScramjetThrust();
 
@@ -0,0 +1,313 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRCommonScenarioFields.h: scenario line parsers shared by DeltaGliderXR1::ParseXRCommonScenarioLine and the
+// XRChecks scenario round trip.  They are templates over the vessel so that the check can reload its lines through
+// this same code without the Orbiter SDK; the vessel class befriends them.
+// ==============================================================
+
+#pragma once
+#include "XR1Globals.h"
+#include "XRCommon_IO.h"
+#include <cstdio>
+
+// --------------------------------------------------------------
+// Parse the supplied line for a door status line in the supplied door table (see DeltaGliderXR1::InitDoorTable).
+//
+// Returns: true if line recognized and parsed, false otherwise
+// --------------------------------------------------------------
+template <class TDoorTable> bool ParseXRDoorScenarioLine(const TDoorTable &doorTable, char *line)
+{
+    // Note: 'line' is used by our parse macros
+    int len;              // used by macros
+    bool bFound = false;  // used by macros
+
+    for (int i = 0; (i < doorTable.count) && !bFound; i++)
+    {
+        IF_FOUND(doorTable.pScenarioName[i])
+        {
+            SSCANF2("%d%lf", (int *)doorTable.pStatus[i], doorTable.pProc[i]);
+        }
+    }
+
+    return bFound;     // set by macros
+}
+
+// --------------------------------------------------------------
+// Parse the supplied line for one of the XR status fields written by DeltaGliderXR1::WriteXRCommonScenarioLines.
+// Door lines, UMmu data, and configuration file overrides are handled by ParseXRCommonScenarioLine itself.
+//
+// Returns: true if line recognized and parsed, false otherwise
+// --------------------------------------------------------------
+template <class TVessel> bool ParseXRCommonScenarioFields(TVessel &vessel, char *line)
+{
+    // Note: 'line' is used by our parse macros
+    int len;              // used by macros
+    bool bFound = false;  // used by macros
+
+    IF_FOUND("APU_STATUS") 
+    {
+        SSCANF1("%d", (int *)&vessel.apu_status);  // no proc for this
+    } 
+    else IF_FOUND("EXTCOOLING_STATUS") 
+    {
+        SSCANF1("%d", (int *)&vessel.externalcooling_status);  // no proc for this
+    } 
+    else IF_FOUND("SECONDARY_HUD") 
+    {
+        SSCANF1("%d", &vessel.m_secondaryHUDMode);
+    } 
+    else IF_FOUND("ADCTRL_MODE")    // BUGFIX IN DEFAULT DG: preserve ADCTRL mode
+    {      
+        int adCtrlMode = 7;     // default to ALL ON
+        SSCANF1("%d", &adCtrlMode);
+        vessel.SetADCtrlMode(adCtrlMode);
+    } 
+    else IF_FOUND("LAST_ACTIVE_SECONDARY_HUD") 
+    {
+        SSCANF1("%d", &vessel.m_lastSecondaryHUDMode);
+    } 
+    else IF_FOUND("APU_FUEL_QTY") 
+    {
+        double frac = 1.0;  // default to full if invalid value found
+        SSCANF1("%lf", &frac);
+        vessel.ValidateFraction(frac);     // make sure it's in range
+        vessel.m_apuFuelQty = frac * APU_FUEL_CAPACITY;
+    } 
+    else IF_FOUND("LOX_QTY") 
+    {
+        const double maxLOXQty = vessel.GetXR1Config()->GetMaxLoxMass();
+        double frac = 1.0;  // default to full if invalid value found
+        SSCANF1("%lf", &frac);
+        vessel.ValidateFraction(frac);     // make sure it's in range
+        vessel.m_loxQty = frac * maxLOXQty;  // set main tank qty ONLY
+    } 
+    else IF_FOUND("CABIN_O2_LEVEL") 
+    {
+        SSCANF1("%lf", &vessel.m_cabinO2Level);
+        vessel.ValidateFraction(vessel.m_cabinO2Level);   // check range
+    } 
+    else IF_FOUND("COOLANT_TEMP") 
+    {
+        SSCANF1("%lf", &vessel.m_coolantTemp);
+    } 
+    else IF_FOUND("CREW_STATE") 
+    {
+        SSCANF1("%d", (int *)&vessel.m_crewState);
+    } 
+    else IF_FOUND("COGSHIFT_MODES") 
+    {
+        SSCANF_BOOL3(vessel.m_cogShiftAutoModeActive, vessel.m_cogShiftCenterModeActive, vessel.m_cogForceRecenter);
+    } 
+    else IF_FOUND("GIMBAL_BUTTON_STATES") 
+    {
+        SSCANF_BOOL6(vessel.m_mainPitchCenteringMode, vessel.m_mainYawCenteringMode, vessel.m_mainDivMode, vessel.m_mainAutoMode, vessel.m_hoverCenteringMode, vessel.m_scramCenteringMode);
+    } 
+    else IF_FOUND("INTERNAL_SYSTEMS_FAILURE") 
+    {
+        SSCANF_BOOL(vessel.m_internalSystemsFailure);
+    } 
+    else IF_FOUND("MWS_ACTIVE") 
+    {
+        SSCANF_BOOL(vessel.m_MWSActive);
+    } 
+    else IF_FOUND("TAKEOFF_LANDING_CALLOUTS") 
+    {
+        SSCANF5("%lf %lf %lf %lf %lf", &vessel.m_preStepPreviousAirspeed, &vessel.m_airborneTargetTime, &vessel.m_takeoffTime, &vessel.m_touchdownTime, &vessel.m_preStepPreviousVerticalSpeed);
+    } 
+    else IF_FOUND("IS_CRASHED") 
+    {
+        SSCANF_BOOL(vessel.m_isCrashed);
+    } 
+    else IF_FOUND("CRASH_MSG") 
+    {
+        SSCANF1("%s", &vessel.m_crashMessage[0]);
+        vessel.DecodeSpaces(vessel.m_crashMessage);   // Orbiter won't save or load spaces in params, so we work around it
+    } 
+    else IF_FOUND("ACTIVE_MDM") 
+    {
+        SSCANF1("%d", &vessel.m_activeMultiDisplayMode);
+    } 
+    else IF_FOUND("MET_STARTING_MJD") 
+    {
+        SSCANF1("%lf", &vessel.m_metMJDStartingTime);
+    } 
+    else IF_FOUND("INTERVAL1_ELAPSED_TIME") 
+    {
+        SSCANF1("%lf", &vessel.m_interval1ElapsedTime);
+    } 
+    else IF_FOUND("INTERVAL2_ELAPSED_TIME") 
+    {
+        SSCANF1("%lf", &vessel.m_interval2ElapsedTime);
+    } 
+    else IF_FOUND("MET_RUNNING") 
+    {
+        SSCANF_BOOL(vessel.m_metTimerRunning);
+    } 
+    else IF_FOUND("INTERVAL1_RUNNING") 
+    {
+        SSCANF_BOOL(vessel.m_interval1TimerRunning);
+    } 
+    else IF_FOUND("INTERVAL2_RUNNING") 
+    {
+        SSCANF_BOOL(vessel.m_interval2TimerRunning);
+    } 
+    else IF_FOUND("TEMP_SCALE") 
+    {
+        SSCANF1("%d", (int *)&vessel.m_activeTempScale);
+    } 
+    else IF_FOUND("CUSTOM_AUTOPILOT_MODE") 
+    {
+        AUTOPILOT ap;
+        SSCANF1("%d", (int *)&ap);
+        // must set the autopilot mode via the method so that RCS thrust levels are set correctly
+        vessel.SetCustomAutopilotMode(ap, false, true);  // do not play sound; FORCE setting regardless of current door status (doors will be set elsewhere during the load)
+    } 
+    else IF_FOUND("AIRSPEED_HOLD_ENGAGED") 
+    {
+        SSCANF_BOOL(vessel.m_airspeedHoldEngaged);
+    } 
+    else IF_FOUND("ATTITUDE_HOLD_DATA") 
+    {
+        // NOTE: m_centerOfLift is a new field for XR1 version 1.3, so it will not be there for pre-existing scenarios.  This would only be a factor
+        // if the scenario was saved with the autpilot engaged, but we need to handle this.  The default value in those cases will be NEUTRAL_CENTER_OF_LIFT.
+        vessel.m_centerOfLift = NEUTRAL_CENTER_OF_LIFT; // this is the value used if no value is present in the scenario
+        *(reinterpret_cast<unsigned char *>(&vessel.m_holdAOA)) = '0';    // default to FALSE if we read an old scenario file below and m_holdAOA is not parsed
+		int i1, i2;
+        SSCANF5("%lf %lf %d %d %lf", &vessel.m_setPitchOrAOA, &vessel.m_setBank, &i1, &i2, &vessel.m_centerOfLift);
+		vessel.m_initialAHBankCompleted = (i1 != 0);  // convert to bool (0 or 1)
+		vessel.m_holdAOA = (i2 != 0);  // convert to bool (0 or 1)
+    } 
+    else IF_FOUND("DESCENT_HOLD_DATA") 
+    {
+		int i1 = 0;  // written as an integer; reading it as a char would turn '0' into true
+        SSCANF3("%lf %lf %d", &vessel.m_setDescentRate, &vessel.m_latchedAutoTouchdownMinDescentRate, &i1);
+		vessel.m_autoLand = (i1 != 0);  // convert to bool (0 or 1)
+    } 
+    else IF_FOUND("AIRSPEED_HOLD_DATA") 
+    {
+        SSCANF1("%lf", &vessel.m_setAirspeed);
+    } 
+    else IF_FOUND("TERTIARY_HUD_ON") 
+    {
+        SSCANF_BOOL(vessel.m_tertiaryHUDOn);
+    } 
+    else IF_FOUND("CREW_DISPLAY_INDEX") 
+    {
+        SSCANF1("%d", &vessel.m_crewDisplayIndex);
+        // range-check this
+        if ((vessel.m_crewDisplayIndex < 0) || (vessel.m_crewDisplayIndex > MAX_PASSENGERS))  // includes room for pilot @ index 0
+            vessel.m_crewDisplayIndex = 0;
+    } 
+    else IF_FOUND("OVERRIDE_INTERLOCKS") 
+    {
+        SSCANF_BOOL2(vessel.m_crewHatchInterlocksDisabled, vessel.m_airlockInterlocksDisabled);
+    } 
+    else IF_FOUND("SCRAM0DIR") 
+    {
+        VECTOR3 dir;
+        dir.z = -21769.5;   // sanity-check
+        SSCANF3("%lf%lf%lf", &dir.x, &dir.y, &dir.z);
+        if (dir.z != -21769.5)  // did we read in all three values?
+            vessel.SetThrusterDir(vessel.th_scram[0], dir);
+    } 
+    else IF_FOUND("SCRAM1DIR") 
+    {
+        VECTOR3 dir;
+        dir.z = -21769.5;   // sanity-check
+        SSCANF3("%lf%lf%lf", &dir.x, &dir.y, &dir.z);
+        if (dir.z != -21769.5)  // did we read in all three values?
+            vessel.SetThrusterDir(vessel.th_scram[1], dir);
+    } 
+    else IF_FOUND("HOVER_BALANCE") 
+    {
+        SSCANF1("%lf", &vessel.m_hoverBalance);
+    } 
+    else IF_FOUND("MAIN0DIR") 
+    {
+        VECTOR3 dir;
+        dir.z = -21769.5;   // sanity-check
+        SSCANF3("%lf%lf%lf", &dir.x, &dir.y, &dir.z);
+        if (dir.z != -21769.5)  // did we read in all three values?
+            vessel.SetThrusterDir(vessel.th_main[0], dir);
+    } 
+    else IF_FOUND("MAIN1DIR") 
+    {
+        VECTOR3 dir;
+        dir.z = -21769.5;   // sanity-check
+        SSCANF3("%lf%lf%lf", &dir.x, &dir.y, &dir.z);
+        if (dir.z != -21769.5)  // did we read in all three values?
+            vessel.SetThrusterDir(vessel.th_main[1], dir);
+    } 
+    else IF_FOUND("TRIM") 
+    {
+        double trim;
+        SSCANF1("%lf", &trim);
+        // Note: cannot use ValidateFraction here, since valid range is -1.0 to +1.0
+        // keep in range manually
+        if (trim < -1.0)
+            trim = -1.0;
+        else if (trim > 1.0)
+            trim = 1.0;
+        vessel.SetControlSurfaceLevel (AIRCTRL_ELEVATORTRIM, trim);
+    } 
+    // NOTE: "SKIN" must be parsed by each subclass because the path, texture names, and texture count may vary between vessels
+    else IF_FOUND("LIGHTS") 
+    {
+        int lgt[3];
+        SSCANF3("%d%d%d", lgt+0, lgt+1, lgt+2);
+        vessel.SetNavlight (lgt[0] != 0);
+        vessel.SetBeacon (lgt[1] != 0);
+        vessel.SetStrobe (lgt[2] != 0);
+    } 
+    else IF_FOUND("DMG_")  // starts with DMG_?
+    {   
+        int dmgIndex;
+        double fracIntegrity;
+
+        SSCANF2("%d %lf", &dmgIndex, &fracIntegrity);
+        vessel.ValidateFraction(fracIntegrity);  // keep in range
+        vessel.SetDamageStatus((DamageItem)dmgIndex, fracIntegrity);   // this may be overridden by subclasses
+    }
+    else IF_FOUND("PAYLOAD_SCREENS_DATA")   // only applicable to payload-enabled vessels, but doesn't hurt to read it here
+    {
+        SSCANF4("%lf %d %d %d", &vessel.m_deployDeltaV, &vessel.m_grappleRangeIndex, &vessel.m_selectedSlotLevel, &vessel.m_selectedSlot);   // payload screen data
+    }
+    else IF_FOUND("GRAPPLE_TARGET")  // only applicable to payload-enabled vessels, but doesn't hurt to read it here
+    {
+        // Allocate space for grapple target vessel name; this is only necessary until the pilot selects another target 
+        // This memory is freed in the destructor.
+        SSCANF1("%s", vessel.m_grappleTargetVesselName);
+    }
+	else IF_FOUND("PARKING_BRAKES")
+	{
+		SSCANF_BOOL(vessel.m_parkingBrakesEngaged);
+	}
+    else IF_FOUND("RNG_STATE")
+    {
+        unsigned long long seed = 0, counter = 0;
+        SSCANF2("%llu %llu", &seed, &counter);
+        vessel.m_random.SetState(seed, counter);
+    }
+
+    return bFound;     // set by macros
+}
@@ -25,17 +25,7 @@
 
 #pragma once
 
-// Door heat FAILURE depends on how far the door is opened (doorProc)
-#define OPEN_DOOR_OVER_TEMP(tempK)          (GetXR1Config()->HullHeatingDamageEnabled && AllowDamageIfDockedCheck() && !Playback() && ((tempK * (0.75 + (doorProc / 4.0))) > m_hullTemperatureLimits.doorOpen))
-#define OPEN_DOOR_WARN_TEMP(tempK)          (GetXR1Config()->HullHeatingDamageEnabled && AllowDamageIfDockedCheck() && !Playback() && (tempK > (m_hullTemperatureLimits.doorOpen * m_hullTemperatureLimits.doorOpenWarning)))
-#define OPEN_DOOR_OVER_PRESSURE_WARN(maxDynP)    (GetXR1Config()->DoorStressDamageEnabled && AllowDamageIfDockedCheck() && !Playback() && (GetDynPressure() > maxDynP))
-// Door dynp FAILURE depends on how far the door is opened (doorProc)
-#define OPEN_DOOR_OVER_PRESSURE_FAIL(maxDynP)    (GetXR1Config()->DoorStressDamageEnabled && AllowDamageIfDockedCheck() && !Playback() && (((GetDynPressure() * (0.20 + (doorProc / 1.25))) > maxDynP )))
-
-// do not issue warnings if door already failed
+// Door heat and dynamic pressure limits are evaluated by DeltaGliderXR1::CheckAllDoorDamage; see DeltaGliderXR1::InitDamageRules.
 #define IS_DOOR_OPEN(status)  (status != DoorStatus::DOOR_CLOSED)   // includes DoorStatus::DOOR_FAILED
-#define IS_DOOR_FAILED() (*doorStatus == DoorStatus::DOOR_FAILED)
-#define IS_DOOR_WARNING(tempK, maxDynP)        ((IS_DOOR_FAILED() == false) && (OPEN_DOOR_WARN_TEMP(tempK) || OPEN_DOOR_OVER_PRESSURE_WARN((maxDynP * DOOR_DYNAMIC_PRESSURE_WARNING_THRESHOLD))))
-#define IS_DOOR_FAILURE(tempK, maxDynP)        ((IS_DOOR_FAILED() == false) && (OPEN_DOOR_OVER_TEMP(tempK) || OPEN_DOOR_OVER_PRESSURE_FAIL(maxDynP)))
 
 
@@ -71,6 +71,7 @@ DeltaGliderXR1::DeltaGliderXR1 (OBJHANDLE hObj, int fmodel, XR1ConfigFileParser
     m_cogForceRecenter(false), m_MWSLit(false), m_wingBalance(0), m_lastActive2DPanelID(-1),
     m_externalCoolingSwitch(false), m_isExternalCoolantFlowing(false), m_selectedTurbopack(0), 
 	m_configOverrideBitmask(0), m_backedOutOrbiterCoreAutoRefuelThisFrame(false), m_parkingBrakesEngaged(false),
+    m_isTelemetrySnapshotValid(false),
     // initialize subclass-use-only variables; these are NOT used by the XR1
     m_dummyAttachmentPoint(nullptr), m_pPayloadBay(nullptr),
     m_deployDeltaV(0.2), m_grappleRangeIndex(0), m_selectedSlotLevel(1), m_selectedSlot(0),
@@ -123,12 +124,25 @@ DeltaGliderXR1::DeltaGliderXR1 (OBJHANDLE hObj, int fmodel, XR1ConfigFileParser
     for (size_t i=0; i < sizeof(m_rcsIntegrityArray) / sizeof(double); i++)
         m_rcsIntegrityArray[i] = 1.0;       // default to no damage
 
+    // no damage until the table is first updated; labels are filled in at that time
+    for (int i = 0; i < DAMAGE_ITEM_COUNT; i++)
+    {
+        DamageStatus &ds = m_damageStatusTable[i];
+        ds.fracIntegrity = 1.0;
+        *ds.label = *ds.shortLabel = 0;
+        ds.onlineOffline = true;
+    }
+    m_damageStatusLabelsValid = false;
+    m_random.SetState(XRRandom::MakeRandomSeed(), 0);  // replaced by the scenario's RNG_STATE, if any
+
     // new vars for the XR1
     *m_lastWarningMessage = 0;
     *m_crashMessage = 0;
+    *m_flightDataRecordingName = 0;
     *m_warningWavFilename = 0;
     m_warningWaveSoundType = ST_Other;  // will be set before first use anyway
     *m_lastWavLoaded = 0;
+    m_activeCalloutSound = NO_SOUND;
     *m_hudWarningText = 0;
 
     // always initalize these variables
@@ -210,6 +224,10 @@ DeltaGliderXR1::DeltaGliderXR1 (OBJHANDLE hObj, int fmodel, XR1ConfigFileParser
     for (int i=0; i < WARNING_LIGHT_COUNT; i++)
         m_warningLights[i] = false;
     m_apuWarning = false;
+
+    InitDoorTable();
+    InitDamageRules();
+    m_skippedXRAnimationCount = 0;
 }
 
 // --------------------------------------------------------------
@@ -25,6 +25,7 @@
 
 #include "DeltaGliderXR1.h"
 #include "AreaIDs.h"
+#include <cassert>
 
 // handle instant jumps to open or closed here
 #define CHECK_DOOR_JUMP(proc, anim) if (action == DoorStatus::DOOR_OPEN) proc = 1.0;            \
@@ -371,7 +372,7 @@ void DeltaGliderXR1::DecompressCabin()
 
     ShowWarning(nullptr, DeltaGliderXR1::ST_None, temp);
     strcpy(m_crashMessage, temp);   // show on HUD
-    PlaySound(Crash, ST_Other);
+    EnqueueCallout(Crash, ST_Other, XRCalloutPriority::Crash);   // interrupts any callout in progress
     m_cabinO2Level = 0;   // no atm in cabin now
     m_MWSActive = true;
 }
@@ -724,3 +725,133 @@ void DeltaGliderXR1::ToggleAPU(void)
 {
     ActivateAPU((apu_status == DoorStatus::DOOR_CLOSED || apu_status == DoorStatus::DOOR_CLOSING) ? DoorStatus::DOOR_OPENING : DoorStatus::DOOR_CLOSING);
 }
+
+//---------------------------------------------------------------------------
+
+// Register the doors common to all XR vessels; invoked by our constructor.
+// The registration order here is also the order in which the doors are written to the scenario file.
+void DeltaGliderXR1::InitDoorTable()
+{
+    m_doorTable.count = 0;
+    m_doorTable.hydraulicMask = 0;
+    m_doorTable.gearMask = 0;
+
+    // the gear moves via SetGearParameters, which sets the gear animation state as well
+    const int gearIndex = RegisterDoor(gear_status, gear_proc, GEAR_OPERATING_SPEED, nullptr, AID_GEARINDICATOR, true, "GEAR");
+    m_doorTable.gearMask |= (1u << gearIndex);
+
+    RegisterDoor(rcover_status,    rcover_proc,    RCOVER_OPERATING_SPEED,    &anim_rcover,    AID_RETRODOORINDICATOR, true, "RCOVER", DoorOpenedAction::EnableRetroThrusters);
+    RegisterDoor(nose_status,      nose_proc,      NOSE_OPERATING_SPEED,      &anim_nose,      AID_NOSECONEINDICATOR,  true, NOSECONE_SCN);  // 'NOSECONE' or 'DOCKINGPORT'
+    RegisterDoor(olock_status,     olock_proc,     AIRLOCK_OPERATING_SPEED,   &anim_olock,     AID_OUTERDOORINDICATOR, true, "AIRLOCK");
+    RegisterDoor(ilock_status,     ilock_proc,     AIRLOCK_OPERATING_SPEED,   &anim_ilock,     AID_INNERDOORINDICATOR, true, "IAIRLOCK");
+
+    // Note: the chamber is not actually animated; however, it does pressurize / depressurize at a fixed speed like a door, and it does not require hydraulic pressure
+    RegisterDoor(chamber_status,   chamber_proc,   CHAMBER_OPERATING_SPEED,   nullptr,         AID_CHAMBERINDICATOR,   false, "CHAMBER");
+    RegisterDoor(brake_status,     brake_proc,     AIRBRAKE_OPERATING_SPEED,  &anim_brake,     -1,                     true, "AIRBRAKE");
+    RegisterDoor(radiator_status,  radiator_proc,  RADIATOR_OPERATING_SPEED,  &anim_radiator,  AID_RADIATORINDICATOR,  true, "RADIATOR");
+
+    // the ladder and hatch are not used by some subclasses, but we animate and save them just the same because we have a status and a proc for them in the base XR1 class
+    RegisterDoor(ladder_status,    ladder_proc,    LADDER_OPERATING_SPEED,    &anim_ladder,    AID_LADDERINDICATOR,    true, "LADDER");
+    RegisterDoor(hatch_status,     hatch_proc,     HATCH_OPERATING_SPEED,     &anim_hatch,     AID_HATCHINDICATOR,     true, "HATCH");
+    RegisterDoor(scramdoor_status, scramdoor_proc, SCRAMDOOR_OPERATING_SPEED, &anim_scramdoor, AID_SCRAMDOORINDICATOR, true, "SCRAM_DOORS", DoorOpenedAction::EnableScramEngines);
+    RegisterDoor(hoverdoor_status, hoverdoor_proc, HOVERDOOR_OPERATING_SPEED, &anim_hoverdoor, AID_HOVERDOORINDICATOR, true, "HOVER_DOORS", DoorOpenedAction::EnableHoverEngines);
+}
+
+// Add a door to the door table and return its index.
+//   rate = fraction of full travel per second
+//   pAnim = animation handle member for this door, or nullptr if the door has no animation
+//   indicatorAreaID = area to redraw when the door finishes opening or closing, or -1 for none
+//   pScenarioName = tag for this door's "NAME status proc" line in the scenario file
+int DeltaGliderXR1::RegisterDoor(DoorStatus &status, double &proc, const double rate, const unsigned int *pAnim, const int indicatorAreaID,
+    const bool requiresHydraulics, const char *pScenarioName, const DoorOpenedAction openedAction)
+{
+    assert(m_doorTable.count < MAX_XR_DOORS);
+    assert(pScenarioName != nullptr);
+
+    const int index = m_doorTable.count++;
+    m_doorTable.pStatus[index] = &status;
+    m_doorTable.pProc[index] = &proc;
+    m_doorTable.rate[index] = rate;
+    m_doorTable.pAnim[index] = pAnim;
+    m_doorTable.indicatorAreaID[index] = indicatorAreaID;
+    m_doorTable.openedAction[index] = openedAction;
+    m_doorTable.pScenarioName[index] = pScenarioName;
+    if (requiresHydraulics)
+        m_doorTable.hydraulicMask |= (1u << index);
+
+    return index;
+}
+
+// Move each door in the door table that is opening or closing; invoked once per timestep by AnimationPostStep.
+// Doors that are open, closed, or failed are skipped without touching anything but their status.
+void DeltaGliderXR1::AnimateDoors(const double simdt)
+{
+    XRDoorTable &doors = m_doorTable;
+
+    unsigned int activeMask = 0;
+    for (int i = 0; i < doors.count; i++)
+    {
+        if (*doors.pStatus[i] >= DoorStatus::DOOR_CLOSING)  // closing or opening
+            activeMask |= (1u << i);
+    }
+
+    // only query the hydraulics if a door that needs them is moving
+    if ((activeMask & doors.hydraulicMask) && !CheckHydraulicPressure(false, false))     // do not log a warning nor play an error beep here!  We are merely querying the state.
+        activeMask &= ~doors.hydraulicMask;
+
+    for (int i = 0; activeMask != 0; i++)
+    {
+        const unsigned int doorBit = (1u << i);
+        if ((activeMask & doorBit) == 0)
+            continue;
+        activeMask &= ~doorBit;
+
+        DoorStatus &status = *doors.pStatus[i];
+        double &proc = *doors.pProc[i];
+        const double da = simdt * doors.rate[i];
+        if (status == DoorStatus::DOOR_CLOSING)
+        {
+            if (proc > 0.0)
+                proc = max(0.0, proc - da);
+            else
+            {
+                status = DoorStatus::DOOR_CLOSED;
+                if (doors.indicatorAreaID[i] >= 0)
+                    TriggerRedrawArea(doors.indicatorAreaID[i]);
+            }
+        }
+        else    // door is opening or open
+        {
+            if (proc < 1.0)
+                proc = min(1.0, proc + da);
+            else
+            {
+                status = DoorStatus::DOOR_OPEN;
+                switch (doors.openedAction[i])
+                {
+                case DoorOpenedAction::EnableRetroThrusters:
+                    EnableRetroThrusters(true);
+                    break;
+
+                case DoorOpenedAction::EnableHoverEngines:
+                    EnableHoverEngines(true);
+                    break;
+
+                case DoorOpenedAction::EnableScramEngines:
+                    EnableScramEngines(true);
+                    break;
+
+                default:
+                    break;
+                }
+                if (doors.indicatorAreaID[i] >= 0)
+                    TriggerRedrawArea(doors.indicatorAreaID[i]);
+            }
+        }
+
+        if (doors.gearMask & doorBit)
+            SetGearParameters(proc);    // will set animation state as well
+        else if (doors.pAnim[i] != nullptr)
+            SetXRAnimation(*doors.pAnim[i], proc);
+    }
+}
@@ -26,6 +26,7 @@
 #include "DeltaGliderXR1.h"
 #include "XR1PreSteps.h"
 #include "AreaIDs.h"
+#include <unordered_set>
 
 // perform an EVA for the specified crew member
 // Returns: true on success, false on error (crew member not present or outer airlock door is closed)
@@ -84,6 +85,7 @@ bool DeltaGliderXR1::PerformEVA(const int ummuCrewMemberIndex)
     if ((evaStatus == TRANSFER_TO_DOCKED_SHIP_OK) || (evaStatus == EVA_OK))
     {
         // EVA successful!  No need to remove the crew member manually since UMmu will do it for us.
+        RebuildCrewIndex();
 
         SetPassengerVisuals();     // update the VC mesh
 
@@ -214,21 +216,27 @@ int DeltaGliderXR1::ExtractIndexFromMmuMisc(const char* pMisc)
 // Returns: 0...n on success, or -1 if name is invalid
 int DeltaGliderXR1::GetMmuSlotNumberForName(const char* pName) const
 {
-    int retVal = -1;    // assume not found
+    // slot lookups by name are case-sensitive
+    return m_crewIndex.GetSlotForExactName(pName);
+}
 
+// Rebuild the crew name and rank index from the crew on board: the Mmu crew slots, or the crew manifest in the
+// config file if there is no Mmu.  Mmu renumbers its slots when a crew member boards or leaves, so the whole
+// index is rebuilt each time.
+void DeltaGliderXR1::RebuildCrewIndex()
+{
+#ifdef MMU
+    m_crewIndex.Clear();
     for (int i = 0; i < MAX_PASSENGERS; i++)
     {
-#ifdef MMU
-        const char* pUMmuName = CONST_UMMU(this).GetCrewNameBySlotNumber(i);
-        if (strcmp(pName, pUMmuName) == 0)
-        {
-            retVal = i;     // found the slot!
-            break;
-        }
-#endif
+        const char* pUmmuMisc = CONST_UMMU(this).GetCrewMiscIdBySlotNumber(i);
+        if (strlen(pUmmuMisc) > 0)   // crew member on board?
+            m_crewIndex.Add(i, CONST_UMMU(this).GetCrewNameBySlotNumber(i), RetrieveRankForMmuMisc(pUmmuMisc));
     }
-
-    return retVal;
+#else
+    // every crew slot is on board without MMU
+    m_crewIndex.Rebuild(GetXR1Config()->CrewMembers, MAX_PASSENGERS);
+#endif
 }
 
 // returns true if Mmu crew member is on board or false if not
@@ -285,30 +293,8 @@ bool DeltaGliderXR1::IsPilotOnBoard() const
 // pTargetRank is case-sensitive; e.g., "Commander"
 bool DeltaGliderXR1::IsCrewRankOnBoard(const char* pTargetRank) const
 {
-#ifdef MMU
-    bool retVal = false;   // assume not on board
-    char pRank[CrewMemberRankLength + 1];
-    for (int i = 0; i < MAX_PASSENGERS; i++)
-    {
-        const char* pUmmuMisc = CONST_UMMU(this).GetCrewMiscIdBySlotNumber(i);
-        const bool crewMemberOnBoard = (strlen(pUmmuMisc) > 0);
-
-        if (crewMemberOnBoard)
-        {
-            // check the crew member's rank (case-sensitive)
-            strncpy(pRank, RetrieveRankForUMmuMisc(pUmmuMisc), CrewMemberRankLength);
-            // check for commander and pilot by RANK (case-sensitive)
-            if (strcmp(pRank, pTargetRank) == 0)
-            {
-                retVal = true;
-                break;
-            }
-        }
-    }
-    return retVal;
-#else
-    return true;
-#endif
+    // the crew index holds only the crew members on board
+    return m_crewIndex.IsRankPresent(pTargetRank);
 }
 
 #ifdef MMU
@@ -372,6 +358,15 @@ void DeltaGliderXR1::StowAllTurbopacks()
 
     int stowedCount = 0;    // # of turbopacks stowed
 
+    // turbopack classnames hashed once so each vessel in range is checked with a single lookup
+    static const std::unordered_set<std::string> s_turbopackClassnames = []
+    {
+        std::unordered_set<std::string> classnames;
+        for (int i = 0; i < TURBOPACKS_ARRAY_SIZE; i++)
+            classnames.insert(TURBOPACKS_ARRAY[i].Classname);
+        return classnames;
+    }();
+
     // loop through all vessels in the sim and check each vessel's classname and distance
     const int dwVesselCount = oapiGetVesselCount();
     for (int i = 0; i < dwVesselCount; i++)
@@ -389,15 +384,11 @@ void DeltaGliderXR1::StowAllTurbopacks()
                 if (candidateVesselDistance <= STOW_TURBOPACK_DISTANCE)
                 {
                     // candidate vessel is in range; check its class for a match with one of our turbopack types
-                    for (int i = 0; i < TURBOPACKS_ARRAY_SIZE; i++)
+                    if (s_turbopackClassnames.count(pClassname) > 0)
                     {
-                        const Turbopack* pTurbopack = TURBOPACKS_ARRAY + i;
-                        if (strcmp(pClassname, pTurbopack->Classname) == 0)
-                        {
-                            // classname is a match!  Delete ("stow") the vessel.
-                            oapiDeleteVessel(hVessel);
-                            stowedCount++;
-                        }
+                        // classname is a match!  Delete ("stow") the vessel.
+                        oapiDeleteVessel(hVessel);
+                        stowedCount++;
                     }
                 }
             }
@@ -430,6 +421,7 @@ void DeltaGliderXR1::RemoveAllMmuCrewMembers()
         char* pName = CONST_UMMU(this).GetCrewNameBySlotNumber(i);
         UMmu.RemoveCrewMember(pName);  // UMMU BUG: METHOD DOESN'T WORK!  
     }
+    RebuildCrewIndex();
 #endif
 }
 
@@ -461,18 +453,8 @@ int DeltaGliderXR1::GetCrewAgeByName(const char* pName) const
 #ifdef MMU
     // TODO: call MMU.GetCrewTotalNumber();
 #else
-    int age = 0;
-    for (int i = 0; i < MAX_PASSENGERS; i++)
-    {
-        CrewMember* pcm = GetXR1Config()->CrewMembers + i;
-        if (strcasecmp(pcm->name, pName) == 0)
-        {
-            age = pcm->age;
-            break;
-        }
-    }
-
-    return age;
+    const int slot = m_crewIndex.GetSlotForName(pName);
+    return ((slot >= 0) ? GetXR1Config()->CrewMembers[slot].age : 0);
 #endif
 }
 
@@ -481,18 +463,8 @@ const char* DeltaGliderXR1::GetCrewMiscIdByName(const char* pName) const
 #ifdef MMU
     // TODO: call MMU.GetCrewMiscIdByName();
 #else
-    const char* pMiscID = "";
-    for (int i = 0; i < MAX_PASSENGERS; i++)
-    {
-        CrewMember* pcm = GetXR1Config()->CrewMembers + i;
-        if (strcasecmp(pcm->name, pName) == 0)
-        {
-            pMiscID = pcm->miscID.c_str();  // "XI0", "XI1", etc.
-            break;
-        }
-    }
-
-    return pMiscID;
+    const int slot = m_crewIndex.GetSlotForName(pName);
+    return ((slot >= 0) ? GetXR1Config()->CrewMembers[slot].miscID.c_str() : "");  // "XI0", "XI1", etc.
 #endif
 }
 
@@ -515,6 +487,7 @@ int DeltaGliderXR1::KillCrew()
             crewMembersKilled++;
         }
     }
+    RebuildCrewIndex();
 
     TriggerRedrawArea(AID_CREW_DISPLAY);   // update the crew display since they're all dead now...
     SetPassengerVisuals();     // update the VC mesh
@@ -568,7 +541,8 @@ void MmuPreStep::clbkPrePostStep(const double simt, const double simdt, const do
         *GetXR1().m_crashMessage = *GetXR1().m_hudWarningText = 0;
 
         // update crew display to show the new member
-        GetXR1().m_crewDisplayIndex = GetXR1().GetUMmuSlotNumberForName(pName);
+        GetXR1().RebuildCrewIndex();
+        GetXR1().m_crewDisplayIndex = GetXR1().GetMmuSlotNumberForName(pName);
         GetXR1().TriggerRedrawArea(AID_CREW_DISPLAY);
 
         // update passenger visuals since we just gained a new crew member
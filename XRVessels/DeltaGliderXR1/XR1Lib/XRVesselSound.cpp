@@ -27,6 +27,9 @@
 #include <cassert>
 #include <cstring>
 
+// seconds a queued callout may wait to play before it is stale and is dropped, indexed by XRCalloutPriority
+static const double s_calloutMaxAge[] = { 2.0, 5.0, 2.0, 5.0, 5.0 };
+
 // invoked during vessel initialization
 // Returns: true if init successful, false if XRSound not loaded
 bool DeltaGliderXR1::InitSound()
@@ -93,53 +96,53 @@ bool DeltaGliderXR1::InitSound()
     XRSoundOnOff(XRSound::SubsonicCallout, false);
     XRSoundOnOff(XRSound::SonicBoom, false);
 
-    // load sounds
-    LoadXR1Sound(SwitchOn, "SwitchOn1.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(SwitchOff, "SwitchOff1.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(Off, "Off.wav", XRSound::PlaybackType::Radio);
-    LoadXR1Sound(Rotation, "Rotation.wav", XRSound::PlaybackType::Radio); // so it's always audible outside the ship 
-    LoadXR1Sound(Translation, "Translation.wav", XRSound::PlaybackType::Radio); // so it's always audible outside the ship 
-    LoadXR1Sound(Error1, "Error1.wav", XRSound::PlaybackType::Radio); // so it's always audible outside the ship (just in case we use it for something)
-    LoadXR1Sound(OneHundredKnots, "100 Knots.wav", XRSound::PlaybackType::Radio);
-    LoadXR1Sound(V1, "V1.wav", XRSound::PlaybackType::Radio);
-    LoadXR1Sound(Rotate, "Rotate.wav", XRSound::PlaybackType::Radio);
-    LoadXR1Sound(GearUp, "Gear Up.wav", XRSound::PlaybackType::Radio);     // 10
-    LoadXR1Sound(GearDown, "Gear Down.wav", XRSound::PlaybackType::Radio);
+    // load sounds that always play from the same slot; all other sounds are loaded on demand via LoadXR1Sound
+    PreloadXR1Sound(SwitchOn, "SwitchOn1.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(SwitchOff, "SwitchOff1.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(Off, "Off.wav", XRSound::PlaybackType::Radio);
+    PreloadXR1Sound(Rotation, "Rotation.wav", XRSound::PlaybackType::Radio); // so it's always audible outside the ship 
+    PreloadXR1Sound(Translation, "Translation.wav", XRSound::PlaybackType::Radio); // so it's always audible outside the ship 
+    PreloadXR1Sound(Error1, "Error1.wav", XRSound::PlaybackType::Radio); // so it's always audible outside the ship (just in case we use it for something)
+    PreloadXR1Sound(OneHundredKnots, "100 Knots.wav", XRSound::PlaybackType::Radio);
+    PreloadXR1Sound(V1, "V1.wav", XRSound::PlaybackType::Radio);
+    PreloadXR1Sound(Rotate, "Rotate.wav", XRSound::PlaybackType::Radio);
+    PreloadXR1Sound(GearUp, "Gear Up.wav", XRSound::PlaybackType::Radio);     // 10
+    PreloadXR1Sound(GearDown, "Gear Down.wav", XRSound::PlaybackType::Radio);
     // GearLocked reused on-the-fly
-    LoadXR1Sound(Pitch, "Pitch.wav", XRSound::PlaybackType::Radio);
-    LoadXR1Sound(On, "On.wav", XRSound::PlaybackType::Radio);
-    LoadXR1Sound(BeepHigh, "BeepHigh.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(BeepLow, "BeepLow.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(AutopilotOn, "Autopilot On.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(AutopilotOff, "Autopilot Off.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(RetroDoorsAreClosed, "Retro doors are closed.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(Pitch, "Pitch.wav", XRSound::PlaybackType::Radio);
+    PreloadXR1Sound(On, "On.wav", XRSound::PlaybackType::Radio);
+    PreloadXR1Sound(BeepHigh, "BeepHigh.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(BeepLow, "BeepLow.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(AutopilotOn, "Autopilot On.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(AutopilotOff, "Autopilot Off.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(RetroDoorsAreClosed, "Retro doors are closed.wav", XRSound::PlaybackType::InternalOnly);
     // slot 20 = MachCallout
     // slot 21 = AltitudeCallout
-    LoadXR1Sound(SonicBoom, "Sonic Boom.wav", XRSound::PlaybackType::BothViewFar);
+    PreloadXR1Sound(SonicBoom, "Sonic Boom.wav", XRSound::PlaybackType::BothViewFar);
     // slot 23 = Ambient    (no longer used here; XRSound handles it)
     // slot 24 = Warning
     // slot 25 = Info
-    LoadXR1Sound(ScramJet, "ScramJet.wav", XRSound::PlaybackType::BothViewFar);
-    LoadXR1Sound(WarningBeep, "Warning Beep.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(GearWhine, "Gear Whine.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(GearLockedThump, "Gear Locked Thump.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(Crash, "Crash.wav", XRSound::PlaybackType::BothViewFar);
-    LoadXR1Sound(ErrorSoundFileMissing, "Error Sound File Missing.wav", XRSound::PlaybackType::BothViewFar);  // debugging only
-    LoadXR1Sound(FuelResupply, "Fuel Flow.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(FuelCrossFeed, "Fuel Flow.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(FuelDump, "Fuel Flow.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(SupplyHatch, "Door Opened Thump.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(HoverDoorsAreClosed, "Hover doors are closed.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(ScramDoorsAreClosed, "SCRAM doors are closed.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(Chamber, "Airlock.wav", XRSound::PlaybackType::InternalOnly);
-    LoadXR1Sound(WheelChirp, "Wheel Chirp.wav", XRSound::PlaybackType::BothViewClose);
-    LoadXR1Sound(TiresRolling, "Tires Rolling.wav", XRSound::PlaybackType::BothViewClose);
+    PreloadXR1Sound(ScramJet, "ScramJet.wav", XRSound::PlaybackType::BothViewFar);
+    PreloadXR1Sound(WarningBeep, "Warning Beep.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(GearWhine, "Gear Whine.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(GearLockedThump, "Gear Locked Thump.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(Crash, "Crash.wav", XRSound::PlaybackType::BothViewFar);
+    PreloadXR1Sound(ErrorSoundFileMissing, "Error Sound File Missing.wav", XRSound::PlaybackType::BothViewFar);  // debugging only
+    PreloadXR1Sound(FuelResupply, "Fuel Flow.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(FuelCrossFeed, "Fuel Flow.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(FuelDump, "Fuel Flow.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(SupplyHatch, "Door Opened Thump.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(HoverDoorsAreClosed, "Hover doors are closed.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(ScramDoorsAreClosed, "SCRAM doors are closed.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(Chamber, "Airlock.wav", XRSound::PlaybackType::InternalOnly);
+    PreloadXR1Sound(WheelChirp, "Wheel Chirp.wav", XRSound::PlaybackType::BothViewClose);
+    PreloadXR1Sound(TiresRolling, "Tires Rolling.wav", XRSound::PlaybackType::BothViewClose);
 
     return true;
 }
 
-// load a WAV file for XRSound to use
-void DeltaGliderXR1::LoadXR1Sound(const Sound sound, const char* pFilename, XRSound::PlaybackType playbackType)
+// load a WAV file for XRSound to use into the slot with the same ID as the sound; this is only invoked from InitSound
+void DeltaGliderXR1::PreloadXR1Sound(const Sound sound, const char* pFilename, XRSound::PlaybackType playbackType)
 {
     if (!m_pXRSound->IsPresent())
         return;
@@ -149,6 +152,27 @@ void DeltaGliderXR1::LoadXR1Sound(const Sound sound, const char* pFilename, XRSo
     bool stat = m_pXRSound->LoadWav(sound, m_lastWavLoaded, playbackType);
 #ifdef _DEBUG
     if (!stat)
+        sprintf(oapiDebugString(), "ERROR: PreloadXR1Sound: LoadWav failed, filename='%s'", pFilename);
+#endif
+}
+
+// Load a WAV file on demand for the specified sound channel to play; this is normally invoked right before PlaySound.
+// The WAV is only read from disk the first time it is used: after that the channel is simply pointed at the cached XRSound slot
+// that already holds it.
+void DeltaGliderXR1::LoadXR1Sound(const Sound sound, const char* pFilename, XRSound::PlaybackType playbackType)
+{
+    if (!m_pXRSound->IsPresent())
+        return;
+
+    // use member variable here so we can preserve the last file loaded for debugging purposes
+    const auto result = m_soundCache.Load(*m_pXRSound, sound, m_pXRSoundPath, pFilename, playbackType, m_lastWavLoaded, sizeof(m_lastWavLoaded));
+    if (result == XR1SoundCache<XRSound>::LoadResult::NoIdleSlot)
+    {
+        // every cached slot is playing (should never happen), so fall back to loading into the channel's own slot
+        PreloadXR1Sound(sound, pFilename, playbackType);
+    }
+#ifdef _DEBUG
+    else if (result == XR1SoundCache<XRSound>::LoadResult::LoadFailed)
         sprintf(oapiDebugString(), "ERROR: LoadXR1Sound: LoadWav failed, filename='%s'", pFilename);
 #endif
 }
@@ -180,6 +204,36 @@ void DeltaGliderXR1::PlaySound(Sound sound, const SoundType soundType, int volum
         volume = GetXR1Config()->AudioCalloutVolume;  // overrides any requested audio callout volume
 
     // now check whether the user wants to play this type of callout
+    const bool playSound = IsSoundTypeEnabled(soundType);
+    if (playSound == false)
+        return;     // user doesn't want the sound to play
+
+    // play the sound!
+    const float volFrac = min(static_cast<float>(volume) / 255.0f, 1.0f);  // convert legacy volume 0-255 to 0-1.0.
+    bool stat = m_pXRSound->PlayWav(GetSoundSlot(sound), bLoop, volFrac);
+
+    // We don't want "missing wave file" errors showing up for users; they may want to delete
+    // some sound files because they don't like them, so we don't want to clutter the log with
+    // useless messages.  We only need this during development.
+#ifdef _DEBUG
+    if (stat == FALSE)
+    {
+        char temp[512];
+        sprintf(temp, "ERROR: PlaySound: PlayWav failed, sound=%d : m_lastWavLoaded=[%s]", sound, m_lastWavLoaded);
+        strcpy(oapiDebugString(), temp);
+
+        // also write to the log
+        GetXR1Config()->WriteLog(temp);
+
+        // now let's play an audible alert, too
+        m_pXRSound->PlayWav(ErrorSoundFileMissing);
+    }
+#endif
+}
+
+// Returns true if the user wants to hear sounds of the specified type
+bool DeltaGliderXR1::IsSoundTypeEnabled(const SoundType soundType) const
+{
     bool playSound;
     switch (soundType)
     {
@@ -225,37 +279,65 @@ void DeltaGliderXR1::PlaySound(Sound sound, const SoundType soundType, int volum
 
         // only show an error during development
 #ifdef _DEBUG   
-        char temp[512];
-        sprintf(temp, "ERROR: PlaySound: Unknown Soundtype value (%d) for sound=%d : m_lastWavLoaded=[%s]", soundType, sound, m_lastWavLoaded);
-        strcpy(oapiDebugString(), temp);
+        sprintf(oapiDebugString(), "ERROR: IsSoundTypeEnabled: Unknown Soundtype value (%d) : m_lastWavLoaded=[%s]", soundType, m_lastWavLoaded);
 #endif
         break;
     }
 
-    if (playSound == false)
-        return;     // user doesn't want the sound to play
-
-    // play the sound!
-    const float volFrac = min(static_cast<float>(volume) / 255.0f, 1.0f);  // convert legacy volume 0-255 to 0-1.0.
-    bool stat = m_pXRSound->PlayWav(sound, bLoop, volFrac);
+    return playSound;
+}
 
-    // We don't want "missing wave file" errors showing up for users; they may want to delete
-    // some sound files because they don't like them, so we don't want to clutter the log with
-    // useless messages.  We only need this during development.
-#ifdef _DEBUG
-    if (stat == FALSE)
+// Map a sound type to its callout priority: warnings first, then proximity callouts, then general information (including
+// sound effects such as ShowInfo beeps), and velocity callouts last.  Crash sounds are queued at XRCalloutPriority::Crash explicitly.
+XRCalloutPriority DeltaGliderXR1::GetCalloutPriority(const SoundType soundType)
+{
+    switch (soundType)
     {
-        char temp[512];
-        sprintf(temp, "ERROR: PlaySound: PlayWav failed, sound=%d : m_lastWavLoaded=[%s]", sound, m_lastWavLoaded);
-        strcpy(oapiDebugString(), temp);
+    case ST_WarningCallout:
+        return XRCalloutPriority::Warning;
 
-        // also write to the log
-        GetXR1Config()->WriteLog(temp);
+    case ST_AltitudeCallout:
+    case ST_DockingDistanceCallout:
+        return XRCalloutPriority::Docking;
 
-        // now let's play an audible alert, too
-        m_pXRSound->PlayWav(ErrorSoundFileMissing);
+    case ST_VelocityCallout:
+        return XRCalloutPriority::Velocity;
+
+    default:
+        return XRCalloutPriority::Info;
     }
-#endif
+}
+
+// Queue a voice callout to be played by CalloutQueuePostStep as soon as no other callout is playing.
+// Callouts that the user has disabled are not queued at all.
+void DeltaGliderXR1::EnqueueCallout(const char *pFilename, const SoundType soundType, const CalloutGroup group)
+{
+    assert(pFilename != nullptr);
+    assert(soundType != ST_None);
+
+    if (!IsXRSoundLoaded() || !IsSoundTypeEnabled(soundType))
+        return;
+
+    const XRCalloutPriority priority = GetCalloutPriority(soundType);
+    m_calloutQueue.Enqueue(GetAbsoluteSimTime(), priority, group, NO_SOUND, pFilename, soundType, s_calloutMaxAge[static_cast<int>(priority)]);
+}
+
+// Queue a preloaded sound as a voice callout
+void DeltaGliderXR1::EnqueueCallout(const Sound sound, const SoundType soundType, const CalloutGroup group)
+{
+    EnqueueCallout(sound, soundType, GetCalloutPriority(soundType), group);
+}
+
+// Queue a preloaded sound at the specified priority; e.g., crash sounds are queued at XRCalloutPriority::Crash so that they
+// interrupt any callout in progress.
+void DeltaGliderXR1::EnqueueCallout(const Sound sound, const SoundType soundType, const XRCalloutPriority priority, const CalloutGroup group)
+{
+    assert(soundType != ST_None);
+
+    if (!IsXRSoundLoaded() || !IsSoundTypeEnabled(soundType))
+        return;
+
+    m_calloutQueue.Enqueue(GetAbsoluteSimTime(), priority, group, sound, nullptr, soundType, s_calloutMaxAge[static_cast<int>(priority)]);
 }
 
 // stop a sound via the XRSound SDK
@@ -269,7 +351,7 @@ void DeltaGliderXR1::StopSound(Sound sound)
         return;
 
     // OK if sound is already stopped here
-    m_pXRSound->StopWav(sound);
+    m_pXRSound->StopWav(GetSoundSlot(sound));
 }
 
 // check whether the specified sound is playing
@@ -278,7 +360,7 @@ bool DeltaGliderXR1::IsPlaying(Sound sound) const
     if (!m_pXRSound->IsPresent())
         return false;
 
-    return m_pXRSound->IsWavPlaying(sound);
+    return m_pXRSound->IsWavPlaying(GetSoundSlot(sound));
 }
 
 // play a warning sound and display a warning message via the DisplayWarningPoststep
@@ -330,13 +412,9 @@ void DeltaGliderXR1::ShowInfo(const char* pSoundFilename, const SoundType soundT
         m_infoWarningTextLineGroup.AddLines(pMessage, false);  // text is not highlighted
     }
 
-    // play the info sound, if any
-    // Info sounds are relatively infrequent, so no need for a PostStep to manage it
+    // queue the info sound, if any; CalloutQueuePostStep will play it
     if ((pSoundFilename != nullptr) && (*pSoundFilename != 0))
-    {
-        LoadXR1Sound(Info, pSoundFilename, XRSound::PlaybackType::Radio);
-        PlaySound(Info, soundType);
-    }
+        EnqueueCallout(pSoundFilename, soundType);
 
     // Clear the last warning message value so that the same warning can be displayed again;
     // this is so that the warning will always be printed again after an info message is displayed.
@@ -368,6 +446,5 @@ void DeltaGliderXR1::PlayDoorSound(DoorStatus doorStatus)
 void DeltaGliderXR1::PlayGearLockedSound(bool isGearUp)
 {
     const char* pFilename = (isGearUp ? "Gear Up And Locked.wav" : "Gear Down And Locked.wav");
-    LoadXR1Sound(GearLocked, pFilename, XRSound::PlaybackType::Radio);
-    PlaySound(GearLocked, ST_InformationCallout);
+    EnqueueCallout(pFilename, ST_InformationCallout, CG_Gear);
 }
@@ -306,6 +306,12 @@ void DeltaGliderXR1::ParseXRConfigFile()
 	// now apply the cheatcodes if they are enabled
 	// Note: cannot use GetXRConfig() here because we cannot make ApplyCheatcodesIfEnabled() const
 	(static_cast<XR1ConfigFileParser*>(m_pConfig))->ApplyCheatcodesIfEnabled();
+
+	// Without MMU the crew manifest is set only by the config file, so this is the only place the crew index needs to be rebuilt.
+	// With MMU, UMmu is not initialized yet; clbkPostCreationCommonXRCode indexes the crew loaded from the scenario.
+#ifndef MMU
+	RebuildCrewIndex();
+#endif
 }
 
 // Used for internal development testing only to tweak some internal value.
@@ -297,10 +297,9 @@ bool DeltaGliderXR1::GetEngineState(XREngineID id, XREngineStateRead &state) con
             state.DivergentMode        = false;
 
             // read-only data
-            XR1Ramjet::THDEF *pThdef = ramjet->thdef[idx];    // SCRAMjet thruster definition data
             state.TSFC         = ramjet->TSFC(idx);
-            state.FlowRate     = pThdef->dmf;   // kg/sec
-            state.Thrust       = pThdef->F;
+            state.FlowRate     = ramjet->DMF(idx);   // kg/sec
+            state.Thrust       = ramjet->GetThrust(idx);
             state.FuelLevel    = SAFE_FRACTION(GetXRPropellantMass(ph_scram), GetXRPropellantMaxMass(ph_scram));
             state.MaxFuelMass  = GetXRPropellantMaxMass(ph_scram);
             state.BayFuelMass  = GetXRBayPropellantMass(ph_scram);
@@ -1033,10 +1032,10 @@ int DeltaGliderXR1::GetStatusScreenText(char *pLinesOut, const int maxLinesToRet
     {
         assert(i >= 0);
         assert(i < INFO_WARNING_BUFFER_LINES);
-        TextLine textLine = m_infoWarningTextLineGroup.GetLine(i);
+        const TextLine &textLine = m_infoWarningTextLineGroup.GetLine(i);
         
-        // retrieve each line's string object and copy it to pLinesOut by value and terminating each with \r\n
-        strcat(pLinesOut, textLine.text.c_str());
+        // copy each line to pLinesOut, terminating each with \r\n
+        strcat(pLinesOut, textLine.text);
         strcat(pLinesOut, "\r\n");
     }
         
@@ -1289,4 +1288,185 @@ bool DeltaGliderXR1::SetCrossFeedMode(XRXFEED_STATE state)
     return true;
 }
 
+//=========================================================================
+
+//
+// API methods added in XRVesselCtrl version 4.1
+//
+
+// Populates snapshotOut with all the readable state of this vessel; the snapshot is built at most once per frame and then shared by all callers.
+//   structSize: sizeof(XRTelemetrySnapshot) as compiled by the caller; we never write more than this many bytes to snapshotOut
+// Returns: true on success, false if structSize is too small to hold even the Version and StructSize fields
+bool DeltaGliderXR1::GetXRTelemetrySnapshot(XRTelemetrySnapshot &snapshotOut, const int structSize)
+{
+    // the caller must at least be able to see which version it received (Version and StructSize fields)
+    if (structSize < static_cast<int>(2 * sizeof(int)))
+        return false;
+
+    if (!m_isTelemetrySnapshotValid || (m_telemetrySnapshot.FrameSequence != GetFrameSequence()))
+        RefreshTelemetrySnapshot();
+
+    // Note: newer clients may have a larger structure; in that case the trailing fields are left untouched and the caller can detect that via StructSize
+    memcpy(&snapshotOut, &m_telemetrySnapshot, min(static_cast<size_t>(structSize), sizeof(XRTelemetrySnapshot)));
+    return true;
+}
+
+// Rebuild our cached telemetry snapshot for this frame.
+// Note: we go through our public XRVesselCtrl getters here so that any subclass overrides (e.g., extra doors on the XR5) are reflected in the snapshot.
+void DeltaGliderXR1::RefreshTelemetrySnapshot()
+{
+    XRTelemetrySnapshot &s = m_telemetrySnapshot;
+
+    s.Version = XRTELEMETRY_SNAPSHOT_VERSION;
+    s.StructSize = sizeof(XRTelemetrySnapshot);
+    s.FrameSequence = GetFrameSequence();
+    s.SimTime = GetAbsoluteSimTime();
+
+    GetXRSystemStatus(s.Status);
+
+    for (int i = 0; i < XRTELEMETRY_ENGINE_COUNT; i++)
+        s.EngineSupported[i] = GetEngineState(static_cast<XREngineID>(i), s.Engines[i]);
+
+    for (int i = 0; i < XRTELEMETRY_DOOR_COUNT; i++)
+        s.DoorStates[i] = GetDoorState(static_cast<XRDoorID>(i), &s.DoorProcs[i]);
+    s.ExternalCoolingState = GetExternalCoolingState();
+
+    for (int i = 0; i < XRTELEMETRY_STDAP_COUNT; i++)
+        s.StandardAP[i] = GetStandardAP(static_cast<XRStdAutopilot>(i));
+    s.AttitudeHoldAPState = GetAttitudeHoldAP(s.AttitudeHold);
+    s.DescentHoldAPState  = GetDescentHoldAP(s.DescentHold);
+    s.AirspeedHoldAPState = GetAirspeedHoldAP(s.AirspeedHold);
+
+    for (int i = 0; i < XRTELEMETRY_LIGHT_COUNT; i++)
+        s.ExteriorLights[i] = GetExteriorLight(static_cast<XRLight>(i));
+
+    s.SecondaryHUDMode      = GetSecondaryHUDMode();
+    s.TertiaryHUDOn         = GetTertiaryHUDState();
+    s.RCSDockingMode        = IsRCSDockingMode();
+    s.ElevatorEVAPortActive = IsElevatorEVAPortActive();
+    s.RecenterCOGMode       = GetRecenterCOGMode();
+
+    s.PayloadBaySlotCount = GetPayloadBaySlotCount();
+    const int slotsToCopy = min(s.PayloadBaySlotCount, XRTELEMETRY_MAX_PAYLOAD_SLOTS);
+    for (int i = 0; i < slotsToCopy; i++)
+        GetPayloadSlotData(i + 1, s.PayloadSlots[i]);   // slot numbers are 1-based
+
+    m_isTelemetrySnapshotValid = true;
+}
+
+//=========================================================================
+
+//
+// API methods added in XRVesselCtrl version 4.2
+//
+
+// Returns true if both commands change the same system; the hold autopilots have no ID
+static bool IsSameXRCommandTarget(const XRCommand &a, const XRCommand &b)
+{
+    if (a.Type != b.Type)
+        return false;
+
+    switch (a.Type)
+    {
+    case XRCommandType::XRCMD_AttitudeHold:
+    case XRCommandType::XRCMD_DescentHold:
+    case XRCommandType::XRCMD_AirspeedHold:
+        return true;
+
+    default:
+        return (a.ID == b.ID);
+    }
+}
+
+// Thread-safe: may be invoked from any thread
+bool DeltaGliderXR1::EnqueueXRCommand(const XRCommand &command)
+{
+    if ((command.Type < XRCommandType::XRCMD_EngineState) || (command.Type > XRCommandType::XRCMD_ExteriorLight))
+        return false;
+
+    lock_guard<mutex> lock(m_xrCommandQueueMutex);
+
+    // coalesce repeated writes: the last one wins, but it keeps the position of the first one
+    for (unsigned int i = 0; i < m_xrCommandQueue.size(); i++)
+    {
+        if (IsSameXRCommandTarget(m_xrCommandQueue[i], command))
+        {
+            m_xrCommandQueue[i] = command;
+            return true;
+        }
+    }
+
+    m_xrCommandQueue.push_back(command);
+    return true;
+}
+
+// Thread-safe: may be invoked from any thread
+int DeltaGliderXR1::GetQueuedXRCommandCount()
+{
+    lock_guard<mutex> lock(m_xrCommandQueueMutex);
+    return static_cast<int>(m_xrCommandQueue.size());
+}
+
+// Invoked from clbkPreStep: apply all queued commands as a single batch
+void DeltaGliderXR1::ApplyQueuedXRCommands()
+{
+    {
+        lock_guard<mutex> lock(m_xrCommandQueueMutex);
+        if (m_xrCommandQueue.empty())
+            return;     // nothing to do (this is the normal case)
+
+        // take the whole queue so clients may keep queueing while we apply this batch
+        m_xrCommandBatch.swap(m_xrCommandQueue);
+    }
+
+    BeginDeferredRedraws();     // each area is repainted once no matter how many commands touched it
+    for (unsigned int i = 0; i < m_xrCommandBatch.size(); i++)
+        ApplyXRCommand(m_xrCommandBatch[i]);
+    EndDeferredRedraws();
+
+    m_xrCommandBatch.clear();   // retains its capacity for the next swap
+}
+
+void DeltaGliderXR1::ApplyXRCommand(const XRCommand &command)
+{
+    switch (command.Type)
+    {
+    case XRCommandType::XRCMD_EngineState:
+        if ((command.ID >= 0) && (command.ID < XRTELEMETRY_ENGINE_COUNT))
+            SetEngineState(static_cast<XREngineID>(command.ID), command.EngineState);
+        break;
+
+    case XRCommandType::XRCMD_DoorState:
+        if ((command.ID >= 0) && (command.ID < XRTELEMETRY_DOOR_COUNT))
+            SetDoorState(static_cast<XRDoorID>(command.ID), command.DoorState);
+        break;
+
+    case XRCommandType::XRCMD_StandardAP:
+        if ((command.ID >= 0) && (command.ID < XRTELEMETRY_STDAP_COUNT))
+            SetStandardAP(static_cast<XRStdAutopilot>(command.ID), command.On);
+        break;
+
+    case XRCommandType::XRCMD_AttitudeHold:
+        SetAttitudeHoldAP(command.AttitudeHold);
+        break;
+
+    case XRCommandType::XRCMD_DescentHold:
+        SetDescentHoldAP(command.DescentHold);
+        break;
+
+    case XRCommandType::XRCMD_AirspeedHold:
+        SetAirspeedHoldAP(command.AirspeedHold);
+        break;
+
+    case XRCommandType::XRCMD_ExteriorLight:
+        if ((command.ID >= 0) && (command.ID < XRTELEMETRY_LIGHT_COUNT))
+            SetExteriorLight(static_cast<XRLight>(command.ID), command.On);
+        break;
+
+    default:
+        assert(false);  // EnqueueXRCommand should have rejected this
+        break;
+    }
+}
+
 //=========================================================================
\ No newline at end of file
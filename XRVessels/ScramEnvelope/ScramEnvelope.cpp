@@ -0,0 +1,446 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// ScramEnvelope.cpp
+// Offline SCRAM engine performance envelope generator.
+//
+// Builds XR1Ramjet against a stub vessel (ScramEnvelopeVessel.h) and
+// sweeps a Mach x altitude x throttle grid, writing thrust, TSFC,
+// fuel flow, and the diffuser, burner, and exhaust temperatures
+// reported by XR1Ramjet::Temp for each point as CSV or as a binary
+// table.  The sweep is split across threads.  With --bench nothing is
+// written; instead the run time and a checksum of the results are
+// printed, so the same grid doubles as a regression benchmark for the
+// thrust kernel.
+//
+// Engine parameters default to the "realistic" settings of the
+// selected vessel's XRnGlobals.cpp and may be overridden individually
+// to try new tuning values without flying.
+//
+// Freestream conditions come from the 1976 U.S. Standard Atmosphere up
+// to 86 km and an isothermal exponential atmosphere above that; this is
+// close to, but not identical with, Orbiter's Earth atmosphere model.
+// ==============================================================
+
+#include "ScramEnvelopeVessel.h"
+#include "ScramEnvelopeModel.h"
+#include "XR1Ramjet.h"
+
+#include <charconv>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SCRAM tuning values read by XR1Ramjet; set from the selected vessel preset and command line
+double SCRAM_COOLING;
+double SCRAM_PRESSURE_RECOVERY_MULT;
+double SCRAM_DMA_SCALE;
+
+// Orbiter's Earth atmosphere constants
+static const ATMCONST s_earthAtmConstants = { 101.4e3, 1.293, 286.91, 1.4 };
+
+const ATMCONST *oapiGetPlanetAtmConstants(OBJHANDLE hPlanet)
+{
+    return ((hPlanet == DeltaGliderXR1::GetAtmosphereHandle()) ? &s_earthAtmConstants : nullptr);
+}
+
+// one axis of the sweep grid: count evenly spaced values from Min to Max inclusive
+struct SweepAxis
+{
+    double Min, Max;
+    int Count;
+
+    double At(const int i) const { return ((Count > 1) ? Min + (Max - Min) * i / (Count - 1) : Min); }
+};
+
+struct Options
+{
+    VesselPreset Engine;
+    int SettingIndex = 1;           // 0 = easy, 1 = realistic
+    SweepAxis Mach = { 1.0, 20.0, 100 };
+    SweepAxis Altitude = { 0.0, 80000.0, 100 };
+    SweepAxis Throttle = { 0.0, 1.0, 100 };
+    double DoorFraction = 1.0;
+    bool UsePressureRecoveryTable = false;
+    int ThreadCount = 0;            // 0 = one per hardware thread
+    bool Binary = false;
+    bool Bench = false;
+    int BenchRepeat = 5;
+    const char *pOutputFilename = nullptr;  // nullptr = stdout
+};
+
+// one output row
+static const int FIELD_COUNT = 9;
+static const char *s_fieldNames[FIELD_COUNT] =
+{
+    "mach", "altitude_m", "throttle", "thrust_n", "tsfc_kg_per_ns", "fuel_flow_kg_per_s",
+    "diffuser_temp_k", "burner_temp_k", "exhaust_temp_k"
+};
+struct EnvelopePoint
+{
+    double Value[FIELD_COUNT];
+};
+
+// binary table layout: BinaryHeader followed by one EnvelopePoint per grid point in Mach, altitude, throttle order (throttle varies fastest)
+struct BinaryHeader
+{
+    char Magic[4];              // "XRSE"
+    uint32_t Version;           // 1
+    uint32_t FieldCount;        // FIELD_COUNT doubles per point
+    uint32_t MachCount, AltitudeCount, ThrottleCount;
+};
+
+//-------------------------------------------------------------------------
+
+// Evaluate grid points [first, last) into pOut, which holds the whole grid.
+static void SweepRange(const Options &opt, const vector<FreestreamState> &freestream, const int64_t first, const int64_t last, EnvelopePoint *pOut)
+{
+    DeltaGliderXR1 vessel;
+    vessel.scramdoor_proc = opt.DoorFraction;
+    vessel.scramdoor_status = ((opt.DoorFraction >= 1.0) ? DoorStatus::DOOR_OPEN : (opt.DoorFraction <= 0.0) ? DoorStatus::DOOR_CLOSED : DoorStatus::DOOR_OPENING);
+
+    // Any non-null handle will do for the thruster: the stub vessel applies the same throttle level to every engine.
+    static int s_thruster;
+    XR1Ramjet ramjet(&vessel);
+    ramjet.AddThrusterDefinition(&s_thruster, opt.Engine.FHV[opt.SettingIndex], opt.Engine.IntakeArea, opt.Engine.InternalTeMax, opt.Engine.MaxDMF[opt.SettingIndex]);
+    ramjet.SetPressureRecoveryTableEnabled(opt.UsePressureRecoveryTable);
+
+    const int64_t throttleCount = opt.Throttle.Count;
+    const int64_t altitudeCount = opt.Altitude.Count;
+    double F[1];
+    for (int64_t k = first; k < last; k++)
+    {
+        const int throttleIndex = static_cast<int>(k % throttleCount);
+        const int altitudeIndex = static_cast<int>((k / throttleCount) % altitudeCount);
+        const int machIndex = static_cast<int>(k / (throttleCount * altitudeCount));
+
+        const double mach = opt.Mach.At(machIndex);
+        const double throttle = opt.Throttle.At(throttleIndex);
+        vessel.SetFlightState(mach, freestream[altitudeIndex]);
+        vessel.SetThrottleLevel(throttle);
+        ramjet.Thrust(F);
+
+        double *v = pOut[k].Value;
+        v[0] = mach;
+        v[1] = opt.Altitude.At(altitudeIndex);
+        v[2] = throttle;
+        v[3] = ramjet.GetMostRecentThrust(0);
+        v[4] = ramjet.TSFC(0);
+        v[5] = ramjet.DMF(0);
+        v[6] = ramjet.Temp(0, 0);
+        v[7] = ramjet.Temp(0, 1);
+        v[8] = ramjet.Temp(0, 2);
+    }
+}
+
+// Evaluate the whole grid, split into contiguous ranges across threadCount threads.
+static void Sweep(const Options &opt, const int threadCount, vector<EnvelopePoint> &points)
+{
+    vector<FreestreamState> freestream(opt.Altitude.Count);
+    for (int i = 0; i < opt.Altitude.Count; i++)
+        freestream[i] = ComputeFreestream(opt.Altitude.At(i));
+
+    const int64_t total = static_cast<int64_t>(points.size());
+    vector<thread> threads;
+    for (int t = 0; t < threadCount; t++)
+    {
+        const int64_t first = total * t / threadCount;
+        const int64_t last = total * (t + 1) / threadCount;
+        threads.emplace_back(SweepRange, cref(opt), cref(freestream), first, last, points.data());
+    }
+    for (thread &t : threads)
+        t.join();
+}
+
+// Format points [first, last) as CSV rows; doubles use the shortest text that reads back exactly.
+static void FormatCSV(const vector<EnvelopePoint> &points, const int64_t first, const int64_t last, string &out)
+{
+    out.reserve(static_cast<size_t>(last - first) * FIELD_COUNT * 12);
+    char buf[32];
+    for (int64_t k = first; k < last; k++)
+    {
+        for (int f = 0; f < FIELD_COUNT; f++)
+        {
+            if (f > 0)
+                out += ',';
+            const to_chars_result result = to_chars(buf, buf + sizeof(buf), points[k].Value[f]);
+            out.append(buf, result.ptr);
+        }
+        out += '\n';
+    }
+}
+
+static bool WriteCSV(FILE *pFile, const vector<EnvelopePoint> &points, const int threadCount)
+{
+    for (int f = 0; f < FIELD_COUNT; f++)
+        fprintf(pFile, "%s%s", ((f > 0) ? "," : ""), s_fieldNames[f]);
+    fputc('\n', pFile);
+
+    // formatting is much slower than the sweep itself, so it is split across threads as well
+    const int64_t total = static_cast<int64_t>(points.size());
+    vector<string> chunks(threadCount);
+    vector<thread> threads;
+    for (int t = 0; t < threadCount; t++)
+        threads.emplace_back(FormatCSV, cref(points), total * t / threadCount, total * (t + 1) / threadCount, ref(chunks[t]));
+    for (thread &t : threads)
+        t.join();
+
+    for (const string &chunk : chunks)
+    {
+        if (fwrite(chunk.data(), 1, chunk.size(), pFile) != chunk.size())
+            return false;
+    }
+    return true;
+}
+
+static bool WriteBinary(FILE *pFile, const Options &opt, const vector<EnvelopePoint> &points)
+{
+    BinaryHeader header = { { 'X', 'R', 'S', 'E' }, 1, FIELD_COUNT,
+        static_cast<uint32_t>(opt.Mach.Count), static_cast<uint32_t>(opt.Altitude.Count), static_cast<uint32_t>(opt.Throttle.Count) };
+    if (fwrite(&header, sizeof(header), 1, pFile) != 1)
+        return false;
+    return (fwrite(points.data(), sizeof(EnvelopePoint), points.size(), pFile) == points.size());
+}
+
+// order-dependent checksum of every output value, for comparing kernel changes
+static uint64_t Checksum(const vector<EnvelopePoint> &points)
+{
+    uint64_t hash = 1469598103934665603ULL;     // FNV-1a
+    for (const EnvelopePoint &p : points)
+    {
+        for (int f = 0; f < FIELD_COUNT; f++)
+        {
+            uint64_t bits;
+            memcpy(&bits, &p.Value[f], sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+//-------------------------------------------------------------------------
+
+static void Usage()
+{
+    fprintf(stderr,
+        "Usage: scramenvelope [options]\n"
+        "  --vessel xr1|xr2|xr5     engine preset (default xr1)\n"
+        "  --easy                   use the 'easy' SCRAMfhv/SCRAMdmf values instead of 'realistic'\n"
+        "  --mach min:max:count     Mach axis (default 1:20:100)\n"
+        "  --altitude min:max:count altitude axis in meters (default 0:80000:100)\n"
+        "  --throttle min:max:count throttle axis (default 0:1:100)\n"
+        "  --door fraction          SCRAM door position, 0-1 (default 1)\n"
+        "  --fhv value              override SCRAM_FHV [J/kg]\n"
+        "  --max-dmf value          override max fuel flow [kg/s]\n"
+        "  --intake-area value      override SCRAM_INTAKE_AREA [m^2]\n"
+        "  --temax value            override SCRAM_INTERNAL_TEMAX [K]\n"
+        "  --cooling value          override SCRAM_COOLING\n"
+        "  --recovery-mult value    override SCRAM_PRESSURE_RECOVERY_MULT\n"
+        "  --dma-scale value        override SCRAM_DMA_SCALE\n"
+        "  --table                  read pressure recovery from XR1Ramjet's lookup table\n"
+        "  --threads n              worker threads (default: hardware threads)\n"
+        "  --binary                 write a binary table instead of CSV\n"
+        "  --output file            output file (default stdout)\n"
+        "  --bench [repeat]         time the sweep and print a checksum instead of writing output\n");
+}
+
+static bool ParseDouble(const char *pStr, double &out)
+{
+    char *pEnd;
+    out = strtod(pStr, &pEnd);
+    return ((pEnd != pStr) && (*pEnd == 0));
+}
+
+static bool ParseAxis(const char *pStr, SweepAxis &axis)
+{
+    double minVal, maxVal;
+    int count;
+    char trailing;
+    if (sscanf(pStr, "%lf:%lf:%d%c", &minVal, &maxVal, &count, &trailing) != 3)
+        return false;
+    if (count < 1)
+        return false;
+    axis = { minVal, maxVal, count };
+    return true;
+}
+
+// Returns true on success, false on a command-line error.
+static bool ParseArguments(const int argc, char **argv, Options &opt)
+{
+    opt.Engine = s_vesselPresets[0];
+
+    // First pass: the vessel preset and easy/realistic selection, which the override options below apply on top of.
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--vessel") == 0) && (i + 1 < argc))
+        {
+            const char *pName = argv[++i];
+            bool found = false;
+            for (const VesselPreset &preset : s_vesselPresets)
+            {
+                if (strcasecmp(pName, preset.pName) == 0)
+                {
+                    opt.Engine = preset;
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                fprintf(stderr, "Unknown vessel: %s\n", pName);
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--easy") == 0)
+        {
+            opt.SettingIndex = 0;
+        }
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pArg = argv[i];
+        const char *pValue = ((i + 1 < argc) ? argv[i + 1] : nullptr);
+        bool ok = true;
+        bool consumedValue = true;
+
+        if (strcmp(pArg, "--vessel") == 0)             ok = (pValue != nullptr);
+        else if (strcmp(pArg, "--mach") == 0)          ok = (pValue && ParseAxis(pValue, opt.Mach));
+        else if (strcmp(pArg, "--altitude") == 0)      ok = (pValue && ParseAxis(pValue, opt.Altitude));
+        else if (strcmp(pArg, "--throttle") == 0)      ok = (pValue && ParseAxis(pValue, opt.Throttle));
+        else if (strcmp(pArg, "--door") == 0)          ok = (pValue && ParseDouble(pValue, opt.DoorFraction));
+        else if (strcmp(pArg, "--fhv") == 0)           ok = (pValue && ParseDouble(pValue, opt.Engine.FHV[opt.SettingIndex]));
+        else if (strcmp(pArg, "--max-dmf") == 0)       ok = (pValue && ParseDouble(pValue, opt.Engine.MaxDMF[opt.SettingIndex]));
+        else if (strcmp(pArg, "--intake-area") == 0)   ok = (pValue && ParseDouble(pValue, opt.Engine.IntakeArea));
+        else if (strcmp(pArg, "--temax") == 0)         ok = (pValue && ParseDouble(pValue, opt.Engine.InternalTeMax));
+        else if (strcmp(pArg, "--cooling") == 0)       ok = (pValue && ParseDouble(pValue, opt.Engine.Cooling));
+        else if (strcmp(pArg, "--recovery-mult") == 0) ok = (pValue && ParseDouble(pValue, opt.Engine.PressureRecoveryMult));
+        else if (strcmp(pArg, "--dma-scale") == 0)     ok = (pValue && ParseDouble(pValue, opt.Engine.DmaScale));
+        else if (strcmp(pArg, "--threads") == 0)       ok = (pValue && (sscanf(pValue, "%d", &opt.ThreadCount) == 1) && (opt.ThreadCount >= 0));
+        else if (strcmp(pArg, "--output") == 0)        { ok = (pValue != nullptr); opt.pOutputFilename = pValue; }
+        else
+        {
+            consumedValue = false;
+            if (strcmp(pArg, "--easy") == 0)            { }
+            else if (strcmp(pArg, "--table") == 0)      opt.UsePressureRecoveryTable = true;
+            else if (strcmp(pArg, "--binary") == 0)     opt.Binary = true;
+            else if (strcmp(pArg, "--bench") == 0)
+            {
+                opt.Bench = true;
+                if (pValue && (pValue[0] != '-'))
+                {
+                    ok = ((sscanf(pValue, "%d", &opt.BenchRepeat) == 1) && (opt.BenchRepeat > 0));
+                    consumedValue = true;
+                }
+            }
+            else
+            {
+                fprintf(stderr, "Unknown option: %s\n", pArg);
+                return false;
+            }
+        }
+
+        if (!ok)
+        {
+            fprintf(stderr, "Missing or invalid value for %s\n", pArg);
+            return false;
+        }
+        if (consumedValue)
+            i++;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--help") == 0) || (strcmp(argv[i], "-h") == 0))
+        {
+            Usage();
+            return 0;
+        }
+    }
+
+    Options opt;
+    if (!ParseArguments(argc, argv, opt))
+    {
+        Usage();
+        return 1;
+    }
+
+    // must be set before XR1Ramjet builds its pressure recovery table on the first Thrust call
+    SCRAM_COOLING = opt.Engine.Cooling;
+    SCRAM_PRESSURE_RECOVERY_MULT = opt.Engine.PressureRecoveryMult;
+    SCRAM_DMA_SCALE = opt.Engine.DmaScale;
+
+    int threadCount = opt.ThreadCount;
+    if (threadCount == 0)
+        threadCount = max(1, static_cast<int>(thread::hardware_concurrency()));
+
+    const int64_t total = static_cast<int64_t>(opt.Mach.Count) * opt.Altitude.Count * opt.Throttle.Count;
+    vector<EnvelopePoint> points(static_cast<size_t>(total));
+
+    if (opt.Bench)
+    {
+        double bestSeconds = 1e30;
+        for (int i = 0; i < opt.BenchRepeat; i++)
+        {
+            const auto start = chrono::steady_clock::now();
+            Sweep(opt, threadCount, points);
+            const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+            bestSeconds = min(bestSeconds, elapsed.count());
+        }
+        printf("vessel=%s points=%lld threads=%d best=%.6f s (%.1f Mpoints/s) checksum=%016llx\n",
+            opt.Engine.pName, static_cast<long long>(total), threadCount, bestSeconds, total / bestSeconds / 1e6,
+            static_cast<unsigned long long>(Checksum(points)));
+        return 0;
+    }
+
+    Sweep(opt, threadCount, points);
+
+    FILE *pFile = stdout;
+    if (opt.pOutputFilename)
+    {
+        pFile = fopen(opt.pOutputFilename, (opt.Binary ? "wb" : "w"));
+        if (pFile == nullptr)
+        {
+            fprintf(stderr, "Could not open %s: %s\n", opt.pOutputFilename, strerror(errno));
+            return 1;
+        }
+    }
+
+    bool ok = (opt.Binary ? WriteBinary(pFile, opt, points) : WriteCSV(pFile, points, threadCount));
+    if (pFile != stdout)
+        ok &= (fclose(pFile) == 0);
+    if (!ok)
+    {
+        fprintf(stderr, "Error writing output\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// ScramEnvelopeModel.h
+// Freestream conditions and per-vessel SCRAM engine parameters
+// shared by ScramEnvelope and the XRChecks ramjet sweep check.
+// ==============================================================
+
+#pragma once
+
+#include "ScramEnvelopeVessel.h"
+
+// SCRAM engine parameters for one vessel class; see each vessel's XRnGlobals.cpp.
+// Array values are indexed the same way as the config file's SCRAMfhv and SCRAMdmf settings: 0 = easy, 1 = realistic.
+struct VesselPreset
+{
+    const char *pName;
+    double FHV[2];              // SCRAM_FHV
+    double MaxDMF[2];           // XR1ConfigFileParser::m_scramMaxDMF
+    double IntakeArea;          // SCRAM_INTAKE_AREA
+    double InternalTeMax;       // SCRAM_INTERNAL_TEMAX
+    double Cooling;             // SCRAM_COOLING
+    double PressureRecoveryMult;// SCRAM_PRESSURE_RECOVERY_MULT
+    double DmaScale;            // SCRAM_DMA_SCALE
+};
+
+static const VesselPreset s_vesselPresets[] =
+{
+    { "xr1", { 3.5e8, 2.0e8 }, {  3.0,  2.0 },  1.0,     16000, 2.0,    0.9,   1.35e-4 },
+    { "xr2", { 4.2e8, 2.4e8 }, {  9.0,  6.0 },  1.34,    20500, 2.5625, 0.765, 1.1475e-4 },
+    { "xr5", { 7.0e8, 4.0e8 }, { 66.0, 44.0 }, 12.2098,  20500, 2.5625, 0.765, 1.1475e-4 },
+};
+
+// 1976 U.S. Standard Atmosphere below 86 km geometric altitude, isothermal above
+inline FreestreamState ComputeFreestream(const double altitude)
+{
+    static const double g0 = 9.80665;
+    static const double Rair = 287.053;
+    static const double earthRadius = 6356766.0;    // used for geopotential altitude
+
+    // layer base geopotential altitude [m], base temperature [K], lapse rate [K/m], and base pressure [Pa]
+    static const double layerBase[] = { 0, 11000, 20000, 32000, 47000, 51000, 71000, 84852 };
+    static const double lapseRate[] = { -0.0065, 0, 0.001, 0.0028, 0, -0.0028, -0.002, 0 };
+    static const int LAYER_COUNT = sizeof(layerBase) / sizeof(layerBase[0]);
+
+    static double baseTemp[LAYER_COUNT], basePressure[LAYER_COUNT];
+    static const bool s_initialized = []
+    {
+        baseTemp[0] = 288.15;
+        basePressure[0] = 101325.0;
+        for (int i = 1; i < LAYER_COUNT; i++)
+        {
+            const double dh = layerBase[i] - layerBase[i - 1];
+            baseTemp[i] = baseTemp[i - 1] + lapseRate[i - 1] * dh;
+            if (lapseRate[i - 1] == 0)
+                basePressure[i] = basePressure[i - 1] * exp(-g0 * dh / (Rair * baseTemp[i - 1]));
+            else
+                basePressure[i] = basePressure[i - 1] * pow(baseTemp[i] / baseTemp[i - 1], -g0 / (Rair * lapseRate[i - 1]));
+        }
+        return true;
+    }();
+    (void)s_initialized;
+
+    const double h = earthRadius * max(altitude, 0.0) / (earthRadius + max(altitude, 0.0));   // geopotential altitude
+    int layer = LAYER_COUNT - 1;
+    while ((layer > 0) && (h < layerBase[layer]))
+        layer--;
+
+    const double dh = h - layerBase[layer];
+    FreestreamState fs;
+    fs.Temperature = baseTemp[layer] + lapseRate[layer] * dh;
+    if (lapseRate[layer] == 0)
+        fs.Pressure = basePressure[layer] * exp(-g0 * dh / (Rair * baseTemp[layer]));
+    else
+        fs.Pressure = basePressure[layer] * pow(fs.Temperature / baseTemp[layer], -g0 / (Rair * lapseRate[layer]));
+    fs.Density = fs.Pressure / (Rair * fs.Temperature);
+    return fs;
+}
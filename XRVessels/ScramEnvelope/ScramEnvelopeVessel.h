@@ -0,0 +1,84 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// ScramEnvelopeVessel.h
+// Minimal stand-in for DeltaGliderXR1 that supplies everything
+// XR1Ramjet reads: Mach number, freestream temperature, pressure and
+// density, thruster level, and the SCRAM door state.  XR1Ramjet is
+// compiled against this header by defining XR1RAMJET_VESSEL_HEADER.
+// ==============================================================
+
+#pragma once
+
+#include "Orbitersdk.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+enum class DoorStatus { NOT_SET = -2, DOOR_FAILED, DOOR_CLOSED, DOOR_OPEN, DOOR_CLOSING, DOOR_OPENING };
+
+// SCRAM tuning values that XR1Ramjet reads directly.  In the vessels these are const globals in XRnGlobals.cpp;
+// here they are writable so they can be set from the command line.  They must be set before the first Thrust call.
+extern double SCRAM_COOLING;
+extern double SCRAM_PRESSURE_RECOVERY_MULT;
+extern double SCRAM_DMA_SCALE;
+
+// freestream conditions at one altitude
+struct FreestreamState
+{
+    double Temperature;     // K
+    double Pressure;        // Pa
+    double Density;         // kg/m^3
+};
+
+class DeltaGliderXR1
+{
+public:
+    DeltaGliderXR1() :
+        scramdoor_proc(1.0), scramdoor_status(DoorStatus::DOOR_OPEN),
+        m_mach(0), m_freestream{ 0, 0, 0 }, m_throttleLevel(0)
+    {
+    }
+
+    void SetFlightState(const double mach, const FreestreamState &freestream) { m_mach = mach; m_freestream = freestream; }
+    void SetThrottleLevel(const double level) { m_throttleLevel = level; }
+
+    // VESSEL methods used by XR1Ramjet
+    OBJHANDLE GetAtmRef() const { return ((m_freestream.Pressure > 0) ? GetAtmosphereHandle() : nullptr); }
+    double GetMachNumber() const { return m_mach; }
+    double GetExternalTemperature() const { return m_freestream.Temperature; }
+    double GetAtmPressure() const { return m_freestream.Pressure; }
+    double GetAtmDensity() const { return m_freestream.Density; }
+    double GetThrusterLevel(THRUSTER_HANDLE th) const { return m_throttleLevel; }
+
+    // the one (Earth) atmosphere the tool models
+    static OBJHANDLE GetAtmosphereHandle() { static int s_earth; return &s_earth; }
+
+    double scramdoor_proc;          // 0 = closed, 1 = open
+    DoorStatus scramdoor_status;
+
+protected:
+    double m_mach;
+    FreestreamState m_freestream;
+    double m_throttleLevel;
+};
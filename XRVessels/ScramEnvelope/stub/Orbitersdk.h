@@ -0,0 +1,42 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// Orbitersdk.h (ScramEnvelope stub)
+// The handful of Orbiter SDK types that XR1Ramjet needs, so that it
+// can be built without the SDK.  Only ScramEnvelope includes this.
+// ==============================================================
+
+#pragma once
+
+typedef void *OBJHANDLE;
+typedef void *THRUSTER_HANDLE;
+
+// subset of the SDK's ATMCONST: XR1Ramjet only reads gamma and R
+typedef struct
+{
+    double p0;      // pressure at mean radius ('sea level') [Pa]
+    double rho0;    // density at mean radius [kg/m^3]
+    double R;       // specific gas constant [J/(K kg)]
+    double gamma;   // ratio of specific heats, c_p/c_v
+} ATMCONST;
+
+const ATMCONST *oapiGetPlanetAtmConstants(OBJHANDLE hPlanet);
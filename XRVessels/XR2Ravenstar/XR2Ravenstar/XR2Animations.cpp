@@ -32,42 +32,6 @@
 // size of a mesh group array
 #define SizeOfGrp(grp) (sizeof(grp) / sizeof(unsigned int))
 
-// Virtual Gateway method that decides which animations are valid for this vessel; if the incoming animation handle is valid, 
-// the call is propogated up to SetAnimation.  Otherwise, this method returns without changing the animation state.
-#define ALLOW(handlePtr)  if (&anim == &(handlePtr)) { SetAnimation(anim, state); return; }
-void XR2Ravenstar::SetXRAnimation(const unsigned int &anim, const double state) const
-{
-    ALLOW(anim_rcover);       // handle for retro cover animation
-    ALLOW(anim_hoverdoor);    // handle for hover doors animation
-    ALLOW(anim_scramdoor);    // handle for scram doors animation
-    ALLOW(anim_nose);         // handle for nose cone animation
-    ALLOW(anim_olock);        // handle for outer airlock animation
-    ALLOW(anim_ilock);        // handle for inner airlock animation
-    ALLOW(anim_hatch);        // handle for top hatch animation
-    ALLOW(anim_radiator);     // handle for radiator animation
-    ALLOW(anim_rudder);       // handle for rudder animation
-	ALLOW(anim_elevator);     // handle for elevator animation
-	ALLOW(anim_elevatortrim); // handle for elevator trim animation
-	ALLOW(anim_laileron);     // handle for left aileron animation
-	ALLOW(anim_raileron);     // handle for right aileron animation
-	ALLOW(anim_brake);        // handle for airbrake animation
-    ALLOW(anim_fuelhatch);    // handle for fuel hatch animation
-    ALLOW(anim_loxhatch);     // handle for LOX hatch animation
-    ALLOW(anim_gear);         // handle for landing gear animation
-
-    // New for XR2
-    ALLOW(anim_bay);          // handle for bay doors animation
-    ALLOW(m_animFrontTireRotation);
-    ALLOW(m_animRearTireRotation);
-    /* Not until the MK II
-    ALLOW(m_animNoseGearCompression);
-    ALLOW(m_animRearGearCompression);
-    */
-
-    // NO: ALLOW(m_animNosewheelSteering); 
-	// NO: ALLOW(anim_ladder);       // handle for front escape ladder animation
-}
-
 // --------------------------------------------------------------
 // Define animation sequences for moving parts
 // Invoked by our constructor.
@@ -516,6 +480,37 @@ void XR2Ravenstar::DefineAnimations()
     AddAnimationComponent(anim_bay, 0, 1, &StarboardBayDoors1);
     AddAnimationComponent(anim_bay, 0, 1, &StarboardBayDoors2);
     AddAnimationComponent(anim_bay, 0, 1, &StarboardBayDoors3);
+
+    // Only these animations are valid for this vessel; SetXRAnimation ignores all others.
+    RegisterXRAnimation(anim_rcover);       // handle for retro cover animation
+    RegisterXRAnimation(anim_hoverdoor);    // handle for hover doors animation
+    RegisterXRAnimation(anim_scramdoor);    // handle for scram doors animation
+    RegisterXRAnimation(anim_nose);         // handle for nose cone animation
+    RegisterXRAnimation(anim_olock);        // handle for outer airlock animation
+    RegisterXRAnimation(anim_ilock);        // handle for inner airlock animation
+    RegisterXRAnimation(anim_hatch);        // handle for top hatch animation
+    RegisterXRAnimation(anim_radiator);     // handle for radiator animation
+    RegisterXRAnimation(anim_rudder);       // handle for rudder animation
+    RegisterXRAnimation(anim_elevator);     // handle for elevator animation
+    RegisterXRAnimation(anim_elevatortrim); // handle for elevator trim animation
+    RegisterXRAnimation(anim_laileron);     // handle for left aileron animation
+    RegisterXRAnimation(anim_raileron);     // handle for right aileron animation
+    RegisterXRAnimation(anim_brake);        // handle for airbrake animation
+    RegisterXRAnimation(anim_fuelhatch);    // handle for fuel hatch animation
+    RegisterXRAnimation(anim_loxhatch);     // handle for LOX hatch animation
+    RegisterXRAnimation(anim_gear);         // handle for landing gear animation
+
+    // New for XR2
+    RegisterXRAnimation(anim_bay);          // handle for bay doors animation
+    RegisterXRAnimation(m_animFrontTireRotation);
+    RegisterXRAnimation(m_animRearTireRotation);
+    /* Not until the MK II
+    RegisterXRAnimation(m_animNoseGearCompression);
+    RegisterXRAnimation(m_animRearGearCompression);
+    */
+
+    // NO: RegisterXRAnimation(m_animNosewheelSteering); 
+    // NO: RegisterXRAnimation(anim_ladder);       // handle for front escape ladder animation
 }
 
 // delete any child animation objects; invoked by our destructor
@@ -150,6 +150,11 @@ XR2Ravenstar::XR2Ravenstar(OBJHANDLE hObj, int fmodel, XR2ConfigFileParser *pCon
     // init new doors
     bay_status = DoorStatus::DOOR_CLOSED;
     bay_proc   = 0.0;
+    RegisterDoor(bay_status, bay_proc, BAY_OPERATING_SPEED, &anim_bay, AID_BAYDOORSINDICATOR, true, "PAYLOAD_BAY_DOORS");
+    AddDoorDamageRule(bay_status, bay_proc, m_topHullTemp, nullptr, BAY_LIMIT,
+        &m_xr2WarningLights[static_cast<int>(XR2WarningLight::wl2Bay)], DoorFailureAction::None, nullptr,
+        "Warning Bay Door Failure.wav", "Bay doors FAILED due to excessive&heat and/or dynamic pressure!",
+        "Warning Bay Doors Open.wav", "Bay doors are open:&close them or reduce speed!");
 
     // replace the data HUD font with a smaller one
     // XR1 ORG: m_pDataHudFont = CreateFont(20, 0, 0, 0, 700, 0, 0, 0, 0, 0, 0, NONANTIALIASED_QUALITY, 0, "Tahoma");
@@ -69,18 +69,14 @@ public:
     virtual bool clbkPanelRedrawEvent(int areaID, int event, SURFHANDLE surf);
 
     // overridden superclass methods
-    virtual void SetXRAnimation(const unsigned int &anim, const double state) const;
     virtual void DefineAnimations();
     virtual void CleanUpAnimations();
     virtual void TweakInternalValue(bool direction);  // used for developement testing only; usually an empty method
     virtual void ApplySkin();
     virtual void PerformCrashDamage();
-    virtual bool CheckAllDoorDamage();
-    virtual bool CheckHullHeatingDamage();
     virtual bool IsWarningPresent();
-    virtual const DamageStatus &GetDamageStatus(DamageItem item) const;
+    virtual void ComputeDamageStatus(DamageItem item, DamageStatus &status, const bool includeLabels) const;
     virtual void SetDamageStatus(DamageItem item, double fracIntegrity);
-    virtual bool CheckDoorFailure(DoorStatus *doorStatus);
     virtual void SetGearParameters(double state);
     virtual bool PerformEVA(const int mmuCrewMemberIndex);
 
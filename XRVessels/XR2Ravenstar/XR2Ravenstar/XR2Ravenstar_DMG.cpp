@@ -43,38 +43,6 @@ void XR2Ravenstar::PerformCrashDamage()
     m_xr2WarningLights[static_cast<int>(XR2WarningLight::wl2Bay)] = true;
 }
 
-//
-// Check for door-related heat and/or dynamic pressure damage here
-// Note that a given damange type is only checked if it is enabled.
-//
-// Returns: true if any damage detected, false otherwise
-bool XR2Ravenstar::CheckAllDoorDamage()
-{
-    bool newdamage = DeltaGliderXR1::CheckAllDoorDamage();  // check common systems
-
-    newdamage |= CheckDoorFailure(&bay_status);
-
-    return newdamage;  
-}
-
-
-//
-// Check all hull surfaces for heat damage.
-// 
-// NOTE: CheckTemperature will turn on warning lights for doors and hull temp as necessary; however
-// we must reset the HTMP light ourselves since any surface can trigger it.  CheckTemperature will only 
-// SET the light, never CLEAR it.  Therefore, we clear it here ourselves.
-//
-// Returns: true if any surface damaged, false otherwise
-bool XR2Ravenstar::CheckHullHeatingDamage()
-{
-    bool newdamage = DeltaGliderXR1::CheckHullHeatingDamage();  // check common systems; includes payload bay doors open check
-
-    // no additional damage checks at this time
-
-    return newdamage;
-}
-
 // Note: base class IsDamagePresent() method is sufficient
 
 // Check whether ANY warning is active.  Invoked on startup.
@@ -101,9 +69,9 @@ bool XR2Ravenstar::IsWarningPresent()
     return retVal;
 }
 
-// returns DamageStatus (a static variable)
+// Populates 'status' for the given item; if includeLabels is false, only status.fracIntegrity is updated.
 // This queries the actual SYSTEM STATE (e.g., current thrust output) to determine whether an item is damaged.
-const DamageStatus &XR2Ravenstar::GetDamageStatus(DamageItem item) const
+void XR2Ravenstar::ComputeDamageStatus(DamageItem item, DamageStatus &status, const bool includeLabels) const
 {
     double frac;
     const char *pLabel;
@@ -120,18 +88,18 @@ const DamageStatus &XR2Ravenstar::GetDamageStatus(DamageItem item) const
         break;
 
     default:
-        return DeltaGliderXR1::GetDamageStatus(item);  // let the superclass handle it
+        DeltaGliderXR1::ComputeDamageStatus(item, status, includeLabels);  // let the superclass handle it
+        return;
     }
 
     // populate the structure
-    static DamageStatus dmgStatus;
-    
-    dmgStatus.fracIntegrity = frac;
-    strcpy(dmgStatus.label, pLabel);
-    strcpy(dmgStatus.shortLabel, pShortLabel);
-    dmgStatus.onlineOffline = onlineOffline;
-
-    return dmgStatus;   // return by reference
+    status.fracIntegrity = frac;
+    if (includeLabels)
+    {
+        strcpy(status.label, pLabel);
+        strcpy(status.shortLabel, pShortLabel);
+        status.onlineOffline = onlineOffline;
+    }
 }
 
 // Sets system damage based on an integrity value; invoked at load time
@@ -156,6 +124,8 @@ void XR2Ravenstar::SetDamageStatus(DamageItem item, double fracIntegrity)
         return;
     }
 
+    UpdateDamageStatusTable();
+
     // if any damage present, let's apply it (also calls SetDamageVisuals)
     if (IsDamagePresent())   
     {
@@ -165,68 +135,6 @@ void XR2Ravenstar::SetDamageStatus(DamageItem item, double fracIntegrity)
 }
 
 
-// Fail a door if dynamic pressure exceeds limits, or issue a warning if a door is 
-// open and dynamic pressure is high enough, if heating == 25% of failure heat level.
-// Returns: true if door FAILED, false otherwise
-bool XR2Ravenstar::CheckDoorFailure(DoorStatus *doorStatus)
-{
-    bool retVal = false;        // assume no damage
-
-    // check for our new doors first
-
-    // do not re-check or warn if door already failed
-    bool doorOpen = ((*doorStatus != DoorStatus::DOOR_CLOSED) && (*doorStatus != DoorStatus::DOOR_FAILED));
-    const double dt = oapiGetSimStep();
-
-    if (doorOpen)
-    {
-        // Door is open!  Check for damage or failure.
-        // NOTE: once a door fails, it can only be repaired via the damage dialog; therefore, we never reset it here
-
-        // check NEW doors for the XR2 first
-        if (doorStatus == &bay_status)
-        {
-            const double doorProc = bay_proc;
-            if (IS_DOOR_FAILURE(m_topHullTemp, BAY_LIMIT))
-            {
-                ShowWarning("Warning Bay Door Failure.wav", DeltaGliderXR1::ST_WarningCallout, "Bay doors FAILED due to excessive&heat and/or dynamic pressure!", true); // force this
-                *doorStatus = DoorStatus::DOOR_FAILED;
-                m_xr2WarningLights[static_cast<int>(XR2WarningLight::wl2Bay)] = true;
-                retVal = true;   // new damage
-            }
-            else if (IS_DOOR_WARNING(m_topHullTemp, BAY_LIMIT))
-            {
-                ShowWarning("Warning Bay Doors Open.wav", DeltaGliderXR1::ST_WarningCallout, "Bay doors are open:&close them or reduce speed!");
-                m_xr2WarningLights[static_cast<int>(XR2WarningLight::wl2Bay)] = true;
-            }
-            else if (IS_DOOR_FAILED() == false) 
-                m_xr2WarningLights[static_cast<int>(XR2WarningLight::wl2Bay)] = false;   // reset light
-        }
-        else    // one of the unmodified doors, so let the base class handle it
-            retVal = DeltaGliderXR1::CheckDoorFailure(doorStatus);    // let our superclass handle it
-    }
-    else   // door is either CLOSED or FAILED
-    {
-        if (IS_DOOR_FAILED() == false)
-        {
-            // only need to handle NEW doors here
-            // door is closed; reset the warning light
-            if (doorStatus == &bay_status)
-                m_xr2WarningLights[static_cast<int>(XR2WarningLight::wl2Bay)] = false;
-            else
-            {
-                // notify our superclass
-                retVal = DeltaGliderXR1::CheckDoorFailure(doorStatus);
-            }
-        }
-        else  // door is failed; notify our superclass
-            retVal = DeltaGliderXR1::CheckDoorFailure(doorStatus);
-    }
-
-    return retVal;
-}
-
-
 // elevon mesh groups
 static unsigned int LAileronGrp[] = {GRP_top_elevators_top01_port, GRP_top_elevators_bottom_port, GRP_bottom_elevators_bottom_port, GRP_bottom_elevators_bottom_port_fixup_1, GRP_bottom_elevators_bottom_port01, 
         GRP_top_elevators_bottom_starboard_fixup_4, /* This is actually *PORT TOP piece */
@@ -843,6 +843,8 @@ void XR2Ravenstar::clbkPostCreation()
     AddPreStep(new NosewheelSteeringPreStep(*this));  // NOTE: REMOVE THIS LINE IF AND WHEN XR2NosewheelSteeringPreStep IS IMPLEMENTED!
     AddPreStep(new UpdateVesselLightsPreStep(*this));
     AddPreStep(new ParkingBrakePreStep(*this));
+    if (*GetXR1Config()->StartupScript)  // user wants a script run when the simulation starts?
+        AddPreStep(new StartupScriptPreStep(*this));
 
     // NO: AddPreStep(new XR2NosewheelSteeringPreStep             (*this)); 
     // not until the Mk II: AddPreStep(new AnimateGearCompressionPrePostStep(*this));
@@ -857,6 +859,7 @@ void XR2Ravenstar::clbkPostCreation()
     AddPostStep(new ComputeAccPostStep(*this));   // used by acc areas; computed only once per frame for efficiency
     // XRSound: AddPostStep(new AmbientSoundsPostStep       (*this));
     AddPostStep(new ShowWarningPostStep(*this));
+    AddPostStep(new CalloutQueuePostStep(*this));
     AddPostStep(new SetHullTempsPostStep(*this));
     AddPostStep(new SetSlopePostStep(*this));
     AddPostStep(new FuelCalloutsPostStep(*this));
@@ -865,8 +868,7 @@ void XR2Ravenstar::clbkPostCreation()
     AddPostStep(new UpdateMassPostStep(*this));
 
     AddPostStep(new SwitchTwoDPanelPostStep(*this));
-    AddPostStep(new AnimationPostStep(*this));  // Note: this should be BEFORE XR2AnimationPostStep so the gear animates correctly
-    AddPostStep(new XR2AnimationPostStep(*this));
+    AddPostStep(new AnimationPostStep(*this));  // also animates the bay doors registered in our constructor
     AddPostStep(new XR2DoorSoundsPostStep(*this));
 
     AddPostStep(new OneShotInitializationPostStep(*this));
@@ -882,6 +884,13 @@ void XR2Ravenstar::clbkPostCreation()
     AddPostStep(new ManageMWSPostStep(*this));
     if (GetXR1Config()->EnableBoilOffExhaustEffect)  // user wants boil-off effect?
         AddPostStep(new BoilOffPostStep(*this));
+    if (GetXR1Config()->FlightDataRecorderEnabled)  // user wants XR state recorded and replayed along with Orbiter's flight recorder?
+    {
+        AddPostStep(new FlightDataPlaybackPostStep(*this));
+        AddPostStep(new FlightDataRecorderPostStep(*this));
+    }
+    if (GetXR1Config()->TelemetryExportEnabled)  // user wants telemetry exported to shared memory?
+        AddPostStep(new TelemetryExportPostStep(*this));
 
 #ifdef _DEBUG
     AddPostStep(new TestXRVesselCtrlPostStep(*this));      // for manual testing of new XRVesselCtrl methods via the debugger
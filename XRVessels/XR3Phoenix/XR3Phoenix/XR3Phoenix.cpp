@@ -156,6 +156,28 @@ XR3Phoenix::XR3Phoenix(OBJHANDLE hObj, int fmodel, XR3ConfigFileParser *pConfigF
     crewElevator_proc   = 0.0;
     bay_status          = DoorStatus::DOOR_CLOSED;
     bay_proc            = 0.0;
+    RegisterDoor(bay_status, bay_proc, BAY_OPERATING_SPEED, &anim_bay, AID_BAYDOORSINDICATOR, true, "PAYLOAD_BAY_DOORS");
+    RegisterDoor(crewElevator_status, crewElevator_proc, ELEVATOR_OPERATING_SPEED, &anim_crewElevator, AID_ELEVATORINDICATOR, true, "CREW_ELEVATOR");
+
+    // add damage limits for our new doors
+    AddDoorDamageRule(crewElevator_status, crewElevator_proc, m_noseconeTemp, nullptr, ELEVATOR_LIMIT,
+        &m_XR3WarningLights[static_cast<int>(XR3WarningLight::wl3Elev)], DoorFailureAction::JamDoor, &anim_crewElevator,
+        "Warning Elevator Failure.wav", "Elevator FAILED due to excessive&heat and/or dynamic pressure!",
+        "Warning Elevator Deployed.wav", "Elevator is deployed:&retract it or reduce speed!");
+    AddDoorDamageRule(bay_status, bay_proc, m_topHullTemp, nullptr, BAY_LIMIT,
+        &m_XR3WarningLights[static_cast<int>(XR3WarningLight::wl3Bay)], DoorFailureAction::None, nullptr,
+        "Warning Bay Door Failure.wav", "Bay doors FAILED due to excessive&heat and/or dynamic pressure!",
+        "Warning Bay Doors Open.wav", "Bay doors are open:&close them or reduce speed!");
+
+    // nosecone max temp is tied to the retro doors and our crew elevator
+    AddHullBreachRule(m_noseconeTemp, &HullTemperatureLimits::noseCone, crewElevator_status, "LOWER HULL");
+    AddHullBreachRule(m_noseconeTemp, &HullTemperatureLimits::noseCone, rcover_status, "LOWER HULL");
+
+    // top hull max temp is also tied to the docking port (uses NOSECONE animation and status)
+    AddHullBreachRule(m_topHullTemp, &HullTemperatureLimits::topHull, nose_status, "TOP HULL");
+
+    // our retro doors are not on the wings, so opening them does not affect the wings' heat limit
+    m_pWingHeatingDoorStatus = nullptr;
 
     // XR3TODO: define VC font
     // replace the data HUD font with a smaller one
@@ -535,7 +557,7 @@ void XR3Phoenix::ConfigureRCSJets(bool dockingMode)
     {
         // get integrity fraction
         int damageIntegrityIndex = static_cast<int>(DamageItem::RCS1) + i;    // 0 <= i <= 13
-        DamageStatus ds = GetDamageStatus((DamageItem)damageIntegrityIndex);
+        const DamageStatus &ds = GetDamageStatus((DamageItem)damageIntegrityIndex);
         SetThrusterMax0(th_rcs[i], (GetRCSThrustMax(i) * rcsThrusterPowerFrac * ds.fracIntegrity));  
     }
 
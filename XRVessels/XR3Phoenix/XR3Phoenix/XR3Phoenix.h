@@ -80,12 +80,9 @@ public:
     virtual void clbkNavMode (int mode, bool active);
     virtual void SetGearParameters (double state);
     virtual void PerformCrashDamage();
-    virtual bool CheckAllDoorDamage();
-    virtual bool CheckHullHeatingDamage();
     virtual bool IsWarningPresent();
-    virtual const DamageStatus &GetDamageStatus(DamageItem item) const;
+    virtual void ComputeDamageStatus(DamageItem item, DamageStatus &status, const bool includeLabels) const;
     virtual void SetDamageStatus(DamageItem item, double fracIntegrity);
-    virtual bool CheckDoorFailure(DoorStatus *doorStatus);
     virtual void CleanUpAnimations();   // invoked by XR1's destructor
     virtual void ActivateRadiator(DoorStatus action);
     virtual void ActivateLandingGear(DoorStatus action);
@@ -107,11 +104,6 @@ public:
     void CreatePayloadBay();
     void SetActiveEVAPort(ACTIVE_EVA_PORT newState);
 
-    // WARNING: All code should invoke SetXRAnimation instead of SetXRAnimation!  The reason is that 
-    // SetXRAnimation always assumes that the handle is valid, and so SetXRAnimation is a virtual "gateway" 
-    // method that allows each subclass to determine whether that animation is valid or not for that vessel.
-    virtual void SetXRAnimation(const unsigned int &anim, const double state) const;
-
     // mesh indicies
     unsigned int m_exteriorMeshIndex;
 
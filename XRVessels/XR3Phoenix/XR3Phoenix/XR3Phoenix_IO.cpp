@@ -90,6 +90,7 @@ void XR3Phoenix::clbkSaveState (FILEHANDLE scn)
     WriteXRCommonScenarioLines(scn);        // save common data
 
     // XR3-specific data
-    oapiWriteScenario_int(scn, "RCS_DOCKING_MODE", static_cast<int>(m_rcsDockingMode));
-    oapiWriteScenario_int(scn, "ACTIVE_EVA_PORT", static_cast<int>(m_activeEVAPort));
+    m_scenarioWriter.WriteInt("RCS_DOCKING_MODE", static_cast<int>(m_rcsDockingMode));
+    m_scenarioWriter.WriteInt("ACTIVE_EVA_PORT", static_cast<int>(m_activeEVAPort));
+    m_scenarioWriter.Flush(scn);
 }
@@ -34,83 +34,6 @@
 
 //---------------------------------------------------------------------------
 
-XR3AnimationPostStep::XR3AnimationPostStep(XR3Phoenix &vessel) : 
-    XR3PrePostStep(vessel)
-{
-}
-
-void XR3AnimationPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
-{
-    // animate doors that require hydraulic pressure
-    if (GetXR3().CheckHydraulicPressure(false, false))     // do not log a warning nor play an error beep here!  We are merely querying the state.
-    {
-        AnimateBayDoors(simt, simdt, mjd);
-        AnimateElevator(simt, simdt, mjd);
-    }
-}
-
-void XR3AnimationPostStep::AnimateBayDoors(const double simt, const double simdt, const double mjd)
-{
-    // animate the payload bay doors
-    if (GetXR3().bay_status >= DoorStatus::DOOR_CLOSING)  // closing or opening
-    {
-        double da = simdt * BAY_OPERATING_SPEED;
-        if (GetXR3().bay_status == DoorStatus::DOOR_CLOSING)
-        {
-            if (GetXR3().bay_proc > 0.0)
-                GetXR3().bay_proc = max(0.0, GetXR3().bay_proc - da);
-            else
-            {
-                GetXR3().bay_status = DoorStatus::DOOR_CLOSED;
-                GetVessel().TriggerRedrawArea(AID_BAYDOORSINDICATOR);
-            }
-        } 
-        else    // door is opening or open
-        {
-            if (GetXR3().bay_proc < 1.0)
-                GetXR3().bay_proc = min (1.0, GetXR3().bay_proc + da);
-            else
-            {
-                GetXR3().bay_status = DoorStatus::DOOR_OPEN;
-                GetVessel().TriggerRedrawArea(AID_BAYDOORSINDICATOR);
-            }
-        }
-        GetXR3().SetXRAnimation(GetXR3().anim_bay, GetXR3().bay_proc);
-    }
-}
-
-void XR3AnimationPostStep::AnimateElevator(const double simt, const double simdt, const double mjd)
-{
-    // animate the elevator
-    if (GetXR3().crewElevator_status >= DoorStatus::DOOR_CLOSING)  // closing or opening
-    {
-        double da = simdt * ELEVATOR_OPERATING_SPEED;
-        if (GetXR3().crewElevator_status == DoorStatus::DOOR_CLOSING)
-        {
-            if (GetXR3().crewElevator_proc > 0.0)
-                GetXR3().crewElevator_proc = max(0.0, GetXR3().crewElevator_proc - da);
-            else
-            {
-                GetXR3().crewElevator_status = DoorStatus::DOOR_CLOSED;
-                GetVessel().TriggerRedrawArea(AID_ELEVATORINDICATOR);
-            }
-        } 
-        else    // door is opening or open
-        {
-            if (GetXR3().crewElevator_proc < 1.0)
-                GetXR3().crewElevator_proc = min (1.0, GetXR3().crewElevator_proc + da);
-            else
-            {
-                GetXR3().crewElevator_status = DoorStatus::DOOR_OPEN;
-                GetVessel().TriggerRedrawArea(AID_ELEVATORINDICATOR);
-            }
-        }
-        GetXR3().SetXRAnimation(GetXR3().anim_crewElevator, GetXR3().crewElevator_proc);
-    }
-}
-
-//---------------------------------------------------------------------------
-
 XR3DoorSoundsPostStep::XR3DoorSoundsPostStep(XR3Phoenix &vessel) : 
     DoorSoundsPostStep(vessel)
 {
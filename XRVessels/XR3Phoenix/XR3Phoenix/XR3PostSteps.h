@@ -34,19 +34,6 @@
 
 //---------------------------------------------------------------------------
 
-class XR3AnimationPostStep : public XR3PrePostStep
-{
-public:
-    XR3AnimationPostStep(XR3Phoenix &vessel);
-    virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
-
-protected:
-    void AnimateBayDoors    (const double simt, const double simdt, const double mjd);
-    void AnimateElevator    (const double simt, const double simdt, const double mjd);
-};
-
-//---------------------------------------------------------------------------
-
 // handles door opening/closing sounds
 class XR3DoorSoundsPostStep : public DoorSoundsPostStep
 {
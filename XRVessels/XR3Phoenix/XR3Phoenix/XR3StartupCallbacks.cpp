@@ -700,6 +700,8 @@ void XR3Phoenix::clbkPostCreation()
     AddPreStep(new RefreshGrappleTargetsInDisplayRangePreStep(*this));
     AddPreStep(new UpdateVesselLightsPreStep(*this));
     AddPreStep(new ParkingBrakePreStep(*this));
+    if (*GetXR1Config()->StartupScript)  // user wants a script run when the simulation starts?
+        AddPreStep(new StartupScriptPreStep(*this));
 
     // WARNING: this must be invoked LAST in the sequence so that behavior is consistent across all pre-step methods
     AddPreStep(new UpdatePreviousFieldsPreStep(*this));
@@ -709,6 +711,7 @@ void XR3Phoenix::clbkPostCreation()
     AddPostStep(new ComputeAccPostStep(*this));   // used by acc areas; computed only once per frame for efficiency
     // XRSound: AddPostStep(new AmbientSoundsPostStep       (*this));
     AddPostStep(new ShowWarningPostStep(*this));
+    AddPostStep(new CalloutQueuePostStep(*this));
     AddPostStep(new SetHullTempsPostStep(*this));
     AddPostStep(new SetSlopePostStep(*this));
     // do not include DoorSoundsPostStep here; we replace it below
@@ -731,9 +734,15 @@ void XR3Phoenix::clbkPostCreation()
 
     // NEW poststeps specific to the XR3
     AddPostStep(new SwitchTwoDPanelPostStep(*this));
-    AddPostStep(new XR3AnimationPostStep(*this));
     AddPostStep(new XR3DoorSoundsPostStep(*this));  // replaces the standard DoorSoundsPostStep in the XR1 class
     AddPostStep(new HandleDockChangesForActiveAirlockPostStep(*this));  // switch active airlock automatically as necessary
+    if (GetXR1Config()->FlightDataRecorderEnabled)  // user wants XR state recorded and replayed along with Orbiter's flight recorder?
+    {
+        AddPostStep(new FlightDataPlaybackPostStep(*this));
+        AddPostStep(new FlightDataRecorderPostStep(*this));
+    }
+    if (GetXR1Config()->TelemetryExportEnabled)  // user wants telemetry exported to shared memory?
+        AddPostStep(new TelemetryExportPostStep(*this));
 
 #ifdef _DEBUG
     AddPostStep(new TestXRVesselCtrlPostStep(*this));      // for manual testing of new XRVesselCtrl methods via the debugger
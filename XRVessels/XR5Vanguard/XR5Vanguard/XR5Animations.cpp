@@ -31,37 +31,6 @@
 #include "meshres.h"
 
 
-// Virtual Gateway method that decides which animations are valid for this vessel; if the incoming animation handle is valid, 
-// the call is propogated up to SetAnimation.  Otherwise, this method returns without changing the animation state.
-#define ALLOW(handlePtr)  if (&anim == &(handlePtr)) { SetAnimation(anim, state); return; }
-void XR5Vanguard::SetXRAnimation(const unsigned int &anim, const double state) const
-{
-    ALLOW(anim_gear);         // handle for landing gear animation
-	ALLOW(anim_rcover);       // handle for retro cover animation
-    ALLOW(anim_hoverdoor);    // handle for hover doors animation
-    ALLOW(anim_scramdoor);    // handle for scram doors animation
-	ALLOW(anim_nose);         // handle for docking port animation
-	ALLOW(anim_hatch);        // handle for top hatch animation 
-	ALLOW(anim_radiator);     // handle for radiator animation
-	ALLOW(anim_rudder);       // handle for rudder animation
-	ALLOW(anim_elevator);     // handle for elevator animation
-	ALLOW(anim_elevatortrim); // handle for elevator trim animation
-	ALLOW(anim_laileron);     // handle for left aileron animation
-	ALLOW(anim_raileron);     // handle for right aileron animation
-	ALLOW(anim_brake);        // handle for airbrake animation
-    ALLOW(anim_olock);        // handle for outer airlock door animation
-    ALLOW(anim_ilock);        // handle for inner airlock door animation
-
-    // new for XR5
-    ALLOW(anim_crewElevator);
-    ALLOW(anim_bay);
-    ALLOW(m_animNoseGearCompression);
-    ALLOW(m_animRearGearCompression);
-    ALLOW(m_animFrontTireRotation);
-    ALLOW(m_animRearTireRotation);
-    ALLOW(m_animNosewheelSteering);
-}
-
 // --------------------------------------------------------------
 // Define animation sequences for moving parts
 // Invoked by our constructor.
@@ -807,6 +776,32 @@ void XR5Vanguard::DefineAnimations()
     // translate the outer doors OUT
     AddAnimationComponent(anim_crewElevator, 0.94, 1.0, &OuterRightElevatorDoor);
     AddAnimationComponent(anim_crewElevator, 0.94, 1.0, &OuterLeftElevatorDoor);
+
+    // Only these animations are valid for this vessel; SetXRAnimation ignores all others.
+    RegisterXRAnimation(anim_gear);         // handle for landing gear animation
+    RegisterXRAnimation(anim_rcover);       // handle for retro cover animation
+    RegisterXRAnimation(anim_hoverdoor);    // handle for hover doors animation
+    RegisterXRAnimation(anim_scramdoor);    // handle for scram doors animation
+    RegisterXRAnimation(anim_nose);         // handle for docking port animation
+    RegisterXRAnimation(anim_hatch);        // handle for top hatch animation 
+    RegisterXRAnimation(anim_radiator);     // handle for radiator animation
+    RegisterXRAnimation(anim_rudder);       // handle for rudder animation
+    RegisterXRAnimation(anim_elevator);     // handle for elevator animation
+    RegisterXRAnimation(anim_elevatortrim); // handle for elevator trim animation
+    RegisterXRAnimation(anim_laileron);     // handle for left aileron animation
+    RegisterXRAnimation(anim_raileron);     // handle for right aileron animation
+    RegisterXRAnimation(anim_brake);        // handle for airbrake animation
+    RegisterXRAnimation(anim_olock);        // handle for outer airlock door animation
+    RegisterXRAnimation(anim_ilock);        // handle for inner airlock door animation
+
+    // new for XR5
+    RegisterXRAnimation(anim_crewElevator);
+    RegisterXRAnimation(anim_bay);
+    RegisterXRAnimation(m_animNoseGearCompression);
+    RegisterXRAnimation(m_animRearGearCompression);
+    RegisterXRAnimation(m_animFrontTireRotation);
+    RegisterXRAnimation(m_animRearTireRotation);
+    RegisterXRAnimation(m_animNosewheelSteering);
 }
 
 // delete any child animation objects; invoked by our destructor
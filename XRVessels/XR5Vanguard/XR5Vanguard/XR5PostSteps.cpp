@@ -34,83 +34,6 @@
 
 //---------------------------------------------------------------------------
 
-XR5AnimationPostStep::XR5AnimationPostStep(XR5Vanguard &vessel) : 
-    XR5PrePostStep(vessel)
-{
-}
-
-void XR5AnimationPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
-{
-    // animate doors that require hydraulic pressure
-    if (GetXR5().CheckHydraulicPressure(false, false))     // do not log a warning nor play an error beep here!  We are merely querying the state.
-    {
-        AnimateBayDoors(simt, simdt, mjd);
-        AnimateElevator(simt, simdt, mjd);
-    }
-}
-
-void XR5AnimationPostStep::AnimateBayDoors(const double simt, const double simdt, const double mjd)
-{
-    // animate the payload bay doors
-    if (GetXR5().bay_status >= DoorStatus::DOOR_CLOSING)  // closing or opening
-    {
-        double da = simdt * BAY_OPERATING_SPEED;
-        if (GetXR5().bay_status == DoorStatus::DOOR_CLOSING)
-        {
-            if (GetXR5().bay_proc > 0.0)
-                GetXR5().bay_proc = max(0.0, GetXR5().bay_proc - da);
-            else
-            {
-                GetXR5().bay_status = DoorStatus::DOOR_CLOSED;
-                GetVessel().TriggerRedrawArea(AID_BAYDOORSINDICATOR);
-            }
-        } 
-        else    // door is opening or open
-        {
-            if (GetXR5().bay_proc < 1.0)
-                GetXR5().bay_proc = min (1.0, GetXR5().bay_proc + da);
-            else
-            {
-                GetXR5().bay_status = DoorStatus::DOOR_OPEN;
-                GetVessel().TriggerRedrawArea(AID_BAYDOORSINDICATOR);
-            }
-        }
-        GetXR5().SetXRAnimation(GetXR5().anim_bay, GetXR5().bay_proc);
-    }
-}
-
-void XR5AnimationPostStep::AnimateElevator(const double simt, const double simdt, const double mjd)
-{
-    // animate the elevator
-    if (GetXR5().crewElevator_status >= DoorStatus::DOOR_CLOSING)  // closing or opening
-    {
-        double da = simdt * ELEVATOR_OPERATING_SPEED;
-        if (GetXR5().crewElevator_status == DoorStatus::DOOR_CLOSING)
-        {
-            if (GetXR5().crewElevator_proc > 0.0)
-                GetXR5().crewElevator_proc = max(0.0, GetXR5().crewElevator_proc - da);
-            else
-            {
-                GetXR5().crewElevator_status = DoorStatus::DOOR_CLOSED;
-                GetVessel().TriggerRedrawArea(AID_ELEVATORINDICATOR);
-            }
-        } 
-        else    // door is opening or open
-        {
-            if (GetXR5().crewElevator_proc < 1.0)
-                GetXR5().crewElevator_proc = min (1.0, GetXR5().crewElevator_proc + da);
-            else
-            {
-                GetXR5().crewElevator_status = DoorStatus::DOOR_OPEN;
-                GetVessel().TriggerRedrawArea(AID_ELEVATORINDICATOR);
-            }
-        }
-        GetXR5().SetXRAnimation(GetXR5().anim_crewElevator, GetXR5().crewElevator_proc);
-    }
-}
-
-//---------------------------------------------------------------------------
-
 XR5DoorSoundsPostStep::XR5DoorSoundsPostStep(XR5Vanguard &vessel) : 
     DoorSoundsPostStep(vessel)
 {
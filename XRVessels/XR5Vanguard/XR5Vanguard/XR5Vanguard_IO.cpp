@@ -70,10 +70,6 @@ void XR5Vanguard::clbkLoadStateEx(FILEHANDLE scn, void *vs)
         {
             SSCANF1("%d", (int *)&m_activeEVAPort);
         }
-		else IF_FOUND("CREW_ELEVATOR")
-		{
-			SSCANF2("%d%lf", (int *)&crewElevator_status, &crewElevator_proc);
-		}
         else
         {
             // unrecognized option - pass to Orbiter's default parser
@@ -94,9 +90,8 @@ void XR5Vanguard::clbkSaveState (FILEHANDLE scn)
     WriteXRCommonScenarioLines(scn);        // save common data
 
     // XR5-specific data
-	char cbuf[256];
-    oapiWriteScenario_int(scn, "RCS_DOCKING_MODE", m_rcsDockingMode);
-    oapiWriteScenario_int(scn, "ACTIVE_EVA_PORT", static_cast<int>(m_activeEVAPort));
-	sprintf(cbuf, "%d %0.4f", (int)crewElevator_status, crewElevator_proc);
-	oapiWriteScenario_string(scn, "CREW_ELEVATOR", cbuf);
+    XRScenarioWriter &w = m_scenarioWriter;
+    w.WriteInt("RCS_DOCKING_MODE", m_rcsDockingMode);
+    w.WriteInt("ACTIVE_EVA_PORT", static_cast<int>(m_activeEVAPort));
+    w.Flush(scn);
 }
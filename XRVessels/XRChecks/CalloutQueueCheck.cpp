@@ -0,0 +1,315 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// CalloutQueueCheck.cpp
+// Fake-clock checks for the voice callout scheduler (XRCalloutQueue.h).
+//
+// Runs scripted scenarios for spacing, coalescing, priority order,
+// expiry, preemption, blocking, and a full queue, then drives the
+// queue with --frames random frames (default 1,000,000, about 4.6
+// hours at 60 fps) of random callouts, durations, and warning periods
+// and checks on every frame that:
+//   - a callout only starts over one that is playing by preempting it,
+//     and only at or above the preempt priority;
+//   - otherwise it starts at least the minimum spacing after the last
+//     one ended;
+//   - no callout starts after its expiry time;
+//   - no pending callout outranks the one that started;
+//   - no two pending callouts share a coalescing group;
+//   - only preempting callouts start while the queue is blocked;
+//   - every callout is played, coalesced, dropped, or still pending.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "XRCalloutQueue.h"
+#include "XRRandom.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const double SPACING = 0.25;     // XRCalloutQueue default
+static const double FRAME_SECONDS = 1.0 / 60;
+
+static int s_failures = 0;
+
+static void Expect(const bool ok, const char *pScenario, const char *pWhat)
+{
+    if (!ok && (++s_failures <= 10))
+        printf("FAIL: %s: %s\n", pScenario, pWhat);
+}
+
+// exposes the pending callouts for the invariant checks
+class CheckedQueue : public XRCalloutQueue
+{
+public:
+    const Callout &GetPending(const int i) const { return m_pending[i]; }
+};
+
+// Plays callouts from a queue against a fake clock; each callout plays for the number of seconds in its soundType
+class FakePlayer
+{
+public:
+    CheckedQueue Queue;
+    double Now = 0;
+    double ActiveEndTime = 0;
+    bool IsBlocked = false;
+    vector<string> Played;          // filenames, in the order they started
+    vector<double> StartTimes;
+    int PreemptCount = 0;
+
+    void Enqueue(const XRCalloutPriority priority, const int group, const char *pFilename, const double seconds, const double maxAge = 5)
+    {
+        Queue.Enqueue(Now, priority, group, 0, pFilename, static_cast<int>(seconds * 1000), maxAge);
+    }
+
+    void Step()
+    {
+        bool preemptActive;
+        const XRCalloutQueue::Callout *pCallout = Queue.Update(Now, IsPlaying(), IsBlocked, preemptActive);
+        if (pCallout != nullptr)
+        {
+            if (preemptActive)
+                PreemptCount++;
+            Played.push_back(pCallout->filename);
+            StartTimes.push_back(Now);
+            ActiveEndTime = Now + pCallout->soundType / 1000.0;
+        }
+        Now += FRAME_SECONDS;
+    }
+
+    void Run(const double seconds) { for (const double end = Now + seconds; Now < end; ) Step(); }
+    bool IsPlaying() const { return (Now < ActiveEndTime); }
+    string PlayedList() const { string s; for (const string &p : Played) s += (s.empty() ? "" : " ") + p; return s; }
+};
+
+static void CheckScenarios()
+{
+    {
+        FakePlayer p;
+        p.Enqueue(XRCalloutPriority::Info, 0, "A", 1.0);
+        p.Enqueue(XRCalloutPriority::Info, 0, "B", 1.0);
+        p.Run(3);
+        Expect(p.PlayedList() == "A B", "spacing", "A and B did not both play in order");
+        Expect((p.StartTimes.size() == 2) && (p.StartTimes[1] >= 1.0 + SPACING) && (p.StartTimes[1] < 1.0 + SPACING + 2 * FRAME_SECONDS),
+            "spacing", "B did not start the minimum spacing after A ended");
+    }
+
+    {
+        FakePlayer p;
+        p.Enqueue(XRCalloutPriority::Info, 0, "Long", 2.0);
+        p.Step();
+        for (int m = 1; m <= 5; m++)
+        {
+            p.Enqueue(XRCalloutPriority::Velocity, 1, ("Mach " + to_string(m)).c_str(), 1.0);
+            p.Enqueue(XRCalloutPriority::Docking, 2, ("Alt " + to_string(m)).c_str(), 1.0);
+            p.Run(0.1);
+        }
+        p.Run(6);
+        Expect(p.PlayedList() == "Long Alt 5 Mach 5", "coalescing", ("played " + p.PlayedList()).c_str());
+        Expect(p.Queue.GetCoalescedCount() == 8, "coalescing", "wrong coalesced count");
+    }
+
+    {
+        FakePlayer p;
+        p.Enqueue(XRCalloutPriority::Info, 0, "Long", 1.0);
+        p.Step();
+        p.Enqueue(XRCalloutPriority::Info, 0, "Beep", 0.5);
+        p.Enqueue(XRCalloutPriority::Info, 0, "Beep", 0.5);
+        p.Run(4);
+        Expect(p.PlayedList() == "Long Beep", "repeat", "a repeated sound waiting to play was not coalesced");
+    }
+
+    {
+        FakePlayer p;
+        p.Enqueue(XRCalloutPriority::Info, 0, "Long", 1.0);
+        p.Step();
+        p.Enqueue(XRCalloutPriority::Velocity, 0, "V", 0.5);
+        p.Enqueue(XRCalloutPriority::Info, 0, "I1", 0.5);
+        p.Enqueue(XRCalloutPriority::Docking, 0, "D", 0.5);
+        p.Enqueue(XRCalloutPriority::Info, 0, "I2", 0.5);
+        p.Run(6);
+        Expect(p.PlayedList() == "Long D I1 I2 V", "priority", ("played " + p.PlayedList()).c_str());
+    }
+
+    {
+        FakePlayer p;
+        p.Enqueue(XRCalloutPriority::Info, 0, "Long", 3.0);
+        p.Step();
+        p.Enqueue(XRCalloutPriority::Velocity, 1, "Mach 2", 0.5, 2.0);
+        p.Run(6);
+        Expect(p.PlayedList() == "Long", "expiry", "a callout played after its maximum age");
+        Expect(p.Queue.GetDroppedCount() == 1, "expiry", "the expired callout was not counted as dropped");
+    }
+
+    {
+        FakePlayer p;
+        p.Enqueue(XRCalloutPriority::Info, 0, "Info", 3.0);
+        p.Step();
+        p.Enqueue(XRCalloutPriority::Docking, 0, "Docking", 0.5);
+        p.Run(0.5);
+        Expect(p.PlayedList() == "Info", "preemption", "a docking callout interrupted an info callout");
+        p.Enqueue(XRCalloutPriority::Crash, 0, "Crash", 2.0);
+        p.Step();
+        Expect((p.PlayedList() == "Info Crash") && (p.PreemptCount == 1), "preemption", "the crash callout did not interrupt the info callout at once");
+        p.Enqueue(XRCalloutPriority::Crash, 0, "Crash 2", 0.5);
+        p.Run(1);
+        Expect(p.PreemptCount == 1, "preemption", "a crash callout interrupted another crash callout");
+        p.Run(5);
+        Expect(p.PlayedList() == "Info Crash Crash 2 Docking", "preemption", ("played " + p.PlayedList()).c_str());
+    }
+
+    {
+        FakePlayer p;
+        p.IsBlocked = true;     // a warning is playing
+        p.Enqueue(XRCalloutPriority::Info, 0, "Info", 0.5);
+        p.Run(1);
+        Expect(p.Played.empty(), "blocked", "an info callout played while a warning was playing");
+        p.Enqueue(XRCalloutPriority::Crash, 0, "Crash", 0.5);
+        p.Step();
+        Expect(p.PlayedList() == "Crash", "blocked", "a crash callout was held off by a warning");
+        p.IsBlocked = false;
+        p.Run(2);
+        Expect(p.PlayedList() == "Crash Info", "blocked", "the info callout did not play after the warning");
+    }
+
+    {
+        FakePlayer p;
+        p.Enqueue(XRCalloutPriority::Info, 0, "Long", 3.0);
+        p.Step();
+        for (int i = 0; i < XRCalloutQueue::MAX_PENDING; i++)
+            p.Enqueue(XRCalloutPriority::Info, 0, ("I" + to_string(i)).c_str(), 0.1, 60);
+        p.Enqueue(XRCalloutPriority::Velocity, 0, "V", 0.1, 60);        // less important than everything pending: dropped
+        p.Enqueue(XRCalloutPriority::Docking, 0, "D", 0.1, 60);         // pushes out I0, the oldest info callout
+        p.Run(10);
+        Expect(p.PlayedList() == "Long D I1 I2 I3 I4 I5 I6 I7", "full queue", ("played " + p.PlayedList()).c_str());
+        Expect(p.Queue.GetDroppedCount() == 2, "full queue", "wrong dropped count");
+    }
+}
+
+static void CheckRandomFrames(const long long frameCount)
+{
+    static const double s_maxAge[] = { 2.0, 5.0, 2.0, 5.0, 5.0 };   // same as the vessel's, by priority
+    XRRandom rng(0xCA110);
+    FakePlayer p;
+    double lastEndTime = -1e9;
+    bool wasPlaying = false;
+    long long enqueued = 0;
+    char filename[32];
+    for (long long frame = 0; frame < frameCount; frame++)
+    {
+        if (wasPlaying && !p.IsPlaying())
+            lastEndTime = p.Now;
+
+        // a burst of callouts every second or so, and a warning every minute or so
+        if (rng.NextDouble() < 0.02)
+        {
+            const int count = 1 + static_cast<int>(rng.NextDouble() * 4);
+            for (int i = 0; i < count; i++)
+            {
+                const int priority = static_cast<int>(rng.NextDouble() * 3.05);     // Crash is rare; warnings never go through the queue
+                const int group = ((priority == 0) || (priority == 2)) ? 1 + static_cast<int>(rng.NextDouble() * 3) : 0;
+                snprintf(filename, sizeof(filename), "P%d G%d #%d", priority, group, static_cast<int>(rng.NextDouble() * 20));
+                p.Enqueue(static_cast<XRCalloutPriority>(priority), group, filename, 0.3 + rng.NextDouble() * 2.5, s_maxAge[priority]);
+                enqueued++;
+            }
+        }
+        if (rng.NextDouble() < 1.0 / 3600)
+            p.IsBlocked = !p.IsBlocked;
+
+        const bool isPlaying = p.IsPlaying();
+        const size_t playedBefore = p.Played.size();
+        const int preemptsBefore = p.PreemptCount;
+        const XRCalloutQueue::Callout *pPrevActive = p.Queue.GetActive();
+        const XRCalloutPriority prevPriority = (pPrevActive ? pPrevActive->priority : XRCalloutPriority::Velocity);
+        const double simt = p.Now;
+        p.Step();
+        wasPlaying = (simt < p.ActiveEndTime);     // as of this frame, including a callout that just started
+
+        if (p.Played.size() == playedBefore)
+            continue;
+
+        const XRCalloutQueue::Callout &c = *p.Queue.GetActive();
+        const bool preempted = (p.PreemptCount != preemptsBefore);
+        if (preempted)
+        {
+            Expect(isPlaying && (c.priority >= XRCalloutPriority::Crash) && (c.priority > prevPriority), "random",
+                "a callout preempted one of equal or higher priority, or below the preempt priority");
+        }
+        else
+        {
+            Expect(!isPlaying, "random", "a callout started over one that was still playing");
+            Expect(simt >= lastEndTime + SPACING - 1e-9, "random", "a callout started less than the minimum spacing after the last one");
+        }
+        Expect(simt <= c.expireTime, "random", "a callout started after its expiry time");
+        Expect(!p.IsBlocked || (c.priority >= XRCalloutPriority::Crash), "random", "a callout below the preempt priority started while blocked");
+        for (int i = 0; i < p.Queue.GetPendingCount(); i++)
+        {
+            const XRCalloutQueue::Callout &pending = p.Queue.GetPending(i);
+            if (pending.expireTime < simt)
+                continue;   // expired; removed on the next Update
+            Expect((pending.priority < c.priority) || ((pending.priority == c.priority) && (pending.sequence > c.sequence)), "random",
+                "a pending callout outranks the one that started");
+            for (int j = i + 1; j < p.Queue.GetPendingCount(); j++)
+                Expect((pending.coalesceGroup == 0) || (pending.coalesceGroup != p.Queue.GetPending(j).coalesceGroup), "random",
+                    "two pending callouts share a coalescing group");
+        }
+    }
+
+    const long long accounted = static_cast<long long>(p.Queue.GetPlayedCount()) + p.Queue.GetCoalescedCount() + p.Queue.GetDroppedCount() + p.Queue.GetPendingCount();
+    Expect(accounted == enqueued, "random", "played + coalesced + dropped + pending != enqueued");
+    printf("%lld random frames: %lld callouts enqueued, %u played (%d preempting), %u coalesced, %u dropped\n",
+        frameCount, enqueued, p.Queue.GetPlayedCount(), p.PreemptCount, p.Queue.GetCoalescedCount(), p.Queue.GetDroppedCount());
+}
+
+int main(int argc, char *argv[])
+{
+    long long frameCount = 1000000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--frames") == 0) && pVal)  { frameCount = atoll(pVal); i++; }
+        else
+        {
+            puts("usage: calloutqueuecheck [--frames n]\n"
+                 "  --frames n   random frames to run (default 1000000)");
+            return 1;
+        }
+    }
+
+    CheckScenarios();
+    CheckRandomFrames(frameCount);
+
+    if (s_failures > 0)
+    {
+        printf("%d checks failed\n", s_failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
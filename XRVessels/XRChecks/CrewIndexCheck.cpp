@@ -0,0 +1,280 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// CrewIndexCheck.cpp
+// Lookup checks for the crew index (XR1CrewIndex.h).
+//
+// Indexes a full 18-person XR5 manifest with duplicate ranks and
+// checks every name (in its own case and in others), every rank's
+// slot list, unknown names and ranks, and the index after crew
+// members leave and board.  Then indexes --trials random manifests
+// (default 100,000) with empty slots, names that differ only in
+// case, and few distinct ranks, and checks every lookup against the
+// linear strcasecmp/strcmp scans the index replaced.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "XR1CrewIndex.h"
+#include "XRRandom.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <vector>
+
+using namespace std;
+
+static const int MAX_PASSENGERS = 18;      // XR5 crew complement
+
+// the name and rank fields of CrewMember (XR1ConfigFileParser.h)
+struct TestCrewMember
+{
+    char name[25 + 1];
+    char rank[30 + 1];
+};
+
+static int s_failures = 0;
+
+static void Fail(const char *pFormat, const char *pArg, const int expected, const int actual)
+{
+    if (s_failures < 10)
+    {
+        printf("FAIL: ");
+        printf(pFormat, pArg);
+        printf(": expected %d, got %d\n", expected, actual);
+    }
+    s_failures++;
+}
+
+static void Set(TestCrewMember &cm, const char *pName, const char *pRank)
+{
+    strcpy(cm.name, pName);
+    strcpy(cm.rank, pRank);
+}
+
+// the linear scans in GetCrewAgeByName and GetCrewMiscIdByName
+static int OriginalSlotForName(const TestCrewMember *pCrew, const char *pName)
+{
+    for (int i = 0; i < MAX_PASSENGERS; i++)
+    {
+        if ((*pCrew[i].name != 0) && (strcasecmp(pCrew[i].name, pName) == 0))
+            return i;
+    }
+    return -1;
+}
+
+// the linear scan in GetMmuSlotNumberForName
+static int OriginalSlotForExactName(const TestCrewMember *pCrew, const char *pName)
+{
+    for (int i = 0; i < MAX_PASSENGERS; i++)
+    {
+        if ((*pCrew[i].name != 0) && (strcmp(pCrew[i].name, pName) == 0))
+            return i;
+    }
+    return -1;
+}
+
+// the slots that IsCrewRankOnBoard scanned for a match
+static vector<int> OriginalSlotsForRank(const TestCrewMember *pCrew, const char *pRank)
+{
+    vector<int> slots;
+    for (int i = 0; i < MAX_PASSENGERS; i++)
+    {
+        if ((*pCrew[i].name != 0) && (strcmp(pCrew[i].rank, pRank) == 0))
+            slots.push_back(i);
+    }
+    return slots;
+}
+
+static void CheckName(const XR1CrewIndex &index, const TestCrewMember *pCrew, const char *pName)
+{
+    const int expected = OriginalSlotForName(pCrew, pName);
+    const int actual = index.GetSlotForName(pName);
+    if (actual != expected)
+        Fail("GetSlotForName(\"%s\")", pName, expected, actual);
+
+    const int expectedExact = OriginalSlotForExactName(pCrew, pName);
+    const int actualExact = index.GetSlotForExactName(pName);
+    if (actualExact != expectedExact)
+        Fail("GetSlotForExactName(\"%s\")", pName, expectedExact, actualExact);
+}
+
+static void CheckRank(const XR1CrewIndex &index, const TestCrewMember *pCrew, const char *pRank)
+{
+    const vector<int> expected = OriginalSlotsForRank(pCrew, pRank);
+    const vector<int> &actual = index.GetSlotsForRank(pRank);
+    if (actual != expected)
+        Fail("GetSlotsForRank(\"%s\") slot count", pRank, static_cast<int>(expected.size()), static_cast<int>(actual.size()));
+    if (index.IsRankPresent(pRank) != !expected.empty())
+        Fail("IsRankPresent(\"%s\")", pRank, !expected.empty(), index.IsRankPresent(pRank));
+}
+
+static void CheckSlots(const XR1CrewIndex &index, const char *pRank, const vector<int> &expected)
+{
+    const vector<int> &actual = index.GetSlotsForRank(pRank);
+    if (actual != expected)
+        Fail("GetSlotsForRank(\"%s\") slot count", pRank, static_cast<int>(expected.size()), static_cast<int>(actual.size()));
+}
+
+static void CheckAllLookups(const XR1CrewIndex &index, const TestCrewMember *pCrew)
+{
+    char altered[sizeof(TestCrewMember::name)];
+    for (int i = 0; i < MAX_PASSENGERS; i++)
+    {
+        if (*pCrew[i].name == 0)
+            continue;
+
+        CheckName(index, pCrew, pCrew[i].name);
+
+        // the same name in upper and lower case
+        for (int upper = 0; upper < 2; upper++)
+        {
+            strcpy(altered, pCrew[i].name);
+            for (char *p = altered; *p; p++)
+                *p = static_cast<char>(upper ? toupper(static_cast<unsigned char>(*p)) : tolower(static_cast<unsigned char>(*p)));
+            CheckName(index, pCrew, altered);
+        }
+
+        CheckRank(index, pCrew, pCrew[i].rank);
+    }
+    CheckName(index, pCrew, "Nobody");
+    CheckRank(index, pCrew, "Admiral");
+    CheckRank(index, pCrew, "commander");      // ranks are case-sensitive
+}
+
+// a full XR5 crew: every slot filled, with duplicate ranks
+static void CheckFullManifest()
+{
+    static const char *s_names[MAX_PASSENGERS] =
+    {
+        "Lee Nash", "Kara Thrace", "Ayumi Sato", "Ivan Petrov", "Maria Lopez", "Sam Okafor", "Nils Berg", "Priya Rao", "Tom Hayes",
+        "Ana Costa", "Li Wei", "Omar Haddad", "Eva Novak", "Ben Carter", "Zoe Martin", "Raj Patel", "Mia Jensen", "Kai Muller"
+    };
+    static const char *s_ranks[MAX_PASSENGERS] =
+    {
+        "Commander", "Pilot", "Pilot", "Flight Engineer", "Mission Specialist", "Mission Specialist", "Mission Specialist", "Flight Engineer", "Passenger",
+        "Passenger", "Passenger", "Passenger", "Passenger", "Passenger", "Passenger", "Mission Specialist", "Passenger", "Commander"
+    };
+
+    TestCrewMember crew[MAX_PASSENGERS];
+    for (int i = 0; i < MAX_PASSENGERS; i++)
+        Set(crew[i], s_names[i], s_ranks[i]);
+
+    XR1CrewIndex index;
+    index.Rebuild(crew, MAX_PASSENGERS);
+    CheckAllLookups(index, crew);
+
+    // duplicate ranks map to every slot with that rank, in order
+    CheckSlots(index, "Commander", { 0, 17 });
+    CheckSlots(index, "Pilot", { 1, 2 });
+    CheckSlots(index, "Flight Engineer", { 3, 7 });
+    CheckSlots(index, "Mission Specialist", { 4, 5, 6, 15 });
+    CheckSlots(index, "Passenger", { 8, 9, 10, 11, 12, 13, 14, 16 });
+    if (index.GetSlotForName("KAI MULLER") != 17)
+        Fail("GetSlotForName(\"%s\")", "KAI MULLER", 17, index.GetSlotForName("KAI MULLER"));
+
+    // both commanders leave, and a new pilot boards in the first commander's slot
+    Set(crew[0], "Jo Park", "Pilot");
+    *crew[17].name = 0;
+    index.Rebuild(crew, MAX_PASSENGERS);
+    CheckAllLookups(index, crew);
+    CheckSlots(index, "Commander", { });
+    CheckSlots(index, "Pilot", { 0, 1, 2 });
+    CheckName(index, crew, "Lee Nash");
+    CheckName(index, crew, "Kai Muller");
+
+    puts("18-person manifest with duplicate ranks: checked every name and rank, before and after a crew change");
+}
+
+// random manifests, checked against the original scans
+static void CheckRandomManifests(const long long trialCount)
+{
+    static const char *s_firstNames[] = { "Ann", "ann", "ANN", "Bob", "bob", "Cy", "Dee", "Ed", "Flo", "Gus" };
+    static const char *s_lastNames[] = { "", " Ray", " ray", " Oak", " Yu" };
+    static const char *s_ranks[] = { "Commander", "Pilot", "pilot", "Engineer", "Passenger" };
+    const int firstCount = static_cast<int>(sizeof(s_firstNames) / sizeof(s_firstNames[0]));
+    const int lastCount = static_cast<int>(sizeof(s_lastNames) / sizeof(s_lastNames[0]));
+    const int rankCount = static_cast<int>(sizeof(s_ranks) / sizeof(s_ranks[0]));
+
+    XRRandom rng(0xC4E3);
+    XR1CrewIndex index;
+    TestCrewMember crew[MAX_PASSENGERS];
+    char name[sizeof(TestCrewMember::name)];
+    for (long long trial = 0; trial < trialCount; trial++)
+    {
+        const int crewCount = 1 + static_cast<int>(rng.NextUInt64() % MAX_PASSENGERS);
+        for (int i = 0; i < MAX_PASSENGERS; i++)
+        {
+            if ((i >= crewCount) || (rng.NextDouble() < 0.2))
+            {
+                Set(crew[i], "", "");
+                continue;
+            }
+            snprintf(name, sizeof(name), "%s%s", s_firstNames[rng.NextUInt64() % firstCount], s_lastNames[rng.NextUInt64() % lastCount]);
+            Set(crew[i], name, s_ranks[rng.NextUInt64() % rankCount]);
+        }
+
+        index.Rebuild(crew, MAX_PASSENGERS);
+        for (int f = 0; f < firstCount; f++)
+        {
+            for (int l = 0; l < lastCount; l++)
+            {
+                snprintf(name, sizeof(name), "%s%s", s_firstNames[f], s_lastNames[l]);
+                CheckName(index, crew, name);
+            }
+        }
+        for (int r = 0; r < rankCount; r++)
+            CheckRank(index, crew, s_ranks[r]);
+    }
+    printf("%lld random manifests: checked every name and rank against the linear scans\n", trialCount);
+}
+
+int main(int argc, char *argv[])
+{
+    long long trialCount = 100000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--trials") == 0) && pVal)  { trialCount = atoll(pVal); i++; }
+        else
+        {
+            puts("usage: crewindexcheck [--trials n]\n"
+                 "  --trials n   random manifests to check (default 100000)");
+            return 1;
+        }
+    }
+
+    CheckFullManifest();
+    CheckRandomManifests(trialCount);
+
+    if (s_failures > 0)
+    {
+        printf("%d checks failed\n", s_failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,419 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// DamageTableCheck.cpp
+// Randomized check of the XR1's cached damage status table against
+// the original uncached GetDamageStatus.
+//
+// The table is filled by the vessel's own code in XR1DamageStatus.h:
+// UpdateXR1DamageStatusTable and ComputeXR1DamageStatus, the bodies of
+// DeltaGliderXR1::UpdateDamageStatusTable and ComputeDamageStatus.
+// Every entry is compared, labels included, against
+// LegacyGetXR1DamageStatus, the old GetDamageStatus switch.
+//
+// DeltaGliderXR1 cannot be built without the Orbiter SDK, so
+// DamageVessel below holds the damage state those templates read and
+// mirrors every code path that changes it: scenario load,
+// SetDamageStatus, ResetDamageStatus, ApplyDamage, FailGear, crash
+// damage, the wing stress, door and SCRAM overheat damage found by
+// TestDamage, and the scenario editor's wing sliders.  Each path
+// refreshes the table exactly where the vessel code does.  --ops
+// random operations are applied to vessels with randomized
+// integrities, and after each one every cached entry must equal the
+// legacy value.
+//
+// Exit code is 0 if the table never goes stale, 1 otherwise.
+// ==============================================================
+
+#include "XR1Globals.h"
+#include "XR1DamageStatus.h"
+#include "XRRandom.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+// XR1Globals.cpp values
+double MAX_MAIN_THRUST[2] = { 2.4e5, 1.92e5 };
+double MAX_RETRO_THRUST = 4.08e4;
+const char *NOSECONE_LABEL = "Nosecone";
+const char *NOSECONE_SHORT_LABEL = "Nose";
+extern const DamageItem D_END = DamageItem::RCS14;
+static const int DAMAGE_ITEM_COUNT = static_cast<int>(DamageItem::RCS14) + 1;
+
+// the parts of XR1ConfigFileParser the damage rules read
+struct DamageConfig
+{
+    int MainEngineThrust;
+};
+
+// the parts of XR1Ramjet the damage rules read
+struct DamageRamjet
+{
+    double GetEngineIntegrity(const int idx) const { return m_integrity[idx]; }
+    double m_integrity[2];
+};
+
+// the parts of DeltaGliderXR1 that hold damage state; thruster handles are indices into m_thrusterMax
+class DamageVessel
+{
+public:
+    enum { TH_MAIN_LEFT, TH_MAIN_RIGHT, TH_RETRO_LEFT, TH_RETRO_RIGHT, THRUSTER_COUNT };
+
+    DamageVessel(XRRandom &rng) :
+        m_rng(rng), lwingstatus(1.0), rwingstatus(1.0), gear_status(DoorStatus::DOOR_CLOSED), nose_status(DoorStatus::DOOR_CLOSED),
+        rcover_status(DoorStatus::DOOR_CLOSED), hatch_status(DoorStatus::DOOR_CLOSED), radiator_status(DoorStatus::DOOR_CLOSED),
+        brake_status(DoorStatus::DOOR_CLOSED), ramjet(&m_ramjet), m_damageStatusLabelsValid(false)
+    {
+        th_main[0] = TH_MAIN_LEFT;
+        th_main[1] = TH_MAIN_RIGHT;
+        th_retro[0] = TH_RETRO_LEFT;
+        th_retro[1] = TH_RETRO_RIGHT;
+        m_config.MainEngineThrust = static_cast<int>(m_rng.NextUInt64() & 1);
+
+        for (int i = 0; i < 4; i++)
+            aileronfail[i] = false;
+        for (int i = 0; i < 2; i++)
+        {
+            m_thrusterMax[th_main[i]] = MAX_MAIN_THRUST[m_config.MainEngineThrust];
+            m_thrusterMax[th_retro[i]] = MAX_RETRO_THRUST;
+            m_hoverEngineIntegrity[i] = 1.0;
+            m_ramjet.m_integrity[i] = 1.0;
+        }
+        for (int i = 0; i < 14; i++)
+            m_rcsIntegrityArray[i] = 1.0;
+
+        // clbkLoadStateEx: half the vessels start with damage loaded from the scenario
+        if (m_rng.NextUInt64() & 1)
+            LoadRandomDamage();
+
+        UpdateDamageStatusTable();  // clbkPostCreationCommonXRCode
+    }
+
+    // the accessors the damage rules use
+    const DamageConfig *GetXR1Config() const { return &m_config; }
+    double GetThrusterMax0(const int th) const { return m_thrusterMax[th]; }
+
+    void ComputeDamageStatus(const DamageItem item, DamageStatus &status, const bool includeLabels) const
+    {
+        ComputeXR1DamageStatus(*this, item, status, includeLabels);
+    }
+
+    void UpdateDamageStatusTable()
+    {
+        UpdateXR1DamageStatusTable(*this, m_damageStatusTable, m_damageStatusLabelsValid);
+    }
+
+    const DamageStatus &GetDamageStatus(const DamageItem item) const { return m_damageStatusTable[static_cast<int>(item)]; }
+
+    bool IsDamagePresent() const
+    {
+        for (int i = 0; i < DAMAGE_ITEM_COUNT; i++)
+        {
+            if (m_damageStatusTable[i].fracIntegrity < 1.0)
+                return true;
+        }
+        return false;
+    }
+
+    void ApplyDamage()
+    {
+        UpdateDamageStatusTable();
+        // wing area, attack point, and damage visuals do not affect the table
+    }
+
+    void SetDamageStatus(const DamageItem item, const double fracIntegrity)
+    {
+        switch (item)
+        {
+        case DamageItem::LeftWing:          lwingstatus = fracIntegrity; break;
+        case DamageItem::RightWing:         rwingstatus = fracIntegrity; break;
+        case DamageItem::LeftAileron:       aileronfail[0] = aileronfail[1] = (fracIntegrity < 1.0); break;
+        case DamageItem::RightAileron:      aileronfail[2] = aileronfail[3] = (fracIntegrity < 1.0); break;
+        case DamageItem::LandingGear:       UpdateDoorDamage(gear_status, fracIntegrity); break;
+        case DamageItem::Nosecone:          UpdateDoorDamage(nose_status, fracIntegrity); break;
+        case DamageItem::RetroDoors:        UpdateDoorDamage(rcover_status, fracIntegrity); break;
+        case DamageItem::Hatch:             UpdateDoorDamage(hatch_status, fracIntegrity); break;
+        case DamageItem::Radiator:          UpdateDoorDamage(radiator_status, fracIntegrity); break;
+        case DamageItem::Airbrake:          UpdateDoorDamage(brake_status, fracIntegrity); break;
+        case DamageItem::MainEngineLeft:    m_thrusterMax[th_main[0]] = MAX_MAIN_THRUST[m_config.MainEngineThrust] * fracIntegrity; break;
+        case DamageItem::MainEngineRight:   m_thrusterMax[th_main[1]] = MAX_MAIN_THRUST[m_config.MainEngineThrust] * fracIntegrity; break;
+        case DamageItem::SCRAMEngineLeft:   m_ramjet.m_integrity[0] = fracIntegrity; break;
+        case DamageItem::SCRAMEngineRight:  m_ramjet.m_integrity[1] = fracIntegrity; break;
+        case DamageItem::HoverEngineFore:   m_hoverEngineIntegrity[0] = fracIntegrity; break;
+        case DamageItem::HoverEngineAft:    m_hoverEngineIntegrity[1] = fracIntegrity; break;
+        case DamageItem::RetroEngineLeft:   m_thrusterMax[th_retro[0]] = MAX_RETRO_THRUST * fracIntegrity; break;
+        case DamageItem::RetroEngineRight:  m_thrusterMax[th_retro[1]] = MAX_RETRO_THRUST * fracIntegrity; break;
+        default:                            m_rcsIntegrityArray[static_cast<int>(item) - static_cast<int>(DamageItem::RCS1)] = fracIntegrity; break;
+        }
+
+        UpdateDamageStatusTable();
+
+        if (IsDamagePresent())
+            ApplyDamage();
+    }
+
+    void ResetDamageStatus()
+    {
+        for (int i = 0; i < DAMAGE_ITEM_COUNT; i++)
+            SetDamageStatus(static_cast<DamageItem>(i), 1.0);
+    }
+
+    void FailGear()
+    {
+        gear_status = DoorStatus::DOOR_FAILED;
+        UpdateDamageStatusTable();
+    }
+
+    // DoCrash followed by PerformCrashDamage and the end of the next TestDamage call
+    void Crash()
+    {
+        FailGear();
+        if (lwingstatus == 1.0)
+            lwingstatus = m_rng.NextDouble() * 0.5;
+        if (rwingstatus == 1.0)
+            rwingstatus = m_rng.NextDouble() * 0.5;
+        for (int i = 0; i < 4; i++)
+            aileronfail[i] = true;
+        nose_status = hatch_status = radiator_status = brake_status = rcover_status = DoorStatus::DOOR_FAILED;
+
+        for (int i = 0; i < THRUSTER_COUNT; i++)
+            m_thrusterMax[i] = 0;
+        for (int i = 0; i < 2; i++)
+        {
+            m_hoverEngineIntegrity[i] = 0;
+            m_ramjet.m_integrity[i] = 0;
+        }
+        for (int i = 0; i < 14; i++)
+            m_rcsIntegrityArray[i] = 0;
+
+        TestDamageExit(true);
+    }
+
+    // TestDamage: wing stress failure
+    void WingStressFailure()
+    {
+        const double alpha = m_rng.NextDouble() * 2;
+        switch (m_rng.NextUInt64() & 3)
+        {
+        case 0: lwingstatus *= exp(-alpha * m_rng.NextDouble()); break;
+        case 1: rwingstatus *= exp(-alpha * m_rng.NextDouble()); break;
+        case 2: aileronfail[0] = aileronfail[1] = true; brake_status = DoorStatus::DOOR_FAILED; break;
+        case 3: aileronfail[2] = aileronfail[3] = true; brake_status = DoorStatus::DOOR_FAILED; break;
+        }
+        TestDamageExit(true);
+    }
+
+    // TestDamage: CheckAllDoorDamage failing a door from heat or dynamic pressure
+    void DoorDamage()
+    {
+        DoorStatus *pDoors[] = { &nose_status, &rcover_status, &hatch_status, &radiator_status, &brake_status, &gear_status };
+        *pDoors[m_rng.NextUInt64() % 6] = DoorStatus::DOOR_FAILED;
+        TestDamageExit(true);
+    }
+
+    // TestDamage: SCRAM overheat damage to a random engine
+    void ScramOverheat()
+    {
+        const int engineIndex = ((m_rng.NextDouble() < 0.5) ? 0 : 1);
+        m_ramjet.m_integrity[engineIndex] *= max(0.0, 1.0 - m_rng.NextDouble());
+        TestDamageExit(true);
+    }
+
+    // TestDamage with no new damage
+    void QuietFrame() { TestDamageExit(false); }
+
+    // EdPg3Proc: the scenario editor's wing sliders
+    void EditorWingSlider()
+    {
+        const double value = static_cast<double>(m_rng.NextUInt64() % 101) * 0.01;
+        if (m_rng.NextUInt64() & 1)
+            lwingstatus = value;
+        else
+            rwingstatus = value;
+        ApplyDamage();
+    }
+
+    XRRandom &m_rng;
+
+    // damage state, public as in DeltaGliderXR1
+    double lwingstatus, rwingstatus;
+    bool aileronfail[4];
+    DoorStatus gear_status, nose_status, rcover_status, hatch_status, radiator_status, brake_status;
+    int th_main[2], th_retro[2];
+    DamageRamjet *ramjet;
+    double m_hoverEngineIntegrity[2];
+    double m_rcsIntegrityArray[14];
+
+protected:
+    void TestDamageExit(const bool newdamage)
+    {
+        if (newdamage)
+            ApplyDamage();      // also refreshes the damage status table
+    }
+
+    static void UpdateDoorDamage(DoorStatus &doorStatus, const double fracIntegrity)
+    {
+        if (fracIntegrity < 1.0)
+            doorStatus = DoorStatus::DOOR_FAILED;
+        else if (doorStatus == DoorStatus::DOOR_FAILED)
+            doorStatus = DoorStatus::DOOR_CLOSED;
+    }
+
+    // a random integrity: intact, destroyed, or anything in between
+    double RandomIntegrity()
+    {
+        const uint64_t r = m_rng.NextUInt64() % 4;
+        return ((r == 0) ? 1.0 : (r == 1) ? 0.0 : m_rng.NextDouble());
+    }
+
+    // the DMG_ scenario lines and the thruster levels Orbiter restores, set directly without going through SetDamageStatus
+    void LoadRandomDamage()
+    {
+        lwingstatus = RandomIntegrity();
+        rwingstatus = RandomIntegrity();
+        for (int i = 0; i < 4; i++)
+            aileronfail[i] = ((m_rng.NextUInt64() % 4) == 0);
+        DoorStatus *pDoors[] = { &nose_status, &rcover_status, &hatch_status, &radiator_status, &brake_status, &gear_status };
+        for (DoorStatus *pDoor : pDoors)
+            *pDoor = static_cast<DoorStatus>(static_cast<int>(DoorStatus::DOOR_FAILED) + static_cast<int>(m_rng.NextUInt64() % 5));
+        for (int i = 0; i < 2; i++)
+        {
+            m_thrusterMax[th_main[i]] = MAX_MAIN_THRUST[m_config.MainEngineThrust] * RandomIntegrity();
+            m_thrusterMax[th_retro[i]] = MAX_RETRO_THRUST * RandomIntegrity();
+            m_hoverEngineIntegrity[i] = RandomIntegrity();
+            m_ramjet.m_integrity[i] = RandomIntegrity();
+        }
+        for (int i = 0; i < 14; i++)
+            m_rcsIntegrityArray[i] = RandomIntegrity();
+    }
+
+    DamageConfig m_config;
+    DamageRamjet m_ramjet;
+    double m_thrusterMax[THRUSTER_COUNT];
+
+    DamageStatus m_damageStatusTable[DAMAGE_ITEM_COUNT];
+    bool m_damageStatusLabelsValid;
+};
+
+static const int OP_COUNT = 9;
+static const char *s_opNames[OP_COUNT] =
+{
+    "SetDamageStatus", "ResetDamageStatus", "FailGear", "crash", "wing stress", "door damage", "SCRAM overheat", "quiet frame", "editor wing slider"
+};
+
+static long long s_staleEntries = 0;
+
+// compare every cached entry with the legacy GetDamageStatus
+static void CompareWithLegacy(const DamageVessel &vessel, const int op, const char *pOpName)
+{
+    for (int i = 0; i < DAMAGE_ITEM_COUNT; i++)
+    {
+        const DamageItem item = static_cast<DamageItem>(i);
+        const DamageStatus &cached = vessel.GetDamageStatus(item);
+        const DamageStatus &legacy = LegacyGetXR1DamageStatus(vessel, item);
+        if ((cached.fracIntegrity != legacy.fracIntegrity) || (strcmp(cached.label, legacy.label) != 0) ||
+            (strcmp(cached.shortLabel, legacy.shortLabel) != 0) || (cached.onlineOffline != legacy.onlineOffline))
+        {
+            if (s_staleEntries++ < 10)
+                printf("FAIL: op %d (%s): item %d cached %.17g '%s' '%s' %d, legacy %.17g '%s' '%s' %d\n", op, pOpName, i,
+                    cached.fracIntegrity, cached.label, cached.shortLabel, cached.onlineOffline,
+                    legacy.fracIntegrity, legacy.label, legacy.shortLabel, legacy.onlineOffline);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int opCount = 1000000;
+    uint64_t seed = 0xDA3A6E;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--ops") == 0) && pVal)        { opCount = atoi(pVal); i++; }
+        else if ((strcmp(argv[i], "--seed") == 0) && pVal)  { seed = strtoull(pVal, nullptr, 0); i++; }
+        else
+        {
+            puts("usage: damagetablecheck [--ops n] [--seed n]\n"
+                 "  --ops n    number of random damage operations (default 1000000)\n"
+                 "  --seed n   random seed");
+            return 1;
+        }
+    }
+
+    XRRandom rng(seed);
+    DamageVessel *pVessel = new DamageVessel(rng);
+    CompareWithLegacy(*pVessel, -1, "scenario load");
+    long long opCounts[OP_COUNT] = { };
+    int vesselCount = 1;
+    for (int op = 0; op < opCount; op++)
+    {
+        // start a fresh vessel now and then so that crashes do not leave everything at zero
+        if ((rng.NextUInt64() % 2000) == 0)
+        {
+            delete pVessel;
+            pVessel = new DamageVessel(rng);
+            vesselCount++;
+            CompareWithLegacy(*pVessel, op, "scenario load");
+        }
+
+        // SetDamageStatus is the most common path: scenario load and XRVesselCtrl
+        const uint64_t r = rng.NextUInt64() % 100;
+        const int opIndex = (r < 40) ? 0 : (r < 42) ? 1 : (r < 45) ? 2 : (r < 46) ? 3 : (r < 55) ? 4 : (r < 64) ? 5 : (r < 73) ? 6 : (r < 85) ? 7 : 8;
+        switch (opIndex)
+        {
+        case 0:
+        {
+            const DamageItem item = static_cast<DamageItem>(rng.NextUInt64() % DAMAGE_ITEM_COUNT);
+            const double frac = (((rng.NextUInt64() % 3) == 0) ? 1.0 : rng.NextDouble());
+            pVessel->SetDamageStatus(item, frac);
+            break;
+        }
+        case 1: pVessel->ResetDamageStatus(); break;
+        case 2: pVessel->FailGear(); break;
+        case 3: pVessel->Crash(); break;
+        case 4: pVessel->WingStressFailure(); break;
+        case 5: pVessel->DoorDamage(); break;
+        case 6: pVessel->ScramOverheat(); break;
+        case 7: pVessel->QuietFrame(); break;
+        default: pVessel->EditorWingSlider(); break;
+        }
+        opCounts[opIndex]++;
+
+        CompareWithLegacy(*pVessel, op, s_opNames[opIndex]);
+    }
+    delete pVessel;
+
+    printf("%d operations on %d vessels:", opCount, vesselCount);
+    for (int i = 0; i < OP_COUNT; i++)
+        printf("%s %s %lld", ((i > 0) ? "," : ""), s_opNames[i], opCounts[i]);
+    printf("\n%lld stale table entries\n", s_staleEntries);
+    if (s_staleEntries > 0)
+        return 1;
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,533 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// DockingTargetsBench.cpp
+// Checks and times the docking target cache (XR1DockingTargets.h).
+//
+// Runs XR1DockingTargets against a fake nav source with IDS, VOR
+// and XPDR transmitters, four nav radios, and a 36-slot payload bay
+// whose IsChildVesselAttached walks every slot like XRPayloadBay's.
+// Scripted cases check that steady tracking makes no nav data or
+// payload bay lookups after the first frame, and that a retuned
+// radio, a new source on the same channel, and a vessel attached to
+// or detached from the bay are all seen on the next frame.  A
+// vessel without a payload bay must still report its IDS targets.
+// Then --frames random frames (default 200,000) of retuning,
+// transmitters coming into and out of range, and bay attachments,
+// with and without a payload bay, are checked against an uncached
+// per-frame scan.  Finally both are timed over the same --frames
+// frames of steady tracking and the time and lookups per frame are
+// reported.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "XR1DockingTargets.h"
+#include "XRRandom.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static const int TRANSMITTER_COUNT = 8;
+static int s_failures = 0;
+static const int BAY_SLOT_COUNT = 36;      // XR5 payload bay
+static const unsigned int CHANNEL_COUNT = 6;
+
+enum class TransmitterType { IDS, VOR, XPDR };
+
+struct FakeTransmitter
+{
+    TransmitterType type;
+    unsigned int channel;
+    bool inRange;
+    VECTOR3 pos;
+};
+
+// Stands in for Orbiter and the vessel: transmitter handles point into m_transmitters and vessel handles into
+// m_vessels, so both stay valid and unique for the life of the fake.  Every lookup XR1DockingTargets makes is counted.
+class FakeDockingNav : public XR1DockingNav
+{
+public:
+    FakeDockingNav(const bool hasPayloadBay) :
+        m_hasPayloadBay(hasPayloadBay), m_attachmentVersion(0),
+        m_navDataCalls(0), m_navPosCalls(0), m_dockingPortCalls(0), m_bayWalks(0)
+    {
+        for (FakeTransmitter &t : m_transmitters)
+            t = { TransmitterType::IDS, 0, false, { 0, 0, 0 } };
+        for (unsigned int &channel : m_radioChannels)
+            channel = CHANNEL_COUNT;   // no transmitter uses this channel
+        for (int &slot : m_baySlots)
+            slot = -1;
+        m_ourPos = { 0, 0, 0 };
+    }
+
+    virtual NAVHANDLE GetNavSource(const int radio) const
+    {
+        // Orbiter picks a source by signal strength; the fake takes the first in-range transmitter on the channel
+        for (int i = 0; i < TRANSMITTER_COUNT; i++)
+        {
+            const FakeTransmitter &t = m_transmitters[i];
+            if (t.inRange && (t.channel == m_radioChannels[radio]))
+                return GetNavHandle(i);
+        }
+        return nullptr;
+    }
+
+    virtual unsigned int GetNavChannel(const int radio) const { return m_radioChannels[radio]; }
+
+    virtual OBJHANDLE GetIDSVessel(const NAVHANDLE hNav) const
+    {
+        m_navDataCalls++;
+        if (!CheckHandle(hNav, "GetIDSVessel"))
+            return nullptr;
+        const int i = GetTransmitterIndex(hNav);
+        return ((m_transmitters[i].type == TransmitterType::IDS) ? GetVesselHandle(i) : nullptr);
+    }
+
+    virtual VECTOR3 GetNavPos(const NAVHANDLE hNav) const
+    {
+        m_navPosCalls++;
+        if (!CheckHandle(hNav, "GetNavPos"))
+            return { 0, 0, 0 };
+        return m_transmitters[GetTransmitterIndex(hNav)].pos;
+    }
+
+    virtual VECTOR3 GetDockingPortPos() const
+    {
+        m_dockingPortCalls++;
+        return m_ourPos;
+    }
+
+    virtual bool HasPayloadBay() const { return m_hasPayloadBay; }
+    virtual unsigned int GetPayloadAttachmentVersion() const { return m_attachmentVersion; }
+
+    virtual bool IsChildVesselAttached(const OBJHANDLE hVessel) const
+    {
+        m_bayWalks++;
+        for (int slot = 0; slot < BAY_SLOT_COUNT; slot++)
+        {
+            if ((m_baySlots[slot] >= 0) && (GetVesselHandle(m_baySlots[slot]) == hVessel))
+                return true;
+        }
+        return false;
+    }
+
+    NAVHANDLE GetNavHandle(const int transmitter) const { return const_cast<FakeTransmitter *>(m_transmitters + transmitter); }
+    OBJHANDLE GetVesselHandle(const int transmitter) const { return const_cast<char *>(m_vessels + transmitter); }
+    int GetTransmitterIndex(const NAVHANDLE hNav) const { return static_cast<int>(static_cast<FakeTransmitter *>(hNav) - m_transmitters); }
+
+    // attach transmitter's vessel in the first free bay slot, or detach it; returns false if nothing changed
+    bool Attach(const int transmitter)
+    {
+        for (int slot = 0; slot < BAY_SLOT_COUNT; slot++)
+        {
+            if (m_baySlots[slot] == transmitter)
+                return false;
+        }
+        for (int slot = 0; slot < BAY_SLOT_COUNT; slot++)
+        {
+            if (m_baySlots[slot] < 0)
+            {
+                m_baySlots[slot] = transmitter;
+                m_attachmentVersion++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Detach(const int transmitter)
+    {
+        for (int slot = 0; slot < BAY_SLOT_COUNT; slot++)
+        {
+            if (m_baySlots[slot] == transmitter)
+            {
+                m_baySlots[slot] = -1;
+                m_attachmentVersion++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Orbiter's nav calls need a live transmitter; a stale or null handle from the cache would crash the simulator
+    bool CheckHandle(const NAVHANDLE hNav, const char *pMethod) const
+    {
+        const int i = ((hNav != nullptr) ? GetTransmitterIndex(hNav) : -1);
+        if ((i >= 0) && (i < TRANSMITTER_COUNT) && m_transmitters[i].inRange)
+            return true;
+        if (s_failures < 10)
+            printf("FAIL: %s called with a transmitter that is not in range\n", pMethod);
+        s_failures++;
+        return false;
+    }
+
+    void ResetCounts() { m_navDataCalls = m_navPosCalls = m_dockingPortCalls = m_bayWalks = 0; }
+
+    const bool m_hasPayloadBay;
+    FakeTransmitter m_transmitters[TRANSMITTER_COUNT];
+    char m_vessels[TRANSMITTER_COUNT];      // only the addresses are used, as vessel handles
+    unsigned int m_radioChannels[XR1DockingTargets::NAV_RADIO_COUNT];
+    int m_baySlots[BAY_SLOT_COUNT];         // transmitter index of the vessel in each slot, or -1 if empty
+    unsigned int m_attachmentVersion;
+    VECTOR3 m_ourPos;
+
+    mutable long long m_navDataCalls;
+    mutable long long m_navPosCalls;
+    mutable long long m_dockingPortCalls;
+    mutable long long m_bayWalks;
+};
+
+// The uncached scan DockingCalloutsPreStep::GetDockingDistance made every frame before the cache: our docking port
+// position, then each radio's nav data, and a payload bay walk and nav position for every IDS transmitter.  IDS
+// transmitters count on a vessel without a payload bay.
+static double UncachedDockingDistance(const XR1DockingNav &nav)
+{
+    const VECTOR3 ourPos = nav.GetDockingPortPos();
+    double closestIDSSquared = -1;
+
+    for (int i = 0; i < XR1DockingTargets::NAV_RADIO_COUNT; i++)
+    {
+        const NAVHANDLE hNav = nav.GetNavSource(i);
+        if (hNav == nullptr)
+            continue;
+
+        const OBJHANDLE hIDSVessel = nav.GetIDSVessel(hNav);
+        if ((hIDSVessel != nullptr) && (!nav.HasPayloadBay() || !nav.IsChildVesselAttached(hIDSVessel)))
+        {
+            const VECTOR3 targetPos = nav.GetNavPos(hNav);
+            const double dx = ourPos.x - targetPos.x;
+            const double dy = ourPos.y - targetPos.y;
+            const double dz = ourPos.z - targetPos.z;
+            const double distanceSquared = (dx * dx) + (dy * dy) + (dz * dz);
+            if ((closestIDSSquared < 0) || (distanceSquared < closestIDSSquared))
+                closestIDSSquared = distanceSquared;
+        }
+    }
+
+    return ((closestIDSSquared >= 0) ? sqrt(closestIDSSquared) : -1);
+}
+
+static void Fail(const char *pCase, const char *pWhat, const double expected, const double actual)
+{
+    if (s_failures < 10)
+        printf("FAIL: %s: %s: expected %g, got %g\n", pCase, pWhat, expected, actual);
+    s_failures++;
+}
+
+static void CheckDistance(const char *pCase, XR1DockingTargets &targets, FakeDockingNav &nav, const double expected)
+{
+    const double actual = targets.GetDockingDistance(nav);
+    if (actual != expected)
+        Fail(pCase, "distance", expected, actual);
+}
+
+static void CheckCount(const char *pCase, const char *pWhat, const long long expected, const long long actual)
+{
+    if (actual != expected)
+        Fail(pCase, pWhat, static_cast<double>(expected), static_cast<double>(actual));
+}
+
+// Radio 0: IDS 100 m away on channel 0; radio 1: IDS 50 m away on channel 1; radio 2: VOR on channel 2;
+// radio 3: XPDR on channel 3.  Transmitter 4 is a second IDS on channel 1, out of range.
+static void SetUpStation(FakeDockingNav &nav)
+{
+    nav.m_transmitters[0] = { TransmitterType::IDS, 0, true, { 100, 0, 0 } };
+    nav.m_transmitters[1] = { TransmitterType::IDS, 1, true, { 0, 50, 0 } };
+    nav.m_transmitters[2] = { TransmitterType::VOR, 2, true, { 0, 0, 10 } };
+    nav.m_transmitters[3] = { TransmitterType::XPDR, 3, true, { 0, 0, 5 } };
+    nav.m_transmitters[4] = { TransmitterType::IDS, 1, false, { 0, 0, 20 } };
+    for (int radio = 0; radio < XR1DockingTargets::NAV_RADIO_COUNT; radio++)
+        nav.m_radioChannels[radio] = radio;
+}
+
+static void CheckScriptedCases()
+{
+    // steady tracking: the first frame classifies all four transmitters, later frames only read the targets' positions
+    {
+        const char *pCase = "steady tracking";
+        FakeDockingNav nav(true);
+        SetUpStation(nav);
+        XR1DockingTargets targets;
+        CheckDistance(pCase, targets, nav, 50);
+        CheckCount(pCase, "first frame nav data lookups", 4, nav.m_navDataCalls);
+        CheckCount(pCase, "first frame payload bay walks", 2, nav.m_bayWalks);
+
+        nav.ResetCounts();
+        for (int frame = 0; frame < 100; frame++)
+        {
+            nav.m_transmitters[1].pos.y = 50 - (frame * 0.1);
+            nav.m_ourPos.y = frame * 0.1;
+            CheckDistance(pCase, targets, nav, fabs(nav.m_ourPos.y - nav.m_transmitters[1].pos.y));
+        }
+        CheckCount(pCase, "nav data lookups after the first frame", 0, nav.m_navDataCalls);
+        CheckCount(pCase, "payload bay walks after the first frame", 0, nav.m_bayWalks);
+        CheckCount(pCase, "nav position lookups", 200, nav.m_navPosCalls);
+        CheckCount(pCase, "docking port lookups", 100, nav.m_dockingPortCalls);
+    }
+
+    // no targets at all: no docking port lookup, and -1
+    {
+        const char *pCase = "no targets";
+        FakeDockingNav nav(true);
+        SetUpStation(nav);
+        nav.m_transmitters[0].inRange = nav.m_transmitters[1].inRange = false;
+        XR1DockingTargets targets;
+        CheckDistance(pCase, targets, nav, -1);
+        CheckDistance(pCase, targets, nav, -1);
+        CheckCount(pCase, "docking port lookups", 0, nav.m_dockingPortCalls);
+    }
+
+    // retuning a radio is seen on the next frame, and only that radio is classified again
+    {
+        const char *pCase = "channel change";
+        FakeDockingNav nav(true);
+        SetUpStation(nav);
+        XR1DockingTargets targets;
+        CheckDistance(pCase, targets, nav, 50);
+
+        nav.ResetCounts();
+        nav.m_radioChannels[1] = 2;     // IDS 50 m -> VOR
+        CheckDistance(pCase, targets, nav, 100);
+        CheckCount(pCase, "nav data lookups after retuning to a VOR", 1, nav.m_navDataCalls);
+
+        nav.m_radioChannels[3] = 1;     // XPDR -> IDS 50 m
+        CheckDistance(pCase, targets, nav, 50);
+        nav.m_radioChannels[3] = 5;     // nothing on this channel
+        CheckDistance(pCase, targets, nav, 100);
+        CheckCount(pCase, "nav data lookups after three retunes", 2, nav.m_navDataCalls);
+    }
+
+    // a different transmitter on the same channel: the source handle changes while the channel does not
+    {
+        const char *pCase = "source change";
+        FakeDockingNav nav(true);
+        SetUpStation(nav);
+        XR1DockingTargets targets;
+        CheckDistance(pCase, targets, nav, 50);
+
+        nav.m_transmitters[1].inRange = false;
+        nav.m_transmitters[4].inRange = true;           // IDS 20 m, also on channel 1
+        CheckDistance(pCase, targets, nav, 20);
+        nav.m_transmitters[4].inRange = false;
+        nav.m_transmitters[4].type = TransmitterType::VOR;  // its handle comes back as a VOR
+
+        CheckDistance(pCase, targets, nav, 100);
+        nav.m_transmitters[4].inRange = true;
+        CheckDistance(pCase, targets, nav, 100);
+    }
+
+    // attaching a target's vessel in the bay drops it on the next frame, even though its transmitter is still in range
+    // on the same channel; detaching it brings it back
+    {
+        const char *pCase = "bay attach and detach";
+        FakeDockingNav nav(true);
+        SetUpStation(nav);
+        XR1DockingTargets targets;
+        CheckDistance(pCase, targets, nav, 50);
+
+        nav.Attach(1);
+        CheckDistance(pCase, targets, nav, 100);
+        nav.Attach(0);
+        CheckDistance(pCase, targets, nav, -1);
+        nav.Detach(1);
+        CheckDistance(pCase, targets, nav, 50);
+
+        nav.ResetCounts();
+        nav.Attach(6);      // an unrelated vessel: everything is checked again, nothing changes
+        CheckDistance(pCase, targets, nav, 50);
+        CheckCount(pCase, "nav data lookups after an unrelated attachment", 4, nav.m_navDataCalls);
+        nav.ResetCounts();
+        CheckDistance(pCase, targets, nav, 50);
+        CheckCount(pCase, "nav data lookups on the frame after", 0, nav.m_navDataCalls);
+    }
+
+    // A vessel without a payload bay has no attached vessels to exclude: its IDS targets must be reported, never -1.
+    // Regression: the cache once required a payload bay before it would count an IDS transmitter.
+    {
+        const char *pCase = "no payload bay";
+        FakeDockingNav nav(false);
+        SetUpStation(nav);
+        XR1DockingTargets targets;
+        CheckDistance(pCase, targets, nav, 50);
+        CheckCount(pCase, "payload bay walks", 0, nav.m_bayWalks);
+        nav.m_transmitters[1].inRange = false;
+        CheckDistance(pCase, targets, nav, 100);
+        nav.m_radioChannels[2] = 0;
+        nav.m_transmitters[0].inRange = false;
+        CheckDistance(pCase, targets, nav, -1);
+        nav.m_transmitters[0].inRange = true;
+        CheckDistance(pCase, targets, nav, 100);
+    }
+
+    // Reset forgets everything
+    {
+        const char *pCase = "reset";
+        FakeDockingNav nav(true);
+        SetUpStation(nav);
+        XR1DockingTargets targets;
+        CheckDistance(pCase, targets, nav, 50);
+        nav.ResetCounts();
+        targets.Reset();
+        CheckDistance(pCase, targets, nav, 50);
+        CheckCount(pCase, "nav data lookups after Reset", 4, nav.m_navDataCalls);
+    }
+}
+
+// random frames: each transmitter drifts, and now and then a radio is retuned, a transmitter changes channel or comes into
+// or goes out of range, an out-of-range handle is reused by a transmitter of another kind, or a vessel is attached or detached
+static void CheckRandomFrames(const long long frameCount, const bool hasPayloadBay, XRRandom &random)
+{
+    FakeDockingNav nav(hasPayloadBay);
+    for (int i = 0; i < TRANSMITTER_COUNT; i++)
+    {
+        nav.m_transmitters[i] = { static_cast<TransmitterType>(random.NextUInt64() % 3), static_cast<unsigned int>(random.NextUInt64() % CHANNEL_COUNT),
+            random.NextDouble() < 0.7, { random.NextDouble() * 1000, random.NextDouble() * 1000, random.NextDouble() * 1000 } };
+    }
+    for (unsigned int &channel : nav.m_radioChannels)
+        channel = static_cast<unsigned int>(random.NextUInt64() % (CHANNEL_COUNT + 1));
+
+    XR1DockingTargets targets;
+    for (long long frame = 0; frame < frameCount; frame++)
+    {
+        for (FakeTransmitter &t : nav.m_transmitters)
+        {
+            t.pos.x += random.NextDouble() - 0.5;
+            t.pos.y += random.NextDouble() - 0.5;
+        }
+        nav.m_ourPos.z += random.NextDouble() - 0.5;
+
+        const double event = random.NextDouble();
+        const int transmitter = static_cast<int>(random.NextUInt64() % TRANSMITTER_COUNT);
+        if (event < 0.01)
+            nav.m_radioChannels[random.NextUInt64() % XR1DockingTargets::NAV_RADIO_COUNT] = static_cast<unsigned int>(random.NextUInt64() % (CHANNEL_COUNT + 1));
+        else if (event < 0.02)
+            nav.m_transmitters[transmitter].inRange = !nav.m_transmitters[transmitter].inRange;
+        else if (event < 0.025)
+            nav.m_transmitters[transmitter].channel = static_cast<unsigned int>(random.NextUInt64() % CHANNEL_COUNT);
+        else if ((event < 0.03) && !nav.m_transmitters[transmitter].inRange)
+            nav.m_transmitters[transmitter].type = static_cast<TransmitterType>(random.NextUInt64() % 3);
+        else if (event < 0.04)
+            nav.Attach(transmitter);
+        else if (event < 0.05)
+            nav.Detach(transmitter);
+
+        const double expected = UncachedDockingDistance(nav);
+        const double actual = targets.GetDockingDistance(nav);
+        if (actual != expected)
+        {
+            if (s_failures < 10)
+            {
+                printf("FAIL: random frame %lld (%s payload bay): expected %g, got %g\n",
+                    frame, (hasPayloadBay ? "with" : "without"), expected, actual);
+            }
+            s_failures++;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    long long frameCount = 200000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--frames") == 0) && pVal)  { frameCount = atoll(pVal); i++; }
+        else
+        {
+            puts("usage: dockingtargetsbench [--frames n]\n"
+                 "  --frames n  random and timed frames (default 200000)");
+            return 1;
+        }
+    }
+    if (frameCount < 1)
+    {
+        fprintf(stderr, "--frames must be at least 1\n");
+        return 1;
+    }
+
+    CheckScriptedCases();
+
+    XRRandom random(49);
+    CheckRandomFrames(frameCount, true, random);
+    CheckRandomFrames(frameCount, false, random);
+
+    // steady tracking with a full bay: two IDS targets in range, plus a VOR and an XPDR
+    FakeDockingNav nav(true);
+    SetUpStation(nav);
+    for (int i = 0; i < BAY_SLOT_COUNT - 1; i++)
+        nav.m_baySlots[i] = 7;      // a vessel with no transmitter on the radios, so every bay walk checks all slots
+    XR1DockingTargets targets;
+    double cachedSum = 0, uncachedSum = 0;  // keeps the distances live
+
+    nav.ResetCounts();
+    Clock::time_point start = Clock::now();
+    for (long long frame = 0; frame < frameCount; frame++)
+    {
+        nav.m_ourPos.x = static_cast<double>(frame & 1023) * 0.01;
+        cachedSum += targets.GetDockingDistance(nav);
+    }
+    const double cachedSeconds = chrono::duration<double>(Clock::now() - start).count();
+    const long long cachedNavData = nav.m_navDataCalls, cachedBayWalks = nav.m_bayWalks;
+
+    nav.ResetCounts();
+    start = Clock::now();
+    for (long long frame = 0; frame < frameCount; frame++)
+    {
+        nav.m_ourPos.x = static_cast<double>(frame & 1023) * 0.01;
+        uncachedSum += UncachedDockingDistance(nav);
+    }
+    const double uncachedSeconds = chrono::duration<double>(Clock::now() - start).count();
+    const long long uncachedNavData = nav.m_navDataCalls, uncachedBayWalks = nav.m_bayWalks;
+
+    if (cachedSum != uncachedSum)
+    {
+        printf("FAIL: steady tracking: cached distances sum to %.17g, uncached to %.17g\n", cachedSum, uncachedSum);
+        s_failures++;
+    }
+    if ((cachedNavData != 4) || (cachedBayWalks != 2))
+    {
+        printf("FAIL: steady tracking: %lld nav data lookups and %lld payload bay walks over %lld frames, expected 4 and 2\n",
+            cachedNavData, cachedBayWalks, frameCount);
+        s_failures++;
+    }
+
+    printf("%lld frames of steady tracking: cached %.1f ns per frame, %.2f nav data lookups and %.2f payload bay walks; "
+        "uncached %.1f ns per frame, %.2f nav data lookups and %.2f payload bay walks\n",
+        frameCount, cachedSeconds * 1e9 / frameCount, static_cast<double>(cachedNavData) / frameCount, static_cast<double>(cachedBayWalks) / frameCount,
+        uncachedSeconds * 1e9 / frameCount, static_cast<double>(uncachedNavData) / frameCount, static_cast<double>(uncachedBayWalks) / frameCount);
+
+    if (s_failures > 0)
+    {
+        printf("%d checks failed\n", s_failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,251 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// FlightDataRoundTrip.cpp
+// Round-trip check and overhead benchmark for the XR flight data
+// recorder (XRFlightDataRecorder.h) and reader (XRFlightData.h).
+//
+// Records --frames random frames (default 20,000) through the real
+// recorder and its writer thread, where each field changes with
+// probability 1/8 per frame as a vessel's state would, then reads the
+// file back and checks that every frame is bit-identical and that
+// each change mask holds exactly the fields that changed (every field
+// on keyframes).  Record is timed in batches of one ring's worth,
+// waiting for the writer thread to drain between batches so no frame
+// is dropped; the check fails if it averages 1 microsecond per frame
+// or more.  Also checks that the recorder finds the newest Orbiter
+// recording of a vessel in a Flights folder and names the flight data
+// file after it.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "XRFlightDataRecorder.h"
+#include "XRRandom.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+namespace fs = std::filesystem;
+
+static const double MAX_RECORD_NANOSECONDS = 1000;     // per frame
+static const int BATCH_SIZE = XRFlightDataRecorder::RING_SLOTS;   // the ring is empty at the start of each batch
+
+static int s_failures = 0;
+
+static void Fail(const char *pFormat, const char *pDetail, const long long value)
+{
+    if (++s_failures <= 10)
+    {
+        printf("FAIL: ");
+        printf(pFormat, pDetail, value);
+        putchar('\n');
+    }
+}
+
+// exposes how many queued frames the writer thread has not taken yet
+class BenchRecorder : public XRFlightDataRecorder
+{
+public:
+    uint64_t GetQueuedCount() const { return m_writeCount.load(memory_order_acquire) - m_readCount.load(memory_order_acquire); }
+};
+
+static void CheckRecordingNames(const fs::path &flightsFolder)
+{
+    // Orbiter's layout: one folder per recording holding a .pos file for each vessel
+    struct Recording { const char *pName; const char *pVessel; int ageSeconds; };
+    static const Recording s_recordings[] =
+    {
+        { "Launch",          "XR1-01", 300 },
+        { "Reentry",         "XR1-01", 100 },   // newest recording of XR1-01
+        { "Docking",         "XR5-01",  10 },   // newer, but XR1-01 is not in it
+        { "Docking (2)",     "XR1-01", 200 },
+    };
+
+    const auto now = fs::file_time_type::clock::now();
+    for (const Recording &rec : s_recordings)
+    {
+        const fs::path folder = flightsFolder / rec.pName;
+        fs::create_directories(folder);
+        const fs::path posPath = folder / (string(rec.pVessel) + ".pos");
+        ofstream(posPath) << "BEGIN_HEADER\n";
+        fs::last_write_time(posPath, now - chrono::seconds(rec.ageSeconds));
+    }
+    ofstream(flightsFolder / "XR1-01.pos") << "not a recording folder\n";
+
+    const string flights = flightsFolder.string();
+    struct Expected { const char *pVessel; const char *pRecording; };
+    static const Expected s_expected[] = { { "XR1-01", "Reentry" }, { "XR5-01", "Docking" }, { "XR2-01", "" } };
+    for (const Expected &e : s_expected)
+    {
+        const string name = XRFlightDataRecorder::FindOrbiterRecordingName(flights.c_str(), e.pVessel);
+        if (name != e.pRecording)
+            Fail("FindOrbiterRecordingName(%s) returned the wrong recording", e.pVessel, 0);
+    }
+    if (!XRFlightDataRecorder::FindOrbiterRecordingName((flights + "/missing").c_str(), "XR1-01").empty())
+        Fail("FindOrbiterRecordingName found a recording in a %s folder", "missing", 0);
+
+    const fs::path expectedPath = flightsFolder / "Reentry" / "XR1-01.xrfd";
+    if (fs::path(XRFlightDataRecorder::GetFlightDataFilename(flights.c_str(), "Reentry", "XR1-01")) != expectedPath)
+        Fail("GetFlightDataFilename did not return %s", expectedPath.string().c_str(), 0);
+}
+
+// Returns the average Record time per frame in nanoseconds
+static double RecordFrames(const string &filename, const vector<XRFlightDataFrame> &frames)
+{
+    BenchRecorder recorder;
+    if (!recorder.Open(filename.c_str(), "XR1-01", 0.1))
+    {
+        Fail("could not create %s", filename.c_str(), 0);
+        return 0;
+    }
+
+    double recordSeconds = 0;
+    for (size_t start = 0; start < frames.size(); start += BATCH_SIZE)
+    {
+        const size_t end = min(start + BATCH_SIZE, frames.size());
+        const Clock::time_point batchStart = Clock::now();
+        for (size_t i = start; i < end; i++)
+            recorder.Record(frames[i]);
+        recordSeconds += chrono::duration<double>(Clock::now() - batchStart).count();
+
+        while (recorder.GetQueuedCount() > 0)
+            this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    recorder.Close();
+
+    if (recorder.GetDroppedCount() > 0)
+        Fail("the recorder %s %lld frames", "dropped", static_cast<long long>(recorder.GetDroppedCount()));
+    if (recorder.HasWriteError())
+        Fail("the recorder reported a %s error", "write", 0);
+    return recordSeconds * 1e9 / static_cast<double>(frames.size());
+}
+
+static void CheckPlayback(const string &filename, const vector<XRFlightDataFrame> &frames)
+{
+    XRFlightDataReader reader;
+    if (!reader.Open(filename.c_str()))
+    {
+        Fail("could not read %s", filename.c_str(), 0);
+        return;
+    }
+    if ((strcmp(reader.GetHeader().VesselName, "XR1-01") != 0) || (reader.GetHeader().SampleInterval != 0.1))
+        Fail("the file header does not match the %s", "recorder", 0);
+
+    const uint64_t allFields = (XRFLIGHTDATA_FIELD_COUNT == 64) ? ~0ull : ((1ull << XRFLIGHTDATA_FIELD_COUNT) - 1);
+    XRFlightDataFrame frame;
+    for (size_t n = 0; n < frames.size(); n++)
+    {
+        if (reader.ReadNext(frame) != XRFlightDataReader::ReadResult::Frame)
+        {
+            Fail("%s ends at frame %lld", "the file", static_cast<long long>(n));
+            return;
+        }
+        if (memcmp(&frame, &frames[n], sizeof(frame)) != 0)
+            Fail("%s %lld differs from the recorded frame", "frame", static_cast<long long>(n));
+
+        uint64_t expectedMask = allFields;
+        if ((n % XRFLIGHTDATA_KEYFRAME_INTERVAL) != 0)
+        {
+            expectedMask = 0;
+            for (int i = 0; i < XRFLIGHTDATA_FIELD_COUNT; i++)
+            {
+                if (frames[n].Words[i] != frames[n - 1].Words[i])
+                    expectedMask |= (1ull << i);
+            }
+        }
+        if (reader.GetChangeMask() != expectedMask)
+            Fail("%s %lld has the wrong change mask", "frame", static_cast<long long>(n));
+    }
+    if (reader.ReadNext(frame) != XRFlightDataReader::ReadResult::EndOfFile)
+        Fail("%s has data after the last frame", "the file", 0);
+}
+
+int main(int argc, char *argv[])
+{
+    long long frameCount = 20000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--frames") == 0) && pVal)  { frameCount = atoll(pVal); i++; }
+        else
+        {
+            puts("usage: flightdataroundtrip [--frames n]\n"
+                 "  --frames n   frames to record and play back (default 20000)");
+            return 1;
+        }
+    }
+    if (frameCount < 1)
+    {
+        fprintf(stderr, "--frames must be at least 1\n");
+        return 1;
+    }
+
+    const fs::path flightsFolder = fs::temp_directory_path() / ("flightdataroundtrip." + to_string(getpid())) / "Flights";
+    fs::create_directories(flightsFolder);
+    CheckRecordingNames(flightsFolder);
+
+    // random frames in which each field changes with probability 1/8, so that most frames are sparse deltas
+    XRRandom rng(0xF17E);
+    vector<XRFlightDataFrame> frames(static_cast<size_t>(frameCount));
+    for (int i = 0; i < XRFLIGHTDATA_FIELD_COUNT; i++)
+        frames[0].Words[i] = rng.NextUInt64();
+    for (size_t n = 1; n < frames.size(); n++)
+    {
+        frames[n] = frames[n - 1];
+        frames[n].SetDouble(XRFlightDataField::SimTime, n * 0.1);
+        for (int i = 1; i < XRFLIGHTDATA_FIELD_COUNT; i++)
+        {
+            if ((rng.NextUInt64() & 7) == 0)
+                frames[n].Words[i] = rng.NextUInt64();
+        }
+    }
+
+    const string filename = XRFlightDataRecorder::GetFlightDataFilename(flightsFolder.string().c_str(), "Reentry", "XR1-01");
+    const double recordNanoseconds = RecordFrames(filename, frames);
+    CheckPlayback(filename, frames);
+    const uintmax_t fileSize = fs::file_size(filename);
+    fs::remove_all(flightsFolder.parent_path());
+
+    printf("%lld frames: %.1f ns per Record call, %.1f bytes per frame on disk\n",
+        frameCount, recordNanoseconds, static_cast<double>(fileSize) / frameCount);
+    if (recordNanoseconds >= MAX_RECORD_NANOSECONDS)
+        Fail("Record %s %lld ns per frame", "averaged", static_cast<long long>(recordNanoseconds));
+
+    if (s_failures > 0)
+    {
+        printf("%d checks failed\n", s_failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
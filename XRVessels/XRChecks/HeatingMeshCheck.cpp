@@ -0,0 +1,221 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+
+// ==============================================================
+// HeatingMeshCheck.cpp
+// Counts the hull heating mesh updates that XR1HeatingMeshState asks
+// SetHullTempsPostStep to make.
+//
+// Steady cruise: the nosecone is held near --temp K (default 2000 K)
+// through the XR1ThermalNodes kernels, with small AOA, slip and
+// heating turbulence and jittered frame times, for --seconds of
+// flight at 30, 60 and 144 fps.  The first frame must make the group
+// visible and apply one material; every later frame must send zero
+// updates.  The original code applied a material on every visible
+// frame; that count is printed for comparison.
+//
+// Reentry ramp: the nosecone heats steadily from 1000 K to the XR1's
+// nosecone limit.  Visibility must be set once and a material applied
+// once per alpha level.
+//
+// Invalidation: a new mesh instance (a new visual) and a Reset (the
+// visual destroyed) must apply everything again; cooling below the
+// visibility threshold must hide the mesh without a material update.
+//
+// Exit code is 0 if every count matches, 1 otherwise.
+// ==============================================================
+
+#include "XR1HeatingMeshState.h"
+#include "XR1ThermalNodes.h"
+#include "XRRandom.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+static const double NOSECONE_TEMP_LIMIT = 2840 + 273.15;   // CTOK(2840), the XR1's m_hullTemperatureLimits.noseCone
+static const double EXT_TEMP = 220;                         // upper-atmosphere ambient temperature, in Kelvin
+
+static int s_failures = 0;
+
+static void Expect(const bool condition, const char *pWhat)
+{
+    if (!condition && (s_failures++ < 20))
+        printf("FAIL: %s\n", pWhat);
+}
+
+// update counts for one run
+struct MeshUpdateCounts
+{
+    int visibilityUpdates = 0;
+    int materialUpdates = 0;
+    int visibleFrames = 0;      // frames in which the original code applied a material
+
+    void Count(const XR1HeatingMeshState &state)
+    {
+        visibilityUpdates += state.IsVisibilityUpdateDue();
+        materialUpdates += state.IsMaterialUpdateDue();
+        visibleFrames += state.IsVisible();
+    }
+};
+
+// a steady cruise at the supplied nosecone temperature and frame rate; returns false if any frame after the first sent an update
+static bool SteadyCruise(const double cruiseTemp, const double fps, const double seconds, XRRandom &rng)
+{
+    typedef XR1ThermalNodes::HeatSource HeatSource;
+    double noseconeTemp = cruiseTemp;
+    XR1ThermalNodes nodes;
+    nodes.Add(noseconeTemp, HeatSource::Nosecone, 1.0);     // as registered by the SetHullTempsPostStep constructor
+
+    XR1HeatingMeshState state;
+    MeshUpdateCounts counts;
+    double minTemp = cruiseTemp, maxTemp = cruiseTemp;
+    bool laterFramesQuiet = true;
+    const int frameCount = static_cast<int>(seconds * fps);
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+        const double simdt = (1.0 / fps) * (0.75 + rng.NextDouble() * 0.5);     // +/- 25% frame time jitter
+        const double aoa = (rng.NextDouble() - 0.5) * 0.01;                   // radians
+        const double slip = (rng.NextDouble() - 0.5) * 0.005;
+        const double turbulence = 1.0 + (rng.NextDouble() - 0.5) * 0.002;
+
+        // the nosecone heat fraction SetHullTempsPostStep::AddHeat computes, scaled so that the cruise heating peaks at cruiseTemp
+        double sourceHeatFrac[static_cast<int>(HeatSource::Count)] = { };
+        sourceHeatFrac[static_cast<int>(HeatSource::Nosecone)] = (1.0 - (sin(fabs(slip)) / 5 / 2)) * (1.0 - (sin(fabs(aoa)) / 3 / 2));
+        const double degreesK = (cruiseTemp - EXT_TEMP) * turbulence;
+
+        nodes.Gather();
+        nodes.AddHeat(sourceHeatFrac, EXT_TEMP, degreesK);
+        nodes.RemoveHeat(EXT_TEMP, simdt);
+        nodes.Scatter();
+        minTemp = min(minTemp, noseconeTemp);
+        maxTemp = max(maxTemp, noseconeTemp);
+
+        state.Update((frame == 0), noseconeTemp, NOSECONE_TEMP_LIMIT);     // the first frame sees a new mesh
+        counts.Count(state);
+        if ((frame > 0) && (state.IsVisibilityUpdateDue() || state.IsMaterialUpdateDue()))
+            laterFramesQuiet = false;
+    }
+
+    printf("  %.0f K cruise at %3.0f fps: %6d frames, nosecone %.1f-%.1f K, alpha level %d: %d visibility + %d material updates (original code: %d material updates)\n",
+        cruiseTemp, fps, frameCount, minTemp, maxTemp, state.GetAlphaLevel(), counts.visibilityUpdates, counts.materialUpdates, counts.visibleFrames);
+    Expect((counts.visibilityUpdates == 1) && (counts.materialUpdates == 1), "steady cruise: first frame must set visibility and apply one material");
+    Expect(state.GetSkippedUpdateCount() == static_cast<unsigned int>(frameCount - 1), "steady cruise: skipped update count must be every frame after the first");
+    return laterFramesQuiet;
+}
+
+static void ReentryRamp()
+{
+    XR1HeatingMeshState state;
+    MeshUpdateCounts counts;
+    int lastLevel = -1, levelChanges = 0;
+    const int frameCount = 60 * 600;    // ten minutes at 60 fps
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+        const double noseconeTemp = 1000 + (NOSECONE_TEMP_LIMIT - 1000) * frame / (frameCount - 1);
+        state.Update((frame == 0), noseconeTemp, NOSECONE_TEMP_LIMIT);
+        counts.Count(state);
+        if (state.IsVisible() && (state.GetAlphaLevel() != lastLevel))
+        {
+            levelChanges++;
+            lastLevel = state.GetAlphaLevel();
+        }
+    }
+    printf("  reentry ramp 1000-%.0f K: %d visibility + %d material updates, %d alpha levels (original code: %d material updates)\n",
+        NOSECONE_TEMP_LIMIT, counts.visibilityUpdates, counts.materialUpdates, levelChanges, counts.visibleFrames);
+    Expect(counts.visibilityUpdates == 2, "reentry ramp: visibility must be set on the first frame and when the mesh appears");
+    Expect(counts.materialUpdates == (XR1HeatingMeshState::ALPHA_LEVELS + 1), "reentry ramp: one material update per alpha level");
+    Expect(counts.materialUpdates == levelChanges, "reentry ramp: material updates must match alpha level changes");
+    Expect(state.GetAlpha() == 1.0f, "reentry ramp: alpha must reach 1.0 at the nosecone limit");
+}
+
+static void Invalidation()
+{
+    XR1HeatingMeshState state;
+    state.Update(true, 2000, NOSECONE_TEMP_LIMIT);
+    state.Update(false, 2000, NOSECONE_TEMP_LIMIT);
+    Expect(!state.IsVisibilityUpdateDue() && !state.IsMaterialUpdateDue(), "unchanged frame must send nothing");
+
+    state.Update(true, 2000, NOSECONE_TEMP_LIMIT);
+    Expect(state.IsVisibilityUpdateDue() && state.IsMaterialUpdateDue(), "new mesh must apply visibility and material again");
+
+    state.Reset();
+    state.Update(true, 2000, NOSECONE_TEMP_LIMIT);
+    Expect(state.IsVisibilityUpdateDue() && state.IsMaterialUpdateDue(), "reset followed by a new mesh must apply everything again");
+
+    state.Update(false, 500, NOSECONE_TEMP_LIMIT);
+    Expect(state.IsVisibilityUpdateDue() && !state.IsVisible() && !state.IsMaterialUpdateDue(), "cooling below the threshold must hide the mesh without a material update");
+    state.Update(false, 400, NOSECONE_TEMP_LIMIT);
+    Expect(!state.IsVisibilityUpdateDue() && !state.IsMaterialUpdateDue(), "hidden mesh must stay untouched");
+
+    state.Update(false, 2000, NOSECONE_TEMP_LIMIT);
+    Expect(state.IsVisibilityUpdateDue() && state.IsMaterialUpdateDue(), "reheating must show the mesh and apply its material");
+}
+
+int main(int argc, char *argv[])
+{
+    double cruiseTemp = 2000;
+    double seconds = 600;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--temp") == 0) && pVal)          { cruiseTemp = atof(pVal); i++; }
+        else if ((strcmp(argv[i], "--seconds") == 0) && pVal)  { seconds = atof(pVal); i++; }
+        else
+        {
+            puts("usage: heatingmeshcheck [--temp k] [--seconds n]\n"
+                 "  --temp k      steady cruise nosecone temperature in Kelvin (default 2000)\n"
+                 "  --seconds n   length of each steady cruise (default 600)");
+            return 1;
+        }
+    }
+
+    XRRandom rng(0x4EA7);
+    puts("steady cruise:");
+    const double frameRates[] = { 30, 60, 144 };
+    for (const double fps : frameRates)
+    {
+        if (!SteadyCruise(cruiseTemp, fps, seconds, rng))
+        {
+            char msg[128];
+            snprintf(msg, sizeof(msg), "steady %.0f K cruise at %.0f fps sent mesh updates after the first frame", cruiseTemp, fps);
+            Expect(false, msg);
+        }
+    }
+
+    puts("heating changes:");
+    ReentryRamp();
+    Invalidation();
+
+    if (s_failures > 0)
+    {
+        printf("%d checks failed\n", s_failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
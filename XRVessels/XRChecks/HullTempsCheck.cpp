@@ -0,0 +1,356 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// HullTempsCheck.cpp
+// Checks the structure-of-arrays hull temperature kernels
+// (XR1ThermalNodes.h) against the original per-surface code.
+//
+// ScalarHull below is SetHullTempsPostStep's AddHeat / RemoveHeat
+// surface updates as they were before the kernels were introduced.
+// Both versions run --flights random flights of --steps frames each,
+// with the same random heating, slip, AOA, external temperature and
+// frame time, and every surface temperature must agree within 1e-9 K
+// on every frame.  Prints the largest difference seen.
+//
+// Then both versions are timed over the same --timed-frames frames of
+// one long flight (default 1,000,000), built before timing starts, with
+// each version's calls to GetExternalTemperature: the original code
+// fetched it once in AddHeat and once per surface in RemoveSurfaceHeat,
+// the kernels once per pass.  GetExternalTemperature's atmosphere
+// queries go through pointers the compiler cannot see into, standing in
+// for the calls into Orbiter, and the temperatures live in memory
+// between frames as the vessel's do.  The stand-in queries are far
+// cheaper than Orbiter's, so the measured difference understates the
+// saving in the vessel.  The XR1ThermalNodes time includes the Gather
+// and Scatter copies that SetHullTempsPostStep makes around the
+// kernels.  Each version runs five times and its fastest run is
+// reported.  Fails if the final temperatures differ.
+//
+// Exit code is 0 if the versions agree, 1 otherwise.
+// ==============================================================
+
+#include "XR1ThermalNodes.h"
+#include "XRRandom.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+typedef XR1ThermalNodes::HeatSource HeatSource;
+
+static const double TOLERANCE = 1e-9;   // Kelvin
+
+// the per-surface code that SetHullTempsPostStep used before XR1ThermalNodes
+struct ScalarHull
+{
+    double m_noseconeTemp, m_leftWingTemp, m_rightWingTemp, m_cockpitTemp, m_topHullTemp;
+
+    void AddHeat(const double extTemp, const double degreesK, const double noseconeHeatFrac, const double leftWingHeatFrac, const double rightWingHeatFrac, const double cockpitHeatFrac)
+    {
+        // NOSECONE
+        // NOTE: this variable is reused for each surface
+        double newTemp = extTemp + (noseconeHeatFrac * degreesK);
+
+        // Don't ever LOWER the nosecone temp in the "add heat" phase here
+        if (newTemp > m_noseconeTemp)
+            m_noseconeTemp = newTemp;
+
+        // LEFT WING
+        newTemp = extTemp + ((leftWingHeatFrac * degreesK) * 0.75);  // nose gets 25% hotter than wings
+        if (newTemp > m_leftWingTemp)
+            m_leftWingTemp = newTemp;
+
+        // RIGHT WING
+        newTemp = extTemp + ((rightWingHeatFrac * degreesK) * 0.75);
+        if (newTemp > m_rightWingTemp)
+            m_rightWingTemp = newTemp;
+
+        // COCKPIT
+        double cockpitDeltaTemp = (cockpitHeatFrac * degreesK) * .73;  // nose gets 27% hotter than cockpit (max)
+        newTemp = extTemp + cockpitDeltaTemp;
+        if (newTemp > m_cockpitTemp)
+            m_cockpitTemp = newTemp;
+
+        // TOP HULL
+        // top hull gets 80% of the heat that the cockpit does
+        newTemp = extTemp + (cockpitDeltaTemp * 0.80);
+        if (newTemp > m_topHullTemp)
+            m_topHullTemp = newTemp;
+    }
+
+    void RemoveHeat(const double extTemp, const double simdt)
+    {
+        RemoveSurfaceHeat(extTemp, simdt, m_noseconeTemp);
+        RemoveSurfaceHeat(extTemp, simdt, m_leftWingTemp);
+        RemoveSurfaceHeat(extTemp, simdt, m_rightWingTemp);
+        RemoveSurfaceHeat(extTemp, simdt, m_cockpitTemp);
+        RemoveSurfaceHeat(extTemp, simdt, m_topHullTemp);
+    }
+
+    static void RemoveSurfaceHeat(const double extTemp, const double simdt, double &temp)
+    {
+        const double delta = fabs(temp - extTemp);
+
+        // Each surface drops 2% or .1 degree of its heat ABOVE AMBIENT per second, whichever is greater
+        double heatDropped = max((delta * .02), 0.1) * simdt;  // amount of heat dropped in this fraction of a second
+
+        double newTemp = temp - heatDropped;
+        if (newTemp > extTemp)
+            temp = newTemp;
+        else
+            temp = extTemp;   // external temps reached ambient
+    }
+};
+
+// one frame of heating conditions
+struct HullFrame
+{
+    double atmPressure, atmTemperature, degreesK, simdt;
+    bool addHeat;
+    double sourceHeatFrac[static_cast<int>(HeatSource::Count)];
+};
+
+// one long flight through random heating conditions, as in the comparison below but without cold spells or time acceleration
+static void BuildTimedFrames(XRRandom &rng, const int frameCount, vector<HullFrame> &frames)
+{
+    double degreesK = 1500, extTemp = 220, slip = 0, aoa = 0;
+    frames.resize(frameCount);
+    for (HullFrame &f : frames)
+    {
+        degreesK = min(3000.0, max(0.0, degreesK + (rng.NextDouble() - 0.5) * 50));
+        extTemp = min(330.0, max(3.0, extTemp + (rng.NextDouble() - 0.5) * 2));
+        slip = min(3.0, max(-3.0, slip + (rng.NextDouble() - 0.5) * 0.05));
+        aoa = min(1.5, max(-1.5, aoa + (rng.NextDouble() - 0.5) * 0.05));
+        f.atmPressure = 0.01 + rng.NextDouble() * 0.02;    // around OAT_VALID_STATICP_THRESHOLD, so the OAT fraction varies
+        f.atmTemperature = extTemp;
+        f.degreesK = degreesK;
+        f.simdt = rng.NextDouble() * 0.05;
+        f.addHeat = true;
+        f.sourceHeatFrac[static_cast<int>(HeatSource::Nosecone)] = (1.0 - (sin(fabs(slip)) / 5 / 2)) * (1.0 - (sin(fabs(aoa)) / 3 / 2));
+        f.sourceHeatFrac[static_cast<int>(HeatSource::LeftWing)] = min(1.0, 1.0 - (sin(-slip) * 0.9));
+        f.sourceHeatFrac[static_cast<int>(HeatSource::RightWing)] = min(1.0, 1.0 - (sin(slip) * 0.9));
+        f.sourceHeatFrac[static_cast<int>(HeatSource::Cockpit)] = min(1.20, 1.0 - sin(aoa));
+    }
+}
+
+// Stand-ins for the Orbiter atmosphere queries behind DeltaGliderXR1::GetExternalTemperature, for the current timed frame
+static const HullFrame *s_pTimedFrame;
+static double AtmPressure() { return s_pTimedFrame->atmPressure; }
+static double AtmTemperature() { return s_pTimedFrame->atmTemperature; }
+static double (*volatile s_getAtmPressure)() = AtmPressure;
+static double (*volatile s_getAtmTemperature)() = AtmTemperature;
+
+// DeltaGliderXR1::GetExternalTemperature
+static double GetExternalTemperature()
+{
+    double effectiveOATFraction = (s_getAtmPressure() / 0.02);     // OAT_VALID_STATICP_THRESHOLD
+    if (effectiveOATFraction > 1.0)
+        effectiveOATFraction = 1.0;
+    else if (effectiveOATFraction < 0.1)
+        effectiveOATFraction = 0.1;
+    return s_getAtmTemperature() * effectiveOATFraction;
+}
+
+// the vessel's surface temperatures, which other code reads between frames
+static ScalarHull s_timedScalar;
+static double s_timedVesselTemp[5];
+
+// one timed run of the original code; returns its time in seconds and leaves the final temperatures in s_timedScalar
+static double TimeScalarHull(const vector<HullFrame> &frames, const double startTemp)
+{
+    ScalarHull &scalar = s_timedScalar;
+    scalar.m_noseconeTemp = scalar.m_leftWingTemp = scalar.m_rightWingTemp = scalar.m_cockpitTemp = scalar.m_topHullTemp = startTemp;
+    const Clock::time_point start = Clock::now();
+    for (const HullFrame &f : frames)
+    {
+        s_pTimedFrame = &f;
+        if (f.addHeat)
+            scalar.AddHeat(GetExternalTemperature(), f.degreesK, f.sourceHeatFrac[0], f.sourceHeatFrac[1], f.sourceHeatFrac[2], f.sourceHeatFrac[3]);
+
+        // the original RemoveSurfaceHeat fetched the external temperature for each surface
+        ScalarHull::RemoveSurfaceHeat(GetExternalTemperature(), f.simdt, scalar.m_noseconeTemp);
+        ScalarHull::RemoveSurfaceHeat(GetExternalTemperature(), f.simdt, scalar.m_leftWingTemp);
+        ScalarHull::RemoveSurfaceHeat(GetExternalTemperature(), f.simdt, scalar.m_rightWingTemp);
+        ScalarHull::RemoveSurfaceHeat(GetExternalTemperature(), f.simdt, scalar.m_cockpitTemp);
+        ScalarHull::RemoveSurfaceHeat(GetExternalTemperature(), f.simdt, scalar.m_topHullTemp);
+    }
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// one timed run of the kernels as SetHullTempsPostStep drives them; returns its time in seconds and leaves the final temperatures in s_timedVesselTemp
+static double TimeThermalNodes(const vector<HullFrame> &frames, const double startTemp)
+{
+    double *const vesselTemp = s_timedVesselTemp;
+    for (int i = 0; i < 5; i++)
+        vesselTemp[i] = startTemp;
+
+    // same registration as the SetHullTempsPostStep constructor
+    XR1ThermalNodes nodes;
+    nodes.Add(vesselTemp[0], HeatSource::Nosecone, 1.0);
+    nodes.Add(vesselTemp[1], HeatSource::LeftWing, 0.75);
+    nodes.Add(vesselTemp[2], HeatSource::RightWing, 0.75);
+    nodes.Add(vesselTemp[3], HeatSource::Cockpit, 0.73);
+    nodes.Add(vesselTemp[4], HeatSource::Cockpit, 0.73 * 0.80);
+
+    const Clock::time_point start = Clock::now();
+    for (const HullFrame &f : frames)
+    {
+        s_pTimedFrame = &f;
+        nodes.Gather();
+        if (f.addHeat)
+            nodes.AddHeat(f.sourceHeatFrac, GetExternalTemperature(), f.degreesK);
+        nodes.RemoveHeat(GetExternalTemperature(), f.simdt);
+        nodes.Scatter();
+    }
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Time both versions over the same frames, keeping each one's fastest run; returns the largest final temperature difference.
+static double TimeHullTemps(const vector<HullFrame> &frames)
+{
+    const int TIMED_RUNS = 5;
+    const double startTemp = 220;
+    double scalarSeconds = 1e30, nodesSeconds = 1e30;
+    for (int run = 0; run < TIMED_RUNS; run++)
+    {
+        scalarSeconds = min(scalarSeconds, TimeScalarHull(frames, startTemp));
+        nodesSeconds = min(nodesSeconds, TimeThermalNodes(frames, startTemp));
+    }
+
+    const ScalarHull &scalar = s_timedScalar;
+    const double scalarTemp[5] = { scalar.m_noseconeTemp, scalar.m_leftWingTemp, scalar.m_rightWingTemp, scalar.m_cockpitTemp, scalar.m_topHullTemp };
+    double maxDiff = 0;
+    for (int i = 0; i < 5; i++)
+        maxDiff = max(maxDiff, fabs(s_timedVesselTemp[i] - scalarTemp[i]));
+
+    printf("%zu timed frames, 5 surfaces, fastest of %d runs: XR1ThermalNodes %.1f ns per frame, original code %.1f ns per frame; final temperatures differ by %.3g K\n",
+        frames.size(), TIMED_RUNS, nodesSeconds * 1e9 / frames.size(), scalarSeconds * 1e9 / frames.size(), maxDiff);
+    return maxDiff;
+}
+
+int main(int argc, char *argv[])
+{
+    int flightCount = 1000;
+    int stepCount = 10000;
+    int timedFrameCount = 1000000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--flights") == 0) && pVal)     { flightCount = atoi(pVal); i++; }
+        else if ((strcmp(argv[i], "--steps") == 0) && pVal)  { stepCount = atoi(pVal); i++; }
+        else if ((strcmp(argv[i], "--timed-frames") == 0) && pVal)  { timedFrameCount = atoi(pVal); i++; }
+        else
+        {
+            puts("usage: hulltempscheck [--flights n] [--steps n] [--timed-frames n]\n"
+                 "  --flights n        number of random flights (default 1000)\n"
+                 "  --steps n          frames per flight (default 10000)\n"
+                 "  --timed-frames n   frames in the timed comparison (default 1000000)");
+            return 1;
+        }
+    }
+
+    XRRandom rng(0x4E47A7);
+    double maxDiff = 0;
+    long long badFrames = 0;
+    for (int flight = 0; flight < flightCount; flight++)
+    {
+        // both versions start from the same temperatures
+        ScalarHull scalar;
+        const double startTemp = 150 + rng.NextDouble() * 400;
+        scalar.m_noseconeTemp = scalar.m_leftWingTemp = scalar.m_rightWingTemp = scalar.m_cockpitTemp = scalar.m_topHullTemp = startTemp;
+
+        // same registration as the SetHullTempsPostStep constructor
+        double vesselTemp[5] = { startTemp, startTemp, startTemp, startTemp, startTemp };
+        XR1ThermalNodes nodes;
+        nodes.Add(vesselTemp[0], HeatSource::Nosecone, 1.0);
+        nodes.Add(vesselTemp[1], HeatSource::LeftWing, 0.75);
+        nodes.Add(vesselTemp[2], HeatSource::RightWing, 0.75);
+        nodes.Add(vesselTemp[3], HeatSource::Cockpit, 0.73);
+        nodes.Add(vesselTemp[4], HeatSource::Cockpit, 0.73 * 0.80);
+
+        // a flight is a random walk through heating conditions, with occasional cold spells where no heat is added
+        double degreesK = rng.NextDouble() * 3000;
+        double extTemp = 180 + rng.NextDouble() * 120;
+        double slip = 0, aoa = 0;
+        for (int step = 0; step < stepCount; step++)
+        {
+            degreesK = max(0.0, degreesK + (rng.NextDouble() - 0.5) * 50);
+            extTemp = min(330.0, max(3.0, extTemp + (rng.NextDouble() - 0.5) * 2));
+            slip = min(3.0, max(-3.0, slip + (rng.NextDouble() - 0.5) * 0.05));
+            aoa = min(1.5, max(-1.5, aoa + (rng.NextDouble() - 0.5) * 0.05));
+            const double simdt = ((rng.NextUInt64() % 50) == 0) ? rng.NextDouble() : rng.NextDouble() * 0.05;   // include time-accelerated frames
+            const bool addHeat = ((rng.NextUInt64() % 20) != 0);
+
+            // the heat fractions SetHullTempsPostStep::AddHeat computes from slip and AOA
+            double sourceHeatFrac[static_cast<int>(HeatSource::Count)];
+            const double noseconeHeatFrac = (fabs(slip) <= 90.0) ?
+                (1.0 - (sin(fabs(slip)) / 5 / 2)) * (1.0 - (sin(fabs(aoa)) / 3 / 2)) :
+                (sin(fabs(slip)) / 5 / 2) * (sin(fabs(aoa)) / 3 / 2);
+            sourceHeatFrac[static_cast<int>(HeatSource::Nosecone)] = noseconeHeatFrac;
+            sourceHeatFrac[static_cast<int>(HeatSource::LeftWing)] = min(1.0, 1.0 - (sin(-slip) * 0.9));
+            sourceHeatFrac[static_cast<int>(HeatSource::RightWing)] = min(1.0, 1.0 - (sin(slip) * 0.9));
+            sourceHeatFrac[static_cast<int>(HeatSource::Cockpit)] = min(1.20, 1.0 - sin(aoa));
+
+            if (addHeat)
+                scalar.AddHeat(extTemp, degreesK, sourceHeatFrac[0], sourceHeatFrac[1], sourceHeatFrac[2], sourceHeatFrac[3]);
+            scalar.RemoveHeat(extTemp, simdt);
+
+            nodes.Gather();
+            if (addHeat)
+                nodes.AddHeat(sourceHeatFrac, extTemp, degreesK);
+            nodes.RemoveHeat(extTemp, simdt);
+            nodes.Scatter();
+
+            const double scalarTemp[5] = { scalar.m_noseconeTemp, scalar.m_leftWingTemp, scalar.m_rightWingTemp, scalar.m_cockpitTemp, scalar.m_topHullTemp };
+            bool frameOK = true;
+            for (int i = 0; i < 5; i++)
+            {
+                const double diff = fabs(vesselTemp[i] - scalarTemp[i]);
+                maxDiff = max(maxDiff, diff);
+                if (!(diff <= TOLERANCE))   // also catches NaN
+                    frameOK = false;
+            }
+            if (!frameOK && (badFrames++ < 10))
+                printf("FAIL: flight %d step %d: nose %.12f vs %.12f, top hull %.12f vs %.12f\n", flight, step, vesselTemp[0], scalarTemp[0], vesselTemp[4], scalarTemp[4]);
+        }
+    }
+
+    printf("%d flights x %d frames: largest difference %.3g K, %lld frames outside %.0e K\n", flightCount, stepCount, maxDiff, badFrames, TOLERANCE);
+
+    vector<HullFrame> timedFrames;
+    BuildTimedFrames(rng, timedFrameCount, timedFrames);
+    const double timedDiff = TimeHullTemps(timedFrames);
+    if (!(timedDiff <= TOLERANCE))
+        puts("FAIL: the timed runs' final temperatures differ");
+
+    if ((badFrames > 0) || !(timedDiff <= TOLERANCE))
+        return 1;
+    puts("all checks passed");
+    return 0;
+}
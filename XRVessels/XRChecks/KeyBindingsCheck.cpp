@@ -0,0 +1,651 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// KeyBindingsCheck.cpp
+// Synthetic key state check for the XR1 key binding table
+// (XR1KeyBindings.h).
+//
+// The original clbkConsumeBufferedKey and clbkConsumeDirectKey are
+// reproduced below with each handler body replaced by the action it
+// performs.  The check looks up every buffered key with every
+// modifier, autopilot state, arrow inversion setting and playback
+// state in both, and feeds --frames random direct key states
+// (default 1,000,000) to both, and fails if they ever perform
+// different actions or leave different keys down.  It also checks
+// IsAnyKeyDown against a per-key scan, and remapping from config
+// values.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "XR1KeyBindings.h"
+#include "XRRandom.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum class Autopilot { Off, AttitudeHold, DescentHold };
+
+// what a buffered keypress does
+struct Outcome
+{
+    XR1KeyAction Action;
+    int Param;
+    bool ChecksIncap;   // swallowed if the crew is incapacitated
+    int Return;         // value returned to Orbiter: 0 or 1, or -1 if the handler decides
+
+    bool operator==(const Outcome &that) const
+    {
+        return (Action == that.Action) && (Param == that.Param) && (ChecksIncap == that.ChecksIncap) && (Return == that.Return);
+    }
+    bool operator!=(const Outcome &that) const { return !(*this == that); }
+};
+
+static const Outcome UNBOUND = { XR1KeyAction::None, 0, false, 0 };
+
+static Outcome Act(XR1KeyAction action, int param = 0) { return { action, param, true, 1 }; }                  // RET_IF_INCAP(); ...; return 1;
+static Outcome ActIncap(XR1KeyAction action, int param = 0) { return { action, param, false, 1 }; }            // ...; return 1;
+static Outcome Pass(XR1KeyAction action, bool checksIncap) { return { action, 0, checksIncap, 0 }; }          // ...; return 0;
+static Outcome Decide(XR1KeyAction action) { return { action, 0, true, -1 }; }                                // RET_IF_INCAP(); return handler's value;
+
+//-------------------------------------------------------------------------
+// The original clbkConsumeBufferedKey, with each case replaced by the action it performs.  The goto-based arrow
+// inversion is folded into the param's sign.
+
+static Outcome OriginalBufferedKey(const int key, const char *kstate, const Autopilot autopilot, const bool airspeedHold,
+    const bool invertPitch, const bool invertDescent, const bool isPlayback)
+{
+    static const int s_keysAllowedDuringPlayback[] =
+    {
+        OAPI_KEY_T, OAPI_KEY_0, OAPI_KEY_1, OAPI_KEY_2, OAPI_KEY_3, OAPI_KEY_4, OAPI_KEY_5, OAPI_KEY_6, OAPI_KEY_7, OAPI_KEY_8, OAPI_KEY_9,
+        OAPI_KEY_H, OAPI_KEY_W, OAPI_KEY_D
+    };
+
+    if (isPlayback)
+    {
+        bool bKeyAllowed = false;
+        for (const int allowed : s_keysAllowedDuringPlayback)
+            bKeyAllowed |= (key == allowed);
+        if (!bKeyAllowed)
+            return UNBOUND;
+    }
+
+    const int d = invertDescent ? -1 : 1;
+    const int p = invertPitch ? -1 : 1;
+
+    if (KEYMOD_SHIFT(kstate))
+    {
+        if (airspeedHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_ADD:      return Act(XR1KeyAction::AirspeedHoldAdjust, KEYSTEP_SMALL);
+            case OAPI_KEY_SUBTRACT: return Act(XR1KeyAction::AirspeedHoldAdjust, -KEYSTEP_SMALL);
+            }
+        }
+    }
+    else if (KEYMOD_CONTROL(kstate))
+    {
+        if (autopilot == Autopilot::DescentHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_NUMPAD2: return Act(XR1KeyAction::DescentHoldAdjust, d * KEYSTEP_LARGE);
+            case OAPI_KEY_NUMPAD8: return Act(XR1KeyAction::DescentHoldAdjust, -d * KEYSTEP_LARGE);
+            }
+        }
+        else if (autopilot == Autopilot::AttitudeHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_NUMPAD3: return ActIncap(XR1KeyAction::AttitudeHoldLevelBank);
+            case OAPI_KEY_NUMPAD7: return ActIncap(XR1KeyAction::AttitudeHoldLevelPitch);
+            case OAPI_KEY_NUMPAD1: return ActIncap(XR1KeyAction::AttitudeHoldLevelBoth);
+            }
+        }
+
+        if (airspeedHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_ADD:      return Act(XR1KeyAction::AirspeedHoldAdjust, KEYSTEP_LARGE);
+            case OAPI_KEY_SUBTRACT: return Act(XR1KeyAction::AirspeedHoldAdjust, -KEYSTEP_LARGE);
+            }
+        }
+
+        switch (key)
+        {
+        case OAPI_KEY_DIVIDE:    return Pass(XR1KeyAction::None, true);
+        case OAPI_KEY_SLASH:     return Act(XR1KeyAction::ToggleRCSRotation);
+        case OAPI_KEY_BACK:      return Pass(XR1KeyAction::KillScramThrust, true);     // RESETKEY, then break
+        case OAPI_KEY_D:         return Act(XR1KeyAction::Undock);
+        case OAPI_KEY_SPACE:     return ActIncap(XR1KeyAction::None);
+        case OAPI_KEY_A:         return Act(XR1KeyAction::ToggleAPU);
+        case OAPI_KEY_B:         return Act(XR1KeyAction::ToggleAirbrake);
+        case OAPI_KEY_K:         return Act(XR1KeyAction::ToggleNoseCone);
+        case OAPI_KEY_O:         return Act(XR1KeyAction::ToggleOuterAirlock);
+        case OAPI_KEY_Y:         return Act(XR1KeyAction::ToggleTopHatch);
+        case OAPI_KEY_H:         return Pass(XR1KeyAction::HUDPowerSound, false);
+        case OAPI_KEY_MULTIPLY:  return Act(XR1KeyAction::KillHoverThrust);
+        case OAPI_KEY_BACKSLASH: return Act(XR1KeyAction::ToggleRetroDoors);
+        case OAPI_KEY_V:         return Act(XR1KeyAction::ToggleHoverDoors);
+        case OAPI_KEY_G:         return Act(XR1KeyAction::ToggleScramDoors);
+        case OAPI_KEY_1:
+        case OAPI_KEY_2:
+        case OAPI_KEY_3:
+        case OAPI_KEY_4:
+        case OAPI_KEY_5:         return ActIncap(XR1KeyAction::SecondaryHUDMode, key - OAPI_KEY_1 + 1);
+        case OAPI_KEY_T:         return ActIncap(XR1KeyAction::ToggleTertiaryHUD);
+        case OAPI_KEY_W:         return Act(XR1KeyAction::ResetMWS);
+        case OAPI_KEY_SUBTRACT:  return Decide(XR1KeyAction::CheckRetroDoorsIfMainIdle);
+        case OAPI_KEY_L:         return Act(XR1KeyAction::SyncAttitudeHold);
+        }
+    }
+    else if (KEYMOD_ALT(kstate))
+    {
+        if (autopilot == Autopilot::DescentHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_NUMPAD2: return Act(XR1KeyAction::DescentHoldAdjust, d * KEYSTEP_SMALL);
+            case OAPI_KEY_NUMPAD8: return Act(XR1KeyAction::DescentHoldAdjust, -d * KEYSTEP_SMALL);
+            }
+        }
+        else if (autopilot == Autopilot::AttitudeHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_NUMPAD2: return Act(XR1KeyAction::AttitudeHoldPitch, p * KEYSTEP_SMALL);
+            case OAPI_KEY_NUMPAD8: return Act(XR1KeyAction::AttitudeHoldPitch, -p * KEYSTEP_SMALL);
+            }
+        }
+
+        if (airspeedHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_ADD:      return Act(XR1KeyAction::AirspeedHoldAdjust, KEYSTEP_TINY);
+            case OAPI_KEY_SUBTRACT: return Act(XR1KeyAction::AirspeedHoldAdjust, -KEYSTEP_TINY);
+            }
+        }
+
+        switch (key)
+        {
+        case OAPI_KEY_R:        return Act(XR1KeyAction::ToggleRadiator);
+        case OAPI_KEY_T:        return ActIncap(XR1KeyAction::ToggleSecondaryHUD);
+        case OAPI_KEY_H:        return Pass(XR1KeyAction::HUDColorSound, false);
+        case OAPI_KEY_D:        return ActIncap(XR1KeyAction::PreviousMDAMode);
+        case OAPI_KEY_SLASH:    return Act(XR1KeyAction::ToggleAFCtrl);
+        case OAPI_KEY_MULTIPLY: return Act(XR1KeyAction::KillScramThrust);
+        case OAPI_KEY_SPACE:    return ActIncap(XR1KeyAction::ShowDataHUD);
+        case OAPI_KEY_S:        return Act(XR1KeyAction::ToggleAirspeedHold);
+        case OAPI_KEY_O:        return Act(XR1KeyAction::ToggleInnerAirlock);
+        }
+    }
+    else
+    {
+        if (autopilot == Autopilot::AttitudeHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_NUMPAD2: return Act(XR1KeyAction::AttitudeHoldPitch, p * KEYSTEP_LARGE);
+            case OAPI_KEY_NUMPAD8: return Act(XR1KeyAction::AttitudeHoldPitch, -p * KEYSTEP_LARGE);
+            case OAPI_KEY_NUMPAD4: return Act(XR1KeyAction::AttitudeHoldBank, 1);
+            case OAPI_KEY_NUMPAD6: return Act(XR1KeyAction::AttitudeHoldBank, -1);
+            case OAPI_KEY_NUMPAD9: return Act(XR1KeyAction::AttitudeHoldToggleAOAPitch);
+            }
+        }
+        else if (autopilot == Autopilot::DescentHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_NUMPAD2: return Act(XR1KeyAction::DescentHoldAdjust, d * KEYSTEP_MED);
+            case OAPI_KEY_NUMPAD8: return Act(XR1KeyAction::DescentHoldAdjust, -d * KEYSTEP_MED);
+            case OAPI_KEY_NUMPAD0: return Act(XR1KeyAction::DescentHoldAutoLand);
+            case OAPI_KEY_DECIMAL: return Act(XR1KeyAction::DescentHoldLevel);
+            }
+        }
+
+        if (airspeedHold)
+        {
+            switch (key)
+            {
+            case OAPI_KEY_ADD:         return Act(XR1KeyAction::AirspeedHoldAdjust, KEYSTEP_MED);
+            case OAPI_KEY_SUBTRACT:    return Act(XR1KeyAction::AirspeedHoldAdjust, -KEYSTEP_MED);
+            case OAPI_KEY_NUMPADENTER: return Act(XR1KeyAction::AirspeedHoldCurrent);
+            case OAPI_KEY_MULTIPLY:    return Act(XR1KeyAction::AirspeedHoldReset);
+            }
+        }
+
+        switch (key)
+        {
+        case OAPI_KEY_DIVIDE:     return Pass(XR1KeyAction::None, true);
+        case OAPI_KEY_L:          return Act(XR1KeyAction::ToggleAttitudeHold);
+        case OAPI_KEY_A:          return Act(XR1KeyAction::ToggleDescentHold);
+        case OAPI_KEY_LBRACKET:
+        case OAPI_KEY_RBRACKET:
+        case OAPI_KEY_SEMICOLON:
+        case OAPI_KEY_APOSTROPHE:
+        case OAPI_KEY_NUMPAD5:    return Pass(XR1KeyAction::None, true);
+        case OAPI_KEY_0:
+        case OAPI_KEY_1:
+        case OAPI_KEY_2:
+        case OAPI_KEY_3:
+        case OAPI_KEY_4:
+        case OAPI_KEY_5:
+        case OAPI_KEY_6:
+        case OAPI_KEY_7:
+        case OAPI_KEY_8:
+        case OAPI_KEY_9:          return ActIncap(XR1KeyAction::MDAMode, ((key == OAPI_KEY_0) ? 0 : (key - 1)));
+        case OAPI_KEY_D:          return ActIncap(XR1KeyAction::NextMDAMode);
+        case OAPI_KEY_H:          return Pass(XR1KeyAction::HUDModeSound, false);
+        case OAPI_KEY_SLASH:      return Act(XR1KeyAction::ToggleRCSMode);
+        case OAPI_KEY_MULTIPLY:   return Pass(XR1KeyAction::KillMainThrustSound, true);
+        case OAPI_KEY_SUBTRACT:   return Decide(XR1KeyAction::CheckRetroDoors);
+        case OAPI_KEY_G:          return Act(XR1KeyAction::ToggleLandingGear);
+        case OAPI_KEY_SPACE:      return Act(XR1KeyAction::KillAllAutopilots);
+        }
+    }
+    return UNBOUND;
+}
+
+// The table-driven clbkConsumeBufferedKey.  The handler returns are those of PerformBufferedKeyAction in XR1Keys.cpp.
+static Outcome TableBufferedKey(const XR1KeyBindings &bindings, const int key, const char *kstate, const int autopilotMask,
+    const bool invertPitch, const bool invertDescent, const bool isPlayback)
+{
+    const XR1KeyBinding *pBinding = bindings.FindBufferedKey(key, XR1KeyBindings::GetBufferedKeyMod(kstate), autopilotMask);
+    if ((pBinding == nullptr) || (isPlayback && !(pBinding->flags & KBF_ALLOW_IN_PLAYBACK)))
+        return UNBOUND;
+
+    int handlerReturn = 1;
+    switch (pBinding->action)
+    {
+    case XR1KeyAction::CheckRetroDoors:
+    case XR1KeyAction::CheckRetroDoorsIfMainIdle:
+        handlerReturn = -1;
+        break;
+    case XR1KeyAction::KillMainThrustSound:
+    case XR1KeyAction::HUDPowerSound:
+    case XR1KeyAction::HUDModeSound:
+    case XR1KeyAction::HUDColorSound:
+        handlerReturn = 0;
+        break;
+    default:
+        break;
+    }
+
+    return { pBinding->action, XR1KeyBindings::GetInvertedParam(*pBinding, invertPitch, invertDescent), !(pBinding->flags & KBF_ALLOW_IF_INCAP),
+        ((pBinding->flags & KBF_PASS_TO_ORBITER) ? 0 : handlerReturn) };
+}
+
+//-------------------------------------------------------------------------
+// The original autopilot key swallowing and ALT/CTRL/SHIFT blocks of clbkConsumeDirectKey, with each handler body
+// replaced by the action it performs.  The keys that work regardless of modifier are unchanged, so they are not
+// repeated here.
+
+static void OriginalDirectKeys(char *kstate, const Autopilot autopilot, const bool airspeedHold, const bool isIncap,
+    const bool elevatorsOperational, vector<XR1KeyAction> &actions)
+{
+#define RESET_KEY_IF_INCAP(keyCode)  if (KEYDOWN(kstate, keyCode) && isIncap) RESETKEY(kstate, keyCode)
+#define RESET_KEY_IF_PRESSED(keyCode)  if (KEYDOWN(kstate, keyCode)) RESETKEY(kstate, keyCode)
+#define HANDLE(keyCode, action)  if (KEYDOWN(kstate, keyCode)) { actions.push_back(action); RESETKEY(kstate, keyCode); }
+
+    if (autopilot == Autopilot::AttitudeHold)
+    {
+        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD2);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD8);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD4);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD6);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD9);
+    }
+    else if (autopilot == Autopilot::DescentHold)
+    {
+        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD2);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD8);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPAD0);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_DECIMAL);
+    }
+
+    if (airspeedHold)
+    {
+        RESET_KEY_IF_PRESSED(OAPI_KEY_ADD);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_SUBTRACT);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_MULTIPLY);
+        RESET_KEY_IF_PRESSED(OAPI_KEY_NUMPADENTER);
+    }
+
+    if (KEYMOD_ALT(kstate))
+    {
+        HANDLE(OAPI_KEY_1, XR1KeyAction::TweakInternalValueDown);
+        HANDLE(OAPI_KEY_2, XR1KeyAction::TweakInternalValueUp);
+        RESET_KEY_IF_INCAP(OAPI_KEY_COMMA);
+        HANDLE(OAPI_KEY_COMMA, XR1KeyAction::ShiftCOGAft);
+        RESET_KEY_IF_INCAP(OAPI_KEY_PERIOD);
+        HANDLE(OAPI_KEY_PERIOD, XR1KeyAction::ShiftCOGForward);
+        RESET_KEY_IF_INCAP(OAPI_KEY_M);
+        HANDLE(OAPI_KEY_M, XR1KeyAction::RecenterCOG);
+        RESET_KEY_IF_INCAP(OAPI_KEY_ADD);
+        HANDLE(OAPI_KEY_ADD, XR1KeyAction::ScramThrustInc);
+        RESET_KEY_IF_INCAP(OAPI_KEY_SUBTRACT);
+        HANDLE(OAPI_KEY_SUBTRACT, XR1KeyAction::ScramThrustDec);
+        RESET_KEY_IF_INCAP(OAPI_KEY_EQUALS);
+        HANDLE(OAPI_KEY_EQUALS, XR1KeyAction::ScramThrustIncFine);
+        RESET_KEY_IF_INCAP(OAPI_KEY_MINUS);
+        HANDLE(OAPI_KEY_MINUS, XR1KeyAction::ScramThrustDecFine);
+        HANDLE(OAPI_KEY_Z, XR1KeyAction::HUDDimmer);
+        HANDLE(OAPI_KEY_X, XR1KeyAction::HUDBrighter);
+        RESET_KEY_IF_INCAP(OAPI_KEY_SEMICOLON);
+        HANDLE(OAPI_KEY_SEMICOLON, XR1KeyAction::GimbalAllUp);
+        RESET_KEY_IF_INCAP(OAPI_KEY_L);
+        HANDLE(OAPI_KEY_L, XR1KeyAction::GimbalAllRight);
+        RESET_KEY_IF_INCAP(OAPI_KEY_P);
+        HANDLE(OAPI_KEY_P, XR1KeyAction::GimbalAllDown);
+        RESET_KEY_IF_INCAP(OAPI_KEY_APOSTROPHE);
+        HANDLE(OAPI_KEY_APOSTROPHE, XR1KeyAction::GimbalAllLeft);
+        RESET_KEY_IF_INCAP(OAPI_KEY_0);
+        HANDLE(OAPI_KEY_0, XR1KeyAction::GimbalRecenter);
+    }
+
+    if (KEYMOD_CONTROL(kstate))
+    {
+        if (!elevatorsOperational)
+        {
+            RESETKEY(kstate, OAPI_KEY_COMMA);
+            RESETKEY(kstate, OAPI_KEY_PERIOD);
+        }
+
+        RESET_KEY_IF_INCAP(OAPI_KEY_COMMA);
+        HANDLE(OAPI_KEY_COMMA, XR1KeyAction::ElevatorTrimInc);
+        RESET_KEY_IF_INCAP(OAPI_KEY_PERIOD);
+        HANDLE(OAPI_KEY_PERIOD, XR1KeyAction::ElevatorTrimDec);
+        RESET_KEY_IF_INCAP(OAPI_KEY_EQUALS);
+        HANDLE(OAPI_KEY_EQUALS, XR1KeyAction::ScramThrustInc);
+        RESET_KEY_IF_INCAP(OAPI_KEY_MINUS);
+        HANDLE(OAPI_KEY_MINUS, XR1KeyAction::ScramThrustDec);
+    }
+
+    if (KEYMOD_SHIFT(kstate))
+    {
+        RESET_KEY_IF_INCAP(OAPI_KEY_NUMPAD0);
+        HANDLE(OAPI_KEY_NUMPAD0, XR1KeyAction::HoverThrustIncFine);
+        RESET_KEY_IF_INCAP(OAPI_KEY_DECIMAL);
+        HANDLE(OAPI_KEY_DECIMAL, XR1KeyAction::HoverThrustDecFine);
+    }
+
+#undef HANDLE
+#undef RESET_KEY_IF_PRESSED
+#undef RESET_KEY_IF_INCAP
+}
+
+// The table-driven version.  PerformDirectKeyAction's elevator trim does nothing while the elevators are offline.
+static void TableDirectKeys(const XR1KeyBindings &bindings, char *kstate, const int autopilotMask, const bool isIncap,
+    const bool elevatorsOperational, vector<XR1KeyAction> &actions)
+{
+    bindings.SwallowAutopilotKeys(kstate, autopilotMask);
+    bindings.DispatchDirectKeys(kstate, isIncap, [&](const XR1KeyBinding &binding)
+    {
+        const bool isTrim = ((binding.action == XR1KeyAction::ElevatorTrimInc) || (binding.action == XR1KeyAction::ElevatorTrimDec));
+        if (!isTrim || elevatorsOperational)
+            actions.push_back(binding.action);
+    });
+}
+
+//-------------------------------------------------------------------------
+
+static int AutopilotMask(const Autopilot autopilot, const bool airspeedHold)
+{
+    return ((autopilot == Autopilot::AttitudeHold) ? APK_ATTITUDEHOLD : (autopilot == Autopilot::DescentHold) ? APK_DESCENTHOLD : 0) |
+        (airspeedHold ? APK_AIRSPEEDHOLD : 0);
+}
+
+// Sets the modifier keys in modBits (bit 0 = SHIFT, 1 = CTRL, 2 = ALT), using the left or right key at random
+static void SetModifiers(char *kstate, const int modBits, XRRandom &rng)
+{
+    static const int s_keys[3][2] = { { OAPI_KEY_LSHIFT, OAPI_KEY_RSHIFT }, { OAPI_KEY_LCONTROL, OAPI_KEY_RCONTROL }, { OAPI_KEY_LALT, OAPI_KEY_RALT } };
+    for (int m = 0; m < 3; m++)
+    {
+        if (modBits & (1 << m))
+            kstate[s_keys[m][rng.NextDouble() < 0.5]] = static_cast<char>(0x80);
+    }
+}
+
+static string KeyName(const int key, const int modBits)
+{
+    char temp[64];
+    sprintf(temp, "%s%s%skey 0x%02X", (modBits & 1) ? "SHIFT-" : "", (modBits & 2) ? "CTRL-" : "", (modBits & 4) ? "ALT-" : "", key);
+    return temp;
+}
+
+int main(int argc, char *argv[])
+{
+    long long frameCount = 1000000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--frames") == 0) && pVal)  { frameCount = atoll(pVal); i++; }
+        else
+        {
+            puts("usage: keybindingscheck [--frames n]\n"
+                 "  --frames n   random direct key states to check (default 1000000)");
+            return 1;
+        }
+    }
+    if (frameCount < 1)
+    {
+        fprintf(stderr, "--frames must be at least 1\n");
+        return 1;
+    }
+
+    int failures = 0;
+    auto fail = [&failures](const string &msg)
+    {
+        if (++failures <= 10)
+            printf("FAIL: %s\n", msg.c_str());
+    };
+
+    XRRandom rng(0x7E45);
+    const XR1KeyBindings bindings;
+
+    // IsAnyKeyDown against a per-key scan, at every alignment
+    long long anyKeyStates = 0;
+    {
+        char buffer[256 + 8];
+        for (int n = 0; n < 200000; n++)
+        {
+            char *kstate = buffer + (n % 8);
+            for (int i = 0; i < 256; i++)
+                kstate[i] = ((rng.NextDouble() < 0.1) ? static_cast<char>(rng.NextDouble() * 0x80) : 0);    // bits other than KEYDOWN's
+            if (rng.NextDouble() < 0.5)
+                kstate[static_cast<int>(rng.NextDouble() * 256)] |= static_cast<char>(0x80);
+
+            bool expected = false;
+            for (int i = 0; i < 256; i++)
+                expected |= (KEYDOWN(kstate, i) != 0);
+            if (XR1KeyBindings::IsAnyKeyDown(kstate) != expected)
+                fail("IsAnyKeyDown disagrees with a scan of every key");
+            anyKeyStates++;
+        }
+    }
+
+    // every buffered key with every modifier, autopilot state, inversion setting, and playback state
+    long long bufferedLookups = 0, boundLookups = 0;
+    for (int key = 1; key < 256; key++)
+    {
+        for (int modBits = 0; modBits < 8; modBits++)
+        {
+            char kstate[256] = { 0 };
+            SetModifiers(kstate, modBits, rng);
+            for (const Autopilot autopilot : { Autopilot::Off, Autopilot::AttitudeHold, Autopilot::DescentHold })
+            {
+                for (int flags = 0; flags < 16; flags++)
+                {
+                    const bool airspeedHold = (flags & 1), invertPitch = (flags & 2), invertDescent = (flags & 4), isPlayback = (flags & 8);
+                    const Outcome expected = OriginalBufferedKey(key, kstate, autopilot, airspeedHold, invertPitch, invertDescent, isPlayback);
+                    const Outcome actual = TableBufferedKey(bindings, key, kstate, AutopilotMask(autopilot, airspeedHold), invertPitch, invertDescent, isPlayback);
+                    bufferedLookups++;
+                    boundLookups += (actual != UNBOUND);
+                    if (actual != expected)
+                    {
+                        char temp[256];
+                        sprintf(temp, "%s, autopilot %d, flags 0x%X: action %d param %d incap %d return %d, original code %d %d %d %d",
+                            KeyName(key, modBits).c_str(), static_cast<int>(autopilot), flags, static_cast<int>(actual.Action), actual.Param,
+                            actual.ChecksIncap, actual.Return, static_cast<int>(expected.Action), expected.Param, expected.ChecksIncap, expected.Return);
+                        fail(temp);
+                    }
+                }
+            }
+        }
+    }
+
+    // releasing SPACE hides the data HUD, except during playback
+    const XR1KeyBinding *pDataHUD = bindings.FindAction(XR1KeyAction::ShowDataHUD);
+    if ((pDataHUD == nullptr) || (pDataHUD->key != OAPI_KEY_SPACE) || (pDataHUD->flags & KBF_ALLOW_IN_PLAYBACK))
+        fail("the data HUD is not hidden by releasing SPACE outside of playback");
+
+    // random direct key states: modifiers, a few keys that are bound somewhere, and some that are not
+    vector<int> boundKeys;
+    for (const auto *pTable : { &bindings.GetBufferedBindings(), &bindings.GetDirectBindings() })
+    {
+        for (const XR1KeyBinding &binding : *pTable)
+            boundKeys.push_back(binding.key);
+    }
+
+    long long directActions = 0;
+    for (long long frame = 0; frame < frameCount; frame++)
+    {
+        char kstate[256] = { 0 };
+        const int modBits = static_cast<int>(rng.NextDouble() * 8);
+        SetModifiers(kstate, modBits, rng);
+        const int keyCount = 1 + static_cast<int>(rng.NextDouble() * 4);
+        for (int i = 0; i < keyCount; i++)
+        {
+            const int key = (rng.NextDouble() < 0.8) ? boundKeys[static_cast<int>(rng.NextDouble() * boundKeys.size())] : 1 + static_cast<int>(rng.NextDouble() * 255);
+            kstate[key] = static_cast<char>(0x80);
+        }
+        const Autopilot autopilot = static_cast<Autopilot>(static_cast<int>(rng.NextDouble() * 3));
+        const bool airspeedHold = (rng.NextDouble() < 0.5), isIncap = (rng.NextDouble() < 0.2), elevatorsOperational = (rng.NextDouble() < 0.8);
+
+        char originalKstate[256];
+        memcpy(originalKstate, kstate, sizeof(kstate));
+        vector<XR1KeyAction> expected, actual;
+        OriginalDirectKeys(originalKstate, autopilot, airspeedHold, isIncap, elevatorsOperational, expected);
+        TableDirectKeys(bindings, kstate, AutopilotMask(autopilot, airspeedHold), isIncap, elevatorsOperational, actual);
+        directActions += actual.size();
+
+        bool keysMatch = true;
+        for (int i = 0; i < 256; i++)
+            keysMatch &= ((KEYDOWN(kstate, i) != 0) == (KEYDOWN(originalKstate, i) != 0));
+
+        if ((actual != expected) || !keysMatch)
+        {
+            char temp[128];
+            sprintf(temp, "direct key state %lld: %zu actions (original code %zu), %s keys left down", frame, actual.size(), expected.size(),
+                keysMatch ? "same" : "different");
+            fail(temp);
+        }
+    }
+
+    // names are unique, so each can be remapped on its own
+    {
+        vector<string> names;
+        for (const auto *pTable : { &bindings.GetBufferedBindings(), &bindings.GetDirectBindings() })
+        {
+            for (const XR1KeyBinding &binding : *pTable)
+            {
+                if (binding.pName == nullptr)
+                    continue;
+                for (const string &name : names)
+                {
+                    if (strcasecmp(name.c_str(), binding.pName) == 0)
+                        fail(string("binding name used twice: ") + binding.pName);
+                }
+                names.push_back(binding.pName);
+            }
+        }
+    }
+
+    // remapping from config values
+    {
+        XR1KeyBindings remapped;
+        auto expectAction = [&](const int key, const XR1KeyMod mod, const int autopilotMask, const XR1KeyAction action, const char *pWhat)
+        {
+            const XR1KeyBinding *pBinding = remapped.FindBufferedKey(key, mod, autopilotMask);
+            if ((pBinding == nullptr) ? (action != XR1KeyAction::None) : (pBinding->action != action))
+                fail(pWhat);
+        };
+
+        if (!remapped.Remap("ToggleLandingGear", "CTRL-F5") || !remapped.Remap("togglelandinggear", "ctrl-f5"))
+            fail("remapping ToggleLandingGear to CTRL-F5 failed");
+        expectAction(OAPI_KEY_F5, XR1KeyMod::Control, 0, XR1KeyAction::ToggleLandingGear, "CTRL-F5 does not toggle the landing gear after remapping");
+        expectAction(OAPI_KEY_G, XR1KeyMod::None, 0, XR1KeyAction::None, "G still toggles the landing gear after remapping");
+
+        if (!remapped.Remap("ToggleLandingGear", "CTRL-A"))
+            fail("remapping ToggleLandingGear to CTRL-A failed");
+        expectAction(OAPI_KEY_A, XR1KeyMod::Control, 0, XR1KeyAction::ToggleLandingGear, "a remapped binding does not win over the default on its key");
+
+        if (remapped.Remap("NoSuchAction", "G") || remapped.Remap("ToggleAPU", "CTRL-NOSUCHKEY") || remapped.Remap("ToggleAPU", "CTRL-ALT-G") ||
+            remapped.Remap("ToggleAPU", "") || remapped.IsRemappable("NoSuchAction"))
+            fail("an invalid binding name or key was accepted");
+        if (!remapped.IsRemappable("toggleapu"))
+            fail("binding names are not case-insensitive");
+
+        if (!remapped.Remap("KillAllAutopilots", "NONE"))
+            fail("unbinding KillAllAutopilots failed");
+        expectAction(OAPI_KEY_SPACE, XR1KeyMod::None, 0, XR1KeyAction::None, "SPACE still kills the autopilots after unbinding");
+
+        // an engaged autopilot swallows the remapped key instead of the default one
+        if (!remapped.Remap("AttitudeHoldPitchIncLarge", "F6"))
+            fail("remapping AttitudeHoldPitchIncLarge failed");
+        expectAction(OAPI_KEY_F6, XR1KeyMod::None, APK_ATTITUDEHOLD, XR1KeyAction::AttitudeHoldPitch, "F6 does not adjust the attitude hold pitch after remapping");
+        char kstate[256] = { 0 };
+        kstate[OAPI_KEY_F6] = kstate[OAPI_KEY_NUMPAD2] = kstate[OAPI_KEY_NUMPAD8] = static_cast<char>(0x80);
+        remapped.SwallowAutopilotKeys(kstate, APK_ATTITUDEHOLD);
+        if (KEYDOWN(kstate, OAPI_KEY_F6) || !KEYDOWN(kstate, OAPI_KEY_NUMPAD2) || KEYDOWN(kstate, OAPI_KEY_NUMPAD8))
+            fail("attitude hold does not swallow its remapped keys");
+
+        if (!remapped.Remap("GimbalAllUp", "ALT-F7"))
+            fail("remapping GimbalAllUp failed");
+        memset(kstate, 0, sizeof(kstate));
+        kstate[OAPI_KEY_LALT] = kstate[OAPI_KEY_F7] = kstate[OAPI_KEY_SEMICOLON] = static_cast<char>(0x80);
+        vector<XR1KeyAction> actions;
+        remapped.DispatchDirectKeys(kstate, false, [&actions](const XR1KeyBinding &binding) { actions.push_back(binding.action); });
+        if ((actions.size() != 1) || (actions[0] != XR1KeyAction::GimbalAllUp) || !KEYDOWN(kstate, OAPI_KEY_SEMICOLON))
+            fail("ALT-F7 does not gimbal up after remapping, or ALT-SEMICOLON still does");
+    }
+
+    printf("%lld IsAnyKeyDown states; %lld buffered keypresses (%lld bound); %lld direct key states with %lld actions\n",
+        anyKeyStates, bufferedLookups, boundLookups, frameCount, directActions);
+
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,375 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// RamjetSweepCheck.cpp
+// Checks XR1Ramjet against the original SCRAM thrust code over the
+// whole flight envelope.
+//
+// ReferenceRamjet below is XR1Ramjet's Thrust and Temp as they
+// were before the atmosphere constants were cached and the pressure
+// recovery table was added.  Both are built against ScramEnvelope's
+// stub vessel and atmosphere model and evaluated on a grid of Mach
+// 0 - 20, altitude 0 - 100 km, throttle 0 - 1 and SCRAM door open,
+// half-open and closed, for the easy and realistic settings of every
+// vessel preset.  Thrust, fuel flow and the diffuser, burner and
+// exhaust temperatures are compared.
+//
+// Each difference is measured against the largest value of that
+// output over the sweep: thrust is the difference of two large terms,
+// so near zero thrust a relative test only measures the cancellation.
+// With the exact pressure recovery formula (the default) every value
+// must be within 1e-10 of that maximum; with the lookup table, within
+// 1e-5.  The table is built once per process from the
+// first SCRAM_PRESSURE_RECOVERY_MULT it sees, just as each vessel
+// DLL builds its own, so table mode covers the --vessel preset only.
+//
+// The grid stays inside the atmosphere, so the no-atmosphere branch
+// (where the original code never reset the exhaust temperature) is
+// not compared.
+//
+// Exit code is 0 if all values are within tolerance, 1 otherwise.
+// ==============================================================
+
+#include "ScramEnvelopeVessel.h"
+#include "ScramEnvelopeModel.h"
+#include "XR1Ramjet.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+// fractions of the largest value of each output over the sweep
+static const double EXACT_TOLERANCE = 1e-10;
+static const double TABLE_TOLERANCE = 1e-5;
+
+// SCRAM tuning values read by XR1Ramjet; set from each vessel preset in turn
+double SCRAM_COOLING;
+double SCRAM_PRESSURE_RECOVERY_MULT;
+double SCRAM_DMA_SCALE;
+
+// Orbiter's Earth atmosphere constants
+static const ATMCONST s_earthAtmConstants = { 101.4e3, 1.293, 286.91, 1.4 };
+
+const ATMCONST *oapiGetPlanetAtmConstants(OBJHANDLE hPlanet)
+{
+    return ((hPlanet == DeltaGliderXR1::GetAtmosphereHandle()) ? &s_earthAtmConstants : nullptr);
+}
+
+// the original single-engine XR1Ramjet code
+class ReferenceRamjet
+{
+public:
+    ReferenceRamjet(DeltaGliderXR1 *_vessel, THRUSTER_HANDLE th, double Qr, double Ai, double Tb_max, double dmf_max) :
+        vessel(_vessel)
+    {
+        thdef.th = th;
+        thdef.Qr = Qr;
+        thdef.Ai = Ai;
+        thdef.Tb_max = Tb_max;
+        thdef.dmf_max = dmf_max;
+        thdef.dmf = thdef.F = thdef.pd = 0.0;
+        for (int i = 0; i < 3; i++) thdef.T[i] = 0.0;
+    }
+
+    void Thrust(double *F)
+    {
+        const OBJHANDLE hBody = vessel->GetAtmRef();
+        const ATMCONST *atm = (hBody ? oapiGetPlanetAtmConstants(hBody) : 0);
+
+        if (atm)   // atmospheric parameters available
+        {
+            double M, Fs, T0, Td, Tb, Tb0, Te, p0, pd, D, cp, v0, ve, tr, lvl, dma, dmf, precov, dmafac;
+            const double dma_scale = SCRAM_DMA_SCALE;
+
+            M   = vessel->GetMachNumber();                     // Mach number
+            T0  = vessel->GetExternalTemperature();            // freestream temperature
+            p0  = vessel->GetAtmPressure();                    // freestream pressure
+            cp  = atm->gamma * atm->R / (atm->gamma-1.0);      // specific heat (pressure)
+            v0  = M * sqrt (atm->gamma * atm->R * T0);         // freestream velocity
+            tr  = (1.0 + 0.5*(atm->gamma-1.0) * M*M);          // temperature ratio
+            Td  = T0 * tr;                                     // diffuser temperature
+            pd  = p0 * pow (Td/T0, atm->gamma/(atm->gamma-1.0)) * vessel->scramdoor_proc; // diffuser pressure; will be ZERO if SCRAM doors closed
+
+            precov = max (0.0, 1.0 - (0.075*pow(max(M,1.0)-1.0, SCRAM_PRESSURE_RECOVERY_MULT)) ); // pressure recovery
+
+            dmafac = dma_scale*precov*pd;   // will be ZERO if SCRAM doors closed
+
+            Tb0 = thdef.Tb_max;                            // max burner temperature
+            lvl = vessel->GetThrusterLevel(thdef.th);      // throttle level
+
+            if ((pd > 0) & (Tb0 > Td))    // any diffuser pressure AND are we within operational range?
+            {
+                D   = (Tb0-Td) / (thdef.Qr/cp - Tb0);      // max fuel-to-air ratio
+                dma = dmafac * thdef.Ai;                   // air mass flow rate [kg/s]
+
+                double throttleFrac = D * dma / thdef.dmf_max;
+                if (throttleFrac > 1.0)
+                    lvl /= throttleFrac;   // reduce effective level so that 100% throttle == max possible fuel flow
+
+                D   *= lvl;                                // actual fuel-to-air ratio
+                dmf  = D * dma;                            // fuel mass flow rate
+
+                if (dmf > thdef.dmf_max)                   // max fuel rate exceeded
+                {
+                    dmf = thdef.dmf_max;
+                    D = dmf/dma;
+                }
+                Tb   = (D*thdef.Qr/cp + Td) / (1.0+D);     // actual burner temperature
+                Te   = Tb * pow (p0/pd, (atm->gamma-1.0)/atm->gamma); // exhaust temperature
+
+                if (Te > Tb)
+                    goto engines_off;
+
+                ve   = sqrt (2.0*cp*(Tb-Te));              // exhaust velocity
+                Fs  = (1.0+D)*ve - v0;                     // specific thrust
+
+                thdef.F = F[0] = max(0.0, Fs*dma * 1.0);   // thrust force * integrity fraction (0...1)
+
+                if (thdef.F == 0.0)
+                    dmf = 0;    // no flow
+
+                thdef.dmf = dmf;
+                thdef.T[1] = Tb;
+                thdef.T[2] = Te;
+            }
+            else   // overheating or SCRAM doors are closed!
+            {
+engines_off:
+                thdef.F = F[0] = 0.0;
+                thdef.dmf = 0.0;
+                thdef.T[1] = thdef.T[2] = Td;
+            }
+            thdef.T[0] = Td;
+            thdef.pd = pd;
+        }
+        else  // no atmospheric parameters
+        {
+            thdef.dmf = 0.0;
+            thdef.F = F[0] = 0.0;
+            thdef.T[0] = vessel->GetExternalTemperature();
+            thdef.T[1] = vessel->GetExternalTemperature();
+            thdef.T[0] = vessel->GetExternalTemperature();
+            thdef.pd = 0;
+        }
+    }
+
+    double DMF() const { return thdef.dmf; }
+    double GetThrust() const { return thdef.F; }
+
+    double Temp(unsigned int which) const
+    {
+        const double freestreamTemp = vessel->GetExternalTemperature();
+        if (vessel->scramdoor_status == DoorStatus::DOOR_CLOSED)
+            return freestreamTemp;
+
+        double t = thdef.T[which] / SCRAM_COOLING;
+
+        const double mach = vessel->GetMachNumber();
+        if (mach == 0)              // out of atmosphere?
+            return freestreamTemp;
+
+        const double tdFrac = thdef.pd / (76923 * mach);
+        if (tdFrac < 1.0)
+            t *= tdFrac;
+
+        if (t < freestreamTemp)
+            t = freestreamTemp;
+
+        return t;
+    }
+
+protected:
+    struct THDEF
+    {
+        THRUSTER_HANDLE th;
+        double Qr, Ai, Tb_max, dmf_max;
+        double dmf, F, T[3], pd;
+    };
+
+    DeltaGliderXR1 *vessel;
+    THDEF thdef;
+};
+
+// compared outputs
+static const int FIELD_COUNT = 5;
+static const char *s_fieldNames[FIELD_COUNT] = { "thrust", "fuel flow", "diffuser temp", "burner temp", "exhaust temp" };
+
+struct SweepResult
+{
+    long long PointCount = 0;
+    long long BadPoints = 0;
+    double MaxScaledDiff[FIELD_COUNT] = { };  // |diff| / largest reference value of the field over the sweep
+};
+
+// Runs the grid for one preset and setting and accumulates differences into result.
+// Returns false if any value is outside tolerance.
+static bool Sweep(const VesselPreset &preset, const int settingIndex, const bool useTable, const int machSteps, const int altitudeSteps, SweepResult &result)
+{
+    SCRAM_COOLING = preset.Cooling;
+    SCRAM_PRESSURE_RECOVERY_MULT = preset.PressureRecoveryMult;
+    SCRAM_DMA_SCALE = preset.DmaScale;
+
+    // any non-null handle will do for the thruster: the stub vessel applies the same throttle level to every engine
+    static int s_thruster;
+    DeltaGliderXR1 vessel;
+    XR1Ramjet ramjet(&vessel);
+    ramjet.AddThrusterDefinition(&s_thruster, preset.FHV[settingIndex], preset.IntakeArea, preset.InternalTeMax, preset.MaxDMF[settingIndex]);
+    ramjet.SetPressureRecoveryTableEnabled(useTable);
+    ReferenceRamjet reference(&vessel, &s_thruster, preset.FHV[settingIndex], preset.IntakeArea, preset.InternalTeMax, preset.MaxDMF[settingIndex]);
+
+    static const double s_doorFractions[] = { 1.0, 0.5, 0.0 };
+    static const int THROTTLE_STEPS = 5;
+
+    // two passes: the first finds the largest reference value of each field, which scales the tolerance
+    double fieldScale[FIELD_COUNT] = { };
+    bool allOK = true;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (const double doorFraction : s_doorFractions)
+        {
+            vessel.scramdoor_proc = doorFraction;
+            vessel.scramdoor_status = ((doorFraction >= 1.0) ? DoorStatus::DOOR_OPEN : (doorFraction <= 0.0) ? DoorStatus::DOOR_CLOSED : DoorStatus::DOOR_OPENING);
+            for (int a = 0; a < altitudeSteps; a++)
+            {
+                const double altitude = 100e3 * a / (altitudeSteps - 1);
+                const FreestreamState fs = ComputeFreestream(altitude);
+                for (int m = 0; m < machSteps; m++)
+                {
+                    const double mach = 20.0 * m / (machSteps - 1);
+                    vessel.SetFlightState(mach, fs);
+                    for (int t = 0; t < THROTTLE_STEPS; t++)
+                    {
+                        vessel.SetThrottleLevel(static_cast<double>(t) / (THROTTLE_STEPS - 1));
+                        double F, refF;
+                        ramjet.Thrust(&F);
+                        reference.Thrust(&refF);
+
+                        const double actual[FIELD_COUNT] = { ramjet.GetThrust(0), ramjet.DMF(0), ramjet.Temp(0, 0), ramjet.Temp(0, 1), ramjet.Temp(0, 2) };
+                        const double expected[FIELD_COUNT] = { reference.GetThrust(), reference.DMF(), reference.Temp(0), reference.Temp(1), reference.Temp(2) };
+                        if (pass == 0)
+                        {
+                            for (int f = 0; f < FIELD_COUNT; f++)
+                                fieldScale[f] = max(fieldScale[f], fabs(expected[f]));
+                            continue;
+                        }
+
+                        bool pointOK = true;
+                        for (int f = 0; f < FIELD_COUNT; f++)
+                        {
+                            const double diff = fabs(actual[f] - expected[f]);
+                            const double scaledDiff = ((fieldScale[f] > 0) ? diff / fieldScale[f] : diff);
+                            result.MaxScaledDiff[f] = max(result.MaxScaledDiff[f], scaledDiff);
+                            if (!(scaledDiff <= (useTable ? TABLE_TOLERANCE : EXACT_TOLERANCE)))   // also catches NaN
+                            {
+                                if (pointOK && (result.BadPoints < 10))
+                                    printf("FAIL: %s %s%s Mach %.2f altitude %.0f m throttle %.2f door %.1f: %s %.17g vs %.17g\n", preset.pName, (settingIndex == 0) ? "easy" : "realistic",
+                                        (useTable ? " (table)" : ""), mach, altitude, vessel.GetThrusterLevel(&s_thruster), doorFraction, s_fieldNames[f], actual[f], expected[f]);
+                                pointOK = false;
+                            }
+                        }
+                        result.PointCount++;
+                        if (!pointOK)
+                        {
+                            result.BadPoints++;
+                            allOK = false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return allOK;
+}
+
+static void PrintResult(const char *pTitle, const SweepResult &result, const bool useTable)
+{
+    printf("%s: %lld points, %lld outside %.0e of the sweep maximum\n", pTitle, result.PointCount, result.BadPoints, (useTable ? TABLE_TOLERANCE : EXACT_TOLERANCE));
+    for (int f = 0; f < FIELD_COUNT; f++)
+        printf("  %-14s largest difference %.3g of the sweep maximum\n", s_fieldNames[f], result.MaxScaledDiff[f]);
+}
+
+int main(int argc, char *argv[])
+{
+    int machSteps = 201;
+    int altitudeSteps = 201;
+    const VesselPreset *pTablePreset = &s_vesselPresets[0];
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--mach-steps") == 0) && pVal)            { machSteps = atoi(pVal); i++; }
+        else if ((strcmp(argv[i], "--altitude-steps") == 0) && pVal)   { altitudeSteps = atoi(pVal); i++; }
+        else if ((strcmp(argv[i], "--vessel") == 0) && pVal)
+        {
+            pTablePreset = nullptr;
+            for (const VesselPreset &preset : s_vesselPresets)
+            {
+                if (strcmp(preset.pName, pVal) == 0)
+                    pTablePreset = &preset;
+            }
+            if (!pTablePreset)
+            {
+                fprintf(stderr, "unknown vessel: %s\n", pVal);
+                return 1;
+            }
+            i++;
+        }
+        else
+        {
+            puts("usage: ramjetsweepcheck [--mach-steps n] [--altitude-steps n] [--vessel xr1|xr2|xr5]\n"
+                 "  --mach-steps n       Mach 0 - 20 grid points (default 201)\n"
+                 "  --altitude-steps n   altitude 0 - 100 km grid points (default 201)\n"
+                 "  --vessel name        preset checked with the pressure recovery table (default xr1)");
+            return 1;
+        }
+    }
+    if ((machSteps < 2) || (altitudeSteps < 2))
+    {
+        fprintf(stderr, "--mach-steps and --altitude-steps must be at least 2\n");
+        return 1;
+    }
+
+    // the exact formula for every preset and setting; this never touches the lookup table
+    bool allOK = true;
+    SweepResult exactResult;
+    for (const VesselPreset &preset : s_vesselPresets)
+    {
+        for (int settingIndex = 0; settingIndex < 2; settingIndex++)
+            allOK &= Sweep(preset, settingIndex, false, machSteps, altitudeSteps, exactResult);
+    }
+    PrintResult("exact pressure recovery, all vessels", exactResult, false);
+
+    SweepResult tableResult;
+    for (int settingIndex = 0; settingIndex < 2; settingIndex++)
+        allOK &= Sweep(*pTablePreset, settingIndex, true, machSteps, altitudeSteps, tableResult);
+    char title[64];
+    snprintf(title, sizeof(title), "pressure recovery table, %s", pTablePreset->pName);
+    PrintResult(title, tableResult, true);
+
+    if (!allOK)
+        return 1;
+    puts("all checks passed");
+    return 0;
+}
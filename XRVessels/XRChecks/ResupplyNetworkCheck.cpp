@@ -0,0 +1,440 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// ResupplyNetworkCheck.cpp
+// Checks the resupply flow network (XR1ResupplyNetwork.h) against
+// the original per-line resupply code.
+//
+// OriginalLines below is the original FlowMainFuel, FlowScramFuel,
+// FlowApuFuel and FlowLox arithmetic.  An empty XR5, with and
+// without payload bay tanks, is resupplied through all four lines
+// at once at time accelerations from 1x to 10000x, both ways, with
+// the same line pressures, and each line must switch off on the
+// same frame with the same tank contents.  Also checks series
+// resistance, ullage pressure and cross-feed flows against their
+// closed forms, and runs --trials random networks and timesteps
+// (default 100,000), which must never overfill a tank or lose mass
+// beyond rounding.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "XR1ResupplyNetwork.h"
+#include "XRRandom.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+// XR5Globals.cpp values
+static const double FUEL_LOAD_RATE = 72 * 22.2;
+static const double SCRAM_FLOW_FRACTION = 0.40;
+static const double APU_FLOW_FRACTION = 0.04;
+static const double LOX_LOAD_FRAC = .0069;
+static const double LOX_MIN_FLOW_RATE = 1.927;
+static const double PRESSURE_MOVEMENT_RATE = .20;
+static const double RESUPPLY_RANDOM_LIMIT = 0.02;
+static const double RESUPPLY_UPPER_LIMIT = 0.84;
+static const double RESUPPLY_LOWER_LIMIT = 0.25;
+static const double RESUPPLY_GROUND_PSI_FACTOR = 0.741;
+
+enum { TANK_MAIN, TANK_SCRAM, TANK_APU, TANK_LOX, LINE_COUNT };
+
+struct TankSpec
+{
+    const char *pName;
+    double shipCapacity;            // in kg; LOX is the default 14-day loadout for 18 crew
+    double bayCapacity;             // in kg; XR5-ER auxiliary tanks (four main, two SCRAM, one LOX)
+    double nominalFlowRate;         // in kg/second
+    double capacityFlowFraction;
+    double maxPressure;             // in PSI
+    double pressureMovementRate;
+};
+
+static const TankSpec s_tanks[LINE_COUNT] =
+{
+    { "main",  230880.0,       4 * 13000.0, FUEL_LOAD_RATE,                       0,             30.0, PRESSURE_MOVEMENT_RATE * 1.14 },
+    { "SCRAM",  55500.0,       2 * 13000.0, FUEL_LOAD_RATE * SCRAM_FLOW_FRACTION, 0,             21.0, PRESSURE_MOVEMENT_RATE * 1.0  },
+    { "APU",     4440.0,       0,           FUEL_LOAD_RATE * APU_FLOW_FRACTION,   0,              6.0, PRESSURE_MOVEMENT_RATE * 0.92 },
+    { "LOX",      130 * 3.6,   10000.0,     LOX_MIN_FLOW_RATE,                    LOX_LOAD_FRAC, 15.0, PRESSURE_MOVEMENT_RATE * 0.86 },
+};
+
+static const double RCS_CAPACITY = 13320.0;
+static const double BAY_LINK_RESISTANCE = 1e-9;     // ResupplyPostStep's default
+
+// LinePressure::AdjustPressure for a grounded ship
+struct LinePressure
+{
+    double linePressure = 0, nominalLinePressure = 0, pressureTarget = -1, initialPressureTarget = 0;
+    double maxPressure, pressureMovementRate;
+
+    void Adjust(const double simdt, const bool flowInProgress, XRRandom &rng)
+    {
+        if (pressureTarget < 0)
+        {
+            nominalLinePressure = maxPressure * RESUPPLY_GROUND_PSI_FACTOR;
+            pressureTarget = maxPressure * RESUPPLY_GROUND_PSI_FACTOR;
+            const double sign = ((rng.NextDouble() < 0.5) ? -1.0 : 1.0);
+            pressureTarget += maxPressure * RESUPPLY_RANDOM_LIMIT * rng.NextDouble() * sign;
+            initialPressureTarget = pressureTarget;
+        }
+        else
+        {
+            const double psiDelta = simdt * (pressureMovementRate * maxPressure * ((pressureTarget > 0) ? 1.0 : 2.2));
+            if (linePressure < pressureTarget)
+                linePressure = min(linePressure + psiDelta, pressureTarget);
+            else if (linePressure > pressureTarget)
+                linePressure = max(linePressure - psiDelta, pressureTarget);
+            else if (flowInProgress)
+            {
+                const double sign = ((rng.NextDouble() < 0.5) ? -1.0 : 1.0);
+                const double variance = maxPressure * RESUPPLY_RANDOM_LIMIT * rng.NextDouble() * sign;
+                pressureTarget = (initialPressureTarget * 0.81) + variance;
+                if (pressureTarget > (maxPressure * RESUPPLY_UPPER_LIMIT))
+                    pressureTarget -= (variance * 2);
+                else if (pressureTarget < (maxPressure * RESUPPLY_LOWER_LIMIT))
+                    pressureTarget += (variance * 2);
+            }
+        }
+    }
+};
+
+// the original FlowMainFuel, FlowScramFuel, FlowApuFuel and FlowLox; masses include the bay tanks
+struct OriginalLines
+{
+    double mass[LINE_COUNT] = { };
+    double capacity[LINE_COUNT];
+    bool flowSwitch[LINE_COUNT];
+
+    void Flow(const int tank, const double simdt, const LinePressure &pressure)
+    {
+        if (!flowSwitch[tank])
+            return;
+
+        if (mass[tank] >= capacity[tank])
+        {
+            flowSwitch[tank] = false;   // "tanks already full"
+            return;
+        }
+
+        const double pressureFrac = pressure.linePressure / pressure.nominalLinePressure;
+        const TankSpec &spec = s_tanks[tank];
+        const double flowRate = ((tank == TANK_LOX) ? max(capacity[tank] * LOX_LOAD_FRAC * pressureFrac, LOX_MIN_FLOW_RATE * pressureFrac) :
+            spec.nominalFlowRate * pressureFrac);
+        mass[tank] += flowRate * simdt;
+        if (mass[tank] > capacity[tank])
+        {
+            mass[tank] = capacity[tank];
+            flowSwitch[tank] = false;
+        }
+    }
+};
+
+// the network as ResupplyPostStep builds and runs it
+struct NetworkLines
+{
+    XR1ResupplyNetwork network;
+    int bayTank[LINE_COUNT];
+    bool flowSwitch[LINE_COUNT];
+
+    explicit NetworkLines(const bool withBay)
+    {
+        for (int tank = 0; tank < LINE_COUNT; tank++)
+        {
+            network.AddTank(s_tanks[tank].shipCapacity);
+            network.AddLine(tank, 1.0);
+            flowSwitch[tank] = true;
+        }
+        for (int tank = 0; tank < LINE_COUNT; tank++)
+        {
+            bayTank[tank] = -1;
+            if (tank != TANK_APU)
+            {
+                bayTank[tank] = network.AddTank(withBay ? s_tanks[tank].bayCapacity : 0);
+                network.GetLink(network.AddLink(tank, bayTank[tank], BAY_LINK_RESISTANCE)).Open = true;
+            }
+        }
+    }
+
+    double Mass(const int tank) const { return network.GetTank(tank).Mass + ((bayTank[tank] >= 0) ? network.GetTank(bayTank[tank]).Mass : 0); }
+    double Capacity(const int tank) const { return network.GetTank(tank).Capacity + ((bayTank[tank] >= 0) ? network.GetTank(bayTank[tank]).Capacity : 0); }
+    bool IsTankFull(const int tank) const { return (network.IsFull(tank) && ((bayTank[tank] < 0) || network.IsFull(bayTank[tank]))); }
+
+    void Flow(const double simdt, const LinePressure *pPressure)
+    {
+        for (int tank = 0; tank < LINE_COUNT; tank++)
+        {
+            XR1ResupplyNetwork::Line &line = network.GetLine(tank);
+            const double flowRate = max(s_tanks[tank].nominalFlowRate, Capacity(tank) * s_tanks[tank].capacityFlowFraction);
+            line.Pressure = pPressure[tank].linePressure;
+            line.Resistance = pPressure[tank].nominalLinePressure / flowRate;
+            line.Open = flowSwitch[tank];
+        }
+
+        network.Solve(simdt);
+
+        for (int tank = 0; tank < LINE_COUNT; tank++)
+        {
+            if (flowSwitch[tank] && (network.GetLineFlowRate(tank) <= 0) && IsTankFull(tank))
+                flowSwitch[tank] = false;
+        }
+    }
+};
+
+static int s_failures = 0;
+static void Fail(const string &msg)
+{
+    if (++s_failures <= 10)
+        printf("FAIL: %s\n", msg.c_str());
+}
+
+static bool Near(const double a, const double b, const double relTolerance)
+{
+    return (fabs(a - b) <= relTolerance * max(1.0, max(fabs(a), fabs(b))));
+}
+
+// Resupply an empty XR5 through all four lines at once; prints and checks the frame on which each line switches off.
+static void FillXR5(const bool withBay, const double timeAcc)
+{
+    const double simdt = timeAcc / 60.0;
+    XRRandom rng(0x5E5);
+    LinePressure pressure[LINE_COUNT];
+    OriginalLines original;
+    NetworkLines network(withBay);
+    for (int tank = 0; tank < LINE_COUNT; tank++)
+    {
+        pressure[tank].maxPressure = s_tanks[tank].maxPressure;
+        pressure[tank].pressureMovementRate = s_tanks[tank].pressureMovementRate;
+        pressure[tank].Adjust(simdt, true, rng);   // the frame the lines come online only sets the pressure targets
+        original.capacity[tank] = network.Capacity(tank);
+        original.flowSwitch[tank] = true;
+    }
+
+    int fillFrame[LINE_COUNT] = { -1, -1, -1, -1 };
+    for (int frame = 1; frame < 10000000; frame++)
+    {
+        bool anyFlowing = false;
+        for (int tank = 0; tank < LINE_COUNT; tank++)
+        {
+            original.Flow(tank, simdt, pressure[tank]);
+            anyFlowing |= original.flowSwitch[tank];
+        }
+        network.Flow(simdt, pressure);
+
+        for (int tank = 0; tank < LINE_COUNT; tank++)
+        {
+            if ((original.flowSwitch[tank] != network.flowSwitch[tank]) || !Near(original.mass[tank], network.Mass(tank), 1e-6))
+            {
+                char temp[200];
+                sprintf(temp, "%s XR5 at %gx, frame %d: %s line %s with %.3f kg (original code %s with %.3f kg)", (withBay ? "bay-tanked" : "empty"),
+                    timeAcc, frame, s_tanks[tank].pName, (network.flowSwitch[tank] ? "on" : "off"), network.Mass(tank),
+                    (original.flowSwitch[tank] ? "on" : "off"), original.mass[tank]);
+                Fail(temp);
+                return;
+            }
+            if ((fillFrame[tank] < 0) && !original.flowSwitch[tank])
+                fillFrame[tank] = frame;
+
+            // the ship tank fills before the bay tanks take anything
+            if ((network.bayTank[tank] >= 0) && (network.network.GetTank(network.bayTank[tank]).Mass > 0) && !network.network.IsFull(tank))
+                Fail(string(s_tanks[tank].pName) + " bay tanks filled before the ship tank");
+        }
+
+        if (!anyFlowing)
+            break;
+
+        for (int tank = 0; tank < LINE_COUNT; tank++)
+            pressure[tank].Adjust(simdt, original.flowSwitch[tank], rng);
+    }
+
+    printf("%s XR5 at %6gx: filled in", (withBay ? "bay-tanked" : "empty     "), timeAcc);
+    for (int tank = 0; tank < LINE_COUNT; tank++)
+        printf(" %s %.1f s", s_tanks[tank].pName, fillFrame[tank] * simdt);
+    printf(" (same frames as original code)\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int trialCount = 100000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--trials") == 0) && pVal)  { trialCount = atoi(pVal); i++; }
+        else
+        {
+            puts("usage: resupplynetworkcheck [--trials n]\n"
+                 "  --trials n   random networks to run (default 100000)");
+            return 1;
+        }
+    }
+
+    // fill times against the original code
+    for (const bool withBay : { false, true })
+    {
+        for (const double timeAcc : { 1.0, 10.0, 100.0, 1000.0, 10000.0 })
+            FillXR5(withBay, timeAcc);
+    }
+
+    // closed forms: a full ship tank and bay tank pass the line's flow on through the cross-feed link in series,
+    // and ullage pressure opposes the line pressure
+    {
+        XR1ResupplyNetwork network;
+        const int main = network.AddTank(100);
+        const int bay = network.AddTank(50);
+        const int rcs = network.AddTank(1000, 2.0);
+        const int line = network.AddLine(main, 0.01);
+        const int bayLink = network.AddLink(main, bay, 0.03);
+        const int xfeedLink = network.AddLink(bay, rcs, 0.02);
+        network.GetLine(line).Pressure = 20;
+        network.GetLine(line).Open = network.GetLink(bayLink).Open = network.GetLink(xfeedLink).Open = true;
+        network.GetTank(main).Mass = 100;
+        network.GetTank(bay).Mass = 50;
+
+        network.Solve(1.0);
+        if (!Near(network.GetLineFlowRate(line), (20.0 - 2.0) / (0.01 + 0.03 + 0.02), 1e-12) || !Near(network.GetTank(rcs).Mass, 300.0, 1e-12))
+            Fail("series flow through two full tanks is not (line pressure - ullage pressure) / total resistance");
+
+        network.GetTank(rcs).Pressure = 25;     // more than the line pressure
+        network.Solve(1.0);
+        if ((network.GetLineFlowRate(line) != 0) || (network.GetLineFlow(line) != 0) || !Near(network.GetTank(rcs).Mass, 300.0, 1e-12))
+            Fail("flow ran backward against ullage pressure above the line pressure");
+
+        // the same network with the cross-feed link closed is a dead end
+        network.GetTank(rcs).Pressure = 0;
+        network.GetLink(xfeedLink).Open = false;
+        network.Solve(1.0);
+        if (network.GetLineFlowRate(line) != 0)
+            Fail("a line into full tanks with no open link still flows");
+    }
+
+    // one huge timestep fills exactly as many small ones do
+    {
+        auto fill = [](const int steps, const double simdt, double *pMass, double &lineFlow)
+        {
+            XR1ResupplyNetwork network;
+            const int main = network.AddTank(230880.0);
+            const int bay = network.AddTank(52000.0);
+            const int rcs = network.AddTank(13320.0);
+            const int line = network.AddLine(main, 22.2 / FUEL_LOAD_RATE);
+            network.GetLink(network.AddLink(main, bay, 0.001)).Open = true;
+            network.GetLink(network.AddLink(main, rcs, 0.05)).Open = true;
+            network.GetLine(line).Pressure = 22.2;
+            network.GetLine(line).Open = true;
+            lineFlow = 0;
+            for (int i = 0; i < steps; i++)
+            {
+                network.Solve(simdt);
+                lineFlow += network.GetLineFlow(line);
+            }
+            for (int i = 0; i < 3; i++)
+                pMass[i] = network.GetTank(i).Mass;
+        };
+
+        double coarse[3], fine[3], coarseFlow, fineFlow;
+        fill(1, 1e6, coarse, coarseFlow);
+        fill(100000, 10.0, fine, fineFlow);
+        if ((coarse[0] != 230880.0) || (coarse[1] != 52000.0) || (coarse[2] != 13320.0) || (fine[0] != 230880.0) || (fine[1] != 52000.0) || (fine[2] != 13320.0) ||
+            !Near(coarseFlow, 230880.0 + 52000.0 + 13320.0, 1e-12) || !Near(fineFlow, coarseFlow, 1e-12))
+            Fail("a single 10^6 second timestep does not fill the tanks exactly as 10^5 ten-second timesteps do");
+    }
+
+    // random networks and timesteps: no tank overfills or loses mass, and the lines deliver what the tanks gain
+    XRRandom rng(0x4E7);
+    double worstMassError = 0;
+    for (int trial = 0; trial < trialCount; trial++)
+    {
+        XR1ResupplyNetwork network;
+        const int tankCount = 2 + static_cast<int>(rng.NextDouble() * (XR1ResupplyNetwork::MAX_TANKS - 1));
+        for (int i = 0; i < tankCount; i++)
+        {
+            const double capacity = ((rng.NextDouble() < 0.1) ? 0 : 1 + rng.NextDouble() * 1e5);
+            const int tank = network.AddTank(capacity, ((rng.NextDouble() < 0.5) ? 0 : rng.NextDouble() * 20));
+            network.GetTank(tank).Mass = ((rng.NextDouble() < 0.3) ? capacity : capacity * rng.NextDouble());
+        }
+        const int lineCount = 1 + static_cast<int>(rng.NextDouble() * 4);
+        for (int i = 0; i < lineCount; i++)
+        {
+            XR1ResupplyNetwork::Line &line = network.GetLine(network.AddLine(static_cast<int>(rng.NextDouble() * tankCount), 1e-4 + rng.NextDouble() * 0.1));
+            line.Pressure = rng.NextDouble() * 30;
+            line.Open = (rng.NextDouble() < 0.9);
+        }
+        const int linkCount = static_cast<int>(rng.NextDouble() * (XR1ResupplyNetwork::MAX_LINKS + 1));
+        for (int i = 0; i < linkCount; i++)
+        {
+            const int from = static_cast<int>(rng.NextDouble() * tankCount);
+            const int to = (from + 1 + static_cast<int>(rng.NextDouble() * (tankCount - 1))) % tankCount;
+            network.GetLink(network.AddLink(from, to, ((rng.NextDouble() < 0.3) ? 1e-9 : 1e-4 + rng.NextDouble() * 0.1))).Open = (rng.NextDouble() < 0.9);
+        }
+
+        for (int step = 0; step < 5; step++)
+        {
+            double before = 0;
+            double prevMass[XR1ResupplyNetwork::MAX_TANKS];
+            for (int i = 0; i < tankCount; i++)
+                before += (prevMass[i] = network.GetTank(i).Mass);
+
+            const double simdt = pow(10.0, -3 + rng.NextDouble() * 9);   // 1 ms to 10^6 seconds
+            network.Solve(simdt);
+
+            double after = 0, delivered = 0, totalCapacity = 0;
+            for (int i = 0; i < tankCount; i++)
+            {
+                const XR1ResupplyNetwork::Tank &tank = network.GetTank(i);
+                after += tank.Mass;
+                totalCapacity += tank.Capacity;
+                if ((tank.Mass > max(tank.Capacity, prevMass[i])) || (tank.Mass < prevMass[i]))
+                {
+                    char temp[160];
+                    sprintf(temp, "trial %d: tank %d went from %.6f to %.6f kg with capacity %.6f kg", trial, i, prevMass[i], tank.Mass, tank.Capacity);
+                    Fail(temp);
+                }
+            }
+            for (int i = 0; i < lineCount; i++)
+                delivered += network.GetLineFlow(i);
+
+            const double massError = fabs((after - before) - delivered) / max(1.0, totalCapacity);
+            worstMassError = max(worstMassError, massError);
+            if (massError > 1e-6)   // rounding
+            {
+                char temp[160];
+                sprintf(temp, "trial %d: lines delivered %.6f kg but the tanks gained %.6f kg", trial, delivered, after - before);
+                Fail(temp);
+            }
+        }
+    }
+
+    printf("%d random networks x 5 timesteps: largest mass imbalance %.3g of total capacity\n", trialCount, worstMassError);
+
+    if (s_failures > 0)
+    {
+        printf("%d checks failed\n", s_failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,609 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// ScenarioRoundTrip.cpp
+// Save -> reload round trip for the XR scenario lines written through
+// XRScenarioWriter.
+//
+// The vessel class itself needs the Orbiter SDK, so ScenarioVessel
+// below carries the members that WriteXRCommonScenarioLines saves,
+// under the same names and types.  Lines are reloaded through the
+// production parsers in XRCommonScenarioFields.h, the same templates
+// that DeltaGliderXR1::ParseXRCommonScenarioLine calls; ScenarioVessel
+// only supplies the vessel methods they call.  Its Write method makes
+// the same writer calls as WriteXRCommonScenarioLines; keep it in sync
+// when that changes.
+//
+// For each of --states random vessel states, the lines are written
+// through XRScenarioWriter::Flush into a captured "file", read back one
+// line at a time the way clbkLoadStateEx does, and every field is
+// compared with the original.  Doubles must come back bit-identical;
+// door positions and the payload delta-V must match their fixed-point
+// text.  The APU fuel and LOX quantities are saved as fractions of tank
+// capacity and scaled back on reload, so they may differ from the saved
+// quantity by one ulp.
+//
+// Exit code is 0 if every state round-tripped, 1 otherwise.
+// ==============================================================
+
+#include "XRScenarioWriter.h"
+#include "XRCommonScenarioFields.h"
+#include "XRRandom.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// scenario file contents captured from oapiWriteLine
+static string s_scenarioFile;
+
+void oapiWriteLine(FILEHANDLE file, char *line)
+{
+    s_scenarioFile += line;
+    s_scenarioFile += '\n';
+}
+
+// globals that the shared parser reads; the XR1's values
+double APU_FUEL_CAPACITY = 200.0;
+const double NEUTRAL_CENTER_OF_LIFT = 0.0;
+const int MAX_PASSENGERS = 18;      // the XR5's, the largest of the vessels
+
+static const int DAMAGE_ITEM_COUNT = 25;    // the XR5's D_END + 1, the largest of the vessels
+static const int DOOR_COUNT = 14;
+
+// stand-in for the XR1ConfigFileParser settings the parser reads
+struct ScenarioConfig
+{
+    double GetMaxLoxMass() const { return 1381.4; }     // the XR1's default LOX loadout at realistic consumption
+};
+
+//-------------------------------------------------------------------------
+// Scenario state of one vessel; member names match DeltaGliderXR1
+//-------------------------------------------------------------------------
+class ScenarioVessel
+{
+public:
+    ScenarioVessel();
+    ScenarioVessel(const ScenarioVessel &) = delete;    // the door table points into this object
+    void Randomize(XRRandom &rng);
+    void Write(XRScenarioWriter &w);
+    bool Parse(char *line);
+    int Compare(const ScenarioVessel &saved) const;   // returns the number of mismatched fields
+    void ClearStrings() { *m_crashMessage = *m_grappleTargetVesselName = 0; }
+
+protected:
+    template <class TVessel> friend bool ParseXRCommonScenarioFields(TVessel &vessel, char *line);
+
+    // stand-ins for the vessel methods that the shared parser calls
+    template<class T> static bool Validate(T &val, const T minVal, const T maxVal)
+    {
+        if (val < minVal) { val = minVal; return false; }
+        if (val > maxVal) { val = maxVal; return false; }
+        return true;
+    }
+    template<class T> static bool ValidateFraction(T &frac) { return Validate(frac, static_cast<T>(0.0), static_cast<T>(1.0)); }
+    static void EncodeSpaces(char *pStr) { for (char *p = pStr; *p; p++) if (*p == ' ') *p = '$'; }
+    static void DecodeSpaces(char *pStr) { for (char *p = pStr; *p; p++) if (*p == '$') *p = ' '; }
+    const ScenarioConfig *GetXR1Config() const { return &m_config; }
+    void SetADCtrlMode(const int mode) { m_adCtrlMode = mode; }
+    void SetCustomAutopilotMode(const AUTOPILOT ap, const bool playSound, const bool force = false) { m_customAutopilotMode = ap; }
+    void SetThrusterDir(VECTOR3 &th, const VECTOR3 &dir) { th = dir; }     // the thruster handles are their directions here
+    void SetControlSurfaceLevel(const AIRCTRL_TYPE type, const double level) { if (type == AIRCTRL_ELEVATORTRIM) m_trim = level; }
+    void SetNavlight(const bool on) { m_lights[0] = on; }
+    void SetBeacon(const bool on) { m_lights[1] = on; }
+    void SetStrobe(const bool on) { m_lights[2] = on; }
+    void SetDamageStatus(const DamageItem item, const double fracIntegrity)
+    {
+        const int i = static_cast<int>(item);
+        if ((i >= 0) && (i < DAMAGE_ITEM_COUNT))
+            m_damage[i] = fracIntegrity;
+    }
+
+    // same layout as DeltaGliderXR1::XRDoorTable for the columns the scenario parser uses
+    struct XRDoorTable
+    {
+        int count;
+        DoorStatus *pStatus[DOOR_COUNT];
+        double *pProc[DOOR_COUNT];
+        const char *pScenarioName[DOOR_COUNT];
+    };
+    XRDoorTable m_doorTable;
+    ScenarioConfig m_config;
+
+    int m_secondaryHUDMode, m_lastSecondaryHUDMode, m_adCtrlMode;
+    double m_preStepPreviousAirspeed, m_airborneTargetTime, m_takeoffTime, m_touchdownTime, m_preStepPreviousVerticalSpeed;
+    double m_apuFuelQty, m_loxQty, m_cabinO2Level;
+    int m_crewState;
+    bool m_internalSystemsFailure;
+    XRRandom m_random;
+    bool m_cogShiftAutoModeActive, m_cogShiftCenterModeActive, m_cogForceRecenter;
+    bool m_MWSActive;
+    double m_coolantTemp;
+    double m_damage[DAMAGE_ITEM_COUNT];
+    bool m_isCrashed;
+    char m_crashMessage[120];
+    double m_metMJDStartingTime, m_interval1ElapsedTime, m_interval2ElapsedTime;
+    bool m_metTimerRunning, m_interval1TimerRunning, m_interval2TimerRunning;
+    int m_activeMultiDisplayMode, m_activeTempScale;
+    AUTOPILOT m_customAutopilotMode;
+    bool m_airspeedHoldEngaged;
+    VECTOR3 th_scram[2], th_main[2];
+    double m_hoverBalance;
+    bool m_mainPitchCenteringMode, m_mainYawCenteringMode, m_mainDivMode, m_mainAutoMode, m_hoverCenteringMode, m_scramCenteringMode;
+    double m_setPitchOrAOA, m_setBank;
+    bool m_initialAHBankCompleted, m_holdAOA;
+    double m_centerOfLift;
+    double m_setDescentRate, m_latchedAutoTouchdownMinDescentRate;
+    bool m_autoLand;
+    double m_setAirspeed;
+    bool m_crewHatchInterlocksDisabled, m_airlockInterlocksDisabled;
+    bool m_tertiaryHUDOn;
+    int m_crewDisplayIndex;
+    DoorStatus m_doorStatus[DOOR_COUNT];
+    double m_doorProc[DOOR_COUNT];
+    DoorStatus apu_status, externalcooling_status;
+    double m_trim;          // Orbiter's elevator trim level
+    bool m_lights[3];       // Orbiter's nav light, beacon, and strobe states
+    bool m_parkingBrakesEngaged;
+    double m_deployDeltaV;
+    int m_grappleRangeIndex, m_selectedSlotLevel, m_selectedSlot;
+    char m_grappleTargetVesselName[64];
+};
+
+static const char *const s_doorNames[DOOR_COUNT] =
+{
+    "NOSECONE", "SCRAM_DOORS", "HOVER_DOORS", "LADDER", "GEAR", "RETRO_DOORS", "OUTER_AIRLOCK", "INNER_AIRLOCK",
+    "CHAMBER", "HATCH", "RADIATOR", "AIRBRAKE", "ELEVATOR", "BAY_DOORS"
+};
+
+static const char *const s_damageLabels[] = { "Left Wing", "Right Wing", "Left Aileron", "Right Aileron", "Left Main Engine" };
+
+ScenarioVessel::ScenarioVessel()
+{
+    m_doorTable.count = DOOR_COUNT;
+    for (int i = 0; i < DOOR_COUNT; i++)
+    {
+        m_doorTable.pStatus[i] = &m_doorStatus[i];
+        m_doorTable.pProc[i] = &m_doorProc[i];
+        m_doorTable.pScenarioName[i] = s_doorNames[i];
+    }
+}
+
+//-------------------------------------------------------------------------
+// Random state generation
+//-------------------------------------------------------------------------
+
+// any finite double: a mix of ordinary magnitudes, tiny and huge values, and raw bit patterns
+static double AnyDouble(XRRandom &rng)
+{
+    const uint64_t kind = rng.NextUInt64() % 4;
+    const double sign = ((rng.NextUInt64() & 1) ? -1.0 : 1.0);
+    switch (kind)
+    {
+    case 0: return sign * rng.NextDouble() * 1e4;
+    case 1: return sign * ldexp(rng.NextDouble(), static_cast<int>(rng.NextUInt64() % 2000) - 1000);
+    case 2: return sign * static_cast<double>(rng.NextUInt64() % 100000) / 1000;    // short decimals, e.g., 12.345
+    default:
+        for (;;)
+        {
+            uint64_t bits = rng.NextUInt64();
+            double d;
+            memcpy(&d, &bits, sizeof(d));
+            if (isfinite(d))
+                return d;
+        }
+    }
+}
+
+static double Fraction(XRRandom &rng) { return ((rng.NextUInt64() % 8) == 0) ? static_cast<double>(rng.NextUInt64() % 2) : rng.NextDouble(); }
+static bool AnyBool(XRRandom &rng) { return (rng.NextUInt64() & 1) != 0; }
+static int AnyInt(XRRandom &rng, const int maxValue) { return static_cast<int>(rng.NextUInt64() % (maxValue + 1)); }
+static VECTOR3 AnyVector(XRRandom &rng) { return { AnyDouble(rng), AnyDouble(rng), AnyDouble(rng) }; }
+static DoorStatus AnyDoorStatus(XRRandom &rng) { return static_cast<DoorStatus>(AnyInt(rng, 4) - 1); }    // DOOR_FAILED through DOOR_OPENING
+
+void ScenarioVessel::Randomize(XRRandom &rng)
+{
+    m_secondaryHUDMode = AnyInt(rng, 5);
+    m_lastSecondaryHUDMode = AnyInt(rng, 5);
+    m_adCtrlMode = AnyInt(rng, 7);
+    m_preStepPreviousAirspeed = AnyDouble(rng);
+    m_airborneTargetTime = AnyDouble(rng);
+    m_takeoffTime = AnyDouble(rng);
+    m_touchdownTime = AnyDouble(rng);
+    m_preStepPreviousVerticalSpeed = AnyDouble(rng);
+    m_apuFuelQty = Fraction(rng) * APU_FUEL_CAPACITY;
+    m_loxQty = Fraction(rng) * GetXR1Config()->GetMaxLoxMass();
+    m_cabinO2Level = Fraction(rng);
+    m_crewState = AnyInt(rng, 2);
+    m_internalSystemsFailure = AnyBool(rng);
+    m_random.SetState(rng.NextUInt64(), rng.NextUInt64());
+    m_cogShiftAutoModeActive = AnyBool(rng);
+    m_cogShiftCenterModeActive = AnyBool(rng);
+    m_cogForceRecenter = AnyBool(rng);
+    m_MWSActive = AnyBool(rng);
+    m_coolantTemp = AnyDouble(rng);
+    for (int i = 0; i < DAMAGE_ITEM_COUNT; i++)
+        m_damage[i] = Fraction(rng);
+    m_isCrashed = AnyBool(rng);
+    snprintf(m_crashMessage, sizeof(m_crashMessage), "%s", (AnyBool(rng) ? "" : "Vessel crashed: hull temperature limit exceeded!"));
+    m_metMJDStartingTime = AnyDouble(rng);
+    m_interval1ElapsedTime = AnyDouble(rng);
+    m_interval2ElapsedTime = AnyDouble(rng);
+    m_metTimerRunning = AnyBool(rng);
+    m_interval1TimerRunning = AnyBool(rng);
+    m_interval2TimerRunning = AnyBool(rng);
+    m_activeMultiDisplayMode = AnyInt(rng, 12);
+    m_activeTempScale = AnyInt(rng, 2);
+    m_customAutopilotMode = static_cast<AUTOPILOT>(AnyInt(rng, static_cast<int>(AUTOPILOT::AP_DESCENTHOLD) + 1) - 1);    // AP_NOTSET through AP_DESCENTHOLD
+    m_airspeedHoldEngaged = AnyBool(rng);
+    th_scram[0] = AnyVector(rng);
+    th_scram[1] = AnyVector(rng);
+    th_main[0] = AnyVector(rng);
+    th_main[1] = AnyVector(rng);
+    m_hoverBalance = AnyDouble(rng);
+    m_mainPitchCenteringMode = AnyBool(rng);
+    m_mainYawCenteringMode = AnyBool(rng);
+    m_mainDivMode = AnyBool(rng);
+    m_mainAutoMode = AnyBool(rng);
+    m_hoverCenteringMode = AnyBool(rng);
+    m_scramCenteringMode = AnyBool(rng);
+    m_setPitchOrAOA = AnyDouble(rng);
+    m_setBank = AnyDouble(rng);
+    m_initialAHBankCompleted = AnyBool(rng);
+    m_holdAOA = AnyBool(rng);
+    m_centerOfLift = AnyDouble(rng);
+    m_setDescentRate = AnyDouble(rng);
+    m_latchedAutoTouchdownMinDescentRate = AnyDouble(rng);
+    m_autoLand = AnyBool(rng);
+    m_setAirspeed = AnyDouble(rng);
+    m_crewHatchInterlocksDisabled = AnyBool(rng);
+    m_airlockInterlocksDisabled = AnyBool(rng);
+    m_tertiaryHUDOn = AnyBool(rng);
+    m_crewDisplayIndex = AnyInt(rng, 18);
+    for (int i = 0; i < DOOR_COUNT; i++)
+    {
+        m_doorStatus[i] = AnyDoorStatus(rng);
+        m_doorProc[i] = Fraction(rng);
+    }
+    apu_status = AnyDoorStatus(rng);
+    externalcooling_status = AnyDoorStatus(rng);
+    m_trim = rng.NextDouble() * 2 - 1;
+    for (bool &light : m_lights)
+        light = AnyBool(rng);
+    m_parkingBrakesEngaged = AnyBool(rng);
+    m_deployDeltaV = rng.NextDouble() * 10;
+    m_grappleRangeIndex = AnyInt(rng, 6);
+    m_selectedSlotLevel = AnyInt(rng, 3);
+    m_selectedSlot = AnyInt(rng, 36);
+    snprintf(m_grappleTargetVesselName, sizeof(m_grappleTargetVesselName), "%s", (AnyBool(rng) ? "" : "XR5-01-Payload"));
+}
+
+//-------------------------------------------------------------------------
+// Save: same writer calls as WriteXRCommonScenarioLines
+//-------------------------------------------------------------------------
+void ScenarioVessel::Write(XRScenarioWriter &w)
+{
+    w.WriteInt("SECONDARY_HUD", m_secondaryHUDMode);
+    w.WriteInt("LAST_ACTIVE_SECONDARY_HUD", m_lastSecondaryHUDMode);
+    w.WriteInt("ADCTRL_MODE", m_adCtrlMode);
+
+    w.BeginLine("TAKEOFF_LANDING_CALLOUTS");
+    w.AppendDouble(m_preStepPreviousAirspeed);
+    w.AppendDouble(m_airborneTargetTime);
+    w.AppendDouble(m_takeoffTime);
+    w.AppendDouble(m_touchdownTime);
+    w.AppendDouble(m_preStepPreviousVerticalSpeed);
+    w.EndLine();
+
+    w.WriteDouble("APU_FUEL_QTY", (m_apuFuelQty / APU_FUEL_CAPACITY));
+    w.WriteDouble("LOX_QTY", (m_loxQty / GetXR1Config()->GetMaxLoxMass()));
+    w.WriteDouble("CABIN_O2_LEVEL", m_cabinO2Level);
+    w.WriteInt("CREW_STATE", m_crewState);
+    w.WriteInt("INTERNAL_SYSTEMS_FAILURE", m_internalSystemsFailure);
+
+    w.BeginLine("RNG_STATE");
+    w.AppendUInt64(m_random.GetSeed());
+    w.AppendUInt64(m_random.GetCounter());
+    w.EndLine();
+
+    w.BeginLine("COGSHIFT_MODES");
+    w.AppendInt(m_cogShiftAutoModeActive);
+    w.AppendInt(m_cogShiftCenterModeActive);
+    w.AppendInt(m_cogForceRecenter);
+    w.EndLine();
+
+    w.WriteInt("MWS_ACTIVE", m_MWSActive);
+    w.WriteDouble("COOLANT_TEMP", m_coolantTemp);
+
+    for (int i = 0; i < DAMAGE_ITEM_COUNT; i++)
+    {
+        w.BeginLine("DMG_", i);
+        w.AppendDouble(m_damage[i]);
+        w.AppendString(s_damageLabels[i % (sizeof(s_damageLabels) / sizeof(s_damageLabels[0]))]);
+        w.EndLine();
+    }
+
+    w.WriteInt("IS_CRASHED", m_isCrashed);
+    if (*m_crashMessage)
+    {
+        EncodeSpaces(m_crashMessage);
+        w.WriteString("CRASH_MSG", m_crashMessage);
+        DecodeSpaces(m_crashMessage);
+    }
+
+    w.WriteDouble("MET_STARTING_MJD", m_metMJDStartingTime);
+    w.WriteDouble("INTERVAL1_ELAPSED_TIME", m_interval1ElapsedTime);
+    w.WriteDouble("INTERVAL2_ELAPSED_TIME", m_interval2ElapsedTime);
+    w.WriteInt("MET_RUNNING", m_metTimerRunning);
+    w.WriteInt("INTERVAL1_RUNNING", m_interval1TimerRunning);
+    w.WriteInt("INTERVAL2_RUNNING", m_interval2TimerRunning);
+
+    w.WriteInt("ACTIVE_MDM", m_activeMultiDisplayMode);
+    w.WriteInt("TEMP_SCALE", m_activeTempScale);
+    w.WriteInt("CUSTOM_AUTOPILOT_MODE", static_cast<int>(m_customAutopilotMode));
+    w.WriteInt("AIRSPEED_HOLD_ENGAGED", m_airspeedHoldEngaged);
+
+    const char *const dirNames[] = { "SCRAM0DIR", "SCRAM1DIR", "MAIN0DIR", "MAIN1DIR" };
+    const VECTOR3 *const dirs[] = { &th_scram[0], &th_scram[1], &th_main[0], &th_main[1] };
+    for (int i = 0; i < 4; i++)
+    {
+        w.BeginLine(dirNames[i]);
+        w.AppendDouble(dirs[i]->x);
+        w.AppendDouble(dirs[i]->y);
+        w.AppendDouble(dirs[i]->z);
+        w.EndLine();
+        if (i == 1)
+            w.WriteDouble("HOVER_BALANCE", m_hoverBalance);
+    }
+
+    w.BeginLine("GIMBAL_BUTTON_STATES");
+    w.AppendInt(m_mainPitchCenteringMode);
+    w.AppendInt(m_mainYawCenteringMode);
+    w.AppendInt(m_mainDivMode);
+    w.AppendInt(m_mainAutoMode);
+    w.AppendInt(m_hoverCenteringMode);
+    w.AppendInt(m_scramCenteringMode);
+    w.EndLine();
+
+    w.BeginLine("ATTITUDE_HOLD_DATA");
+    w.AppendDouble(m_setPitchOrAOA);
+    w.AppendDouble(m_setBank);
+    w.AppendInt(m_initialAHBankCompleted);
+    w.AppendInt(m_holdAOA);
+    w.AppendDouble(m_centerOfLift);
+    w.EndLine();
+
+    w.BeginLine("DESCENT_HOLD_DATA");
+    w.AppendDouble(m_setDescentRate);
+    w.AppendDouble(m_latchedAutoTouchdownMinDescentRate);
+    w.AppendInt(m_autoLand);
+    w.EndLine();
+
+    w.WriteDouble("AIRSPEED_HOLD_DATA", m_setAirspeed);
+
+    w.BeginLine("OVERRIDE_INTERLOCKS");
+    w.AppendInt(m_crewHatchInterlocksDisabled);
+    w.AppendInt(m_airlockInterlocksDisabled);
+    w.EndLine();
+
+    w.WriteInt("TERTIARY_HUD_ON", m_tertiaryHUDOn);
+    w.WriteInt("CREW_DISPLAY_INDEX", m_crewDisplayIndex);
+
+    // WriteDoorScenarioLines
+    for (int i = 0; i < m_doorTable.count; i++)
+    {
+        w.BeginLine(m_doorTable.pScenarioName[i]);
+        w.AppendInt(static_cast<int>(*m_doorTable.pStatus[i]));
+        w.AppendFixed(*m_doorTable.pProc[i], 4);
+        w.EndLine();
+    }
+
+    w.WriteInt("APU_STATUS", static_cast<int>(apu_status));
+    w.WriteInt("EXTCOOLING_STATUS", static_cast<int>(externalcooling_status));
+    w.WriteDouble("TRIM", m_trim);
+
+    w.BeginLine("LIGHTS");
+    w.AppendInt(m_lights[0]);
+    w.AppendInt(m_lights[1]);
+    w.AppendInt(m_lights[2]);
+    w.EndLine();
+
+    w.WriteInt("PARKING_BRAKES", m_parkingBrakesEngaged);
+
+    w.BeginLine("PAYLOAD_SCREENS_DATA");
+    w.AppendFixed(m_deployDeltaV, 1);
+    w.AppendInt(m_grappleRangeIndex);
+    w.AppendInt(m_selectedSlotLevel);
+    w.AppendInt(m_selectedSlot);
+    w.EndLine();
+
+    if (*m_grappleTargetVesselName != 0)
+        w.WriteString("GRAPPLE_TARGET", m_grappleTargetVesselName);
+
+    w.Flush(nullptr);
+}
+
+//-------------------------------------------------------------------------
+// Reload: the production parsers, in the order ParseXRCommonScenarioLine calls them
+//-------------------------------------------------------------------------
+bool ScenarioVessel::Parse(char *line)
+{
+    return (ParseXRDoorScenarioLine(m_doorTable, line) || ParseXRCommonScenarioFields(*this, line));
+}
+
+//-------------------------------------------------------------------------
+// Comparison
+//-------------------------------------------------------------------------
+
+static int s_mismatches = 0;
+
+static void Mismatch(const char *pField, const string &saved, const string &loaded)
+{
+    if (s_mismatches++ < 20)
+        printf("FAIL: %s: saved %s, reloaded %s\n", pField, saved.c_str(), loaded.c_str());
+}
+
+static string ToText(const double d) { char buf[40]; snprintf(buf, sizeof(buf), "%.17g", d); return buf; }
+static string ToText(const int i) { return to_string(i); }
+static string ToText(const uint64_t i) { return to_string(i); }
+static string ToText(const string &s) { return '"' + s + '"'; }
+
+template<class T> static int Same(const char *pField, const T &saved, const T &loaded)
+{
+    if (saved == loaded)
+        return 0;
+    Mismatch(pField, ToText(saved), ToText(loaded));
+    return 1;
+}
+
+// doubles must be bit-identical (this also distinguishes -0.0 from 0.0)
+static int SameBits(const char *pField, const double saved, const double loaded)
+{
+    if (memcmp(&saved, &loaded, sizeof(double)) == 0)
+        return 0;
+    Mismatch(pField, ToText(saved), ToText(loaded));
+    return 1;
+}
+
+// quantities saved as a fraction of capacity and scaled back must be within one ulp
+static int SameScaled(const char *pField, const double saved, const double loaded)
+{
+    if ((saved == loaded) || (nextafter(saved, loaded) == loaded))
+        return 0;
+    Mismatch(pField, ToText(saved), ToText(loaded));
+    return 1;
+}
+
+// fixed-point values must read back as the value their text represents
+static int SameFixed(const char *pField, const double saved, const double loaded, const int decimals)
+{
+    char buf[352];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, saved);
+    return SameBits(pField, strtod(buf, nullptr), loaded);
+}
+
+#define SAME(field)         Same(#field, saved.field, field)
+#define SAME_BOOL(field)    Same(#field, static_cast<int>(saved.field), static_cast<int>(field))
+#define SAME_BITS(field)    SameBits(#field, saved.field, field)
+
+int ScenarioVessel::Compare(const ScenarioVessel &saved) const
+{
+    int n = 0;
+    n += SAME(m_secondaryHUDMode) + SAME(m_lastSecondaryHUDMode) + SAME(m_adCtrlMode);
+    n += SAME_BITS(m_preStepPreviousAirspeed) + SAME_BITS(m_airborneTargetTime) + SAME_BITS(m_takeoffTime) + SAME_BITS(m_touchdownTime) + SAME_BITS(m_preStepPreviousVerticalSpeed);
+    n += SameScaled("m_apuFuelQty", saved.m_apuFuelQty, m_apuFuelQty) + SameScaled("m_loxQty", saved.m_loxQty, m_loxQty) + SAME_BITS(m_cabinO2Level);
+    n += SAME(m_crewState) + SAME_BOOL(m_internalSystemsFailure);
+    n += Same("m_random.seed", saved.m_random.GetSeed(), m_random.GetSeed()) + Same("m_random.counter", saved.m_random.GetCounter(), m_random.GetCounter());
+    n += SAME_BOOL(m_cogShiftAutoModeActive) + SAME_BOOL(m_cogShiftCenterModeActive) + SAME_BOOL(m_cogForceRecenter);
+    n += SAME_BOOL(m_MWSActive) + SAME_BITS(m_coolantTemp);
+    for (int i = 0; i < DAMAGE_ITEM_COUNT; i++)
+        n += SAME_BITS(m_damage[i]);
+    n += SAME_BOOL(m_isCrashed) + Same("m_crashMessage", string(saved.m_crashMessage), string(m_crashMessage));
+    n += SAME_BITS(m_metMJDStartingTime) + SAME_BITS(m_interval1ElapsedTime) + SAME_BITS(m_interval2ElapsedTime);
+    n += SAME_BOOL(m_metTimerRunning) + SAME_BOOL(m_interval1TimerRunning) + SAME_BOOL(m_interval2TimerRunning);
+    n += SAME(m_activeMultiDisplayMode) + SAME(m_activeTempScale) + SAME_BOOL(m_customAutopilotMode) + SAME_BOOL(m_airspeedHoldEngaged);
+    for (int i = 0; i < 2; i++)
+    {
+        n += SAME_BITS(th_scram[i].x) + SAME_BITS(th_scram[i].y) + SAME_BITS(th_scram[i].z);
+        n += SAME_BITS(th_main[i].x) + SAME_BITS(th_main[i].y) + SAME_BITS(th_main[i].z);
+    }
+    n += SAME_BITS(m_hoverBalance);
+    n += SAME_BOOL(m_mainPitchCenteringMode) + SAME_BOOL(m_mainYawCenteringMode) + SAME_BOOL(m_mainDivMode) + SAME_BOOL(m_mainAutoMode) + SAME_BOOL(m_hoverCenteringMode) + SAME_BOOL(m_scramCenteringMode);
+    n += SAME_BITS(m_setPitchOrAOA) + SAME_BITS(m_setBank) + SAME_BOOL(m_initialAHBankCompleted) + SAME_BOOL(m_holdAOA) + SAME_BITS(m_centerOfLift);
+    n += SAME_BITS(m_setDescentRate) + SAME_BITS(m_latchedAutoTouchdownMinDescentRate) + SAME_BOOL(m_autoLand);
+    n += SAME_BITS(m_setAirspeed);
+    n += SAME_BOOL(m_crewHatchInterlocksDisabled) + SAME_BOOL(m_airlockInterlocksDisabled) + SAME_BOOL(m_tertiaryHUDOn) + SAME(m_crewDisplayIndex);
+    for (int i = 0; i < DOOR_COUNT; i++)
+        n += SAME_BOOL(m_doorStatus[i]) + SameFixed(s_doorNames[i], saved.m_doorProc[i], m_doorProc[i], 4);
+    n += SAME_BOOL(apu_status) + SAME_BOOL(externalcooling_status);
+    n += SAME_BITS(m_trim);
+    n += SAME_BOOL(m_lights[0]) + SAME_BOOL(m_lights[1]) + SAME_BOOL(m_lights[2]) + SAME_BOOL(m_parkingBrakesEngaged);
+    n += SameFixed("m_deployDeltaV", saved.m_deployDeltaV, m_deployDeltaV, 1);
+    n += SAME(m_grappleRangeIndex) + SAME(m_selectedSlotLevel) + SAME(m_selectedSlot);
+    n += Same("m_grappleTargetVesselName", string(saved.m_grappleTargetVesselName), string(m_grappleTargetVesselName));
+    return n;
+}
+
+//-------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int stateCount = 10000;
+    if ((argc == 3) && (strcmp(argv[1], "--states") == 0))
+        stateCount = atoi(argv[2]);
+    else if (argc != 1)
+    {
+        puts("usage: scenarioroundtrip [--states n]\n"
+             "  --states n   number of random vessel states to save and reload (default 10000)");
+        return 1;
+    }
+
+    XRRandom rng(0x5C3A2105);
+    XRScenarioWriter writer;
+    int failedStates = 0;
+    int unparsedLines = 0;
+    for (int state = 0; state < stateCount; state++)
+    {
+        ScenarioVessel saved;
+        saved.Randomize(rng);
+        s_scenarioFile.clear();
+        saved.Write(writer);
+
+        // Reload into a vessel that starts from unrelated values, so that a field the parser skips cannot match by accident.
+        // The strings are only saved when they are not empty, so those start out empty as they do in a new vessel.
+        // Orbiter hands clbkLoadStateEx each line without its leading whitespace.
+        ScenarioVessel loaded;
+        loaded.Randomize(rng);
+        loaded.ClearStrings();
+        vector<char> line;
+        for (size_t pos = 0; pos < s_scenarioFile.size(); )
+        {
+            const size_t end = s_scenarioFile.find('\n', pos);
+            size_t start = pos;
+            while (s_scenarioFile[start] == ' ')
+                start++;
+            line.assign(s_scenarioFile.begin() + start, s_scenarioFile.begin() + end);
+            line.push_back(0);
+            if (!loaded.Parse(line.data()))
+            {
+                if (unparsedLines++ < 20)
+                    printf("FAIL: line not recognized: %s\n", line.data());
+            }
+            pos = end + 1;
+        }
+
+        if (loaded.Compare(saved) > 0)
+            failedStates++;
+    }
+
+    printf("%d random vessel states saved and reloaded: %d differed, %d lines not recognized\n", stateCount, failedStates, unparsedLines);
+    if ((failedStates > 0) || (unparsedLines > 0))
+        return 1;
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,425 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// ScriptEngineBench.cpp
+// Compile and execution benchmark for the XRVC script engine
+// (XRVCScriptEngine.h), run against a stub vessel.
+//
+// Generates a script of --lines commands covering every command
+// group, compiles it from a file, and then runs it the way
+// StartupScriptPreStep does: a fixed time budget per frame until the
+// program finishes.  The stub vessel counts every XRVesselCtrl call
+// and keeps the state it was given, so the run can be checked against
+// what the generator wrote.  Also checks that a line of exactly
+// MAX_LINE_LENGTH-1 characters is accepted and a longer one is
+// rejected with a "Line too long" error rather than being split.
+//
+// Exit code is 0 if every check passed, 1 otherwise.
+// ==============================================================
+
+#include "XRVCScriptEngine.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+struct Options
+{
+    int LineCount = 100000;
+    double FrameBudget = 0.5e-3;    // seconds per frame; matches StartupScriptPreStep
+};
+
+static void Usage()
+{
+    puts("usage: scriptenginebench [--lines n] [--budget seconds]\n"
+         "  --lines n         number of script lines to generate (default 100000)\n"
+         "  --budget seconds  execution time budget per frame (default 0.0005)");
+}
+
+static bool ParseOptions(const int argc, char *argv[], Options &opt)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pArg = argv[i];
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(pArg, "--lines") == 0) && pVal)         { opt.LineCount = atoi(pVal); i++; }
+        else if ((strcmp(pArg, "--budget") == 0) && pVal)   { opt.FrameBudget = atof(pVal); i++; }
+        else
+        {
+            Usage();
+            return false;
+        }
+    }
+    return ((opt.LineCount > 0) && (opt.FrameBudget > 0));
+}
+
+//-------------------------------------------------------------------------
+// Stub vessel: stores whatever it is given and counts each call.
+// The payload bay doors are not supported, so every command that targets
+// them must be counted as rejected by the engine.
+//-------------------------------------------------------------------------
+class StubVessel : public XRVesselCtrl
+{
+public:
+    StubVessel() : XRVesselCtrl(nullptr, 1) { }
+
+    int SetCalls = 0;           // Set* / Shift / Reset calls
+    mutable int GetCalls = 0;   // Get* calls made by read-modify-write commands
+
+    XREngineStateRead Engines[static_cast<int>(XREngineID::XRE_RetroRight) + 1] = { };
+    XRDoorState DockingPort = XRDoorState::XRDS_Closed;
+    bool NavLight = false;
+    bool KillRot = false;
+    XRAttitudeHoldState AttitudeHold = { };
+    XRDescentHoldState DescentHold = { };
+    XRAirspeedHoldState AirspeedHold = { };
+    XRSystemStatusRead Status = { };
+    int SecondaryHUDMode = 0;
+    double CenterOfGravity = 0;
+    int KillAutopilotsCount = 0;
+
+    virtual bool SetEngineState(XREngineID id, const XREngineStateWrite &state) { SetCalls++; static_cast<XREngineStateWrite &>(Engines[static_cast<int>(id)]) = state; return true; }
+    virtual bool GetEngineState(XREngineID id, XREngineStateRead &state) const { GetCalls++; state = Engines[static_cast<int>(id)]; return true; }
+    virtual bool SetDoorState(XRDoorID id, XRDoorState state)
+    {
+        SetCalls++;
+        if (id != XRDoorID::XRD_DockingPort)
+            return false;
+        DockingPort = state;
+        return true;
+    }
+    virtual XRDoorState GetDoorState(XRDoorID id, double *pProc = nullptr) const { return (id == XRDoorID::XRD_DockingPort) ? DockingPort : XRDoorState::XRDS_DoorNotSupported; }
+    virtual bool SetXRSystemStatus(const XRSystemStatusWrite &status) { SetCalls++; static_cast<XRSystemStatusWrite &>(Status) = status; return true; }
+    virtual void GetXRSystemStatus(XRSystemStatusRead &status) const { GetCalls++; status = Status; }
+    virtual bool ClearAllXRDamage() { SetCalls++; return true; }
+    virtual void KillAutopilots() { SetCalls++; KillAutopilotsCount++; }
+    virtual XRAutopilotState SetStandardAP(XRStdAutopilot id, bool on) { SetCalls++; KillRot = on; return on ? XRAutopilotState::XRAPSTATE_Engaged : XRAutopilotState::XRAPSTATE_Disengaged; }
+    virtual XRAutopilotState GetStandardAP(XRStdAutopilot id) { return KillRot ? XRAutopilotState::XRAPSTATE_Engaged : XRAutopilotState::XRAPSTATE_Disengaged; }
+    virtual XRAutopilotState SetAttitudeHoldAP(const XRAttitudeHoldState &state) { SetCalls++; AttitudeHold = state; return XRAutopilotState::XRAPSTATE_Engaged; }
+    virtual XRAutopilotState GetAttitudeHoldAP(XRAttitudeHoldState &state) const { GetCalls++; state = AttitudeHold; return XRAutopilotState::XRAPSTATE_Engaged; }
+    virtual XRAutopilotState SetDescentHoldAP(const XRDescentHoldState &state) { SetCalls++; DescentHold = state; return XRAutopilotState::XRAPSTATE_Engaged; }
+    virtual XRAutopilotState GetDescentHoldAP(XRDescentHoldState &state) const { GetCalls++; state = DescentHold; return XRAutopilotState::XRAPSTATE_Engaged; }
+    virtual XRAutopilotState SetAirspeedHoldAP(const XRAirspeedHoldState &state) { SetCalls++; AirspeedHold = state; return XRAutopilotState::XRAPSTATE_Engaged; }
+    virtual XRAutopilotState GetAirspeedHoldAP(XRAirspeedHoldState &state) const { GetCalls++; state = AirspeedHold; return XRAutopilotState::XRAPSTATE_Engaged; }
+    virtual bool SetExteriorLight(XRLight light, bool state) { SetCalls++; NavLight = state; return true; }
+    virtual bool GetExteriorLight(XRLight light) const { return NavLight; }
+    virtual bool SetSecondaryHUDMode(int modeNumber) { SetCalls++; SecondaryHUDMode = modeNumber; return true; }
+    virtual int GetSecondaryHUDMode() const { return SecondaryHUDMode; }
+    virtual bool SetTertiaryHUDState(bool on) { SetCalls++; return true; }
+    virtual bool GetTertiaryHUDState() const { return false; }
+    virtual bool ResetMasterWarningAlarm() { SetCalls++; return true; }
+    virtual bool ShiftCenterOfGravity(double requestedShift) { SetCalls++; CenterOfGravity += requestedShift; return true; }
+    virtual double GetCenterOfGravity() const { return CenterOfGravity; }
+    virtual bool SetRCSDockingMode(bool on) { SetCalls++; return true; }
+    virtual bool IsRCSDockingMode() const { return false; }
+    virtual bool SetElevatorEVAPortActive(bool on) { SetCalls++; return true; }
+    virtual bool IsElevatorEVAPortActive() const { return false; }
+    virtual int GetStatusScreenText(char *pLinesOut, const int maxLinesToRetrieve) const { return 0; }
+    virtual OMMUManagement *GetMMuObject() { return nullptr; }
+    virtual void WriteTertiaryHudMessage(const char *pMessage, const bool isWarning) { }
+    virtual const char *GetCustomSkinName() const { return nullptr; }
+    virtual int GetPayloadBaySlotCount() const { return 0; }
+    virtual bool IsPayloadBaySlotFree(const int slotNumber) const { return false; }
+    virtual bool GetPayloadSlotData(const int slotNumber, XRPayloadSlotData &slotDataOut) { return false; }
+    virtual bool CanAttachPayload(const OBJHANDLE hPayloadVessel, const int slotNumber) const { return false; }
+    virtual bool GrapplePayloadModuleIntoSlot(const OBJHANDLE hPayloadVessel, const int slotNumber) { return false; }
+    virtual bool DeployPayloadInFlight(const int slotNumber, const double deltaV) { return false; }
+    virtual bool DeployPayloadWhileLanded(const int slotNumber) { return false; }
+    virtual int DeployAllPayloadInFlight(const double deltaV) { return 0; }
+    virtual int DeployAllPayloadWhileLanded() { return 0; }
+    virtual bool SetMWSTest(bool bTestMode) { return false; }
+    virtual bool GetRecenterCOGMode() const { return false; }
+    virtual bool SetRecenterCOGMode(const bool bEnableRecenterMode) { return false; }
+    virtual XRDoorState GetExternalCoolingState() const { return XRDoorState::XRDS_DoorNotSupported; }
+    virtual bool SetExternalCoolingState(const bool bEnabled) { return false; }
+    virtual bool SetCrossFeedMode(XRXFEED_STATE state) { return false; }
+    virtual bool GetXRTelemetrySnapshot(XRTelemetrySnapshot &snapshotOut, const int structSize = sizeof(XRTelemetrySnapshot)) { return false; }
+    virtual bool EnqueueXRCommand(const XRCommand &command) { return false; }
+    virtual int GetQueuedXRCommandCount() { return 0; }
+};
+
+//-------------------------------------------------------------------------
+// Script generation
+//-------------------------------------------------------------------------
+
+// Final state the script leaves the vessel in, plus the calls it must make
+struct Expected
+{
+    int Instructions = 0;
+    int Rejected = 0;
+    int SetCalls = 0;
+    int GetCalls = 0;
+    int KillAutopilotsCount = 0;
+    double MainLeftThrottle = 0, MainRightThrottle = 0;
+    bool MainLeftAutoMode = false;
+    XRDoorState DockingPort = XRDoorState::XRDS_Closed;
+    bool NavLight = false;
+    bool KillRot = false;
+    double TargetPitch = 0, TargetBank = 0;
+    double TargetDescentRate = 0;
+    bool AutoLand = false;
+    double TargetAirspeed = 0;
+    double LeftWing = 0;
+    int SecondaryHUDMode = 0;
+    int CenterOfGravitySteps = 0;     // ShiftCenterOfGravity +0.01 steps
+};
+
+// Returns one script line (without the newline) for line index i and updates the expected state
+static string MakeLine(const int i, Expected &exp)
+{
+    char line[256];
+    const double frac = (i % 1000) / 1000.0;
+    switch (i % 14)
+    {
+    case 0:
+        snprintf(line, sizeof(line), "Set Engine MainBoth ThrottleLevel %.3f", frac);
+        exp.MainLeftThrottle = exp.MainRightThrottle = frac;
+        exp.GetCalls += 2; exp.SetCalls += 2;
+        break;
+    case 1:
+        snprintf(line, sizeof(line), "Set Engine MainLeft AutoMode %s", (i & 1) ? "on" : "off");
+        exp.MainLeftAutoMode = ((i & 1) != 0);
+        exp.GetCalls++; exp.SetCalls++;
+        break;
+    case 2:
+        snprintf(line, sizeof(line), "Set Engine MainRight ThrottleLevel %.3f", 1.0 - frac);
+        exp.MainRightThrottle = 1.0 - frac;
+        exp.GetCalls++; exp.SetCalls++;
+        break;
+    case 3:
+        snprintf(line, sizeof(line), "Set Door DockingPort %s", (i & 1) ? "open" : "closing");
+        exp.DockingPort = ((i & 1) ? XRDoorState::XRDS_Open : XRDoorState::XRDS_Closing);
+        exp.SetCalls++;
+        break;
+    case 4:
+        strcpy(line, "Set Door PayloadBayDoors open");     // not supported by the stub
+        exp.Rejected++;
+        exp.SetCalls++;
+        break;
+    case 5:
+        snprintf(line, sizeof(line), "Set Light Nav %s", (i & 1) ? "on" : "off");
+        exp.NavLight = ((i & 1) != 0);
+        exp.SetCalls++;
+        break;
+    case 6:
+        snprintf(line, sizeof(line), "Set StdAutopilot KillRot %s", (i & 1) ? "on" : "off");
+        exp.KillRot = ((i & 1) != 0);
+        exp.SetCalls++;
+        break;
+    case 7:
+        snprintf(line, sizeof(line), "Set XRAutopilot AttitudeHold on Pitch %.1f %.1f", frac * 80, -frac * 80);
+        exp.TargetPitch = atof(line + strlen("Set XRAutopilot AttitudeHold on Pitch "));
+        exp.TargetBank = -exp.TargetPitch;
+        exp.SetCalls++;
+        break;
+    case 8:
+        snprintf(line, sizeof(line), "Set XRAutopilot DescentHold on %.1f %s", -frac * 100, (i & 1) ? "on" : "off");
+        exp.TargetDescentRate = atof(line + strlen("Set XRAutopilot DescentHold on "));
+        exp.AutoLand = ((i & 1) != 0);
+        exp.SetCalls++;
+        break;
+    case 9:
+        // no parameters: the engine reads the current state first
+        snprintf(line, sizeof(line), "Set XRAutopilot AirspeedHold %s", (i & 1) ? "on" : "off");
+        exp.GetCalls++; exp.SetCalls++;
+        break;
+    case 10:
+        snprintf(line, sizeof(line), "Set XRAutopilot AirspeedHold on %d", i % 2000);
+        exp.TargetAirspeed = i % 2000;
+        exp.SetCalls++;
+        break;
+    case 11:
+        snprintf(line, sizeof(line), "Set DamageState LeftWing %.3f", frac);
+        exp.LeftWing = frac;
+        exp.GetCalls++; exp.SetCalls++;
+        break;
+    case 12:
+        snprintf(line, sizeof(line), "Set Other SecondaryHUDMode %d", i % 6);
+        exp.SecondaryHUDMode = i % 6;
+        exp.SetCalls++;
+        break;
+    default:
+        if ((i % 28) == 13)
+        {
+            strcpy(line, "Reset Autopilots");
+            exp.KillAutopilotsCount++;
+        }
+        else
+        {
+            strcpy(line, "ShiftCenterOfGravity 0.01");
+            exp.CenterOfGravitySteps++;
+        }
+        exp.SetCalls++;
+        break;
+    }
+    exp.Instructions++;
+    return line;
+}
+
+static bool WriteFile(const char *pFilename, const string &text)
+{
+    FILE *pFile = fopen(pFilename, "wt");
+    if (pFile == nullptr)
+        return false;
+    const bool success = (fwrite(text.data(), 1, text.size(), pFile) == text.size());
+    return (fclose(pFile) == 0) && success;
+}
+
+static int s_failures = 0;
+
+static void Check(const bool condition, const char *pDescription)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", pDescription);
+        s_failures++;
+    }
+}
+
+static bool Near(const double a, const double b, const double tolerance = 1e-9)
+{
+    return (a - b < tolerance) && (b - a < tolerance);
+}
+
+// Runs the generated script through the engine and checks the result against exp
+static void RunBenchmark(const Options &opt, const char *pFilename)
+{
+    Expected exp;
+    string text = "# generated by scriptenginebench\n";
+    text.reserve(static_cast<size_t>(opt.LineCount) * 40);
+    for (int i = 0; i < opt.LineCount; i++)
+    {
+        text += MakeLine(i, exp);
+        text += '\n';
+    }
+    if (!WriteFile(pFilename, text))
+    {
+        printf("FAIL: could not write '%s'\n", pFilename);
+        s_failures++;
+        return;
+    }
+
+    XRVCScriptEngine engine;
+    const auto compileStart = Clock::now();
+    const bool compiled = engine.CompileFile(pFilename);
+    const double compileTime = chrono::duration<double>(Clock::now() - compileStart).count();
+    if (!compiled)
+    {
+        printf("FAIL: compile error: %s\n", engine.GetErrorMessage());
+        s_failures++;
+        return;
+    }
+    Check(engine.GetInstructionCount() == exp.Instructions, "instruction count matches the generated script");
+
+    StubVessel vessel;
+    int frames = 0;
+    double longestFrame = 0;
+    const auto runStart = Clock::now();
+    while (!engine.IsFinished())
+    {
+        const auto frameStart = Clock::now();
+        engine.Execute(vessel, opt.FrameBudget);
+        const double frameTime = chrono::duration<double>(Clock::now() - frameStart).count();
+        if (frameTime > longestFrame)
+            longestFrame = frameTime;
+        frames++;
+    }
+    const double runTime = chrono::duration<double>(Clock::now() - runStart).count();
+
+    printf("%d lines: compile %.1f ms (%.0f ns/line); execute %.1f ms (%.0f ns/instruction) over %d frames, longest frame %.3f ms\n",
+        opt.LineCount, compileTime * 1e3, compileTime * 1e9 / opt.LineCount,
+        runTime * 1e3, runTime * 1e9 / opt.LineCount, frames, longestFrame * 1e3);
+
+    Check(engine.GetFailedCount() == exp.Rejected, "rejected command count matches");
+    Check(vessel.SetCalls == exp.SetCalls, "vessel set call count matches");
+    Check(vessel.GetCalls == exp.GetCalls, "vessel get call count matches");
+    Check(vessel.KillAutopilotsCount == exp.KillAutopilotsCount, "KillAutopilots call count matches");
+
+    const XREngineStateRead &mainLeft = vessel.Engines[static_cast<int>(XREngineID::XRE_MainLeft)];
+    const XREngineStateRead &mainRight = vessel.Engines[static_cast<int>(XREngineID::XRE_MainRight)];
+    Check(Near(mainLeft.ThrottleLevel, exp.MainLeftThrottle), "left main throttle");
+    Check(Near(mainRight.ThrottleLevel, exp.MainRightThrottle), "right main throttle");
+    Check(mainLeft.AutoMode == exp.MainLeftAutoMode, "left main auto mode survives throttle writes");
+    Check(vessel.DockingPort == exp.DockingPort, "docking port state");
+    Check(vessel.NavLight == exp.NavLight, "nav light state");
+    Check(vessel.KillRot == exp.KillRot, "killrot state");
+    Check(Near(vessel.AttitudeHold.TargetPitch, exp.TargetPitch) && Near(vessel.AttitudeHold.TargetBank, exp.TargetBank), "attitude hold targets");
+    Check(Near(vessel.DescentHold.TargetDescentRate, exp.TargetDescentRate) && (vessel.DescentHold.AutoLandMode == exp.AutoLand), "descent hold targets");
+    Check(Near(vessel.AirspeedHold.TargetAirspeed, exp.TargetAirspeed), "airspeed hold target");
+    Check(Near(vessel.Status.LeftWing, exp.LeftWing), "left wing integrity");
+    Check(vessel.SecondaryHUDMode == exp.SecondaryHUDMode, "secondary HUD mode");
+    Check(Near(vessel.CenterOfGravity, exp.CenterOfGravitySteps * 0.01, 1e-6), "center of gravity shift");   // accumulated rounding
+}
+
+// Checks that a line of MAX_LINE_LENGTH-1 characters compiles and a longer one is rejected instead of being split
+static void CheckLineLength(const char *pFilename)
+{
+    const int maxChars = XRVCScriptEngine::MAX_LINE_LENGTH - 1;
+    const string command = "Set Light Nav on";
+
+    // longest legal line: the command padded with trailing blanks
+    {
+        const string line = command + string(maxChars - command.size(), ' ');
+        XRVCScriptEngine engine;
+        Check(WriteFile(pFilename, line + "\n" + command + "\n"), "write max-length script");
+        Check(engine.CompileFile(pFilename) && (engine.GetInstructionCount() == 2), "line of MAX_LINE_LENGTH-1 characters is accepted");
+    }
+
+    // one character longer: without the check the overflow would be compiled as its own line
+    {
+        const string line = string(maxChars - command.size() + 1, ' ') + command;
+        XRVCScriptEngine engine;
+        Check(WriteFile(pFilename, line + "\n"), "write over-long script");
+        const bool compiled = engine.CompileFile(pFilename);
+        Check(!compiled && (strstr(engine.GetErrorMessage(), "(1): Line too long") != nullptr), "line of MAX_LINE_LENGTH characters is rejected as too long");
+        Check(engine.GetInstructionCount() == 0, "rejected script leaves the program empty");
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Options opt;
+    if (!ParseOptions(argc, argv, opt))
+        return 1;
+
+    char filename[64];
+    snprintf(filename, sizeof(filename), "/tmp/ScriptEngineBench-%d.xrvc", static_cast<int>(getpid()));
+
+    RunBenchmark(opt, filename);
+    CheckLineLength(filename);
+    remove(filename);
+
+    if (s_failures > 0)
+    {
+        printf("%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,389 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// SoundCacheCheck.cpp
+// Checks the on-demand WAV slot cache (XR1SoundCache.h) against a mock
+// XRSound that counts LoadWav calls.
+//
+// Plays a scripted 30-minute XR1 flight through the cache the same way
+// DeltaGliderXR1 does (LoadXR1Sound followed by PlaySound): queued Mach,
+// altitude, and information callouts, repeating warnings (including
+// one missing WAV file), door hydraulics with two doors moving at
+// once, the APU, and the resupply lines.  Fails if any WAV file is read
+// from disk more often than the number of channels that ever played it
+// at the same time (once for everything but the door and resupply
+// sounds), if a channel ever plays a slot holding a different WAV, or
+// if a slot is reloaded or shared while it is playing.  Then checks
+// that eviction is least-recently-used.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "XR1SoundCache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const char *SOUND_FOLDER = "XRSound/Default";
+static const double FRAME_SECONDS = 0.1;
+static const double FLIGHT_SECONDS = 30 * 60;
+
+// channels, with the same IDs as DeltaGliderXR1::Sound
+enum Channel
+{
+    Warning = 25, Info = 26,
+    dNosecone = 33, dOuterDoor = 34, dRadiator = 38, dRetroDoors = 39, dHoverDoors = 40, dScramDoors = 41,
+    APU = 42, FuelResupplyLine = 47, LoxResupplyLine = 48, ExternalCoolingLine = 53
+};
+
+static int s_failures = 0;
+
+static void Fail(const char *pMessage, const double simt, const char *pDetail)
+{
+    if (++s_failures <= 10)
+        printf("FAIL: t=%.1f: %s: %s\n", simt, pMessage, pDetail);
+}
+
+// Stands in for XRSound: tracks what each slot holds and whether it is playing, and counts LoadWav calls per file
+class MockXRSound
+{
+public:
+    enum PlaybackType { InternalOnly, BothViewClose, BothViewMedium, BothViewFar, Radio, Wind, Global };
+
+    double Now = 0;
+    int LoadCount = 0;
+    map<string, int> LoadsByPath;
+
+    bool LoadWav(const int soundID, const char *pSoundFilename, const PlaybackType playbackType)
+    {
+        if (IsWavPlaying(soundID))
+            Fail("LoadWav into a playing slot", Now, pSoundFilename);
+
+        LoadCount++;
+        LoadsByPath[pSoundFilename]++;
+        Slot &slot = m_slots[soundID];
+        slot = Slot();
+        slot.Path = pSoundFilename;
+        slot.Loaded = (strstr(pSoundFilename, "Missing") == nullptr);    // the one WAV file the script's install lacks
+        return slot.Loaded;
+    }
+
+    bool PlayWav(const int soundID, const bool bLoop = false, const float volume = 1.0f)
+    {
+        auto it = m_slots.find(soundID);
+        if ((it == m_slots.end()) || !it->second.Loaded)
+            return false;
+        it->second.Loop = bLoop;
+        it->second.EndTime = Now + GetDuration(it->second.Path);
+        return true;
+    }
+
+    bool StopWav(const int soundID)
+    {
+        auto it = m_slots.find(soundID);
+        if (it == m_slots.end())
+            return false;
+        it->second.Loop = false;
+        it->second.EndTime = 0;
+        return true;
+    }
+
+    bool IsWavPlaying(const int soundID) const
+    {
+        auto it = m_slots.find(soundID);
+        return ((it != m_slots.end()) && (it->second.Loop || (Now < it->second.EndTime)));
+    }
+
+    const char *GetPath(const int soundID) const
+    {
+        auto it = m_slots.find(soundID);
+        return ((it != m_slots.end()) ? it->second.Path.c_str() : "");
+    }
+
+protected:
+    struct Slot
+    {
+        string Path;
+        bool Loaded = false;
+        bool Loop = false;
+        double EndTime = 0;
+    };
+
+    static double GetDuration(const string &path)
+    {
+        if (path.find("Hydraulics") != string::npos)
+            return 8.0;
+        if (path.find("APU St") != string::npos)   // startup and shutdown
+            return 3.0;
+        if (path.find("Thump") != string::npos)
+            return 0.5;
+        return 1.5;     // voice callouts and resupply line sounds
+    }
+
+    map<int, Slot> m_slots;
+};
+
+typedef XR1SoundCache<MockXRSound> SoundCache;
+
+// Loads and plays sounds the way DeltaGliderXR1::LoadXR1Sound and PlaySound do, and checks each play
+class Player
+{
+public:
+    MockXRSound XRSound;
+    SoundCache Cache;
+    int PlayCount = 0;
+    map<string, int> PeakConcurrentPlays;   // by path: most channels ever playing it at once
+
+    void Play(const int channel, const char *pFilename, const MockXRSound::PlaybackType type, const bool bLoop = false)
+    {
+        char path[280];
+        Cache.Load(XRSound, channel, SOUND_FOLDER, pFilename, type, path, sizeof(path));
+        const int slot = Cache.GetSlot(channel);
+        XRSound.PlayWav(slot, bLoop);
+        PlayCount++;
+
+        char expectedPath[280];
+        snprintf(expectedPath, sizeof(expectedPath), "%s/%s", SOUND_FOLDER, pFilename);
+        if (strcmp(XRSound.GetPath(slot), expectedPath) != 0)
+            Fail("channel plays the wrong WAV", XRSound.Now, expectedPath);
+
+        int playing = 0;
+        for (int c = 1; c < SoundCache::CHANNEL_COUNT; c++)
+        {
+            const int otherSlot = Cache.GetSlot(c);
+            if ((c != channel) && (otherSlot == slot) && XRSound.IsWavPlaying(slot))
+                Fail("two channels play the same slot", XRSound.Now, expectedPath);
+            if (XRSound.IsWavPlaying(otherSlot) && (strcmp(XRSound.GetPath(otherSlot), expectedPath) == 0))
+                playing++;
+        }
+        int &peak = PeakConcurrentPlays[expectedPath];
+        peak = max(peak, max(playing, 1));
+    }
+
+    bool IsPlaying(const int channel) const { return XRSound.IsWavPlaying(Cache.GetSlot(channel)); }
+    void Stop(const int channel) { XRSound.StopWav(Cache.GetSlot(channel)); }
+};
+
+// one door movement: hydraulics loop while it moves, then a thump
+struct DoorMove { double Start; int Channel; double Seconds; };
+
+static void FlyScriptedFlight()
+{
+    Player player;
+
+    // voice callouts are queued and play one at a time on the Info channel
+    vector<pair<double, string>> callouts;
+    callouts.push_back({ 30, "APU Autostart.wav" });
+    for (int m = 1; m <= 20; m++)   // ascent
+        callouts.push_back({ 120 + m * 30.0, "Mach " + to_string(m) + ".wav" });
+    callouts.push_back({ 760, "Refueling Systems Offline.wav" });
+    callouts.push_back({ 800, "Cross-Feed Main.wav" });
+    callouts.push_back({ 830, "Cross-Feed Off.wav" });
+    callouts.push_back({ 900, "Reentry Check All Systems Green.wav" });
+    for (int m = 20; m >= 1; m--)   // reentry
+        callouts.push_back({ 1000 + (20 - m) * 20.0, "Mach " + to_string(m) + ".wav" });
+    callouts.push_back({ 1420, "Subsonic.wav" });
+    callouts.push_back({ 1440, "You are cleared to land.wav" });
+    static const int s_altitudes[] = { 1000, 500, 400, 300, 200, 100, 50, 40, 30, 20, 10, 5 };
+    for (int i = 0; i < 12; i++)
+        callouts.push_back({ 1450 + i * 4.0, to_string(s_altitudes[i]) + ".wav" });
+    callouts.push_back({ 1520, "Wheel Stop.wav" });
+    callouts.push_back({ 1600, "Refueling Systems Online.wav" });
+    callouts.push_back({ 1605, "LOX Resupply Systems Online.wav" });
+    callouts.push_back({ 1610, "External Cooling Online.wav" });
+    callouts.push_back({ 1680, "LOX Tanks Full.wav" });
+    callouts.push_back({ 1690, "Refueling Systems Offline.wav" });
+    callouts.push_back({ 1695, "LOX Resupply Systems Offline.wav" });
+    callouts.push_back({ 1700, "External Cooling Offline.wav" });
+    for (int i = 0; i < 4; i++)     // docking distance callouts at the hangar reuse the altitude callout files
+        callouts.push_back({ 1720 + i * 15.0, to_string(s_altitudes[11 - i]) + ".wav" });
+
+    // warnings repeat every 6 seconds while their condition lasts
+    struct WarningSpan { double Start, End; const char *pFilename; };
+    static const WarningSpan s_warnings[] =
+    {
+        { 620, 650, "Warning SCRAM Temperature.wav" },
+        { 1100, 1200, "Warning Hull Temperature.wav" },
+        { 1150, 1180, "Warning Missing Sound File.wav" },
+        { 1440, 1470, "Warning Gear is Up.wav" },
+        { 1300, 1310, "Warning Hull Temperature.wav" },
+    };
+
+    static const DoorMove s_doorMoves[] =
+    {
+        { 10, dOuterDoor, 6 }, { 20, dOuterDoor, 6 },
+        { 100, dRetroDoors, 7 }, { 100, dHoverDoors, 9 },   // two doors moving at once
+        { 400, dScramDoors, 5 }, { 950, dRadiator, 10 }, { 990, dRadiator, 10 },
+        { 1405, dHoverDoors, 9 }, { 1408, dRetroDoors, 7 }, { 1560, dNosecone, 8 }, { 1620, dOuterDoor, 6 },
+    };
+
+    size_t nextCallout = 0;
+    vector<double> lastWarning(sizeof(s_warnings) / sizeof(s_warnings[0]), -1e9);
+    bool apuRunning = false;
+    for (double simt = 0; simt < FLIGHT_SECONDS; simt += FRAME_SECONDS)
+    {
+        player.XRSound.Now = simt;
+
+        if ((nextCallout < callouts.size()) && (callouts[nextCallout].first <= simt) && !player.IsPlaying(Info))
+            player.Play(Info, callouts[nextCallout++].second.c_str(), MockXRSound::Radio);
+
+        for (size_t i = 0; i < lastWarning.size(); i++)
+        {
+            const WarningSpan &w = s_warnings[i];
+            if ((simt >= w.Start) && (simt < w.End) && (simt - lastWarning[i] >= 6))
+            {
+                player.Play(Warning, w.pFilename, MockXRSound::Radio);
+                lastWarning[i] = simt;
+            }
+        }
+
+        for (const DoorMove &d : s_doorMoves)
+        {
+            if ((simt >= d.Start) && (simt - FRAME_SECONDS < d.Start))
+                player.Play(d.Channel, "Hydraulics1.wav", MockXRSound::InternalOnly, true);
+            if ((simt >= d.Start + d.Seconds) && (simt - FRAME_SECONDS < d.Start + d.Seconds))
+            {
+                player.Stop(d.Channel);
+                player.Play(d.Channel, "Door Opened Thump.wav", MockXRSound::InternalOnly);
+            }
+        }
+
+        if ((simt >= 5) && (simt < 1750))
+        {
+            if (simt - FRAME_SECONDS < 5)
+                player.Play(APU, "APU Startup.wav", MockXRSound::InternalOnly);
+            else if (!apuRunning && !player.IsPlaying(APU))
+            {
+                player.Play(APU, "APU Run.wav", MockXRSound::InternalOnly, true);
+                apuRunning = true;
+            }
+        }
+        else if (apuRunning)
+        {
+            player.Stop(APU);
+            player.Play(APU, "APU Shutdown.wav", MockXRSound::InternalOnly);
+            apuRunning = false;
+        }
+
+        // the resupply lines extend and then attach; all three move at once
+        static const int s_lines[] = { FuelResupplyLine, LoxResupplyLine, ExternalCoolingLine };
+        for (const int line : s_lines)
+        {
+            const double extendTime = 1600 + ((line == ExternalCoolingLine) ? 1 : 0);
+            if ((simt >= extendTime) && (simt - FRAME_SECONDS < extendTime))
+                player.Play(line, "Resupply Line Extend.wav", MockXRSound::InternalOnly);
+            if ((simt >= extendTime + 2) && (simt - FRAME_SECONDS < extendTime + 2))
+                player.Play(line, "Resupply Line Attach.wav", MockXRSound::InternalOnly);
+        }
+    }
+
+    if (nextCallout < callouts.size())
+        Fail("callouts left in the queue", FLIGHT_SECONDS, callouts[nextCallout].second.c_str());
+
+    int repeatedFiles = 0;
+    for (const auto &it : player.XRSound.LoadsByPath)
+    {
+        const int peak = player.PeakConcurrentPlays[it.first];
+        if (it.second > peak)
+        {
+            char detail[400];
+            snprintf(detail, sizeof(detail), "%s loaded %d times, but at most %d channels played it at once", it.first.c_str(), it.second, peak);
+            Fail("WAV read from disk more than once", FLIGHT_SECONDS, detail);
+        }
+        if (it.second > 1)
+            repeatedFiles++;
+    }
+
+    printf("scripted flight: %d plays of %d distinct WAV files, %d LoadWav calls (%d files loaded more than once)\n",
+        player.PlayCount, static_cast<int>(player.XRSound.LoadsByPath.size()), player.XRSound.LoadCount, repeatedFiles);
+}
+
+// Plays each file once on the Info channel and lets it finish
+static void PlayAll(Player &player, const char *pPrefix, const int first, const int count)
+{
+    for (int i = first; i < first + count; i++)
+    {
+        player.Play(Info, (pPrefix + to_string(i) + ".wav").c_str(), MockXRSound::Radio);
+        player.XRSound.Now += 10;
+    }
+}
+
+static void CheckEviction()
+{
+    // a full cache evicts the least-recently-used WAV
+    {
+        Player player;
+        PlayAll(player, "A", 0, SoundCache::CACHE_SIZE);
+        PlayAll(player, "A", 0, 1);     // A0 is now the most recently used
+        int loads = player.XRSound.LoadCount;
+        PlayAll(player, "B", 0, 1);     // evicts A1
+        PlayAll(player, "A", 0, 1);
+        if (player.XRSound.LoadCount != loads + 1)
+            Fail("eviction", player.XRSound.Now, "a recently used WAV was evicted");
+        loads = player.XRSound.LoadCount;
+        PlayAll(player, "A", 1, 1);
+        if (player.XRSound.LoadCount != loads + 1)
+            Fail("eviction", player.XRSound.Now, "the least-recently-used WAV was not evicted");
+    }
+
+    // a working set that fits is loaded once; cycling through one that does not reloads every file
+    {
+        Player player;
+        for (int pass = 0; pass < 3; pass++)
+            PlayAll(player, "C", 0, SoundCache::CACHE_SIZE);
+        if (player.XRSound.LoadCount != SoundCache::CACHE_SIZE)
+            Fail("eviction", player.XRSound.Now, "a working set that fits in the cache was reloaded");
+
+        const int loads = player.XRSound.LoadCount;
+        for (int pass = 0; pass < 2; pass++)
+            PlayAll(player, "D", 0, SoundCache::CACHE_SIZE + 1);
+        if (player.XRSound.LoadCount != loads + 2 * (SoundCache::CACHE_SIZE + 1))
+            Fail("eviction", player.XRSound.Now, "cycling through more WAVs than fit did not follow LRU order");
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        puts("usage: soundcachecheck");
+        return 1;
+    }
+
+    FlyScriptedFlight();
+    CheckEviction();
+
+    if (s_failures > 0)
+    {
+        printf("%d checks failed\n", s_failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,199 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// TelemetryRingBench.cpp
+// Throughput benchmark for the shared memory telemetry ring
+// (XRTelemetryRing.h).
+//
+// A writer thread publishes records as fast as it can, or at a fixed
+// rate with --rate, while a reader thread in the same process drains
+// them through its own mapping of the segment, exactly as an external
+// dashboard would.  Every field of each record is derived from its
+// frame number, so the reader can prove that no record it accepted was
+// torn and that accepted records arrive in order.  Prints the write and
+// read rates and the number of records the reader had to skip.
+//
+// Exit code is 0 if no torn or out-of-order record was read and every
+// record was either read or counted as skipped, 1 otherwise.
+// ==============================================================
+
+#include "XRTelemetryRing.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+struct Options
+{
+    uint64_t RecordCount = 10000000;
+    double Rate = 0;                // records per second; 0 = unthrottled
+};
+
+static void Usage()
+{
+    puts("usage: telemetryringbench [--records n] [--rate records_per_second]\n"
+         "  --records n   number of records to publish (default 10000000)\n"
+         "  --rate r      publish r records per second instead of as fast as possible; e.g., 60 for one vessel at 60 fps");
+}
+
+static bool ParseOptions(const int argc, char *argv[], Options &opt)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pArg = argv[i];
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(pArg, "--records") == 0) && pVal)       { opt.RecordCount = strtoull(pVal, nullptr, 10); i++; }
+        else if ((strcmp(pArg, "--rate") == 0) && pVal)     { opt.Rate = atof(pVal); i++; }
+        else
+        {
+            Usage();
+            return false;
+        }
+    }
+    return (opt.RecordCount > 0);
+}
+
+// fill every field from the frame number so the reader can check the whole record
+static void FillRecord(const uint64_t frame, XRTelemetryRecord &rec)
+{
+    const double f = static_cast<double>(frame);
+    rec.FrameSequence = frame;
+    double *pFirst = &rec.SimTime;
+    double *pLast = &rec.CoolantTemp;
+    for (double *p = pFirst; p <= pLast; p++)
+        *p = f;
+    for (int i = 0; i < 15; i++)
+        rec.DoorStates[i] = static_cast<int32_t>(frame);
+    rec.MasterWarning = static_cast<int32_t>(frame);
+}
+
+static bool IsRecordConsistent(const XRTelemetryRecord &rec)
+{
+    const double f = static_cast<double>(rec.FrameSequence);
+    const double *pFirst = &rec.SimTime;
+    const double *pLast = &rec.CoolantTemp;
+    for (const double *p = pFirst; p <= pLast; p++)
+    {
+        if (*p != f)
+            return false;
+    }
+    for (int i = 0; i < 15; i++)
+    {
+        if (rec.DoorStates[i] != static_cast<int32_t>(rec.FrameSequence))
+            return false;
+    }
+    return (rec.MasterWarning == static_cast<int32_t>(rec.FrameSequence));
+}
+
+int main(int argc, char *argv[])
+{
+    Options opt;
+    if (!ParseOptions(argc, argv, opt))
+        return 2;
+
+    char vesselName[64];
+    snprintf(vesselName, sizeof(vesselName), "TelemetryRingBench-%d", static_cast<int>(getpid()));
+
+    XRTelemetryRingWriter writer;
+    if (!writer.Open(vesselName))
+    {
+        fprintf(stderr, "Cannot create shared memory segment for '%s'.\n", vesselName);
+        return 2;
+    }
+
+    XRTelemetryRingReader reader;
+    if (!reader.Open(vesselName))
+    {
+        fprintf(stderr, "Cannot attach to shared memory segment for '%s'.\n", vesselName);
+        return 2;
+    }
+
+    atomic<bool> writerDone(false);
+    uint64_t readCount = 0, tornCount = 0, outOfOrderCount = 0;
+    double readSeconds = 0;
+
+    thread readerThread([&]
+    {
+        XRTelemetryRecord rec;
+        uint64_t lastFrame = 0;
+        bool haveLast = false;
+        const Clock::time_point start = Clock::now();
+        for (;;)
+        {
+            const bool done = writerDone.load(memory_order_acquire);
+            const XRTelemetryRingReader::ReadResult result = reader.ReadNext(rec);
+            if (result == XRTelemetryRingReader::ReadResult::Record)
+            {
+                readCount++;
+                if (!IsRecordConsistent(rec))
+                    tornCount++;
+                else if (haveLast && (rec.FrameSequence <= lastFrame))
+                    outOfOrderCount++;
+                lastFrame = rec.FrameSequence;
+                haveLast = true;
+            }
+            else if (done)
+                break;  // the writer has finished and we have read everything it published
+            else
+                this_thread::yield();
+        }
+        readSeconds = chrono::duration<double>(Clock::now() - start).count();
+    });
+
+    XRTelemetryRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    const Clock::time_point start = Clock::now();
+    for (uint64_t frame = 0; frame < opt.RecordCount; frame++)
+    {
+        FillRecord(frame, rec);
+        writer.Publish(rec);
+        if (opt.Rate > 0)
+            this_thread::sleep_until(start + chrono::duration_cast<Clock::duration>(chrono::duration<double>((frame + 1) / opt.Rate)));
+    }
+    const double writeSeconds = chrono::duration<double>(Clock::now() - start).count();
+    writerDone.store(true, memory_order_release);
+    readerThread.join();
+
+    const uint64_t droppedCount = reader.GetDroppedCount();
+    printf("records published: %llu in %.3f s (%.1f M records/s)\n",
+        static_cast<unsigned long long>(opt.RecordCount), writeSeconds, opt.RecordCount / writeSeconds / 1e6);
+    if (opt.Rate == 0)
+        printf("Publish cost:      %.1f ns per record\n", writeSeconds * 1e9 / opt.RecordCount);
+    printf("records read:      %llu in %.3f s (%.1f M records/s)\n",
+        static_cast<unsigned long long>(readCount), readSeconds, readCount / readSeconds / 1e6);
+    printf("records skipped:   %llu (reader lapped by the writer)\n", static_cast<unsigned long long>(droppedCount));
+    printf("torn records:      %llu\n", static_cast<unsigned long long>(tornCount));
+    printf("out-of-order:      %llu\n", static_cast<unsigned long long>(outOfOrderCount));
+
+    // every published record must be either read or counted as skipped
+    const bool accountedFor = ((readCount + droppedCount) == opt.RecordCount);
+    if (!accountedFor)
+        printf("FAILED: read + skipped != published\n");
+
+    return (((tornCount == 0) && (outOfOrderCount == 0) && accountedFor) ? 0 : 1);
+}
@@ -0,0 +1,334 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// TextBoxDrawCheck.cpp
+// Sketchpad draw-count check for TextBox::Render.
+//
+// Renders a TextBox and a copy of the original TextBox::Render, which
+// set the text color before every line, into recording sketchpads
+// while random info and warning messages are added to their line
+// group.  Fails if the two ever draw different text, at different
+// positions or in a different color, font or background, or disagree
+// about whether the box was redrawn.  Also fails if Render sets the
+// text color more than once per run of same-colored lines, leaves a
+// different font selected than it found, or draws anything when the
+// text is unchanged.  Reports the sketchpad calls each made.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "TextBox.h"
+#include "XRRandom.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+static const int GROUP_LINES = 32;
+
+//-------------------------------------------------------------------------
+// The original TextBox::Render, verbatim apart from renaming
+
+class OriginalTextBox : public TextBox
+{
+public:
+    OriginalTextBox(int width, int height, uint32_t normalTextColor, uint32_t highlightTextColor, uint32_t bgColor, int screenLineCount, const TextLineGroup &textLineGroup) :
+        TextBox(width, height, normalTextColor, highlightTextColor, bgColor, screenLineCount, textLineGroup)
+    {
+    }
+
+    virtual bool Render(oapi::Sketchpad *skp, int topY, oapi::Font *font, int lineSpacing, bool forceRender, int startingLineNumber = -1) override
+    {
+        bool retVal = false;        // assume NOT re-rendered
+
+        const int currentAddLinesCount = m_textLineGroup.GetAddLinesCount();
+        if (forceRender || (currentAddLinesCount != m_lastRenderedAddLinesCount))
+        {
+            m_lastRenderedAddLinesCount = currentAddLinesCount;     // remember this
+
+            // text has changed; must re-render this box
+            retVal = true;        
+
+            oapi::Font *prevFont = skp->SetFont(font);
+            if (m_bgColor == CWHITE)
+            {
+                skp->SetBackgroundMode(oapi::Sketchpad::BK_TRANSPARENT);
+            }
+            else
+            {
+                skp->SetBackgroundMode(oapi::Sketchpad::BK_OPAQUE);
+                skp->SetBackgroundColor(m_bgColor);
+            }
+
+            skp->SetTextAlign(oapi::Sketchpad::LEFT);
+
+            int cy = topY + 1;  // top spacing
+            int cx = 3;         // left side spacing
+
+            // figure out which line at which to begin rendering
+            const int bufferLineCount = m_textLineGroup.GetLineCount();   // current # of lines in the buffer
+            if (startingLineNumber <= 0)
+            {
+                // user wants a full screen starting from the end
+                if (m_screenLineCount >= bufferLineCount)
+                    startingLineNumber = 1; // entire buffer fits on screen
+                else
+                    startingLineNumber = bufferLineCount - m_screenLineCount + 1;    // bottom n lines in buffer (index is 1-based)
+            }
+            else if (startingLineNumber > bufferLineCount)   // out-of-range?
+                return false;     // can't render anything (don't want to throw exception here b/c we don't want to CTD for this)
+
+            // loop thorough lines in vector, which has 0-based index
+            const int startingLineIndex = startingLineNumber-1;     // 0-based
+            const int endingLineIndex = min(startingLineIndex + m_screenLineCount, bufferLineCount);   // EXCLUSIVE
+            for (int i = startingLineIndex; i < endingLineIndex; i++)
+            {
+                const TextLine &line = m_textLineGroup.GetLine(i);
+
+                skp->SetTextColor((line.color == TEXTCOLOR::Normal ? m_normalTextColor : m_highlightTextColor));
+                skp->Text(cx, cy, line.text, line.length);
+
+                // drop to next line
+                cy += lineSpacing;
+            }
+
+            // restore previous font
+            skp->SetFont(prevFont);
+        }
+
+        return retVal;
+    }
+};
+
+//-------------------------------------------------------------------------
+
+// one Text call and the sketchpad state it was drawn with
+struct DrawnText
+{
+    int X, Y;
+    string Text;
+    uint32_t TextColor;
+    const oapi::Font *Font;
+    oapi::Sketchpad::BkgMode BackgroundMode;
+    uint32_t BackgroundColor;   // valid only for BK_OPAQUE
+    oapi::Sketchpad::TAlign_horizontal Align;
+
+    bool operator==(const DrawnText &that) const
+    {
+        return (X == that.X) && (Y == that.Y) && (Text == that.Text) && (TextColor == that.TextColor) && (Font == that.Font) &&
+            (BackgroundMode == that.BackgroundMode) && (Align == that.Align) &&
+            ((BackgroundMode != oapi::Sketchpad::BK_OPAQUE) || (BackgroundColor == that.BackgroundColor));
+    }
+};
+
+// Records what is drawn on it and counts every call
+class RecordingSketchpad : public oapi::Sketchpad
+{
+public:
+    // Starts a new render with the panel's font selected
+    void Reset(oapi::Font *pFont)
+    {
+        m_pFont = pFont;
+        m_textColor = m_backgroundColor = 0;
+        m_backgroundMode = BK_TRANSPARENT;
+        m_align = CENTER;
+        Drawn.clear();
+        TextColorCalls = Calls = 0;
+    }
+
+    const oapi::Font *GetFont() const { return m_pFont; }
+
+    virtual oapi::Font *SetFont(oapi::Font *font) const override
+    {
+        Calls++;
+        oapi::Font *pPrev = m_pFont;
+        m_pFont = font;
+        return pPrev;
+    }
+    virtual void SetTextAlign(TAlign_horizontal tah, TAlign_vertical tav) override { Calls++; m_align = tah; }
+    virtual uint32_t SetTextColor(uint32_t col) override { Calls++; TextColorCalls++; return Swap(m_textColor, col); }
+    virtual uint32_t SetBackgroundColor(uint32_t col) override { Calls++; return Swap(m_backgroundColor, col); }
+    virtual void SetBackgroundMode(BkgMode mode) override { Calls++; m_backgroundMode = mode; }
+    virtual bool Text(int x, int y, const char *str, int len) override
+    {
+        Calls++;
+        Drawn.push_back({ x, y, string(str, len), m_textColor, m_pFont, m_backgroundMode, m_backgroundColor, m_align });
+        return true;
+    }
+
+    vector<DrawnText> Drawn;
+    int TextColorCalls;
+    mutable int Calls;      // SetFont is const
+
+protected:
+    static uint32_t Swap(uint32_t &current, const uint32_t col)
+    {
+        const uint32_t prev = current;
+        current = col;
+        return prev;
+    }
+
+    mutable oapi::Font *m_pFont;
+    uint32_t m_textColor, m_backgroundColor;
+    BkgMode m_backgroundMode;
+    TAlign_horizontal m_align;
+};
+
+// Returns the number of runs of same-colored text in the drawn lines
+static int CountColorRuns(const vector<DrawnText> &drawn)
+{
+    int runs = 0;
+    for (size_t i = 0; i < drawn.size(); i++)
+    {
+        if ((i == 0) || (drawn[i].TextColor != drawn[i - 1].TextColor))
+            runs++;
+    }
+    return runs;
+}
+
+// Adds a random 1-3 line info or warning message
+static void AddMessage(XRRandom &rng, TextLineGroup &group)
+{
+    static const char *s_words[] = { "WARNING:", "SCRAM", "doors", "open", "Hull", "temperature", "critical", "Gear", "is", "up",
+        "APU", "fuel", "depleted", "Docking", "port", "contact", "Impact=", "2.345", "m/s" };
+    const int wordCount = static_cast<int>(sizeof(s_words) / sizeof(s_words[0]));
+
+    string text;
+    const int lines = 1 + static_cast<int>(rng.NextDouble() * 3);
+    for (int i = 0; i < lines; i++)
+    {
+        if (i > 0)
+            text += '&';
+        const int words = 1 + static_cast<int>(rng.NextDouble() * 6);
+        for (int w = 0; w < words; w++)
+            text += string((w > 0) ? " " : "") + s_words[static_cast<int>(rng.NextDouble() * wordCount)];
+    }
+    group.AddLines(text.c_str(), rng.NextDouble() < 0.4);
+}
+
+struct BoxConfig
+{
+    int ScreenLineCount;
+    uint32_t BackgroundColor;
+};
+
+int main(int argc, char *argv[])
+{
+    int renderCount = 200000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--renders") == 0) && pVal)  { renderCount = atoi(pVal); i++; }
+        else
+        {
+            puts("usage: textboxdrawcheck [--renders n]\n"
+                 "  --renders n   Render calls per text box (default 200000)");
+            return 1;
+        }
+    }
+    if (renderCount < 1)
+    {
+        fprintf(stderr, "--renders must be at least 1\n");
+        return 1;
+    }
+
+    // from a single line up to more lines than the group holds, with transparent (CWHITE) and opaque backgrounds
+    static const BoxConfig s_configs[] = { { 1, CWHITE }, { 6, CWHITE }, { 12, 0x202020 }, { GROUP_LINES + 8, 0x000040 } };
+
+    oapi::Font panelFont, textBoxFont;
+    RecordingSketchpad skp, originalSkp;
+    XRRandom rng(0x7E44);
+    int failures = 0;
+    long long renders = 0, redraws = 0, linesDrawn = 0;
+    long long textColorCalls = 0, originalTextColorCalls = 0, calls = 0, originalCalls = 0;
+
+    auto fail = [&failures](const char *pMsg, const BoxConfig &config, const long long render)
+    {
+        if (++failures <= 10)
+            printf("FAIL: %s (%d-line box, render %lld)\n", pMsg, config.ScreenLineCount, render);
+    };
+
+    for (const BoxConfig &config : s_configs)
+    {
+        TextLineGroup group(GROUP_LINES);
+        TextBox box(200, 100, 0x00FF00, 0x00FFFF, config.BackgroundColor, config.ScreenLineCount, group);
+        OriginalTextBox originalBox(200, 100, 0x00FF00, 0x00FFFF, config.BackgroundColor, config.ScreenLineCount, group);
+
+        for (int r = 0; r < renderCount; r++)
+        {
+            if (rng.NextDouble() < 0.5)
+                AddMessage(rng, group);
+
+            const int topY = static_cast<int>(rng.NextDouble() * 20);
+            const int lineSpacing = 10 + static_cast<int>(rng.NextDouble() * 6);
+            const bool forceRender = (rng.NextDouble() < 0.2);
+            // mostly the last screenful, as the panels render it; sometimes a given line, including out-of-range ones
+            const int startingLineNumber = (rng.NextDouble() < 0.7) ? -1 : static_cast<int>(rng.NextDouble() * (group.GetLineCount() + 4));
+
+            skp.Reset(&panelFont);
+            originalSkp.Reset(&panelFont);
+            const bool rendered = box.Render(&skp, topY, &textBoxFont, lineSpacing, forceRender, startingLineNumber);
+            const bool originalRendered = originalBox.Render(&originalSkp, topY, &textBoxFont, lineSpacing, forceRender, startingLineNumber);
+
+            renders++;
+            redraws += rendered;
+            linesDrawn += skp.Drawn.size();
+            textColorCalls += skp.TextColorCalls;
+            originalTextColorCalls += originalSkp.TextColorCalls;
+            calls += skp.Calls;
+            originalCalls += originalSkp.Calls;
+
+            if (rendered != originalRendered)
+                fail("Render's result differs from the original code's", config, r);
+            if (skp.Drawn != originalSkp.Drawn)
+                fail("Render drew different text than the original code", config, r);
+            if (skp.GetFont() != &panelFont)
+                fail("Render left a different font selected than it found", config, r);
+            if (!rendered && (skp.Calls != 0))
+                fail("Render made sketchpad calls without redrawing the box", config, r);
+            if (skp.TextColorCalls != CountColorRuns(skp.Drawn))
+                fail("Render set the text color other than once per run of same-colored lines", config, r);
+
+            // nothing has changed since the render above, so an unforced render must not draw anything
+            skp.Reset(&panelFont);
+            if (box.Render(&skp, topY, &textBoxFont, lineSpacing, false, startingLineNumber) || (skp.Calls != 0))
+                fail("an unforced Render of unchanged text drew something", config, r);
+            originalSkp.Reset(&panelFont);
+            originalBox.Render(&originalSkp, topY, &textBoxFont, lineSpacing, false, startingLineNumber);
+        }
+    }
+
+    printf("%lld renders, %lld redraws, %lld lines drawn: SetTextColor called %lld times (original code %lld), "
+        "%lld sketchpad calls in all (original code %lld)\n",
+        renders, redraws, linesDrawn, textColorCalls, originalTextColorCalls, calls, originalCalls);
+
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,257 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// TextLineBench.cpp
+// Benchmark and consistency check for the HUD text line ring buffer
+// (TextLineGroup in TextBox.h).
+//
+// Pushes --lines text lines (default 1,000,000) through a 64-line
+// TextLineGroup, as single and '&'-separated multi-line messages like
+// the vessel's info and warning messages, and does the same with a
+// copy of the original TextLineGroup that kept each line in a
+// heap-allocated std::string and erased the oldest one from the front
+// of a vector.  Reports the time per line for each and fails if the
+// two ever hold different lines, other than the ring buffer's
+// truncation of lines longer than TextLine::MAX_LENGTH.  The messages
+// are built before timing starts, so only AddLines is timed.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "TextBox.h"
+#include "XRRandom.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static const int GROUP_LINES = 64;          // the info/warning line group's size
+static const int MAX_MESSAGE_LENGTH = 512;  // as in XR1Globals.h; only used by the original code
+
+//-------------------------------------------------------------------------
+// The original TextLineGroup, verbatim apart from renaming
+
+struct OriginalTextLine
+{
+    OriginalTextLine(const char *pText, TEXTCOLOR color) 
+    {
+        this->text = pText;
+        this->color = color;
+    }
+
+    OriginalTextLine(const OriginalTextLine &that) 
+    {
+        text = that.text;
+        color = that.color;
+    }
+
+    string text;
+    TEXTCOLOR color;
+};
+
+class OriginalTextLineGroup
+{
+public:
+    OriginalTextLineGroup(const int maxLines) : m_maxLines(maxLines), m_addLinesCount(0) { }
+
+    ~OriginalTextLineGroup()
+    {
+        for (unsigned int i=0; i < m_lines.size(); i++)
+            delete m_lines[i];
+    }
+
+    int GetLineCount() const { return static_cast<int>(m_lines.size()); }
+    const OriginalTextLine &GetLine(const int index) const { return *m_lines[index]; }
+
+    void AddLines(const char *pStr, bool highlighted)
+    {
+        m_addLinesCount++;
+
+        char temp[MAX_MESSAGE_LENGTH];
+        strcpy(temp, pStr);
+
+        char *pStart = temp;
+        bool cont = true;
+        while (cont)
+        {
+            char *pEnd = strchr(pStart, '&');
+            if (pEnd)
+            {
+                *pEnd = 0;
+            }
+            else
+                cont = false;
+
+            OriginalTextLine textLine(pStart, (highlighted ? TEXTCOLOR::Highlighted : TEXTCOLOR::Normal));
+            AddLine(textLine);
+
+            if (pEnd)
+                pStart = pEnd + 1;
+        }
+    }
+
+protected:
+    void AddLine(const OriginalTextLine &textLine)
+    {
+        m_lines.push_back(new OriginalTextLine(textLine));
+
+        int lineCount = GetLineCount();
+        if (lineCount > m_maxLines)
+        {
+            lineCount = m_maxLines;
+            delete m_lines[0];
+            m_lines.erase(m_lines.begin());
+        }
+    }
+
+    const int m_maxLines;
+    int m_addLinesCount;
+    vector<const OriginalTextLine *> m_lines;
+};
+
+//-------------------------------------------------------------------------
+
+struct Message
+{
+    string Text;
+    bool Highlighted;
+};
+
+// Returns the number of lines in the messages
+static long long BuildMessages(const long long lineCount, vector<Message> &messages)
+{
+    static const char *s_words[] = { "WARNING:", "SCRAM", "doors", "open", "Hull", "temperature", "critical", "Gear", "is", "up",
+        "APU", "fuel", "depleted", "Docking", "port", "contact", "Impact=", "2.345", "m/s", "You", "and", "the", "crew", "are", "UNINJURED." };
+    const int wordCount = static_cast<int>(sizeof(s_words) / sizeof(s_words[0]));
+
+    XRRandom rng(0x7E47);
+    long long lines = 0;
+    while (lines < lineCount)
+    {
+        Message m;
+        m.Highlighted = (rng.NextDouble() < 0.3);
+        const int messageLines = min(1 + static_cast<int>(rng.NextDouble() * 3), static_cast<int>(lineCount - lines));
+        bool hasLongLine = false;
+        for (int i = 0; i < messageLines; i++)
+        {
+            if (i > 0)
+                m.Text += '&';
+            // Mostly short lines, occasionally one too long for TextLine.  At most one long line per message keeps the
+            // whole message under MAX_MESSAGE_LENGTH, as the vessel's messages are.
+            const bool isLongLine = (!hasLongLine && (rng.NextDouble() < 0.01));
+            hasLongLine |= isLongLine;
+            const int words = (isLongLine ? 25 : 2 + static_cast<int>(rng.NextDouble() * 6));
+            for (int w = 0; w < words; w++)
+                m.Text += string((w > 0) ? " " : "") + s_words[static_cast<int>(rng.NextDouble() * wordCount)];
+        }
+        lines += messageLines;
+        messages.push_back(m);
+    }
+    return lines;
+}
+
+static bool GroupsMatch(const TextLineGroup &group, const OriginalTextLineGroup &original)
+{
+    if (group.GetLineCount() != original.GetLineCount())
+        return false;
+    for (int i = 0; i < group.GetLineCount(); i++)
+    {
+        const TextLine &line = group.GetLine(i);
+        const string expected = original.GetLine(i).text.substr(0, TextLine::MAX_LENGTH);
+        if ((line.length != static_cast<int>(expected.size())) || (expected != line.text) || (line.color != original.GetLine(i).color))
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    long long lineCount = 1000000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--lines") == 0) && pVal)  { lineCount = atoll(pVal); i++; }
+        else
+        {
+            puts("usage: textlinebench [--lines n]\n"
+                 "  --lines n   text lines to add (default 1000000)");
+            return 1;
+        }
+    }
+    if (lineCount < 1)
+    {
+        fprintf(stderr, "--lines must be at least 1\n");
+        return 1;
+    }
+
+    vector<Message> messages;
+    const long long lines = BuildMessages(lineCount, messages);
+
+    TextLineGroup group(GROUP_LINES);
+    Clock::time_point start = Clock::now();
+    for (const Message &m : messages)
+        group.AddLines(m.Text.c_str(), m.Highlighted);
+    const double ringSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+    OriginalTextLineGroup original(GROUP_LINES);
+    start = Clock::now();
+    for (const Message &m : messages)
+        original.AddLines(m.Text.c_str(), m.Highlighted);
+    const double originalSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+    int failures = 0;
+    if (!GroupsMatch(group, original))
+    {
+        puts("FAIL: the ring buffer's lines differ from the original code's after the last message");
+        failures++;
+    }
+
+    // compare the two after every message, untimed
+    TextLineGroup checkGroup(GROUP_LINES);
+    OriginalTextLineGroup checkOriginal(GROUP_LINES);
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        checkGroup.AddLines(messages[i].Text.c_str(), messages[i].Highlighted);
+        checkOriginal.AddLines(messages[i].Text.c_str(), messages[i].Highlighted);
+        if ((checkGroup.GetAddLinesCount() != static_cast<int>(i + 1)) || !GroupsMatch(checkGroup, checkOriginal))
+        {
+            if (++failures <= 10)
+                printf("FAIL: the ring buffer's lines differ from the original code's after message %zu\n", i);
+        }
+    }
+
+    printf("%lld lines in %zu messages: ring buffer %.1f ns per line, original code %.1f ns per line\n",
+        lines, messages.size(), ringSeconds * 1e9 / lines, originalSeconds * 1e9 / lines);
+
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
@@ -0,0 +1,403 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XRRandomCheck.cpp
+// Distribution and replay checks for the per-vessel random number
+// generator (XRRandom.h).
+//
+// Draws --draws values (default 10^6) from each of several seeds and
+// checks NextDouble for range, mean, variance, a 100-bin chi-square
+// uniformity test, and lag-1 serial correlation, and NextUInt64 for
+// per-bit balance, and checks that streams from adjacent seeds are
+// uncorrelated.  The seeds are fixed, so the results are
+// repeatable; the limits are about five standard errors (chi-square:
+// p = 0.001), so a correct generator never fails them.  Also checks
+// that restoring a saved (seed, counter) state replays the same
+// sequence, which is what the RNG_STATE scenario line relies on.
+//
+// The damage rolls in XR1DamageRolls.h, which TestDamage and FailDoor
+// call, are checked the same way:
+// - a simulated over-limit flight with wing stress failures and door
+//   heat failures is saved mid-flight as an RNG_STATE line written by
+//   XRScenarioWriter; reloading it into a generator with a different
+//   seed must replay the rest of the failure sequence bit for bit.
+//   (scenarioroundtrip runs the same line through the production
+//   scenario parser.)
+// - --draws rolls of each kind must match their failure probabilities
+//   and jam position distribution to within five standard errors.
+//
+// Exit code is 0 if all checks pass, 1 otherwise.
+// ==============================================================
+
+#include "XRRandom.h"
+#include "XR1DamageRolls.h"
+#include "XRScenarioWriter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const int BIN_COUNT = 100;
+static const double CHI_SQUARE_LIMIT = 148.23;     // 99 degrees of freedom, p = 0.001
+
+static int s_failures = 0;
+
+static void Check(const bool ok, const uint64_t seed, const char *pWhat, const double value, const double limit)
+{
+    if (!ok)
+    {
+        printf("FAIL: seed 0x%llx: %s = %.6g (limit %.6g)\n", static_cast<unsigned long long>(seed), pWhat, value, limit);
+        s_failures++;
+    }
+}
+
+static void CheckSeed(const uint64_t seed, const long long drawCount)
+{
+    XRRandom rng(seed);
+    long long bins[BIN_COUNT] = { };
+    double sum = 0, sumSquares = 0, sumLag = 0, minValue = 1, maxValue = 0, prev = 0;
+    for (long long i = 0; i < drawCount; i++)
+    {
+        const double x = rng.NextDouble();
+        if (x < minValue) minValue = x;
+        if (x > maxValue) maxValue = x;
+        sum += x;
+        sumSquares += x * x;
+        if (i > 0)
+            sumLag += (x - 0.5) * (prev - 0.5);
+        prev = x;
+        const int bin = static_cast<int>(x * BIN_COUNT);
+        bins[(bin < BIN_COUNT) ? bin : BIN_COUNT - 1]++;
+    }
+
+    const double n = static_cast<double>(drawCount);
+    const double mean = sum / n;
+    const double variance = sumSquares / n - mean * mean;
+    const double meanLimit = 5 * sqrt(1.0 / 12.0 / n);
+    const double varianceLimit = 5 * sqrt(1.0 / 180.0 / n);        // fourth central moment of U(0,1) minus variance squared: 1/80 - 1/144 = 1/180
+    const double correlation = (sumLag / (n - 1)) * 12.0;          // divided by the variance, 1/12
+    const double correlationLimit = 5 / sqrt(n);
+
+    double chiSquare = 0;
+    const double expected = n / BIN_COUNT;
+    for (int i = 0; i < BIN_COUNT; i++)
+        chiSquare += (bins[i] - expected) * (bins[i] - expected) / expected;
+
+    Check((minValue >= 0) && (maxValue < 1), seed, "NextDouble minimum", minValue, 0);
+    Check(fabs(mean - 0.5) <= meanLimit, seed, "|mean - 1/2|", fabs(mean - 0.5), meanLimit);
+    Check(fabs(variance - 1.0 / 12.0) <= varianceLimit, seed, "|variance - 1/12|", fabs(variance - 1.0 / 12.0), varianceLimit);
+    Check(chiSquare <= CHI_SQUARE_LIMIT, seed, "chi-square", chiSquare, CHI_SQUARE_LIMIT);
+    Check(fabs(correlation) <= correlationLimit, seed, "|lag-1 correlation|", fabs(correlation), correlationLimit);
+
+    // every bit of NextUInt64 should be set half of the time
+    XRRandom bitRng(seed);
+    long long bitCounts[64] = { };
+    for (long long i = 0; i < drawCount; i++)
+    {
+        const uint64_t v = bitRng.NextUInt64();
+        for (int b = 0; b < 64; b++)
+            bitCounts[b] += static_cast<long long>((v >> b) & 1);
+    }
+    const double bitLimit = 5 * sqrt(n * 0.25);
+    for (int b = 0; b < 64; b++)
+    {
+        char what[48];
+        snprintf(what, sizeof(what), "|bit %d count - n/2|", b);
+        Check(fabs(bitCounts[b] - n / 2) <= bitLimit, seed, what, fabs(bitCounts[b] - n / 2), bitLimit);
+    }
+
+    printf("seed 0x%016llx: mean %.6f, variance %.6f, chi-square %.1f, lag-1 correlation %+.5f, range [%.3g, 1 - %.3g]\n",
+        static_cast<unsigned long long>(seed), mean, variance, chiSquare, correlation, minValue, 1 - maxValue);
+}
+
+// Streams from adjacent seeds must be uncorrelated: SplitMix64 only adds the seed to the counter
+// before mixing, and a careless caller may seed vessels with consecutive values.
+static void CheckAdjacentSeeds(const uint64_t seed, const long long drawCount)
+{
+    XRRandom a(seed), b(seed + 1);
+    double sumProduct = 0;
+    for (long long i = 0; i < drawCount; i++)
+        sumProduct += (a.NextDouble() - 0.5) * (b.NextDouble() - 0.5);
+    const double correlation = (sumProduct / drawCount) * 12.0;
+    const double limit = 5 / sqrt(static_cast<double>(drawCount));
+    Check(fabs(correlation) <= limit, seed, "|correlation with seed + 1|", fabs(correlation), limit);
+}
+
+// restoring a saved state must replay the values drawn after it was saved
+static void CheckReplay(const uint64_t seed)
+{
+    XRRandom rng(seed);
+    for (int i = 0; i < 12345; i++)
+        rng.NextUInt64();
+
+    const uint64_t savedSeed = rng.GetSeed();
+    const uint64_t savedCounter = rng.GetCounter();
+    uint64_t values[1000];
+    for (int i = 0; i < 1000; i++)
+        values[i] = rng.NextUInt64();
+
+    XRRandom replay;
+    replay.SetState(savedSeed, savedCounter);
+    for (int i = 0; i < 1000; i++)
+    {
+        if (replay.NextUInt64() != values[i])
+        {
+            printf("FAIL: seed 0x%llx: replay diverges at value %d\n", static_cast<unsigned long long>(seed), i);
+            s_failures++;
+            return;
+        }
+    }
+}
+
+// scenario file contents captured from oapiWriteLine
+static string s_scenarioFile;
+
+void oapiWriteLine(FILEHANDLE file, char *line)
+{
+    s_scenarioFile += line;
+    s_scenarioFile += '\n';
+}
+
+// one failure in a simulated flight; 'value' is the wing integrity multiplier or the door jam position
+struct FailureEvent
+{
+    int frame;
+    int part;       // WingStressFailure value, or DOOR_PART_BASE + door index
+    double value;
+};
+
+static const int DOOR_COUNT = 6;
+static const int DOOR_PART_BASE = 100;
+
+// A flight that stays over its wing load and door temperature limits: each frame rolls a wing stress failure as
+// TestDamage does, and a heat failure for each open door that has not failed yet, jamming it as FailDoor does.
+// Doors are repaired every 500 frames so that they keep failing.
+static void FlyOverLimits(XRRandom &rng, const int firstFrame, const int endFrame, vector<FailureEvent> &events)
+{
+    bool doorFailed[DOOR_COUNT] = { };
+    for (int frame = firstFrame; frame < endFrame; frame++)
+    {
+        if ((frame % 500) == 0)
+        {
+            for (bool &failed : doorFailed)
+                failed = false;
+        }
+
+        const double dt = 0.01 + 0.001 * (frame % 7);   // uneven frame rate
+        const double alpha = 0.5 + 0.25 * (frame % 5);
+        double wingFrac = 1.0;
+        const WingStressFailure failure = RollWingStressFailure(rng, alpha, dt, wingFrac);
+        if (failure != WingStressFailure::None)
+            events.push_back({ frame, static_cast<int>(failure), wingFrac });
+
+        for (int door = 0; door < DOOR_COUNT; door++)
+        {
+            if (doorFailed[door])
+                continue;
+            const double tempK = 700 + 40 * door;
+            if (RollHeatDamage(rng, GetHeatDamageProbability(tempK, 600, dt)))
+            {
+                doorFailed[door] = true;
+                events.push_back({ frame, DOOR_PART_BASE + door, RollFailedDoorProc(rng) });
+            }
+        }
+    }
+}
+
+// reloading a mid-flight RNG_STATE must replay the rest of the wing and door failure sequence bit for bit
+static void CheckFailureReplay(const uint64_t seed)
+{
+    const int FRAME_COUNT = 20000, SAVE_FRAME = 10000;
+    XRRandom rng(seed);
+    vector<FailureEvent> beforeSave, original;
+    FlyOverLimits(rng, 0, SAVE_FRAME, beforeSave);
+
+    // save the generator state as DeltaGliderXR1::WriteXRCommonScenarioLines does
+    XRScenarioWriter w;
+    w.BeginLine("RNG_STATE");
+    w.AppendUInt64(rng.GetSeed());
+    w.AppendUInt64(rng.GetCounter());
+    w.EndLine();
+    s_scenarioFile.clear();
+    w.Flush(nullptr);
+
+    FlyOverLimits(rng, SAVE_FRAME, FRAME_COUNT, original);
+
+    // reload it into a generator that was seeded differently, as a freshly created vessel is
+    XRRandom replay(~seed);
+    unsigned long long savedSeed = 0, savedCounter = 0;
+    if (sscanf(s_scenarioFile.c_str(), "  RNG_STATE %llu %llu", &savedSeed, &savedCounter) != 2)
+    {
+        printf("FAIL: seed 0x%llx: cannot read back '%s'\n", static_cast<unsigned long long>(seed), s_scenarioFile.c_str());
+        s_failures++;
+        return;
+    }
+    replay.SetState(savedSeed, savedCounter);
+    vector<FailureEvent> replayed;
+    FlyOverLimits(replay, SAVE_FRAME, FRAME_COUNT, replayed);
+
+    int wingFailures = 0, doorFailures = 0;
+    for (const FailureEvent &e : original)
+        (e.part >= DOOR_PART_BASE ? doorFailures : wingFailures)++;
+    if ((wingFailures < 10) || (doorFailures < 10))
+    {
+        printf("FAIL: seed 0x%llx: replayed flight has only %d wing and %d door failures\n", static_cast<unsigned long long>(seed), wingFailures, doorFailures);
+        s_failures++;
+    }
+
+    if (replayed.size() != original.size())
+    {
+        printf("FAIL: seed 0x%llx: replay has %d failures, original %d\n", static_cast<unsigned long long>(seed), static_cast<int>(replayed.size()), static_cast<int>(original.size()));
+        s_failures++;
+        return;
+    }
+    for (size_t i = 0; i < original.size(); i++)
+    {
+        const FailureEvent &a = original[i], &b = replayed[i];
+        if ((a.frame != b.frame) || (a.part != b.part) || (memcmp(&a.value, &b.value, sizeof(double)) != 0))
+        {
+            printf("FAIL: seed 0x%llx: replay diverges at failure %d: frame %d part %d value %.17g, original frame %d part %d value %.17g\n",
+                static_cast<unsigned long long>(seed), static_cast<int>(i), b.frame, b.part, b.value, a.frame, a.part, a.value);
+            s_failures++;
+            return;
+        }
+    }
+}
+
+// 'count' successes in n trials of probability p must be within five standard errors
+static void CheckRate(const uint64_t seed, const char *pWhat, const long long count, const double n, const double p)
+{
+    const double limit = 5 * sqrt(n * p * (1 - p));
+    char what[96];
+    snprintf(what, sizeof(what), "|%s count - %.0f|", pWhat, n * p);
+    Check(fabs(count - n * p) <= limit, seed, what, fabs(count - n * p), limit);
+}
+
+// the damage rolls must fail at their stated probabilities
+static void CheckFailureRates(const uint64_t seed, const long long drawCount)
+{
+    const double n = static_cast<double>(drawCount);
+    XRRandom rng(seed);
+
+    // wing stress: alpha 2 for 0.1 second, so p = 1 - e^-0.2; each part equally likely, wing multiplier e^(-alpha * U)
+    const double alpha = 2.0, dt = 0.1;
+    const double p = 1.0 - exp(-alpha * dt);
+    long long partCounts[5] = { };
+    double wingFracSum = 0, wingFracSumSquares = 0;
+    for (long long i = 0; i < drawCount; i++)
+    {
+        double wingFrac = 1.0;
+        const WingStressFailure failure = RollWingStressFailure(rng, alpha, dt, wingFrac);
+        partCounts[static_cast<int>(failure)]++;
+        if ((failure == WingStressFailure::LeftWing) || (failure == WingStressFailure::RightWing))
+        {
+            wingFracSum += wingFrac;
+            wingFracSumSquares += wingFrac * wingFrac;
+        }
+    }
+    CheckRate(seed, "wing stress failure", drawCount - partCounts[0], n, p);
+    static const char *s_partNames[] = { "", "left wing failure", "right wing failure", "left aileron failure", "right aileron failure" };
+    for (int i = 1; i < 5; i++)
+        CheckRate(seed, s_partNames[i], partCounts[i], n, p / 4);
+
+    const double wingCount = static_cast<double>(partCounts[1] + partCounts[2]);
+    const double wingFracMean = (1 - exp(-alpha)) / alpha;
+    const double wingFracVariance = (1 - exp(-2 * alpha)) / (2 * alpha) - wingFracMean * wingFracMean;
+    const double wingFracLimit = 5 * sqrt(wingFracVariance / wingCount);
+    Check(fabs(wingFracSum / wingCount - wingFracMean) <= wingFracLimit, seed, "|mean wing multiplier - (1 - e^-2) / 2|", fabs(wingFracSum / wingCount - wingFracMean), wingFracLimit);
+
+    // heat damage: 50% over the limit at 10 fps, and ten times the limit for 0.1 second, which must always fail
+    const double heatP = GetHeatDamageProbability(900, 600, 0.1);     // p = 0.028125
+    long long heatCount = 0, certainCount = 0;
+    for (long long i = 0; i < drawCount; i++)
+    {
+        heatCount += RollHeatDamage(rng, heatP);
+        certainCount += RollHeatDamage(rng, GetHeatDamageProbability(6000, 600, 0.1));    // p = 1.25
+    }
+    CheckRate(seed, "heat damage", heatCount, n, heatP);
+    Check(certainCount == drawCount, seed, "heat damage misses with p > 1", static_cast<double>(drawCount - certainCount), 0);
+
+    // door jam position: fmod(U, 0.3) + 0.2 is in [0.2, 0.5), below 0.3 with probability 0.4, mean 0.34, variance 0.0077333
+    long long lowCount = 0;
+    double procSum = 0, minProc = 1, maxProc = 0;
+    for (long long i = 0; i < drawCount; i++)
+    {
+        const double proc = RollFailedDoorProc(rng);
+        if (proc < minProc) minProc = proc;
+        if (proc > maxProc) maxProc = proc;
+        lowCount += (proc < 0.3);
+        procSum += proc;
+    }
+    Check((minProc >= 0.2) && (maxProc < 0.5), seed, "door jam position outside [0.2, 0.5)", ((minProc < 0.2) ? minProc : maxProc), 0.2);
+    CheckRate(seed, "door jam position < 0.3", lowCount, n, 0.4);
+    const double procLimit = 5 * sqrt((0.082 / 3 - 0.14 * 0.14) / n);
+    Check(fabs(procSum / n - 0.34) <= procLimit, seed, "|mean door jam position - 0.34|", fabs(procSum / n - 0.34), procLimit);
+
+    printf("seed 0x%016llx: wing stress failures %lld (expected %.0f), heat damage %lld (expected %.0f), door jams below 0.3 %lld (expected %.0f)\n",
+        static_cast<unsigned long long>(seed), drawCount - partCounts[0], n * p, heatCount, n * heatP, lowCount, n * 0.4);
+}
+
+int main(int argc, char *argv[])
+{
+    long long drawCount = 1000000;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pVal = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((strcmp(argv[i], "--draws") == 0) && pVal)  { drawCount = atoll(pVal); i++; }
+        else
+        {
+            puts("usage: xrrandomcheck [--draws n]\n"
+                 "  --draws n   values drawn per seed (default 1000000)");
+            return 1;
+        }
+    }
+    if (drawCount < 1000)
+    {
+        fprintf(stderr, "--draws must be at least 1000\n");
+        return 1;
+    }
+
+    // zero, small sequential seeds (as a careless caller might use), and arbitrary ones
+    static const uint64_t s_seeds[] = { 0, 1, 2, 0x5EED, 0x123456789ABCDEF0ULL, 0xFFFFFFFFFFFFFFFFULL };
+    for (const uint64_t seed : s_seeds)
+    {
+        CheckSeed(seed, drawCount);
+        CheckAdjacentSeeds(seed, drawCount);
+        CheckReplay(seed);
+        CheckFailureReplay(seed);
+        CheckFailureRates(seed, drawCount);
+    }
+
+    if (s_failures > 0)
+    {
+        printf("%d checks failed\n", s_failures);
+        return 1;
+    }
+    puts("all checks passed");
+    return 0;
+}
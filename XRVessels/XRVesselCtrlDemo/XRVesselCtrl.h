@@ -22,7 +22,7 @@
 // ==============================================================
 // Public XR-Class Vessel Control Header File.
 // 
-// XRVesselControl Version: 4.0
+// XRVesselControl Version: 4.2
 // Release Date: 16-Aug-2021
 //
 // XR vessels implementing this API version: XR1 2.0, XR2 2.0, XR5 2.0
@@ -47,7 +47,7 @@ class XRVesselCtrl;
 
 // Use this floating point constant when implementing your ship's GetCtrlAPIVersion method; also, you should compare each vessel's API 
 // version against this version when you are writing interface code.
-#define THIS_XRVESSELCTRL_API_VERSION 4.0f
+#define THIS_XRVESSELCTRL_API_VERSION 4.2f
 
 /*
   Here is an example of how to use the XRVesselCtrl API:
@@ -313,6 +313,89 @@ bool XRVesselCtrlFlag = true;
 // added in XRVesselCtrl API version 3.0
 enum class XRXFEED_STATE { XRXF_MAIN, XRXF_OFF, XRXF_RCS };
 
+//-------------------------------------------------------------------------
+
+// added in XRVesselCtrl API version 4.1
+// Telemetry snapshot: a single flat structure containing all the readable XRVesselCtrl state, populated by one call to 
+// GetXRTelemetrySnapshot.  The vessel builds the snapshot at most once per frame and shares it between all callers, so 
+// polling this is much cheaper than invoking the individual Get* methods every frame.
+//
+// NOTE: new fields will only ever be appended to the end of this structure; existing fields will never be moved or removed.
+#define XRTELEMETRY_SNAPSHOT_VERSION 1
+#define XRTELEMETRY_ENGINE_COUNT     8      // one for each XREngineID value
+#define XRTELEMETRY_DOOR_COUNT       15     // one for each XRDoorID value
+#define XRTELEMETRY_STDAP_COUNT      7      // one for each XRStdAutopilot value
+#define XRTELEMETRY_LIGHT_COUNT      3      // one for each XRLight value
+#define XRTELEMETRY_MAX_PAYLOAD_SLOTS 64    // larger than any XR vessel's payload bay
+
+struct XRTelemetrySnapshot
+{
+    int                 Version;            // XRTELEMETRY_SNAPSHOT_VERSION implemented by the vessel
+    int                 StructSize;         // sizeof(XRTelemetrySnapshot) as compiled by the vessel
+    unsigned long long  FrameSequence;      // increments by one each Orbiter frame; if this matches the value you saw last time, nothing has changed
+    double              SimTime;            // vessel's absolute simulation time in seconds when this snapshot was built
+
+    XRSystemStatusRead  Status;             // same as GetXRSystemStatus
+
+    // indexed by XREngineID; EngineSupported[n] is false if the vessel does not have that engine (Engines[n] is undefined in that case)
+    bool                EngineSupported[XRTELEMETRY_ENGINE_COUNT];
+    XREngineStateRead   Engines[XRTELEMETRY_ENGINE_COUNT];
+
+    // indexed by XRDoorID; DoorProc[n] is -1 if the door has no proc or is not supported
+    XRDoorState         DoorStates[XRTELEMETRY_DOOR_COUNT];
+    double              DoorProcs[XRTELEMETRY_DOOR_COUNT];
+    XRDoorState         ExternalCoolingState;
+
+    // indexed by XRStdAutopilot
+    XRAutopilotState    StandardAP[XRTELEMETRY_STDAP_COUNT];
+    XRAutopilotState    AttitudeHoldAPState;
+    XRAttitudeHoldState AttitudeHold;
+    XRAutopilotState    DescentHoldAPState;
+    XRDescentHoldState  DescentHold;
+    XRAutopilotState    AirspeedHoldAPState;
+    XRAirspeedHoldState AirspeedHold;
+
+    // indexed by XRLight
+    bool                ExteriorLights[XRTELEMETRY_LIGHT_COUNT];
+
+    int                 SecondaryHUDMode;   // 0 = off
+    bool                TertiaryHUDOn;
+    bool                RCSDockingMode;
+    bool                ElevatorEVAPortActive;
+    bool                RecenterCOGMode;
+
+    // payload bay; only the first min(PayloadBaySlotCount, XRTELEMETRY_MAX_PAYLOAD_SLOTS) entries are valid (PayloadSlots[0] = slot #1)
+    int                 PayloadBaySlotCount;
+    XRPayloadSlotData   PayloadSlots[XRTELEMETRY_MAX_PAYLOAD_SLOTS];
+};
+
+//-------------------------------------------------------------------------
+// added in XRVesselCtrl API version 4.2
+//-------------------------------------------------------------------------
+// A queued state change for EnqueueXRCommand.  Set Type and ID, then fill in only the field(s) that apply to that type.
+enum class XRCommandType
+{
+    XRCMD_EngineState,      // ID = XREngineID; uses EngineState
+    XRCMD_DoorState,        // ID = XRDoorID; uses DoorState
+    XRCMD_StandardAP,       // ID = XRStdAutopilot; uses On
+    XRCMD_AttitudeHold,     // ID ignored; uses AttitudeHold
+    XRCMD_DescentHold,      // ID ignored; uses DescentHold
+    XRCMD_AirspeedHold,     // ID ignored; uses AirspeedHold
+    XRCMD_ExteriorLight     // ID = XRLight; uses On
+};
+
+struct XRCommand
+{
+    XRCommandType       Type;
+    int                 ID;
+    XREngineStateWrite  EngineState;
+    XRDoorState         DoorState;
+    bool                On;
+    XRAttitudeHoldState AttitudeHold;
+    XRDescentHoldState  DescentHold;
+    XRAirspeedHoldState AirspeedHold;
+};
+
 //=========================================================================
 // Each vessel that supports this API will extend this abstract 
 // base class.  This need not be limited to only XR-class vessels; it is up
@@ -527,6 +610,31 @@ public:
     // Returns: true on success, false if state is invalid or no crew members on board
     virtual bool SetCrossFeedMode(XRXFEED_STATE state) = 0;
 
+    //=====================================================================
+    // Methods added in API version 4.1
+    //=====================================================================
+    // Populates snapshotOut with all the readable state of this vessel in a single call.  The snapshot is built at most once 
+    // per frame and cached, so any number of callers may poll this every frame.  Compare snapshotOut.FrameSequence against the 
+    // value from your previous call to skip processing unchanged data.
+    //   snapshotOut: structure to be populated
+    //   structSize: leave this at its default value; it allows vessels built against a newer version of this header to safely 
+    //               populate an older (smaller) client structure, and vice versa.
+    // Returns: true on success, false if structSize is too small to hold even the Version and StructSize fields
+    virtual bool GetXRTelemetrySnapshot(XRTelemetrySnapshot &snapshotOut, const int structSize = sizeof(XRTelemetrySnapshot)) = 0;
+
+    //=====================================================================
+    // Methods added in API version 4.2
+    //=====================================================================
+    // Queues a state change to be applied at the start of the vessel's next timestep.  Unlike the Set* methods, this may be 
+    // called from any thread.  All commands queued before a timestep are applied together, in the order they were first queued, 
+    // with a single panel redraw for the whole batch; if a command is queued more than once for the same Type and ID before it 
+    // is applied, only the last one is kept.  Commands for systems not supported by this vessel are silently ignored when applied.
+    // Returns: true on success, false if command.Type is invalid
+    virtual bool EnqueueXRCommand(const XRCommand &command) = 0;
+
+    // Returns the number of queued commands that have not been applied yet; may be called from any thread.
+    virtual int GetQueuedXRCommandCount() = 0;
+
     //=====================================================================
 
     // TODO: add resupply / refueling support later as necessary
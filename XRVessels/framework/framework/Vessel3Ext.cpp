@@ -32,13 +32,14 @@
 #include "InstrumentPanel.h"
 #include "PrePostStep.h"
 #include <cassert>
+#include <algorithm>
 
 // constructor
 VESSEL3_EXT::VESSEL3_EXT(OBJHANDLE vessel, int fmodel) :
     XRVesselCtrl(vessel, fmodel),
     m_hModule(nullptr), m_hasFocus(false), exmesh_tpl(nullptr),
 	m_videoWindowWidth(0), m_videoWindowHeight(0), m_lastVideoWindowWidth(-1), m_last2DPanelWidth(0),
-    m_absoluteSimTime(0), m_pConfig(nullptr)
+    m_absoluteSimTime(0), m_frameSequence(0), m_deferRedraws(false), m_pConfig(nullptr)
 {
 	//m_regKeyManager.Initialize(HKEY_CURRENT_USER, XR_GLOBAL_SETTINGS_REG_KEY, nullptr);   // should always succeed
 }
@@ -132,6 +133,14 @@ InstrumentPanel *VESSEL3_EXT::GetInstrumentPanel(const int panelNumber)
 // Trigger a redraw are for the supplied area ID by sending the request to each of our panels
 bool VESSEL3_EXT::TriggerRedrawArea(const int areaID)
 {
+    if (m_deferRedraws)
+    {
+        // only redraw each area once per batch
+        if (find(m_deferredRedrawAreas.begin(), m_deferredRedrawAreas.end(), areaID) == m_deferredRedrawAreas.end())
+            m_deferredRedrawAreas.push_back(areaID);
+        return true;
+    }
+
     // iterate through each of our instrument panels and send the request to each
     bool wasProcessed = false;
 
@@ -151,6 +160,23 @@ bool VESSEL3_EXT::TriggerRedrawArea(const int areaID)
     return wasProcessed;
 }
 
+void VESSEL3_EXT::BeginDeferredRedraws()
+{
+    assert(!m_deferRedraws);   // nesting not supported
+    m_deferRedraws = true;
+}
+
+void VESSEL3_EXT::EndDeferredRedraws()
+{
+    assert(m_deferRedraws);
+    m_deferRedraws = false;
+
+    for (unsigned int i = 0; i < m_deferredRedrawAreas.size(); i++)
+        TriggerRedrawArea(m_deferredRedrawAreas[i]);
+
+    m_deferredRedrawAreas.clear();
+}
+
 // Note: this is called BEFORE clbkLoadPanel; this is sort of a hack to get the video mode width, but it's the only way to do it
 // short of implementing bitmap-independent panels.
 // TODO: look into use oapiGetViewportSize() instead of this.
@@ -430,6 +456,8 @@ void VESSEL3_EXT::clbkPreStep(double simtDoNotUse, double simdt, double mjd)
     if (simdt > 0)
         m_absoluteSimTime += simdt;
 
+    m_frameSequence++;  // new frame
+
     // DEBUG: sprintf(oapiDebugString(), "GetAbsoluteSimTime()=%lf, simtDoNotUse=%lf", GetAbsoluteSimTime(), simtDoNotUse);
 
     // ********************************************************************
@@ -132,6 +132,10 @@ public:
     // This is the same principle as oapiGetSimTime except that it always returns a value >= the previous frame's value.
     double GetAbsoluteSimTime() const { return m_absoluteSimTime; }  
 
+    // Returns the number of frames (clbkPreStep calls) since simulation start; 0 = first frame has not started yet.
+    // Use this to cache data that only needs to be computed once per frame.
+    unsigned long long GetFrameSequence() const { return m_frameSequence; }
+
     // Returns the number of seconds since the system booted (realtime); typically has 10-16 millisecond accuracy (16 ms = 1/60th second),
     // which should suffice for normal realtime deltas.
     // Note: it is OK for this method to be static without a mutex because Orbiter is single-threaded
@@ -158,6 +162,11 @@ public:
     // you should not normally need to override these methods; however, they are virtual in case you need to sometime
     virtual bool TriggerRedrawArea(const int areaID);
 
+    // While deferred, TriggerRedrawArea only records the area ID; EndDeferredRedraws then redraws each recorded area exactly once.
+    // Use this to coalesce the redraws from a batch of state changes.  Calls may not be nested.
+    void BeginDeferredRedraws();
+    void EndDeferredRedraws();
+
     // if you hook any of these methods in your subclass, be sure to invoke the VESSEL3_EXT method as well
     virtual void clbkPreStep(double simt, double simdt, double mjd);
     virtual void clbkPostStep(double simt, double simdt, double mjd);
@@ -225,6 +234,9 @@ private:
     vector<PrePostStep *> m_postStepVector;      // list of PrePostStep objects; may be empty
     vector<PrePostStep *> m_preStepVector;       // list of PrePostStep objects; may be empty
     double m_absoluteSimTime;                    // linear simulation time since simulation start, ignoring any MJD changes (edits)
+    unsigned long long m_frameSequence;          // incremented once per frame by clbkPreStep
+    bool m_deferRedraws;                         // true = TriggerRedrawArea is inside a Begin/EndDeferredRedraws block
+    vector<int> m_deferredRedrawAreas;           // unique area IDs to be redrawn by EndDeferredRedraws
 };
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,167 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRCalloutQueue.cpp
+// Priority-ordered voice callout scheduler.
+// ==============================================================
+
+#include "XRCalloutQueue.h"
+#include <cassert>
+#include <cstring>
+
+XRCalloutQueue::XRCalloutQueue(const double minimumSpacing, const XRCalloutPriority preemptPriority) :
+    m_minimumSpacing(minimumSpacing), m_preemptPriority(preemptPriority)
+{
+    Clear();
+}
+
+void XRCalloutQueue::Clear()
+{
+    m_pendingCount = 0;
+    m_hasActive = false;
+    m_nextStartTime = 0;
+    m_nextSequence = 0;
+    m_playedCount = m_coalescedCount = m_droppedCount = 0;
+}
+
+void XRCalloutQueue::Enqueue(const double simt, const XRCalloutPriority priority, const int coalesceGroup, const int soundID, const char *pFilename,
+                             const int soundType, const double maxAge)
+{
+    if (pFilename == nullptr)
+        pFilename = "";
+
+    // a callout in the same group supersedes the pending one, as does a repeat of the same sound
+    int index = -1;
+    for (int i = 0; i < m_pendingCount; i++)
+    {
+        const Callout &c = m_pending[i];
+        const bool isSuperseded = ((coalesceGroup != 0) ? (c.coalesceGroup == coalesceGroup) : 
+            ((c.coalesceGroup == 0) && (c.soundID == soundID) && (strcmp(c.filename, pFilename) == 0)));
+        if (isSuperseded)
+        {
+            index = i;
+            m_coalescedCount++;
+            break;
+        }
+    }
+
+    if (index < 0)
+    {
+        if (m_pendingCount < MAX_PENDING)
+        {
+            index = m_pendingCount++;
+        }
+        else
+        {
+            // queue is full: push out the least important, oldest callout unless the new one is less important still
+            int victim = 0;
+            for (int i = 1; i < m_pendingCount; i++)
+            {
+                const Callout &c = m_pending[i];
+                if ((c.priority < m_pending[victim].priority) || ((c.priority == m_pending[victim].priority) && (c.sequence < m_pending[victim].sequence)))
+                    victim = i;
+            }
+
+            m_droppedCount++;
+            if (priority < m_pending[victim].priority)
+                return;     // drop the new callout
+            index = victim;
+        }
+    }
+
+    Callout &c = m_pending[index];
+    c.priority = priority;
+    c.coalesceGroup = coalesceGroup;
+    c.soundID = soundID;
+    c.soundType = soundType;
+    c.expireTime = simt + maxAge;
+    c.sequence = m_nextSequence++;
+    strncpy(c.filename, pFilename, sizeof(c.filename) - 1);
+    c.filename[sizeof(c.filename) - 1] = 0;
+}
+
+const XRCalloutQueue::Callout *XRCalloutQueue::Update(const double simt, const bool isActivePlaying, const bool isBlocked, bool &preemptActive)
+{
+    preemptActive = false;
+
+    // never play a stale callout
+    for (int i = m_pendingCount - 1; i >= 0; i--)
+    {
+        if (simt > m_pending[i].expireTime)
+        {
+            RemovePending(i);
+            m_droppedCount++;
+        }
+    }
+
+    if (m_hasActive && !isActivePlaying)
+    {
+        // active callout just finished (or was stopped by someone else)
+        m_hasActive = false;
+        m_nextStartTime = simt + m_minimumSpacing;
+    }
+
+    const int next = FindNext();
+    if (next < 0)
+        return nullptr;
+
+    const Callout &c = m_pending[next];
+    if (isBlocked && (c.priority < m_preemptPriority))
+        return nullptr;
+
+    if (m_hasActive)
+    {
+        if ((c.priority < m_preemptPriority) || (c.priority <= m_active.priority))
+            return nullptr;     // wait for the active callout to finish
+        preemptActive = true;
+    }
+    else if (simt < m_nextStartTime)
+    {
+        return nullptr;
+    }
+
+    m_active = c;
+    m_hasActive = true;
+    m_playedCount++;
+    RemovePending(next);
+    return &m_active;
+}
+
+int XRCalloutQueue::FindNext() const
+{
+    int next = -1;
+    for (int i = 0; i < m_pendingCount; i++)
+    {
+        const Callout &c = m_pending[i];
+        if ((next < 0) || (c.priority > m_pending[next].priority) || ((c.priority == m_pending[next].priority) && (c.sequence < m_pending[next].sequence)))
+            next = i;
+    }
+    return next;
+}
+
+void XRCalloutQueue::RemovePending(const int index)
+{
+    assert((index >= 0) && (index < m_pendingCount));
+
+    // order does not matter; see FindNext
+    m_pending[index] = m_pending[--m_pendingCount];
+}
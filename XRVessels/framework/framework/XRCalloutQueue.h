@@ -0,0 +1,98 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRCalloutQueue.h
+// Schedules voice callouts so that only one plays at a time.
+//
+// Callouts are queued with a priority and play highest-priority first,
+// with a minimum gap between the end of one callout and the start of the
+// next.  A new callout in the same coalescing group as a pending one
+// replaces it (e.g., only the latest altitude callout plays), and a
+// callout that has waited longer than its maximum age is dropped rather
+// than played late.  Callouts at or above the preempt priority interrupt
+// a lower-priority callout that is already playing, and are not held
+// off while the queue is blocked.
+//
+// This class only decides *what* to play and *when*; the vessel does the
+// actual playing, so there are no Orbiter or XRSound dependencies here.
+// ==============================================================
+
+#pragma once
+
+#include <cstdint>
+
+// in increasing order of importance
+enum class XRCalloutPriority { Velocity, Info, Docking, Crash, Warning };
+
+class XRCalloutQueue
+{
+public:
+    struct Callout
+    {
+        XRCalloutPriority priority;
+        int coalesceGroup;          // a new callout replaces any pending callout in the same group; 0 = none
+        int soundID;                // preloaded sound to play if filename is empty
+        int soundType;              // passed back to the vessel as-is
+        double expireTime;          // simt after which the callout is dropped if it has not started playing
+        unsigned int sequence;      // enqueue order; breaks ties between callouts of equal priority
+        char filename[256];         // WAV file to load and play; empty = play soundID
+    };
+
+    XRCalloutQueue(const double minimumSpacing = 0.25, const XRCalloutPriority preemptPriority = XRCalloutPriority::Crash);
+
+    // Queue a callout; pFilename may be null or empty to play a preloaded soundID instead.
+    void Enqueue(const double simt, const XRCalloutPriority priority, const int coalesceGroup, const int soundID, const char *pFilename, 
+                 const int soundType, const double maxAge);
+
+    // Invoke once per frame.  isActivePlaying = whether the callout last returned by this method is still playing;
+    // isBlocked = true to hold off callouts below the preempt priority, e.g., while a warning is playing outside of this queue.
+    // Returns the callout to start playing now, or nullptr if none.  If preemptActive is set on return, the caller 
+    // must stop the active callout before playing the new one.
+    const Callout *Update(const double simt, const bool isActivePlaying, const bool isBlocked, bool &preemptActive);
+
+    // Returns the callout that is playing (or was playing as of the last Update), or nullptr if none.
+    const Callout *GetActive() const { return (m_hasActive ? &m_active : nullptr); }
+
+    void Clear();
+    int GetPendingCount() const { return m_pendingCount; }
+    unsigned int GetPlayedCount() const { return m_playedCount; }
+    unsigned int GetCoalescedCount() const { return m_coalescedCount; }
+    unsigned int GetDroppedCount() const { return m_droppedCount; }
+
+    static const int MAX_PENDING = 8;
+
+protected:
+    int FindNext() const;   // index of the pending callout to play next, or -1 if none
+    void RemovePending(const int index);
+
+    const double m_minimumSpacing;
+    const XRCalloutPriority m_preemptPriority;
+    Callout m_pending[MAX_PENDING];     // unordered
+    int m_pendingCount;
+    Callout m_active;
+    bool m_hasActive;
+    double m_nextStartTime;             // earliest simt at which the next callout may start if none is playing
+    unsigned int m_nextSequence;
+    unsigned int m_playedCount;
+    unsigned int m_coalescedCount;
+    unsigned int m_droppedCount;        // expired before playing or pushed out of a full queue
+};
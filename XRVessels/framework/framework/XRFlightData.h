@@ -0,0 +1,227 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRFlightData.h
+// Binary flight data file format for XR-specific vessel state that
+// Orbiter's own flight recorder does not capture: hull temperatures,
+// consumables, autopilot modes, and damage.  The vessel samples a
+// fixed set of fields at a fixed rate (see XRFlightDataRecorder); this
+// header defines the frame layout, the delta encoding, and a reader.
+//
+// Every field is stored as a raw 64-bit word, so a replayed frame is
+// bit-for-bit identical to the recorded one.  Each frame on disk is a
+// 64-bit mask of the fields that changed since the previous frame
+// followed by the new value of each of those fields.  Every
+// KeyframeInterval frames a complete frame is written instead.
+//
+// This header has no Orbiter dependencies so that out-of-process tools
+// can include it as-is.
+// ==============================================================
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#define XRFLIGHTDATA_MAGIC              0x44465258u     // 'XRFD'
+#define XRFLIGHTDATA_VERSION            1
+#define XRFLIGHTDATA_KEYFRAME_INTERVAL  256             // frames between complete frames
+#define XRFLIGHTDATA_FILE_EXTENSION     ".xrfd"
+
+// Recorded fields; each is one 64-bit word in XRFlightDataFrame.
+// NOTE: new fields will only ever be appended before FieldCount.
+enum class XRFlightDataField
+{
+    SimTime,                    // absolute simulation time in seconds
+
+    // temperatures and life support
+    NoseconeTemp,               // Kelvin
+    LeftWingTemp,
+    RightWingTemp,
+    CockpitTemp,
+    TopHullTemp,
+    CoolantTemp,                // degrees C
+    CabinO2Level,               // fraction; nominal = .209
+
+    // consumables; 0 <= n <= 1.0 (-1 = not supported)
+    MainFuelLevel,
+    SCRAMFuelLevel,
+    RCSFuelLevel,
+    APUFuelLevel,
+    LOXLevel,
+
+    // autopilots; booleans and enums are stored as integers
+    StdAutopilotMask,           // bit n set = XRStdAutopilot n engaged
+    AttitudeHoldOn,
+    AttitudeHoldMode,           // XRAttitudeHoldMode
+    AttitudeHoldTargetPitch,    // degrees
+    AttitudeHoldTargetBank,     // degrees
+    DescentHoldOn,
+    DescentHoldTargetRate,      // m/s
+    DescentHoldAutoLand,
+    AirspeedHoldOn,
+    AirspeedHoldTarget,         // m/s
+
+    // damage: one integrity fraction for each double in XRSystemStatusWrite, in declaration order (LeftWing ... ForwardRCS)
+    DamageIntegrityFirst,
+    DamageIntegrityLast = DamageIntegrityFirst + 23,
+    DamageStateMask,            // two bits per XRDamageState in XRSystemStatusWrite, in declaration order (LeftAileron = bits 0-1)
+    InternalSystemsFailure,
+    MasterWarning,
+
+    FieldCount
+};
+
+static const int XRFLIGHTDATA_FIELD_COUNT = static_cast<int>(XRFlightDataField::FieldCount);
+static_assert(XRFLIGHTDATA_FIELD_COUNT <= 64, "each field must have a bit in the 64-bit change mask");
+
+struct XRFlightDataFrame
+{
+    uint64_t Words[XRFLIGHTDATA_FIELD_COUNT];
+
+    double GetDouble(const XRFlightDataField field) const { double val; memcpy(&val, &Words[static_cast<int>(field)], sizeof(val)); return val; }
+    int64_t GetInt(const XRFlightDataField field) const { return static_cast<int64_t>(Words[static_cast<int>(field)]); }
+    void SetDouble(const XRFlightDataField field, const double val) { memcpy(&Words[static_cast<int>(field)], &val, sizeof(val)); }
+    void SetInt(const XRFlightDataField field, const int64_t val) { Words[static_cast<int>(field)] = static_cast<uint64_t>(val); }
+};
+
+// Written once at the start of the file
+struct XRFlightDataFileHeader
+{
+    uint32_t Magic;             // XRFLIGHTDATA_MAGIC
+    uint32_t Version;           // XRFLIGHTDATA_VERSION
+    uint32_t FieldCount;        // XRFLIGHTDATA_FIELD_COUNT as compiled by the writer
+    uint32_t KeyframeInterval;  // XRFLIGHTDATA_KEYFRAME_INTERVAL as compiled by the writer
+    double   SampleInterval;    // seconds between frames
+    char     VesselName[64];
+};
+
+// largest possible encoded frame: the change mask plus every field
+static const size_t XRFLIGHTDATA_MAX_ENCODED_FRAME_SIZE = sizeof(uint64_t) * (1 + XRFLIGHTDATA_FIELD_COUNT);
+
+// Encode 'frame' as a delta against 'prevFrame' (or as a complete frame if isKeyframe is true) into pOut, which must
+// hold at least XRFLIGHTDATA_MAX_ENCODED_FRAME_SIZE bytes.  Returns the number of bytes written.
+inline size_t XRFlightDataEncodeFrame(const XRFlightDataFrame &prevFrame, const XRFlightDataFrame &frame, const bool isKeyframe, uint8_t *pOut)
+{
+    uint64_t changeMask = 0;
+    for (int i = 0; i < XRFLIGHTDATA_FIELD_COUNT; i++)
+    {
+        if (isKeyframe || (frame.Words[i] != prevFrame.Words[i]))
+            changeMask |= (1ull << i);
+    }
+
+    uint8_t *p = pOut;
+    memcpy(p, &changeMask, sizeof(changeMask));
+    p += sizeof(changeMask);
+    for (int i = 0; i < XRFLIGHTDATA_FIELD_COUNT; i++)
+    {
+        if (changeMask & (1ull << i))
+        {
+            memcpy(p, &frame.Words[i], sizeof(uint64_t));
+            p += sizeof(uint64_t);
+        }
+    }
+    return static_cast<size_t>(p - pOut);
+}
+
+//-------------------------------------------------------------------------
+
+// Reads a flight data file frame by frame
+class XRFlightDataReader
+{
+public:
+    enum class ReadResult { Frame, EndOfFile, Corrupt, NotOpen };
+
+    XRFlightDataReader() : m_pFile(nullptr), m_frameCount(0), m_changeMask(0) { memset(&m_header, 0, sizeof(m_header)); memset(&m_frame, 0, sizeof(m_frame)); }
+    virtual ~XRFlightDataReader() { Close(); }
+
+    // Returns false if the file cannot be opened or was written with a different layout
+    bool Open(const char *pFilename)
+    {
+        Close();
+        m_pFile = fopen(pFilename, "rb");
+        if (m_pFile == nullptr)
+            return false;
+
+        if ((fread(&m_header, sizeof(m_header), 1, m_pFile) != 1) || (m_header.Magic != XRFLIGHTDATA_MAGIC) ||
+            (m_header.Version != XRFLIGHTDATA_VERSION) || (m_header.FieldCount != XRFLIGHTDATA_FIELD_COUNT))
+        {
+            Close();
+            return false;
+        }
+
+        memset(&m_frame, 0, sizeof(m_frame));
+        m_frameCount = 0;
+        m_changeMask = 0;
+        return true;
+    }
+
+    void Close()
+    {
+        if (m_pFile != nullptr)
+        {
+            fclose(m_pFile);
+            m_pFile = nullptr;
+        }
+    }
+
+    bool IsOpen() const { return (m_pFile != nullptr); }
+    const XRFlightDataFileHeader &GetHeader() const { return m_header; }
+
+    // Decode the next frame into frameOut; GetChangeMask then returns the fields that differ from the previous frame.
+    ReadResult ReadNext(XRFlightDataFrame &frameOut)
+    {
+        if (m_pFile == nullptr)
+            return ReadResult::NotOpen;
+
+        uint64_t changeMask;
+        if (fread(&changeMask, sizeof(changeMask), 1, m_pFile) != 1)
+            return ReadResult::EndOfFile;
+
+        // the first frame of the file must be complete
+        const uint64_t allFields = (XRFLIGHTDATA_FIELD_COUNT == 64) ? ~0ull : ((1ull << XRFLIGHTDATA_FIELD_COUNT) - 1);
+        if ((changeMask & ~allFields) || ((m_frameCount == 0) && (changeMask != allFields)))
+            return ReadResult::Corrupt;
+
+        for (int i = 0; i < XRFLIGHTDATA_FIELD_COUNT; i++)
+        {
+            if ((changeMask & (1ull << i)) && (fread(&m_frame.Words[i], sizeof(uint64_t), 1, m_pFile) != 1))
+                return ReadResult::Corrupt;     // truncated frame
+        }
+
+        m_frameCount++;
+        m_changeMask = changeMask;
+        frameOut = m_frame;
+        return ReadResult::Frame;
+    }
+
+    uint64_t GetChangeMask() const { return m_changeMask; }
+    uint64_t GetFrameCount() const { return m_frameCount; }    // number of frames read so far
+
+protected:
+    FILE *m_pFile;
+    XRFlightDataFileHeader m_header;
+    XRFlightDataFrame m_frame;      // last decoded frame; deltas are applied to this
+    uint64_t m_frameCount;
+    uint64_t m_changeMask;
+};
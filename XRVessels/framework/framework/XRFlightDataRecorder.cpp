@@ -0,0 +1,178 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRFlightDataRecorder.cpp
+// Background-thread writer for binary flight data files.
+// ==============================================================
+
+#include "XRFlightDataRecorder.h"
+#include <chrono>
+#include <filesystem>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+static_assert((XRFlightDataRecorder::RING_SLOTS & (XRFlightDataRecorder::RING_SLOTS - 1)) == 0, "RING_SLOTS must be a power of two");
+
+// how often the writer thread wakes up to drain the ring
+static const chrono::milliseconds WRITER_THREAD_PERIOD(100);
+
+XRFlightDataRecorder::XRFlightDataRecorder() :
+    m_pFile(nullptr), m_writeCount(0), m_readCount(0), m_droppedCount(0), m_writeError(false),
+    m_stopRequested(false), m_encodedFrameCount(0)
+{
+    memset(&m_prevFrame, 0, sizeof(m_prevFrame));
+}
+
+XRFlightDataRecorder::~XRFlightDataRecorder()
+{
+    Close();
+}
+
+bool XRFlightDataRecorder::Open(const char *pFilename, const char *pVesselName, const double sampleInterval)
+{
+    Close();
+
+    m_pFile = fopen(pFilename, "wb");
+    if (m_pFile == nullptr)
+        return false;
+
+    XRFlightDataFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = XRFLIGHTDATA_MAGIC;
+    header.Version = XRFLIGHTDATA_VERSION;
+    header.FieldCount = XRFLIGHTDATA_FIELD_COUNT;
+    header.KeyframeInterval = XRFLIGHTDATA_KEYFRAME_INTERVAL;
+    header.SampleInterval = sampleInterval;
+    strncpy(header.VesselName, pVesselName, sizeof(header.VesselName) - 1);
+    if (fwrite(&header, sizeof(header), 1, m_pFile) != 1)
+    {
+        fclose(m_pFile);
+        m_pFile = nullptr;
+        return false;
+    }
+
+    m_writeCount.store(0, memory_order_relaxed);
+    m_readCount.store(0, memory_order_relaxed);
+    m_droppedCount.store(0, memory_order_relaxed);
+    m_writeError.store(false, memory_order_relaxed);
+    m_encodedFrameCount = 0;
+    m_stopRequested = false;
+    m_writerThread = thread(&XRFlightDataRecorder::WriterThreadMain, this);
+    return true;
+}
+
+void XRFlightDataRecorder::Close()
+{
+    if (m_pFile == nullptr)
+        return;
+
+    {
+        lock_guard<mutex> lock(m_stopMutex);
+        m_stopRequested = true;
+    }
+    m_stopCondition.notify_one();
+    m_writerThread.join();
+
+    fclose(m_pFile);
+    m_pFile = nullptr;
+}
+
+bool XRFlightDataRecorder::Record(const XRFlightDataFrame &frame)
+{
+    const uint64_t writeCount = m_writeCount.load(memory_order_relaxed);
+    if ((writeCount - m_readCount.load(memory_order_acquire)) >= RING_SLOTS)
+    {
+        m_droppedCount.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    m_ring[writeCount & (RING_SLOTS - 1)] = frame;
+    m_writeCount.store(writeCount + 1, memory_order_release);
+    return true;
+}
+
+void XRFlightDataRecorder::WriterThreadMain()
+{
+    bool stop = false;
+    while (!stop)
+    {
+        {
+            unique_lock<mutex> lock(m_stopMutex);
+            m_stopCondition.wait_for(lock, WRITER_THREAD_PERIOD, [this] { return m_stopRequested; });
+            stop = m_stopRequested;
+        }
+        DrainRing();    // on stop, this writes everything that was queued before Close was called
+    }
+    fflush(m_pFile);
+}
+
+// Encode and write every queued frame; invoked only on the writer thread
+void XRFlightDataRecorder::DrainRing()
+{
+    uint64_t readCount = m_readCount.load(memory_order_relaxed);
+    const uint64_t writeCount = m_writeCount.load(memory_order_acquire);
+    for (; readCount < writeCount; readCount++)
+    {
+        const XRFlightDataFrame &frame = m_ring[readCount & (RING_SLOTS - 1)];
+        const bool isKeyframe = ((m_encodedFrameCount % XRFLIGHTDATA_KEYFRAME_INTERVAL) == 0);
+        const size_t size = XRFlightDataEncodeFrame(m_prevFrame, frame, isKeyframe, m_encodeBuffer);
+        m_prevFrame = frame;
+        m_encodedFrameCount++;
+
+        // we are done with the slot once the frame is encoded
+        m_readCount.store(readCount + 1, memory_order_release);
+
+        if (fwrite(m_encodeBuffer, 1, size, m_pFile) != size)
+            m_writeError.store(true, memory_order_relaxed);
+    }
+}
+
+string XRFlightDataRecorder::FindOrbiterRecordingName(const char *pFlightsFolder, const char *pVesselName)
+{
+    const string posFilename = string(pVesselName) + ".pos";
+    string recordingName;
+    fs::file_time_type newestTime;
+    error_code ec;
+    for (const fs::directory_entry &entry : fs::directory_iterator(pFlightsFolder, ec))
+    {
+        if (!entry.is_directory(ec))
+            continue;
+
+        const fs::path posPath = entry.path() / posFilename;
+        const fs::file_time_type writeTime = fs::last_write_time(posPath, ec);
+        if (ec)
+            continue;   // this recording does not include the vessel
+
+        if (recordingName.empty() || (writeTime > newestTime))
+        {
+            recordingName = entry.path().filename().string();
+            newestTime = writeTime;
+        }
+    }
+    return recordingName;
+}
+
+string XRFlightDataRecorder::GetFlightDataFilename(const char *pFlightsFolder, const char *pRecordingName, const char *pVesselName)
+{
+    return (fs::path(pFlightsFolder) / pRecordingName / (string(pVesselName) + XRFLIGHTDATA_FILE_EXTENSION)).string();
+}
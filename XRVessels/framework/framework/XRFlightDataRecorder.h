@@ -0,0 +1,91 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRFlightDataRecorder.h
+// Writes XRFlightDataFrames to a flight data file (see XRFlightData.h).
+//
+// The simulation thread only copies each frame into a single-producer /
+// single-consumer ring; a background thread delta-encodes the frames
+// and writes them to disk, so recording never waits on file I/O.  If
+// the writer thread falls a full ring behind, new frames are dropped
+// and counted rather than blocking the simulation.
+// ==============================================================
+
+#pragma once
+
+#include "XRFlightData.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class XRFlightDataRecorder
+{
+public:
+    XRFlightDataRecorder();
+    virtual ~XRFlightDataRecorder();
+
+    // Create the file and start the writer thread; returns true on success
+    bool Open(const char *pFilename, const char *pVesselName, const double sampleInterval);
+
+    // Stop the writer thread after it has written every queued frame, then close the file
+    void Close();
+
+    bool IsOpen() const { return (m_pFile != nullptr); }
+
+    // Queue one frame for the writer thread; never blocks.  Returns false if the ring was full and the frame was dropped.
+    bool Record(const XRFlightDataFrame &frame);
+
+    uint64_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+    bool HasWriteError() const { return m_writeError.load(std::memory_order_relaxed); }
+
+    static const int RING_SLOTS = 512;      // must be a power of two; ~50 seconds at 10 frames per second
+
+    // Orbiter's flight recorder writes each vessel's trajectory to <flights folder>/<recording name>/<vessel name>.pos.
+    // Returns the name of the recording whose .pos file for pVesselName was written most recently, or an empty string if there is none.
+    static std::string FindOrbiterRecordingName(const char *pFlightsFolder, const char *pVesselName);
+
+    // Returns the flight data filename for pVesselName in the given Orbiter recording: <flights folder>/<recording name>/<vessel name>.xrfd
+    static std::string GetFlightDataFilename(const char *pFlightsFolder, const char *pRecordingName, const char *pVesselName);
+
+protected:
+    void WriterThreadMain();
+    void DrainRing();
+
+    FILE *m_pFile;
+    XRFlightDataFrame m_ring[RING_SLOTS];
+    std::atomic<uint64_t> m_writeCount;     // frames queued; only stored by the simulation thread
+    std::atomic<uint64_t> m_readCount;      // frames taken by the writer thread; only stored by the writer thread
+    std::atomic<uint64_t> m_droppedCount;
+    std::atomic<bool> m_writeError;
+
+    std::thread m_writerThread;
+    std::mutex m_stopMutex;                 // only used to wake the writer thread; Record never touches it
+    std::condition_variable m_stopCondition;
+    bool m_stopRequested;                   // guarded by m_stopMutex
+
+    // owned by the writer thread
+    XRFlightDataFrame m_prevFrame;
+    uint64_t m_encodedFrameCount;
+    uint8_t m_encodeBuffer[XRFLIGHTDATA_MAX_ENCODED_FRAME_SIZE];
+};
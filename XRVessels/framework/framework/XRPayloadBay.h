@@ -87,6 +87,10 @@ public:
     int GetChildCount() const;
 
     int GetSlotCount() const                 { return static_cast<int>(m_allSlotsMap.size()); }
+
+    // Changes whenever RefreshSlotStates finds that the set of attached payload vessels changed; callers may cache
+    // the results of IsChildVesselAttached until this changes.
+    unsigned int GetAttachmentVersion() const { return m_attachmentVersion; }
     VESSEL &GetParentVessel() const          { return m_parentVessel; }
 
     // fuel/lox management
@@ -109,4 +113,6 @@ protected:
     // map of slots numbers -> slot data: key=(int) slot #, value=(XRPayloadBaySlot) data
     HASHMAP_INT_XRPAYLOADBAYSLOT m_allSlotsMap;
     SlotsDrainedFilled m_slotsDrainedFilled;  // only updated by AdjustPropellantMass
+    size_t m_attachmentSignature;             // hash of (slot, child vessel) pairs as of the last RefreshSlotStates
+    unsigned int m_attachmentVersion;         // incremented each time m_attachmentSignature changes
 };
@@ -0,0 +1,75 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRRandom.h
+// Replayable per-vessel random number generator.
+//
+// This is a counter-based SplitMix64 generator: the Nth value is a
+// pure function of (seed, N), so the complete generator state is just
+// those two integers.  Saving them in the scenario file and restoring
+// them on load replays exactly the same sequence of random values,
+// and tests may inject a fixed stream by setting the state directly.
+// ==============================================================
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+class XRRandom
+{
+public:
+    XRRandom(const uint64_t seed = 0) : m_seed(seed), m_counter(0) { }
+
+    void SetState(const uint64_t seed, const uint64_t counter) { m_seed = seed; m_counter = counter; }
+    uint64_t GetSeed() const { return m_seed; }
+    uint64_t GetCounter() const { return m_counter; }   // number of values drawn since the seed was set
+
+    // returns the next uniformly distributed 64-bit value
+    uint64_t NextUInt64() { return Mix(m_seed + (++m_counter * GOLDEN_GAMMA)); }
+
+    // returns the next uniformly distributed value in [0, 1); a drop-in replacement for oapiRand()
+    double NextDouble() { return static_cast<double>(NextUInt64() >> 11) * (1.0 / 9007199254740992.0); }   // 53 random bits / 2^53
+
+    // returns a seed that differs from run to run
+    static uint64_t MakeRandomSeed()
+    {
+        std::random_device rd;
+        const uint64_t entropy = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+        return Mix(entropy ^ static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+    }
+
+protected:
+    static const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    // SplitMix64 output function
+    static uint64_t Mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t m_seed;
+    uint64_t m_counter;
+};
@@ -0,0 +1,107 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRScenarioWriter.cpp
+// Buffered scenario file writer.
+// ==============================================================
+
+#include "XRScenarioWriter.h"
+#include <cassert>
+#include <charconv>
+
+using namespace std;
+
+void XRScenarioWriter::BeginLine(const char *pName)
+{
+    m_buffer += "  ";   // same indent as oapiWriteScenario_*
+    m_buffer += pName;
+}
+
+void XRScenarioWriter::BeginLine(const char *pNamePrefix, const int index)
+{
+    BeginLine(pNamePrefix);
+
+    char buf[16];
+    const to_chars_result result = to_chars(buf, buf + sizeof(buf), index);
+    assert(result.ec == errc());
+    m_buffer.append(buf, result.ptr);
+}
+
+void XRScenarioWriter::AppendString(const char *pValue)
+{
+    AppendSeparator();
+    m_buffer += pValue;
+}
+
+void XRScenarioWriter::AppendInt(const int value)
+{
+    AppendSeparator();
+
+    char buf[16];
+    const to_chars_result result = to_chars(buf, buf + sizeof(buf), value);
+    assert(result.ec == errc());
+    m_buffer.append(buf, result.ptr);
+}
+
+void XRScenarioWriter::AppendUInt64(const uint64_t value)
+{
+    AppendSeparator();
+
+    char buf[24];
+    const to_chars_result result = to_chars(buf, buf + sizeof(buf), value);
+    assert(result.ec == errc());
+    m_buffer.append(buf, result.ptr);
+}
+
+// shortest representation that parses back to exactly the same value
+void XRScenarioWriter::AppendDouble(const double value)
+{
+    AppendSeparator();
+
+    char buf[32];
+    const to_chars_result result = to_chars(buf, buf + sizeof(buf), value);
+    assert(result.ec == errc());
+    m_buffer.append(buf, result.ptr);
+}
+
+// identical to sprintf("%.Nf", value)
+void XRScenarioWriter::AppendFixed(const double value, const int decimals)
+{
+    AppendSeparator();
+
+    char buf[352];  // large enough for DBL_MAX in fixed notation with a handful of decimals
+    const to_chars_result result = to_chars(buf, buf + sizeof(buf), value, chars_format::fixed, decimals);
+    assert(result.ec == errc());
+    m_buffer.append(buf, result.ptr);
+}
+
+void XRScenarioWriter::Flush(FILEHANDLE scn)
+{
+    if (m_buffer.empty())
+        return;
+
+    // oapiWriteLine appends its own newline to the final line
+    assert(m_buffer.back() == '\n');
+    m_buffer.back() = 0;
+    oapiWriteLine(scn, &m_buffer[0]);
+    m_buffer.clear();
+}
@@ -0,0 +1,72 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRScenarioWriter.h
+// Buffers scenario lines in the same "  NAME value" layout that
+// oapiWriteScenario_* produces and writes them to the scenario file
+// in a single call.  Floating-point values are formatted with
+// std::to_chars: WriteDouble/AppendDouble emit the shortest text that
+// reads back to the identical double, while the *Fixed variants match
+// printf's "%.Nf" output byte-for-byte.
+// ==============================================================
+
+#pragma once
+
+#include "Orbitersdk.h"
+#include <cstdint>
+#include <string>
+
+class XRScenarioWriter
+{
+public:
+    XRScenarioWriter(const size_t initialCapacity = 8192) { m_buffer.reserve(initialCapacity); }
+
+    // single-value lines
+    void WriteString(const char *pName, const char *pValue) { BeginLine(pName); AppendString(pValue); EndLine(); }
+    void WriteInt(const char *pName, const int value) { BeginLine(pName); AppendInt(value); EndLine(); }
+    void WriteDouble(const char *pName, const double value) { BeginLine(pName); AppendDouble(value); EndLine(); }
+    void WriteFixed(const char *pName, const double value, const int decimals) { BeginLine(pName); AppendFixed(value, decimals); EndLine(); }
+
+    // multi-value lines: BeginLine, then one or more Append* calls, then EndLine
+    void BeginLine(const char *pName);
+    void BeginLine(const char *pNamePrefix, const int index);   // e.g., "DMG_", 3 -> "DMG_3"
+    void AppendString(const char *pValue);
+    void AppendInt(const int value);
+    void AppendUInt64(const uint64_t value);
+    void AppendDouble(const double value);
+    void AppendFixed(const double value, const int decimals);
+    void EndLine() { m_buffer += '\n'; }
+
+    // Write all buffered lines to the scenario file and empty the buffer; the buffer's capacity is retained for the next save.
+    void Flush(FILEHANDLE scn);
+
+    bool IsEmpty() const { return m_buffer.empty(); }
+
+protected:
+    void AppendSeparator()
+    {
+        // every value is preceded by a single space, which also separates the first value from the name
+        m_buffer += ' ';
+    }
+
+    std::string m_buffer;
+};
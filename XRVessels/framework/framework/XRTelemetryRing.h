@@ -0,0 +1,321 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRTelemetryRing.h
+// Fixed-layout telemetry record and a single-producer / single-consumer
+// ring buffer in POSIX shared memory.  The vessel publishes one record per
+// frame via XRTelemetryRingWriter; external processes (dashboards, flight
+// data recorders, etc.) consume them via XRTelemetryRingReader.
+//
+// This header has no Orbiter dependencies so that out-of-process readers
+// can include it as-is.
+//
+// Each slot is guarded by its own sequence counter (a seqlock): the writer
+// never waits on a reader, and a reader that falls more than one ring behind
+// simply skips ahead to the oldest record still in the buffer.
+// ==============================================================
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define XRTELEMETRY_RING_MAGIC      0x58525452u     // 'XRTR'
+#define XRTELEMETRY_RING_VERSION    1
+#define XRTELEMETRY_RING_SLOTS      256             // must be a power of two; ~4 seconds at 60 fps
+#define XRTELEMETRY_RING_NAME_PREFIX "/XRTelemetry."
+
+// One record per frame.  Only fixed-size POD fields so the layout is identical in every process.
+// NOTE: new fields will only ever be appended to the end of this structure.
+struct XRTelemetryRecord
+{
+    uint64_t FrameSequence;     // VESSEL3_EXT frame number this record was built from
+    double   SimTime;           // absolute simulation time in seconds
+    double   MJD;
+
+    // flight data
+    double   Altitude;          // meters
+    double   Airspeed;          // m/s
+    double   Groundspeed;       // m/s
+    double   VerticalSpeed;     // m/s
+    double   Mach;
+    double   DynamicPressure;   // pascals
+    double   StaticPressure;    // pascals
+    double   Pitch;             // radians
+    double   Bank;              // radians
+    double   Yaw;               // radians
+    double   AOA;               // radians
+    double   SlipAngle;         // radians
+    double   Mass;              // kg
+
+    // engines; indexed by XREngineID, -1 = engine not supported by this vessel
+    double   ThrottleLevel[8];
+    double   Thrust[8];         // kN
+
+    // consumables; 0 <= n <= 1.0 (-1 = not supported)
+    double   MainFuelLevel;
+    double   SCRAMFuelLevel;
+    double   RCSFuelLevel;
+    double   APUFuelLevel;
+    double   LOXLevel;
+
+    // temperatures
+    double   NoseconeTemp;      // Kelvin
+    double   LeftWingTemp;      // Kelvin
+    double   RightWingTemp;     // Kelvin
+    double   CockpitTemp;       // Kelvin
+    double   TopHullTemp;       // Kelvin
+    double   CoolantTemp;       // degrees C
+
+    // indexed by XRDoorID; the integer value of the XRDoorState enum
+    int32_t  DoorStates[15];
+    int32_t  MasterWarning;     // 1 = master warning active
+};
+
+// Lives at offset 0 of the shared memory segment; followed by XRTELEMETRY_RING_SLOTS slots.
+struct XRTelemetryRingHeader
+{
+    uint32_t Magic;             // XRTELEMETRY_RING_MAGIC once the writer has initialized the segment
+    uint32_t Version;           // XRTELEMETRY_RING_VERSION
+    uint32_t RecordSize;        // sizeof(XRTelemetryRecord) as compiled by the writer
+    uint32_t SlotCount;         // XRTELEMETRY_RING_SLOTS
+    std::atomic<uint64_t> WriteCount;  // total number of records published; the newest is in slot (WriteCount - 1) % SlotCount
+};
+
+struct XRTelemetryRingSlot
+{
+    // seqlock: odd while the writer is updating the record; (2 * n) + 2 once record #n is complete
+    std::atomic<uint64_t> Sequence;
+    XRTelemetryRecord     Record;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory ring requires lock-free 64-bit atomics");
+
+// Build the shared memory object name for the supplied vessel name; POSIX names may not contain a '/' after the leading one.
+inline void XRTelemetryRingName(const char *pVesselName, char *pNameOut, const size_t nameOutSize)
+{
+    snprintf(pNameOut, nameOutSize, XRTELEMETRY_RING_NAME_PREFIX "%s", pVesselName);
+    for (char *p = pNameOut + 1; *p; p++)
+    {
+        if (*p == '/')
+            *p = '_';
+    }
+}
+
+inline size_t XRTelemetryRingSize()
+{
+    return sizeof(XRTelemetryRingHeader) + (XRTELEMETRY_RING_SLOTS * sizeof(XRTelemetryRingSlot));
+}
+
+//-------------------------------------------------------------------------
+
+// Producer side; used by the vessel.  Only one writer may exist for a given name.
+class XRTelemetryRingWriter
+{
+public:
+    XRTelemetryRingWriter() : m_pHeader(nullptr), m_pSlots(nullptr), m_writeCount(0) { m_name[0] = 0; }
+    virtual ~XRTelemetryRingWriter() { Close(); }
+
+    // Create (or re-create) the shared memory segment; returns true on success
+    bool Open(const char *pVesselName)
+    {
+        Close();
+        XRTelemetryRingName(pVesselName, m_name, sizeof(m_name));
+
+        const int fd = shm_open(m_name, O_CREAT | O_RDWR, 0644);
+        if (fd < 0)
+            return false;
+
+        const size_t size = XRTelemetryRingSize();
+        void *pMem = MAP_FAILED;
+        if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+            pMem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);  // the mapping keeps the segment alive
+
+        if (pMem == MAP_FAILED)
+        {
+            shm_unlink(m_name);
+            return false;
+        }
+
+        // Magic goes in last so a reader never sees a half-initialized header
+        memset(pMem, 0, size);
+        m_pHeader = static_cast<XRTelemetryRingHeader *>(pMem);
+        m_pSlots = reinterpret_cast<XRTelemetryRingSlot *>(m_pHeader + 1);
+        m_pHeader->Version = XRTELEMETRY_RING_VERSION;
+        m_pHeader->RecordSize = sizeof(XRTelemetryRecord);
+        m_pHeader->SlotCount = XRTELEMETRY_RING_SLOTS;
+        m_pHeader->WriteCount.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_pHeader->Magic = XRTELEMETRY_RING_MAGIC;
+        m_writeCount = 0;
+        return true;
+    }
+
+    // Unmap and remove the segment; readers that still have it mapped keep their (now stale) copy
+    void Close()
+    {
+        if (m_pHeader != nullptr)
+        {
+            munmap(m_pHeader, XRTelemetryRingSize());
+            shm_unlink(m_name);
+            m_pHeader = nullptr;
+            m_pSlots = nullptr;
+        }
+    }
+
+    bool IsOpen() const { return (m_pHeader != nullptr); }
+
+    // Publish one record; never blocks
+    void Publish(const XRTelemetryRecord &record)
+    {
+        XRTelemetryRingSlot &slot = m_pSlots[m_writeCount & (XRTELEMETRY_RING_SLOTS - 1)];
+        const uint64_t seq = m_writeCount * 2;
+
+        slot.Sequence.store(seq + 1, std::memory_order_relaxed);   // mark busy
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.Record = record;
+        slot.Sequence.store(seq + 2, std::memory_order_release);   // mark complete
+
+        m_writeCount++;
+        m_pHeader->WriteCount.store(m_writeCount, std::memory_order_release);
+    }
+
+protected:
+    char m_name[256];
+    XRTelemetryRingHeader *m_pHeader;
+    XRTelemetryRingSlot *m_pSlots;
+    uint64_t m_writeCount;      // private copy so we never have to read back from shared memory
+};
+
+//-------------------------------------------------------------------------
+
+// Consumer side; any number of readers may attach to the same segment, each with its own read position.
+class XRTelemetryRingReader
+{
+public:
+    enum class ReadResult { Record, NoData, NotOpen };
+
+    XRTelemetryRingReader() : m_pHeader(nullptr), m_pSlots(nullptr), m_readCount(0), m_droppedCount(0) { }
+    virtual ~XRTelemetryRingReader() { Close(); }
+
+    // Attach to the ring published by the named vessel; returns false if the vessel is not exporting telemetry
+    bool Open(const char *pVesselName)
+    {
+        Close();
+        char name[256];
+        XRTelemetryRingName(pVesselName, name, sizeof(name));
+
+        const int fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0)
+            return false;
+
+        const size_t size = XRTelemetryRingSize();
+        struct stat st;
+        void *pMem = MAP_FAILED;
+        if ((fstat(fd, &st) == 0) && (static_cast<size_t>(st.st_size) >= size))
+            pMem = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (pMem == MAP_FAILED)
+            return false;
+
+        m_pHeader = static_cast<XRTelemetryRingHeader *>(pMem);
+        if ((m_pHeader->Magic != XRTELEMETRY_RING_MAGIC) || (m_pHeader->Version != XRTELEMETRY_RING_VERSION) ||
+            (m_pHeader->RecordSize != sizeof(XRTelemetryRecord)) || (m_pHeader->SlotCount != XRTELEMETRY_RING_SLOTS))
+        {
+            Close();    // writer not initialized yet or built against a different layout
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        m_pSlots = reinterpret_cast<const XRTelemetryRingSlot *>(m_pHeader + 1);
+        m_readCount = m_pHeader->WriteCount.load(std::memory_order_acquire);  // start with the next new record
+        m_droppedCount = 0;
+        return true;
+    }
+
+    void Close()
+    {
+        if (m_pHeader != nullptr)
+        {
+            munmap(const_cast<XRTelemetryRingHeader *>(m_pHeader), XRTelemetryRingSize());
+            m_pHeader = nullptr;
+            m_pSlots = nullptr;
+        }
+    }
+
+    bool IsOpen() const { return (m_pHeader != nullptr); }
+
+    // Copy the next unread record into recordOut.  Returns NoData if we have caught up with the writer.
+    ReadResult ReadNext(XRTelemetryRecord &recordOut)
+    {
+        if (m_pHeader == nullptr)
+            return ReadResult::NotOpen;
+
+        for (;;)
+        {
+            const uint64_t writeCount = m_pHeader->WriteCount.load(std::memory_order_acquire);
+            if (m_readCount >= writeCount)
+                return ReadResult::NoData;
+
+            // if the writer has lapped us, skip ahead to the oldest record still in the ring
+            if ((writeCount - m_readCount) > XRTELEMETRY_RING_SLOTS)
+            {
+                m_droppedCount += (writeCount - XRTELEMETRY_RING_SLOTS) - m_readCount;
+                m_readCount = writeCount - XRTELEMETRY_RING_SLOTS;
+            }
+
+            const XRTelemetryRingSlot &slot = m_pSlots[m_readCount & (XRTELEMETRY_RING_SLOTS - 1)];
+            const uint64_t expectedSeq = (m_readCount * 2) + 2;
+            if (slot.Sequence.load(std::memory_order_acquire) == expectedSeq)
+            {
+                memcpy(&recordOut, &slot.Record, sizeof(recordOut));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.Sequence.load(std::memory_order_relaxed) == expectedSeq)
+                {
+                    m_readCount++;
+                    return ReadResult::Record;
+                }
+            }
+
+            // the writer overwrote this slot while we were reading it; loop around and resync
+            m_droppedCount++;
+            m_readCount++;
+        }
+    }
+
+    // Number of records skipped because this reader fell too far behind
+    uint64_t GetDroppedCount() const { return m_droppedCount; }
+
+protected:
+    const XRTelemetryRingHeader *m_pHeader;
+    const XRTelemetryRingSlot *m_pSlots;
+    uint64_t m_readCount;
+    uint64_t m_droppedCount;
+};
@@ -0,0 +1,894 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRVCScriptEngine.cpp
+// Portable compiler and interpreter for XRVesselCtrl (.xrvc) scripts.
+// ==============================================================
+
+#include "XRVCScriptEngine.h"
+#include <cassert>
+#include <cctype>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <limits>
+#include <strings.h>
+
+using namespace std;
+
+//-------------------------------------------------------------------------
+// Symbol tables; these mirror the XRVesselCtrlDemo parser tree exactly.
+// All lookups are case-insensitive.
+//-------------------------------------------------------------------------
+
+struct EngineTarget { const char *pName; XREngineID engine1; XREngineID engine2; };
+static const EngineTarget s_engineTargets[] =
+{
+    { "MainBoth",   XREngineID::XRE_MainLeft,   XREngineID::XRE_MainRight  },
+    { "MainLeft",   XREngineID::XRE_MainLeft,   XREngineID::XRE_MainLeft   },
+    { "MainRight",  XREngineID::XRE_MainRight,  XREngineID::XRE_MainRight  },
+    { "HoverBoth",  XREngineID::XRE_HoverFore,  XREngineID::XRE_HoverAft   },
+    { "HoverFore",  XREngineID::XRE_HoverFore,  XREngineID::XRE_HoverFore  },
+    { "HoverAft",   XREngineID::XRE_HoverAft,   XREngineID::XRE_HoverAft   },
+    { "ScramBoth",  XREngineID::XRE_ScramLeft,  XREngineID::XRE_ScramRight },
+    { "ScramLeft",  XREngineID::XRE_ScramLeft,  XREngineID::XRE_ScramLeft  },
+    { "ScramRight", XREngineID::XRE_ScramRight, XREngineID::XRE_ScramRight },
+    { "RetroBoth",  XREngineID::XRE_RetroLeft,  XREngineID::XRE_RetroRight },
+    { "RetroLeft",  XREngineID::XRE_RetroLeft,  XREngineID::XRE_RetroLeft  },
+    { "RetroRight", XREngineID::XRE_RetroRight, XREngineID::XRE_RetroRight },
+};
+
+struct EngineField { const char *pName; uint16_t offset; bool isBool; double minValue; double maxValue; };
+#define ENGINE_FIELD_DBL(FIELD, MIN, MAX) { #FIELD, static_cast<uint16_t>(offsetof(XREngineStateWrite, FIELD)), false, MIN, MAX }
+#define ENGINE_FIELD_BOOL(FIELD)          { #FIELD, static_cast<uint16_t>(offsetof(XREngineStateWrite, FIELD)), true, 0, 0 }
+static const EngineField s_engineFields[] =
+{
+    ENGINE_FIELD_DBL(ThrottleLevel, 0.0, 1.0),
+    ENGINE_FIELD_DBL(GimbalX, -1.0, 1.0),
+    ENGINE_FIELD_DBL(GimbalY, -1.0, 1.0),
+    ENGINE_FIELD_DBL(Balance, -1.0, 1.0),
+    ENGINE_FIELD_BOOL(CenteringModeX),
+    ENGINE_FIELD_BOOL(CenteringModeY),
+    ENGINE_FIELD_BOOL(CenteringModeBalance),
+    ENGINE_FIELD_BOOL(AutoMode),
+    ENGINE_FIELD_BOOL(DivergentMode),
+};
+
+struct NamedID { const char *pName; int id; };
+#define DOOR_ENTRY(ID)  { #ID, static_cast<int>(XRDoorID::XRD_##ID) }
+static const NamedID s_doors[] =
+{
+    DOOR_ENTRY(DockingPort), DOOR_ENTRY(ScramDoors), DOOR_ENTRY(HoverDoors), DOOR_ENTRY(Ladder), DOOR_ENTRY(Gear),
+    DOOR_ENTRY(RetroDoors), DOOR_ENTRY(OuterAirlock), DOOR_ENTRY(InnerAirlock), DOOR_ENTRY(AirlockChamber),
+    DOOR_ENTRY(CrewHatch), DOOR_ENTRY(Radiator), DOOR_ENTRY(Speedbrake), DOOR_ENTRY(APU),
+    DOOR_ENTRY(CrewElevator), DOOR_ENTRY(PayloadBayDoors),
+};
+
+static const NamedID s_doorStates[] =
+{
+    { "opening", static_cast<int>(XRDoorState::XRDS_Opening) },
+    { "open",    static_cast<int>(XRDoorState::XRDS_Open)    },
+    { "closing", static_cast<int>(XRDoorState::XRDS_Closing) },
+    { "closed",  static_cast<int>(XRDoorState::XRDS_Closed)  },
+};
+
+static const NamedID s_lights[] =
+{
+    { "Nav",    static_cast<int>(XRLight::XRL_Nav)    },
+    { "Beacon", static_cast<int>(XRLight::XRL_Beacon) },
+    { "Strobe", static_cast<int>(XRLight::XRL_Strobe) },
+};
+
+#define STDAP_ENTRY(ID) { #ID, static_cast<int>(XRStdAutopilot::XRSAP_##ID) }
+static const NamedID s_stdAutopilots[] =
+{
+    STDAP_ENTRY(KillRot), STDAP_ENTRY(Prograde), STDAP_ENTRY(Retrograde), STDAP_ENTRY(Normal),
+    STDAP_ENTRY(AntiNormal), STDAP_ENTRY(LevelHorizon), STDAP_ENTRY(Hover),
+};
+
+struct OtherCommand { const char *pName; XRVCScriptEngine::Opcode op; int limitLow; int limitHigh; };
+static const OtherCommand s_otherCommands[] =
+{
+    { "SecondaryHUDMode",      XRVCScriptEngine::Opcode::SecondaryHUDMode,      0, 5 },
+    { "SetTertiaryHUDState",   XRVCScriptEngine::Opcode::TertiaryHUDState,      0, 1 },
+    { "RCSDockingMode",        XRVCScriptEngine::Opcode::RCSDockingMode,        0, 1 },
+    { "ElevatorEVAPortActive", XRVCScriptEngine::Opcode::ElevatorEVAPortActive, 0, 1 },
+};
+
+struct DamageField { const char *pName; uint16_t offset; bool isDamageState; };
+#define DAMAGE_FIELD_DBL(FIELD) { #FIELD, static_cast<uint16_t>(offsetof(XRSystemStatusWrite, FIELD)), false }
+#define DAMAGE_FIELD_INT(FIELD) { #FIELD, static_cast<uint16_t>(offsetof(XRSystemStatusWrite, FIELD)), true }
+static const DamageField s_damageFields[] =
+{
+    DAMAGE_FIELD_DBL(LeftWing), DAMAGE_FIELD_DBL(RightWing),
+    DAMAGE_FIELD_DBL(LeftMainEngine), DAMAGE_FIELD_DBL(RightMainEngine),
+    DAMAGE_FIELD_DBL(LeftSCRAMEngine), DAMAGE_FIELD_DBL(RightSCRAMEngine),
+    DAMAGE_FIELD_DBL(ForeHoverEngine), DAMAGE_FIELD_DBL(AftHoverEngine),
+    DAMAGE_FIELD_DBL(LeftRetroEngine), DAMAGE_FIELD_DBL(RightRetroEngine),
+    DAMAGE_FIELD_DBL(ForwardLowerRCS), DAMAGE_FIELD_DBL(AftUpperRCS),
+    DAMAGE_FIELD_DBL(ForwardUpperRCS), DAMAGE_FIELD_DBL(AftLowerRCS),
+    DAMAGE_FIELD_DBL(ForwardStarboardRCS), DAMAGE_FIELD_DBL(AftPortRCS),
+    DAMAGE_FIELD_DBL(ForwardPortRCS), DAMAGE_FIELD_DBL(AftStarboardRCS),
+    DAMAGE_FIELD_DBL(OutboardUpperPortRCS), DAMAGE_FIELD_DBL(OutboardLowerStarboardRCS),
+    DAMAGE_FIELD_DBL(OutboardUpperStarboardRCS), DAMAGE_FIELD_DBL(OutboardLowerPortRCS),
+    DAMAGE_FIELD_DBL(AftRCS), DAMAGE_FIELD_DBL(ForwardRCS),
+    DAMAGE_FIELD_INT(LeftAileron), DAMAGE_FIELD_INT(RightAileron),
+    DAMAGE_FIELD_INT(LandingGear), DAMAGE_FIELD_INT(DockingPort),
+    DAMAGE_FIELD_INT(RetroDoors), DAMAGE_FIELD_INT(TopHatch),
+    DAMAGE_FIELD_INT(Radiator), DAMAGE_FIELD_INT(Speedbrake),
+    DAMAGE_FIELD_INT(PayloadBayDoors), DAMAGE_FIELD_INT(CrewElevator),
+};
+
+// Returns a pointer to the table entry whose pName matches pToken (case-insensitive), or nullptr if none.
+template <typename T, int N>
+static const T *FindSymbol(const T (&table)[N], const char *pToken)
+{
+    for (int i = 0; i < N; i++)
+    {
+        if (strcasecmp(table[i].pName, pToken) == 0)
+            return table + i;
+    }
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------
+
+XRVCScriptEngine::XRVCScriptEngine() :
+    m_programCounter(0), m_failedCount(0), m_lastFailedLine(-1)
+{
+    *m_statusBuffer = 0;
+}
+
+void XRVCScriptEngine::Clear()
+{
+    m_program.clear();
+    m_errorMsg.clear();
+    m_programCounter = 0;
+    m_failedCount = 0;
+    m_lastFailedLine = -1;
+}
+
+bool XRVCScriptEngine::CompileFile(const char *pFilename)
+{
+    const size_t originalSize = m_program.size();
+    m_errorMsg.clear();
+    const bool success = CompileFileImpl(pFilename, 0);
+    if (!success)
+        m_program.resize(originalSize);   // roll back any partially-compiled instructions
+
+    return success;
+}
+
+bool XRVCScriptEngine::CompileText(const char *pText, const char *pSourceName)
+{
+    assert(pText != nullptr);
+
+    const size_t originalSize = m_program.size();
+    m_errorMsg.clear();
+
+    char line[MAX_LINE_LENGTH];
+    int lineNumber = 0;
+    const char *pLineStart = pText;
+    while (*pLineStart)
+    {
+        lineNumber++;
+        const char *pLineEnd = strchr(pLineStart, '\n');
+        const size_t len = (pLineEnd != nullptr) ? static_cast<size_t>(pLineEnd - pLineStart) : strlen(pLineStart);
+        if (len >= sizeof(line))
+        {
+            char msg[256];
+            snprintf(msg, sizeof(msg), "%s(%d): Line too long (max %d characters).", pSourceName, lineNumber, MAX_LINE_LENGTH - 1);
+            m_errorMsg = msg;
+            m_program.resize(originalSize);
+            return false;
+        }
+        memcpy(line, pLineStart, len);
+        line[len] = 0;
+
+        if (!CompileLine(line, lineNumber, pSourceName, 0))
+        {
+            m_program.resize(originalSize);
+            return false;
+        }
+
+        if (pLineEnd == nullptr)
+            break;
+        pLineStart = pLineEnd + 1;
+    }
+    return true;
+}
+
+// Compiles the supplied file, recursing for any Runscript commands; does not roll back on error.
+bool XRVCScriptEngine::CompileFileImpl(const char *pFilename, const int includeDepth)
+{
+    FILE *pFile = fopen(pFilename, "rt");
+    if (pFile == nullptr)
+    {
+        m_errorMsg = "Could not open script file '";
+        m_errorMsg += pFilename;
+        m_errorMsg += "'.";
+        return false;
+    }
+
+    bool success = true;
+    char buffer[MAX_LINE_LENGTH];
+    int lineNumber = 0;
+    while (fgets(buffer, sizeof(buffer), pFile) != nullptr)
+    {
+        lineNumber++;
+
+        // fgets stops at a full buffer; unless the next character ends the line, the rest of this line would be read as a separate command
+        if (strchr(buffer, '\n') == nullptr)
+        {
+            const int nextChar = fgetc(pFile);
+            if ((nextChar != EOF) && (nextChar != '\n'))
+            {
+                char msg[512];
+                snprintf(msg, sizeof(msg), "%s(%d): Line too long (max %d characters).", pFilename, lineNumber, MAX_LINE_LENGTH - 1);
+                m_errorMsg = msg;
+                success = false;
+                break;
+            }
+        }
+
+        if (!(success = CompileLine(buffer, lineNumber, pFilename, includeDepth)))
+            break;
+    }
+
+    if (success && !feof(pFile))
+    {
+        m_errorMsg = "Error reading script file '";
+        m_errorMsg += pFilename;
+        m_errorMsg += "'.";
+        success = false;
+    }
+
+    fclose(pFile);
+    return success;
+}
+
+// Split pLine in-place into whitespace-delimited tokens.  Returns the token count, or -1 if there are too many tokens.
+int XRVCScriptEngine::Tokenize(char *pLine, char **argvOut, const int maxTokens)
+{
+    int argc = 0;
+    char *p = pLine;
+    for (;;)
+    {
+        while (isspace(static_cast<unsigned char>(*p)))
+            p++;
+        if (*p == 0)
+            break;
+
+        if (argc == maxTokens)
+            return -1;
+        argvOut[argc++] = p;
+
+        while (*p && !isspace(static_cast<unsigned char>(*p)))
+            p++;
+        if (*p == 0)
+            break;
+        *p++ = 0;   // terminate this token
+    }
+    return argc;
+}
+
+// Compile a single script line and append it to m_program.  Empty lines and lines starting with '#' are ignored.
+// Returns true on success, false on error (m_errorMsg is set).
+bool XRVCScriptEngine::CompileLine(char *pLine, const int lineNumber, const char *pSourceName, const int includeDepth)
+{
+    char *argv[MAX_TOKENS];
+    const int argc = Tokenize(pLine, argv, MAX_TOKENS);
+    if (argc == 0)
+        return true;   // empty line
+    if (*argv[0] == '#')
+        return true;   // comment line
+
+    *m_statusBuffer = 0;
+    bool success;
+    Instruction instr = { };
+    instr.LineNumber = lineNumber;
+
+    if (argc < 0)
+    {
+        SetError("Too many arguments (max %d tokens).", MAX_TOKENS);
+        success = false;
+    }
+    else if (strcasecmp(argv[0], "Set") == 0)
+    {
+        success = CompileSet(argv + 1, argc - 1, instr);
+    }
+    else if (strcasecmp(argv[0], "Reset") == 0)
+    {
+        success = CompileReset(argv + 1, argc - 1, instr);
+    }
+    else if (strcasecmp(argv[0], "ShiftCenterOfGravity") == 0)
+    {
+        // limits are vessel-specific, so do not limit them here
+        instr.Op = Opcode::ShiftCenterOfGravity;
+        success = ValidateArgumentCount(argc - 1, 1, 1) &&
+            ParseValidatedDouble(argv[1], instr.Arg[0], -numeric_limits<double>::max(), numeric_limits<double>::max());
+    }
+    else if (strcasecmp(argv[0], "Runscript") == 0)
+    {
+        // nested scripts are compiled inline
+        if (!ValidateArgumentCount(argc - 1, 1, 1))
+            success = false;
+        else if (includeDepth >= MAX_INCLUDE_DEPTH)
+        {
+            SetError("Runscript nested too deeply (max %d levels).", MAX_INCLUDE_DEPTH);
+            success = false;
+        }
+        else
+        {
+            if (!CompileFileImpl(argv[1], includeDepth + 1))
+            {
+                // m_errorMsg already describes the nested failure; add where it was included from
+                char msg[256];
+                snprintf(msg, sizeof(msg), "\n  included from %s(%d)", pSourceName, lineNumber);
+                m_errorMsg += msg;
+                return false;
+            }
+            return true;   // no instruction for this line itself
+        }
+    }
+    else
+    {
+        SetError("Invalid command token: [%s]", argv[0]);
+        success = false;
+    }
+
+    if (!success)
+    {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "%s(%d): ", pSourceName, lineNumber);
+        m_errorMsg = msg;
+        m_errorMsg += m_statusBuffer;
+        return false;
+    }
+
+    m_program.push_back(instr);
+    return true;
+}
+
+// Set <Engine | Door | Light | StdAutopilot | XRAutopilot | DamageState | Other> ...
+bool XRVCScriptEngine::CompileSet(const char * const *argv, const int argc, Instruction &instr)
+{
+    if (argc < 1)
+    {
+        SetError("Required token missing; options are: Engine Door Light StdAutopilot XRAutopilot DamageState Other");
+        return false;
+    }
+
+    const char *pGroup = argv[0];
+    if (strcasecmp(pGroup, "Engine") == 0)
+    {
+        if (argc < 3)
+        {
+            SetError("Required token missing: Set Engine <engine> <field> <value>");
+            return false;
+        }
+        const EngineTarget *pTarget = FindSymbol(s_engineTargets, argv[1]);
+        if (pTarget == nullptr)
+        {
+            SetError("Invalid command token: [%s]", argv[1]);
+            return false;
+        }
+        const EngineField *pField = FindSymbol(s_engineFields, argv[2]);
+        if (pField == nullptr)
+        {
+            SetError("Invalid command token: [%s]", argv[2]);
+            return false;
+        }
+        if (!ValidateArgumentCount(argc - 3, 1, 1))
+            return false;
+
+        instr.ID1 = static_cast<uint8_t>(pTarget->engine1);
+        instr.ID2 = static_cast<uint8_t>(pTarget->engine2);
+        instr.FieldOffset = pField->offset;
+        if (pField->isBool)
+        {
+            bool state;
+            if (!ParseValidatedBool(argv[3], state))
+                return false;
+            instr.Op = Opcode::EngineBool;
+            instr.Flags = (state ? INSTR_ON : 0);
+            return true;
+        }
+        instr.Op = Opcode::EngineDouble;
+        return ParseValidatedDouble(argv[3], instr.Arg[0], pField->minValue, pField->maxValue);
+    }
+
+    if (strcasecmp(pGroup, "Door") == 0)
+    {
+        if (argc < 2)
+        {
+            SetError("Required token missing: Set Door <door> <state>");
+            return false;
+        }
+        const NamedID *pDoor = FindSymbol(s_doors, argv[1]);
+        if (pDoor == nullptr)
+        {
+            SetError("Invalid command token: [%s]", argv[1]);
+            return false;
+        }
+        if (!ValidateArgumentCount(argc - 2, 1, 1))
+            return false;
+        const NamedID *pState = FindSymbol(s_doorStates, argv[2]);
+        if (pState == nullptr)
+        {
+            SetError("Invalid door state: '%s'", argv[2]);
+            return false;
+        }
+        instr.Op = Opcode::DoorState;
+        instr.ID1 = instr.ID2 = static_cast<uint8_t>(pDoor->id);
+        instr.Arg[0] = pState->id;
+        return true;
+    }
+
+    // Light and StdAutopilot share the same <name> <on/off> form
+    const bool isLight = (strcasecmp(pGroup, "Light") == 0);
+    if (isLight || (strcasecmp(pGroup, "StdAutopilot") == 0))
+    {
+        if (argc < 2)
+        {
+            SetError("Required token missing: Set %s <name> <on/off>", pGroup);
+            return false;
+        }
+        const NamedID *pEntry = (isLight ? FindSymbol(s_lights, argv[1]) : FindSymbol(s_stdAutopilots, argv[1]));
+        if (pEntry == nullptr)
+        {
+            SetError("Invalid command token: [%s]", argv[1]);
+            return false;
+        }
+        bool state;
+        if (!ValidateArgumentCount(argc - 2, 1, 1) || !ParseValidatedBool(argv[2], state))
+            return false;
+        instr.Op = (isLight ? Opcode::ExteriorLight : Opcode::StdAutopilot);
+        instr.ID1 = instr.ID2 = static_cast<uint8_t>(pEntry->id);
+        instr.Flags = (state ? INSTR_ON : 0);
+        return true;
+    }
+
+    if (strcasecmp(pGroup, "XRAutopilot") == 0)
+        return CompileXRAutopilot(argv + 1, argc - 1, instr);
+
+    if (strcasecmp(pGroup, "DamageState") == 0)
+    {
+        if (argc < 2)
+        {
+            SetError("Required token missing: Set DamageState <system> <value>");
+            return false;
+        }
+        const DamageField *pField = FindSymbol(s_damageFields, argv[1]);
+        if (pField == nullptr)
+        {
+            SetError("Invalid command token: [%s]", argv[1]);
+            return false;
+        }
+        if (!ValidateArgumentCount(argc - 2, 1, 1))
+            return false;
+
+        instr.FieldOffset = pField->offset;
+        if (pField->isDamageState)
+        {
+            instr.Op = Opcode::DamageState;
+            if (strcasecmp(argv[2], "offline") == 0)
+                instr.Arg[0] = static_cast<int>(XRDamageState::XRDMG_offline);
+            else if (strcasecmp(argv[2], "online") == 0)
+                instr.Arg[0] = static_cast<int>(XRDamageState::XRDMG_online);
+            else
+            {
+                SetError("Invalid parameter: '%s'", argv[2]);
+                return false;
+            }
+            return true;
+        }
+        instr.Op = Opcode::DamageDouble;
+        return ParseValidatedDouble(argv[2], instr.Arg[0], 0.0, 1.0);
+    }
+
+    if (strcasecmp(pGroup, "Other") == 0)
+    {
+        if (argc < 2)
+        {
+            SetError("Required token missing: Set Other <setting> <value>");
+            return false;
+        }
+        const OtherCommand *pCommand = FindSymbol(s_otherCommands, argv[1]);
+        if (pCommand == nullptr)
+        {
+            SetError("Invalid command token: [%s]", argv[1]);
+            return false;
+        }
+        if (!ValidateArgumentCount(argc - 2, 1, 1))
+            return false;
+
+        // boolean settings accept on/off as well as 0/1
+        int value;
+        bool state;
+        if ((pCommand->limitHigh == 1) && ParseValidatedBool(argv[2], state))
+            value = (state ? 1 : 0);
+        else if (!ParseValidatedInt(argv[2], value, pCommand->limitLow, pCommand->limitHigh))
+            return false;
+
+        instr.Op = pCommand->op;
+        instr.Arg[0] = value;
+        return true;
+    }
+
+    SetError("Invalid command token: [%s]", pGroup);
+    return false;
+}
+
+// Set XRAutopilot AttitudeHold <on/off> [<Pitch/AoA> <pitch> <bank>]
+// Set XRAutopilot DescentHold <on/off> [<rate> <autoland>]
+// Set XRAutopilot AirspeedHold <on/off> [<airspeed>]
+bool XRVCScriptEngine::CompileXRAutopilot(const char * const *argv, const int argc, Instruction &instr)
+{
+    if (argc < 1)
+    {
+        SetError("Required token missing; options are: AttitudeHold DescentHold AirspeedHold");
+        return false;
+    }
+
+    const char *pName = argv[0];
+    const int paramCount = argc - 1;
+    const char * const *params = argv + 1;
+    bool isOn;
+    if (strcasecmp(pName, "AttitudeHold") == 0)
+    {
+        if (!ValidateArgumentCount(paramCount, 1, 4) || !ParseValidatedBool(params[0], isOn))
+            return false;
+        instr.Op = Opcode::AttitudeHold;
+        if (paramCount > 1)
+        {
+            if (paramCount != 4)
+            {
+                SetError("Invalid number of paramters: must have either 1 or 4 parameters.");
+                return false;
+            }
+            if (strcasecmp(params[1], "pitch") == 0)
+                instr.Flags |= INSTR_HOLD_PITCH;
+            else if (strcasecmp(params[1], "aoa") != 0)
+            {
+                SetError("Invalid value for [Pitch/AoA] parameter: '%s'", params[1]);
+                return false;
+            }
+            if (!ParseValidatedDouble(params[2], instr.Arg[0], -85, 85) || !ParseValidatedDouble(params[3], instr.Arg[1], -85, 85))
+                return false;
+            instr.Flags |= INSTR_ALL_PARAMS;
+        }
+    }
+    else if (strcasecmp(pName, "DescentHold") == 0)
+    {
+        if (!ValidateArgumentCount(paramCount, 1, 3) || !ParseValidatedBool(params[0], isOn))
+            return false;
+        instr.Op = Opcode::DescentHold;
+        if (paramCount > 1)
+        {
+            if (paramCount != 3)
+            {
+                SetError("Invalid number of paramters: must have either 1 or 3 parameters.");
+                return false;
+            }
+            bool autoLand;
+            if (!ParseValidatedDouble(params[1], instr.Arg[0], -1000, 1000) || !ParseValidatedBool(params[2], autoLand))
+                return false;
+            instr.Flags |= (INSTR_ALL_PARAMS | (autoLand ? INSTR_AUTOLAND : 0));
+        }
+    }
+    else if (strcasecmp(pName, "AirspeedHold") == 0)
+    {
+        if (!ValidateArgumentCount(paramCount, 1, 2) || !ParseValidatedBool(params[0], isOn))
+            return false;
+        instr.Op = Opcode::AirspeedHold;
+        if (paramCount == 2)
+        {
+            if (!ParseValidatedDouble(params[1], instr.Arg[0], 0, numeric_limits<double>::max()))
+                return false;
+            instr.Flags |= INSTR_ALL_PARAMS;
+        }
+    }
+    else
+    {
+        SetError("Invalid command token: [%s]", pName);
+        return false;
+    }
+
+    if (isOn)
+        instr.Flags |= INSTR_ON;
+    return true;
+}
+
+// Reset <Autopilots | MasterWarning | Damage>
+bool XRVCScriptEngine::CompileReset(const char * const *argv, const int argc, Instruction &instr)
+{
+    if (!ValidateArgumentCount(argc, 1, 1))
+        return false;
+
+    if (strcasecmp(argv[0], "Autopilots") == 0)
+        instr.Op = Opcode::ResetAutopilots;
+    else if (strcasecmp(argv[0], "MasterWarning") == 0)
+        instr.Op = Opcode::ResetMasterWarning;
+    else if (strcasecmp(argv[0], "Damage") == 0)
+        instr.Op = Opcode::ResetDamage;
+    else
+    {
+        SetError("Invalid command: '%s'", argv[0]);
+        return false;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------
+// Execution
+//-------------------------------------------------------------------------
+
+int XRVCScriptEngine::Execute(XRVesselCtrl &vessel, const double timeBudget, const int maxInstructions)
+{
+    // Only check the clock every few instructions: a single instruction is far cheaper than reading the clock.
+    const int clockCheckInterval = 16;
+    const auto startTime = chrono::steady_clock::now();
+    const auto budget = chrono::duration<double>(timeBudget);
+
+    const int programSize = static_cast<int>(m_program.size());
+    int executedCount = 0;
+    while ((m_programCounter < programSize) && (executedCount < maxInstructions))
+    {
+        const Instruction &instr = m_program[m_programCounter++];
+        if (!ExecuteInstruction(vessel, instr))
+        {
+            m_failedCount++;
+            m_lastFailedLine = instr.LineNumber;
+        }
+        executedCount++;
+
+        if ((timeBudget >= 0) && ((executedCount % clockCheckInterval) == 0))
+        {
+            if ((chrono::steady_clock::now() - startTime) >= budget)
+                break;
+        }
+    }
+    return executedCount;
+}
+
+// Returns true if the vessel accepted the command, false if it was rejected or is not supported.
+bool XRVCScriptEngine::ExecuteInstruction(XRVesselCtrl &vessel, const Instruction &instr)
+{
+    const bool isOn = ((instr.Flags & INSTR_ON) != 0);
+    const bool allParams = ((instr.Flags & INSTR_ALL_PARAMS) != 0);
+    bool success = false;
+    switch (instr.Op)
+    {
+    case Opcode::EngineDouble:
+    case Opcode::EngineBool:
+    {
+        // read-modify-write each engine so that the other fields are preserved
+        XREngineStateRead state;
+        success = true;
+        for (int i = 0; i < ((instr.ID1 != instr.ID2) ? 2 : 1); i++)
+        {
+            const XREngineID id = static_cast<XREngineID>(i == 0 ? instr.ID1 : instr.ID2);
+            if (!vessel.GetEngineState(id, state))
+            {
+                success = false;
+                break;
+            }
+            char *pField = reinterpret_cast<char *>(static_cast<XREngineStateWrite *>(&state)) + instr.FieldOffset;
+            if (instr.Op == Opcode::EngineDouble)
+                *reinterpret_cast<double *>(pField) = instr.Arg[0];
+            else
+                *reinterpret_cast<bool *>(pField) = isOn;
+            if (!(success = vessel.SetEngineState(id, state)))
+                break;
+        }
+        break;
+    }
+
+    case Opcode::DoorState:
+        success = vessel.SetDoorState(static_cast<XRDoorID>(instr.ID1), static_cast<XRDoorState>(static_cast<int>(instr.Arg[0])));
+        break;
+
+    case Opcode::ExteriorLight:
+        success = vessel.SetExteriorLight(static_cast<XRLight>(instr.ID1), isOn);
+        break;
+
+    case Opcode::StdAutopilot:
+        success = (vessel.SetStandardAP(static_cast<XRStdAutopilot>(instr.ID1), isOn) != XRAutopilotState::XRAPSTATE_NotSupported);
+        break;
+
+    case Opcode::AttitudeHold:
+    {
+        XRAttitudeHoldState state;
+        if (allParams)
+        {
+            state.mode = ((instr.Flags & INSTR_HOLD_PITCH) ? XRAttitudeHoldMode::XRAH_HoldPitch : XRAttitudeHoldMode::XRAH_HoldAOA);
+            state.TargetPitch = instr.Arg[0];
+            state.TargetBank = instr.Arg[1];
+        }
+        else if (vessel.GetAttitudeHoldAP(state) == XRAutopilotState::XRAPSTATE_NotSupported)
+            break;
+        state.on = isOn;
+        success = (vessel.SetAttitudeHoldAP(state) != XRAutopilotState::XRAPSTATE_NotSupported);
+        break;
+    }
+
+    case Opcode::DescentHold:
+    {
+        XRDescentHoldState state;
+        if (allParams)
+        {
+            state.TargetDescentRate = instr.Arg[0];
+            state.AutoLandMode = ((instr.Flags & INSTR_AUTOLAND) != 0);
+        }
+        else if (vessel.GetDescentHoldAP(state) == XRAutopilotState::XRAPSTATE_NotSupported)
+            break;
+        state.on = isOn;
+        success = (vessel.SetDescentHoldAP(state) != XRAutopilotState::XRAPSTATE_NotSupported);
+        break;
+    }
+
+    case Opcode::AirspeedHold:
+    {
+        XRAirspeedHoldState state;
+        if (allParams)
+            state.TargetAirspeed = instr.Arg[0];
+        else if (vessel.GetAirspeedHoldAP(state) == XRAutopilotState::XRAPSTATE_NotSupported)
+            break;
+        state.on = isOn;
+        success = (vessel.SetAirspeedHoldAP(state) != XRAutopilotState::XRAPSTATE_NotSupported);
+        break;
+    }
+
+    case Opcode::DamageDouble:
+    case Opcode::DamageState:
+    {
+        XRSystemStatusRead status;
+        vessel.GetXRSystemStatus(status);
+        char *pField = reinterpret_cast<char *>(static_cast<XRSystemStatusWrite *>(&status)) + instr.FieldOffset;
+        if (instr.Op == Opcode::DamageDouble)
+            *reinterpret_cast<double *>(pField) = instr.Arg[0];
+        else
+            *reinterpret_cast<XRDamageState *>(pField) = static_cast<XRDamageState>(static_cast<int>(instr.Arg[0]));
+        success = vessel.SetXRSystemStatus(status);
+        break;
+    }
+
+    case Opcode::SecondaryHUDMode:
+        success = vessel.SetSecondaryHUDMode(static_cast<int>(instr.Arg[0]));
+        break;
+
+    case Opcode::TertiaryHUDState:
+        success = vessel.SetTertiaryHUDState(instr.Arg[0] != 0);
+        break;
+
+    case Opcode::RCSDockingMode:
+        success = vessel.SetRCSDockingMode(instr.Arg[0] != 0);
+        break;
+
+    case Opcode::ElevatorEVAPortActive:
+        success = vessel.SetElevatorEVAPortActive(instr.Arg[0] != 0);
+        break;
+
+    case Opcode::ShiftCenterOfGravity:
+        success = vessel.ShiftCenterOfGravity(instr.Arg[0]);
+        break;
+
+    case Opcode::ResetAutopilots:
+        vessel.KillAutopilots();    // no return status (always succeeds)
+        success = true;
+        break;
+
+    case Opcode::ResetMasterWarning:
+        success = vessel.ResetMasterWarningAlarm();
+        break;
+
+    case Opcode::ResetDamage:
+        success = vessel.ClearAllXRDamage();
+        break;
+
+    default:
+        assert(false);   // should never happen
+        break;
+    }
+    return success;
+}
+
+//-------------------------------------------------------------------------
+// Argument parsing; each method writes an error message to m_statusBuffer on failure
+//-------------------------------------------------------------------------
+
+bool XRVCScriptEngine::ValidateArgumentCount(const int argc, const int minArgs, const int maxArgs)
+{
+    if (argc < minArgs)
+    {
+        SetError("Too few arguments: expected %d, found %d.", minArgs, argc);
+        return false;
+    }
+    if (argc > maxArgs)
+    {
+        SetError("Too many arguments: expected %d, found %d.", maxArgs, argc);
+        return false;
+    }
+    return true;
+}
+
+// pStr must be one of "true", "on", "false", or "off" (case-insensitive)
+bool XRVCScriptEngine::ParseValidatedBool(const char *pStr, bool &boolOut)
+{
+    if ((strcasecmp(pStr, "true") == 0) || (strcasecmp(pStr, "on") == 0))
+        boolOut = true;
+    else if ((strcasecmp(pStr, "false") == 0) || (strcasecmp(pStr, "off") == 0))
+        boolOut = false;
+    else
+    {
+        SetError("Invalid boolean value (%s); valid options are 'true', 'on', 'false', or 'off' (case-insensitive).", pStr);
+        return false;
+    }
+    return true;
+}
+
+bool XRVCScriptEngine::ParseValidatedInt(const char *pStr, int &intOut, const int min, const int max)
+{
+    char *pEnd;
+    const long value = strtol(pStr, &pEnd, 10);
+    if ((pEnd == pStr) || (*pEnd != 0))
+    {
+        SetError("Invalid argument: '%s'", pStr);
+        return false;
+    }
+    if ((value < min) || (value > max))
+    {
+        SetError("Value out-of-range (%ld); valid range is %d - %d.", value, min, max);
+        return false;
+    }
+    intOut = static_cast<int>(value);
+    return true;
+}
+
+bool XRVCScriptEngine::ParseValidatedDouble(const char *pStr, double &dblOut, const double min, const double max)
+{
+    char *pEnd;
+    dblOut = strtod(pStr, &pEnd);
+    if ((pEnd == pStr) || (*pEnd != 0))
+    {
+        SetError("Invalid argument: '%s'", pStr);
+        return false;
+    }
+    if ((dblOut < min) || (dblOut > max))
+    {
+        SetError("Value out-of-range (%.4lf); valid range is %.4lf - %.4lf.", dblOut, min, max);
+        return false;
+    }
+    return true;
+}
+
+void XRVCScriptEngine::SetError(const char *pFormat, ...)
+{
+    va_list args;
+    va_start(args, pFormat);
+    vsnprintf(m_statusBuffer, sizeof(m_statusBuffer), pFormat, args);
+    va_end(args);
+}
@@ -0,0 +1,144 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XRVCScriptEngine.h
+// Portable compiler and interpreter for XRVesselCtrl (.xrvc) scripts.
+//
+// Scripts use the same command grammar as the XRVesselCtrlDemo console
+// (e.g., "Set Engine MainBoth ThrottleLevel 1.0"), but are parsed only
+// once: each line is resolved into a fixed-size instruction that holds
+// the target IDs, field offsets, and already-validated arguments.
+// Execution is then just a switch over those instructions, and may be
+// spread over several frames by passing a per-frame time budget to
+// Execute.  There are no Win32 or MFC dependencies here.
+// ==============================================================
+
+#pragma once
+
+#include "XRVesselCtrl.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class XRVCScriptEngine
+{
+public:
+    enum class Opcode : uint8_t
+    {
+        EngineDouble,           // Set Engine <engine> <double field> <value>
+        EngineBool,             // Set Engine <engine> <bool field> <on/off>
+        DoorState,              // Set Door <door> <state>
+        ExteriorLight,          // Set Light <light> <on/off>
+        StdAutopilot,           // Set StdAutopilot <autopilot> <on/off>
+        AttitudeHold,           // Set XRAutopilot AttitudeHold <on/off> [Pitch/AoA <pitch> <bank>]
+        DescentHold,            // Set XRAutopilot DescentHold <on/off> [<rate> <autoland>]
+        AirspeedHold,           // Set XRAutopilot AirspeedHold <on/off> [<airspeed>]
+        DamageDouble,           // Set DamageState <system> <0.0 - 1.0>
+        DamageState,            // Set DamageState <system> <online/offline>
+        SecondaryHUDMode,       // Set Other SecondaryHUDMode <0-5>
+        TertiaryHUDState,       // Set Other SetTertiaryHUDState <0/1>
+        RCSDockingMode,         // Set Other RCSDockingMode <0/1>
+        ElevatorEVAPortActive,  // Set Other ElevatorEVAPortActive <0/1>
+        ShiftCenterOfGravity,   // ShiftCenterOfGravity <double>
+        ResetAutopilots,        // Reset Autopilots
+        ResetMasterWarning,     // Reset MasterWarning
+        ResetDamage             // Reset Damage
+    };
+
+    // A single compiled script command.  Everything is resolved at compile time, so executing
+    // one of these is a single XRVesselCtrl call (or a read-modify-write pair for engine and damage fields).
+    struct Instruction
+    {
+        Opcode   Op;
+        uint8_t  ID1;           // XREngineID, XRDoorID, XRLight, or XRStdAutopilot
+        uint8_t  ID2;           // second engine for "Both" engine targets; same as ID1 otherwise
+        uint8_t  Flags;         // INSTR_* bits below
+        uint16_t FieldOffset;   // byte offset of the target field in XREngineStateWrite or XRSystemStatusWrite
+        int      LineNumber;    // 1-based line number in the script that produced this instruction
+        double   Arg[3];        // validated arguments; bools are stored as 0.0 / 1.0
+    };
+
+    // Instruction::Flags bits
+    static const uint8_t INSTR_ON = 0x01;           // autopilot on/off, light on/off, bool field value
+    static const uint8_t INSTR_ALL_PARAMS = 0x02;   // XR autopilot: all parameters were supplied, not just on/off
+    static const uint8_t INSTR_HOLD_PITCH = 0x04;   // Attitude Hold: hold pitch rather than AoA
+    static const uint8_t INSTR_AUTOLAND = 0x08;     // Descent Hold: auto-land engaged
+
+    XRVCScriptEngine();
+    virtual ~XRVCScriptEngine() { }
+
+    // Compile a script file and append its instructions to the program; "Runscript" lines are compiled inline.
+    // Returns true on success, false on error (see GetErrorMessage).  On error the program is left unchanged.
+    bool CompileFile(const char *pFilename);
+
+    // Compile script text already in memory; pSourceName is only used in error messages.
+    bool CompileText(const char *pText, const char *pSourceName = "<text>");
+
+    // Discard all compiled instructions and rewind.
+    void Clear();
+
+    // Rewind to the first instruction so the program can be run again.
+    void Rewind() { m_programCounter = 0; m_failedCount = 0; }
+
+    // Execute instructions until the program finishes, maxInstructions have run, or timeBudget seconds have elapsed.
+    // Pass a negative timeBudget to disable the time limit.  Returns the number of instructions executed.
+    int Execute(XRVesselCtrl &vessel, const double timeBudget, const int maxInstructions = 0x7FFFFFFF);
+
+    bool IsFinished() const { return (m_programCounter >= static_cast<int>(m_program.size())); }
+    int GetInstructionCount() const { return static_cast<int>(m_program.size()); }
+    int GetProgramCounter() const { return m_programCounter; }
+    const Instruction &GetInstruction(const int index) const { return m_program[index]; }
+
+    // number of instructions that were rejected by the vessel since the last Rewind
+    int GetFailedCount() const { return m_failedCount; }
+    int GetLastFailedLine() const { return m_lastFailedLine; }   // -1 = none
+
+    // error message from the last failed Compile* call, or empty
+    const char *GetErrorMessage() const { return m_errorMsg.c_str(); }
+
+    static const int MAX_LINE_LENGTH = 1024;
+    static const int MAX_TOKENS = 8;
+    static const int MAX_INCLUDE_DEPTH = 8;
+
+protected:
+    bool CompileFileImpl(const char *pFilename, const int includeDepth);
+    bool CompileLine(char *pLine, const int lineNumber, const char *pSourceName, const int includeDepth);
+    bool CompileSet(const char * const *argv, const int argc, Instruction &instr);
+    bool CompileReset(const char * const *argv, const int argc, Instruction &instr);
+    bool CompileXRAutopilot(const char * const *argv, const int argc, Instruction &instr);
+    bool ExecuteInstruction(XRVesselCtrl &vessel, const Instruction &instr);
+
+    bool ValidateArgumentCount(const int argc, const int minArgs, const int maxArgs);
+    bool ParseValidatedBool(const char *pStr, bool &boolOut);
+    bool ParseValidatedInt(const char *pStr, int &intOut, const int min, const int max);
+    bool ParseValidatedDouble(const char *pStr, double &dblOut, const double min, const double max);
+    void SetError(const char *pFormat, ...);
+
+    static int Tokenize(char *pLine, char **argvOut, const int maxTokens);
+
+    std::vector<Instruction> m_program;
+    int m_programCounter;           // index of next instruction to execute
+    int m_failedCount;
+    int m_lastFailedLine;
+    std::string m_errorMsg;
+    char m_statusBuffer[256];       // scratch buffer for the current line's error text
+};
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -51,3 +52,16 @@ public:
 		return ((*s1).compare(*s2) == 0);
 	}
 };
+
+// Case-insensitive FNV-1a hash of a null-terminated ASCII string.  This is constexpr so that it may also be used
+// for 'case' labels, in which case the compiler rejects any two labels that hash to the same value.
+constexpr uint32_t HashStringNoCase(const char *pStr)
+{
+    uint32_t hash = 2166136261u;
+    for (; *pStr; pStr++)
+    {
+        const char c = (((*pStr >= 'a') && (*pStr <= 'z')) ? static_cast<char>(*pStr - ('a' - 'A')) : *pStr);
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
@@ -32,7 +32,7 @@
 
 // Constructor
 XRPayloadBay::XRPayloadBay(VESSEL &parentVessel) :
-    m_parentVessel(parentVessel)
+    m_parentVessel(parentVessel), m_attachmentSignature(0), m_attachmentVersion(0)
 {
 }
 
@@ -322,12 +322,15 @@ void XRPayloadBay::RefreshSlotStates()
     // Second, locate and process *primary* slot with a child (i.e., a slot with a payload directly attached)
     // and disable any necessary slots.
     vector<XRPayloadBaySlot *> vOut;  // declared here for efficiency
+    size_t attachmentSignature = 0;
     for (int slotNumber=1; slotNumber <= GetSlotCount(); slotNumber++)
     {
         XRPayloadBaySlot *pSlot = GetSlot(slotNumber);
         VESSEL *pChild = pSlot->GetChild();
         if (pChild != nullptr)
         {
+            attachmentSignature = (attachmentSignature * 31) ^ (reinterpret_cast<size_t>(pChild->GetHandle()) + slotNumber);
+
             vOut.clear();       // reset
 
             // This is a primary slot with a child attached; process it and mark any surrounding slots as DISABLED if the 
@@ -343,6 +346,13 @@ void XRPayloadBay::RefreshSlotStates()
             }
         }
     }
+
+    // let callers that cache attachment status know that a payload vessel was attached or detached
+    if (attachmentSignature != m_attachmentSignature)
+    {
+        m_attachmentSignature = attachmentSignature;
+        m_attachmentVersion++;
+    }
 }
 
 // Instantiate a new instance of a given payload vessel and attach it in the bay at the specified slot, provided there is room.